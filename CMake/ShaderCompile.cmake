@@ -0,0 +1,117 @@
+cmake_minimum_required(VERSION 3.14)
+
+# Compile a shader permutation with dxc.exe. This script is run with "cmake -DPARAMS=<file> -P ShaderCompile.cmake" by
+# shader targets in dxc.cmake. The parameter file sets DXC, SOURCE, OUTPUT, PROFILE, ENTRY, DEFINES, FLAGS, DEPENDS and
+# CACHE_DIR.
+#
+# Compiled shaders are cached in CACHE_DIR by SHA256 of the source file, included files, defines, flags and dxc version.
+# Included files are listed by preprocessing the source with "dxc -M", so that DEPENDS is not required for the cache key
+# to be correct. dxc is skipped if the same permutation has been compiled before, even after a clean build or in another
+# build tree that shares the cache directory. Included files are also written to OUTPUT.d, which is used as depfile of
+# the custom command where the generator supports it.
+if(NOT PARAMS)
+    message(FATAL_ERROR "No shader compile parameter file given.")
+endif()
+
+include(${PARAMS})
+
+get_filename_component(outputDir ${OUTPUT} DIRECTORY)
+file(MAKE_DIRECTORY ${outputDir})
+
+set(defineArgs)
+foreach(define IN LISTS DEFINES)
+    list(APPEND defineArgs "-D" ${define})
+endforeach()
+
+# DXIL libraries do not have entry point.
+set(entryArgs)
+if(ENTRY)
+    set(entryArgs "-E" ${ENTRY})
+endif()
+
+# List included files. dxc prints them as a make rule, in which spaces in paths are escaped and lines are continued with
+# backslashes.
+execute_process(
+    COMMAND         ${DXC} -M -T ${PROFILE} ${entryArgs} ${defineArgs} ${FLAGS} ${SOURCE}
+    OUTPUT_VARIABLE dependOutput
+    RESULT_VARIABLE result
+    ERROR_QUIET
+)
+
+set(includedFiles)
+if(result EQUAL 0)
+    string(REPLACE "\\\n" " " dependOutput "${dependOutput}")
+    string(REPLACE "\\ " "<SPACE>" dependOutput "${dependOutput}")
+    string(REGEX REPLACE "^[^\n]*: " "" dependOutput "${dependOutput}")
+    string(REGEX REPLACE "[ \t\r\n]+" ";" dependOutput "${dependOutput}")
+    foreach(file IN LISTS dependOutput)
+        if(file STREQUAL "")
+            continue()
+        endif()
+
+        string(REPLACE "<SPACE>" " " file "${file}")
+        file(TO_CMAKE_PATH "${file}" file)
+        get_filename_component(file "${file}" ABSOLUTE)
+        if(EXISTS "${file}" AND NOT IS_DIRECTORY "${file}")
+            list(APPEND includedFiles "${file}")
+        endif()
+    endforeach()
+else()
+    message(WARNING "dxc does not support -M, only SOURCE and DEPENDS are hashed for shader cache: ${SOURCE}")
+endif()
+
+set(dependFiles ${SOURCE} ${DEPENDS} ${includedFiles})
+list(REMOVE_DUPLICATES dependFiles)
+
+set(depfileContent "${OUTPUT}:")
+foreach(file IN LISTS dependFiles)
+    string(REPLACE " " "\\ " file "${file}")
+    string(APPEND depfileContent " \\\n  ${file}")
+endforeach()
+file(WRITE ${OUTPUT}.d "${depfileContent}\n")
+
+# Calculate cache key.
+execute_process(
+    COMMAND         ${DXC} --version
+    OUTPUT_VARIABLE dxcVersion
+    ERROR_QUIET
+)
+
+set(cacheKey "${PROFILE}|${ENTRY}|${DEFINES}|${FLAGS}|${dxcVersion}")
+foreach(file IN LISTS dependFiles)
+    file(SHA256 ${file} fileHash)
+    string(APPEND cacheKey "|${fileHash}")
+endforeach()
+
+string(SHA256 cacheKey "${cacheKey}")
+set(cachedShader ${CACHE_DIR}/${cacheKey}.cso)
+
+# Reuse the cached shader binary.
+if(EXISTS ${cachedShader})
+    execute_process(COMMAND ${CMAKE_COMMAND} -E copy ${cachedShader} ${OUTPUT} RESULT_VARIABLE result)
+    if(result EQUAL 0)
+        return()
+    endif()
+endif()
+
+execute_process(
+    COMMAND         ${DXC} -T ${PROFILE} ${entryArgs} ${defineArgs} ${FLAGS} -Fo ${OUTPUT} ${SOURCE}
+    RESULT_VARIABLE result
+)
+
+if(NOT result EQUAL 0)
+    file(REMOVE ${OUTPUT})
+    message(FATAL_ERROR "Failed to compile shader: ${SOURCE}")
+endif()
+
+# Copy to a temporary file first and then rename it, so that parallel builds sharing the cache never see a partial file.
+string(RANDOM LENGTH 16 tempSuffix)
+set(tempShader ${cachedShader}.${tempSuffix}.tmp)
+
+file(MAKE_DIRECTORY ${CACHE_DIR})
+execute_process(COMMAND ${CMAKE_COMMAND} -E copy ${OUTPUT} ${tempShader} RESULT_VARIABLE result)
+if(result EQUAL 0)
+    file(RENAME ${tempShader} ${cachedShader})
+else()
+    file(REMOVE ${tempShader})
+endif()
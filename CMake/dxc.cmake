@@ -1,13 +1,91 @@
 cmake_minimum_required(VERSION 3.14)
 
-# YaGEAddGraphicsShaderTarget
+# dxc.exe is used to compile shaders. Set YAGE_DXC_EXECUTABLE to use a specific dxc.exe.
+find_program(YAGE_DXC_EXECUTABLE NAMES "dxc")
+if(NOT YAGE_DXC_EXECUTABLE)
+    set(YAGE_DXC_EXECUTABLE "dxc")
+endif()
+
+# Compiled shaders are cached here by content hash. Set YAGE_SHADER_CACHE_DIR to share the cache between build trees.
+if(NOT YAGE_SHADER_CACHE_DIR)
+    set(YAGE_SHADER_CACHE_DIR "${CMAKE_BINARY_DIR}/ShaderCache")
+endif()
+
+set(YAGE_SHADER_COMPILE_SCRIPT "${CMAKE_CURRENT_LIST_DIR}/ShaderCompile.cmake")
+
+# Depfile paths written by ShaderCompile.cmake are absolute.
+if(POLICY CMP0116)
+    cmake_policy(SET CMP0116 NEW)
+endif()
+
+# _YaGEGetShaderStageInfo
 #
-# Add a custom target to compile graphics shader using dxc.exe. You may need Visual Studio developer command prompt to use this function. Shader model 6.0 is used here.
-# Default shader output directory is ${CMAKE_CURRENT_BINARY_DIR}/Shaders. You can change it by setting YAGE_SHADER_OUTPUT_DIR.
+# Get shader model, default entry point and binary suffix of the specified shader stage. Shader model 6.0 is used here,
+# except for amplification and mesh shaders which require shader model 6.5. Ray tracing shaders are compiled as DXIL
+# libraries without entry point, exports are selected by state object descriptions.
+function(_YaGEGetShaderStageInfo shaderType)
+    if(shaderType STREQUAL "VERTEX")
+        set(shaderModel "vs_6_0" PARENT_SCOPE)
+        set(shaderEntry "VertexMain" PARENT_SCOPE)
+        set(shaderBinarySuffix ".vso" PARENT_SCOPE)
+        set(promptShaderType "vertex" PARENT_SCOPE)
+    elseif(shaderType STREQUAL "PIXEL")
+        set(shaderModel "ps_6_0" PARENT_SCOPE)
+        set(shaderEntry "PixelMain" PARENT_SCOPE)
+        set(shaderBinarySuffix ".pso" PARENT_SCOPE)
+        set(promptShaderType "pixel" PARENT_SCOPE)
+    elseif(shaderType STREQUAL "DOMAIN")
+        set(shaderModel "ds_6_0" PARENT_SCOPE)
+        set(shaderEntry "DomainMain" PARENT_SCOPE)
+        set(shaderBinarySuffix ".dso" PARENT_SCOPE)
+        set(promptShaderType "domain" PARENT_SCOPE)
+    elseif(shaderType STREQUAL "HULL")
+        set(shaderModel "hs_6_0" PARENT_SCOPE)
+        set(shaderEntry "HullMain" PARENT_SCOPE)
+        set(shaderBinarySuffix ".hso" PARENT_SCOPE)
+        set(promptShaderType "hull" PARENT_SCOPE)
+    elseif(shaderType STREQUAL "GEOMETRY")
+        set(shaderModel "gs_6_0" PARENT_SCOPE)
+        set(shaderEntry "GeometryMain" PARENT_SCOPE)
+        set(shaderBinarySuffix ".gso" PARENT_SCOPE)
+        set(promptShaderType "geometry" PARENT_SCOPE)
+    elseif(shaderType STREQUAL "COMPUTE")
+        set(shaderModel "cs_6_0" PARENT_SCOPE)
+        set(shaderEntry "ComputeMain" PARENT_SCOPE)
+        set(shaderBinarySuffix ".cso" PARENT_SCOPE)
+        set(promptShaderType "compute" PARENT_SCOPE)
+    elseif(shaderType STREQUAL "AMPLIFICATION")
+        set(shaderModel "as_6_5" PARENT_SCOPE)
+        set(shaderEntry "AmplificationMain" PARENT_SCOPE)
+        set(shaderBinarySuffix ".aso" PARENT_SCOPE)
+        set(promptShaderType "amplification" PARENT_SCOPE)
+    elseif(shaderType STREQUAL "MESH")
+        set(shaderModel "ms_6_5" PARENT_SCOPE)
+        set(shaderEntry "MeshMain" PARENT_SCOPE)
+        set(shaderBinarySuffix ".mso" PARENT_SCOPE)
+        set(promptShaderType "mesh" PARENT_SCOPE)
+    elseif(shaderType STREQUAL "RAY_TRACING")
+        set(shaderModel "lib_6_3" PARENT_SCOPE)
+        set(shaderEntry "" PARENT_SCOPE)
+        set(shaderBinarySuffix ".rto" PARENT_SCOPE)
+        set(promptShaderType "ray tracing" PARENT_SCOPE)
+    else()
+        message(FATAL_ERROR "Unknown shader type: ${shaderType}")
+    endif()
+endfunction()
+
+# _YaGEAddShaderCompileCommand
+#
+# Add a custom command to compile a shader permutation with ShaderCompile.cmake. Compile parameters are written to a
+# parameter file in ${CMAKE_CURRENT_BINARY_DIR}/ShaderParams, which is only touched when parameters are changed.
+# Included files are collected by ShaderCompile.cmake and used as depfile where the generator supports it, so DEPENDS is
+# only required for generators without depfile support.
 #
 # Usage:
-#   YaGEAddGraphicsShaderTarget(targetName VERTEX vertexShader1.hlsl vertexShader2.hlsl ... PIXEL pixelShader1.hlsl pixelShader2.hlsl ...)
-function(YaGEAddGraphicsShaderTarget targetName)
+#   _YaGEAddShaderCompileCommand(SOURCE source.hlsl OUTPUT binary PROFILE vs_6_0 ENTRY VertexMain COMMENT comment [DEFINES ...] [DEPENDS ...])
+function(_YaGEAddShaderCompileCommand)
+    cmake_parse_arguments(ARG "" "SOURCE;OUTPUT;PROFILE;ENTRY;COMMENT" "DEFINES;DEPENDS" ${ARGN})
+
     if(CMAKE_BUILD_TYPE STREQUAL "Debug")
         set(dxcExtraFlags "-Zi" "-Od" "-Qembed_debug")
     elseif(CMAKE_BUILD_TYPE STREQUAL "RelWithDebInfo")
@@ -16,6 +94,49 @@ function(YaGEAddGraphicsShaderTarget targetName)
         set(dxcExtraFlags "-O3")
     endif()
 
+    get_filename_component(outputName ${ARG_OUTPUT} NAME)
+    string(SHA1 outputHash "${ARG_OUTPUT}")
+    string(SUBSTRING ${outputHash} 0 8 outputHash)
+    set(paramFile "${CMAKE_CURRENT_BINARY_DIR}/ShaderParams/${outputName}.${outputHash}.cmake")
+    file(WRITE "${paramFile}.tmp"
+        "set(DXC       [==[${YAGE_DXC_EXECUTABLE}]==])\n"
+        "set(SOURCE    [==[${ARG_SOURCE}]==])\n"
+        "set(OUTPUT    [==[${ARG_OUTPUT}]==])\n"
+        "set(PROFILE   [==[${ARG_PROFILE}]==])\n"
+        "set(ENTRY     [==[${ARG_ENTRY}]==])\n"
+        "set(DEFINES   [==[${ARG_DEFINES}]==])\n"
+        "set(FLAGS     [==[${dxcExtraFlags}]==])\n"
+        "set(DEPENDS   [==[${ARG_DEPENDS}]==])\n"
+        "set(CACHE_DIR [==[${YAGE_SHADER_CACHE_DIR}]==])\n"
+    )
+    configure_file("${paramFile}.tmp" "${paramFile}" COPYONLY)
+
+    # Ninja supports depfiles since CMake 3.7, Makefile generators since 3.20 and other generators since 3.21.
+    set(depfileArgs)
+    if(CMAKE_GENERATOR MATCHES "Ninja" OR
+       (CMAKE_GENERATOR MATCHES "Makefiles" AND NOT CMAKE_VERSION VERSION_LESS 3.20) OR
+       NOT CMAKE_VERSION VERSION_LESS 3.21)
+        set(depfileArgs DEPFILE ${ARG_OUTPUT}.d)
+    endif()
+
+    add_custom_command(
+        OUTPUT          ${ARG_OUTPUT}
+        COMMAND         ${CMAKE_COMMAND} -DPARAMS=${paramFile} -P ${YAGE_SHADER_COMPILE_SCRIPT}
+        DEPENDS         ${ARG_SOURCE} ${ARG_DEPENDS} ${paramFile} ${YAGE_SHADER_COMPILE_SCRIPT}
+        ${depfileArgs}
+        COMMENT         ${ARG_COMMENT}
+    )
+endfunction()
+
+# YaGEAddGraphicsShaderTarget
+#
+# Add a custom target to compile graphics shader using dxc.exe. You may need Visual Studio developer command prompt to use this function. Shader model 6.0 is used here, except for amplification and mesh shaders which require shader model 6.5.
+# Default shader output directory is ${CMAKE_CURRENT_BINARY_DIR}/Shaders. You can change it by setting YAGE_SHADER_OUTPUT_DIR.
+#
+# Usage:
+#   YaGEAddGraphicsShaderTarget(targetName VERTEX vertexShader1.hlsl vertexShader2.hlsl ... PIXEL pixelShader1.hlsl pixelShader2.hlsl ...)
+#   YaGEAddGraphicsShaderTarget(targetName AMPLIFICATION amplificationShader.hlsl MESH meshShader.hlsl PIXEL pixelShader.hlsl)
+function(YaGEAddGraphicsShaderTarget targetName)
     # No shader resource given.
     if(NOT ${ARGC} GREATER 1)
         message(FATAL_ERROR "No shader source file given.")
@@ -30,39 +151,12 @@ function(YaGEAddGraphicsShaderTarget targetName)
         math(EXPR index "${index} + 1")
 
         # Update shader type.
-        if(currentSource MATCHES "VERTEX|PIXEL|DOMAIN|HULL|GEOMETRY")
+        if(currentSource MATCHES "^(VERTEX|PIXEL|DOMAIN|HULL|GEOMETRY|AMPLIFICATION|MESH|RAY_TRACING)$")
             set(shaderType ${currentSource})
             continue()
         endif()
 
-        if(shaderType STREQUAL "VERTEX")
-            set(shaderModel "vs_6_0")
-            set(shaderEntry "VertexMain")
-            set(shaderBinarySuffix ".vso")
-            set(promptShaderType "vertex")
-        elseif(shaderType STREQUAL "PIXEL")
-            set(shaderModel "ps_6_0")
-            set(shaderEntry "PixelMain")
-            set(shaderBinarySuffix ".pso")
-            set(promptShaderType "pixel")
-        elseif(shaderType STREQUAL "DOMAIN")
-            set(shaderModel "ds_6_0")
-            set(shaderEntry "DomainMain")
-            set(shaderBinarySuffix ".dso")
-            set(promptShaderType "domain")
-        elseif(shaderType STREQUAL "HULL")
-            set(shaderModel "hs_6_0")
-            set(shaderEntry "HullMain")
-            set(shaderBinarySuffix ".hso")
-            set(promptShaderType "hull")
-        elseif(shaderType STREQUAL "GEOMETRY")
-            set(shaderModel "gs_6_0")
-            set(shaderEntry "GeometryMain")
-            set(shaderBinarySuffix ".gso")
-            set(promptShaderType "geometry")
-        else()
-            message(FATAL_ERROR "Unknown shader type: ${shaderType}")
-        endif()
+        _YaGEGetShaderStageInfo(${shaderType})
 
         # Create directory if needed.
         if(YAGE_SHADER_OUTPUT_DIR)
@@ -83,18 +177,19 @@ function(YaGEAddGraphicsShaderTarget targetName)
         set(shaderBinary ${shaderOutputDir}/${shaderName}${shaderBinarySuffix})
 
         # Compile shader.
-        add_custom_command(
-            OUTPUT          ${shaderBinary}
-            COMMAND         dxc -T ${shaderModel} -E ${shaderEntry} -Fo ${shaderBinary} ${dxcExtraFlags} ${shaderSource}
-            MAIN_DEPENDENCY ${shaderSource}
-            COMMENT         "Compiling ${promptShaderType} shader: ${shaderSource}"
+        _YaGEAddShaderCompileCommand(
+            SOURCE  ${shaderSource}
+            OUTPUT  ${shaderBinary}
+            PROFILE ${shaderModel}
+            ENTRY   ${shaderEntry}
+            COMMENT "Compiling ${promptShaderType} shader: ${shaderSource}"
         )
 
         list(APPEND shaderBinaryList ${shaderBinary})
     endwhile()
 
     add_custom_target(${targetName} ALL DEPENDS ${shaderBinaryList})
-    
+
     # Create directory if needed.
     add_custom_command(
         TARGET ${targetName} PRE_BUILD
@@ -102,3 +197,144 @@ function(YaGEAddGraphicsShaderTarget targetName)
         COMMENT "Creating shader output directory: ${shaderOutputDir}"
     )
 endfunction()
+
+# YaGEAddShaderLibrary
+#
+# Add a custom target to compile shader permutations using dxc.exe and pack them into a single shader library file, which could be loaded with YaGE::ShaderLibrary.
+# Each SHADER starts a new permutation. STAGE is one of VERTEX, PIXEL, DOMAIN, HULL, GEOMETRY, COMPUTE, AMPLIFICATION, MESH and RAY_TRACING. ENTRY defaults to the entry point used by YaGEAddGraphicsShaderTarget.
+# NAME defaults to the binary file name used by YaGEAddGraphicsShaderTarget, for example "HelloTriangle.vso". Sorted defines are appended to the default name in brackets, for example "HelloTriangle.pso[ALPHA_TEST,USE_FOG=1]".
+# Included files are found with "dxc -M" for the shader cache and depfile. DEPENDS lists extra files that the permutation depends on, and is required for included files only with generators that do not support depfiles.
+# Relative library path is placed in ${CMAKE_CURRENT_BINARY_DIR}/Shaders or YAGE_SHADER_OUTPUT_DIR.
+#
+# Usage:
+#   YaGEAddShaderLibrary(targetName OUTPUT library.yshl
+#       SHADER shader1.hlsl STAGE VERTEX [ENTRY entry] [NAME name] [DEFINES A=1 B ...] [DEPENDS common.hlsli ...]
+#       SHADER shader2.hlsl STAGE PIXEL ...
+#   )
+function(YaGEAddShaderLibrary targetName)
+    set(libraryOutput)
+    set(permutationCount 0)
+    set(currentField)
+
+    foreach(arg IN LISTS ARGN)
+        if(arg MATCHES "^(OUTPUT|SHADER|STAGE|ENTRY|NAME|DEFINES|DEPENDS)$")
+            if(arg STREQUAL "SHADER")
+                math(EXPR permutationCount "${permutationCount} + 1")
+            elseif(NOT arg STREQUAL "OUTPUT" AND permutationCount EQUAL 0)
+                message(FATAL_ERROR "${arg} must follow SHADER.")
+            endif()
+
+            set(currentField ${arg})
+            continue()
+        endif()
+
+        if(currentField STREQUAL "OUTPUT")
+            set(libraryOutput ${arg})
+        elseif(currentField MATCHES "^(SHADER|STAGE|ENTRY|NAME)$")
+            set(permutation${permutationCount}_${currentField} ${arg})
+        elseif(currentField MATCHES "^(DEFINES|DEPENDS)$")
+            list(APPEND permutation${permutationCount}_${currentField} ${arg})
+        else()
+            message(FATAL_ERROR "Unexpected argument: ${arg}")
+        endif()
+    endforeach()
+
+    if(NOT libraryOutput)
+        message(FATAL_ERROR "No shader library output given.")
+    endif()
+
+    if(permutationCount EQUAL 0)
+        message(FATAL_ERROR "No shader source file given.")
+    endif()
+
+    if(YAGE_SHADER_OUTPUT_DIR)
+        set(shaderOutputDir ${YAGE_SHADER_OUTPUT_DIR})
+    else()
+        set(shaderOutputDir ${CMAKE_CURRENT_BINARY_DIR}/Shaders)
+    endif()
+
+    if(NOT IS_ABSOLUTE ${libraryOutput})
+        set(libraryOutput ${shaderOutputDir}/${libraryOutput})
+    endif()
+
+    # Compiled permutations are placed in intermediate directory before packed.
+    set(intermediateDir ${CMAKE_CURRENT_BINARY_DIR}/${targetName}.dir)
+    set(shaderBinaryList)
+    set(manifest)
+
+    foreach(index RANGE 1 ${permutationCount})
+        set(currentSource ${permutation${index}_SHADER})
+        set(shaderType ${permutation${index}_STAGE})
+        set(shaderDefines ${permutation${index}_DEFINES})
+        set(shaderDepends)
+
+        if(NOT shaderType)
+            message(FATAL_ERROR "No shader stage given for ${currentSource}.")
+        endif()
+
+        _YaGEGetShaderStageInfo(${shaderType})
+        if(permutation${index}_ENTRY)
+            set(shaderEntry ${permutation${index}_ENTRY})
+        endif()
+
+        # Check source path.
+        if(IS_ABSOLUTE ${currentSource})
+            set(shaderSource ${currentSource})
+        else()
+            set(shaderSource ${CMAKE_CURRENT_SOURCE_DIR}/${currentSource})
+        endif()
+
+        foreach(dependency IN LISTS permutation${index}_DEPENDS)
+            if(IS_ABSOLUTE ${dependency})
+                list(APPEND shaderDepends ${dependency})
+            else()
+                list(APPEND shaderDepends ${CMAKE_CURRENT_SOURCE_DIR}/${dependency})
+            endif()
+        endforeach()
+
+        # Get permutation name.
+        list(SORT shaderDefines)
+        if(permutation${index}_NAME)
+            set(permutationName ${permutation${index}_NAME})
+        else()
+            get_filename_component(shaderName ${shaderSource} NAME_WE)
+            set(permutationName ${shaderName}${shaderBinarySuffix})
+            if(shaderDefines)
+                string(REPLACE ";" "," joinedDefines "${shaderDefines}")
+                set(permutationName "${permutationName}[${joinedDefines}]")
+            endif()
+        endif()
+
+        string(MAKE_C_IDENTIFIER "${permutationName}" binaryName)
+        set(shaderBinary ${intermediateDir}/${index}_${binaryName}${shaderBinarySuffix})
+
+        _YaGEAddShaderCompileCommand(
+            SOURCE  ${shaderSource}
+            OUTPUT  ${shaderBinary}
+            PROFILE ${shaderModel}
+            ENTRY   ${shaderEntry}
+            DEFINES ${shaderDefines}
+            DEPENDS ${shaderDepends}
+            COMMENT "Compiling ${promptShaderType} shader: ${permutationName}"
+        )
+
+        list(APPEND shaderBinaryList ${shaderBinary})
+        string(APPEND manifest "${shaderType}\t${permutationName}\t${shaderBinary}\n")
+    endforeach()
+
+    # Only touch the manifest when permutations are changed.
+    set(manifestFile ${intermediateDir}/Manifest.txt)
+    file(WRITE ${manifestFile}.tmp "${manifest}")
+    configure_file(${manifestFile}.tmp ${manifestFile} COPYONLY)
+
+    get_filename_component(libraryDir ${libraryOutput} DIRECTORY)
+    add_custom_command(
+        OUTPUT  ${libraryOutput}
+        COMMAND ${CMAKE_COMMAND} -E make_directory ${libraryDir}
+        COMMAND YaGEShaderPacker ${manifestFile} ${libraryOutput}
+        DEPENDS YaGEShaderPacker ${manifestFile} ${shaderBinaryList}
+        COMMENT "Packing shader library: ${libraryOutput}"
+    )
+
+    add_custom_target(${targetName} ALL DEPENDS ${libraryOutput})
+endfunction()
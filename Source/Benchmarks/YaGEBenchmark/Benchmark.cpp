@@ -0,0 +1,173 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+/// @brief  Calibration stops growing the number of operations beyond this limit, so that empty operations terminate.
+static constexpr const uint64_t MAX_CALIBRATED_OPERATIONS = (UINT64_C(1) << 36);
+
+static auto WriteJsonString(std::ostream &out, const std::string &value) -> void {
+    out << '"';
+    for (char c : value) {
+        switch (c) {
+        case '"':
+            out << "\\\"";
+            break;
+        case '\\':
+            out << "\\\\";
+            break;
+        case '\n':
+            out << "\\n";
+            break;
+        case '\r':
+            out << "\\r";
+            break;
+        case '\t':
+            out << "\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                char buffer[8];
+                snprintf(buffer, sizeof(buffer), "\\u%04X", static_cast<unsigned int>(c));
+                out << buffer;
+            } else {
+                out << c;
+            }
+            break;
+        }
+    }
+    out << '"';
+}
+
+static auto WriteJsonNumber(std::ostream &out, double value) -> void {
+    // JSON does not support infinity and NaN.
+    if (!std::isfinite(value)) {
+        out << "null";
+        return;
+    }
+
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%.9g", value);
+    out << buffer;
+}
+
+BenchmarkRunner::BenchmarkRunner(const BenchmarkOptions &options) : options(options), context(), results() {}
+
+auto BenchmarkRunner::IsEnabled(const std::string &name) const noexcept -> bool {
+    return options.filter.empty() || name.find(options.filter) != std::string::npos;
+}
+
+auto BenchmarkRunner::Run(const std::string                   &name,
+                          uint64_t                             bytesPerOperation,
+                          const std::function<void(uint64_t)> &operation) -> BenchmarkResult * {
+    if (!IsEnabled(name))
+        return nullptr;
+
+    const uint64_t minSampleTime = static_cast<uint64_t>(options.minSampleTime * 1e9);
+
+    // Warm up caches and lazily created objects.
+    operation(1);
+
+    // Grow number of operations until a single sample takes long enough to hide timer resolution.
+    uint64_t operations = 1;
+    for (;;) {
+        const uint64_t begin = Now();
+        operation(operations);
+        const uint64_t elapsed = Now() - begin;
+
+        if (elapsed >= minSampleTime || operations >= MAX_CALIBRATED_OPERATIONS)
+            break;
+
+        const uint64_t scale = (elapsed == 0) ? 10 : std::min<uint64_t>(10, minSampleTime / elapsed + 1);
+        operations *= std::max<uint64_t>(scale, 2);
+    }
+
+    std::vector<double> times(options.sampleCount);
+    for (double &time : times) {
+        const uint64_t begin = Now();
+        operation(operations);
+        time = static_cast<double>(Now() - begin) / static_cast<double>(operations);
+    }
+
+    std::sort(times.begin(), times.end());
+
+    BenchmarkResult result;
+    result.name              = name;
+    result.operations        = operations;
+    result.samples           = static_cast<uint32_t>(times.size());
+    result.medianTime        = (times.size() % 2 == 1) ? times[times.size() / 2]
+                                                       : (times[times.size() / 2 - 1] + times[times.size() / 2]) * 0.5;
+    result.minTime           = times.front();
+    result.maxTime           = times.back();
+    result.bytesPerOperation = bytesPerOperation;
+
+    return &AddResult(std::move(result));
+}
+
+auto BenchmarkRunner::AddResult(BenchmarkResult result) -> BenchmarkResult & {
+    // Results are printed as they are finished, so that progress of long runs is visible.
+    fprintf(stderr, "%-48s %14.2f ns/op\n", result.name.c_str(), result.medianTime);
+
+    results.push_back(std::move(result));
+    return results.back();
+}
+
+auto BenchmarkRunner::AddContext(std::string key, std::string value) -> void {
+    context.emplace_back(std::move(key), std::move(value));
+}
+
+auto BenchmarkRunner::WriteJson(std::ostream &out) const -> void {
+    out << "{\n  \"context\": {";
+    for (size_t i = 0; i < context.size(); ++i) {
+        out << (i == 0 ? "\n    " : ",\n    ");
+        WriteJsonString(out, context[i].first);
+        out << ": ";
+        WriteJsonString(out, context[i].second);
+    }
+    out << (context.empty() ? "},\n" : "\n  },\n");
+
+    out << "  \"benchmarks\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchmarkResult &result = results[i];
+
+        out << (i == 0 ? "\n    {" : ",\n    {");
+        out << "\n      \"name\": ";
+        WriteJsonString(out, result.name);
+        out << ",\n      \"operations\": " << result.operations;
+        out << ",\n      \"samples\": " << result.samples;
+        out << ",\n      \"median_ns\": ";
+        WriteJsonNumber(out, result.medianTime);
+        out << ",\n      \"min_ns\": ";
+        WriteJsonNumber(out, result.minTime);
+        out << ",\n      \"max_ns\": ";
+        WriteJsonNumber(out, result.maxTime);
+
+        if (result.bytesPerOperation != 0) {
+            // Throughput is computed from the median sample.
+            out << ",\n      \"bytes_per_second\": ";
+            WriteJsonNumber(out, static_cast<double>(result.bytesPerOperation) * 1e9 / result.medianTime);
+        }
+
+        out << ",\n      \"metrics\": [";
+        for (size_t j = 0; j < result.metrics.size(); ++j) {
+            const BenchmarkMetric &metric = result.metrics[j];
+
+            out << (j == 0 ? "\n        {\"name\": " : ",\n        {\"name\": ");
+            WriteJsonString(out, metric.name);
+            out << ", \"value\": ";
+            WriteJsonNumber(out, metric.value);
+            out << ", \"unit\": ";
+            WriteJsonString(out, metric.unit);
+            out << "}";
+        }
+        out << (result.metrics.empty() ? "]\n    }" : "\n      ]\n    }");
+    }
+    out << (results.empty() ? "]\n}\n" : "\n  ]\n}\n");
+}
+
+auto BenchmarkRunner::Now() noexcept -> uint64_t {
+    const auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+}
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <YaGE/Core/String.h>
+
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct BenchmarkMetric {
+    /// @brief  Name of this metric, for example "frame_time_p99".
+    std::string name;
+
+    /// @brief  Value of this metric.
+    double value;
+
+    /// @brief  Unit of this metric, for example "ms".
+    std::string unit;
+};
+
+struct BenchmarkResult {
+    /// @brief  Name of the benchmark, for example "hash/hash64/4096".
+    std::string name;
+
+    /// @brief  Number of operations measured in each sample.
+    uint64_t operations;
+
+    /// @brief  Number of samples.
+    uint32_t samples;
+
+    /// @brief  Median time in nanosecond of each operation across all samples.
+    double medianTime;
+
+    /// @brief  Minimum time in nanosecond of each operation across all samples.
+    double minTime;
+
+    /// @brief  Maximum time in nanosecond of each operation across all samples.
+    double maxTime;
+
+    /// @brief  Number of bytes processed by each operation. Throughput is reported only if this is not 0.
+    uint64_t bytesPerOperation;
+
+    /// @brief  Benchmark-specific metrics.
+    std::vector<BenchmarkMetric> metrics;
+};
+
+struct BenchmarkOptions {
+    /// @brief  Only benchmarks whose name contains this string are run. Empty filter matches all benchmarks.
+    std::string filter;
+
+    /// @brief  Minimum time in second that each sample of a microbenchmark should take.
+    double minSampleTime;
+
+    /// @brief  Number of samples of each microbenchmark.
+    uint32_t sampleCount;
+
+    /// @brief  Number of draws per frame of the stress scene.
+    uint32_t stressDrawCount;
+
+    /// @brief  Number of measured frames of the stress scene.
+    uint32_t stressFrameCount;
+
+    /// @brief  Path to the image to be loaded by image benchmarks. Image benchmarks are skipped if this is empty.
+    YaGE::String imagePath;
+};
+
+class BenchmarkRunner {
+public:
+    /// @brief
+    ///   Create a benchmark runner.
+    ///
+    /// @param options  Options of this benchmark run.
+    explicit BenchmarkRunner(const BenchmarkOptions &options);
+
+    /// @brief
+    ///   Get options of this benchmark run.
+    ///
+    /// @return const BenchmarkOptions &
+    ///   Return options of this benchmark run.
+    YAGE_NODISCARD auto Options() const noexcept -> const BenchmarkOptions & { return options; }
+
+    /// @brief
+    ///   Checks if the specified benchmark should be run.
+    ///
+    /// @param name     Name of the benchmark.
+    ///
+    /// @return bool
+    /// @retval true    The benchmark matches the filter.
+    /// @retval false   The benchmark does not match the filter.
+    YAGE_NODISCARD auto IsEnabled(const std::string &name) const noexcept -> bool;
+
+    /// @brief
+    ///   Run a microbenchmark. The operation is repeated until each sample takes at least @p minSampleTime seconds, and then @p sampleCount samples are measured.
+    ///
+    /// @param name                 Name of the benchmark.
+    /// @param bytesPerOperation    Number of bytes processed by each operation. Pass 0 if throughput is meaningless.
+    /// @param operation            The operation to be measured. The argument is number of times that the operation should be repeated.
+    ///
+    /// @return BenchmarkResult *
+    ///   Return pointer to the result so that custom metrics could be appended. The pointer is invalidated once another result is added. Return nullptr if the benchmark is filtered out.
+    auto Run(const std::string &name, uint64_t bytesPerOperation, const std::function<void(uint64_t)> &operation)
+        -> BenchmarkResult *;
+
+    /// @brief
+    ///   Add a result measured by the caller, for example frame times of the stress scene.
+    ///
+    /// @param result   The result to be added.
+    ///
+    /// @return BenchmarkResult &
+    ///   Return reference to the added result.
+    auto AddResult(BenchmarkResult result) -> BenchmarkResult &;
+
+    /// @brief
+    ///   Add an environment property that is written together with the results, for example name of the GPU.
+    ///
+    /// @param key      Name of the property.
+    /// @param value    Value of the property.
+    auto AddContext(std::string key, std::string value) -> void;
+
+    /// @brief
+    ///   Write all results as a JSON document.
+    ///
+    /// @param[out] out     The stream to write JSON to.
+    auto WriteJson(std::ostream &out) const -> void;
+
+    /// @brief
+    ///   Get the current time in nanosecond from a monotonic clock.
+    ///
+    /// @return uint64_t
+    ///   Return the current time in nanosecond.
+    YAGE_NODISCARD static auto Now() noexcept -> uint64_t;
+
+private:
+    /// @brief  Options of this benchmark run.
+    BenchmarkOptions options;
+
+    /// @brief  Environment properties.
+    std::vector<std::pair<std::string, std::string>> context;
+
+    /// @brief  Results of this benchmark run.
+    std::vector<BenchmarkResult> results;
+};
+
+/// @brief
+///   Run CPU-only benchmarks: hashing, math kernels and image loading.
+///
+/// @param[in] runner   The runner that results are added to.
+auto RunCoreBenchmarks(BenchmarkRunner &runner) -> void;
+
+/// @brief
+///   Run GPU benchmarks: command buffer submission, descriptor commits, temp uploads, descriptor allocation and the stress scene.
+///
+/// @param[in] runner   The runner that results are added to.
+///
+/// @throw RenderAPIException
+///   Thrown if failed to create D3D12 objects for the benchmarks.
+auto RunGraphicsBenchmarks(BenchmarkRunner &runner) -> void;
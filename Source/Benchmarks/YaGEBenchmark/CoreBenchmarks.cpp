@@ -0,0 +1,198 @@
+#include "Benchmark.h"
+
+#include <YaGE/Core/Hash.h>
+#include <YaGE/Math/Batch.h>
+#include <YaGE/Resource/Image.h>
+
+#include <random>
+
+using namespace YaGE;
+
+/// @brief  Number of elements that are processed by each call to batch math kernels.
+static constexpr const size_t MATH_BATCH_SIZE = 4096;
+
+/// @brief  Results of measured functions are accumulated into this sink, so that calls are never optimized away.
+static volatile uint64_t resultSink;
+
+struct SphereData {
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> z;
+    std::vector<float> radius;
+
+    explicit SphereData(size_t count) : x(count), y(count), z(count), radius(count) {}
+
+    auto Stream() noexcept -> SphereStream { return {x.data(), y.data(), z.data(), radius.data()}; }
+};
+
+struct BoxData {
+    std::vector<float> minX;
+    std::vector<float> minY;
+    std::vector<float> minZ;
+    std::vector<float> maxX;
+    std::vector<float> maxY;
+    std::vector<float> maxZ;
+
+    explicit BoxData(size_t count) : minX(count), minY(count), minZ(count), maxX(count), maxY(count), maxZ(count) {}
+
+    auto Stream() noexcept -> BoxStream {
+        return {minX.data(), minY.data(), minZ.data(), maxX.data(), maxY.data(), maxZ.data()};
+    }
+};
+
+/// @brief
+///   Run a benchmark of a batch kernel. Time per element is appended so that kernels of different batch sizes are comparable.
+///
+/// @param[in] runner       The runner that the result is added to.
+/// @param     name         Name of the benchmark. Batch size is appended to the name.
+/// @param     batchSize    Number of elements that are processed by each call to @p batch.
+/// @param     batch        The batch kernel to be measured.
+static auto RunBatch(BenchmarkRunner             &runner,
+                     const std::string           &name,
+                     size_t                       batchSize,
+                     const std::function<void()> &batch) -> void {
+    BenchmarkResult *result = runner.Run(name + "/" + std::to_string(batchSize), 0, [&batch](uint64_t count) {
+        for (uint64_t i = 0; i < count; ++i)
+            batch();
+    });
+
+    if (result != nullptr)
+        result->metrics.push_back({"element_time", result->medianTime / static_cast<double>(batchSize), "ns"});
+}
+
+static auto RunHashBenchmarks(BenchmarkRunner &runner) -> void {
+    const size_t sizes[] = {16, 64, 4096, 1 << 20};
+
+    std::vector<uint8_t> data(sizes[_countof(sizes) - 1]);
+    {
+        std::mt19937 random(0x5961474Eu);
+        for (uint8_t &value : data)
+            value = static_cast<uint8_t>(random());
+    }
+
+    for (size_t size : sizes) {
+        // Seed is changed every iteration so that calls could not be hoisted out of the loop.
+        runner.Run("hash/hash64/" + std::to_string(size), size, [&data, size](uint64_t count) {
+            uint64_t result = 0;
+            for (uint64_t i = 0; i < count; ++i)
+                result += Hash64(data.data(), size, i);
+            resultSink = result;
+        });
+
+        runner.Run("hash/fast_hash64/" + std::to_string(size), size, [&data, size](uint64_t count) {
+            uint64_t result = 0;
+            for (uint64_t i = 0; i < count; ++i)
+                result += FastHash64(data.data(), size, i);
+            resultSink = result;
+        });
+    }
+}
+
+static auto RunMathBenchmarks(BenchmarkRunner &runner) -> void {
+    const size_t count = MATH_BATCH_SIZE;
+
+    std::mt19937                          random(0x5961474Eu);
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> extent(0.1f, 4.0f);
+
+    std::vector<Matrix4> matrices(count);
+    std::vector<Matrix4> results(count);
+    for (Matrix4 &matrix : matrices) {
+        matrix = Matrix4(1.0f);
+        matrix.Translate(position(random), position(random), position(random));
+    }
+
+    Matrix4 viewProjection(1.0f);
+    viewProjection.LookAt(Vector3(0.0f, 0.0f, -150.0f), Vector3(0.0f, 0.0f, 0.0f), Vector3(0.0f, 1.0f, 0.0f))
+        .Perspective(1.0f, 16.0f / 9.0f, 0.1f, 1000.0f);
+
+    const Frustum frustum(viewProjection);
+
+    SphereData spheres(count);
+    SphereData transformedSpheres(count);
+    for (size_t i = 0; i < count; ++i) {
+        spheres.x[i]      = position(random);
+        spheres.y[i]      = position(random);
+        spheres.z[i]      = position(random);
+        spheres.radius[i] = extent(random);
+    }
+
+    BoxData boxes(count);
+    BoxData transformedBoxes(count);
+    for (size_t i = 0; i < count; ++i) {
+        const float x = position(random);
+        const float y = position(random);
+        const float z = position(random);
+
+        boxes.minX[i] = x;
+        boxes.minY[i] = y;
+        boxes.minZ[i] = z;
+        boxes.maxX[i] = x + extent(random);
+        boxes.maxY[i] = y + extent(random);
+        boxes.maxZ[i] = z + extent(random);
+    }
+
+    std::vector<float> scaleX(count, 1.0f);
+    std::vector<float> scaleY(count, 1.0f);
+    std::vector<float> scaleZ(count, 1.0f);
+    std::vector<float> rotationX(count);
+    std::vector<float> rotationY(count);
+    std::vector<float> rotationZ(count);
+    std::vector<float> rotationW(count, 1.0f);
+
+    std::vector<uint32_t> visible(count);
+
+    RunBatch(runner, "math/batch_multiply", count,
+             [&]() { BatchMultiply(matrices.data(), viewProjection, results.data(), count); });
+
+    RunBatch(runner, "math/batch_compose", count, [&]() {
+        BatchCompose({scaleX.data(), scaleY.data(), scaleZ.data()},
+                     {rotationX.data(), rotationY.data(), rotationZ.data(), rotationW.data()},
+                     {spheres.x.data(), spheres.y.data(), spheres.z.data()}, results.data(), count);
+    });
+
+    RunBatch(runner, "math/batch_transform_spheres", count,
+             [&]() { BatchTransformSpheres(matrices.data(), spheres.Stream(), transformedSpheres.Stream(), count); });
+
+    RunBatch(runner, "math/batch_transform_boxes", count,
+             [&]() { BatchTransformBoxes(matrices.data(), boxes.Stream(), transformedBoxes.Stream(), count); });
+
+    RunBatch(runner, "math/batch_cull_spheres", count,
+             [&]() { resultSink = BatchCullSpheres(frustum, spheres.Stream(), count, visible.data()); });
+
+    RunBatch(runner, "math/batch_cull_boxes", count,
+             [&]() { resultSink = BatchCullBoxes(frustum, boxes.Stream(), count, visible.data()); });
+
+    // Scalar matrix math is measured as a baseline of the batch kernels.
+    RunBatch(runner, "math/matrix_inverse", count, [&]() {
+        for (size_t i = 0; i < count; ++i)
+            results[i] = matrices[i].Inversed();
+    });
+}
+
+static auto RunImageBenchmarks(BenchmarkRunner &runner) -> void {
+    const String &path = runner.Options().imagePath;
+    if (path.IsEmpty() || !runner.IsEnabled("image/load"))
+        return;
+
+    // Decoded size is used as throughput because file size depends on compression of the image.
+    const Image image(path);
+
+    BenchmarkResult *result = runner.Run("image/load", image.Size(), [&path](uint64_t count) {
+        for (uint64_t i = 0; i < count; ++i) {
+            const Image loaded(path);
+            resultSink = loaded.Size();
+        }
+    });
+
+    result->metrics.push_back({"width", static_cast<double>(image.Width()), "px"});
+    result->metrics.push_back({"height", static_cast<double>(image.Height()), "px"});
+}
+
+auto RunCoreBenchmarks(BenchmarkRunner &runner) -> void {
+    runner.AddContext("batch_avx2", BatchUsesAvx2() ? "true" : "false");
+
+    RunHashBenchmarks(runner);
+    RunMathBenchmarks(runner);
+    RunImageBenchmarks(runner);
+}
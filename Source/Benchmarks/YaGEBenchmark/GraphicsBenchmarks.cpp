@@ -0,0 +1,488 @@
+#include "Benchmark.h"
+
+#include <YaGE/Core/Profiler.h>
+#include <YaGE/Core/Unicode.h>
+#include <YaGE/Graphics/ColorBuffer.h>
+#include <YaGE/Graphics/CommandBuffer.h>
+#include <YaGE/Graphics/GpuProfiler.h>
+#include <YaGE/Graphics/ShaderLibrary.h>
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+
+using namespace YaGE;
+
+/// @brief  Width in pixel of the offscreen render target.
+static constexpr const uint32_t RENDER_TARGET_WIDTH = 1920;
+
+/// @brief  Height in pixel of the offscreen render target.
+static constexpr const uint32_t RENDER_TARGET_HEIGHT = 1080;
+
+/// @brief  Triangles are laid out in a grid of this many rows and columns that covers the render target.
+static constexpr const uint32_t GRID_SIZE = 128;
+
+/// @brief  Number of colors in each palette buffer.
+static constexpr const uint32_t PALETTE_SIZE = 256;
+
+/// @brief  Draw benchmarks submit their command buffer once this many draws are recorded.
+static constexpr const uint64_t DRAWS_PER_SUBMIT = 4096;
+
+/// @brief  Upload benchmarks submit their command buffer once this many bytes are uploaded.
+static constexpr const size_t UPLOAD_BYTES_PER_SUBMIT = 16 * 1024 * 1024;
+
+/// @brief  Upload benchmarks submit their command buffer once this many copies are recorded.
+static constexpr const uint64_t UPLOADS_PER_SUBMIT = 1024;
+
+/// @brief  Number of descriptors that are allocated before they are freed by descriptor allocator benchmarks.
+static constexpr const uint64_t DESCRIPTOR_BATCH_SIZE = 256;
+
+/// @brief  The stress scene switches its palette every this many draws to emulate material changes.
+static constexpr const uint32_t DRAWS_PER_MATERIAL = 64;
+
+/// @brief  Number of stress scene frames that are rendered before measurement starts.
+static constexpr const uint32_t STRESS_WARMUP_FRAMES = 16;
+
+/// @brief  Maximum number of stress scene frames that CPU could run ahead of GPU, like a swap chain does.
+static constexpr const uint32_t MAX_FRAMES_IN_FLIGHT = 2;
+
+class BenchmarkScene {
+public:
+    /// @brief
+    ///   Create resources and pipeline states that are shared by draw benchmarks.
+    ///
+    /// @param[in] commandBuffer    The command buffer that is used to upload palettes.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to create D3D12 objects.
+    explicit BenchmarkScene(CommandBuffer &commandBuffer);
+
+    /// @brief
+    ///   Bind render target, pipeline state and root arguments of this scene. This must be called again once the command buffer is submitted.
+    ///
+    /// @param[in] commandBuffer    The command buffer to record commands on.
+    auto BeginDraws(CommandBuffer &commandBuffer) noexcept -> void;
+
+    /// @brief
+    ///   Draw a single triangle of this scene.
+    ///
+    /// @param[in] commandBuffer    The command buffer to record commands on.
+    /// @param     index            Index of the triangle. Position and color of the triangle are derived from this index.
+    auto Draw(CommandBuffer &commandBuffer, uint32_t index) noexcept -> void {
+        const uint32_t column = index % GRID_SIZE;
+        const uint32_t row    = (index / GRID_SIZE) % GRID_SIZE;
+        const float    scale  = 1.0f / static_cast<float>(GRID_SIZE);
+
+        commandBuffer.SetGraphicsConstant(0, 0, static_cast<float>(2 * column + 1) * scale - 1.0f,
+                                          static_cast<float>(2 * row + 1) * scale - 1.0f, scale, scale,
+                                          index % PALETTE_SIZE);
+        commandBuffer.Draw(3);
+    }
+
+    /// @brief
+    ///   Get unordered access view of the specified palette.
+    ///
+    /// @param index    Index of the palette. Must be 0 or 1.
+    ///
+    /// @return CpuDescriptorHandle
+    ///   Return unordered access view of the palette.
+    YAGE_NODISCARD auto Palette(uint32_t index) const noexcept -> CpuDescriptorHandle {
+        return palettes[index].StructuredUnorderedAccessView();
+    }
+
+    /// @brief
+    ///   Get the offscreen render target of this scene.
+    ///
+    /// @return ColorBuffer &
+    ///   Return reference to the offscreen render target.
+    YAGE_NODISCARD auto RenderTarget() noexcept -> ColorBuffer & { return renderTarget; }
+
+private:
+    /// @brief  Offscreen render target. Benchmarks never present so that results are not bound to refresh rate.
+    ColorBuffer renderTarget;
+
+    /// @brief  Color palettes that are bound alternately to force descriptor table updates.
+    StructuredBuffer palettes[2];
+
+    /// @brief  Root signature with per-draw root constants and a palette descriptor table.
+    std::unique_ptr<RootSignature> rootSignature;
+
+    /// @brief  Pipeline state of the stress scene.
+    std::unique_ptr<GraphicsPipelineState> pipelineState;
+};
+
+BenchmarkScene::BenchmarkScene(CommandBuffer &commandBuffer)
+    : renderTarget(RENDER_TARGET_WIDTH, RENDER_TARGET_HEIGHT, DXGI_FORMAT_R8G8B8A8_UNORM),
+      palettes(),
+      rootSignature(),
+      pipelineState() {
+    { // Upload palettes.
+        std::vector<Color> colors(PALETTE_SIZE);
+        for (uint32_t i = 0; i < 2; ++i) {
+            palettes[i] = StructuredBuffer(PALETTE_SIZE, static_cast<uint32_t>(sizeof(Color)));
+
+            for (uint32_t j = 0; j < PALETTE_SIZE; ++j)
+                colors[j] = Color(static_cast<float>(j) / PALETTE_SIZE, static_cast<float>(i), 0.5f, 1.0f);
+
+            commandBuffer.Transition(palettes[i], D3D12_RESOURCE_STATE_COPY_DEST);
+            commandBuffer.CopyBuffer(colors.data(), palettes[i], 0, colors.size() * sizeof(Color));
+            commandBuffer.Transition(palettes[i], D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+        }
+
+        commandBuffer.Submit();
+        commandBuffer.WaitForComplete();
+    }
+
+    { // Create root signature.
+        const D3D12_DESCRIPTOR_RANGE range{
+            /* RangeType                         = */ D3D12_DESCRIPTOR_RANGE_TYPE_UAV,
+            /* NumDescriptors                    = */ 1,
+            /* BaseShaderRegister                = */ 0,
+            /* RegisterSpace                     = */ 0,
+            /* OffsetInDescriptorsFromTableStart = */ 0,
+        };
+
+        D3D12_ROOT_PARAMETER parameters[2];
+
+        parameters[0].ParameterType            = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
+        parameters[0].Constants.ShaderRegister = 0;
+        parameters[0].Constants.RegisterSpace  = 0;
+        parameters[0].Constants.Num32BitValues = 5;
+        parameters[0].ShaderVisibility         = D3D12_SHADER_VISIBILITY_VERTEX;
+
+        parameters[1].ParameterType                       = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
+        parameters[1].DescriptorTable.NumDescriptorRanges = 1;
+        parameters[1].DescriptorTable.pDescriptorRanges   = &range;
+        parameters[1].ShaderVisibility                    = D3D12_SHADER_VISIBILITY_VERTEX;
+
+        D3D12_ROOT_SIGNATURE_DESC desc{};
+        desc.NumParameters = _countof(parameters);
+        desc.pParameters   = parameters;
+
+        rootSignature = std::make_unique<RootSignature>(desc);
+    }
+
+    { // Create pipeline state.
+        ShaderLibrary shaderLibrary(u"Shaders/StressScene.yshl");
+
+        D3D12_GRAPHICS_PIPELINE_STATE_DESC desc{};
+
+        desc.pRootSignature                        = rootSignature->D3D12RootSignature();
+        desc.VS                                    = shaderLibrary.Bytecode(u"StressScene.vso");
+        desc.PS                                    = shaderLibrary.Bytecode(u"StressScene.pso");
+        desc.RasterizerState.FillMode              = D3D12_FILL_MODE_SOLID;
+        desc.RasterizerState.CullMode              = D3D12_CULL_MODE_NONE;
+        desc.RasterizerState.FrontCounterClockwise = FALSE;
+        desc.RasterizerState.DepthBias             = D3D12_DEFAULT_DEPTH_BIAS;
+        desc.RasterizerState.DepthBiasClamp        = D3D12_DEFAULT_DEPTH_BIAS_CLAMP;
+        desc.RasterizerState.SlopeScaledDepthBias  = D3D12_DEFAULT_SLOPE_SCALED_DEPTH_BIAS;
+        desc.RasterizerState.DepthClipEnable       = TRUE;
+        desc.RasterizerState.MultisampleEnable     = FALSE;
+        desc.RasterizerState.AntialiasedLineEnable = FALSE;
+        desc.RasterizerState.ForcedSampleCount     = 0;
+        desc.RasterizerState.ConservativeRaster    = D3D12_CONSERVATIVE_RASTERIZATION_MODE_OFF;
+        desc.BlendState.AlphaToCoverageEnable      = FALSE;
+        desc.BlendState.IndependentBlendEnable     = FALSE;
+
+        for (auto &target : desc.BlendState.RenderTarget)
+            target = {
+                FALSE,
+                FALSE,
+                D3D12_BLEND_ONE,
+                D3D12_BLEND_ZERO,
+                D3D12_BLEND_OP_ADD,
+                D3D12_BLEND_ONE,
+                D3D12_BLEND_ZERO,
+                D3D12_BLEND_OP_ADD,
+                D3D12_LOGIC_OP_NOOP,
+                D3D12_COLOR_WRITE_ENABLE_ALL,
+            };
+
+        desc.DepthStencilState.DepthEnable   = FALSE;
+        desc.DepthStencilState.StencilEnable = FALSE;
+        desc.SampleMask                      = UINT_MAX;
+        desc.PrimitiveTopologyType           = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
+        desc.NumRenderTargets                = 1;
+        desc.RTVFormats[0]                   = renderTarget.PixelFormat();
+        desc.SampleDesc.Count                = 1;
+
+        pipelineState = std::make_unique<GraphicsPipelineState>(*rootSignature, desc);
+    }
+}
+
+auto BenchmarkScene::BeginDraws(CommandBuffer &commandBuffer) noexcept -> void {
+    commandBuffer.Transition(renderTarget, D3D12_RESOURCE_STATE_RENDER_TARGET);
+    commandBuffer.SetRenderTarget(renderTarget);
+
+    commandBuffer.SetPipelineState(*pipelineState);
+    commandBuffer.SetGraphicsRootSignature(*rootSignature);
+    commandBuffer.SetGraphicsDescriptor(1, 0, Palette(0));
+
+    commandBuffer.SetViewport(0, 0, RENDER_TARGET_WIDTH, RENDER_TARGET_HEIGHT);
+    commandBuffer.SetScissorRect(0, 0, RENDER_TARGET_WIDTH, RENDER_TARGET_HEIGHT);
+    commandBuffer.SetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+}
+
+/// @brief
+///   Get the specified percentile of sorted values.
+///
+/// @param values       Values sorted in ascending order.
+/// @param percentile   The percentile between 0 and 1.
+///
+/// @return double
+///   Return the value at the specified percentile. Return NaN if @p values is empty.
+static auto Percentile(const std::vector<double> &values, double percentile) noexcept -> double {
+    if (values.empty())
+        return std::numeric_limits<double>::quiet_NaN();
+
+    const size_t index = static_cast<size_t>(percentile * static_cast<double>(values.size() - 1) + 0.5);
+    return values[index];
+}
+
+/// @brief
+///   Record and submit the specified number of scene draws, and wait for them to finish on GPU.
+///
+/// @param[in] scene            The scene to be drawn.
+/// @param[in] commandBuffer    The command buffer to record draws on.
+/// @param     count            Number of draws.
+/// @param     changePalette    Whether to bind a different palette before each draw, so that each draw commits a new descriptor table.
+static auto RecordDraws(BenchmarkScene &scene, CommandBuffer &commandBuffer, uint64_t count, bool changePalette)
+    -> void {
+    scene.BeginDraws(commandBuffer);
+    for (uint64_t i = 0; i < count; ++i) {
+        if (i != 0 && i % DRAWS_PER_SUBMIT == 0) {
+            commandBuffer.Submit();
+            scene.BeginDraws(commandBuffer);
+        }
+
+        if (changePalette)
+            commandBuffer.SetGraphicsDescriptor(1, 0, scene.Palette(static_cast<uint32_t>(i % 2)));
+
+        scene.Draw(commandBuffer, static_cast<uint32_t>(i));
+    }
+
+    commandBuffer.Submit();
+    commandBuffer.WaitForComplete();
+}
+
+static auto RunCommandBufferBenchmarks(BenchmarkRunner &runner, BenchmarkScene &scene, CommandBuffer &commandBuffer)
+    -> void {
+    runner.Run("graphics/command_buffer/empty_submit", 0, [&commandBuffer](uint64_t count) {
+        for (uint64_t i = 0; i < count; ++i)
+            commandBuffer.Submit();
+        commandBuffer.WaitForComplete();
+    });
+
+    runner.Run("graphics/command_buffer/record_submit_64_draws", 0, [&scene, &commandBuffer](uint64_t count) {
+        for (uint64_t i = 0; i < count; ++i) {
+            scene.BeginDraws(commandBuffer);
+            for (uint32_t j = 0; j < 64; ++j)
+                scene.Draw(commandBuffer, j);
+            commandBuffer.Submit();
+        }
+        commandBuffer.WaitForComplete();
+    });
+
+    // DynamicDescriptorHeap is internal to CommandBuffer. Cost of Commit() per draw is the difference between draws
+    // that keep their descriptor table and draws that bind a new descriptor table.
+    const BenchmarkResult *result = runner.Run("graphics/draw/static_descriptors", 0, [&](uint64_t count) {
+        RecordDraws(scene, commandBuffer, count, false);
+    });
+
+    const double baseline = (result != nullptr) ? result->medianTime : std::numeric_limits<double>::quiet_NaN();
+
+    BenchmarkResult *commit = runner.Run("graphics/draw/descriptor_commit", 0, [&](uint64_t count) {
+        RecordDraws(scene, commandBuffer, count, true);
+    });
+
+    if (commit != nullptr)
+        commit->metrics.push_back({"commit_time", commit->medianTime - baseline, "ns"});
+}
+
+static auto RunUploadBenchmarks(BenchmarkRunner &runner, CommandBuffer &commandBuffer) -> void {
+    const size_t sizes[] = {256, 64 * 1024, 1024 * 1024};
+    const size_t maxSize = sizes[_countof(sizes) - 1];
+
+    const std::vector<uint8_t> data(maxSize, 0xCD);
+    GpuBuffer                  dest(maxSize);
+
+    for (size_t size : sizes) {
+        runner.Run("graphics/temp_upload/" + std::to_string(size), size, [&, size](uint64_t count) {
+            size_t   pendingBytes  = 0;
+            uint64_t pendingCopies = 0;
+
+            // Submit regularly so that upload pages are recycled as in a real frame.
+            for (uint64_t i = 0; i < count; ++i) {
+                commandBuffer.CopyBuffer(data.data(), dest, 0, size);
+
+                pendingBytes += size;
+                pendingCopies += 1;
+                if (pendingBytes >= UPLOAD_BYTES_PER_SUBMIT || pendingCopies >= UPLOADS_PER_SUBMIT) {
+                    commandBuffer.Submit();
+                    pendingBytes  = 0;
+                    pendingCopies = 0;
+                }
+            }
+
+            commandBuffer.Submit();
+            commandBuffer.WaitForComplete();
+        });
+    }
+}
+
+static auto RunDescriptorAllocatorBenchmarks(BenchmarkRunner &runner) -> void {
+    CpuDescriptorAllocator allocator;
+    allocator.Initialize(RenderDevice::Singleton().Device(), D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+
+    std::vector<CpuDescriptorHandle> handles(DESCRIPTOR_BATCH_SIZE);
+
+    runner.Run("graphics/cpu_descriptor_allocator/allocate_free", 0, [&](uint64_t count) {
+        for (uint64_t i = 0; i < count; i += DESCRIPTOR_BATCH_SIZE) {
+            const size_t batchSize = static_cast<size_t>(std::min(DESCRIPTOR_BATCH_SIZE, count - i));
+
+            for (size_t j = 0; j < batchSize; ++j)
+                handles[j] = allocator.Allocate();
+            for (size_t j = 0; j < batchSize; ++j)
+                allocator.Free(handles[j]);
+        }
+    });
+
+    runner.Run("graphics/cpu_descriptor_allocator/allocate_free_contiguous_8", 0, [&](uint64_t count) {
+        for (uint64_t i = 0; i < count; i += DESCRIPTOR_BATCH_SIZE) {
+            const size_t batchSize = static_cast<size_t>(std::min(DESCRIPTOR_BATCH_SIZE, count - i));
+
+            for (size_t j = 0; j < batchSize; ++j)
+                handles[j] = allocator.AllocateContiguous(8);
+            for (size_t j = 0; j < batchSize; ++j)
+                allocator.FreeContiguous(handles[j], 8);
+        }
+    });
+}
+
+static auto RunStressScene(BenchmarkRunner &runner, BenchmarkScene &scene, CommandBuffer &commandBuffer) -> void {
+    const uint32_t    drawCount  = runner.Options().stressDrawCount;
+    const uint32_t    frameCount = runner.Options().stressFrameCount;
+    const std::string name       = "scene/stress/" + std::to_string(drawCount);
+
+    if (!runner.IsEnabled(name))
+        return;
+
+    RenderDevice &device = RenderDevice::Singleton();
+    GpuProfiler   profiler;
+
+    std::vector<double> cpuTimes;
+    std::vector<double> gpuTimes;
+    std::vector<double> frameTimes;
+
+    cpuTimes.reserve(frameCount);
+    gpuTimes.reserve(frameCount);
+    frameTimes.reserve(frameCount);
+
+#ifdef YAGE_ENABLE_PROFILER
+    uint64_t counters[static_cast<size_t>(ProfileCounter::Count)]{};
+#endif
+
+    uint64_t syncPoints[MAX_FRAMES_IN_FLIGHT]{};
+    uint64_t lastFrameEnd = BenchmarkRunner::Now();
+
+    for (uint32_t frame = 0; frame < STRESS_WARMUP_FRAMES + frameCount; ++frame) {
+        uint64_t &syncPoint = syncPoints[frame % MAX_FRAMES_IN_FLIGHT];
+        if (syncPoint != 0)
+            device.Sync(syncPoint);
+
+        // CPU frame time covers recording and submission only.
+        const uint64_t begin = BenchmarkRunner::Now();
+        const uint32_t scope = profiler.BeginScope(commandBuffer, u"StressScene");
+
+        scene.BeginDraws(commandBuffer);
+        commandBuffer.ClearColor(scene.RenderTarget());
+
+        for (uint32_t i = 0; i < drawCount; ++i) {
+            if (i % DRAWS_PER_MATERIAL == 0)
+                commandBuffer.SetGraphicsDescriptor(1, 0, scene.Palette((i / DRAWS_PER_MATERIAL) % 2));
+            scene.Draw(commandBuffer, i);
+        }
+
+        profiler.EndScope(commandBuffer, scope);
+        profiler.Resolve(commandBuffer);
+        syncPoint = commandBuffer.Submit();
+
+        const uint64_t end = BenchmarkRunner::Now();
+        profiler.EndFrame(syncPoint);
+
+#ifdef YAGE_ENABLE_PROFILER
+        Profiler::Singleton().EndFrame();
+#endif
+
+        if (frame >= STRESS_WARMUP_FRAMES) {
+            cpuTimes.push_back(static_cast<double>(end - begin) * 1e-6);
+            frameTimes.push_back(static_cast<double>(end - lastFrameEnd) * 1e-6);
+
+            // GPU times are read back a few frames later. The latest finished frame is sampled every frame.
+            if (profiler.FrameTime() > 0.0)
+                gpuTimes.push_back(profiler.FrameTime());
+
+#ifdef YAGE_ENABLE_PROFILER
+            const FrameStatistics statistics = Profiler::Singleton().LastFrameStatistics();
+            for (size_t i = 0; i < static_cast<size_t>(ProfileCounter::Count); ++i)
+                counters[i] += statistics.counters[i];
+#endif
+        }
+
+        lastFrameEnd = end;
+    }
+
+    device.Sync();
+
+    std::sort(cpuTimes.begin(), cpuTimes.end());
+    std::sort(gpuTimes.begin(), gpuTimes.end());
+    std::sort(frameTimes.begin(), frameTimes.end());
+
+    // Times of the result are CPU time per draw, so that results of different draw counts are comparable.
+    const double toDrawTime = 1e6 / static_cast<double>(drawCount);
+
+    BenchmarkResult result;
+    result.name              = name;
+    result.operations        = drawCount;
+    result.samples           = frameCount;
+    result.medianTime        = Percentile(cpuTimes, 0.5) * toDrawTime;
+    result.minTime           = cpuTimes.front() * toDrawTime;
+    result.maxTime           = cpuTimes.back() * toDrawTime;
+    result.bytesPerOperation = 0;
+    result.metrics           = {
+        {"cpu_frame_time_median", Percentile(cpuTimes, 0.5), "ms"},
+        {"cpu_frame_time_p95", Percentile(cpuTimes, 0.95), "ms"},
+        {"cpu_frame_time_p99", Percentile(cpuTimes, 0.99), "ms"},
+        {"gpu_frame_time_median", Percentile(gpuTimes, 0.5), "ms"},
+        {"gpu_frame_time_p95", Percentile(gpuTimes, 0.95), "ms"},
+        {"gpu_frame_time_p99", Percentile(gpuTimes, 0.99), "ms"},
+        {"frame_time_median", Percentile(frameTimes, 0.5), "ms"},
+        {"frame_time_p99", Percentile(frameTimes, 0.99), "ms"},
+    };
+
+#ifdef YAGE_ENABLE_PROFILER
+    for (size_t i = 0; i < static_cast<size_t>(ProfileCounter::Count); ++i) {
+        const char *counterName = Profiler::CounterName(static_cast<ProfileCounter>(i));
+        result.metrics.push_back({std::string("counter/") + counterName,
+                                  static_cast<double>(counters[i]) / static_cast<double>(frameCount), "per_frame"});
+    }
+#endif
+
+    runner.AddResult(std::move(result));
+}
+
+auto RunGraphicsBenchmarks(BenchmarkRunner &runner) -> void {
+    { // Record the adapter so that results of different machines are never compared by accident.
+        DXGI_ADAPTER_DESC1 desc;
+        if (SUCCEEDED(RenderDevice::Singleton().Adapter()->GetDesc1(&desc)))
+            runner.AddContext("adapter", ToUtf8(reinterpret_cast<const char16_t *>(desc.Description)));
+    }
+
+    CommandBuffer  commandBuffer;
+    BenchmarkScene scene(commandBuffer);
+
+    RunCommandBufferBenchmarks(runner, scene, commandBuffer);
+    RunUploadBenchmarks(runner, commandBuffer);
+    RunDescriptorAllocatorBenchmarks(runner);
+    RunStressScene(runner, scene, commandBuffer);
+}
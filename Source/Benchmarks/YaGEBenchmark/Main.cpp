@@ -0,0 +1,130 @@
+#include "Benchmark.h"
+
+#include <YaGE/Core/Exception.h>
+#include <YaGE/Core/Unicode.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cwchar>
+#include <iostream>
+#include <sstream>
+
+using namespace YaGE;
+
+static auto PrintUsage() -> void {
+    std::cout << "Usage: YaGEBenchmark [options]\n"
+                 "  --filter <text>      Only run benchmarks whose name contains <text>.\n"
+                 "  --output <file>      Write JSON results to <file> instead of standard output.\n"
+                 "  --min-time <second>  Minimum time of each microbenchmark sample. Default is 0.1.\n"
+                 "  --samples <count>    Number of samples of each microbenchmark. Default is 5.\n"
+                 "  --draws <count>      Number of draws per frame of the stress scene. Default is 10000.\n"
+                 "  --frames <count>     Number of measured frames of the stress scene. Default is 300.\n"
+                 "  --image <file>       Image to be loaded by image benchmarks. Skipped if not set.\n"
+                 "  --cpu-only           Skip benchmarks that require a GPU.\n"
+              << std::endl;
+}
+
+static auto ParseCount(const wchar_t *value) -> uint32_t {
+    wchar_t                 *end    = nullptr;
+    const unsigned long long result = std::wcstoull(value, &end, 10);
+    if (end == value || *end != L'\0' || result == 0 || result > UINT32_MAX)
+        throw Exception(Format(u"Invalid count: {}.", reinterpret_cast<const char16_t *>(value)));
+    return static_cast<uint32_t>(result);
+}
+
+static auto ParseSecond(const wchar_t *value) -> double {
+    wchar_t     *end    = nullptr;
+    const double result = std::wcstod(value, &end);
+    if (end == value || *end != L'\0' || !(result > 0.0))
+        throw Exception(Format(u"Invalid time: {}.", reinterpret_cast<const char16_t *>(value)));
+    return result;
+}
+
+/// Run all benchmarks and write results as JSON.
+///
+/// Progress is written to standard error, so that JSON could be redirected from standard output. Exit code is not 0 if
+/// any benchmark failed to run, so that scripts never compare partial results.
+auto wmain(int argc, wchar_t **argv) -> int {
+    try {
+        BenchmarkOptions options;
+        options.minSampleTime    = 0.1;
+        options.sampleCount      = 5;
+        options.stressDrawCount  = 10000;
+        options.stressFrameCount = 300;
+
+        const wchar_t *outputPath = nullptr;
+        bool           cpuOnly    = false;
+
+        for (int i = 1; i < argc; ++i) {
+            const StringView arg(reinterpret_cast<const char16_t *>(argv[i]));
+
+            if (arg == u"--cpu-only") {
+                cpuOnly = true;
+                continue;
+            }
+
+            if (arg == u"--help") {
+                PrintUsage();
+                return 0;
+            }
+
+            if (i + 1 >= argc) {
+                PrintUsage();
+                return 1;
+            }
+
+            const wchar_t *value = argv[++i];
+            if (arg == u"--filter") {
+                options.filter = ToUtf8(reinterpret_cast<const char16_t *>(value));
+            } else if (arg == u"--output") {
+                outputPath = value;
+            } else if (arg == u"--min-time") {
+                options.minSampleTime = ParseSecond(value);
+            } else if (arg == u"--samples") {
+                options.sampleCount = ParseCount(value);
+            } else if (arg == u"--draws") {
+                options.stressDrawCount = ParseCount(value);
+            } else if (arg == u"--frames") {
+                options.stressFrameCount = ParseCount(value);
+            } else if (arg == u"--image") {
+                options.imagePath = String(reinterpret_cast<const char16_t *>(value));
+            } else {
+                PrintUsage();
+                return 1;
+            }
+        }
+
+        BenchmarkRunner runner(options);
+
+        RunCoreBenchmarks(runner);
+        if (!cpuOnly)
+            RunGraphicsBenchmarks(runner);
+
+        std::ostringstream json;
+        runner.WriteJson(json);
+
+        if (outputPath == nullptr) {
+            std::cout << json.str() << std::flush;
+            return 0;
+        }
+
+        FILE *file = _wfopen(outputPath, L"wb");
+        if (file == nullptr)
+            throw Exception(Format(u"Failed to open file: {}.", reinterpret_cast<const char16_t *>(outputPath)));
+
+        const std::string content = json.str();
+        const size_t      written = fwrite(content.data(), 1, content.size(), file);
+        fclose(file);
+
+        if (written != content.size())
+            throw Exception(Format(u"Failed to write file: {}.", reinterpret_cast<const char16_t *>(outputPath)));
+    } catch (const SystemErrorException &e) {
+        std::cerr << ToUtf8(e.Message()) << " Error code: 0x" << std::hex << uint32_t(e.ErrorCode()) << std::endl;
+        return 1;
+    } catch (const Exception &e) {
+        std::cerr << ToUtf8(e.Message()) << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
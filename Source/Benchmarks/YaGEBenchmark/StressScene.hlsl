@@ -0,0 +1,34 @@
+struct DrawConstants {
+    float4 transform; // xy: offset, zw: scale.
+    uint   colorIndex;
+};
+
+ConstantBuffer<DrawConstants> drawConstants : register(b0);
+RWStructuredBuffer<float4>    palette       : register(u0);
+
+struct VertexOutput {
+    float4 position : SV_POSITION;
+    float4 color    : COLOR;
+};
+
+typedef VertexOutput PixelInput;
+
+VertexOutput VertexMain(uint vertexID : SV_VertexID) {
+    // Each draw is a single triangle generated from vertex ID.
+    const float2 corners[3] = {
+        float2(0.0f, 1.0f),
+        float2(1.0f, -1.0f),
+        float2(-1.0f, -1.0f),
+    };
+
+    VertexOutput output;
+
+    output.position = float4(corners[vertexID] * drawConstants.transform.zw + drawConstants.transform.xy, 0.0f, 1.0f);
+    output.color    = palette[drawConstants.colorIndex];
+
+    return output;
+}
+
+float4 PixelMain(PixelInput pixel) : SV_TARGET {
+    return pixel.color;
+}
@@ -1,31 +1,13 @@
 #include <YaGE/Core/Exception.h>
 #include <YaGE/Core/Window.h>
 #include <YaGE/Graphics/CommandBuffer.h>
+#include <YaGE/Graphics/ShaderLibrary.h>
 #include <YaGE/Graphics/SwapChain.h>
 
 #include <memory>
 
 using namespace YaGE;
 
-static auto LoadBinary(const String &path) -> std::vector<uint8_t> {
-    HANDLE fileHandle = CreateFileW(reinterpret_cast<LPCWSTR>(path.Data()), GENERIC_READ, FILE_SHARE_READ, nullptr,
-                                    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
-    if (fileHandle == INVALID_HANDLE_VALUE)
-        throw SystemErrorException(GetLastError());
-
-    LARGE_INTEGER fileSize;
-    if (!GetFileSizeEx(fileHandle, &fileSize)) {
-        CloseHandle(fileHandle);
-        throw SystemErrorException(GetLastError());
-    }
-
-    std::vector<uint8_t> buffer(fileSize.QuadPart);
-    ReadFile(fileHandle, buffer.data(), static_cast<DWORD>(fileSize.QuadPart), nullptr, nullptr);
-    CloseHandle(fileHandle);
-
-    return buffer;
-}
-
 struct Vertex {
     float position[4];
     Color color;
@@ -87,8 +69,7 @@ auto Application::CreateRootSignature() -> void {
 }
 
 auto Application::CreateGraphicsPipelineState() -> void {
-    std::vector<uint8_t> vertexShader(LoadBinary(u"Shaders/HelloTriangle.vso"));
-    std::vector<uint8_t> pixelShader(LoadBinary(u"Shaders/HelloTriangle.pso"));
+    ShaderLibrary shaderLibrary(u"Shaders/HelloTriangle.yshl");
 
     D3D12_INPUT_ELEMENT_DESC inputElements[]{
         {"POSITION", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 0, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
@@ -98,10 +79,8 @@ auto Application::CreateGraphicsPipelineState() -> void {
     D3D12_GRAPHICS_PIPELINE_STATE_DESC desc{};
 
     desc.pRootSignature                        = rootSignature->D3D12RootSignature();
-    desc.VS.BytecodeLength                     = vertexShader.size();
-    desc.VS.pShaderBytecode                    = vertexShader.data();
-    desc.PS.BytecodeLength                     = pixelShader.size();
-    desc.PS.pShaderBytecode                    = pixelShader.data();
+    desc.VS                                    = shaderLibrary.Bytecode(u"HelloTriangle.vso");
+    desc.PS                                    = shaderLibrary.Bytecode(u"HelloTriangle.pso");
     desc.InputLayout.pInputElementDescs        = inputElements;
     desc.InputLayout.NumElements               = _countof(inputElements);
     desc.RasterizerState.FillMode              = D3D12_FILL_MODE_SOLID;
@@ -156,6 +135,9 @@ auto Application::Run() -> void {
 }
 
 auto Application::Update() -> void {
+    // Wait for swap chain to limit frame latency.
+    swapChain.WaitForNextFrame();
+
     auto &backBuffer = swapChain.CurrentBackBuffer();
 
     commandBuffer.Transition(backBuffer, D3D12_RESOURCE_STATE_RENDER_TARGET);
@@ -55,6 +55,9 @@ auto Application::Run() -> void {
 }
 
 auto Application::Update() -> void {
+    // Wait for swap chain to limit frame latency.
+    swapChain.WaitForNextFrame();
+
     auto &backBuffer = swapChain.CurrentBackBuffer();
 
     commandBuffer.Transition(backBuffer, D3D12_RESOURCE_STATE_RENDER_TARGET);
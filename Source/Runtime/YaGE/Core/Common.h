@@ -30,6 +30,14 @@
 #    define YAGE_CONSTEXPR20 inline
 #endif
 
+// Evaluates to true in constant evaluation. Compilers without the builtin always take the constexpr path.
+#if (defined(__clang__) && __clang_major__ >= 9) || (!defined(__clang__) && defined(__GNUC__) && __GNUC__ >= 9) ||     \
+    (!defined(__clang__) && defined(_MSC_VER) && _MSC_VER >= 1925)
+#    define YAGE_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#else
+#    define YAGE_IS_CONSTANT_EVALUATED() true
+#endif
+
 #if defined(__clang__) || defined(__GNUC__)
 #    define YAGE_NODISCARD __attribute__((warn_unused_result))
 #elif defined(_MSC_VER) && (_MSC_VER >= 1700)
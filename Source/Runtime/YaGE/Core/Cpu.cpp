@@ -0,0 +1,45 @@
+#include "Cpu.h"
+
+#include <immintrin.h>
+#include <intrin.h>
+
+using namespace YaGE;
+
+// GCC and clang only allow _xgetbv() in functions that enable XSAVE. Enable it for the detection function only, so that
+// the rest of this file does not require XSAVE.
+#if defined(__clang__) || defined(__GNUC__)
+#    define YAGE_TARGET_XSAVE __attribute__((target("xsave")))
+#else
+#    define YAGE_TARGET_XSAVE
+#endif
+
+namespace {
+
+/// @brief
+///   Detect AVX2 and FMA support with cpuid instructions.
+YAGE_NODISCARD YAGE_TARGET_XSAVE auto DetectAvx2() noexcept -> bool {
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+
+    // FMA, OSXSAVE and AVX.
+    __cpuid(info, 1);
+    constexpr const int leaf1Mask = (1 << 12) | (1 << 27) | (1 << 28);
+    if ((info[2] & leaf1Mask) != leaf1Mask)
+        return false;
+
+    // Operating system must save both XMM and YMM registers.
+    if ((_xgetbv(0) & 0x6) != 0x6)
+        return false;
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+}
+
+} // namespace
+
+auto YaGE::IsAvx2Supported() noexcept -> bool {
+    static const bool supported = DetectAvx2();
+    return supported;
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "Common.h"
+
+namespace YaGE {
+
+/// @brief
+///   Checks if current processor and operating system support AVX2 and FMA instructions. The result is detected once and cached.
+/// @remarks
+///   SIMD kernels that are compiled with AVX2 enabled must only be called if this function returns true.
+///
+/// @return bool
+/// @retval true    AVX2 and FMA instructions are supported.
+/// @retval false   AVX2 or FMA instructions are not supported.
+YAGE_NODISCARD YAGE_API auto IsAvx2Supported() noexcept -> bool;
+
+} // namespace YaGE
@@ -1,7 +1,12 @@
 #include "Hash.h"
+#include "Cpu.h"
+#include "HashKernels.h"
 
 #include <cstring>
 
+#include <emmintrin.h>
+#include <intrin.h>
+
 using namespace YaGE;
 
 YAGE_NODISCARD auto YaGE::Hash32(const void *data, size_t size, uint32_t seed) noexcept -> uint32_t {
@@ -191,3 +196,359 @@ YAGE_NODISCARD auto YaGE::Hash64(const void *data, size_t size, uint64_t seed) n
 
     return h64;
 }
+
+namespace {
+
+constexpr const uint32_t PRIME32_2 = 0x85EBCA77U;
+constexpr const uint32_t PRIME32_3 = 0xC2B2AE3DU;
+constexpr const uint64_t PRIME64_1 = 0x9E3779B185EBCA87ULL;
+constexpr const uint64_t PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr const uint64_t PRIME64_3 = 0x165667B19E3779F9ULL;
+constexpr const uint64_t PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+constexpr const uint64_t PRIME64_5 = 0x27D4EB2F165667C5ULL;
+constexpr const uint64_t PRIME_MX1 = 0x165667919E3779F9ULL;
+constexpr const uint64_t PRIME_MX2 = 0x9FB21C651E98DF25ULL;
+
+/// @brief  Seed of the high 64 bits of 128-bit hash values of short inputs.
+constexpr const uint64_t HIGH_SEED = 0x7FEB352D4AD8A9CBULL;
+
+/// @brief
+///   Pseudo-random secret that is mixed with the input. Generated with splitmix64.
+YAGE_ALIGNAS(64) constexpr const uint8_t HASH_SECRET[FAST_HASH_SECRET_SIZE]{
+    0x21, 0xA2, 0xBE, 0x4A, 0x9F, 0xF6, 0xB0, 0x2C, 0x89, 0x89, 0x14, 0x23, 0x47, 0x03, 0x17, 0x94, 0x03, 0xFE, 0x9D,
+    0x60, 0x50, 0x59, 0x55, 0xDD, 0x00, 0x28, 0xB1, 0xDE, 0x50, 0xB1, 0xAF, 0xDB, 0xB6, 0x2C, 0x44, 0x6C, 0x2E, 0x9B,
+    0x78, 0x7E, 0xC4, 0xF8, 0xE4, 0xC7, 0x36, 0x56, 0x1E, 0xF4, 0xE4, 0xA7, 0xFB, 0xF8, 0x50, 0xD1, 0x59, 0x09, 0xEA,
+    0x9E, 0xDB, 0x3C, 0xF1, 0x16, 0x73, 0xA9, 0x68, 0x00, 0x52, 0xF9, 0x58, 0x82, 0xCD, 0x74, 0x8B, 0x86, 0x16, 0xE1,
+    0x62, 0x4A, 0xC7, 0x55, 0xBD, 0x3C, 0x02, 0xA2, 0x99, 0xC7, 0xF4, 0xD2, 0xB9, 0x51, 0x7B, 0xA3, 0x79, 0xCB, 0x98,
+    0xDF, 0x05, 0x39, 0x4F, 0x52, 0x85, 0x58, 0x6F, 0x39, 0x76, 0xB2, 0xA3, 0x6C, 0x38, 0x56, 0x1D, 0xAF, 0x5A, 0xE8,
+    0x04, 0x51, 0x6B, 0xBE, 0xFF, 0xA9, 0xB3, 0x33, 0xD5, 0x9F, 0x1B, 0xC5, 0xD0, 0x6B, 0x56, 0x4B, 0xAB, 0x50, 0x1C,
+    0xE9, 0x0C, 0x98, 0xC5, 0x62, 0xFE, 0x80, 0x57, 0x39, 0xAC, 0x28, 0xC7, 0xED, 0xBC, 0xA6, 0xE3, 0x12, 0x89, 0x76,
+    0x88, 0x7C, 0x2C, 0x33, 0xC9, 0xE8, 0xB3, 0x50, 0xDA, 0x47, 0xBD, 0x20, 0xE5, 0xBF, 0x3B, 0xCE, 0x4F, 0x7C, 0xBB,
+    0xE0, 0xE8, 0xC8, 0xA6, 0xCB, 0x6D, 0x34, 0x4A, 0x43, 0xB8, 0x4D, 0x19, 0xBF, 0x7F, 0x6D, 0x41, 0x60, 0x7B, 0x2A,
+    0x8F, 0x7D,
+};
+
+YAGE_FORCEINLINE auto Read32(const uint8_t *p) noexcept -> uint32_t {
+    uint32_t value;
+    memcpy(&value, p, sizeof(value)); // Avoid alignment problem.
+    return value;
+}
+
+YAGE_FORCEINLINE auto Read64(const uint8_t *p) noexcept -> uint64_t {
+    uint64_t value;
+    memcpy(&value, p, sizeof(value)); // Avoid alignment problem.
+    return value;
+}
+
+YAGE_FORCEINLINE auto Write64(uint8_t *p, uint64_t value) noexcept -> void {
+    memcpy(p, &value, sizeof(value));
+}
+
+YAGE_FORCEINLINE auto Swap32(uint32_t value) noexcept -> uint32_t {
+#if defined(_MSC_VER)
+    return _byteswap_ulong(value);
+#else
+    return __builtin_bswap32(value);
+#endif
+}
+
+YAGE_FORCEINLINE auto Swap64(uint64_t value) noexcept -> uint64_t {
+#if defined(_MSC_VER)
+    return _byteswap_uint64(value);
+#else
+    return __builtin_bswap64(value);
+#endif
+}
+
+YAGE_FORCEINLINE auto Rotl64(uint64_t value, int shift) noexcept -> uint64_t {
+    return (value << shift) | (value >> (64 - shift));
+}
+
+/// @brief
+///   Multiply two 64-bit integers to a 128-bit integer.
+YAGE_FORCEINLINE auto Mul128(uint64_t lhs, uint64_t rhs) noexcept -> Hash128 {
+#if defined(_MSC_VER) && defined(_M_X64)
+    Hash128 result;
+    result.low = _umul128(lhs, rhs, &result.high);
+    return result;
+#elif defined(__SIZEOF_INT128__)
+    const unsigned __int128 product = static_cast<unsigned __int128>(lhs) * rhs;
+    return Hash128{static_cast<uint64_t>(product), static_cast<uint64_t>(product >> 64)};
+#else
+    const uint64_t lowLow   = (lhs & 0xFFFFFFFFULL) * (rhs & 0xFFFFFFFFULL);
+    const uint64_t highLow  = (lhs >> 32) * (rhs & 0xFFFFFFFFULL);
+    const uint64_t lowHigh  = (lhs & 0xFFFFFFFFULL) * (rhs >> 32);
+    const uint64_t highHigh = (lhs >> 32) * (rhs >> 32);
+    const uint64_t cross    = (lowLow >> 32) + (highLow & 0xFFFFFFFFULL) + lowHigh;
+    return Hash128{(cross << 32) | (lowLow & 0xFFFFFFFFULL), (highLow >> 32) + (cross >> 32) + highHigh};
+#endif
+}
+
+/// @brief
+///   Multiply two 64-bit integers and fold the 128-bit product to 64 bits.
+YAGE_FORCEINLINE auto Mul128Fold64(uint64_t lhs, uint64_t rhs) noexcept -> uint64_t {
+    const Hash128 product = Mul128(lhs, rhs);
+    return product.low ^ product.high;
+}
+
+/// @brief
+///   Final mix of xxhash64.
+YAGE_FORCEINLINE auto Avalanche64(uint64_t h64) noexcept -> uint64_t {
+    h64 ^= h64 >> 33;
+    h64 *= PRIME64_2;
+    h64 ^= h64 >> 29;
+    h64 *= PRIME64_3;
+    h64 ^= h64 >> 32;
+    return h64;
+}
+
+/// @brief
+///   Fast final mix for values that are already mixed by multiplications.
+YAGE_FORCEINLINE auto Avalanche(uint64_t h64) noexcept -> uint64_t {
+    h64 ^= h64 >> 37;
+    h64 *= PRIME_MX1;
+    h64 ^= h64 >> 32;
+    return h64;
+}
+
+/// @brief
+///   Stronger final mix for 4 to 8 byte inputs, whose keyed value is not multiplied yet.
+YAGE_FORCEINLINE auto Rrmxmx(uint64_t h64, uint64_t size) noexcept -> uint64_t {
+    h64 ^= Rotl64(h64, 49) ^ Rotl64(h64, 24);
+    h64 *= PRIME_MX2;
+    h64 ^= (h64 >> 35) + size;
+    h64 *= PRIME_MX2;
+    h64 ^= h64 >> 28;
+    return h64;
+}
+
+/// @brief
+///   Mix 16 bytes of input with 16 bytes of secret.
+YAGE_FORCEINLINE auto Mix16(const uint8_t *input, const uint8_t *secret, uint64_t seed) noexcept -> uint64_t {
+    return Mul128Fold64(Read64(input) ^ (Read64(secret) + seed), Read64(input + 8) ^ (Read64(secret + 8) - seed));
+}
+
+/// @brief
+///   Hash input of at most 16 bytes.
+auto HashShort(const uint8_t *input, size_t size, uint64_t seed) noexcept -> uint64_t {
+    const uint8_t *secret = HASH_SECRET;
+
+    if (size > 8) {
+        const uint64_t flip1 = (Read64(secret + 24) ^ Read64(secret + 32)) + seed;
+        const uint64_t flip2 = (Read64(secret + 40) ^ Read64(secret + 48)) - seed;
+        const uint64_t low   = Read64(input) ^ flip1;
+        const uint64_t high  = Read64(input + size - 8) ^ flip2;
+        return Avalanche(size + Swap64(low) + high + Mul128Fold64(low, high));
+    }
+
+    if (size >= 4) {
+        seed ^= static_cast<uint64_t>(Swap32(static_cast<uint32_t>(seed))) << 32;
+
+        const uint64_t flip  = (Read64(secret + 8) ^ Read64(secret + 16)) - seed;
+        const uint64_t value = Read32(input + size - 4) + (static_cast<uint64_t>(Read32(input)) << 32);
+        return Rrmxmx(value ^ flip, size);
+    }
+
+    if (size > 0) {
+        // Combine the first, middle and last bytes with the size. Each input of 1 to 3 bytes maps to a unique value.
+        const uint32_t combined = (static_cast<uint32_t>(input[0]) << 16) |
+                                  (static_cast<uint32_t>(input[size >> 1]) << 24) |
+                                  static_cast<uint32_t>(input[size - 1]) | (static_cast<uint32_t>(size) << 8);
+        const uint64_t flip     = (Read32(secret) ^ Read32(secret + 4)) + seed;
+        return Avalanche64(combined ^ flip);
+    }
+
+    return Avalanche64(seed ^ Read64(secret + 56) ^ Read64(secret + 64));
+}
+
+/// @brief
+///   Hash input of 17 to 128 bytes. 16-byte blocks are read from both ends of the input.
+auto HashMedium(const uint8_t *input, size_t size, uint64_t seed) noexcept -> uint64_t {
+    const uint8_t *secret = HASH_SECRET;
+
+    uint64_t acc = size * PRIME64_1;
+    if (size > 32) {
+        if (size > 64) {
+            if (size > 96) {
+                acc += Mix16(input + 48, secret + 96, seed);
+                acc += Mix16(input + size - 64, secret + 112, seed);
+            }
+            acc += Mix16(input + 32, secret + 64, seed);
+            acc += Mix16(input + size - 48, secret + 80, seed);
+        }
+        acc += Mix16(input + 16, secret + 32, seed);
+        acc += Mix16(input + size - 32, secret + 48, seed);
+    }
+    acc += Mix16(input, secret, seed);
+    acc += Mix16(input + size - 16, secret + 16, seed);
+
+    return Avalanche(acc);
+}
+
+/// @brief
+///   Hash input of 129 to 240 bytes.
+auto HashLarge(const uint8_t *input, size_t size, uint64_t seed) noexcept -> uint64_t {
+    const uint8_t *secret     = HASH_SECRET;
+    const size_t   roundCount = size / 16;
+
+    uint64_t acc = size * PRIME64_1;
+    for (size_t i = 0; i < 8; ++i)
+        acc += Mix16(input + i * 16, secret + i * 16, seed);
+    acc = Avalanche(acc);
+
+    // The secret is not long enough for all rounds. Reuse it with an offset.
+    for (size_t i = 8; i < roundCount; ++i)
+        acc += Mix16(input + i * 16, secret + (i - 8) * 16 + 3, seed);
+    acc += Mix16(input + size - 16, secret + FAST_HASH_SECRET_SIZE - 17, seed);
+
+    return Avalanche(acc);
+}
+
+/// @brief
+///   Hash input of at most 240 bytes.
+YAGE_FORCEINLINE auto HashUpTo240(const uint8_t *input, size_t size, uint64_t seed) noexcept -> uint64_t {
+    if (size <= 16)
+        return HashShort(input, size, seed);
+    if (size <= 128)
+        return HashMedium(input, size, seed);
+    return HashLarge(input, size, seed);
+}
+
+/// @brief
+///   SSE2 lanes that process one 64-byte stripe with four 128-bit registers.
+struct Sse2Lanes {
+    struct State {
+        __m128i acc[4];
+    };
+
+    static YAGE_FORCEINLINE auto Load(State &state, const uint64_t acc[8]) noexcept -> void {
+        for (size_t i = 0; i < 4; ++i)
+            state.acc[i] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(acc) + i);
+    }
+
+    static YAGE_FORCEINLINE auto Store(const State &state, uint64_t acc[8]) noexcept -> void {
+        for (size_t i = 0; i < 4; ++i)
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(acc) + i, state.acc[i]);
+    }
+
+    static YAGE_FORCEINLINE auto Accumulate(State &state, const uint8_t *input, const uint8_t *secret) noexcept
+        -> void {
+        for (size_t i = 0; i < 4; ++i) {
+            const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(input) + i);
+            const __m128i key  = _mm_loadu_si128(reinterpret_cast<const __m128i *>(secret) + i);
+
+            // Multiply low and high 32 bits of each keyed 64-bit lane, and add data to the neighbor lane.
+            const __m128i dataKey = _mm_xor_si128(data, key);
+            const __m128i keyHigh = _mm_shuffle_epi32(dataKey, _MM_SHUFFLE(0, 3, 0, 1));
+            const __m128i product = _mm_mul_epu32(dataKey, keyHigh);
+            const __m128i swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+
+            state.acc[i] = _mm_add_epi64(state.acc[i], _mm_add_epi64(product, swapped));
+        }
+    }
+
+    static YAGE_FORCEINLINE auto Scramble(State &state, const uint8_t *secret) noexcept -> void {
+        const __m128i prime = _mm_set1_epi32(static_cast<int>(FAST_HASH_PRIME32_1));
+        for (size_t i = 0; i < 4; ++i) {
+            const __m128i key = _mm_loadu_si128(reinterpret_cast<const __m128i *>(secret) + i);
+
+            __m128i acc = state.acc[i];
+            acc         = _mm_xor_si128(acc, _mm_srli_epi64(acc, 47));
+            acc         = _mm_xor_si128(acc, key);
+
+            // 64-bit multiplication by a 32-bit constant.
+            const __m128i high        = _mm_shuffle_epi32(acc, _MM_SHUFFLE(0, 3, 0, 1));
+            const __m128i productLow  = _mm_mul_epu32(acc, prime);
+            const __m128i productHigh = _mm_mul_epu32(high, prime);
+
+            state.acc[i] = _mm_add_epi64(productLow, _mm_slli_epi64(productHigh, 32));
+        }
+    }
+};
+
+/// @brief
+///   Accumulate input that is longer than 240 bytes.
+///
+/// @param[in]  input           Pointer to start of data to be hashed.
+/// @param      size            Size in byte of data to be hashed.
+/// @param      seed            Seed of hash algorithm.
+/// @param[out] acc             Receives the 8 accumulators.
+/// @param[out] customSecret    Buffer that is used to store the seeded secret.
+///
+/// @return const uint8_t *
+///   Return the secret that should be used to merge the accumulators.
+auto AccumulateLong(const uint8_t *input,
+                    size_t         size,
+                    uint64_t       seed,
+                    uint64_t       acc[8],
+                    uint8_t        customSecret[FAST_HASH_SECRET_SIZE]) noexcept -> const uint8_t * {
+    const uint8_t *secret = HASH_SECRET;
+    if (seed != 0) {
+        for (size_t i = 0; i < FAST_HASH_SECRET_SIZE; i += 16) {
+            Write64(customSecret + i, Read64(HASH_SECRET + i) + seed);
+            Write64(customSecret + i + 8, Read64(HASH_SECRET + i + 8) - seed);
+        }
+        secret = customSecret;
+    }
+
+    acc[0] = PRIME32_3;
+    acc[1] = PRIME64_1;
+    acc[2] = PRIME64_2;
+    acc[3] = PRIME64_3;
+    acc[4] = PRIME64_4;
+    acc[5] = PRIME32_2;
+    acc[6] = PRIME64_5;
+    acc[7] = FAST_HASH_PRIME32_1;
+
+    using AccumulateFunc = void (*)(uint64_t *, const uint8_t *, size_t, const uint8_t *);
+
+    static const AccumulateFunc accumulate =
+        IsAvx2Supported() ? &FastHashAccumulateAvx2 : &FastHashAccumulate<Sse2Lanes>;
+    accumulate(acc, input, size, secret);
+
+    return secret;
+}
+
+/// @brief
+///   Merge the 8 accumulators into a 64-bit hash value.
+YAGE_FORCEINLINE auto MergeAccumulators(const uint64_t acc[8], const uint8_t *secret, uint64_t start) noexcept
+    -> uint64_t {
+    uint64_t result = start;
+    for (size_t i = 0; i < 4; ++i)
+        result += Mul128Fold64(acc[i * 2] ^ Read64(secret + i * 16), acc[i * 2 + 1] ^ Read64(secret + i * 16 + 8));
+    return Avalanche(result);
+}
+
+} // namespace
+
+YAGE_NODISCARD auto YaGE::FastHash64(const void *data, size_t size, uint64_t seed) noexcept -> uint64_t {
+    const uint8_t *input = static_cast<const uint8_t *>(data);
+    if (size <= 240)
+        return HashUpTo240(input, size, seed);
+
+    uint64_t acc[8];
+    YAGE_ALIGNAS(16) uint8_t customSecret[FAST_HASH_SECRET_SIZE];
+
+    const uint8_t *secret = AccumulateLong(input, size, seed, acc, customSecret);
+    return MergeAccumulators(acc, secret + 11, size * PRIME64_1);
+}
+
+YAGE_NODISCARD auto YaGE::FastHash128(const void *data, size_t size, uint64_t seed) noexcept -> Hash128 {
+    const uint8_t *input = static_cast<const uint8_t *>(data);
+    if (size <= 240) {
+        // Short paths are cheap enough to be hashed twice with independent seeds.
+        return Hash128{
+            HashUpTo240(input, size, seed),
+            HashUpTo240(input, size, seed ^ HIGH_SEED),
+        };
+    }
+
+    uint64_t acc[8];
+    YAGE_ALIGNAS(16) uint8_t customSecret[FAST_HASH_SECRET_SIZE];
+
+    const uint8_t *secret = AccumulateLong(input, size, seed, acc, customSecret);
+    return Hash128{
+        MergeAccumulators(acc, secret + 11, size * PRIME64_1),
+        MergeAccumulators(acc, secret + FAST_HASH_SECRET_SIZE - FAST_HASH_STRIPE_LENGTH - 11, ~(size * PRIME64_2)),
+    };
+}
@@ -33,6 +33,50 @@ YAGE_NODISCARD YAGE_API auto Hash32(const void *data, size_t size, uint32_t seed
 ///   Return hash value of the specified data.
 YAGE_NODISCARD YAGE_API auto Hash64(const void *data, size_t size, uint64_t seed = 0) noexcept -> uint64_t;
 
+/// @brief
+///   128-bit hash value.
+struct Hash128 {
+    /// @brief  Low 64 bits of the hash value.
+    uint64_t low;
+
+    /// @brief  High 64 bits of the hash value.
+    uint64_t high;
+
+    YAGE_NODISCARD YAGE_FORCEINLINE constexpr auto operator==(const Hash128 &rhs) const noexcept -> bool {
+        return low == rhs.low && high == rhs.high;
+    }
+
+    YAGE_NODISCARD YAGE_FORCEINLINE constexpr auto operator!=(const Hash128 &rhs) const noexcept -> bool {
+        return low != rhs.low || high != rhs.high;
+    }
+};
+
+/// @brief
+///   Calculate 64-bit hash value of a range of data.
+/// @remarks
+///   An XXH3-style algorithm is used here. Inputs up to 240 bytes are hashed with dedicated short paths, and longer inputs are accumulated in 64-byte stripes with SSE2 or AVX2 instructions. Hash values are not compatible with XXH3 and may be different from @p Hash64().
+///
+/// @param[in] data		Pointer to start of data to be hashed.
+/// @param	   size		Size in byte of data to be hashed.
+/// @param	   seed		Seed of hash algorithm. Hashing the same data with different seed value will generate different result.
+///
+/// @return uint64_t
+///   Return hash value of the specified data.
+YAGE_NODISCARD YAGE_API auto FastHash64(const void *data, size_t size, uint64_t seed = 0) noexcept -> uint64_t;
+
+/// @brief
+///   Calculate 128-bit hash value of a range of data. This is useful for keys that are compared by hash value only, such as cached pipeline states.
+/// @remarks
+///   The same algorithm as @p FastHash64() is used here. Low 64 bits of the result are always equal to @p FastHash64() of the same data and seed.
+///
+/// @param[in] data		Pointer to start of data to be hashed.
+/// @param	   size		Size in byte of data to be hashed.
+/// @param	   seed		Seed of hash algorithm. Hashing the same data with different seed value will generate different result.
+///
+/// @return Hash128
+///   Return hash value of the specified data.
+YAGE_NODISCARD YAGE_API auto FastHash128(const void *data, size_t size, uint64_t seed = 0) noexcept -> Hash128;
+
 /// @brief
 ///   Calculate hash value of a range of data.
 ///
@@ -48,7 +92,7 @@ YAGE_NODISCARD YAGE_FORCEINLINE auto Hash(const void *data, size_t size, size_t
 #    pragma warning(disable : 4127)
 #endif
     if YAGE_IF_CONSTEXPR (sizeof(size_t) >= sizeof(uint64_t))
-        return Hash64(data, size, static_cast<uint64_t>(seed));
+        return FastHash64(data, size, static_cast<uint64_t>(seed));
     else
         return Hash32(data, size, static_cast<uint32_t>(seed));
 #if defined(_MSC_VER)
@@ -0,0 +1,65 @@
+// This file is compiled with AVX2 enabled. Functions in this file are only called if the processor supports AVX2.
+#include "HashKernels.h"
+
+using namespace YaGE;
+
+namespace {
+
+/// @brief
+///   AVX2 lanes that process one 64-byte stripe with two 256-bit registers.
+struct Avx2Lanes {
+    struct State {
+        __m256i acc[2];
+    };
+
+    static YAGE_FORCEINLINE auto Load(State &state, const uint64_t acc[8]) noexcept -> void {
+        state.acc[0] = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(acc));
+        state.acc[1] = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(acc) + 1);
+    }
+
+    static YAGE_FORCEINLINE auto Store(const State &state, uint64_t acc[8]) noexcept -> void {
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(acc), state.acc[0]);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(acc) + 1, state.acc[1]);
+    }
+
+    static YAGE_FORCEINLINE auto Accumulate(State &state, const uint8_t *input, const uint8_t *secret) noexcept
+        -> void {
+        for (size_t i = 0; i < 2; ++i) {
+            const __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(input) + i);
+            const __m256i key  = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(secret) + i);
+
+            // Multiply low and high 32 bits of each keyed 64-bit lane, and add data to the neighbor lane.
+            const __m256i dataKey = _mm256_xor_si256(data, key);
+            const __m256i keyHigh = _mm256_shuffle_epi32(dataKey, _MM_SHUFFLE(0, 3, 0, 1));
+            const __m256i product = _mm256_mul_epu32(dataKey, keyHigh);
+            const __m256i swapped = _mm256_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+
+            state.acc[i] = _mm256_add_epi64(state.acc[i], _mm256_add_epi64(product, swapped));
+        }
+    }
+
+    static YAGE_FORCEINLINE auto Scramble(State &state, const uint8_t *secret) noexcept -> void {
+        const __m256i prime = _mm256_set1_epi32(static_cast<int>(FAST_HASH_PRIME32_1));
+        for (size_t i = 0; i < 2; ++i) {
+            const __m256i key = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(secret) + i);
+
+            __m256i acc = state.acc[i];
+            acc         = _mm256_xor_si256(acc, _mm256_srli_epi64(acc, 47));
+            acc         = _mm256_xor_si256(acc, key);
+
+            // 64-bit multiplication by a 32-bit constant.
+            const __m256i high        = _mm256_shuffle_epi32(acc, _MM_SHUFFLE(0, 3, 0, 1));
+            const __m256i productLow  = _mm256_mul_epu32(acc, prime);
+            const __m256i productHigh = _mm256_mul_epu32(high, prime);
+
+            state.acc[i] = _mm256_add_epi64(productLow, _mm256_slli_epi64(productHigh, 32));
+        }
+    }
+};
+
+} // namespace
+
+auto YaGE::FastHashAccumulateAvx2(uint64_t acc[8], const uint8_t *input, size_t size, const uint8_t *secret) noexcept
+    -> void {
+    FastHashAccumulate<Avx2Lanes>(acc, input, size, secret);
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Common.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <immintrin.h>
+
+namespace YaGE {
+
+/// @brief
+///   Accumulate long input of @p FastHash64() and @p FastHash128() with AVX2 instructions. This function must not be called if the processor does not support AVX2.
+///
+/// @param[in,out] acc      The 8 accumulators.
+/// @param[in]     input    Pointer to start of data to be hashed.
+/// @param         size     Size in byte of data to be hashed. Must be greater than @p FAST_HASH_STRIPE_LENGTH.
+/// @param[in]     secret   The secret that is used to hash the data. Must have @p FAST_HASH_SECRET_SIZE bytes.
+auto FastHashAccumulateAvx2(uint64_t acc[8], const uint8_t *input, size_t size, const uint8_t *secret) noexcept -> void;
+
+// Everything below has internal linkage on purpose. This header is included by translation units that are compiled
+// with different instruction sets, and the linker may pick any copy of an inline function with external linkage.
+namespace {
+
+/// @brief  Size in byte of the hash secret.
+constexpr const size_t FAST_HASH_SECRET_SIZE = 192;
+
+/// @brief  Size in byte of data that is consumed by each accumulation.
+constexpr const size_t FAST_HASH_STRIPE_LENGTH = 64;
+
+/// @brief  Secret offset between two stripes.
+constexpr const size_t FAST_HASH_SECRET_CONSUME_RATE = 8;
+
+/// @brief  Number of stripes between two scrambles.
+constexpr const size_t FAST_HASH_STRIPES_PER_BLOCK =
+    (FAST_HASH_SECRET_SIZE - FAST_HASH_STRIPE_LENGTH) / FAST_HASH_SECRET_CONSUME_RATE;
+
+/// @brief  Size in byte of data between two scrambles.
+constexpr const size_t FAST_HASH_BLOCK_LENGTH = FAST_HASH_STRIPE_LENGTH * FAST_HASH_STRIPES_PER_BLOCK;
+
+/// @brief  Multiplier of the scramble step.
+constexpr const uint32_t FAST_HASH_PRIME32_1 = 0x9E3779B1U;
+
+/// @brief
+///   Accumulate all stripes of the input with the specified SIMD lanes. The last stripe always ends at the end of the input, so that no partial stripe is read.
+template <typename Lanes>
+auto FastHashAccumulate(uint64_t acc[8], const uint8_t *input, size_t size, const uint8_t *secret) noexcept -> void {
+    typename Lanes::State state;
+    Lanes::Load(state, acc);
+
+    const size_t blockCount = (size - 1) / FAST_HASH_BLOCK_LENGTH;
+    for (size_t block = 0; block < blockCount; ++block) {
+        const uint8_t *blockStart = input + block * FAST_HASH_BLOCK_LENGTH;
+        for (size_t i = 0; i < FAST_HASH_STRIPES_PER_BLOCK; ++i) {
+            Lanes::Accumulate(state, blockStart + i * FAST_HASH_STRIPE_LENGTH,
+                              secret + i * FAST_HASH_SECRET_CONSUME_RATE);
+        }
+        Lanes::Scramble(state, secret + FAST_HASH_SECRET_SIZE - FAST_HASH_STRIPE_LENGTH);
+    }
+
+    const uint8_t *lastBlock   = input + blockCount * FAST_HASH_BLOCK_LENGTH;
+    const size_t   stripeCount = ((size - 1) - blockCount * FAST_HASH_BLOCK_LENGTH) / FAST_HASH_STRIPE_LENGTH;
+    for (size_t i = 0; i < stripeCount; ++i)
+        Lanes::Accumulate(state, lastBlock + i * FAST_HASH_STRIPE_LENGTH, secret + i * FAST_HASH_SECRET_CONSUME_RATE);
+
+    Lanes::Accumulate(state, input + size - FAST_HASH_STRIPE_LENGTH,
+                      secret + FAST_HASH_SECRET_SIZE - FAST_HASH_STRIPE_LENGTH - 7);
+
+    Lanes::Store(state, acc);
+}
+
+} // namespace
+
+} // namespace YaGE
@@ -0,0 +1,702 @@
+#pragma once
+
+#include "Common.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <emmintrin.h>
+#include <intrin.h>
+
+namespace YaGE {
+
+template <typename Key, typename Value, typename Hasher = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+class HashMap {
+public:
+    using key_type        = Key;
+    using mapped_type     = Value;
+    using value_type      = std::pair<const Key, Value>;
+    using size_type       = size_t;
+    using difference_type = ptrdiff_t;
+    using hasher          = Hasher;
+    using key_equal       = KeyEqual;
+    using reference       = value_type &;
+    using const_reference = const value_type &;
+    using pointer         = value_type *;
+    using const_pointer   = const value_type *;
+
+private:
+    /// @brief  Control byte of empty slots.
+    static constexpr const int8_t EMPTY = -128;
+
+    /// @brief  Control byte of erased slots. Lookups must continue probing after erased slots.
+    static constexpr const int8_t DELETED = -2;
+
+    /// @brief  Number of control bytes that are matched at once.
+    static constexpr const size_t GROUP_WIDTH = 16;
+
+    /// @brief
+    ///   Bit mask of matched slots in a group.
+    class GroupMask {
+    public:
+        YAGE_FORCEINLINE explicit GroupMask(uint32_t mask) noexcept : bits(mask) {}
+
+        YAGE_NODISCARD YAGE_FORCEINLINE auto HasAny() const noexcept -> bool { return bits != 0; }
+
+        /// @brief
+        ///   Get index of the lowest matched slot and remove it from this mask.
+        YAGE_NODISCARD YAGE_FORCEINLINE auto Next() noexcept -> size_t {
+            unsigned long index;
+            _BitScanForward(&index, bits);
+            bits &= bits - 1;
+            return static_cast<size_t>(index);
+        }
+
+    private:
+        uint32_t bits;
+    };
+
+    /// @brief
+    ///   16 control bytes that are matched with SSE2 instructions.
+    class Group {
+    public:
+        YAGE_FORCEINLINE explicit Group(const int8_t *controls) noexcept
+            : value(_mm_loadu_si128(reinterpret_cast<const __m128i *>(controls))) {}
+
+        YAGE_NODISCARD YAGE_FORCEINLINE auto Match(int8_t h2) const noexcept -> GroupMask {
+            return GroupMask(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(value, _mm_set1_epi8(h2)))));
+        }
+
+        YAGE_NODISCARD YAGE_FORCEINLINE auto MatchEmpty() const noexcept -> GroupMask { return Match(EMPTY); }
+
+        /// @brief
+        ///   Empty and erased control bytes are the only negative control bytes.
+        YAGE_NODISCARD YAGE_FORCEINLINE auto MatchEmptyOrDeleted() const noexcept -> GroupMask {
+            return GroupMask(static_cast<uint32_t>(_mm_movemask_epi8(value)));
+        }
+
+    private:
+        __m128i value;
+    };
+
+    template <bool IsConst>
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = typename HashMap::value_type;
+        using difference_type   = ptrdiff_t;
+        using pointer           = typename std::conditional<IsConst, const value_type *, value_type *>::type;
+        using reference         = typename std::conditional<IsConst, const value_type &, value_type &>::type;
+
+        /// @brief
+        ///   Create a null iterator.
+        Iterator() noexcept : control(), controlEnd(), slot() {}
+
+        /// @brief
+        ///   Create an iterator that points to the first full slot starting from the specified slot.
+        Iterator(const int8_t *ctrl, const int8_t *ctrlEnd, pointer position) noexcept
+            : control(ctrl), controlEnd(ctrlEnd), slot(position) {
+            SkipEmptySlots();
+        }
+
+        /// @brief
+        ///   Non-const iterators could be implicitly converted to const iterators.
+        template <bool OtherConst, typename = typename std::enable_if<IsConst && !OtherConst>::type>
+        Iterator(const Iterator<OtherConst> &other) noexcept
+            : control(other.control), controlEnd(other.controlEnd), slot(other.slot) {}
+
+        YAGE_NODISCARD auto operator*() const noexcept -> reference { return *slot; }
+        YAGE_NODISCARD auto operator->() const noexcept -> pointer { return slot; }
+
+        auto operator++() noexcept -> Iterator & {
+            ++control;
+            ++slot;
+            SkipEmptySlots();
+            return *this;
+        }
+
+        auto operator++(int) noexcept -> Iterator {
+            Iterator result = *this;
+            ++(*this);
+            return result;
+        }
+
+        YAGE_NODISCARD auto operator==(const Iterator &rhs) const noexcept -> bool { return slot == rhs.slot; }
+        YAGE_NODISCARD auto operator!=(const Iterator &rhs) const noexcept -> bool { return slot != rhs.slot; }
+
+    private:
+        auto SkipEmptySlots() noexcept -> void {
+            while (control != controlEnd && *control < 0) {
+                ++control;
+                ++slot;
+            }
+        }
+
+        friend class HashMap;
+        friend class Iterator<!IsConst>;
+
+        /// @brief  Control byte of current slot.
+        const int8_t *control;
+
+        /// @brief  End of control bytes. Cloned control bytes are not iterated.
+        const int8_t *controlEnd;
+
+        /// @brief  Current slot.
+        pointer slot;
+    };
+
+public:
+    using iterator       = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    /// @brief
+    ///   Create an empty hash map. No memory is allocated until the first element is inserted.
+    HashMap() noexcept
+        : controls(), slots(), capacity(), count(), growthLeft(), hashFunction(), equalFunction() {}
+
+    /// @brief
+    ///   Create an empty hash map with space for at least the specified number of elements.
+    ///
+    /// @param elementCount     Number of elements that could be inserted without rehashing.
+    ///
+    /// @throw std::bad_alloc
+    ///   Thrown if failed to allocate memory.
+    explicit HashMap(size_t elementCount) : HashMap() { Reserve(elementCount); }
+
+    /// @brief
+    ///   Copy constructor of hash map.
+    ///
+    /// @param other    The hash map to be copied.
+    ///
+    /// @throw std::bad_alloc
+    ///   Thrown if failed to allocate memory.
+    HashMap(const HashMap &other)
+        : controls(),
+          slots(),
+          capacity(),
+          count(),
+          growthLeft(),
+          hashFunction(other.hashFunction),
+          equalFunction(other.equalFunction) {
+        Reserve(other.count);
+        for (const auto &element : other)
+            InsertUnique(HashOf(element.first), element);
+    }
+
+    /// @brief
+    ///   Move constructor of hash map.
+    ///
+    /// @param other    The hash map to be moved. The moved hash map will be empty.
+    HashMap(HashMap &&other) noexcept
+        : controls(other.controls),
+          slots(other.slots),
+          capacity(other.capacity),
+          count(other.count),
+          growthLeft(other.growthLeft),
+          hashFunction(std::move(other.hashFunction)),
+          equalFunction(std::move(other.equalFunction)) {
+        other.controls   = nullptr;
+        other.slots      = nullptr;
+        other.capacity   = 0;
+        other.count      = 0;
+        other.growthLeft = 0;
+    }
+
+    /// @brief
+    ///   Destroy all elements and free memory.
+    ~HashMap() noexcept {
+        DestroySlots();
+        Deallocate(controls, slots, capacity);
+    }
+
+    /// @brief
+    ///   Copy assignment of hash map.
+    ///
+    /// @param other    The hash map to be copied.
+    ///
+    /// @return HashMap &
+    ///   Return reference to this hash map.
+    ///
+    /// @throw std::bad_alloc
+    ///   Thrown if failed to allocate memory. This hash map is not changed if any exception is thrown.
+    auto operator=(const HashMap &other) -> HashMap & {
+        if (this != &other) {
+            HashMap temp(other);
+            Swap(temp);
+        }
+        return *this;
+    }
+
+    /// @brief
+    ///   Move assignment of hash map.
+    ///
+    /// @param other    The hash map to be moved. The moved hash map will be empty.
+    ///
+    /// @return HashMap &
+    ///   Return reference to this hash map.
+    auto operator=(HashMap &&other) noexcept -> HashMap & {
+        if (this != &other) {
+            HashMap temp(std::move(other));
+            Swap(temp);
+        }
+        return *this;
+    }
+
+    /// @brief
+    ///   Swap content of two hash maps.
+    ///
+    /// @param other    The hash map to be swapped with.
+    auto Swap(HashMap &other) noexcept -> void {
+        using std::swap;
+        swap(controls, other.controls);
+        swap(slots, other.slots);
+        swap(capacity, other.capacity);
+        swap(count, other.count);
+        swap(growthLeft, other.growthLeft);
+        swap(hashFunction, other.hashFunction);
+        swap(equalFunction, other.equalFunction);
+    }
+
+    /// @brief
+    ///   Get number of elements in this hash map.
+    ///
+    /// @return size_t
+    ///   Return number of elements in this hash map.
+    YAGE_NODISCARD auto Size() const noexcept -> size_t { return count; }
+
+    /// @brief
+    ///   Checks if this hash map is empty.
+    ///
+    /// @return bool
+    /// @retval true    This hash map is empty.
+    /// @retval false   This hash map is not empty.
+    YAGE_NODISCARD auto IsEmpty() const noexcept -> bool { return count == 0; }
+
+    /// @brief
+    ///   Get number of slots in this hash map. At most 7/8 of the slots are used before rehashing.
+    ///
+    /// @return size_t
+    ///   Return number of slots in this hash map.
+    YAGE_NODISCARD auto Capacity() const noexcept -> size_t { return capacity; }
+
+    /// @brief
+    ///   Destroy all elements in this hash map. Allocated memory is kept for reuse.
+    auto Clear() noexcept -> void {
+        DestroySlots();
+        if (capacity != 0)
+            memset(controls, EMPTY, capacity + GROUP_WIDTH);
+        count      = 0;
+        growthLeft = MaxLoad(capacity);
+    }
+
+    /// @brief
+    ///   Reserve space for at least the specified number of elements.
+    ///
+    /// @param elementCount     Number of elements that could be inserted without rehashing.
+    ///
+    /// @throw std::bad_alloc
+    ///   Thrown if failed to allocate memory. This hash map is not changed if any exception is thrown.
+    auto Reserve(size_t elementCount) -> void {
+        if (elementCount <= count + growthLeft)
+            return;
+
+        size_t newCapacity = GROUP_WIDTH;
+        while (MaxLoad(newCapacity) < elementCount)
+            newCapacity *= 2;
+        Rehash(newCapacity);
+    }
+
+    /// @brief
+    ///   Find the element with the specified key.
+    ///
+    /// @param key  The key to be found.
+    ///
+    /// @return iterator
+    ///   Return iterator to the element if found. Otherwise, return @p end().
+    YAGE_NODISCARD auto Find(const Key &key) noexcept -> iterator {
+        const size_t index = FindIndex(key);
+        return index == capacity ? end() : IteratorAt(index);
+    }
+
+    /// @brief
+    ///   Find the element with the specified key.
+    ///
+    /// @param key  The key to be found.
+    ///
+    /// @return const_iterator
+    ///   Return iterator to the element if found. Otherwise, return @p end().
+    YAGE_NODISCARD auto Find(const Key &key) const noexcept -> const_iterator {
+        const size_t index = FindIndex(key);
+        return index == capacity ? end() : IteratorAt(index);
+    }
+
+    /// @brief
+    ///   Checks if this hash map contains the specified key.
+    ///
+    /// @param key  The key to be checked.
+    ///
+    /// @return bool
+    /// @retval true    This hash map contains the specified key.
+    /// @retval false   This hash map does not contain the specified key.
+    YAGE_NODISCARD auto Contains(const Key &key) const noexcept -> bool { return FindIndex(key) != capacity; }
+
+    /// @brief
+    ///   Insert a new element with the specified key if the key does not exist. The value is constructed in place from the specified arguments and nothing is constructed if the key already exists.
+    ///
+    /// @tparam K       Type of the key. Must be @p Key or a type that could be used to construct @p Key.
+    /// @tparam Args    Types of arguments to construct the value.
+    /// @param key      The key of the element.
+    /// @param args     Arguments to construct the value.
+    ///
+    /// @return std::pair<iterator, bool>
+    ///   Return a pair of iterator to the element with the specified key and a bool that is true if a new element is inserted.
+    ///
+    /// @throw std::bad_alloc
+    ///   Thrown if failed to allocate memory.
+    template <typename K, typename... Args>
+    auto TryEmplace(K &&key, Args &&...args) -> std::pair<iterator, bool> {
+        const size_t hash  = HashOf(key);
+        const size_t index = FindIndex(key, hash);
+        if (index != capacity)
+            return {IteratorAt(index), false};
+
+        const size_t slot = InsertUnique(hash, std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)),
+                                         std::forward_as_tuple(std::forward<Args>(args)...));
+        return {IteratorAt(slot), true};
+    }
+
+    /// @brief
+    ///   Insert the specified element if its key does not exist.
+    ///
+    /// @param element  The element to be inserted.
+    ///
+    /// @return std::pair<iterator, bool>
+    ///   Return a pair of iterator to the element with the same key and a bool that is true if a new element is inserted.
+    ///
+    /// @throw std::bad_alloc
+    ///   Thrown if failed to allocate memory.
+    auto Insert(const value_type &element) -> std::pair<iterator, bool> {
+        return TryEmplace(element.first, element.second);
+    }
+
+    /// @brief
+    ///   Insert the specified element if its key does not exist.
+    ///
+    /// @param element  The element to be inserted.
+    ///
+    /// @return std::pair<iterator, bool>
+    ///   Return a pair of iterator to the element with the same key and a bool that is true if a new element is inserted.
+    ///
+    /// @throw std::bad_alloc
+    ///   Thrown if failed to allocate memory.
+    auto Insert(value_type &&element) -> std::pair<iterator, bool> {
+        return TryEmplace(std::move(const_cast<Key &>(element.first)), std::move(element.second));
+    }
+
+    /// @brief
+    ///   Get value of the specified key. A default-constructed value is inserted if the key does not exist.
+    ///
+    /// @param key  The key of the value.
+    ///
+    /// @return Value &
+    ///   Return reference to the value.
+    ///
+    /// @throw std::bad_alloc
+    ///   Thrown if failed to allocate memory.
+    auto operator[](const Key &key) -> Value & { return TryEmplace(key).first->second; }
+
+    /// @brief
+    ///   Get value of the specified key. A default-constructed value is inserted if the key does not exist.
+    ///
+    /// @param key  The key of the value.
+    ///
+    /// @return Value &
+    ///   Return reference to the value.
+    ///
+    /// @throw std::bad_alloc
+    ///   Thrown if failed to allocate memory.
+    auto operator[](Key &&key) -> Value & { return TryEmplace(std::move(key)).first->second; }
+
+    /// @brief
+    ///   Remove the element with the specified key.
+    ///
+    /// @param key  The key of the element to be removed.
+    ///
+    /// @return size_t
+    ///   Return number of removed elements, which is either 0 or 1.
+    auto Erase(const Key &key) noexcept -> size_t {
+        const size_t index = FindIndex(key);
+        if (index == capacity)
+            return 0;
+
+        EraseAt(index);
+        return 1;
+    }
+
+    /// @brief
+    ///   Remove the element that the specified iterator points to. Other iterators are not invalidated.
+    ///
+    /// @param position     Iterator to the element to be removed. Must be a valid iterator of this hash map.
+    ///
+    /// @return iterator
+    ///   Return iterator to the element after the removed element.
+    auto Erase(const_iterator position) noexcept -> iterator {
+        const size_t index = static_cast<size_t>(position.control - controls);
+        EraseAt(index);
+        return IteratorAt(index);
+    }
+
+    YAGE_NODISCARD auto begin() noexcept -> iterator { return IteratorAt(0); }
+    YAGE_NODISCARD auto begin() const noexcept -> const_iterator { return IteratorAt(0); }
+    YAGE_NODISCARD auto cbegin() const noexcept -> const_iterator { return IteratorAt(0); }
+    YAGE_NODISCARD auto end() noexcept -> iterator { return IteratorAt(capacity); }
+    YAGE_NODISCARD auto end() const noexcept -> const_iterator { return IteratorAt(capacity); }
+    YAGE_NODISCARD auto cend() const noexcept -> const_iterator { return IteratorAt(capacity); }
+
+private:
+    /// @brief
+    ///   Get maximum number of elements before rehashing.
+    YAGE_NODISCARD static auto MaxLoad(size_t slotCount) noexcept -> size_t { return slotCount - slotCount / 8; }
+
+    /// @brief
+    ///   Mix hash value of the key. Standard hash functions of integers may return the integer itself, but both the high and low bits are used here.
+    YAGE_NODISCARD auto HashOf(const Key &key) const noexcept -> size_t {
+        const uint64_t hash = static_cast<uint64_t>(hashFunction(key)) * 0x9E3779B97F4A7C15ULL;
+        return static_cast<size_t>(hash ^ (hash >> 32));
+    }
+
+    /// @brief
+    ///   7-bit fragment of hash value that is stored in control bytes.
+    YAGE_NODISCARD static auto H2(size_t hash) noexcept -> int8_t { return static_cast<int8_t>(hash & 0x7F); }
+
+    /// @brief
+    ///   Probe start position of hash value.
+    YAGE_NODISCARD static auto H1(size_t hash) noexcept -> size_t { return hash >> 7; }
+
+    YAGE_NODISCARD auto IteratorAt(size_t index) noexcept -> iterator {
+        return iterator(controls + index, controls + capacity, slots + index);
+    }
+
+    YAGE_NODISCARD auto IteratorAt(size_t index) const noexcept -> const_iterator {
+        return const_iterator(controls + index, controls + capacity, slots + index);
+    }
+
+    /// @brief
+    ///   Set control byte of the specified slot. The first control bytes are cloned after the last slot, so that groups could be loaded at any slot without wrapping.
+    auto SetControl(size_t index, int8_t value) noexcept -> void {
+        controls[index] = value;
+        if (index < GROUP_WIDTH - 1)
+            controls[capacity + index] = value;
+    }
+
+    YAGE_NODISCARD auto FindIndex(const Key &key) const noexcept -> size_t { return FindIndex(key, HashOf(key)); }
+
+    /// @brief
+    ///   Find slot index of the specified key.
+    ///
+    /// @return size_t
+    ///   Return index of the slot if found. Otherwise, return @p capacity.
+    template <typename K>
+    YAGE_NODISCARD auto FindIndex(const K &key, size_t hash) const noexcept -> size_t {
+        if (count == 0)
+            return capacity;
+
+        const size_t mask = capacity - 1;
+        const int8_t h2   = H2(hash);
+
+        // Triangular probing over groups visits every slot exactly once when capacity is a power of 2.
+        size_t position = H1(hash) & mask;
+        for (size_t step = GROUP_WIDTH;; step += GROUP_WIDTH) {
+            const Group group(controls + position);
+
+            GroupMask match = group.Match(h2);
+            while (match.HasAny()) {
+                const size_t index = (position + match.Next()) & mask;
+                if (equalFunction(slots[index].first, key))
+                    return index;
+            }
+
+            if (group.MatchEmpty().HasAny())
+                return capacity;
+
+            position = (position + step) & mask;
+        }
+    }
+
+    /// @brief
+    ///   Find the first empty or erased slot in probe sequence of the specified hash value.
+    YAGE_NODISCARD auto FindInsertSlot(size_t hash) const noexcept -> size_t {
+        const size_t mask = capacity - 1;
+
+        size_t position = H1(hash) & mask;
+        for (size_t step = GROUP_WIDTH;; step += GROUP_WIDTH) {
+            GroupMask match = Group(controls + position).MatchEmptyOrDeleted();
+            if (match.HasAny())
+                return (position + match.Next()) & mask;
+            position = (position + step) & mask;
+        }
+    }
+
+    /// @brief
+    ///   Insert a new element whose key is known not to exist.
+    ///
+    /// @return size_t
+    ///   Return slot index of the new element.
+    template <typename... Args>
+    auto InsertUnique(size_t hash, Args &&...args) -> size_t {
+        size_t index = capacity == 0 ? 0 : FindInsertSlot(hash);
+
+        // Erased slots could always be reused. Empty slots are only used if there is still space.
+        if (capacity == 0 || (growthLeft == 0 && controls[index] == EMPTY)) {
+            // Rehash in place if more than half of the slots are erased slots.
+            Rehash(count * 2 < MaxLoad(capacity) ? capacity : (capacity == 0 ? GROUP_WIDTH : capacity * 2));
+            index = FindInsertSlot(hash);
+        }
+
+        ::new (static_cast<void *>(slots + index)) value_type(std::forward<Args>(args)...);
+
+        if (controls[index] == EMPTY)
+            growthLeft -= 1;
+        SetControl(index, H2(hash));
+        count += 1;
+
+        return index;
+    }
+
+    /// @brief
+    ///   Remove element in the specified slot.
+    auto EraseAt(size_t index) noexcept -> void {
+        slots[index].~value_type();
+        count -= 1;
+
+        // The slot could be marked as empty if no probe sequence has ever passed through it, which is true if there is
+        // an empty slot both right before and right after it in the same 16-slot window.
+        const size_t    mask        = capacity - 1;
+        const GroupMask emptyAfter  = Group(controls + index).MatchEmpty();
+        const GroupMask emptyBefore = Group(controls + ((index - GROUP_WIDTH) & mask)).MatchEmpty();
+
+        const bool wasNeverFull = emptyAfter.HasAny() && emptyBefore.HasAny() &&
+                                  LeadingZeros(emptyBefore) + TrailingZeros(emptyAfter) < GROUP_WIDTH;
+
+        if (wasNeverFull) {
+            SetControl(index, EMPTY);
+            growthLeft += 1;
+        } else {
+            SetControl(index, DELETED);
+        }
+    }
+
+    /// @brief
+    ///   Count trailing unmatched slots of the specified mask.
+    YAGE_NODISCARD static auto TrailingZeros(GroupMask mask) noexcept -> size_t { return mask.Next(); }
+
+    /// @brief
+    ///   Count leading unmatched slots of the specified 16-bit mask.
+    YAGE_NODISCARD static auto LeadingZeros(GroupMask mask) noexcept -> size_t {
+        size_t last = 0;
+        while (mask.HasAny())
+            last = mask.Next();
+        return GROUP_WIDTH - 1 - last;
+    }
+
+    /// @brief
+    ///   Move all elements to new slots of the specified capacity.
+    auto Rehash(size_t newCapacity) -> void {
+        int8_t     *newControls = nullptr;
+        value_type *newSlots    = nullptr;
+        Allocate(newCapacity, newControls, newSlots);
+
+        int8_t     *oldControls = controls;
+        value_type *oldSlots    = slots;
+        const size_t oldCapacity = capacity;
+
+        controls   = newControls;
+        slots      = newSlots;
+        capacity   = newCapacity;
+        growthLeft = MaxLoad(newCapacity) - count;
+
+        for (size_t i = 0; i < oldCapacity; ++i) {
+            if (oldControls[i] < 0)
+                continue;
+
+            value_type  &element = oldSlots[i];
+            const size_t hash    = HashOf(element.first);
+            const size_t index   = FindInsertSlot(hash);
+
+            ::new (static_cast<void *>(slots + index))
+                value_type(std::move(const_cast<Key &>(element.first)), std::move(element.second));
+            element.~value_type();
+            SetControl(index, H2(hash));
+        }
+
+        Deallocate(oldControls, oldSlots, oldCapacity);
+    }
+
+    /// @brief
+    ///   Destroy all elements in this hash map.
+    auto DestroySlots() noexcept -> void {
+        if (std::is_trivially_destructible<value_type>::value)
+            return;
+
+        for (size_t i = 0; i < capacity; ++i) {
+            if (controls[i] >= 0)
+                slots[i].~value_type();
+        }
+    }
+
+    /// @brief
+    ///   Allocate control bytes and slots. All control bytes are initialized as empty.
+    static auto Allocate(size_t slotCount, int8_t *&newControls, value_type *&newSlots) -> void {
+        newSlots = std::allocator<value_type>().allocate(slotCount);
+        try {
+            newControls = new int8_t[slotCount + GROUP_WIDTH];
+        } catch (...) {
+            std::allocator<value_type>().deallocate(newSlots, slotCount);
+            throw;
+        }
+
+        memset(newControls, EMPTY, slotCount + GROUP_WIDTH);
+    }
+
+    /// @brief
+    ///   Free control bytes and slots. Elements must be destroyed before calling this method.
+    static auto Deallocate(int8_t *oldControls, value_type *oldSlots, size_t slotCount) noexcept -> void {
+        if (slotCount == 0)
+            return;
+
+        delete[] oldControls;
+        std::allocator<value_type>().deallocate(oldSlots, slotCount);
+    }
+
+private:
+    /// @brief  Control bytes of slots. Non-negative control bytes are hash fragments of full slots.
+    int8_t *controls;
+
+    /// @brief  Element slots. Only slots with non-negative control bytes are constructed.
+    value_type *slots;
+
+    /// @brief  Number of slots. Either 0 or a power of 2 that is not less than 16.
+    size_t capacity;
+
+    /// @brief  Number of elements.
+    size_t count;
+
+    /// @brief  Number of elements that could be inserted into empty slots before rehashing.
+    size_t growthLeft;
+
+    /// @brief  Hash function object.
+    Hasher hashFunction;
+
+    /// @brief  Key equality function object.
+    KeyEqual equalFunction;
+};
+
+} // namespace YaGE
@@ -0,0 +1,196 @@
+#include "Memory.h"
+
+#include <malloc.h>
+
+#include <atomic>
+#include <cassert>
+
+using namespace YaGE;
+
+namespace {
+
+auto DefaultAllocate(size_t size, size_t alignment, void *) noexcept -> void * {
+    return _aligned_malloc(size, alignment);
+}
+
+auto DefaultFree(void *ptr, void *) noexcept -> void { _aligned_free(ptr); }
+
+/// @brief  Current general purpose allocator.
+MemoryCallbacks memoryCallbacks{
+    /* allocate = */ DefaultAllocate,
+    /* free     = */ DefaultFree,
+    /* userData = */ nullptr,
+};
+
+/// @brief  Index of current frame. Frame arenas are reset when they observe a new frame index.
+std::atomic_uint64_t frameArenaIndex{0};
+
+struct ThreadFrameArena {
+    /// @brief  Frame arena of current thread.
+    LinearArena arena;
+
+    /// @brief  Index of the frame that this arena is reset for.
+    uint64_t frameIndex = 0;
+};
+
+/// @brief  Frame arena of each thread.
+thread_local ThreadFrameArena threadFrameArena;
+
+} // namespace
+
+auto YaGE::SetMemoryCallbacks(const MemoryCallbacks &callbacks) noexcept -> void {
+    if (callbacks.allocate == nullptr || callbacks.free == nullptr) {
+        memoryCallbacks.allocate = DefaultAllocate;
+        memoryCallbacks.free     = DefaultFree;
+        memoryCallbacks.userData = nullptr;
+    } else {
+        memoryCallbacks = callbacks;
+    }
+}
+
+YAGE_NODISCARD auto YaGE::AllocateMemory(size_t size, size_t alignment) noexcept -> void * {
+    assert((alignment & (alignment - 1)) == 0);
+    return memoryCallbacks.allocate(size, alignment, memoryCallbacks.userData);
+}
+
+auto YaGE::FreeMemory(void *ptr) noexcept -> void {
+    if (ptr != nullptr)
+        memoryCallbacks.free(ptr, memoryCallbacks.userData);
+}
+
+struct YaGE::LinearArena::Block {
+    /// @brief  The block that is allocated before this block, or the next spare block.
+    Block *prev;
+
+    /// @brief  Size in byte of data in this block.
+    size_t size;
+};
+
+namespace {
+
+/// @brief  Size in byte of arena block header. Data of each block starts right after the header.
+constexpr const size_t ARENA_BLOCK_HEADER_SIZE = DEFAULT_MEMORY_ALIGNMENT;
+
+} // namespace
+
+YaGE::LinearArena::LinearArena(size_t blockSize) noexcept
+    : current(), offset(), spareBlocks(), blockSize(blockSize), scopeDepth() {}
+
+YaGE::LinearArena::~LinearArena() noexcept {
+    Reset();
+    Trim();
+}
+
+YAGE_NODISCARD auto YaGE::LinearArena::Allocate(size_t size, size_t alignment) -> void * {
+    assert(alignment <= DEFAULT_MEMORY_ALIGNMENT && (alignment & (alignment - 1)) == 0);
+
+    if (current != nullptr) {
+        const size_t start = (offset + alignment - 1) & ~(alignment - 1);
+        if (start + size <= current->size) {
+            offset = start + size;
+            return reinterpret_cast<uint8_t *>(current) + ARENA_BLOCK_HEADER_SIZE + start;
+        }
+    }
+
+    // Take the first spare block that is large enough.
+    Block *block = nullptr;
+    for (Block **link = &spareBlocks; *link != nullptr; link = &((*link)->prev)) {
+        if ((*link)->size >= size) {
+            block = *link;
+            *link = block->prev;
+            break;
+        }
+    }
+
+    // Allocate a new block.
+    if (block == nullptr) {
+        const size_t dataSize = size > blockSize ? size : blockSize;
+
+        block = static_cast<Block *>(AllocateMemory(ARENA_BLOCK_HEADER_SIZE + dataSize));
+        if (block == nullptr)
+            throw std::bad_alloc();
+
+        block->size = dataSize;
+    }
+
+    block->prev = current;
+    current     = block;
+    offset      = size;
+
+    return reinterpret_cast<uint8_t *>(block) + ARENA_BLOCK_HEADER_SIZE;
+}
+
+auto YaGE::LinearArena::Rewind(Marker marker) noexcept -> void {
+    // Blocks that are allocated after the marker are moved to spare block list.
+    while (current != marker.block) {
+        assert(current != nullptr);
+
+        Block *block = current;
+        current      = block->prev;
+        block->prev  = spareBlocks;
+        spareBlocks  = block;
+    }
+
+    offset = marker.offset;
+}
+
+auto YaGE::LinearArena::Trim() noexcept -> void {
+    while (spareBlocks != nullptr) {
+        Block *block = spareBlocks;
+        spareBlocks  = block->prev;
+        FreeMemory(block);
+    }
+}
+
+YAGE_NODISCARD auto YaGE::FrameArena() noexcept -> LinearArena & {
+    ThreadFrameArena &frameArena = threadFrameArena;
+
+    // Memory allocated in previous frames is no longer in use. Scopes that are still alive may have been entered in a
+    // previous frame, so that the arena could only be reset after all scopes exit.
+    const uint64_t frameIndex = frameArenaIndex.load(std::memory_order_relaxed);
+    if (frameArena.frameIndex != frameIndex && !frameArena.arena.IsInScope()) {
+        frameArena.arena.Reset();
+        frameArena.frameIndex = frameIndex;
+    }
+
+    return frameArena.arena;
+}
+
+auto YaGE::AdvanceFrameArenas() noexcept -> void { frameArenaIndex.fetch_add(1, std::memory_order_relaxed); }
+
+YaGE::FixedSizePool::FixedSizePool(size_t blockSize, size_t blocksPerChunk) noexcept
+    : freeList(),
+      chunks(),
+      blockSize((blockSize + DEFAULT_MEMORY_ALIGNMENT - 1) & ~(DEFAULT_MEMORY_ALIGNMENT - 1)),
+      blocksPerChunk(blocksPerChunk == 0 ? 1 : blocksPerChunk) {
+    if (this->blockSize == 0)
+        this->blockSize = DEFAULT_MEMORY_ALIGNMENT;
+}
+
+YaGE::FixedSizePool::~FixedSizePool() noexcept {
+    while (chunks != nullptr) {
+        Chunk *chunk = chunks;
+        chunks       = chunk->next;
+        FreeMemory(chunk);
+    }
+}
+
+auto YaGE::FixedSizePool::Grow() -> void {
+    Chunk *chunk = static_cast<Chunk *>(AllocateMemory(DEFAULT_MEMORY_ALIGNMENT + blockSize * blocksPerChunk));
+    if (chunk == nullptr)
+        throw std::bad_alloc();
+
+    chunk->next = chunks;
+    chunks      = chunk;
+
+    // Push blocks in reverse order so that blocks are allocated in address order.
+    uint8_t *const data = reinterpret_cast<uint8_t *>(chunk) + DEFAULT_MEMORY_ALIGNMENT;
+    for (size_t i = blocksPerChunk; i > 0; --i) {
+        FreeBlock *block = reinterpret_cast<FreeBlock *>(data + (i - 1) * blockSize);
+        block->next      = freeList;
+        freeList         = block;
+    }
+}
+
+YaGE::MemoryPool::MemoryPool() noexcept
+    : pools{{16, 256}, {32, 128}, {64, 64}, {128, 32}, {256, 16}, {512, 8}, {1024, 8}} {}
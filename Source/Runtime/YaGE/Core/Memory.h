@@ -0,0 +1,486 @@
+#pragma once
+
+#include "Common.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+namespace YaGE {
+
+/// @brief  Default alignment of memory blocks allocated by YaGE allocators.
+constexpr const size_t DEFAULT_MEMORY_ALIGNMENT = 16;
+
+struct MemoryCallbacks {
+    /// @brief  Allocate a memory block of the specified size and alignment. Return @p nullptr if failed.
+    void *(*allocate)(size_t size, size_t alignment, void *userData);
+
+    /// @brief  Free a memory block that is allocated by @p allocate. @p ptr may be @p nullptr.
+    void (*free)(void *ptr, void *userData);
+
+    /// @brief  User data that is passed to the callbacks.
+    void *userData;
+};
+
+/// @brief
+///   Replace the general purpose allocator that is used by YaGE, including buffers of @p String, memory pools and arena blocks.
+/// @remarks
+///   This function must be called before any YaGE object is created, because memory blocks must be freed by the allocator that allocated them. Applications could use this function to route YaGE allocations to a scalable allocator.
+///
+/// @param callbacks    The allocation callbacks. Pass callbacks with null function pointers to restore the default allocator.
+YAGE_API auto SetMemoryCallbacks(const MemoryCallbacks &callbacks) noexcept -> void;
+
+/// @brief
+///   Allocate memory with the general purpose allocator of YaGE.
+///
+/// @param size         Size in byte of the memory block.
+/// @param alignment    Alignment of the memory block. Must be a power of 2.
+///
+/// @return void *
+///   Return pointer to the memory block. Return @p nullptr if failed to allocate memory.
+YAGE_NODISCARD YAGE_API auto AllocateMemory(size_t size, size_t alignment = DEFAULT_MEMORY_ALIGNMENT) noexcept
+    -> void *;
+
+/// @brief
+///   Free memory that is allocated by @p AllocateMemory().
+///
+/// @param ptr  Pointer to the memory block. Nothing happens if @p ptr is @p nullptr.
+YAGE_API auto FreeMemory(void *ptr) noexcept -> void;
+
+class LinearArena {
+public:
+    /// @brief  Default size in byte of arena blocks.
+    static constexpr const size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    /// @brief
+    ///   Allocation position of a linear arena. Memory allocated after a marker is freed at once when rewinding to it.
+    struct Marker {
+        /// @brief  The block that is in use when this marker is taken.
+        void *block;
+
+        /// @brief  Offset in byte from start of the block.
+        size_t offset;
+    };
+
+    /// @brief
+    ///   Create an empty linear arena. No memory is allocated until the first allocation.
+    ///
+    /// @param blockSize    Minimum size in byte of each memory block.
+    YAGE_API explicit LinearArena(size_t blockSize = DEFAULT_BLOCK_SIZE) noexcept;
+
+    /// @brief
+    ///   Copy constructor is disabled.
+    LinearArena(const LinearArena &) = delete;
+
+    /// @brief
+    ///   Copy assignment is disabled.
+    auto operator=(const LinearArena &) = delete;
+
+    /// @brief
+    ///   Free all memory blocks. Memory allocated from this arena must not be used after this arena is destroyed.
+    YAGE_API ~LinearArena() noexcept;
+
+    /// @brief
+    ///   Allocate memory from this arena. Memory is not freed individually.
+    /// @remarks
+    ///   Allocation is a pointer bump in the current block. A new block is taken from the spare block list or allocated only if current block does not have enough space.
+    ///
+    /// @param size         Size in byte of memory to be allocated.
+    /// @param alignment    Alignment of the memory. Must be a power of 2 and not greater than @p DEFAULT_MEMORY_ALIGNMENT.
+    ///
+    /// @return void *
+    ///   Return pointer to the allocated memory.
+    /// @throw std::bad_alloc
+    ///   Thrown if failed to allocate a new memory block.
+    YAGE_NODISCARD YAGE_API auto Allocate(size_t size, size_t alignment = DEFAULT_MEMORY_ALIGNMENT) -> void *;
+
+    /// @brief
+    ///   Allocate an uninitialized array from this arena.
+    ///
+    /// @tparam T       Type of array elements. Must be trivially destructible because destructors are never called.
+    /// @param count    Number of elements in the array.
+    ///
+    /// @return T *
+    ///   Return pointer to the first element of the array.
+    /// @throw std::bad_alloc
+    ///   Thrown if failed to allocate a new memory block.
+    template <typename T>
+    YAGE_NODISCARD auto AllocateArray(size_t count) -> T * {
+        static_assert(std::is_trivially_destructible<T>::value, "Arena arrays are never destroyed.");
+        static_assert(alignof(T) <= DEFAULT_MEMORY_ALIGNMENT, "Arena does not support over-aligned types.");
+        return static_cast<T *>(Allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    /// @brief
+    ///   Get current allocation position of this arena.
+    ///
+    /// @return Marker
+    ///   Return current allocation position.
+    YAGE_NODISCARD auto CurrentMarker() const noexcept -> Marker { return {current, offset}; }
+
+    /// @brief
+    ///   Free all memory that is allocated after the specified marker. Released blocks are kept for reuse.
+    ///
+    /// @param marker   A marker of this arena. The marker must not be older than any marker that has been rewound to.
+    YAGE_API auto Rewind(Marker marker) noexcept -> void;
+
+    /// @brief
+    ///   Free all memory that is allocated from this arena. Released blocks are kept for reuse.
+    auto Reset() noexcept -> void { Rewind(Marker{nullptr, 0}); }
+
+    /// @brief
+    ///   Return all unused blocks to the general purpose allocator.
+    YAGE_API auto Trim() noexcept -> void;
+
+    /// @brief
+    ///   Checks if any @p ArenaScope of this arena is alive.
+    ///
+    /// @return bool
+    /// @retval true    At least one scope of this arena is alive.
+    /// @retval false   No scope of this arena is alive.
+    YAGE_NODISCARD auto IsInScope() const noexcept -> bool { return scopeDepth != 0; }
+
+private:
+    friend class ArenaScope;
+
+    struct Block;
+
+    /// @brief  The block that is currently allocated from. Previous blocks are linked in allocation order.
+    Block *current;
+
+    /// @brief  Offset in byte of the next allocation in current block.
+    size_t offset;
+
+    /// @brief  Blocks that are released by rewinding and could be reused.
+    Block *spareBlocks;
+
+    /// @brief  Minimum size in byte of each memory block.
+    size_t blockSize;
+
+    /// @brief  Number of alive scopes of this arena.
+    uint32_t scopeDepth;
+};
+
+class ArenaScope {
+public:
+    /// @brief
+    ///   Take a marker of the specified arena. Memory allocated from the arena within this scope is freed when this scope exits.
+    ///
+    /// @param arena    The arena to be rewound when this scope exits.
+    explicit ArenaScope(LinearArena &arena) noexcept : arena(arena), marker(arena.CurrentMarker()) {
+        arena.scopeDepth += 1;
+    }
+
+    /// @brief
+    ///   Copy constructor is disabled.
+    ArenaScope(const ArenaScope &) = delete;
+
+    /// @brief
+    ///   Copy assignment is disabled.
+    auto operator=(const ArenaScope &) = delete;
+
+    /// @brief
+    ///   Rewind the arena to the marker that is taken when this scope is entered.
+    ~ArenaScope() noexcept {
+        arena.Rewind(marker);
+        arena.scopeDepth -= 1;
+    }
+
+private:
+    /// @brief  The arena to be rewound.
+    LinearArena &arena;
+
+    /// @brief  Allocation position of the arena when this scope is entered.
+    LinearArena::Marker marker;
+};
+
+/// @brief
+///   Get the frame arena of current thread. The frame arena is used for scratch memory that does not live longer than current frame.
+/// @remarks
+///   The frame arena is reset on the first access of each thread after @p AdvanceFrameArenas() is called, unless an @p ArenaScope of it is still alive. Memory that is only used within a function should be allocated in an @p ArenaScope so that it is freed immediately.
+///
+/// @return LinearArena &
+///   Return reference to the frame arena of current thread.
+YAGE_NODISCARD YAGE_API auto FrameArena() noexcept -> LinearArena &;
+
+/// @brief
+///   Mark the end of current frame. Frame arenas of all threads are reset lazily. This method is called by @p SwapChain::Present().
+YAGE_API auto AdvanceFrameArenas() noexcept -> void;
+
+/// @brief
+///   STL allocator that allocates from a linear arena. Deallocation does nothing, memory is freed when the arena is rewound or reset.
+///
+/// @tparam T   Type of elements to be allocated.
+template <typename T>
+class ArenaAllocator {
+public:
+    static_assert(alignof(T) <= DEFAULT_MEMORY_ALIGNMENT, "Arena does not support over-aligned types.");
+
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = ArenaAllocator<U>;
+    };
+
+    /// @brief
+    ///   Create an allocator that allocates from the specified arena.
+    ///
+    /// @param arena    The arena to allocate from.
+    ArenaAllocator(LinearArena &arena) noexcept : arena(&arena) {}
+
+    /// @brief
+    ///   Rebind constructor of arena allocator.
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U> &other) noexcept : arena(other.arena) {}
+
+    YAGE_NODISCARD auto allocate(size_t count) -> T * {
+        return static_cast<T *>(arena->Allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    auto deallocate(T *, size_t) noexcept -> void {}
+
+    template <typename U>
+    YAGE_NODISCARD auto operator==(const ArenaAllocator<U> &rhs) const noexcept -> bool {
+        return arena == rhs.arena;
+    }
+
+    template <typename U>
+    YAGE_NODISCARD auto operator!=(const ArenaAllocator<U> &rhs) const noexcept -> bool {
+        return arena != rhs.arena;
+    }
+
+private:
+    template <typename U>
+    friend class ArenaAllocator;
+
+    /// @brief  The arena to allocate from.
+    LinearArena *arena;
+};
+
+class FixedSizePool {
+public:
+    /// @brief
+    ///   Create a pool of fixed-size memory blocks. No memory is allocated until the first allocation.
+    /// @remarks
+    ///   This pool is not thread safe. Pools that are shared between threads must be protected by the owner.
+    ///
+    /// @param blockSize        Size in byte of each block. Rounded up to multiple of @p DEFAULT_MEMORY_ALIGNMENT.
+    /// @param blocksPerChunk   Number of blocks that are allocated at once when this pool runs out of blocks.
+    YAGE_API FixedSizePool(size_t blockSize, size_t blocksPerChunk) noexcept;
+
+    /// @brief
+    ///   Copy constructor is disabled.
+    FixedSizePool(const FixedSizePool &) = delete;
+
+    /// @brief
+    ///   Copy assignment is disabled.
+    auto operator=(const FixedSizePool &) = delete;
+
+    /// @brief
+    ///   Free all memory chunks of this pool. Blocks allocated from this pool must not be used after this pool is destroyed.
+    YAGE_API ~FixedSizePool() noexcept;
+
+    /// @brief
+    ///   Allocate a block from this pool.
+    ///
+    /// @return void *
+    ///   Return pointer to the block. The block is aligned to @p DEFAULT_MEMORY_ALIGNMENT.
+    /// @throw std::bad_alloc
+    ///   Thrown if failed to allocate a new memory chunk.
+    YAGE_NODISCARD auto Allocate() -> void * {
+        if (freeList == nullptr)
+            Grow();
+
+        FreeBlock *block = freeList;
+        freeList         = block->next;
+        return block;
+    }
+
+    /// @brief
+    ///   Return a block to this pool.
+    ///
+    /// @param ptr  Pointer to a block that is allocated from this pool. Nothing happens if @p ptr is @p nullptr.
+    auto Free(void *ptr) noexcept -> void {
+        if (ptr == nullptr)
+            return;
+
+        FreeBlock *block = static_cast<FreeBlock *>(ptr);
+        block->next      = freeList;
+        freeList         = block;
+    }
+
+    /// @brief
+    ///   Get size in byte of each block of this pool.
+    ///
+    /// @return size_t
+    ///   Return size in byte of each block.
+    YAGE_NODISCARD auto BlockSize() const noexcept -> size_t { return blockSize; }
+
+private:
+    /// @brief
+    ///   Allocate a new chunk and push all of its blocks to the free list.
+    ///
+    /// @throw std::bad_alloc
+    ///   Thrown if failed to allocate a new memory chunk.
+    YAGE_API auto Grow() -> void;
+
+    struct FreeBlock {
+        FreeBlock *next;
+    };
+
+    struct Chunk {
+        Chunk *next;
+    };
+
+    /// @brief  Free blocks of this pool.
+    FreeBlock *freeList;
+
+    /// @brief  Allocated chunks of this pool.
+    Chunk *chunks;
+
+    /// @brief  Size in byte of each block.
+    size_t blockSize;
+
+    /// @brief  Number of blocks in each chunk.
+    size_t blocksPerChunk;
+};
+
+class MemoryPool {
+public:
+    /// @brief  Number of size classes. Size classes are powers of 2 from 16 to 1024 bytes.
+    static constexpr const size_t SIZE_CLASS_COUNT = 7;
+
+    /// @brief  Maximum size in byte of pooled allocations. Larger allocations use the general purpose allocator.
+    static constexpr const size_t MAX_POOLED_SIZE = size_t(16) << (SIZE_CLASS_COUNT - 1);
+
+    /// @brief
+    ///   Create a memory pool with fixed-size pools for each size class.
+    /// @remarks
+    ///   This pool is not thread safe. It is designed to be owned by a container that is protected by its own lock.
+    YAGE_API MemoryPool() noexcept;
+
+    /// @brief
+    ///   Copy constructor is disabled.
+    MemoryPool(const MemoryPool &) = delete;
+
+    /// @brief
+    ///   Copy assignment is disabled.
+    auto operator=(const MemoryPool &) = delete;
+
+    /// @brief
+    ///   Allocate memory from the size class that fits the specified size.
+    ///
+    /// @param size     Size in byte of memory to be allocated.
+    ///
+    /// @return void *
+    ///   Return pointer to the allocated memory. The memory is aligned to @p DEFAULT_MEMORY_ALIGNMENT.
+    /// @throw std::bad_alloc
+    ///   Thrown if failed to allocate memory.
+    YAGE_NODISCARD auto Allocate(size_t size) -> void * {
+        if (size > MAX_POOLED_SIZE) {
+            void *ptr = AllocateMemory(size);
+            if (ptr == nullptr)
+                throw std::bad_alloc();
+            return ptr;
+        }
+
+        return pools[SizeClass(size)].Allocate();
+    }
+
+    /// @brief
+    ///   Free memory that is allocated from this pool.
+    ///
+    /// @param ptr      Pointer to the memory. Nothing happens if @p ptr is @p nullptr.
+    /// @param size     Size in byte that is passed to @p Allocate().
+    auto Free(void *ptr, size_t size) noexcept -> void {
+        if (size > MAX_POOLED_SIZE)
+            FreeMemory(ptr);
+        else
+            pools[SizeClass(size)].Free(ptr);
+    }
+
+private:
+    /// @brief
+    ///   Get size class index of the specified size.
+    YAGE_NODISCARD static auto SizeClass(size_t size) noexcept -> size_t {
+        size_t index = 0;
+        while ((size_t(16) << index) < size)
+            index += 1;
+        return index;
+    }
+
+    /// @brief  Fixed-size pools for each size class.
+    FixedSizePool pools[SIZE_CLASS_COUNT];
+};
+
+/// @brief
+///   STL allocator that allocates from a memory pool. Node-based containers such as @p std::deque, @p std::list and @p std::map allocate fixed-size nodes and benefit most from pooling.
+/// @remarks
+///   A default-constructed pool allocator uses the general purpose allocator.
+///
+/// @tparam T   Type of elements to be allocated.
+template <typename T>
+class PoolAllocator {
+public:
+    static_assert(alignof(T) <= DEFAULT_MEMORY_ALIGNMENT, "Memory pool does not support over-aligned types.");
+
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = PoolAllocator<U>;
+    };
+
+    /// @brief
+    ///   Create an allocator that uses the general purpose allocator.
+    PoolAllocator() noexcept : pool() {}
+
+    /// @brief
+    ///   Create an allocator that allocates from the specified memory pool.
+    ///
+    /// @param pool     The memory pool to allocate from. The pool must outlive all containers that use this allocator.
+    PoolAllocator(MemoryPool &pool) noexcept : pool(&pool) {}
+
+    /// @brief
+    ///   Rebind constructor of pool allocator.
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U> &other) noexcept : pool(other.pool) {}
+
+    YAGE_NODISCARD auto allocate(size_t count) -> T * {
+        if (pool != nullptr)
+            return static_cast<T *>(pool->Allocate(sizeof(T) * count));
+
+        void *ptr = AllocateMemory(sizeof(T) * count, alignof(T));
+        if (ptr == nullptr)
+            throw std::bad_alloc();
+        return static_cast<T *>(ptr);
+    }
+
+    auto deallocate(T *ptr, size_t count) noexcept -> void {
+        if (pool != nullptr)
+            pool->Free(ptr, sizeof(T) * count);
+        else
+            FreeMemory(ptr);
+    }
+
+    template <typename U>
+    YAGE_NODISCARD auto operator==(const PoolAllocator<U> &rhs) const noexcept -> bool {
+        return pool == rhs.pool;
+    }
+
+    template <typename U>
+    YAGE_NODISCARD auto operator!=(const PoolAllocator<U> &rhs) const noexcept -> bool {
+        return pool != rhs.pool;
+    }
+
+private:
+    template <typename U>
+    friend class PoolAllocator;
+
+    /// @brief  The memory pool to allocate from. Null if the general purpose allocator is used.
+    MemoryPool *pool;
+};
+
+} // namespace YaGE
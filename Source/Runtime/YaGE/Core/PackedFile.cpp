@@ -0,0 +1,321 @@
+#include "PackedFile.h"
+#include "Exception.h"
+#include "Hash.h"
+
+#include <Windows.h>
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+using namespace YaGE;
+
+namespace {
+
+/// @brief
+///   Header of packed files. The table of contents follows the header and the name table follows the table of contents.
+struct PackedFileHeader {
+    /// @brief  Magic number. Must be @p PackedFileFormat::magic.
+    uint32_t magic;
+
+    /// @brief  Version of file format. Must be @p PackedFileFormat::version.
+    uint32_t version;
+
+    /// @brief  Number of entries in the table of contents.
+    uint32_t entryCount;
+
+    /// @brief  Length in characters of the name table.
+    uint32_t nameTableLength;
+
+    /// @brief  Offset in byte of the table of contents from start of the file.
+    uint64_t tocOffset;
+
+    /// @brief  Offset in byte of the name table from start of the file.
+    uint64_t nameTableOffset;
+};
+
+static_assert(sizeof(PackedFileHeader) == 32, "Size of PackedFileHeader must be 32 bytes.");
+
+/// @brief  Maximum alignment of entry data. Padding is written from a zeroed buffer of this size.
+constexpr const uint64_t MAX_DATA_ALIGNMENT = 4096;
+
+/// @brief
+///   Open a file with the specified access.
+///
+/// @param path         Path to the file.
+/// @param access       Desired access of the file.
+/// @param share        Share mode of the file.
+/// @param disposition  Action to take if the file exists or not.
+/// @param flags        File attributes and flags.
+///
+/// @return HANDLE
+///   Return the file handle. Return @p INVALID_HANDLE_VALUE if failed to open the file.
+auto OpenFile(StringView path, DWORD access, DWORD share, DWORD disposition, DWORD flags) noexcept -> HANDLE {
+    if (path.IsNullTerminated())
+        return CreateFileW(reinterpret_cast<LPCWSTR>(path.Data()), access, share, nullptr, disposition, flags, nullptr);
+
+    String tempPath(path);
+    return CreateFileW(reinterpret_cast<LPCWSTR>(tempPath.Data()), access, share, nullptr, disposition, flags, nullptr);
+}
+
+/// @brief
+///   Write all data to the specified file.
+///
+/// @param file     The file handle to be written to.
+/// @param data     Data to be written.
+/// @param size     Size in byte of data to be written.
+///
+/// @return bool
+/// @retval true    All data is written.
+/// @retval false   Failed to write data. Call @p GetLastError() to get the error code.
+auto WriteAll(HANDLE file, const void *data, size_t size) noexcept -> bool {
+    const auto *ptr = static_cast<const uint8_t *>(data);
+    while (size > 0) {
+        const DWORD toWrite = static_cast<DWORD>(std::min<size_t>(size, 0x40000000));
+        DWORD       written = 0;
+        if (!WriteFile(file, ptr, toWrite, &written, nullptr))
+            return false;
+
+        ptr += written;
+        size -= written;
+    }
+
+    return true;
+}
+
+} // namespace
+
+YaGE::PackedFile::PackedFile() noexcept
+    : file(INVALID_HANDLE_VALUE),
+      mapping(nullptr),
+      view(nullptr),
+      fileSize(0),
+      entries(nullptr),
+      entrySize(0),
+      entryCount(0),
+      names(nullptr) {}
+
+YaGE::PackedFile::PackedFile(StringView path, const PackedFileFormat &format) : PackedFile() {
+    file = OpenFile(path, GENERIC_READ, FILE_SHARE_READ, OPEN_EXISTING,
+                    FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS);
+    if (file == INVALID_HANDLE_VALUE)
+        throw SystemErrorException(HRESULT_FROM_WIN32(GetLastError()),
+                                   Format(u"Failed to open {}: {}.", format.kind, path));
+
+    // This constructor delegates to the default constructor, so that the destructor releases handles if it throws.
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size))
+        throw SystemErrorException(HRESULT_FROM_WIN32(GetLastError()),
+                                   Format(u"Failed to get size of {}: {}.", format.kind, path));
+
+    fileSize = static_cast<uint64_t>(size.QuadPart);
+    if (fileSize < sizeof(PackedFileHeader))
+        throw SystemErrorException(HRESULT_FROM_WIN32(ERROR_BAD_FORMAT),
+                                   Format(u"Invalid {}: {}.", format.kind, path));
+
+    mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr)
+        throw SystemErrorException(HRESULT_FROM_WIN32(GetLastError()),
+                                   Format(u"Failed to map {}: {}.", format.kind, path));
+
+    view = static_cast<const uint8_t *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (view == nullptr)
+        throw SystemErrorException(HRESULT_FROM_WIN32(GetLastError()),
+                                   Format(u"Failed to map {}: {}.", format.kind, path));
+
+    { // Validate header and table of contents.
+        const auto *header = reinterpret_cast<const PackedFileHeader *>(view);
+        if (header->magic != format.magic || header->version != format.version)
+            throw SystemErrorException(HRESULT_FROM_WIN32(ERROR_BAD_FORMAT),
+                                       Format(u"Invalid {}: {}.", format.kind, path));
+
+        const uint64_t tocSize   = uint64_t(header->entryCount) * format.entrySize;
+        const uint64_t namesSize = uint64_t(header->nameTableLength) * sizeof(char16_t);
+        if (header->tocOffset % alignof(PackedFileEntry) != 0 || header->tocOffset > fileSize ||
+            tocSize > fileSize - header->tocOffset || header->nameTableOffset % alignof(char16_t) != 0 ||
+            header->nameTableOffset > fileSize || namesSize > fileSize - header->nameTableOffset)
+            throw SystemErrorException(HRESULT_FROM_WIN32(ERROR_BAD_FORMAT),
+                                       Format(u"Invalid {}: {}.", format.kind, path));
+
+        entries    = view + header->tocOffset;
+        entrySize  = format.entrySize;
+        entryCount = header->entryCount;
+        names      = reinterpret_cast<const char16_t *>(view + header->nameTableOffset);
+
+        for (uint32_t i = 0; i < entryCount; ++i) {
+            const auto &entry = *reinterpret_cast<const PackedFileEntry *>(entries + size_t(i) * entrySize);
+            if (entry.offset > fileSize || entry.size > fileSize - entry.offset ||
+                uint64_t(entry.nameOffset) + entry.nameLength > header->nameTableLength)
+                throw SystemErrorException(HRESULT_FROM_WIN32(ERROR_BAD_FORMAT),
+                                           Format(u"Invalid {}: {}.", format.kind, path));
+        }
+    }
+}
+
+YaGE::PackedFile::PackedFile(PackedFile &&other) noexcept
+    : file(other.file),
+      mapping(other.mapping),
+      view(other.view),
+      fileSize(other.fileSize),
+      entries(other.entries),
+      entrySize(other.entrySize),
+      entryCount(other.entryCount),
+      names(other.names) {
+    other.file       = INVALID_HANDLE_VALUE;
+    other.mapping    = nullptr;
+    other.view       = nullptr;
+    other.fileSize   = 0;
+    other.entries    = nullptr;
+    other.entrySize  = 0;
+    other.entryCount = 0;
+    other.names      = nullptr;
+}
+
+auto YaGE::PackedFile::operator=(PackedFile &&other) noexcept -> PackedFile & {
+    if (this == &other)
+        return *this;
+
+    this->~PackedFile();
+
+    file       = other.file;
+    mapping    = other.mapping;
+    view       = other.view;
+    fileSize   = other.fileSize;
+    entries    = other.entries;
+    entrySize  = other.entrySize;
+    entryCount = other.entryCount;
+    names      = other.names;
+
+    other.file       = INVALID_HANDLE_VALUE;
+    other.mapping    = nullptr;
+    other.view       = nullptr;
+    other.fileSize   = 0;
+    other.entries    = nullptr;
+    other.entrySize  = 0;
+    other.entryCount = 0;
+    other.names      = nullptr;
+
+    return *this;
+}
+
+YaGE::PackedFile::~PackedFile() noexcept {
+    if (view != nullptr)
+        UnmapViewOfFile(view);
+    if (mapping != nullptr)
+        CloseHandle(mapping);
+    if (file != INVALID_HANDLE_VALUE)
+        CloseHandle(file);
+}
+
+auto YaGE::PackedFile::Find(StringView name) const noexcept -> const PackedFileEntry * {
+    const uint64_t hash = HashName(name);
+
+    auto entryAt = [this](uint32_t index) -> const PackedFileEntry & {
+        return *reinterpret_cast<const PackedFileEntry *>(entries + size_t(index) * entrySize);
+    };
+
+    // Binary search for the first entry whose name hash is not less than the hash. Entries are strided by entry size.
+    uint32_t first = 0;
+    uint32_t count = entryCount;
+    while (count > 0) {
+        const uint32_t half = count / 2;
+        if (entryAt(first + half).nameHash < hash) {
+            first += half + 1;
+            count -= half + 1;
+        } else {
+            count = half;
+        }
+    }
+
+    for (; first < entryCount && entryAt(first).nameHash == hash; ++first) {
+        const PackedFileEntry &entry = entryAt(first);
+        if (Name(entry.nameOffset, entry.nameLength) == name)
+            return &entry;
+    }
+
+    return nullptr;
+}
+
+auto YaGE::PackedFile::HashName(StringView name) noexcept -> uint64_t {
+    return Hash64(name.Data(), name.Length() * sizeof(char16_t));
+}
+
+auto YaGE::PackedFile::Save(StringView              path,
+                            const PackedFileFormat &format,
+                            size_t                  count,
+                            const PackedFileItem   *items) -> void {
+    // Sort entries by name hash so that entries could be found with binary search.
+    std::vector<uint64_t> hashes(count);
+    for (size_t i = 0; i < count; ++i)
+        hashes[i] = HashName(items[i].name);
+
+    std::vector<size_t> order(count);
+    std::iota(order.begin(), order.end(), size_t(0));
+    std::sort(order.begin(), order.end(), [&hashes](size_t lhs, size_t rhs) -> bool {
+        return hashes[lhs] < hashes[rhs];
+    });
+
+    std::vector<uint8_t>  toc(count * format.entrySize);
+    std::vector<char16_t> nameTable;
+
+    PackedFileHeader header{};
+    header.magic           = format.magic;
+    header.version         = format.version;
+    header.entryCount      = static_cast<uint32_t>(count);
+    header.tocOffset       = sizeof(PackedFileHeader);
+    header.nameTableOffset = header.tocOffset + toc.size();
+
+    for (size_t i = 0; i < count; ++i) {
+        const PackedFileItem &item = items[order[i]];
+        memcpy(toc.data() + i * format.entrySize, item.entry, format.entrySize);
+
+        auto &entry      = *reinterpret_cast<PackedFileEntry *>(toc.data() + i * format.entrySize);
+        entry.nameHash   = hashes[order[i]];
+        entry.nameOffset = static_cast<uint32_t>(nameTable.size());
+        entry.nameLength = static_cast<uint32_t>(item.name.Length());
+        entry.size       = item.size;
+        nameTable.insert(nameTable.end(), item.name.Data(), item.name.Data() + item.name.Length());
+    }
+
+    header.nameTableLength = static_cast<uint32_t>(nameTable.size());
+
+    // Resolve data offsets.
+    const uint64_t alignMask = format.dataAlignment - 1;
+
+    uint64_t offset = header.nameTableOffset + nameTable.size() * sizeof(char16_t);
+    for (size_t i = 0; i < count; ++i) {
+        auto &entry  = *reinterpret_cast<PackedFileEntry *>(toc.data() + i * format.entrySize);
+        offset       = (offset + alignMask) & ~alignMask;
+        entry.offset = offset;
+        offset += entry.size;
+    }
+
+    HANDLE file = OpenFile(path, GENERIC_WRITE, 0, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN);
+    if (file == INVALID_HANDLE_VALUE)
+        throw SystemErrorException(HRESULT_FROM_WIN32(GetLastError()),
+                                   Format(u"Failed to create {}: {}.", format.kind, path));
+
+    bool succeeded = WriteAll(file, &header, sizeof(header)) && WriteAll(file, toc.data(), toc.size()) &&
+                     WriteAll(file, nameTable.data(), nameTable.size() * sizeof(char16_t));
+
+    uint64_t written = header.nameTableOffset + nameTable.size() * sizeof(char16_t);
+    for (size_t i = 0; succeeded && i < count; ++i) {
+        static constexpr const uint8_t padding[MAX_DATA_ALIGNMENT]{};
+
+        const auto           &entry = *reinterpret_cast<const PackedFileEntry *>(toc.data() + i * format.entrySize);
+        const PackedFileItem &item  = items[order[i]];
+
+        succeeded = WriteAll(file, padding, static_cast<size_t>(entry.offset - written)) &&
+                    WriteAll(file, item.data, item.size);
+        written = entry.offset + entry.size;
+    }
+
+    if (!succeeded) {
+        const DWORD error = GetLastError();
+        CloseHandle(file);
+        throw SystemErrorException(HRESULT_FROM_WIN32(error), Format(u"Failed to write {}: {}.", format.kind, path));
+    }
+
+    CloseHandle(file);
+}
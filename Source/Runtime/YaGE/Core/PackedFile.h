@@ -0,0 +1,202 @@
+#pragma once
+
+#include "String.h"
+
+namespace YaGE {
+
+/// @brief
+///   Leading fields of table of contents entries in packed files. Entry types of packed files must start with these fields in the same order.
+struct PackedFileEntry {
+    /// @brief  64-bit hash value of name of this entry. Entries are sorted by this value.
+    uint64_t nameHash;
+
+    /// @brief  Offset in characters of name of this entry in the name table.
+    uint32_t nameOffset;
+
+    /// @brief  Length in characters of name of this entry.
+    uint32_t nameLength;
+
+    /// @brief  Offset in byte of data of this entry from start of the file.
+    uint64_t offset;
+
+    /// @brief  Size in byte of data of this entry.
+    uint64_t size;
+};
+
+static_assert(sizeof(PackedFileEntry) == 32, "Size of PackedFileEntry must be 32 bytes.");
+
+/// @brief
+///   Format of a packed file. Packed files start with a header, followed by the table of contents, the name table and aligned data of each entry.
+struct PackedFileFormat {
+    /// @brief  Magic number of this file format.
+    uint32_t magic;
+
+    /// @brief  Version of this file format.
+    uint32_t version;
+
+    /// @brief  Size in byte of each table of contents entry. Must be a multiple of 8 and not less than size of @p PackedFileEntry.
+    uint32_t entrySize;
+
+    /// @brief  Alignment of data of each entry. Must be a power of 2 and not greater than 4096.
+    uint64_t dataAlignment;
+
+    /// @brief  Name of this file format that is used in error messages, for example "asset archive".
+    const char16_t *kind;
+};
+
+/// @brief
+///   An entry to be written to a packed file.
+struct PackedFileItem {
+    /// @brief  Name of this entry.
+    StringView name;
+
+    /// @brief  Table of contents entry of this item. Fields of @p PackedFileEntry are resolved when saving.
+    const void *entry;
+
+    /// @brief  Data of this entry.
+    const void *data;
+
+    /// @brief  Size in byte of data of this entry.
+    size_t size;
+};
+
+class PackedFile {
+public:
+    /// @brief
+    ///   Create an empty packed file.
+    YAGE_API PackedFile() noexcept;
+
+    /// @brief
+    ///   Open and memory-map a packed file. Only the header and the table of contents are validated, entry data is paged in on demand when accessed.
+    ///
+    /// @param path     Path to the packed file to be opened.
+    /// @param format   Format of the packed file.
+    ///
+    /// @throw SystemErrorException
+    ///   Thrown if failed to open or map the file, or the file is not a valid packed file of @p format.
+    YAGE_API PackedFile(StringView path, const PackedFileFormat &format);
+
+    /// @brief
+    ///   Copy constructor is disabled.
+    PackedFile(const PackedFile &) = delete;
+
+    /// @brief
+    ///   Copy assignment is disabled.
+    auto operator=(const PackedFile &) = delete;
+
+    /// @brief
+    ///   Move constructor. The moved packed file will be empty.
+    ///
+    /// @param other    The packed file to move from.
+    YAGE_API PackedFile(PackedFile &&other) noexcept;
+
+    /// @brief
+    ///   Move assignment. The moved packed file will be empty.
+    ///
+    /// @param other    The packed file to move from.
+    ///
+    /// @return PackedFile &
+    ///   Return reference to this packed file.
+    YAGE_API auto operator=(PackedFile &&other) noexcept -> PackedFile &;
+
+    /// @brief
+    ///   Unmap and close this packed file. Pointers to entry data are invalidated.
+    YAGE_API ~PackedFile() noexcept;
+
+    /// @brief
+    ///   Find an entry by name.
+    /// @remarks
+    ///   Entries are sorted by name hash, so that lookup is a binary search and no lookup table is built when opening the file.
+    ///
+    /// @param name     Name of the entry to be found.
+    ///
+    /// @return const PackedFileEntry *
+    ///   Return pointer to the leading fields of the table of contents entry. Return @p nullptr if no such entry.
+    YAGE_NODISCARD YAGE_API auto Find(StringView name) const noexcept -> const PackedFileEntry *;
+
+    /// @brief
+    ///   Get name in the name table.
+    ///
+    /// @param nameOffset   Offset in characters of the name in the name table.
+    /// @param nameLength   Length in characters of the name.
+    ///
+    /// @return StringView
+    ///   Return the name. The name is not null-terminated.
+    YAGE_NODISCARD auto Name(uint32_t nameOffset, uint32_t nameLength) const noexcept -> StringView {
+        return StringView(names + nameOffset, nameLength);
+    }
+
+    /// @brief
+    ///   Get memory-mapped data at the specified offset.
+    ///
+    /// @param offset   Offset in byte from start of the file.
+    ///
+    /// @return const uint8_t *
+    ///   Return pointer to the memory-mapped data.
+    YAGE_NODISCARD auto Data(uint64_t offset) const noexcept -> const uint8_t * { return view + offset; }
+
+    /// @brief
+    ///   Get number of entries in this file.
+    ///
+    /// @return uint32_t
+    ///   Return number of entries in this file.
+    YAGE_NODISCARD auto EntryCount() const noexcept -> uint32_t { return entryCount; }
+
+    /// @brief
+    ///   Get table of contents of this file.
+    ///
+    /// @return const void *
+    ///   Return pointer to the first table of contents entry.
+    YAGE_NODISCARD auto Entries() const noexcept -> const void * { return entries; }
+
+    /// @brief
+    ///   Calculate hash value of entry name.
+    ///
+    /// @param name     Name of the entry.
+    ///
+    /// @return uint64_t
+    ///   Return hash value of the entry name.
+    YAGE_NODISCARD YAGE_API static auto HashName(StringView name) noexcept -> uint64_t;
+
+    /// @brief
+    ///   Write entries to a packed file. Entries are sorted by name hash and their data is aligned with @p format.dataAlignment.
+    ///
+    /// @param path     Path to the packed file to be written.
+    /// @param format   Format of the packed file.
+    /// @param count    Number of entries to be written.
+    /// @param items    Entries to be written. Names must be unique.
+    ///
+    /// @throw SystemErrorException
+    ///   Thrown if failed to write the file.
+    YAGE_API static auto Save(StringView              path,
+                              const PackedFileFormat &format,
+                              size_t                  count,
+                              const PackedFileItem   *items) -> void;
+
+private:
+    /// @brief  The file handle.
+    void *file;
+
+    /// @brief  File mapping handle of the file.
+    void *mapping;
+
+    /// @brief  Start of the mapped view of the file.
+    const uint8_t *view;
+
+    /// @brief  Size in byte of the file.
+    uint64_t fileSize;
+
+    /// @brief  Table of contents of this file.
+    const uint8_t *entries;
+
+    /// @brief  Size in byte of each table of contents entry.
+    uint32_t entrySize;
+
+    /// @brief  Number of entries in this file.
+    uint32_t entryCount;
+
+    /// @brief  Name table of this file.
+    const char16_t *names;
+};
+
+} // namespace YaGE
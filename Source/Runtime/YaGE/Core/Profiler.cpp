@@ -0,0 +1,249 @@
+#include "Profiler.h"
+#include "String.h"
+
+#include <Windows.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <string>
+
+using namespace YaGE;
+
+namespace {
+
+/// @brief
+///   Convert nanoseconds to milliseconds.
+///
+/// @param ns   Time in nanosecond.
+///
+/// @return double
+///   Return time in millisecond.
+YAGE_NODISCARD YAGE_FORCEINLINE auto ToMilliseconds(uint64_t ns) noexcept -> double {
+    return static_cast<double>(ns) / 1000000.0;
+}
+
+/// @brief
+///   Convert nanoseconds to microseconds. Chrome trace events use microseconds as time unit.
+///
+/// @param ns   Time in nanosecond.
+///
+/// @return double
+///   Return time in microsecond.
+YAGE_NODISCARD YAGE_FORCEINLINE auto ToMicroseconds(uint64_t ns) noexcept -> double {
+    return static_cast<double>(ns) / 1000.0;
+}
+
+/// @brief
+///   Write all data to the specified file.
+///
+/// @param path     Path of the file. The file is overwritten if it already exists.
+/// @param data     The data to be written.
+///
+/// @return bool
+/// @retval true    Succeeded to write the file.
+/// @retval false   Failed to write the file.
+YAGE_NODISCARD auto WriteTraceFile(StringView path, const std::string &data) noexcept -> bool {
+    HANDLE file = INVALID_HANDLE_VALUE;
+    if (path.IsNullTerminated()) {
+        file = CreateFileW(reinterpret_cast<LPCWSTR>(path.Data()), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+                           FILE_ATTRIBUTE_NORMAL, nullptr);
+    } else {
+        String tempPath(path);
+        file = CreateFileW(reinterpret_cast<LPCWSTR>(tempPath.Data()), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+                           FILE_ATTRIBUTE_NORMAL, nullptr);
+    }
+
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    DWORD      bytesWritten = 0;
+    const BOOL succeeded    = ::WriteFile(file, data.data(), static_cast<DWORD>(data.size()), &bytesWritten, nullptr);
+    CloseHandle(file);
+
+    return succeeded && bytesWritten == data.size();
+}
+
+} // namespace
+
+YaGE::Profiler::Profiler() noexcept
+    : timerTime(),
+      timerCalls(),
+      counters(),
+      tracing(false),
+      lastFrameEnd(Now()),
+      frameCount(),
+      lastFrame(),
+      traceBegin(),
+      traceEvents(),
+      traceFrames(),
+      mutex() {
+    for (size_t i = 0; i < TIMER_COUNT; ++i) {
+        timerTime[i].store(0, std::memory_order_relaxed);
+        timerCalls[i].store(0, std::memory_order_relaxed);
+    }
+
+    for (size_t i = 0; i < COUNTER_COUNT; ++i)
+        counters[i].store(0, std::memory_order_relaxed);
+}
+
+YaGE::Profiler::~Profiler() noexcept {}
+
+auto YaGE::Profiler::AddTime(ProfileTimer timer, uint64_t begin, uint64_t end) noexcept -> void {
+    const size_t index = static_cast<size_t>(timer);
+    timerTime[index].fetch_add(end - begin, std::memory_order_relaxed);
+    timerCalls[index].fetch_add(1, std::memory_order_relaxed);
+
+    if (!tracing.load(std::memory_order_relaxed))
+        return;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (traceEvents.size() < traceEvents.capacity())
+        traceEvents.push_back(TraceEvent{timer, static_cast<uint32_t>(GetCurrentThreadId()), begin, end});
+}
+
+auto YaGE::Profiler::EndFrame() noexcept -> void {
+    const uint64_t now = Now();
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    FrameStatistics stats{};
+    stats.frameIndex = frameCount++;
+    stats.frameTime  = ToMilliseconds(now - lastFrameEnd);
+
+    for (size_t i = 0; i < TIMER_COUNT; ++i) {
+        stats.timerTime[i]  = ToMilliseconds(timerTime[i].exchange(0, std::memory_order_relaxed));
+        stats.timerCalls[i] = timerCalls[i].exchange(0, std::memory_order_relaxed);
+    }
+
+    for (size_t i = 0; i < COUNTER_COUNT; ++i)
+        stats.counters[i] = counters[i].exchange(0, std::memory_order_relaxed);
+
+    lastFrame    = stats;
+    lastFrameEnd = now;
+
+    if (tracing.load(std::memory_order_relaxed) && traceFrames.size() < traceFrames.capacity())
+        traceFrames.push_back(TraceFrame{now, stats});
+}
+
+auto YaGE::Profiler::LastFrameStatistics() const noexcept -> FrameStatistics {
+    std::lock_guard<std::mutex> lock(mutex);
+    return lastFrame;
+}
+
+auto YaGE::Profiler::BeginTrace() noexcept -> void {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Reserve memory up front so that recording trace events never allocates or throws.
+    try {
+        traceEvents.clear();
+        traceEvents.reserve(MAX_TRACE_EVENTS);
+        traceFrames.clear();
+        traceFrames.reserve(MAX_TRACE_EVENTS / 64);
+    } catch (...) {
+        return;
+    }
+
+    traceBegin = Now();
+    tracing.store(true, std::memory_order_relaxed);
+}
+
+auto YaGE::Profiler::EndTrace(StringView path) noexcept -> bool {
+    std::vector<TraceEvent> events;
+    std::vector<TraceFrame> frames;
+    uint64_t                begin;
+
+    { // Lock scope.
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!tracing.load(std::memory_order_relaxed))
+            return false;
+
+        tracing.store(false, std::memory_order_relaxed);
+        events.swap(traceEvents);
+        frames.swap(traceFrames);
+        begin = traceBegin;
+    }
+
+    try {
+        std::string json;
+        json.reserve(events.size() * 96 + frames.size() * 256 + 64);
+        json += "{\"traceEvents\":[";
+
+        auto out   = std::back_inserter(json);
+        bool first = true;
+        for (const auto &event : events) {
+            // Events that begin before tracing starts are clamped.
+            const uint64_t eventBegin = std::max(event.begin, begin);
+            fmt::format_to(out, "{}{{\"name\":\"{}\",\"cat\":\"YaGE\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},"
+                           "\"dur\":{:.3f}}}",
+                           first ? "" : ",", TimerName(event.timer), event.threadID,
+                           ToMicroseconds(eventBegin - begin), ToMicroseconds(event.end - eventBegin));
+            first = false;
+        }
+
+        // Frame boundaries are written as instant events and counters are written as counter events.
+        for (const auto &frame : frames) {
+            const double ts = ToMicroseconds(frame.time - begin);
+            fmt::format_to(out, "{}{{\"name\":\"Frame {}\",\"cat\":\"YaGE\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,"
+                           "\"tid\":0,\"ts\":{:.3f}}}",
+                           first ? "" : ",", frame.statistics.frameIndex, ts);
+            first = false;
+
+            json += ",{\"name\":\"Counters\",\"ph\":\"C\",\"pid\":1,";
+            fmt::format_to(out, "\"ts\":{:.3f},\"args\":{{", ts);
+            for (size_t i = 0; i < COUNTER_COUNT; ++i)
+                fmt::format_to(out, "{}\"{}\":{}", (i == 0) ? "" : ",", CounterName(static_cast<ProfileCounter>(i)),
+                               frame.statistics.counters[i]);
+            json += "}}";
+        }
+
+        json += "],\"displayTimeUnit\":\"ms\"}";
+        return WriteTraceFile(path, json);
+    } catch (...) {
+        return false;
+    }
+}
+
+auto YaGE::Profiler::Now() noexcept -> uint64_t {
+    const auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+}
+
+auto YaGE::Profiler::TimerName(ProfileTimer timer) noexcept -> const char * {
+    switch (timer) {
+    case ProfileTimer::CommandBufferSubmit:
+        return "CommandBuffer::Submit";
+    case ProfileTimer::DescriptorHeapCommit:
+        return "DynamicDescriptorHeap::Commit";
+    case ProfileTimer::TempBufferAllocate:
+        return "TempBufferAllocator::Allocate";
+    case ProfileTimer::DeviceSync:
+        return "RenderDevice::Sync";
+    case ProfileTimer::SwapChainPresent:
+        return "SwapChain::Present";
+    default:
+        return "Unknown";
+    }
+}
+
+auto YaGE::Profiler::CounterName(ProfileCounter counter) noexcept -> const char * {
+    switch (counter) {
+    case ProfileCounter::DescriptorsCopied:
+        return "DescriptorsCopied";
+    case ProfileCounter::BarriersIssued:
+        return "BarriersIssued";
+    case ProfileCounter::UploadBytes:
+        return "UploadBytes";
+    case ProfileCounter::TempPagesCreated:
+        return "TempPagesCreated";
+    case ProfileCounter::RedundantStatesFiltered:
+        return "RedundantStatesFiltered";
+    default:
+        return "Unknown";
+    }
+}
+
+YAGE_NODISCARD auto YaGE::Profiler::Singleton() -> Profiler & {
+    static Profiler instance;
+    return instance;
+}
@@ -0,0 +1,257 @@
+#pragma once
+
+#include "StringView.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace YaGE {
+
+enum class ProfileTimer : uint32_t {
+    CommandBufferSubmit,
+    DescriptorHeapCommit,
+    TempBufferAllocate,
+    DeviceSync,
+    SwapChainPresent,
+    Count,
+};
+
+enum class ProfileCounter : uint32_t {
+    DescriptorsCopied,
+    BarriersIssued,
+    UploadBytes,
+    TempPagesCreated,
+    RedundantStatesFiltered,
+    Count,
+};
+
+struct FrameStatistics {
+    /// @brief  Index of the frame. Starts from 0.
+    uint64_t frameIndex;
+
+    /// @brief  CPU time in millisecond between the end of the previous frame and the end of this frame.
+    double frameTime;
+
+    /// @brief  Total CPU time in millisecond spent in each timer in this frame.
+    double timerTime[static_cast<size_t>(ProfileTimer::Count)];
+
+    /// @brief  Number of times that each timer is entered in this frame.
+    uint64_t timerCalls[static_cast<size_t>(ProfileTimer::Count)];
+
+    /// @brief  Value of each counter in this frame.
+    uint64_t counters[static_cast<size_t>(ProfileCounter::Count)];
+};
+
+class Profiler {
+public:
+    /// @brief
+    ///   Create a CPU profiler. All timers and counters are zero.
+    YAGE_API Profiler() noexcept;
+
+    /// @brief
+    ///   Copy constructor is disabled.
+    Profiler(const Profiler &) = delete;
+
+    /// @brief
+    ///   Copy assignment is disabled.
+    auto operator=(const Profiler &) = delete;
+
+    /// @brief
+    ///   Destroy this profiler.
+    YAGE_API ~Profiler() noexcept;
+
+    /// @brief
+    ///   Add a timed interval to the specified timer. This method is thread safe and lock free unless tracing is enabled.
+    ///
+    /// @param timer    The timer to be added to.
+    /// @param begin    Begin time in nanosecond of the interval. See @p Now().
+    /// @param end      End time in nanosecond of the interval. See @p Now().
+    YAGE_API auto AddTime(ProfileTimer timer, uint64_t begin, uint64_t end) noexcept -> void;
+
+    /// @brief
+    ///   Add value to the specified counter. This method is thread safe and lock free.
+    ///
+    /// @param counter  The counter to be added to.
+    /// @param value    The value to be added.
+    auto AddCount(ProfileCounter counter, uint64_t value) noexcept -> void {
+        counters[static_cast<size_t>(counter)].fetch_add(value, std::memory_order_relaxed);
+    }
+
+    /// @brief
+    ///   Finish current frame. Timers and counters of current frame are stored as statistics of the last frame and then reset to zero. This is called by @p SwapChain::Present() if profiler is enabled.
+    YAGE_API auto EndFrame() noexcept -> void;
+
+    /// @brief
+    ///   Get statistics of the last finished frame.
+    ///
+    /// @return FrameStatistics
+    ///   Return statistics of the last finished frame.
+    YAGE_NODISCARD YAGE_API auto LastFrameStatistics() const noexcept -> FrameStatistics;
+
+    /// @brief
+    ///   Start recording trace events. Previously recorded trace events are discarded.
+    YAGE_API auto BeginTrace() noexcept -> void;
+
+    /// @brief
+    ///   Stop recording trace events and write them to the specified file in Chrome trace event JSON format. The file could be opened by chrome://tracing or Perfetto.
+    ///
+    /// @param path     Path of the trace file. The file is overwritten if it already exists.
+    ///
+    /// @return bool
+    /// @retval true    Succeeded to write the trace file.
+    /// @retval false   Failed to write the trace file or tracing is not started.
+    YAGE_API auto EndTrace(StringView path) noexcept -> bool;
+
+    /// @brief
+    ///   Checks if trace events are being recorded.
+    ///
+    /// @return bool
+    /// @retval true    Trace events are being recorded.
+    /// @retval false   Trace events are not being recorded.
+    YAGE_NODISCARD auto IsTracing() const noexcept -> bool { return tracing.load(std::memory_order_relaxed); }
+
+    /// @brief
+    ///   Get current time in nanosecond from a monotonic clock.
+    ///
+    /// @return uint64_t
+    ///   Return current time in nanosecond.
+    YAGE_NODISCARD YAGE_API static auto Now() noexcept -> uint64_t;
+
+    /// @brief
+    ///   Get name of the specified timer.
+    ///
+    /// @param timer    The timer to be queried.
+    ///
+    /// @return const char *
+    ///   Return null-terminated name of the timer.
+    YAGE_NODISCARD YAGE_API static auto TimerName(ProfileTimer timer) noexcept -> const char *;
+
+    /// @brief
+    ///   Get name of the specified counter.
+    ///
+    /// @param counter  The counter to be queried.
+    ///
+    /// @return const char *
+    ///   Return null-terminated name of the counter.
+    YAGE_NODISCARD YAGE_API static auto CounterName(ProfileCounter counter) noexcept -> const char *;
+
+    /// @brief
+    ///   Get global singleton instance of profiler.
+    ///
+    /// @return Profiler &
+    ///   Return reference to the profiler singleton instance.
+    YAGE_NODISCARD YAGE_API static auto Singleton() -> Profiler &;
+
+private:
+    struct TraceEvent {
+        /// @brief  The timer of this event.
+        ProfileTimer timer;
+
+        /// @brief  ID of the thread that this event is recorded on.
+        uint32_t threadID;
+
+        /// @brief  Begin time in nanosecond of this event.
+        uint64_t begin;
+
+        /// @brief  End time in nanosecond of this event.
+        uint64_t end;
+    };
+
+    struct TraceFrame {
+        /// @brief  End time in nanosecond of this frame.
+        uint64_t time;
+
+        /// @brief  Statistics of this frame.
+        FrameStatistics statistics;
+    };
+
+    /// @brief  Maximum number of trace events to be recorded. Events beyond this limit are dropped. Memory of trace events is reserved when tracing starts.
+    static constexpr const size_t MAX_TRACE_EVENTS = 0x100000;
+
+    /// @brief  Number of timers.
+    static constexpr const size_t TIMER_COUNT = static_cast<size_t>(ProfileTimer::Count);
+
+    /// @brief  Number of counters.
+    static constexpr const size_t COUNTER_COUNT = static_cast<size_t>(ProfileCounter::Count);
+
+private:
+    /// @brief  Total time in nanosecond of each timer in current frame.
+    std::atomic<uint64_t> timerTime[TIMER_COUNT];
+
+    /// @brief  Number of calls of each timer in current frame.
+    std::atomic<uint64_t> timerCalls[TIMER_COUNT];
+
+    /// @brief  Value of each counter in current frame.
+    std::atomic<uint64_t> counters[COUNTER_COUNT];
+
+    /// @brief  Whether trace events are being recorded.
+    std::atomic<bool> tracing;
+
+    /// @brief  End time in nanosecond of the last frame.
+    uint64_t lastFrameEnd;
+
+    /// @brief  Number of finished frames.
+    uint64_t frameCount;
+
+    /// @brief  Statistics of the last finished frame.
+    FrameStatistics lastFrame;
+
+    /// @brief  Start time in nanosecond of current trace.
+    uint64_t traceBegin;
+
+    /// @brief  Recorded trace events.
+    std::vector<TraceEvent> traceEvents;
+
+    /// @brief  Recorded frames of current trace.
+    std::vector<TraceFrame> traceFrames;
+
+    /// @brief  Mutex that protects frame statistics and trace events.
+    mutable std::mutex mutex;
+};
+
+class ProfileScope {
+public:
+    /// @brief
+    ///   Start timing the specified timer. The interval is added to the timer when this object is destroyed.
+    ///
+    /// @param timer    The timer to be timed.
+    explicit ProfileScope(ProfileTimer timer) noexcept : timer(timer), begin(Profiler::Now()) {}
+
+    /// @brief
+    ///   Copy constructor is disabled.
+    ProfileScope(const ProfileScope &) = delete;
+
+    /// @brief
+    ///   Copy assignment is disabled.
+    auto operator=(const ProfileScope &) = delete;
+
+    /// @brief
+    ///   Stop timing and add the interval to the timer.
+    ~ProfileScope() noexcept { Profiler::Singleton().AddTime(timer, begin, Profiler::Now()); }
+
+private:
+    /// @brief  The timer to be timed.
+    ProfileTimer timer;
+
+    /// @brief  Begin time in nanosecond.
+    uint64_t begin;
+};
+
+} // namespace YaGE
+
+#define YAGE_PROFILE_CONCAT_IMPL(a, b) a##b
+#define YAGE_PROFILE_CONCAT(a, b) YAGE_PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef YAGE_ENABLE_PROFILER
+#    define YAGE_PROFILE_SCOPE(timer)                                                                                 \
+        ::YaGE::ProfileScope YAGE_PROFILE_CONCAT(yageProfileScope, __LINE__)(::YaGE::ProfileTimer::timer)
+#    define YAGE_PROFILE_COUNT(counter, value)                                                                        \
+        ::YaGE::Profiler::Singleton().AddCount(::YaGE::ProfileCounter::counter, static_cast<uint64_t>(value))
+#    define YAGE_PROFILE_FRAME() ::YaGE::Profiler::Singleton().EndFrame()
+#else
+#    define YAGE_PROFILE_SCOPE(timer) ((void)0)
+#    define YAGE_PROFILE_COUNT(counter, value) ((void)0)
+#    define YAGE_PROFILE_FRAME() ((void)0)
+#endif
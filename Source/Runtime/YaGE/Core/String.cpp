@@ -1,4 +1,5 @@
 #include "String.h"
+#include "Memory.h"
 
 using namespace YaGE;
 
@@ -22,7 +23,7 @@ YaGE::String::String(const value_type *ptr, size_type len) noexcept {
     } else {
         const size_type allocCount = alignUpAllocCount(len + 1);
         const size_type allocSize  = allocCount * sizeof(value_type);
-        const pointer   buffer     = static_cast<pointer>(malloc(allocSize));
+        const pointer   buffer     = static_cast<pointer>(AllocateMemory(allocSize));
 
         traits_type::copy(buffer, ptr, len);
         traits_type::assign(buffer[len], value_type());
@@ -46,7 +47,7 @@ YaGE::String::String(const value_type *ptr) noexcept {
     } else {
         const size_type allocCount = alignUpAllocCount(len + 1);
         const size_type allocSize  = allocCount * sizeof(value_type);
-        const pointer   buffer     = static_cast<pointer>(malloc(allocSize));
+        const pointer   buffer     = static_cast<pointer>(AllocateMemory(allocSize));
 
         // Copy with trailing '\0'.
         traits_type::copy(buffer, ptr, len + 1);
@@ -72,7 +73,7 @@ YaGE::String::String(StringView str) noexcept {
     } else {
         const size_type allocCount = alignUpAllocCount(len + 1);
         const size_type allocSize  = allocCount * sizeof(value_type);
-        const pointer   buffer     = static_cast<pointer>(malloc(allocSize));
+        const pointer   buffer     = static_cast<pointer>(AllocateMemory(allocSize));
 
         traits_type::copy(buffer, ptr, len);
         traits_type::assign(buffer[len], value_type());
@@ -95,7 +96,7 @@ YaGE::String::String(const String &other) noexcept {
 
         const size_type allocCount = alignUpAllocCount(len + 1);
         const size_type allocSize  = allocCount * sizeof(value_type);
-        const pointer   buffer     = static_cast<pointer>(malloc(allocSize));
+        const pointer   buffer     = static_cast<pointer>(AllocateMemory(allocSize));
 
         // Copy with trailing '\0'.
         traits_type::copy(buffer, ptr, len + 1);
@@ -141,8 +142,8 @@ auto YaGE::String::operator=(const String &other) noexcept -> String & {
             const size_type allocCount = alignUpAllocCount(len + 1);
             const size_type allocSize  = allocCount * sizeof(value_type);
 
-            free(_impl.l.ptr);
-            _impl.l.ptr      = static_cast<pointer>(malloc(allocSize));
+            FreeMemory(_impl.l.ptr);
+            _impl.l.ptr      = static_cast<pointer>(AllocateMemory(allocSize));
             _impl.l.capacity = allocCount - 1;
         }
 
@@ -151,7 +152,7 @@ auto YaGE::String::operator=(const String &other) noexcept -> String & {
     } else {
         const size_type allocCount = alignUpAllocCount(len + 1);
         const size_type allocSize  = allocCount * sizeof(value_type);
-        const pointer   buffer     = static_cast<pointer>(malloc(allocSize));
+        const pointer   buffer     = static_cast<pointer>(AllocateMemory(allocSize));
 
         // Copy with trailing '\0'.
         traits_type::copy(buffer, str, len + 1);
@@ -168,7 +169,7 @@ auto YaGE::String::operator=(const String &other) noexcept -> String & {
 
 auto YaGE::String::operator=(String &&other) noexcept -> String & {
     if (_impl.l.isLong)
-        free(_impl.l.ptr);
+        FreeMemory(_impl.l.ptr);
 
     _impl = other._impl;
     memset(&other._impl, 0, sizeof(other._impl));
@@ -178,7 +179,7 @@ auto YaGE::String::operator=(String &&other) noexcept -> String & {
 
 YaGE::String::~String() noexcept {
     if (_impl.l.isLong)
-        free(_impl.l.ptr);
+        FreeMemory(_impl.l.ptr);
 }
 
 auto YaGE::String::operator=(const_pointer str) noexcept -> String & {
@@ -200,8 +201,8 @@ auto YaGE::String::operator=(const_pointer str) noexcept -> String & {
             const size_type allocCount = alignUpAllocCount(len + 1);
             const size_type allocSize  = allocCount * sizeof(value_type);
 
-            free(_impl.l.ptr);
-            _impl.l.ptr      = static_cast<pointer>(malloc(allocSize));
+            FreeMemory(_impl.l.ptr);
+            _impl.l.ptr      = static_cast<pointer>(AllocateMemory(allocSize));
             _impl.l.capacity = allocCount - 1;
         }
 
@@ -210,7 +211,7 @@ auto YaGE::String::operator=(const_pointer str) noexcept -> String & {
     } else {
         const size_type allocCount = alignUpAllocCount(len + 1);
         const size_type allocSize  = allocCount * sizeof(value_type);
-        const pointer   buffer     = static_cast<pointer>(malloc(allocSize));
+        const pointer   buffer     = static_cast<pointer>(AllocateMemory(allocSize));
 
         // Copy with trailing '\0'.
         traits_type::move(buffer, str, len + 1);
@@ -262,8 +263,8 @@ auto YaGE::String::operator=(StringView str) noexcept -> String & {
             const size_type allocCount = alignUpAllocCount(len + 1);
             const size_type allocSize  = allocCount * sizeof(value_type);
 
-            free(_impl.l.ptr);
-            _impl.l.ptr      = static_cast<pointer>(malloc(allocSize));
+            FreeMemory(_impl.l.ptr);
+            _impl.l.ptr      = static_cast<pointer>(AllocateMemory(allocSize));
             _impl.l.capacity = allocCount - 1;
         }
 
@@ -273,7 +274,7 @@ auto YaGE::String::operator=(StringView str) noexcept -> String & {
     } else {
         const size_type allocCount = alignUpAllocCount(len + 1);
         const size_type allocSize  = allocCount * sizeof(value_type);
-        const pointer   buffer     = static_cast<pointer>(malloc(allocSize));
+        const pointer   buffer     = static_cast<pointer>(AllocateMemory(allocSize));
 
         traits_type::move(buffer, ptr, len);
         traits_type::assign(buffer[len], value_type());
@@ -295,8 +296,13 @@ auto YaGE::String::Reserve(size_type newCap) noexcept -> void {
 
         const size_type allocCount = alignUpAllocCount(newCap + 1);
         const size_type allocSize  = allocCount * sizeof(value_type);
+        const pointer   buffer     = static_cast<pointer>(AllocateMemory(allocSize));
 
-        _impl.l.ptr      = static_cast<pointer>(realloc(_impl.l.ptr, allocSize));
+        // Memory callbacks do not support reallocation. Copy with trailing '\0'.
+        traits_type::copy(buffer, _impl.l.ptr, _impl.l.size + size_type(1));
+        FreeMemory(_impl.l.ptr);
+
+        _impl.l.ptr      = buffer;
         _impl.l.capacity = allocCount - 1;
     } else {
         if (newCap < SHORT_CAPACITY)
@@ -306,7 +312,7 @@ auto YaGE::String::Reserve(size_type newCap) noexcept -> void {
 
         const size_type allocCount = alignUpAllocCount(newCap + 1);
         const size_type allocSize  = allocCount * sizeof(value_type);
-        const pointer   buffer     = static_cast<pointer>(malloc(allocSize));
+        const pointer   buffer     = static_cast<pointer>(AllocateMemory(allocSize));
 
         // Copy with trailing '\0'.
         traits_type::copy(buffer, _impl.s.str, _impl.s.size + size_type(1));
@@ -1,7 +1,143 @@
 #include "StringView.h"
 
+#include <emmintrin.h>
+#include <intrin.h>
+
 using namespace YaGE;
 
+namespace {
+
+/// @brief
+///   Compare 8 characters with the specified pattern.
+///
+/// @return uint32_t
+///   Return a byte mask of the comparison result. Each matched character sets 2 adjacent bits.
+YAGE_FORCEINLINE auto MatchChars(const char16_t *str, __m128i pattern) noexcept -> uint32_t {
+    const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(str));
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi16(block, pattern)));
+}
+
+} // namespace
+
+YAGE_NODISCARD auto YaGE::StringView::SearchChar(const_pointer first, const_pointer last, value_type ch) noexcept
+    -> const_pointer {
+    const __m128i pattern = _mm_set1_epi16(static_cast<short>(ch));
+
+    const_pointer i = first;
+    for (; last - i >= 8; i += 8) {
+        const uint32_t mask = MatchChars(i, pattern);
+        if (mask != 0) {
+            unsigned long index;
+            _BitScanForward(&index, mask);
+            return i + index / 2;
+        }
+    }
+
+    for (; i != last; ++i) {
+        if (traits_type::eq(*i, ch))
+            return i;
+    }
+
+    return nullptr;
+}
+
+YAGE_NODISCARD auto YaGE::StringView::SearchCharReverse(const_pointer first, const_pointer last, value_type ch) noexcept
+    -> const_pointer {
+    const __m128i pattern = _mm_set1_epi16(static_cast<short>(ch));
+
+    const_pointer i = last;
+    for (; i - first >= 8; i -= 8) {
+        const uint32_t mask = MatchChars(i - 8, pattern);
+        if (mask != 0) {
+            unsigned long index;
+            _BitScanReverse(&index, mask);
+            return i - 8 + index / 2;
+        }
+    }
+
+    while (i != first) {
+        --i;
+        if (traits_type::eq(*i, ch))
+            return i;
+    }
+
+    return nullptr;
+}
+
+YAGE_NODISCARD auto YaGE::StringView::SearchString(const_pointer first,
+                                                   const_pointer last,
+                                                   const_pointer str,
+                                                   size_type     count) noexcept -> const_pointer {
+    if (count == 1)
+        return SearchChar(first, last, str[0]);
+
+    const __m128i head = _mm_set1_epi16(static_cast<short>(str[0]));
+    const __m128i tail = _mm_set1_epi16(static_cast<short>(str[count - 1]));
+
+    // Start position of the last possible match.
+    const const_pointer lastStart = last - count;
+
+    const_pointer i = first;
+    for (; lastStart - i >= 7; i += 8) {
+        // Only keep the lower bit of each character.
+        uint32_t mask = MatchChars(i, head) & MatchChars(i + count - 1, tail) & 0x5555U;
+        while (mask != 0) {
+            unsigned long index;
+            _BitScanForward(&index, mask);
+
+            const const_pointer candidate = i + index / 2;
+            if (traits_type::compare(candidate + 1, str + 1, count - 2) == 0)
+                return candidate;
+
+            mask &= mask - 1;
+        }
+    }
+
+    for (; i <= lastStart; ++i) {
+        if (traits_type::compare(i, str, count) == 0)
+            return i;
+    }
+
+    return nullptr;
+}
+
+YAGE_NODISCARD auto YaGE::StringView::SearchStringReverse(const_pointer first,
+                                                          const_pointer last,
+                                                          const_pointer str,
+                                                          size_type     count) noexcept -> const_pointer {
+    if (count == 1)
+        return SearchCharReverse(first, last, str[0]);
+
+    const __m128i head = _mm_set1_epi16(static_cast<short>(str[0]));
+    const __m128i tail = _mm_set1_epi16(static_cast<short>(str[count - 1]));
+
+    // One past start position of the last possible match.
+    const_pointer i = last - count + 1;
+    for (; i - first >= 8; i -= 8) {
+        const const_pointer blockStart = i - 8;
+
+        uint32_t mask = MatchChars(blockStart, head) & MatchChars(blockStart + count - 1, tail) & 0x5555U;
+        while (mask != 0) {
+            unsigned long index;
+            _BitScanReverse(&index, mask);
+
+            const const_pointer candidate = blockStart + index / 2;
+            if (traits_type::compare(candidate + 1, str + 1, count - 2) == 0)
+                return candidate;
+
+            mask ^= (1U << index);
+        }
+    }
+
+    while (i != first) {
+        --i;
+        if (traits_type::compare(i, str, count) == 0)
+            return i;
+    }
+
+    return nullptr;
+}
+
 YAGE_NODISCARD auto YaGE::StringView::Split(StringView delims) const noexcept -> std::vector<StringView> {
     std::vector<StringView> result;
 
@@ -28,12 +164,10 @@ YAGE_NODISCARD auto YaGE::StringView::Split(value_type delim) const noexcept ->
     const_pointer       lastSplit = ptr;
     const const_pointer cmpEnd    = ptr + len;
 
-    for (const_pointer i = ptr; i != cmpEnd; ++i) {
-        if (traits_type::eq(*i, delim)) {
-            if (i != lastSplit)
-                result.emplace_back(lastSplit, static_cast<size_type>(i - lastSplit));
-            lastSplit = i + 1;
-        }
+    for (const_pointer i = SearchChar(ptr, cmpEnd, delim); i != nullptr; i = SearchChar(i + 1, cmpEnd, delim)) {
+        if (i != lastSplit)
+            result.emplace_back(lastSplit, static_cast<size_type>(i - lastSplit));
+        lastSplit = i + 1;
     }
 
     if (lastSplit < ptr + len)
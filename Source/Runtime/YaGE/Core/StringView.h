@@ -300,15 +300,7 @@ public:
     /// @retval true   This StringView contains @p str.
     /// @retval false  This StringView does not contain @p str.
     YAGE_NODISCARD constexpr auto Contains(StringView str) const noexcept -> bool {
-        if (str.len > len)
-            return false;
-
-        const const_pointer cmpEnd = ptr + len - str.len + 1;
-        for (const_pointer i = ptr; i != cmpEnd; ++i) {
-            if (traits_type::compare(i, str.ptr, str.len) == 0)
-                return true;
-        }
-        return false;
+        return IndexOf(str) != size_type(-1);
     }
 
     /// @brief
@@ -320,6 +312,9 @@ public:
     /// @retval true    This StringView contains character @p ch.
     /// @retval false   This StringView doesn't contain character @p ch.
     YAGE_NODISCARD constexpr auto Contains(value_type ch) const noexcept -> bool {
+        if (!YAGE_IS_CONSTANT_EVALUATED() && len >= SIMD_SEARCH_THRESHOLD)
+            return SearchChar(ptr, ptr + len, ch) != nullptr;
+
         const const_pointer cmpEnd = ptr + len;
         for (const_pointer i = ptr; i != cmpEnd; ++i) {
             if (traits_type::eq(*i, ch))
@@ -340,6 +335,9 @@ public:
         if (str.len + from > len)
             return size_type(-1);
 
+        if (!YAGE_IS_CONSTANT_EVALUATED() && str.len != 0 && len - from >= SIMD_SEARCH_THRESHOLD)
+            return ToIndex(SearchString(ptr + from, ptr + len, str.ptr, str.len));
+
         const const_pointer cmpEnd = ptr + len - str.len + 1;
         for (const_pointer i = ptr + from; i != cmpEnd; ++i) {
             if (traits_type::compare(i, str.ptr, str.len) == 0)
@@ -360,8 +358,11 @@ public:
         if (from >= len)
             return size_type(-1);
 
+        if (!YAGE_IS_CONSTANT_EVALUATED() && len - from >= SIMD_SEARCH_THRESHOLD)
+            return ToIndex(SearchChar(ptr + from, ptr + len, ch));
+
         const const_pointer cmpEnd = ptr + len;
-        for (const_pointer i = ptr; i != cmpEnd; ++i) {
+        for (const_pointer i = ptr + from; i != cmpEnd; ++i) {
             if (traits_type::eq(*i, ch))
                 return static_cast<size_type>(i - ptr);
         }
@@ -379,6 +380,9 @@ public:
         if (str.len > len)
             return size_type(-1);
 
+        if (!YAGE_IS_CONSTANT_EVALUATED() && str.len != 0 && len >= SIMD_SEARCH_THRESHOLD)
+            return ToIndex(SearchStringReverse(ptr, ptr + len, str.ptr, str.len));
+
         const const_pointer searchStart = ptr + len - str.len + 1;
         for (const_pointer i = searchStart; i != ptr; --i) {
             if (traits_type::compare(i - 1, str.ptr, str.len) == 0)
@@ -401,6 +405,10 @@ public:
 
         const const_pointer searchStart = (from + str.len > len ? ptr + len - str.len + 1 : ptr + from + 1);
 
+        // Matches must start before the search start, so that they end before the search start plus pattern length.
+        if (!YAGE_IS_CONSTANT_EVALUATED() && str.len != 0 && size_type(searchStart - ptr) >= SIMD_SEARCH_THRESHOLD)
+            return ToIndex(SearchStringReverse(ptr, searchStart - 1 + str.len, str.ptr, str.len));
+
         for (const_pointer i = searchStart; i != ptr; --i) {
             if (traits_type::compare(i - 1, str.ptr, str.len) == 0)
                 return static_cast<size_type>(i - ptr - 1);
@@ -419,6 +427,9 @@ public:
         if (len == 0)
             return size_type(-1);
 
+        if (!YAGE_IS_CONSTANT_EVALUATED() && len >= SIMD_SEARCH_THRESHOLD)
+            return ToIndex(SearchCharReverse(ptr, ptr + len, ch));
+
         for (const_pointer i = ptr + len; i != ptr; --i) {
             if (traits_type::eq(*(i - 1), ch))
                 return static_cast<size_type>(i - ptr - 1);
@@ -440,6 +451,9 @@ public:
 
         const const_pointer searchStart = (from + 1 > len ? ptr + len : ptr + from + 1);
 
+        if (!YAGE_IS_CONSTANT_EVALUATED() && size_type(searchStart - ptr) >= SIMD_SEARCH_THRESHOLD)
+            return ToIndex(SearchCharReverse(ptr, searchStart, ch));
+
         for (const_pointer i = searchStart; i != ptr; --i) {
             if (traits_type::eq(*(i - 1), ch))
                 return static_cast<size_type>(i - ptr - 1);
@@ -567,6 +581,52 @@ public:
     }
 
 private:
+    /// @brief
+    ///   Convert result of search kernels to index in this StringView.
+    YAGE_NODISCARD auto ToIndex(const_pointer position) const noexcept -> size_type {
+        return position == nullptr ? size_type(-1) : static_cast<size_type>(position - ptr);
+    }
+
+    /// @brief
+    ///   Find the first occurrence of the specified character with SSE2 instructions.
+    ///
+    /// @return const_pointer
+    ///   Return pointer to the first occurrence in range [@p first, @p last). Return @p nullptr if not found.
+    YAGE_NODISCARD YAGE_API static auto SearchChar(const_pointer first, const_pointer last, value_type ch) noexcept
+        -> const_pointer;
+
+    /// @brief
+    ///   Find the last occurrence of the specified character with SSE2 instructions.
+    ///
+    /// @return const_pointer
+    ///   Return pointer to the last occurrence in range [@p first, @p last). Return @p nullptr if not found.
+    YAGE_NODISCARD YAGE_API static auto SearchCharReverse(const_pointer first,
+                                                          const_pointer last,
+                                                          value_type    ch) noexcept -> const_pointer;
+
+    /// @brief
+    ///   Find the first occurrence of the specified non-empty pattern with SSE2 instructions. Positions whose first and last characters both match the pattern are found 8 at a time and then verified.
+    ///
+    /// @return const_pointer
+    ///   Return pointer to the first occurrence that lies in range [@p first, @p last). Return @p nullptr if not found.
+    YAGE_NODISCARD YAGE_API static auto SearchString(const_pointer first,
+                                                     const_pointer last,
+                                                     const_pointer str,
+                                                     size_type     count) noexcept -> const_pointer;
+
+    /// @brief
+    ///   Find the last occurrence of the specified non-empty pattern with SSE2 instructions.
+    ///
+    /// @return const_pointer
+    ///   Return pointer to the last occurrence that lies in range [@p first, @p last). Return @p nullptr if not found.
+    YAGE_NODISCARD YAGE_API static auto SearchStringReverse(const_pointer first,
+                                                            const_pointer last,
+                                                            const_pointer str,
+                                                            size_type     count) noexcept -> const_pointer;
+
+    /// @brief  Minimum number of characters to be searched with SIMD kernels. Shorter strings are searched inline.
+    static constexpr const size_type SIMD_SEARCH_THRESHOLD = 32;
+
     /// @brief Pointer to start of this string.
     const value_type *ptr = nullptr;
 
@@ -0,0 +1,374 @@
+#pragma once
+
+#include "ThreadPool.h"
+
+#if YAGE_CPLUSPLUS >= 202002L && defined(__has_include)
+#    if __has_include(<coroutine>)
+#        define YAGE_HAS_COROUTINE 1
+#    endif
+#endif
+
+#ifdef YAGE_HAS_COROUTINE
+
+#    include <coroutine>
+#    include <exception>
+#    include <optional>
+
+namespace YaGE {
+
+class ScheduleAwaiter {
+public:
+    /// @brief
+    ///   Create an awaiter that resumes the awaiting coroutine on worker threads of the specified thread pool.
+    ///
+    /// @param[in] threadPool   The thread pool that the coroutine is resumed on.
+    explicit ScheduleAwaiter(ThreadPool &threadPool) noexcept : pool(threadPool) {}
+
+    /// @brief
+    ///   The awaiting coroutine is always suspended.
+    auto await_ready() const noexcept -> bool { return false; }
+
+    /// @brief
+    ///   Push resumption of the awaiting coroutine to the thread pool.
+    ///
+    /// @param handle   The awaiting coroutine.
+    auto await_suspend(std::coroutine_handle<> handle) -> void { Post(pool, handle); }
+
+    /// @brief
+    ///   Nothing to return.
+    auto await_resume() const noexcept -> void {}
+
+    /// @brief
+    ///   Resume the specified coroutine on worker threads of the specified thread pool. This is used by awaiters whose completion is notified on threads that should not run coroutines, such as the sync point callback thread of @p RenderDevice.
+    ///
+    /// @param[in] threadPool   The thread pool that the coroutine is resumed on.
+    /// @param     handle       The coroutine to be resumed.
+    static auto Post(ThreadPool &threadPool, std::coroutine_handle<> handle) -> void {
+        threadPool.Enqueue([handle]() { handle.resume(); });
+    }
+
+private:
+    /// @brief  The thread pool that the coroutine is resumed on.
+    ThreadPool &pool;
+};
+
+/// @brief
+///   Resume current coroutine on worker threads of the specified thread pool. Use @p co_await @p Schedule() at the beginning of a task to run the task in parallel.
+///
+/// @param[in] pool     The thread pool that current coroutine is resumed on.
+///
+/// @return ScheduleAwaiter
+///   Return an awaiter that resumes current coroutine on @p pool.
+YAGE_NODISCARD inline auto Schedule(ThreadPool &pool = ThreadPool::Singleton()) noexcept -> ScheduleAwaiter {
+    return ScheduleAwaiter(pool);
+}
+
+class DetachedTask {
+public:
+    struct promise_type {
+        auto get_return_object() const noexcept -> DetachedTask { return DetachedTask(); }
+        auto initial_suspend() const noexcept -> std::suspend_never { return {}; }
+        auto final_suspend() const noexcept -> std::suspend_never { return {}; }
+        auto return_void() const noexcept -> void {}
+        auto unhandled_exception() const noexcept -> void { std::terminate(); }
+    };
+};
+
+class TaskPromiseBase {
+public:
+    struct FinalAwaiter {
+        auto await_ready() const noexcept -> bool { return false; }
+
+        template <typename Promise>
+        auto await_suspend(std::coroutine_handle<Promise> handle) noexcept -> std::coroutine_handle<> {
+            TaskPromiseBase &promise = handle.promise();
+            if (promise.continuation)
+                return promise.continuation;
+
+            // Detached tasks are destroyed once finished. Exceptions of detached tasks are discarded.
+            if (promise.isDetached)
+                handle.destroy();
+
+            return std::noop_coroutine();
+        }
+
+        auto await_resume() const noexcept -> void {}
+    };
+
+    /// @brief
+    ///   Tasks are lazily started once awaited, waited or detached.
+    auto initial_suspend() const noexcept -> std::suspend_always { return {}; }
+
+    /// @brief
+    ///   Transfer execution to the awaiting coroutine once finished.
+    auto final_suspend() const noexcept -> FinalAwaiter { return {}; }
+
+    /// @brief
+    ///   Store the exception thrown by the task. The exception is rethrown when result of the task is retrieved.
+    auto unhandled_exception() noexcept -> void { exception = std::current_exception(); }
+
+    /// @brief  The coroutine that is awaiting this task.
+    std::coroutine_handle<> continuation;
+
+    /// @brief  Exception thrown by this task.
+    std::exception_ptr exception;
+
+    /// @brief  Whether the task has been detached.
+    bool isDetached = false;
+};
+
+template <typename T = void>
+class Task {
+public:
+    class promise_type : public TaskPromiseBase {
+    public:
+        auto get_return_object() noexcept -> Task {
+            return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        template <typename U>
+        auto return_value(U &&value) -> void {
+            result.emplace(std::forward<U>(value));
+        }
+
+        auto Result() -> T {
+            if (exception != nullptr)
+                std::rethrow_exception(exception);
+            return std::move(*result);
+        }
+
+    private:
+        /// @brief  Value returned by the task.
+        std::optional<T> result;
+    };
+
+    /// @brief
+    ///   Create an empty task.
+    Task() noexcept : handle() {}
+
+    /// @brief
+    ///   Copy constructor is disabled.
+    Task(const Task &) = delete;
+
+    /// @brief
+    ///   Copy assignment is disabled.
+    auto operator=(const Task &) = delete;
+
+    /// @brief
+    ///   Move constructor of task. The moved task will be empty.
+    ///
+    /// @param other    The task to be moved.
+    Task(Task &&other) noexcept : handle(other.handle) { other.handle = nullptr; }
+
+    /// @brief
+    ///   Move assignment of task. The moved task will be empty.
+    ///
+    /// @param other    The task to be moved.
+    ///
+    /// @return Task &
+    ///   Return reference to this task.
+    auto operator=(Task &&other) noexcept -> Task & {
+        if (this != &other) {
+            if (handle)
+                handle.destroy();
+            handle       = other.handle;
+            other.handle = nullptr;
+        }
+        return *this;
+    }
+
+    /// @brief
+    ///   Destroy this task. The task must either be finished or never started.
+    ~Task() noexcept {
+        if (handle)
+            handle.destroy();
+    }
+
+    /// @brief
+    ///   Checks if this task is finished.
+    ///
+    /// @return bool
+    /// @retval true    This task is empty or finished.
+    /// @retval false   This task is not started or still running.
+    YAGE_NODISCARD auto IsDone() const noexcept -> bool { return !handle || handle.done(); }
+
+    /// @brief
+    ///   Start this task and block current thread until it is finished. Prefer @p co_await in coroutines.
+    ///
+    /// @return T
+    ///   Return result of this task.
+    ///
+    /// @throw
+    ///   Rethrow the exception thrown by this task.
+    auto Get() -> T {
+        if (!handle.done()) {
+            SyncWaitState state;
+            SyncWait(*this, state);
+
+            std::unique_lock<std::mutex> lock(state.mutex);
+            state.condition.wait(lock, [&state]() { return state.isDone; });
+        }
+
+        return handle.promise().Result();
+    }
+
+    /// @brief
+    ///   Start this task without waiting for it. The task is destroyed once finished and its result is discarded. This task will be empty after detached.
+    auto Detach() noexcept -> void {
+        std::coroutine_handle<promise_type> task = handle;
+        handle                                   = nullptr;
+
+        task.promise().isDetached = true;
+        task.resume();
+    }
+
+    /// @brief
+    ///   Start this task and suspend the awaiting coroutine until this task is finished.
+    auto operator co_await() noexcept {
+        struct Awaiter {
+            auto await_ready() const noexcept -> bool { return task.done(); }
+
+            auto await_suspend(std::coroutine_handle<> awaiting) noexcept -> std::coroutine_handle<> {
+                task.promise().continuation = awaiting;
+                return task;
+            }
+
+            auto await_resume() -> T { return task.promise().Result(); }
+
+            std::coroutine_handle<promise_type> task;
+        };
+
+        return Awaiter{handle};
+    }
+
+private:
+    /// @brief
+    ///   Create a task from coroutine handle.
+    ///
+    /// @param coroutine    Handle of the task coroutine.
+    explicit Task(std::coroutine_handle<promise_type> coroutine) noexcept : handle(coroutine) {}
+
+    /// @brief
+    ///   State that is used to notify the thread that waits for a task.
+    struct SyncWaitState {
+        std::mutex              mutex;
+        std::condition_variable condition;
+        bool                    isDone = false;
+    };
+
+    /// @brief
+    ///   Await the specified task and notify the waiting thread once finished.
+    static auto SyncWait(Task &task, SyncWaitState &state) -> DetachedTask {
+        try {
+            co_await task;
+        } catch (...) {
+            // The exception is rethrown by Get().
+        }
+
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.isDone = true;
+        state.condition.notify_all();
+    }
+
+private:
+    /// @brief  Handle of the task coroutine.
+    std::coroutine_handle<promise_type> handle;
+};
+
+template <>
+class Task<void>::promise_type : public TaskPromiseBase {
+public:
+    auto get_return_object() noexcept -> Task {
+        return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+
+    auto return_void() const noexcept -> void {}
+
+    auto Result() -> void {
+        if (exception != nullptr)
+            std::rethrow_exception(exception);
+    }
+};
+
+class WhenAllAwaiter {
+public:
+    /// @brief
+    ///   Create an awaiter that runs the specified tasks in parallel on the specified thread pool.
+    ///
+    /// @param[in] childTasks   The tasks to be executed. Tasks must not be started.
+    /// @param[in] threadPool   The thread pool that tasks are executed on.
+    WhenAllAwaiter(std::vector<Task<>> &childTasks, ThreadPool &threadPool) noexcept
+        : tasks(childTasks), pool(threadPool), remaining(), continuation() {}
+
+    /// @brief
+    ///   Checks if there is nothing to wait for.
+    auto await_ready() const noexcept -> bool { return tasks.empty(); }
+
+    /// @brief
+    ///   Start all tasks on the thread pool.
+    ///
+    /// @param awaiting The awaiting coroutine.
+    ///
+    /// @return bool
+    /// @retval true    The awaiting coroutine is resumed by the last finished task.
+    /// @retval false   All tasks have been finished, resume the awaiting coroutine immediately.
+    auto await_suspend(std::coroutine_handle<> awaiting) -> bool {
+        continuation = awaiting;
+        remaining.store(tasks.size() + 1, std::memory_order_relaxed);
+
+        for (auto &task : tasks)
+            RunChild(task, *this);
+
+        return remaining.fetch_sub(1, std::memory_order_acq_rel) != 1;
+    }
+
+    /// @brief
+    ///   Nothing to return. Results and exceptions of each task could be retrieved via @p Task::Get() without blocking.
+    auto await_resume() const noexcept -> void {}
+
+private:
+    /// @brief
+    ///   Run the specified child task on the thread pool and resume the awaiting coroutine if it is the last one.
+    static auto RunChild(Task<> &task, WhenAllAwaiter &awaiter) -> DetachedTask {
+        co_await Schedule(awaiter.pool);
+
+        try {
+            co_await task;
+        } catch (...) {
+            // The exception is rethrown by Task::Get().
+        }
+
+        if (awaiter.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            awaiter.continuation.resume();
+    }
+
+private:
+    /// @brief  The tasks to be executed.
+    std::vector<Task<>> &tasks;
+
+    /// @brief  The thread pool that tasks are executed on.
+    ThreadPool &pool;
+
+    /// @brief  Number of unfinished tasks plus one for the awaiting coroutine.
+    std::atomic<size_t> remaining;
+
+    /// @brief  The awaiting coroutine.
+    std::coroutine_handle<> continuation;
+};
+
+/// @brief
+///   Run all of the specified tasks in parallel and resume current coroutine once all of them are finished.
+///
+/// @param[in] tasks    The tasks to be executed. Tasks must not be started.
+/// @param[in] pool     The thread pool that tasks are executed on.
+///
+/// @return WhenAllAwaiter
+///   Return an awaiter that waits for all of the tasks.
+YAGE_NODISCARD inline auto WhenAll(std::vector<Task<>> &tasks, ThreadPool &pool = ThreadPool::Singleton()) noexcept
+    -> WhenAllAwaiter {
+    return WhenAllAwaiter(tasks, pool);
+}
+
+} // namespace YaGE
+
+#endif // YAGE_HAS_COROUTINE
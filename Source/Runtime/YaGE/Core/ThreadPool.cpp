@@ -0,0 +1,149 @@
+#include "ThreadPool.h"
+
+using namespace YaGE;
+
+namespace {
+
+/// @brief  The thread pool that current thread belongs to. This is null for non-worker threads.
+thread_local ThreadPool *currentPool;
+
+/// @brief  Index of current worker thread in @p currentPool.
+thread_local uint32_t currentWorkerIndex;
+
+} // namespace
+
+YaGE::ThreadPool::ThreadPool(uint32_t threadCount)
+    : threads(),
+      workerCount(),
+      workerQueues(),
+      tasks(),
+      mutex(),
+      condition(),
+      pendingTaskCount(0),
+      stopping(false) {
+    if (threadCount == 0) {
+        const uint32_t hardwareThreads = std::thread::hardware_concurrency();
+        threadCount                    = (hardwareThreads > 1 ? hardwareThreads - 1 : 1);
+    }
+
+    // Worker queues must be created before any worker starts stealing.
+    workerCount  = threadCount;
+    workerQueues = std::unique_ptr<WorkerQueue[]>(new WorkerQueue[threadCount]);
+
+    threads.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; ++i)
+        threads.emplace_back(&ThreadPool::WorkerMain, this, i);
+}
+
+YaGE::ThreadPool::~ThreadPool() noexcept {
+    { // Lock scope.
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+
+    condition.notify_all();
+    for (auto &thread : threads)
+        thread.join();
+}
+
+auto YaGE::ThreadPool::RunPendingTask() -> bool {
+    const uint32_t workerIndex = (currentPool == this) ? currentWorkerIndex : UINT32_MAX;
+
+    std::function<void()> task;
+    if (!TryTakeTask(workerIndex, task))
+        return false;
+
+    task();
+    return true;
+}
+
+auto YaGE::ThreadPool::Enqueue(std::function<void()> &&task) -> void {
+    if (currentPool == this) {
+        // Tasks submitted by workers are pushed to their own queue.
+        WorkerQueue                &queue = workerQueues[currentWorkerIndex];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+        pendingTaskCount.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push(std::move(task));
+        pendingTaskCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Acquire the mutex so that the notification could not be lost between a worker checking pending task count and
+    // starting to wait.
+    { // Lock scope.
+        std::lock_guard<std::mutex> lock(mutex);
+    }
+
+    condition.notify_one();
+}
+
+auto YaGE::ThreadPool::TryTakeTask(uint32_t workerIndex, std::function<void()> &task) -> bool {
+    // Pop the latest task from local queue.
+    if (workerIndex < workerCount) {
+        WorkerQueue                &queue = workerQueues[workerIndex];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+            pendingTaskCount.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    { // Take the oldest task from the shared queue.
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!tasks.empty()) {
+            task = std::move(tasks.front());
+            tasks.pop();
+            pendingTaskCount.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    // Steal the oldest task from other workers.
+    for (uint32_t i = 1; i <= workerCount; ++i) {
+        const uint32_t victim = static_cast<uint32_t>((uint64_t(workerIndex) + i) % workerCount);
+        if (victim == workerIndex)
+            continue;
+
+        WorkerQueue                &queue = workerQueues[victim];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            pendingTaskCount.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+auto YaGE::ThreadPool::WorkerMain(uint32_t workerIndex) noexcept -> void {
+    currentPool        = this;
+    currentWorkerIndex = workerIndex;
+
+    for (;;) {
+        std::function<void()> task;
+        if (TryTakeTask(workerIndex, task)) {
+            task();
+            continue;
+        }
+
+        { // Wait for a new task.
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this]() { return stopping || pendingTaskCount.load(std::memory_order_relaxed) > 0; });
+
+            // Pending tasks are finished before exiting.
+            if (stopping && pendingTaskCount.load(std::memory_order_relaxed) == 0)
+                return;
+        }
+    }
+}
+
+YAGE_NODISCARD auto YaGE::ThreadPool::Singleton() -> ThreadPool & {
+    static ThreadPool instance;
+    return instance;
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include "Common.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace YaGE {
+
+class ThreadPool {
+public:
+    /// @brief
+    ///   Create a work-stealing thread pool and start worker threads.
+    /// @remarks
+    ///   Each worker thread owns a task queue. Tasks submitted by a worker thread are pushed to its own queue and executed in LIFO order, so that child tasks are executed while their data is still hot in cache. Tasks submitted by other threads are pushed to a shared queue. Idle workers steal the oldest tasks from other workers before sleeping.
+    ///
+    /// @param threadCount  Number of worker threads. Pass 0 to use number of hardware threads minus 1. At least 1 worker thread is created.
+    YAGE_API explicit ThreadPool(uint32_t threadCount = 0);
+
+    /// @brief
+    ///   Copy constructor is disabled.
+    ThreadPool(const ThreadPool &) = delete;
+
+    /// @brief
+    ///   Copy assignment is disabled.
+    auto operator=(const ThreadPool &) = delete;
+
+    /// @brief
+    ///   Destroy this thread pool. All pending tasks are finished before worker threads exit.
+    YAGE_API ~ThreadPool() noexcept;
+
+    /// @brief
+    ///   Submit a task to be executed on worker threads.
+    /// @remarks
+    ///   Exceptions thrown by the task are stored in the returned future. This method is thread-safe.
+    ///
+    /// @tparam Func    Type of the task function. The task function should not take any argument.
+    /// @param func     The task to be executed.
+    ///
+    /// @return std::future
+    ///   Return a future that could be used to poll or wait for the result of the task.
+    template <typename Func>
+    auto Submit(Func &&func) -> std::future<decltype(std::declval<typename std::decay<Func>::type &>()())> {
+        using Result = decltype(std::declval<typename std::decay<Func>::type &>()());
+
+        auto                task   = std::make_shared<std::packaged_task<Result()>>(std::forward<Func>(func));
+        std::future<Result> future = task->get_future();
+
+        Enqueue([task]() { (*task)(); });
+        return future;
+    }
+
+    /// @brief
+    ///   Execute one pending task on current thread if there is any. Threads that are waiting for results of tasks could call this method to help with pending work instead of blocking.
+    ///
+    /// @return bool
+    /// @retval true    A pending task is executed.
+    /// @retval false   There is no pending task.
+    YAGE_API auto RunPendingTask() -> bool;
+
+    /// @brief
+    ///   Get number of worker threads in this thread pool.
+    ///
+    /// @return uint32_t
+    ///   Return number of worker threads.
+    YAGE_NODISCARD auto ThreadCount() const noexcept -> uint32_t { return static_cast<uint32_t>(threads.size()); }
+
+    /// @brief
+    ///   Get global singleton instance of thread pool.
+    ///
+    /// @return ThreadPool &
+    ///   Return reference to the thread pool singleton instance.
+    YAGE_NODISCARD YAGE_API static auto Singleton() -> ThreadPool &;
+
+private:
+    /// @brief
+    ///   Push a task into task queue and wake up a worker thread.
+    ///
+    /// @param task     The task to be executed.
+    YAGE_API auto Enqueue(std::function<void()> &&task) -> void;
+
+    /// @brief
+    ///   Try to take a task from local queue of the specified worker, the shared queue, or steal one from other workers.
+    ///
+    /// @param      workerIndex Index of the worker that takes the task. Pass @p UINT32_MAX for non-worker threads.
+    /// @param[out] task        Receives the task that is taken.
+    ///
+    /// @return bool
+    /// @retval true    A task is taken.
+    /// @retval false   There is no pending task.
+    auto TryTakeTask(uint32_t workerIndex, std::function<void()> &task) -> bool;
+
+    /// @brief
+    ///   Worker thread entry.
+    ///
+    /// @param workerIndex  Index of this worker thread.
+    auto WorkerMain(uint32_t workerIndex) noexcept -> void;
+
+    friend class ScheduleAwaiter;
+
+private:
+    /// @brief
+    ///   Task queue owned by a worker thread. The owner pushes and pops at the back, other workers steal from the front.
+    struct WorkerQueue {
+        /// @brief  Pending tasks of this worker.
+        std::deque<std::function<void()>> tasks;
+
+        /// @brief  Mutex to protect pending tasks of this worker.
+        std::mutex mutex;
+    };
+
+    /// @brief  Worker threads.
+    std::vector<std::thread> threads;
+
+    /// @brief  Number of worker threads.
+    uint32_t workerCount;
+
+    /// @brief  Task queues of worker threads. Indexed by worker index.
+    std::unique_ptr<WorkerQueue[]> workerQueues;
+
+    /// @brief  Pending tasks that are submitted by non-worker threads.
+    std::queue<std::function<void()>> tasks;
+
+    /// @brief  Mutex to protect the shared task queue and sleeping of worker threads.
+    mutable std::mutex mutex;
+
+    /// @brief  Condition variable that is used to wake up worker threads.
+    std::condition_variable condition;
+
+    /// @brief  Number of tasks in all task queues.
+    std::atomic<size_t> pendingTaskCount;
+
+    /// @brief  Indicates whether worker threads should exit.
+    bool stopping;
+};
+
+} // namespace YaGE
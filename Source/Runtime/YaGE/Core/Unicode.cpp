@@ -0,0 +1,335 @@
+#include "Unicode.h"
+
+#include <emmintrin.h>
+#include <intrin.h>
+
+#include <cstring>
+
+using namespace YaGE;
+
+namespace {
+
+/// @brief  Code point that is used to replace ill-formed sequences.
+constexpr const char32_t REPLACEMENT_CHARACTER = 0xFFFD;
+
+/// @brief
+///   Get number of leading ASCII bytes in the specified 16-byte block.
+///
+/// @return uint32_t
+///   Return number of leading ASCII bytes. Return 16 if all bytes are ASCII.
+YAGE_FORCEINLINE auto AsciiPrefixLength(const uint8_t *str) noexcept -> uint32_t {
+    const __m128i  block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(str));
+    const uint32_t mask  = static_cast<uint32_t>(_mm_movemask_epi8(block));
+    if (mask == 0)
+        return 16;
+
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<uint32_t>(index);
+}
+
+/// @brief
+///   Checks if the specified 16 UTF-16 code units are all ASCII characters.
+YAGE_FORCEINLINE auto IsAsciiBlock(__m128i low, __m128i high) noexcept -> bool {
+    const __m128i nonAscii = _mm_and_si128(_mm_or_si128(low, high), _mm_set1_epi16(static_cast<short>(0xFF80)));
+    return _mm_movemask_epi8(_mm_cmpeq_epi16(nonAscii, _mm_setzero_si128())) == 0xFFFF;
+}
+
+/// @brief
+///   Decode a code point that starts with a non-ASCII byte. Follows the maximal subpart practice of the Unicode standard: each maximal ill-formed subsequence is decoded as a single replacement character.
+///
+/// @param[in]  str         Pointer to the lead byte.
+/// @param[in]  end         Pointer to end of the UTF-8 string.
+/// @param[out] codePoint   Receives the decoded code point.
+///
+/// @return size_t
+///   Return number of bytes consumed.
+auto DecodeUtf8(const uint8_t *str, const uint8_t *end, char32_t &codePoint) noexcept -> size_t {
+    const uint8_t lead = str[0];
+
+    size_t   trailCount = 0;
+    char32_t value      = 0;
+    uint8_t  lower      = 0x80;
+    uint8_t  upper      = 0xBF;
+
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        trailCount = 1;
+        value      = lead & 0x1F;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+        trailCount = 2;
+        value      = lead & 0x0F;
+        lower      = (lead == 0xE0 ? 0xA0 : 0x80); // Overlong encoding.
+        upper      = (lead == 0xED ? 0x9F : 0xBF); // Surrogates.
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        trailCount = 3;
+        value      = lead & 0x07;
+        lower      = (lead == 0xF0 ? 0x90 : 0x80); // Overlong encoding.
+        upper      = (lead == 0xF4 ? 0x8F : 0xBF); // Greater than U+10FFFF.
+    } else {
+        codePoint = REPLACEMENT_CHARACTER;
+        return 1;
+    }
+
+    for (size_t i = 1; i <= trailCount; ++i) {
+        if (str + i == end || str[i] < lower || str[i] > upper) {
+            codePoint = REPLACEMENT_CHARACTER;
+            return i;
+        }
+
+        value = (value << 6) | (str[i] & 0x3F);
+        lower = 0x80;
+        upper = 0xBF;
+    }
+
+    codePoint = value;
+    return trailCount + 1;
+}
+
+/// @brief
+///   Decode a code point from UTF-16 string. Unpaired surrogates are decoded as replacement characters.
+///
+/// @param[in]  str         Pointer to the first code unit.
+/// @param[in]  end         Pointer to end of the UTF-16 string.
+/// @param[out] codePoint   Receives the decoded code point.
+///
+/// @return size_t
+///   Return number of code units consumed.
+YAGE_FORCEINLINE auto DecodeUtf16(const char16_t *str, const char16_t *end, char32_t &codePoint) noexcept -> size_t {
+    const char32_t unit = str[0];
+    if (unit < 0xD800 || unit > 0xDFFF) {
+        codePoint = unit;
+        return 1;
+    }
+
+    if (unit <= 0xDBFF && end - str >= 2 && str[1] >= 0xDC00 && str[1] <= 0xDFFF) {
+        codePoint = 0x10000 + ((unit - 0xD800) << 10) + (char32_t(str[1]) - 0xDC00);
+        return 2;
+    }
+
+    codePoint = REPLACEMENT_CHARACTER;
+    return 1;
+}
+
+/// @brief
+///   Get number of bytes to encode the specified code point in UTF-8.
+YAGE_FORCEINLINE auto Utf8Size(char32_t codePoint) noexcept -> size_t {
+    return codePoint < 0x80 ? 1 : (codePoint < 0x800 ? 2 : (codePoint < 0x10000 ? 3 : 4));
+}
+
+/// @brief
+///   Encode the specified code point in UTF-8.
+///
+/// @return size_t
+///   Return number of bytes written.
+YAGE_FORCEINLINE auto EncodeUtf8(char32_t codePoint, uint8_t *dest) noexcept -> size_t {
+    if (codePoint < 0x80) {
+        dest[0] = static_cast<uint8_t>(codePoint);
+        return 1;
+    }
+
+    if (codePoint < 0x800) {
+        dest[0] = static_cast<uint8_t>(0xC0 | (codePoint >> 6));
+        dest[1] = static_cast<uint8_t>(0x80 | (codePoint & 0x3F));
+        return 2;
+    }
+
+    if (codePoint < 0x10000) {
+        dest[0] = static_cast<uint8_t>(0xE0 | (codePoint >> 12));
+        dest[1] = static_cast<uint8_t>(0x80 | ((codePoint >> 6) & 0x3F));
+        dest[2] = static_cast<uint8_t>(0x80 | (codePoint & 0x3F));
+        return 3;
+    }
+
+    dest[0] = static_cast<uint8_t>(0xF0 | (codePoint >> 18));
+    dest[1] = static_cast<uint8_t>(0x80 | ((codePoint >> 12) & 0x3F));
+    dest[2] = static_cast<uint8_t>(0x80 | ((codePoint >> 6) & 0x3F));
+    dest[3] = static_cast<uint8_t>(0x80 | (codePoint & 0x3F));
+    return 4;
+}
+
+/// @brief
+///   Sum all 16-bit lanes of the specified vector.
+YAGE_FORCEINLINE auto HorizontalSum(__m128i value) noexcept -> size_t {
+    const __m128i sum32 = _mm_madd_epi16(value, _mm_set1_epi16(1));
+    const __m128i sum64 = _mm_add_epi32(sum32, _mm_shuffle_epi32(sum32, _MM_SHUFFLE(1, 0, 3, 2)));
+    const __m128i total = _mm_add_epi32(sum64, _mm_shuffle_epi32(sum64, _MM_SHUFFLE(2, 3, 0, 1)));
+    return static_cast<size_t>(static_cast<uint32_t>(_mm_cvtsi128_si32(total)));
+}
+
+} // namespace
+
+YAGE_NODISCARD auto YaGE::Utf8ToUtf16Length(const char *str, size_t length) noexcept -> size_t {
+    const uint8_t       *i   = reinterpret_cast<const uint8_t *>(str);
+    const uint8_t *const end = i + length;
+
+    size_t count = 0;
+    while (i != end) {
+        if (end - i >= 16) {
+            const uint32_t asciiCount = AsciiPrefixLength(i);
+            count += asciiCount;
+            i += asciiCount;
+            if (asciiCount == 16)
+                continue;
+        } else if (*i < 0x80) {
+            count += 1;
+            i += 1;
+            continue;
+        }
+
+        char32_t codePoint;
+        i += DecodeUtf8(i, end, codePoint);
+        count += (codePoint >= 0x10000 ? 2 : 1);
+    }
+
+    return count;
+}
+
+auto YaGE::Utf8ToUtf16(const char *str, size_t length, char16_t *dest) noexcept -> size_t {
+    const uint8_t       *i   = reinterpret_cast<const uint8_t *>(str);
+    const uint8_t *const end = i + length;
+    char16_t            *out = dest;
+
+    const __m128i zero = _mm_setzero_si128();
+    while (i != end) {
+        if (end - i >= 16) {
+            const __m128i  block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(i));
+            const uint32_t mask  = static_cast<uint32_t>(_mm_movemask_epi8(block));
+
+            // Zero-extend 16 ASCII characters at once.
+            if (mask == 0) {
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_unpacklo_epi8(block, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 8), _mm_unpackhi_epi8(block, zero));
+                i += 16;
+                out += 16;
+                continue;
+            }
+
+            // Copy leading ASCII characters one by one so that nothing is written after end of the output.
+            unsigned long asciiCount;
+            _BitScanForward(&asciiCount, mask);
+            for (unsigned long j = 0; j < asciiCount; ++j)
+                *out++ = static_cast<char16_t>(*i++);
+        } else if (*i < 0x80) {
+            *out++ = static_cast<char16_t>(*i++);
+            continue;
+        }
+
+        char32_t codePoint;
+        i += DecodeUtf8(i, end, codePoint);
+
+        if (codePoint >= 0x10000) {
+            codePoint -= 0x10000;
+            out[0] = static_cast<char16_t>(0xD800 + (codePoint >> 10));
+            out[1] = static_cast<char16_t>(0xDC00 + (codePoint & 0x3FF));
+            out += 2;
+        } else {
+            *out++ = static_cast<char16_t>(codePoint);
+        }
+    }
+
+    return static_cast<size_t>(out - dest);
+}
+
+YAGE_NODISCARD auto YaGE::Utf16ToUtf8Length(const char16_t *str, size_t length) noexcept -> size_t {
+    const char16_t       *i   = str;
+    const char16_t *const end = str + length;
+
+    const __m128i zero          = _mm_setzero_si128();
+    const __m128i three         = _mm_set1_epi16(3);
+    const __m128i asciiMask     = _mm_set1_epi16(static_cast<short>(0xFF80));
+    const __m128i twoByteMask   = _mm_set1_epi16(static_cast<short>(0xF800));
+    const __m128i surrogateBits = _mm_set1_epi16(static_cast<short>(0xD800));
+
+    size_t count = 0;
+    while (end - i >= 8) {
+        // Each lane adds at most 3 per iteration. Flush before 16-bit lanes could overflow.
+        __m128i        lanes     = zero;
+        const char16_t *blockEnd = (end - i) / 8 > 4096 ? i + 8 * 4096 : i + ((end - i) & ~ptrdiff_t(7));
+
+        while (i != blockEnd) {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(i));
+            const __m128i high  = _mm_and_si128(block, twoByteMask);
+
+            // Surrogates need to be paired. Count this block with the scalar path.
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, surrogateBits)) != 0)
+                break;
+
+            // 3 bytes for each code unit, minus 1 if it is less than U+0800 and minus 1 more if it is ASCII.
+            __m128i size = _mm_add_epi16(three, _mm_cmpeq_epi16(high, zero));
+            size         = _mm_add_epi16(size, _mm_cmpeq_epi16(_mm_and_si128(block, asciiMask), zero));
+            lanes        = _mm_add_epi16(lanes, size);
+            i += 8;
+        }
+
+        count += HorizontalSum(lanes);
+        if (i == blockEnd)
+            continue;
+
+        // A surrogate pair may cross end of this block.
+        const char16_t *const scalarEnd = i + 8;
+        while (i < scalarEnd) {
+            char32_t codePoint;
+            i += DecodeUtf16(i, end, codePoint);
+            count += Utf8Size(codePoint);
+        }
+    }
+
+    while (i < end) {
+        char32_t codePoint;
+        i += DecodeUtf16(i, end, codePoint);
+        count += Utf8Size(codePoint);
+    }
+
+    return count;
+}
+
+auto YaGE::Utf16ToUtf8(const char16_t *str, size_t length, char *dest) noexcept -> size_t {
+    const char16_t       *i   = str;
+    const char16_t *const end = str + length;
+    uint8_t              *out = reinterpret_cast<uint8_t *>(dest);
+
+    while (end - i >= 16) {
+        const __m128i low  = _mm_loadu_si128(reinterpret_cast<const __m128i *>(i));
+        const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i *>(i + 8));
+
+        // Narrow 16 ASCII characters at once.
+        if (IsAsciiBlock(low, high)) {
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_packus_epi16(low, high));
+            i += 16;
+            out += 16;
+            continue;
+        }
+
+        // A surrogate pair may cross end of this block.
+        const char16_t *const scalarEnd = i + 16;
+        while (i < scalarEnd) {
+            char32_t codePoint;
+            i += DecodeUtf16(i, end, codePoint);
+            out += EncodeUtf8(codePoint, out);
+        }
+    }
+
+    while (i < end) {
+        char32_t codePoint;
+        i += DecodeUtf16(i, end, codePoint);
+        out += EncodeUtf8(codePoint, out);
+    }
+
+    return static_cast<size_t>(out - reinterpret_cast<uint8_t *>(dest));
+}
+
+YAGE_NODISCARD auto YaGE::ToString(const char *str, size_t length) noexcept -> String {
+    String result;
+    result.Resize(Utf8ToUtf16Length(str, length));
+    Utf8ToUtf16(str, length, result.Data());
+    return result;
+}
+
+YAGE_NODISCARD auto YaGE::ToString(const char *str) noexcept -> String { return ToString(str, strlen(str)); }
+
+YAGE_NODISCARD auto YaGE::ToUtf8(StringView str) -> std::string {
+    std::string result(Utf16ToUtf8Length(str.Data(), str.Length()), '\0');
+    if (!result.empty())
+        Utf16ToUtf8(str.Data(), str.Length(), &result[0]);
+    return result;
+}
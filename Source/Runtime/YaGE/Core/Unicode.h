@@ -0,0 +1,90 @@
+#pragma once
+
+#include "String.h"
+
+#include <string>
+
+namespace YaGE {
+
+/// @brief
+///   Get number of UTF-16 code units that are required to represent the specified UTF-8 string.
+/// @remarks
+///   Each maximal ill-formed subsequence of the UTF-8 string is counted as a single U+FFFD replacement character, which matches the output of @p Utf8ToUtf16().
+///
+/// @param[in] str      Pointer to start of the UTF-8 string.
+/// @param     length   Number of bytes in the UTF-8 string.
+///
+/// @return size_t
+///   Return number of UTF-16 code units that are required.
+YAGE_NODISCARD YAGE_API auto Utf8ToUtf16Length(const char *str, size_t length) noexcept -> size_t;
+
+/// @brief
+///   Convert the specified UTF-8 string to UTF-16. Ill-formed subsequences are replaced with U+FFFD.
+/// @remarks
+///   ASCII runs are converted 16 bytes at a time with SSE2 instructions.
+///
+/// @param[in]  str     Pointer to start of the UTF-8 string.
+/// @param      length  Number of bytes in the UTF-8 string.
+/// @param[out] dest    Pointer to the output buffer. Must have space for @p Utf8ToUtf16Length() code units. The output is not null-terminated.
+///
+/// @return size_t
+///   Return number of UTF-16 code units written.
+YAGE_API auto Utf8ToUtf16(const char *str, size_t length, char16_t *dest) noexcept -> size_t;
+
+/// @brief
+///   Get number of bytes that are required to represent the specified UTF-16 string in UTF-8.
+/// @remarks
+///   Unpaired surrogates are counted as U+FFFD replacement characters, which matches the output of @p Utf16ToUtf8().
+///
+/// @param[in] str      Pointer to start of the UTF-16 string.
+/// @param     length   Number of UTF-16 code units in the string.
+///
+/// @return size_t
+///   Return number of bytes that are required.
+YAGE_NODISCARD YAGE_API auto Utf16ToUtf8Length(const char16_t *str, size_t length) noexcept -> size_t;
+
+/// @brief
+///   Convert the specified UTF-16 string to UTF-8. Unpaired surrogates are replaced with U+FFFD.
+/// @remarks
+///   ASCII runs are converted 16 code units at a time with SSE2 instructions.
+///
+/// @param[in]  str     Pointer to start of the UTF-16 string.
+/// @param      length  Number of UTF-16 code units in the string.
+/// @param[out] dest    Pointer to the output buffer. Must have space for @p Utf16ToUtf8Length() bytes. The output is not null-terminated.
+///
+/// @return size_t
+///   Return number of bytes written.
+YAGE_API auto Utf16ToUtf8(const char16_t *str, size_t length, char *dest) noexcept -> size_t;
+
+/// @brief
+///   Create a string from the specified UTF-8 string. The result is allocated only once.
+///
+/// @param[in] str      Pointer to start of the UTF-8 string.
+/// @param     length   Number of bytes in the UTF-8 string.
+///
+/// @return String
+///   Return the converted UTF-16 string.
+YAGE_NODISCARD YAGE_API auto ToString(const char *str, size_t length) noexcept -> String;
+
+/// @brief
+///   Create a string from the specified null-terminated UTF-8 string, such as command line arguments and file paths.
+///
+/// @param[in] str  Pointer to start of the null-terminated UTF-8 string.
+///
+/// @return String
+///   Return the converted UTF-16 string.
+YAGE_NODISCARD YAGE_API auto ToString(const char *str) noexcept -> String;
+
+/// @brief
+///   Convert the specified string to UTF-8. The result is allocated only once.
+///
+/// @param str  The string to be converted.
+///
+/// @return std::string
+///   Return the converted UTF-8 string.
+///
+/// @throw std::bad_alloc
+///   Thrown if failed to allocate memory for the result.
+YAGE_NODISCARD YAGE_API auto ToUtf8(StringView str) -> std::string;
+
+} // namespace YaGE
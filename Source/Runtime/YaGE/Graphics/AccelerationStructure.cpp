@@ -0,0 +1,225 @@
+#include "AccelerationStructure.h"
+#include "../Core/Exception.h"
+#include "CommandBuffer.h"
+#include "RenderDevice.h"
+
+#include <algorithm>
+
+using namespace YaGE;
+using Microsoft::WRL::ComPtr;
+
+namespace {
+
+/// @brief
+///   Get D3D12 device that supports ray tracing.
+///
+/// @return ID3D12Device5 *
+///   Return the D3D12 device of @p RenderDevice::Singleton(). Return nullptr if ray tracing is not supported by the runtime.
+auto RayTracingDevice() noexcept -> ID3D12Device5 * {
+    static const ComPtr<ID3D12Device5> device5 = []() -> ComPtr<ID3D12Device5> {
+        ComPtr<ID3D12Device5> result;
+        RenderDevice::Singleton().Device()->QueryInterface(IID_PPV_ARGS(result.GetAddressOf()));
+        return result;
+    }();
+
+    return device5.Get();
+}
+
+} // namespace
+
+YaGE::AccelerationStructure::AccelerationStructure() noexcept
+    : GpuResource(),
+      type(D3D12_RAYTRACING_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL),
+      bufferSize(),
+      address(),
+      buildFlags(D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_NONE),
+      elementCount(),
+      isBuilt(false),
+      srv() {}
+
+YaGE::AccelerationStructure::AccelerationStructure(D3D12_RAYTRACING_ACCELERATION_STRUCTURE_TYPE type, size_t size)
+    : GpuResource(),
+      type(type),
+      bufferSize(),
+      address(),
+      buildFlags(D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_NONE),
+      elementCount(),
+      isBuilt(false),
+      srv() {
+    // Acceleration structures must be aligned with D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BYTE_ALIGNMENT.
+    size       = ((size + 255) & ~size_t(255));
+    bufferSize = size;
+
+    { // Create ID3D12Resource.
+        const D3D12_RESOURCE_DESC desc{
+            /* Dimension        = */ D3D12_RESOURCE_DIMENSION_BUFFER,
+            /* Alignment        = */ 0,
+            /* Width            = */ size,
+            /* Height           = */ 1,
+            /* DepthOrArraySize = */ 1,
+            /* MipLevels        = */ 1,
+            /* Format           = */ DXGI_FORMAT_UNKNOWN,
+            /* SampleDesc       = */
+            {
+                /* Count   = */ 1,
+                /* Quality = */ 0,
+            },
+            /* Layout = */ D3D12_TEXTURE_LAYOUT_ROW_MAJOR,
+            /* Flags  = */ D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS,
+        };
+
+        HRESULT hr = CreateResource(D3D12_HEAP_TYPE_DEFAULT, desc,
+                                    D3D12_RESOURCE_STATE_RAYTRACING_ACCELERATION_STRUCTURE, nullptr);
+        if (FAILED(hr))
+            throw RenderAPIException(hr, u"Failed to create ID3D12Resource for AccelerationStructure.");
+
+        RenderDevice::Singleton().SetMemoryCategory(allocation, GpuMemoryCategory::AccelerationStructure);
+        this->address = resource->GetGPUVirtualAddress();
+    }
+
+    // Only top-level acceleration structures could be bound to shaders.
+    if (type == D3D12_RAYTRACING_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL) {
+        D3D12_SHADER_RESOURCE_VIEW_DESC desc;
+        desc.Format                                   = DXGI_FORMAT_UNKNOWN;
+        desc.ViewDimension                            = D3D12_SRV_DIMENSION_RAYTRACING_ACCELERATION_STRUCTURE;
+        desc.Shader4ComponentMapping                  = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+        desc.RaytracingAccelerationStructure.Location = address;
+
+        // Acceleration structure views are described by GPU address, resource must be nullptr.
+        srv.Create(nullptr, desc);
+    }
+}
+
+YaGE::AccelerationStructure::AccelerationStructure(AccelerationStructure &&other) noexcept
+    : GpuResource(std::move(other)),
+      type(other.type),
+      bufferSize(other.bufferSize),
+      address(other.address),
+      buildFlags(other.buildFlags),
+      elementCount(other.elementCount),
+      isBuilt(other.isBuilt),
+      srv(std::move(other.srv)) {
+    other.bufferSize   = 0;
+    other.address      = 0;
+    other.buildFlags   = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_NONE;
+    other.elementCount = 0;
+    other.isBuilt      = false;
+}
+
+auto YaGE::AccelerationStructure::operator=(AccelerationStructure &&other) noexcept -> AccelerationStructure & {
+    GpuResource::operator=(std::move(other));
+
+    type         = other.type;
+    bufferSize   = other.bufferSize;
+    address      = other.address;
+    buildFlags   = other.buildFlags;
+    elementCount = other.elementCount;
+    isBuilt      = other.isBuilt;
+    srv          = std::move(other.srv);
+
+    other.bufferSize   = 0;
+    other.address      = 0;
+    other.buildFlags   = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_NONE;
+    other.elementCount = 0;
+    other.isBuilt      = false;
+
+    return *this;
+}
+
+YaGE::AccelerationStructure::~AccelerationStructure() noexcept {}
+
+YAGE_NODISCARD auto
+YaGE::AccelerationStructure::PrebuildInfo(const D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_INPUTS &inputs) noexcept
+    -> D3D12_RAYTRACING_ACCELERATION_STRUCTURE_PREBUILD_INFO {
+    D3D12_RAYTRACING_ACCELERATION_STRUCTURE_PREBUILD_INFO info{};
+
+    ID3D12Device5 *const device5 = RayTracingDevice();
+    if (device5 != nullptr)
+        device5->GetRaytracingAccelerationStructurePrebuildInfo(&inputs, &info);
+
+    return info;
+}
+
+YaGE::AccelerationStructureCompactor::AccelerationStructureCompactor() noexcept
+    : pending(), batches(), retired(), reclaimedSize() {}
+
+YaGE::AccelerationStructureCompactor::~AccelerationStructureCompactor() noexcept {}
+
+auto YaGE::AccelerationStructureCompactor::Enqueue(AccelerationStructure &structure) -> bool {
+    if (!structure.IsBuilt() || structure.Type() != D3D12_RAYTRACING_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL ||
+        !(structure.BuildFlags() & D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_ALLOW_COMPACTION))
+        return false;
+
+    pending.push_back(&structure);
+    return true;
+}
+
+auto YaGE::AccelerationStructureCompactor::Remove(AccelerationStructure &structure) noexcept -> void {
+    pending.erase(std::remove(pending.begin(), pending.end(), &structure), pending.end());
+
+    for (Batch &batch : batches)
+        std::replace(batch.structures.begin(), batch.structures.end(), &structure,
+                     static_cast<AccelerationStructure *>(nullptr));
+}
+
+auto YaGE::AccelerationStructureCompactor::Update(CommandBuffer &commandBuffer) -> uint32_t {
+    // The command buffer that copies from retired acceleration structures has been submitted.
+    retired.clear();
+
+    uint32_t compactedCount = 0;
+
+    // Batches are read back in submission order.
+    while (!batches.empty() && batches.front().handle.IsReady()) {
+        Batch &batch = batches.front();
+
+        const auto *sizes =
+            static_cast<const D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_COMPACTED_SIZE_DESC *>(
+                batch.handle.Data());
+
+        for (size_t i = 0; i < batch.structures.size(); ++i) {
+            AccelerationStructure *const structure = batch.structures[i];
+            if (structure == nullptr)
+                continue;
+
+            // Compaction is skipped if it does not reclaim any memory.
+            const size_t compactedSize = static_cast<size_t>(sizes[i].CompactedSizeInBytes);
+            if (compactedSize == 0 || ((compactedSize + 255) & ~size_t(255)) >= structure->Size())
+                continue;
+
+            AccelerationStructure compacted(structure->Type(), compactedSize);
+            commandBuffer.CopyAccelerationStructure(compacted, *structure,
+                                                    D3D12_RAYTRACING_ACCELERATION_STRUCTURE_COPY_MODE_COMPACT);
+
+            reclaimedSize += structure->Size() - compacted.Size();
+
+            retired.push_back(std::move(*structure));
+            *structure = std::move(compacted);
+            ++compactedCount;
+        }
+
+        batches.pop_front();
+    }
+
+    if (!pending.empty()) {
+        const uint32_t count = static_cast<uint32_t>(pending.size());
+
+        Batch batch;
+        batch.readback = std::make_unique<ReadbackBuffer>(
+            count * sizeof(D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_COMPACTED_SIZE_DESC));
+        batch.handle     = commandBuffer.EmitCompactedSizes(count, pending.data(), *batch.readback, 0);
+        batch.structures = std::move(pending);
+
+        pending.clear();
+        batches.push_back(std::move(batch));
+    }
+
+    return compactedCount;
+}
+
+YAGE_NODISCARD auto YaGE::AccelerationStructureCompactor::PendingCount() const noexcept -> size_t {
+    size_t count = pending.size();
+    for (const Batch &batch : batches)
+        count += batch.structures.size() -
+                 static_cast<size_t>(std::count(batch.structures.begin(), batch.structures.end(), nullptr));
+    return count;
+}
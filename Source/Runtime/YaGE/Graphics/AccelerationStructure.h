@@ -0,0 +1,252 @@
+#pragma once
+
+#include "Descriptor.h"
+#include "GpuResource.h"
+#include "ReadbackBuffer.h"
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace YaGE {
+
+class CommandBuffer;
+
+class AccelerationStructure : public GpuResource {
+public:
+    /// @brief
+    ///   Create an empty acceleration structure.
+    YAGE_API AccelerationStructure() noexcept;
+
+    /// @brief
+    ///   Create a new acceleration structure buffer with at least the given size. The buffer is always in @p D3D12_RESOURCE_STATE_RAYTRACING_ACCELERATION_STRUCTURE state.
+    /// @remarks
+    ///   Use @p PrebuildInfo() to get the required size. A shader resource view is created for top-level acceleration structures.
+    ///
+    /// @param type     Type of this acceleration structure.
+    /// @param size     Expected buffer size in byte of this acceleration structure. The actual buffer size might be greater than the given size.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to create D3D12 resource for this acceleration structure.
+    YAGE_API AccelerationStructure(D3D12_RAYTRACING_ACCELERATION_STRUCTURE_TYPE type, size_t size);
+
+    /// @brief
+    ///   Move constructor of AccelerationStructure. The moved acceleration structure will be invalidated.
+    ///
+    /// @param other    The acceleration structure to be moved.
+    YAGE_API AccelerationStructure(AccelerationStructure &&other) noexcept;
+
+    /// @brief
+    ///   Move assignment of AccelerationStructure. The moved acceleration structure will be invalidated.
+    ///
+    /// @param other    The acceleration structure to be moved.
+    ///
+    /// @return AccelerationStructure &
+    ///   Return reference to this acceleration structure.
+    YAGE_API auto operator=(AccelerationStructure &&other) noexcept -> AccelerationStructure &;
+
+    /// @brief
+    ///   Destroy this acceleration structure.
+    YAGE_API ~AccelerationStructure() noexcept override;
+
+    /// @brief
+    ///   Get type of this acceleration structure.
+    ///
+    /// @return D3D12_RAYTRACING_ACCELERATION_STRUCTURE_TYPE
+    ///   Return type of this acceleration structure.
+    YAGE_NODISCARD auto Type() const noexcept -> D3D12_RAYTRACING_ACCELERATION_STRUCTURE_TYPE { return type; }
+
+    /// @brief
+    ///   Get size in byte of this acceleration structure buffer.
+    ///
+    /// @return size_t
+    ///   Return size in byte of this acceleration structure buffer.
+    YAGE_NODISCARD auto Size() const noexcept -> size_t { return bufferSize; }
+
+    /// @brief
+    ///   Get GPU address to start of this acceleration structure.
+    ///
+    /// @return uint64_t
+    ///   Return GPU address to start of this acceleration structure. Bottom-level acceleration structures are referenced by this address in instance descriptions.
+    YAGE_NODISCARD auto GpuAddress() const noexcept -> uint64_t { return address; }
+
+    /// @brief
+    ///   Get shader resource view of this acceleration structure. This SRV could be used as a RaytracingAccelerationStructure in HLSL.
+    /// @note
+    ///   Only top-level acceleration structures have shader resource view.
+    ///
+    /// @return CpuDescriptorHandle
+    ///   Return shader resource view CPU handle of this acceleration structure.
+    YAGE_NODISCARD auto ShaderResourceView() const noexcept -> CpuDescriptorHandle { return srv; }
+
+    /// @brief
+    ///   Get bindless index of shader resource view of this acceleration structure.
+    ///
+    /// @return uint32_t
+    ///   Return bindless index of the shader resource view. Return @p UINT32_MAX for bottom-level acceleration structures.
+    YAGE_NODISCARD auto BindlessIndex() const noexcept -> uint32_t { return srv.BindlessIndex(); }
+
+    /// @brief
+    ///   Get build flags of the last build of this acceleration structure. @p D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_PERFORM_UPDATE is never included.
+    ///
+    /// @return D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAGS
+    ///   Return build flags of the last build.
+    YAGE_NODISCARD auto BuildFlags() const noexcept -> D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAGS {
+        return buildFlags;
+    }
+
+    /// @brief
+    ///   Get number of geometries or instances of the last build of this acceleration structure.
+    ///
+    /// @return uint32_t
+    ///   Return number of geometries for bottom-level acceleration structures or number of instances for top-level acceleration structures.
+    YAGE_NODISCARD auto ElementCount() const noexcept -> uint32_t { return elementCount; }
+
+    /// @brief
+    ///   Checks if this acceleration structure has been built.
+    ///
+    /// @return bool
+    /// @retval true    This acceleration structure has been built and could be updated if built with @p D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_ALLOW_UPDATE.
+    /// @retval false   This acceleration structure is empty or has been invalidated.
+    YAGE_NODISCARD auto IsBuilt() const noexcept -> bool { return isBuilt; }
+
+    /// @brief
+    ///   Mark this acceleration structure as not built, so that the next build of this acceleration structure is a full rebuild rather than an update.
+    /// @remarks
+    ///   Top-level acceleration structures should be invalidated once bottom-level acceleration structures that they reference are relocated, for example by @p AccelerationStructureCompactor.
+    auto Invalidate() noexcept -> void { isBuilt = false; }
+
+    /// @brief
+    ///   Get size requirements of building an acceleration structure with the specified inputs.
+    ///
+    /// @param inputs   Inputs of the acceleration structure build.
+    ///
+    /// @return D3D12_RAYTRACING_ACCELERATION_STRUCTURE_PREBUILD_INFO
+    ///   Return size requirements of the result buffer, the build scratch buffer and the update scratch buffer. All sizes are zero if ray tracing is not supported.
+    YAGE_NODISCARD YAGE_API static auto
+    PrebuildInfo(const D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_INPUTS &inputs) noexcept
+        -> D3D12_RAYTRACING_ACCELERATION_STRUCTURE_PREBUILD_INFO;
+
+    friend class CommandBuffer;
+
+private:
+    /// @brief  Type of this acceleration structure.
+    D3D12_RAYTRACING_ACCELERATION_STRUCTURE_TYPE type;
+
+    /// @brief  Size in byte of this acceleration structure buffer.
+    size_t bufferSize;
+
+    /// @brief  GPU address to start of this acceleration structure.
+    uint64_t address;
+
+    /// @brief  Build flags of the last build.
+    D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAGS buildFlags;
+
+    /// @brief  Number of geometries or instances of the last build.
+    uint32_t elementCount;
+
+    /// @brief  Whether this acceleration structure has been built.
+    bool isBuilt;
+
+    /// @brief  Shader resource view of top-level acceleration structure.
+    YaGE::ShaderResourceView srv;
+};
+
+struct AccelerationStructureBuild {
+    /// @brief  The acceleration structure to be built. It is recreated if it is empty or smaller than required.
+    AccelerationStructure *dest;
+
+    /// @brief  The acceleration structure to be updated. Only used if @p inputs.Flags contains @p D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_PERFORM_UPDATE. Pass nullptr to update @p dest in place.
+    AccelerationStructure *source;
+
+    /// @brief  Geometries or instances of the acceleration structure. @p inputs.Type must match type of @p dest if it is not empty.
+    D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_INPUTS inputs;
+};
+
+class AccelerationStructureCompactor {
+public:
+    /// @brief
+    ///   Create an empty acceleration structure compactor.
+    YAGE_API AccelerationStructureCompactor() noexcept;
+
+    /// @brief
+    ///   Copy constructor is disabled.
+    AccelerationStructureCompactor(const AccelerationStructureCompactor &) = delete;
+
+    /// @brief
+    ///   Copy assignment is disabled.
+    auto operator=(const AccelerationStructureCompactor &) = delete;
+
+    /// @brief
+    ///   Destroy this acceleration structure compactor. Acceleration structures that are waiting for compaction are kept as is.
+    YAGE_API ~AccelerationStructureCompactor() noexcept;
+
+    /// @brief
+    ///   Enqueue a bottom-level acceleration structure to be compacted. The acceleration structure must be kept alive until it is compacted or removed by @p Remove().
+    ///
+    /// @param[in] structure    The acceleration structure to be compacted. It must have been built with @p D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_ALLOW_COMPACTION.
+    ///
+    /// @return bool
+    /// @retval true    The acceleration structure is enqueued.
+    /// @retval false   The acceleration structure is not a built bottom-level acceleration structure that allows compaction.
+    YAGE_API auto Enqueue(AccelerationStructure &structure) -> bool;
+
+    /// @brief
+    ///   Remove an acceleration structure from this compactor. This method must be called before destroying an acceleration structure that is waiting for compaction.
+    ///
+    /// @param[in] structure    The acceleration structure to be removed.
+    YAGE_API auto Remove(AccelerationStructure &structure) noexcept -> void;
+
+    /// @brief
+    ///   Record compaction commands into the specified command buffer. This method should be called once per frame, and the command buffer must be submitted before the next call.
+    /// @remarks
+    ///   Compacted sizes of newly enqueued acceleration structures are emitted into a readback buffer, so that compaction never stalls CPU. Acceleration structures whose compacted sizes have been read back are copied into smaller buffers and replaced in place. Previous buffers of compacted acceleration structures are released on the next call. Top-level acceleration structures that reference the compacted acceleration structures must be rebuilt.
+    ///
+    /// @param[in] commandBuffer    The command buffer to record compaction commands. Must support ray tracing.
+    ///
+    /// @return uint32_t
+    ///   Return number of acceleration structures that are compacted by this call.
+    /// @throw RenderAPIException
+    ///   Thrown if failed to create readback buffers or compacted acceleration structures.
+    YAGE_API auto Update(CommandBuffer &commandBuffer) -> uint32_t;
+
+    /// @brief
+    ///   Get number of acceleration structures that are waiting for compaction.
+    ///
+    /// @return size_t
+    ///   Return number of acceleration structures that are waiting for compaction.
+    YAGE_NODISCARD YAGE_API auto PendingCount() const noexcept -> size_t;
+
+    /// @brief
+    ///   Get total size in byte that has been reclaimed by compaction.
+    ///
+    /// @return uint64_t
+    ///   Return total size in byte that has been reclaimed by this compactor.
+    YAGE_NODISCARD auto ReclaimedSize() const noexcept -> uint64_t { return reclaimedSize; }
+
+private:
+    struct Batch {
+        /// @brief  Readback buffer that compacted sizes are copied to.
+        std::unique_ptr<ReadbackBuffer> readback;
+
+        /// @brief  Handle of compacted sizes in @p readback.
+        ReadbackHandle handle;
+
+        /// @brief  Acceleration structures of this batch. Removed acceleration structures are set to nullptr.
+        std::vector<AccelerationStructure *> structures;
+    };
+
+    /// @brief  Acceleration structures that are enqueued since the last update.
+    std::vector<AccelerationStructure *> pending;
+
+    /// @brief  Batches whose compacted sizes are being read back.
+    std::deque<Batch> batches;
+
+    /// @brief  Previous buffers of compacted acceleration structures that are still referenced by the last command buffer.
+    std::vector<AccelerationStructure> retired;
+
+    /// @brief  Total size in byte that has been reclaimed by compaction.
+    uint64_t reclaimedSize;
+};
+
+} // namespace YaGE
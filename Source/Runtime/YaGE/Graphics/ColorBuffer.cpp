@@ -23,136 +23,36 @@ YaGE::ColorBuffer::ColorBuffer(uint32_t    width,
                                uint32_t    mipmapLevels,
                                uint32_t    sampleCount)
     : PixelBuffer(), clearColor(), rtv(), srv(), uav() {
-    // Clamp mipmap levels.
-    const uint32_t maxMipLevels = MaxMipLevels(width | height);
-    if (mipmapLevels == 0 || mipmapLevels > maxMipLevels)
-        mipmapLevels = maxMipLevels;
-
-    if (sampleCount == 0)
-        sampleCount = 1;
+    const D3D12_RESOURCE_DESC desc = ResourceDesc(width, height, arraySize, format, mipmapLevels, sampleCount);
 
     this->width       = width;
     this->height      = height;
     this->arraySize   = arraySize;
-    this->sampleCount = sampleCount;
-    this->mipLevels   = mipmapLevels;
+    this->sampleCount = desc.SampleDesc.Count;
+    this->mipLevels   = desc.MipLevels;
     this->pixelFormat = format;
 
-    // Create D3D12 resources.
-    RenderDevice &device = RenderDevice::Singleton();
-
-    { // Create ID3D12Resource.
-        const D3D12_HEAP_PROPERTIES heapProps{
-            /* Type                 = */ D3D12_HEAP_TYPE_DEFAULT,
-            /* CPUPageProperty      = */ D3D12_CPU_PAGE_PROPERTY_UNKNOWN,
-            /* MemoryPoolPreference = */ D3D12_MEMORY_POOL_UNKNOWN,
-            /* CreationNodeMask     = */ 0,
-            /* VisibleNodeMask      = */ 0,
-        };
-
-        // Enable unordered access if multi-sample is not enabled.
-        D3D12_RESOURCE_FLAGS resourceFlags = D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;
-        if (sampleCount == 1 && device.SupportUnorderedAccess(format))
-            resourceFlags |= D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
+    HRESULT hr = CreateResource(D3D12_HEAP_TYPE_DEFAULT, desc, D3D12_RESOURCE_STATE_COMMON, nullptr);
+    if (FAILED(hr))
+        throw RenderAPIException(hr, u"Failed to create ID3D12Resource for ColorBuffer.");
 
-        const D3D12_RESOURCE_DESC desc{
-            /* Dimension        = */ D3D12_RESOURCE_DIMENSION_TEXTURE2D,
-            /* Alignment        = */ 0,
-            /* Width            = */ width,
-            /* Height           = */ height,
-            /* DepthOrArraySize = */ static_cast<UINT16>(arraySize),
-            /* MipLevels        = */ static_cast<UINT16>(mipmapLevels),
-            /* Format           = */ format,
-            /* SampleDesc       = */
-            {
-                /* Count   = */ sampleCount,
-                /* Quality = */ 0,
-            },
-            /* Layout = */ D3D12_TEXTURE_LAYOUT_UNKNOWN,
-            /* Flags  = */ resourceFlags,
-        };
-
-        HRESULT hr = device.Device()->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &desc,
-                                                              D3D12_RESOURCE_STATE_COMMON, nullptr,
-                                                              IID_PPV_ARGS(resource.GetAddressOf()));
-        if (FAILED(hr))
-            throw RenderAPIException(hr, u"Failed to create ID3D12Resource for ColorBuffer.");
-    }
-
-    { // Create render target view.
-        D3D12_RENDER_TARGET_VIEW_DESC desc;
-        desc.Format = format;
-
-        if (arraySize > 1 && sampleCount > 1) {
-            desc.ViewDimension                    = D3D12_RTV_DIMENSION_TEXTURE2DMSARRAY;
-            desc.Texture2DMSArray.FirstArraySlice = 0;
-            desc.Texture2DMSArray.ArraySize       = arraySize;
-        } else if (arraySize > 1) {
-            desc.ViewDimension                  = D3D12_RTV_DIMENSION_TEXTURE2DARRAY;
-            desc.Texture2DArray.MipSlice        = 0;
-            desc.Texture2DArray.FirstArraySlice = 0;
-            desc.Texture2DArray.ArraySize       = arraySize;
-            desc.Texture2DArray.PlaneSlice      = 0;
-        } else if (sampleCount > 1) {
-            desc.ViewDimension = D3D12_RTV_DIMENSION_TEXTURE2DMS;
-        } else {
-            desc.ViewDimension        = D3D12_RTV_DIMENSION_TEXTURE2D;
-            desc.Texture2D.MipSlice   = 0;
-            desc.Texture2D.PlaneSlice = 0;
-        }
-
-        rtv.Create(this->resource.Get(), desc);
-    }
-
-    { // Create shader resource view
-        D3D12_SHADER_RESOURCE_VIEW_DESC desc;
-        desc.Format                  = format;
-        desc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-
-        if (arraySize > 1 && sampleCount > 1) {
-            desc.ViewDimension                    = D3D12_SRV_DIMENSION_TEXTURE2DMSARRAY;
-            desc.Texture2DMSArray.FirstArraySlice = 0;
-            desc.Texture2DMSArray.ArraySize       = arraySize;
-        } else if (arraySize > 1) {
-            desc.ViewDimension                      = D3D12_SRV_DIMENSION_TEXTURE2DARRAY;
-            desc.Texture2DArray.MostDetailedMip     = 0;
-            desc.Texture2DArray.MipLevels           = mipmapLevels;
-            desc.Texture2DArray.FirstArraySlice     = 0;
-            desc.Texture2DArray.ArraySize           = arraySize;
-            desc.Texture2DArray.PlaneSlice          = 0;
-            desc.Texture2DArray.ResourceMinLODClamp = 0;
-        } else if (sampleCount > 1) {
-            desc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2DMS;
-        } else {
-            desc.ViewDimension                 = D3D12_SRV_DIMENSION_TEXTURE2D;
-            desc.Texture2D.MostDetailedMip     = 0;
-            desc.Texture2D.MipLevels           = mipmapLevels;
-            desc.Texture2D.PlaneSlice          = 0;
-            desc.Texture2D.ResourceMinLODClamp = 0;
-        }
+    CreateViews();
+}
 
-        srv.Create(this->resource.Get(), desc);
-    }
+YaGE::ColorBuffer::ColorBuffer(ID3D12Heap *heap, uint64_t heapOffset, const D3D12_RESOURCE_DESC &desc)
+    : PixelBuffer(), clearColor(), rtv(), srv(), uav() {
+    this->width       = static_cast<uint32_t>(desc.Width);
+    this->height      = desc.Height;
+    this->arraySize   = desc.DepthOrArraySize;
+    this->sampleCount = desc.SampleDesc.Count;
+    this->mipLevels   = desc.MipLevels;
+    this->pixelFormat = desc.Format;
 
-    // Create unordered access view.
-    if (sampleCount == 1 && device.SupportUnorderedAccess(format)) {
-        D3D12_UNORDERED_ACCESS_VIEW_DESC desc;
-        desc.Format = format;
+    HRESULT hr = CreatePlacedResource(heap, heapOffset, desc, D3D12_RESOURCE_STATE_COMMON, nullptr);
+    if (FAILED(hr))
+        throw RenderAPIException(hr, u"Failed to create placed ID3D12Resource for ColorBuffer.");
 
-        if (arraySize > 1) {
-            desc.ViewDimension                  = D3D12_UAV_DIMENSION_TEXTURE2DARRAY;
-            desc.Texture2DArray.MipSlice        = 0;
-            desc.Texture2DArray.FirstArraySlice = 0;
-            desc.Texture2DArray.ArraySize       = arraySize;
-            desc.Texture2DArray.PlaneSlice      = 0;
-        } else {
-            desc.ViewDimension        = D3D12_UAV_DIMENSION_TEXTURE2D;
-            desc.Texture2D.MipSlice   = 0;
-            desc.Texture2D.PlaneSlice = 0;
-        }
-
-        uav.Create(resource.Get(), desc);
-    }
+    CreateViews();
 }
 
 YaGE::ColorBuffer::ColorBuffer(uint32_t width, uint32_t height, DXGI_FORMAT format)
@@ -164,18 +64,7 @@ YaGE::ColorBuffer::ColorBuffer(uint32_t width, uint32_t height, DXGI_FORMAT form
     this->mipLevels   = 1;
     this->pixelFormat = format;
 
-    // Create D3D12 resources.
-    RenderDevice &device = RenderDevice::Singleton();
-
     { // Create ID3D12Resource.
-        const D3D12_HEAP_PROPERTIES heapProps{
-            /* Type                 = */ D3D12_HEAP_TYPE_DEFAULT,
-            /* CPUPageProperty      = */ D3D12_CPU_PAGE_PROPERTY_UNKNOWN,
-            /* MemoryPoolPreference = */ D3D12_MEMORY_POOL_UNKNOWN,
-            /* CreationNodeMask     = */ 0,
-            /* VisibleNodeMask      = */ 0,
-        };
-
         const D3D12_RESOURCE_DESC desc{
             /* Dimension        = */ D3D12_RESOURCE_DIMENSION_TEXTURE2D,
             /* Alignment        = */ 0,
@@ -193,9 +82,7 @@ YaGE::ColorBuffer::ColorBuffer(uint32_t width, uint32_t height, DXGI_FORMAT form
             /* Flags  = */ D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET | D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS,
         };
 
-        HRESULT hr = device.Device()->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &desc,
-                                                              D3D12_RESOURCE_STATE_COMMON, nullptr,
-                                                              IID_PPV_ARGS(resource.GetAddressOf()));
+        HRESULT hr = CreateResource(D3D12_HEAP_TYPE_DEFAULT, desc, D3D12_RESOURCE_STATE_COMMON, nullptr);
         if (FAILED(hr))
             throw RenderAPIException(hr, u"Failed to create ID3D12Resource for ColorBuffer.");
     }
@@ -258,6 +145,120 @@ auto YaGE::ColorBuffer::operator=(ColorBuffer &&other) noexcept -> ColorBuffer &
 
 YaGE::ColorBuffer::~ColorBuffer() noexcept {}
 
+YAGE_NODISCARD auto YaGE::ColorBuffer::ResourceDesc(uint32_t    width,
+                                                    uint32_t    height,
+                                                    uint32_t    arraySize,
+                                                    DXGI_FORMAT format,
+                                                    uint32_t    mipmapLevels,
+                                                    uint32_t    sampleCount) -> D3D12_RESOURCE_DESC {
+    // Clamp mipmap levels.
+    const uint32_t maxMipLevels = MaxMipLevels(width | height);
+    if (mipmapLevels == 0 || mipmapLevels > maxMipLevels)
+        mipmapLevels = maxMipLevels;
+
+    if (sampleCount == 0)
+        sampleCount = 1;
+
+    // Enable unordered access if multi-sample is not enabled.
+    D3D12_RESOURCE_FLAGS resourceFlags = D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;
+    if (sampleCount == 1 && RenderDevice::Singleton().SupportUnorderedAccess(format))
+        resourceFlags |= D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
+
+    return D3D12_RESOURCE_DESC{
+        /* Dimension        = */ D3D12_RESOURCE_DIMENSION_TEXTURE2D,
+        /* Alignment        = */ 0,
+        /* Width            = */ width,
+        /* Height           = */ height,
+        /* DepthOrArraySize = */ static_cast<UINT16>(arraySize),
+        /* MipLevels        = */ static_cast<UINT16>(mipmapLevels),
+        /* Format           = */ format,
+        /* SampleDesc       = */
+        {
+            /* Count   = */ sampleCount,
+            /* Quality = */ 0,
+        },
+        /* Layout = */ D3D12_TEXTURE_LAYOUT_UNKNOWN,
+        /* Flags  = */ resourceFlags,
+    };
+}
+
+auto YaGE::ColorBuffer::CreateViews() -> void {
+    { // Create render target view.
+        D3D12_RENDER_TARGET_VIEW_DESC desc;
+        desc.Format = pixelFormat;
+
+        if (arraySize > 1 && sampleCount > 1) {
+            desc.ViewDimension                    = D3D12_RTV_DIMENSION_TEXTURE2DMSARRAY;
+            desc.Texture2DMSArray.FirstArraySlice = 0;
+            desc.Texture2DMSArray.ArraySize       = arraySize;
+        } else if (arraySize > 1) {
+            desc.ViewDimension                  = D3D12_RTV_DIMENSION_TEXTURE2DARRAY;
+            desc.Texture2DArray.MipSlice        = 0;
+            desc.Texture2DArray.FirstArraySlice = 0;
+            desc.Texture2DArray.ArraySize       = arraySize;
+            desc.Texture2DArray.PlaneSlice      = 0;
+        } else if (sampleCount > 1) {
+            desc.ViewDimension = D3D12_RTV_DIMENSION_TEXTURE2DMS;
+        } else {
+            desc.ViewDimension        = D3D12_RTV_DIMENSION_TEXTURE2D;
+            desc.Texture2D.MipSlice   = 0;
+            desc.Texture2D.PlaneSlice = 0;
+        }
+
+        rtv.Create(this->resource.Get(), desc);
+    }
+
+    { // Create shader resource view
+        D3D12_SHADER_RESOURCE_VIEW_DESC desc;
+        desc.Format                  = pixelFormat;
+        desc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+
+        if (arraySize > 1 && sampleCount > 1) {
+            desc.ViewDimension                    = D3D12_SRV_DIMENSION_TEXTURE2DMSARRAY;
+            desc.Texture2DMSArray.FirstArraySlice = 0;
+            desc.Texture2DMSArray.ArraySize       = arraySize;
+        } else if (arraySize > 1) {
+            desc.ViewDimension                      = D3D12_SRV_DIMENSION_TEXTURE2DARRAY;
+            desc.Texture2DArray.MostDetailedMip     = 0;
+            desc.Texture2DArray.MipLevels           = mipLevels;
+            desc.Texture2DArray.FirstArraySlice     = 0;
+            desc.Texture2DArray.ArraySize           = arraySize;
+            desc.Texture2DArray.PlaneSlice          = 0;
+            desc.Texture2DArray.ResourceMinLODClamp = 0;
+        } else if (sampleCount > 1) {
+            desc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2DMS;
+        } else {
+            desc.ViewDimension                 = D3D12_SRV_DIMENSION_TEXTURE2D;
+            desc.Texture2D.MostDetailedMip     = 0;
+            desc.Texture2D.MipLevels           = mipLevels;
+            desc.Texture2D.PlaneSlice          = 0;
+            desc.Texture2D.ResourceMinLODClamp = 0;
+        }
+
+        srv.Create(this->resource.Get(), desc);
+    }
+
+    // Create unordered access view.
+    if (this->resource->GetDesc().Flags & D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS) {
+        D3D12_UNORDERED_ACCESS_VIEW_DESC desc;
+        desc.Format = pixelFormat;
+
+        if (arraySize > 1) {
+            desc.ViewDimension                  = D3D12_UAV_DIMENSION_TEXTURE2DARRAY;
+            desc.Texture2DArray.MipSlice        = 0;
+            desc.Texture2DArray.FirstArraySlice = 0;
+            desc.Texture2DArray.ArraySize       = arraySize;
+            desc.Texture2DArray.PlaneSlice      = 0;
+        } else {
+            desc.ViewDimension        = D3D12_UAV_DIMENSION_TEXTURE2D;
+            desc.Texture2D.MipSlice   = 0;
+            desc.Texture2D.PlaneSlice = 0;
+        }
+
+        uav.Create(resource.Get(), desc);
+    }
+}
+
 auto YaGE::ColorBuffer::ReleaseSwapChainResource() noexcept -> void { this->resource.Reset(); }
 
 auto YaGE::ColorBuffer::ResetSwapChainResource(Microsoft::WRL::ComPtr<ID3D12Resource> buffer) -> void {
@@ -271,6 +272,7 @@ auto YaGE::ColorBuffer::ResetSwapChainResource(Microsoft::WRL::ComPtr<ID3D12Reso
     this->sampleCount = desc.SampleDesc.Count;
     this->mipLevels   = desc.MipLevels;
     this->pixelFormat = desc.Format;
+    this->subresourceStates.clear();
 
     { // Create render target view.
         D3D12_RENDER_TARGET_VIEW_DESC rtvDesc;
@@ -46,6 +46,19 @@ public:
     ///   Thrown if failed to create D3D12 resource for this color buffer.
     YAGE_API ColorBuffer(uint32_t width, uint32_t height, DXGI_FORMAT format);
 
+    /// @brief
+    ///   Create a new color buffer that is placed in the specified heap. Placed color buffers could alias memory with other placed resources in the same heap.
+    /// @note
+    ///   Content of an aliased color buffer is undefined. An aliasing barrier must be recorded before using it, and it must be initialized with a clear, discard or copy operation.
+    ///
+    /// @param[in] heap         The heap that this color buffer is placed in. The heap must be alive until this color buffer is destroyed.
+    /// @param     heapOffset   Offset in byte from start of the heap. Must be aligned with the alignment of this resource.
+    /// @param     desc         Description of the color buffer resource. This is usually created by @p ResourceDesc().
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to create D3D12 resource for this color buffer.
+    YAGE_API ColorBuffer(ID3D12Heap *heap, uint64_t heapOffset, const D3D12_RESOURCE_DESC &desc);
+
     /// @brief
     ///   Move constructor of ColorBuffer. The moved ColorBuffer will be invalidated.
     ///
@@ -113,11 +126,37 @@ public:
     /// @retval false   This color buffer doesn't support unordered access.
     YAGE_NODISCARD auto SupportUnorderedAccess() const noexcept -> bool { return !uav.IsNull(); }
 
+    /// @brief
+    ///   Get D3D12 resource description of a color buffer. This is the same description that is used by the constructor.
+    ///
+    /// @param width        Width in pixel of the color buffer.
+    /// @param height       Height in pixel of the color buffer.
+    /// @param arraySize    Number of 2D textures in the color buffer.
+    /// @param format       Pixel format of the color buffer.
+    /// @param mipmapLevels Supported mipmap levels of the color buffer. Pass 0 to use maximum supported levels.
+    /// @param sampleCount  Number of samples of the color buffer.
+    ///
+    /// @return D3D12_RESOURCE_DESC
+    ///   Return description of the color buffer resource.
+    YAGE_NODISCARD YAGE_API static auto ResourceDesc(uint32_t    width,
+                                                     uint32_t    height,
+                                                     uint32_t    arraySize,
+                                                     DXGI_FORMAT format,
+                                                     uint32_t    mipmapLevels = 1,
+                                                     uint32_t    sampleCount  = 1) -> D3D12_RESOURCE_DESC;
+
     friend class SwapChain;
 
 private:
     /// @brief
-    ///   For internal usage. Release swap chain resource so that swap chain could resize back buffers.
+    ///   Create render target view, shader resource view and unordered access view for the whole color buffer.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to allocate descriptors.
+    auto CreateViews() -> void;
+
+    /// @brief
+    ///   For internal usage. Release swap chain resource immediately without @p RenderDevice::DeferRelease(), so that swap chain could resize or destroy back buffers.
     auto ReleaseSwapChainResource() noexcept -> void;
 
     /// @brief
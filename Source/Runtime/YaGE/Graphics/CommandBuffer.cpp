@@ -1,10 +1,21 @@
 #include "CommandBuffer.h"
 #include "../Core/Exception.h"
+#include "../Core/Memory.h"
+#include "../Resource/Image.h"
+#include "AccelerationStructure.h"
+#include "CommandSignature.h"
+#include "MipGenerator.h"
+#include "RayTracingPipeline.h"
 #include "RenderDevice.h"
+#include "Upscaler.h"
 
+#include <intrin.h>
+
+#include <algorithm>
 #include <cassert>
+#include <atomic>
+#include <deque>
 #include <mutex>
-#include <queue>
 #include <stack>
 
 using namespace YaGE;
@@ -13,12 +24,32 @@ namespace {
 
 static constexpr const uint32_t DEFAULT_PAGE_SIZE = 0x200000; // 2 MiB
 
+/// @brief
+///   Get number of subresources of the specified resource. Plane slices are not counted.
+///
+/// @param[in] resource The D3D12 resource to be queried.
+///
+/// @return uint32_t
+///   Return number of subresources of the specified resource.
+auto SubresourceCount(ID3D12Resource *resource) noexcept -> uint32_t {
+    const D3D12_RESOURCE_DESC desc = resource->GetDesc();
+    if (desc.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER)
+        return 1;
+
+    const uint32_t arraySize = (desc.Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE3D) ? 1U : desc.DepthOrArraySize;
+    return static_cast<uint32_t>(desc.MipLevels) * arraySize;
+}
+
 enum class TempBufferType {
     Upload,
     UnorderedAccess,
 };
 
+class TempBufferPageManager;
+
 class TempBufferPage final : public GpuResource {
+    friend class TempBufferPageManager;
+
 public:
     /// @brief
     ///   Create a new temp buffer page.
@@ -44,10 +75,17 @@ public:
     ///
     /// @param other    The page to be moved.
     TempBufferPage(TempBufferPage &&other) noexcept
-        : GpuResource(std::move(other)), size(other.size), data(other.data), gpuAddress(other.gpuAddress) {
-        other.size       = 0;
-        other.data       = nullptr;
-        other.gpuAddress = 0;
+        : GpuResource(std::move(other)),
+          size(other.size),
+          data(other.data),
+          gpuAddress(other.gpuAddress),
+          next(other.next),
+          retireSyncPoint(other.retireSyncPoint) {
+        other.size            = 0;
+        other.data            = nullptr;
+        other.gpuAddress      = 0;
+        other.next            = nullptr;
+        other.retireSyncPoint = 0;
     }
 
     /// @brief
@@ -90,21 +128,19 @@ private:
 
     /// @brief  GPU address to start of this temp buffer page.
     uint64_t gpuAddress;
+
+    /// @brief  Next page in the retired page list. Used by temp buffer page manager only.
+    TempBufferPage *next;
+
+    /// @brief  The sync point that indicates when this retired page could be reused.
+    uint64_t retireSyncPoint;
 };
 
 TempBufferPage::TempBufferPage(TempBufferType bufferType, size_t size)
-    : GpuResource(), size(size), data(nullptr), gpuAddress(0) {
-    RenderDevice &device = RenderDevice::Singleton();
+    : GpuResource(), size(size), data(nullptr), gpuAddress(0), next(nullptr), retireSyncPoint(0) {
+    YAGE_PROFILE_COUNT(TempPagesCreated, 1);
 
     if (bufferType == TempBufferType::Upload) {
-        const D3D12_HEAP_PROPERTIES heapProps{
-            /* Type                 = */ D3D12_HEAP_TYPE_UPLOAD,
-            /* CPUPageProperty      = */ D3D12_CPU_PAGE_PROPERTY_UNKNOWN,
-            /* MemoryPoolPreference = */ D3D12_MEMORY_POOL_UNKNOWN,
-            /* CreationNodeMask     = */ 0,
-            /* VisibleNodeMask      = */ 0,
-        };
-
         const D3D12_RESOURCE_DESC desc{
             /* Dimension        = */ D3D12_RESOURCE_DIMENSION_BUFFER,
             /* Alignment        = */ 0,
@@ -122,24 +158,15 @@ TempBufferPage::TempBufferPage(TempBufferType bufferType, size_t size)
             /* Flags  = */ D3D12_RESOURCE_FLAG_NONE,
         };
 
-        HRESULT hr = device.Device()->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &desc,
-                                                              D3D12_RESOURCE_STATE_GENERIC_READ, nullptr,
-                                                              IID_PPV_ARGS(resource.GetAddressOf()));
+        HRESULT hr = CreateResource(D3D12_HEAP_TYPE_UPLOAD, desc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr);
         if (FAILED(hr))
             throw RenderAPIException(hr, u"Failed to create temporary upload buffer page.");
 
-        usageState = D3D12_RESOURCE_STATE_GENERIC_READ;
+        RenderDevice::Singleton().SetMemoryCategory(allocation, GpuMemoryCategory::TempPage);
+
         resource->Map(0, nullptr, &data);
         gpuAddress = resource->GetGPUVirtualAddress();
     } else {
-        const D3D12_HEAP_PROPERTIES heapProps{
-            /* Type                 = */ D3D12_HEAP_TYPE_DEFAULT,
-            /* CPUPageProperty      = */ D3D12_CPU_PAGE_PROPERTY_UNKNOWN,
-            /* MemoryPoolPreference = */ D3D12_MEMORY_POOL_UNKNOWN,
-            /* CreationNodeMask     = */ 0,
-            /* VisibleNodeMask      = */ 0,
-        };
-
         const D3D12_RESOURCE_DESC desc{
             /* Dimension        = */ D3D12_RESOURCE_DIMENSION_BUFFER,
             /* Alignment        = */ 0,
@@ -157,13 +184,12 @@ TempBufferPage::TempBufferPage(TempBufferType bufferType, size_t size)
             /* Flags  = */ D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS,
         };
 
-        HRESULT hr = device.Device()->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &desc,
-                                                              D3D12_RESOURCE_STATE_COMMON, nullptr,
-                                                              IID_PPV_ARGS(resource.GetAddressOf()));
+        HRESULT hr = CreateResource(D3D12_HEAP_TYPE_DEFAULT, desc, D3D12_RESOURCE_STATE_COMMON, nullptr);
         if (FAILED(hr))
             throw RenderAPIException(hr, u"Failed to create temporary unordered access buffer page.");
 
-        usageState = D3D12_RESOURCE_STATE_COMMON;
+        RenderDevice::Singleton().SetMemoryCategory(allocation, GpuMemoryCategory::TempPage);
+
         gpuAddress = resource->GetGPUVirtualAddress();
     }
 }
@@ -175,6 +201,227 @@ TempBufferPage::~TempBufferPage() noexcept {
     }
 }
 
+/// @brief  Size in byte of each chunk that is acquired from upload ring.
+static constexpr const size_t UPLOAD_RING_CHUNK_SIZE = 0x10000; // 64 KiB
+
+/// @brief  Size in byte of upload rings that are not created yet. Upload ring is disabled if this is 0.
+static std::atomic<size_t> uploadRingSize{0x2000000}; // 32 MiB
+
+/// @brief  Number of size buckets of pooled large pages. Large pages are pooled from 4 MiB to 512 MiB.
+static constexpr const uint32_t LARGE_PAGE_BUCKET_COUNT = 8;
+
+/// @brief  Maximum total size in byte of pooled large pages in each size bucket. At least one page is always pooled.
+static constexpr const size_t MAX_LARGE_PAGE_BUCKET_BYTES = 0x4000000; // 64 MiB
+
+/// @brief  Large pages up to this size are rounded up to power of 2. Larger pages are rounded up to @p LARGE_PAGE_GRANULARITY.
+static constexpr const size_t MAX_POW2_LARGE_PAGE_SIZE = 0x4000000; // 64 MiB
+
+/// @brief  Size granularity in byte of large pages that are larger than @p MAX_POW2_LARGE_PAGE_SIZE.
+static constexpr const size_t LARGE_PAGE_GRANULARITY = 0x400000; // 4 MiB
+
+/// @brief
+///   Get size of a new large page.
+/// @remarks
+///   Rounding up to power of 2 wastes up to half of the page, so pages larger than 64 MiB are rounded up to 4 MiB instead.
+///   Those pages have different sizes in the same bucket, and are reused by searching the bucket by size.
+///
+/// @param size     Requested size in byte. Must be greater than default page size.
+///
+/// @return size_t
+///   Return size in byte of the new large page.
+YAGE_NODISCARD static auto LargePageSize(size_t size) noexcept -> size_t {
+    if (size > MAX_POW2_LARGE_PAGE_SIZE)
+        return (size + LARGE_PAGE_GRANULARITY - 1) & ~(LARGE_PAGE_GRANULARITY - 1);
+
+    size_t pageSize = size_t(DEFAULT_PAGE_SIZE) << 1;
+    while (pageSize < size)
+        pageSize <<= 1;
+    return pageSize;
+}
+
+/// @brief
+///   Get bucket index of a large page.
+///
+/// @param size     Size in byte of the large page. Must be greater than default page size.
+///
+/// @return uint32_t
+///   Return index of the bucket. Return @p UINT32_MAX if the page is too large to be pooled.
+YAGE_NODISCARD static auto LargePageBucket(size_t size) noexcept -> uint32_t {
+    uint32_t bucket = 0;
+    while (bucket < LARGE_PAGE_BUCKET_COUNT && (size_t(DEFAULT_PAGE_SIZE) << (bucket + 1)) < size)
+        ++bucket;
+    return bucket < LARGE_PAGE_BUCKET_COUNT ? bucket : UINT32_MAX;
+}
+
+/// @brief
+///   Get index of upload ring for the specified command queue.
+///
+/// @param type     Type of the command queue.
+///
+/// @return uint32_t
+///   Return index of the upload ring.
+YAGE_NODISCARD static constexpr auto UploadRingIndex(D3D12_COMMAND_LIST_TYPE type) noexcept -> uint32_t {
+    return type == D3D12_COMMAND_LIST_TYPE_COPY ? 1 : (type == D3D12_COMMAND_LIST_TYPE_COMPUTE ? 2 : 0);
+}
+
+class UploadRing {
+public:
+    /// @brief
+    ///   Create an empty upload ring. The ring buffer is created on first allocation.
+    UploadRing() noexcept;
+
+    /// @brief
+    ///   Copy constructor of upload ring is disabled.
+    UploadRing(const UploadRing &) = delete;
+
+    /// @brief
+    ///   Copy assignment of upload ring is disabled.
+    auto operator=(const UploadRing &) = delete;
+
+    /// @brief
+    ///   Destroy this upload ring. GPU must not be using this ring anymore.
+    ~UploadRing() noexcept;
+
+    /// @brief
+    ///   Allocate a chunk from this upload ring. Finished chunks at the tail of the ring are reclaimed first.
+    ///
+    /// @param size             Size in byte of the chunk to be allocated. Must be aligned up with 256 bytes.
+    /// @param[out] chunkID     Receives ID of the new chunk. The ID should be used to free the chunk.
+    /// @param[out] offset      Receives offset from start of the ring buffer to the new chunk.
+    ///
+    /// @return bool
+    /// @retval true   The chunk is allocated.
+    /// @retval false  There is no enough space in this ring or upload ring is disabled.
+    /// @throw RenderAPIException
+    ///   Thrown if failed to create the ring buffer.
+    YAGE_NODISCARD auto Allocate(size_t size, uint64_t &chunkID, size_t &offset) -> bool;
+
+    /// @brief
+    ///   Free chunks that are allocated from this ring.
+    ///
+    /// @param syncPoint    The sync point that indicates when the chunks can be reused.
+    /// @param chunkIDs     ID of the chunks to be freed.
+    auto Free(uint64_t syncPoint, const std::vector<uint64_t> &chunkIDs) noexcept -> void;
+
+    /// @brief
+    ///   Get the ring buffer. Only available after the first successful allocation.
+    ///
+    /// @return TempBufferPage *
+    ///   Return pointer to the ring buffer.
+    YAGE_NODISCARD YAGE_FORCEINLINE auto Buffer() const noexcept -> TempBufferPage * { return buffer; }
+
+private:
+    struct Chunk {
+        /// @brief  Offset from start of the ring buffer to end of this chunk.
+        size_t end;
+
+        /// @brief  The sync point that indicates when this chunk could be reused.
+        uint64_t syncPoint;
+
+        /// @brief  Whether this chunk has been freed.
+        bool retired;
+    };
+
+    /// @brief  The render device that is used to check sync points.
+    RenderDevice &renderDevice;
+
+    /// @brief  The persistent mapped ring buffer.
+    TempBufferPage *buffer;
+
+    /// @brief  Size in byte of the ring buffer.
+    size_t capacity;
+
+    /// @brief  Offset from start of the ring buffer to the first free byte.
+    size_t head;
+
+    /// @brief  Offset from start of the ring buffer to the oldest chunk in use.
+    size_t tail;
+
+    /// @brief  ID of the first chunk in chunk queue.
+    uint64_t firstChunkID;
+
+    /// @brief  Memory pool of chunk queue nodes.
+    MemoryPool chunkPool;
+
+    /// @brief  Allocated chunks in allocation order.
+    std::deque<Chunk, PoolAllocator<Chunk>> chunks;
+
+    /// @brief  Mutex to protect this upload ring.
+    mutable std::mutex mutex;
+};
+
+UploadRing::UploadRing() noexcept
+    : renderDevice(RenderDevice::Singleton()),
+      buffer(),
+      capacity(),
+      head(),
+      tail(),
+      firstChunkID(),
+      chunkPool(),
+      chunks(PoolAllocator<Chunk>(chunkPool)),
+      mutex() {}
+
+UploadRing::~UploadRing() noexcept { delete buffer; }
+
+YAGE_NODISCARD auto UploadRing::Allocate(size_t size, uint64_t &chunkID, size_t &offset) -> bool {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Create ring buffer on first use.
+    if (buffer == nullptr) {
+        capacity = (uploadRingSize.load(std::memory_order_relaxed) + 0xFFFF) & ~size_t(0xFFFF);
+        if (capacity == 0)
+            return false;
+
+        buffer = new TempBufferPage(TempBufferType::Upload, capacity);
+    }
+
+    if (size > capacity)
+        return false;
+
+    // Reclaim all finished chunks at the tail.
+    while (!chunks.empty() && chunks.front().retired && renderDevice.IsSyncPointReached(chunks.front().syncPoint)) {
+        tail = chunks.front().end;
+        chunks.pop_front();
+        ++firstChunkID;
+    }
+
+    if (chunks.empty()) {
+        head = 0;
+        tail = 0;
+    }
+
+    // If head equals to tail and the ring is not empty, then the ring is full.
+    size_t begin = 0;
+    if (chunks.empty() || head > tail) {
+        if (capacity - head >= size)
+            begin = head;
+        else if (tail >= size)
+            begin = 0; // Wrap around. The space at the end of ring is released together with this chunk.
+        else
+            return false;
+    } else if (head < tail && tail - head >= size) {
+        begin = head;
+    } else {
+        return false;
+    }
+
+    head    = begin + size;
+    chunkID = firstChunkID + chunks.size();
+    offset  = begin;
+    chunks.push_back(Chunk{head, 0, false});
+
+    return true;
+}
+
+auto UploadRing::Free(uint64_t syncPoint, const std::vector<uint64_t> &chunkIDs) noexcept -> void {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const uint64_t id : chunkIDs) {
+        Chunk &chunk    = chunks[static_cast<size_t>(id - firstChunkID)];
+        chunk.syncPoint = syncPoint;
+        chunk.retired   = true;
+    }
+}
+
 class TempBufferPageManager {
 public:
     /// @brief
@@ -202,7 +449,9 @@ public:
     ///   Return pointer to the new temp buffer page.
     /// @throw RenderAPIException
     ///   Throw if failed to create new temp buffer page.
-    YAGE_NODISCARD auto AllocateUploadPage(size_t size) -> TempBufferPage *;
+    YAGE_NODISCARD auto AllocateUploadPage(size_t size) -> TempBufferPage * {
+        return AllocatePage(TempBufferType::Upload, size);
+    }
 
     /// @brief
     ///   Allocate a new unordered access temp buffer page.
@@ -213,184 +462,398 @@ public:
     ///   Return pointer to the new temp buffer page.
     /// @throw RenderAPIException
     ///   Throw if failed to create new temp buffer page.
-    YAGE_NODISCARD auto AllocateUnorderedAccessPage(size_t size) -> TempBufferPage *;
+    YAGE_NODISCARD auto AllocateUnorderedAccessPage(size_t size) -> TempBufferPage * {
+        return AllocatePage(TempBufferType::UnorderedAccess, size);
+    }
 
     /// @brief
     ///   Free retired upload pages.
     ///
     /// @param syncPoint    The sync point that indicates when the retired pages can be reused.
     /// @param pages        The pages to be freed.
-    auto FreeUploadPages(uint64_t syncPoint, const std::vector<void *> &pages) noexcept -> void;
+    auto FreeUploadPages(uint64_t syncPoint, const std::vector<void *> &pages) noexcept -> void {
+        FreePages(TempBufferType::Upload, syncPoint, pages);
+    }
 
     /// @brief
     ///   Free retired unordered access pages.
     ///
     /// @param syncPoint    The sync point that indicates when the retired pages can be reused.
     /// @param pages        The pages to be freed.
-    auto FreeUnorderedAccessPages(uint64_t syncPoint, const std::vector<void *> &pages) noexcept -> void;
+    auto FreeUnorderedAccessPages(uint64_t syncPoint, const std::vector<void *> &pages) noexcept -> void {
+        FreePages(TempBufferType::UnorderedAccess, syncPoint, pages);
+    }
+
+    /// @brief
+    ///   Push a list of retired pages back to the retired page list. This method is lock-free.
+    ///
+    /// @param type     Type of the retired pages.
+    /// @param first    The first page of the list.
+    /// @param last     The last page of the list.
+    auto PushRetiredPages(TempBufferType type, TempBufferPage *first, TempBufferPage *last) noexcept -> void;
 
     /// @brief
-    ///   Get the singleton instance of temp buffer page manager.
+    ///   Get upload ring of the specified command queue.
+    ///
+    /// @param type     Type of the command queue.
+    ///
+    /// @return UploadRing &
+    ///   Return reference to the upload ring.
+    YAGE_NODISCARD auto UploadRingFor(D3D12_COMMAND_LIST_TYPE type) noexcept -> UploadRing & {
+        return uploadRings[UploadRingIndex(type)];
+    }
+
+    /// @brief
+    ///   Get the singleton instance of temp buffer page manager. The instance is never destroyed, so that it is still valid when thread local page caches are destroyed.
     ///
     /// @return TempBufferPageManager &
     ///   Return reference to the temp buffer page manager singleton instance.
     YAGE_NODISCARD static auto Singleton() -> TempBufferPageManager &;
 
 private:
+    /// @brief
+    ///   Allocate a new temp buffer page. Default pages are taken from the thread local page cache first. The page
+    ///   cache is refilled from the retired page list if it is empty. Large pages are rounded up to power of 2 and
+    ///   reused from the large page pool.
+    ///
+    /// @param type     Type of the temp buffer page.
+    /// @param size     Expected size in byte of the new temp buffer page.
+    ///
+    /// @return TempBufferPage *
+    ///   Return pointer to the new temp buffer page.
+    /// @throw RenderAPIException
+    ///   Throw if failed to create new temp buffer page.
+    YAGE_NODISCARD auto AllocatePage(TempBufferType type, size_t size) -> TempBufferPage *;
+
+    /// @brief
+    ///   Free retired pages. Pooled large pages are returned to their size buckets until the bucket limit is reached,
+    ///   and other pages are linked together and pushed to the retired page list at once.
+    ///
+    /// @param type         Type of the retired pages.
+    /// @param syncPoint    The sync point that indicates when the retired pages can be reused.
+    /// @param pages        The pages to be freed.
+    auto FreePages(TempBufferType type, uint64_t syncPoint, const std::vector<void *> &pages) noexcept -> void;
+
+    /// @brief
+    ///   Reclaim all retired pages whose sync point has been reached. Reclaimed default pages are moved into the thread
+    ///   local page cache, large pages that are not pooled are deleted and pages that are still in use are pushed back.
+    ///
+    /// @param type     Type of the pages to be reclaimed.
+    auto ReclaimPages(TempBufferType type) noexcept -> void;
+
+    /// @brief
+    ///   Try to acquire a retired large page whose sync point has been reached.
+    ///
+    /// @param type     Type of the large page.
+    /// @param bucket   Bucket index of the large page.
+    /// @param size     Minimum size in byte of the large page.
+    ///
+    /// @return TempBufferPage *
+    ///   Return pointer to the reusable large page. Return @p nullptr if there is no reusable large page.
+    YAGE_NODISCARD auto AcquireLargePage(TempBufferType type, uint32_t bucket, size_t size) noexcept
+        -> TempBufferPage *;
+
     /// @brief  The render device that is used to create new buffer pages and sync with GPU.
     RenderDevice &renderDevice;
 
-    /// @brief  Temp buffer page pool. This is used to cache all allocated pages.
-    std::stack<TempBufferPage> pagePool;
+    /// @brief  Memory pool of page pool nodes. Protected by @p pagePoolMutex.
+    MemoryPool pagePoolNodes;
+
+    /// @brief  Temp buffer page pool. This is used to cache all allocated default pages.
+    std::stack<TempBufferPage, std::deque<TempBufferPage, PoolAllocator<TempBufferPage>>> pagePool;
 
-    /// @brief  Mutex to protect page pool.
+    /// @brief  Mutex to protect page pool. This is only used when creating new pages.
     mutable std::mutex pagePoolMutex;
 
-    /// @brief  Retired upload pages to be reused.
-    std::queue<std::pair<uint64_t, TempBufferPage *>> retiredUploadPages;
+    /// @brief  Lock-free lists of retired pages for each temp buffer type.
+    std::atomic<TempBufferPage *> retiredPages[2];
+
+    /// @brief  Lock-free lists of retired large pages for each temp buffer type and size bucket.
+    std::atomic<TempBufferPage *> largePages[2][LARGE_PAGE_BUCKET_COUNT];
+
+    /// @brief  Number of pages in each large page list. Used to limit size of each bucket.
+    std::atomic_uint32_t largePageCounts[2][LARGE_PAGE_BUCKET_COUNT];
 
-    /// @brief  Mutex to protect retired upload page queue.
-    mutable std::mutex retiredUploadQueueMutex;
+    /// @brief  Upload rings for each command queue.
+    UploadRing uploadRings[3];
+};
+
+/// @brief  Maximum number of default pages for each temp buffer type that could be cached by a single thread.
+static constexpr const uint32_t PAGE_CACHE_CAPACITY = 8;
 
-    /// @brief  Retired unordered access pages to be reused.
-    std::queue<std::pair<uint64_t, TempBufferPage *>> retiredUnorderedAccessPages;
+struct TempBufferPageCache {
+    /// @brief  Cached default pages for each temp buffer type.
+    TempBufferPage *pages[2][PAGE_CACHE_CAPACITY];
 
-    /// @brief  Mutex to protect retired unordered access page queue.
-    mutable std::mutex retiredUnorderedAccessQueueMutex;
+    /// @brief  Number of cached default pages for each temp buffer type.
+    uint32_t count[2];
+
+    /// @brief
+    ///   Return all cached pages to temp buffer page manager.
+    ~TempBufferPageCache() noexcept {
+        for (uint32_t type = 0; type < 2; ++type) {
+            if (count[type] == 0)
+                continue;
 
-    /// @brief  Queue of pages to be deleted.
-    std::queue<std::pair<uint64_t, TempBufferPage *>> deletionQueue;
+            for (uint32_t i = 0; i + 1 < count[type]; ++i)
+                pages[type][i]->next = pages[type][i + 1];
 
-    /// @brief  Mutex to protect deletion queue.
-    mutable std::mutex deletionQueueMutex;
+            TempBufferPageManager::Singleton().PushRetiredPages(static_cast<TempBufferType>(type), pages[type][0],
+                                                                pages[type][count[type] - 1]);
+        }
+    }
 };
 
+/// @brief  Thread local default page cache. Pages in this cache are always ready to be reused.
+static thread_local TempBufferPageCache threadPageCache{};
+
 TempBufferPageManager::TempBufferPageManager()
     : renderDevice(RenderDevice::Singleton()),
-      pagePool(),
+      pagePoolNodes(),
+      pagePool(PoolAllocator<TempBufferPage>(pagePoolNodes)),
       pagePoolMutex(),
-      retiredUploadPages(),
-      retiredUploadQueueMutex(),
-      retiredUnorderedAccessPages(),
-      retiredUnorderedAccessQueueMutex(),
-      deletionQueue(),
-      deletionQueueMutex() {}
+      uploadRings() {
+    for (auto &list : retiredPages)
+        list.store(nullptr, std::memory_order_relaxed);
 
-TempBufferPageManager::~TempBufferPageManager() noexcept {
-    renderDevice.Sync();
-    std::lock_guard<std::mutex> lock(deletionQueueMutex);
-    while (!deletionQueue.empty()) {
-        delete deletionQueue.front().second;
-        deletionQueue.pop();
+    for (auto &buckets : largePages) {
+        for (auto &list : buckets)
+            list.store(nullptr, std::memory_order_relaxed);
+    }
+
+    for (auto &buckets : largePageCounts) {
+        for (auto &count : buckets)
+            count.store(0, std::memory_order_relaxed);
     }
 }
 
-YAGE_NODISCARD auto TempBufferPageManager::AllocateUploadPage(size_t size) -> TempBufferPage * {
-    // Align up size.
-    size = (size + 255) & ~size_t(255);
+TempBufferPageManager::~TempBufferPageManager() noexcept {
+    renderDevice.Sync();
 
-    if (size <= DEFAULT_PAGE_SIZE) {
-        { // Try to get a free page from free page queue.
-            std::lock_guard<std::mutex> lock(retiredUploadQueueMutex);
-            if (!retiredUploadPages.empty()) {
-                if (renderDevice.IsSyncPointReached(retiredUploadPages.front().first)) {
-                    auto page = retiredUploadPages.front().second;
-                    retiredUploadPages.pop();
-                    return page;
-                }
-            }
+    // Default pages are owned by page pool. Only non-default pages should be deleted here.
+    for (auto &list : retiredPages) {
+        TempBufferPage *page = list.exchange(nullptr, std::memory_order_acquire);
+        while (page != nullptr) {
+            TempBufferPage *next = page->next;
+            if (!page->IsDefaultPage())
+                delete page;
+            page = next;
         }
+    }
 
-        { // Create a new page.
-            TempBufferPage newPage(TempBufferType::Upload);
-
-            std::lock_guard<std::mutex> lock(pagePoolMutex);
-            pagePool.emplace(std::move(newPage));
-            return &pagePool.top();
+    for (auto &buckets : largePages) {
+        for (auto &list : buckets) {
+            TempBufferPage *page = list.exchange(nullptr, std::memory_order_acquire);
+            while (page != nullptr) {
+                TempBufferPage *next = page->next;
+                delete page;
+                page = next;
+            }
         }
     }
+}
+
+auto TempBufferPageManager::PushRetiredPages(TempBufferType type, TempBufferPage *first, TempBufferPage *last) noexcept
+    -> void {
+    auto &list = retiredPages[static_cast<size_t>(type)];
 
-    return new TempBufferPage(TempBufferType::Upload, size);
+    TempBufferPage *head = list.load(std::memory_order_relaxed);
+    do {
+        last->next = head;
+    } while (!list.compare_exchange_weak(head, first, std::memory_order_release, std::memory_order_relaxed));
 }
 
-YAGE_NODISCARD auto TempBufferPageManager::AllocateUnorderedAccessPage(size_t size) -> TempBufferPage * {
+YAGE_NODISCARD auto TempBufferPageManager::AllocatePage(TempBufferType type, size_t size) -> TempBufferPage * {
     // Align up size.
     size = (size + 255) & ~size_t(255);
 
-    if (size <= DEFAULT_PAGE_SIZE) {
-        { // Try to get a free page from free page queue.
-            std::lock_guard<std::mutex> lock(retiredUnorderedAccessQueueMutex);
-            if (!retiredUnorderedAccessPages.empty()) {
-                if (renderDevice.IsSyncPointReached(retiredUnorderedAccessPages.front().first)) {
-                    auto page = retiredUnorderedAccessPages.front().second;
-                    retiredUnorderedAccessPages.pop();
-                    return page;
-                }
+    if (size > DEFAULT_PAGE_SIZE) {
+        const uint32_t bucket = LargePageBucket(size);
+        if (bucket == UINT32_MAX)
+            return new TempBufferPage(type, size);
+
+        TempBufferPage *page = AcquireLargePage(type, bucket, size);
+        if (page != nullptr)
+            return page;
+
+        return new TempBufferPage(type, LargePageSize(size));
+    }
+
+    const size_t index = static_cast<size_t>(type);
+    auto        &cache = threadPageCache;
+
+    if (cache.count[index] == 0)
+        ReclaimPages(type);
+
+    if (cache.count[index] != 0) {
+        TempBufferPage *page = cache.pages[index][--cache.count[index]];
+        page->next           = nullptr;
+        return page;
+    }
+
+    { // Create a new page.
+        TempBufferPage newPage(type);
+
+        std::lock_guard<std::mutex> lock(pagePoolMutex);
+        pagePool.emplace(std::move(newPage));
+        return &pagePool.top();
+    }
+}
+
+auto TempBufferPageManager::FreePages(TempBufferType            type,
+                                      uint64_t                  syncPoint,
+                                      const std::vector<void *> &pages) noexcept -> void {
+    TempBufferPage *first = nullptr;
+    TempBufferPage *last  = nullptr;
+
+    for (void *ptr : pages) {
+        TempBufferPage *page  = static_cast<TempBufferPage *>(ptr);
+        page->retireSyncPoint = syncPoint;
+        page->next            = nullptr;
+
+        // Pooled large pages are returned to their size buckets. Pages that exceed the bucket limit are retired like
+        // unpooled pages and deleted once GPU has finished with them, so that a burst of large uploads does not keep
+        // its memory forever.
+        uint32_t bucket = page->IsDefaultPage() ? UINT32_MAX : LargePageBucket(page->size);
+        if (bucket != UINT32_MAX) {
+            const size_t maxCount = std::max<size_t>(1, MAX_LARGE_PAGE_BUCKET_BYTES / page->size);
+            auto        &count    = largePageCounts[static_cast<size_t>(type)][bucket];
+            if (count.fetch_add(1, std::memory_order_relaxed) >= maxCount) {
+                count.fetch_sub(1, std::memory_order_relaxed);
+                bucket = UINT32_MAX;
             }
         }
 
-        { // Create a new page.
-            TempBufferPage newPage(TempBufferType::UnorderedAccess);
+        if (bucket != UINT32_MAX) {
+            auto &list = largePages[static_cast<size_t>(type)][bucket];
 
-            std::lock_guard<std::mutex> lock(pagePoolMutex);
-            pagePool.emplace(std::move(newPage));
-            return &pagePool.top();
+            TempBufferPage *head = list.load(std::memory_order_relaxed);
+            do {
+                page->next = head;
+            } while (!list.compare_exchange_weak(head, page, std::memory_order_release, std::memory_order_relaxed));
+            continue;
         }
+
+        // Link other pages together so that they could be pushed with a single CAS operation.
+        if (last == nullptr)
+            first = page;
+        else
+            last->next = page;
+        last = page;
     }
 
-    return new TempBufferPage(TempBufferType::UnorderedAccess, size);
+    if (first != nullptr)
+        PushRetiredPages(type, first, last);
 }
 
-auto TempBufferPageManager::FreeUploadPages(uint64_t syncPoint, const std::vector<void *> &pages) noexcept -> void {
-    { // Free default pages.
-        std::lock_guard<std::mutex> lock(retiredUploadQueueMutex);
-        for (const auto &page : pages) {
-            auto bufferPage = static_cast<TempBufferPage *>(page);
-            if (bufferPage->IsDefaultPage())
-                retiredUploadPages.emplace(syncPoint, bufferPage);
-        }
-    }
+auto TempBufferPageManager::ReclaimPages(TempBufferType type) noexcept -> void {
+    const size_t index = static_cast<size_t>(type);
+    auto        &cache = threadPageCache;
 
-    { // Free deletion pages.
-        std::lock_guard<std::mutex> lock(deletionQueueMutex);
-        for (const auto &page : pages) {
-            auto bufferPage = static_cast<TempBufferPage *>(page);
-            if (!bufferPage->IsDefaultPage())
-                deletionQueue.emplace(syncPoint, bufferPage);
+    // Take the whole list at once. Taking all pages avoids ABA problem of lock-free stack.
+    TempBufferPage *page = retiredPages[index].exchange(nullptr, std::memory_order_acquire);
+    if (page == nullptr)
+        return;
+
+    TempBufferPage *keepFirst = nullptr;
+    TempBufferPage *keepLast  = nullptr;
+
+    while (page != nullptr) {
+        TempBufferPage *const next = page->next;
+
+        const bool reached = renderDevice.IsSyncPointReached(page->retireSyncPoint);
+        if (reached && !page->IsDefaultPage()) {
+            delete page;
+        } else if (reached && cache.count[index] < PAGE_CACHE_CAPACITY) {
+            cache.pages[index][cache.count[index]++] = page;
+        } else {
+            // Pages that are still in use, or reusable pages that the cache could not hold.
+            page->next = nullptr;
+            if (keepLast == nullptr)
+                keepFirst = page;
+            else
+                keepLast->next = page;
+            keepLast = page;
         }
+
+        page = next;
     }
+
+    if (keepFirst != nullptr)
+        PushRetiredPages(type, keepFirst, keepLast);
 }
 
-auto TempBufferPageManager::FreeUnorderedAccessPages(uint64_t syncPoint, const std::vector<void *> &pages) noexcept
-    -> void {
-    { // Free default pages.
-        std::lock_guard<std::mutex> lock(retiredUnorderedAccessQueueMutex);
-        for (const auto &page : pages) {
-            auto bufferPage = static_cast<TempBufferPage *>(page);
-            if (bufferPage->IsDefaultPage())
-                retiredUnorderedAccessPages.emplace(syncPoint, bufferPage);
+YAGE_NODISCARD auto TempBufferPageManager::AcquireLargePage(TempBufferType type, uint32_t bucket, size_t size) noexcept
+    -> TempBufferPage * {
+    auto &list = largePages[static_cast<size_t>(type)][bucket];
+
+    TempBufferPage *page = list.exchange(nullptr, std::memory_order_acquire);
+    if (page == nullptr)
+        return nullptr;
+
+    TempBufferPage *result    = nullptr;
+    TempBufferPage *keepFirst = nullptr;
+    TempBufferPage *keepLast  = nullptr;
+
+    while (page != nullptr) {
+        TempBufferPage *const next = page->next;
+
+        if (result == nullptr && page->size >= size && renderDevice.IsSyncPointReached(page->retireSyncPoint)) {
+            result       = page;
+            result->next = nullptr;
+            largePageCounts[static_cast<size_t>(type)][bucket].fetch_sub(1, std::memory_order_relaxed);
+        } else {
+            page->next = nullptr;
+            if (keepLast == nullptr)
+                keepFirst = page;
+            else
+                keepLast->next = page;
+            keepLast = page;
         }
+
+        page = next;
     }
 
-    { // Free deletion pages.
-        std::lock_guard<std::mutex> lock(deletionQueueMutex);
-        for (const auto &page : pages) {
-            auto bufferPage = static_cast<TempBufferPage *>(page);
-            if (!bufferPage->IsDefaultPage())
-                deletionQueue.emplace(syncPoint, bufferPage);
-        }
+    if (keepFirst != nullptr) {
+        TempBufferPage *head = list.load(std::memory_order_relaxed);
+        do {
+            keepLast->next = head;
+        } while (!list.compare_exchange_weak(head, keepFirst, std::memory_order_release, std::memory_order_relaxed));
     }
+
+    return result;
 }
 
 YAGE_NODISCARD auto TempBufferPageManager::Singleton() -> TempBufferPageManager & {
-    static TempBufferPageManager instance;
-    return instance;
+    // Intentionally leaked. Thread local page caches return their pages to this manager on thread exit, which may
+    // happen after static objects are destroyed, for example worker threads of the thread pool singleton. Pages are
+    // reclaimed by the operating system on process exit.
+    static TempBufferPageManager *const instance = new TempBufferPageManager;
+    return *instance;
+}
+
+/// @brief
+///   Checks if the specified acceleration structure build is an update.
+///
+/// @param inputs   Inputs of the acceleration structure build.
+///
+/// @return bool
+/// @retval true    The build updates an existing acceleration structure.
+/// @retval false   The build is a full rebuild.
+YAGE_NODISCARD auto IsUpdate(const D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_INPUTS &inputs) noexcept -> bool {
+    return (inputs.Flags & D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_PERFORM_UPDATE) != 0;
 }
 
 } // namespace
 
-YaGE::CommandBuffer::TempBufferAllocator::TempBufferAllocator() noexcept
-    : uploadPage(),
+YaGE::CommandBuffer::TempBufferAllocator::TempBufferAllocator(D3D12_COMMAND_LIST_TYPE queueType) noexcept
+    : queueType(queueType),
+      uploadRing(),
+      ringChunkOffset(),
+      ringChunkSize(),
+      ringChunkUsed(),
+      ringChunks(),
+      uploadPage(),
       uploadPageOffset(),
       retiredUploadPages(),
       unorderedAccessPage(),
@@ -398,16 +861,51 @@ YaGE::CommandBuffer::TempBufferAllocator::TempBufferAllocator() noexcept
       retiredUnorderedAccessPages() {}
 
 YaGE::CommandBuffer::TempBufferAllocator::~TempBufferAllocator() noexcept {
-    CleanUp(RenderDevice::Singleton().AcquireSyncPoint());
+    CleanUp(RenderDevice::Singleton().AcquireSyncPoint(queueType));
 }
 
 YAGE_NODISCARD auto YaGE::CommandBuffer::TempBufferAllocator::AllocateUploadBuffer(size_t size)
     -> TempBufferAllocation {
+    YAGE_PROFILE_SCOPE(TempBufferAllocate);
+
     // Align up allocate size.
     size = (size + 255) & ~size_t(255);
+    YAGE_PROFILE_COUNT(UploadBytes, size);
 
     TempBufferPageManager &pageManager = TempBufferPageManager::Singleton();
 
+    // Acquire a new ring chunk if there is no enough space in current ring chunk.
+    if (ringChunkUsed + size > ringChunkSize && size < DEFAULT_PAGE_SIZE) {
+        if (uploadRing == nullptr)
+            uploadRing = &pageManager.UploadRingFor(queueType);
+
+        const size_t chunkSize = (size > UPLOAD_RING_CHUNK_SIZE) ? size : UPLOAD_RING_CHUNK_SIZE;
+
+        uint64_t chunkID = 0;
+        size_t   offset  = 0;
+        if (static_cast<UploadRing *>(uploadRing)->Allocate(chunkSize, chunkID, offset)) {
+            ringChunks.push_back(chunkID);
+            ringChunkOffset = offset;
+            ringChunkSize   = chunkSize;
+            ringChunkUsed   = 0;
+        }
+    }
+
+    // Sub-allocate from current ring chunk.
+    if (ringChunkUsed + size <= ringChunkSize) {
+        TempBufferPage *const buffer = static_cast<UploadRing *>(uploadRing)->Buffer();
+        const size_t          offset = ringChunkOffset + ringChunkUsed;
+
+        ringChunkUsed += size;
+        return TempBufferAllocation{
+            /* resource   = */ buffer,
+            /* size       = */ size,
+            /* offset     = */ offset,
+            /* data       = */ buffer->Map<uint8_t>() + offset,
+            /* gpuAddress = */ buffer->GpuAddress() + offset,
+        };
+    }
+
     // Allocate a single page if size is larger than default page size.
     if (size >= DEFAULT_PAGE_SIZE) {
         TempBufferPage *page = pageManager.AllocateUploadPage(size);
@@ -450,6 +948,8 @@ YAGE_NODISCARD auto YaGE::CommandBuffer::TempBufferAllocator::AllocateUploadBuff
 
 YAGE_NODISCARD auto YaGE::CommandBuffer::TempBufferAllocator::AllocateUnorderedAccessBuffer(size_t size)
     -> TempBufferAllocation {
+    YAGE_PROFILE_SCOPE(TempBufferAllocate);
+
     // Align up allocate size.
     size = (size + 255) & ~size_t(255);
 
@@ -498,6 +998,15 @@ YAGE_NODISCARD auto YaGE::CommandBuffer::TempBufferAllocator::AllocateUnorderedA
 auto YaGE::CommandBuffer::TempBufferAllocator::CleanUp(uint64_t syncPoint) noexcept -> void {
     TempBufferPageManager &pageManager = TempBufferPageManager::Singleton();
 
+    if (!ringChunks.empty()) {
+        static_cast<UploadRing *>(uploadRing)->Free(syncPoint, ringChunks);
+        ringChunks.clear();
+    }
+
+    ringChunkOffset = 0;
+    ringChunkSize   = 0;
+    ringChunkUsed   = 0;
+
     if (uploadPage != nullptr) {
         retiredUploadPages.push_back(uploadPage);
         uploadPage = nullptr;
@@ -519,32 +1028,72 @@ auto YaGE::CommandBuffer::TempBufferAllocator::CleanUp(uint64_t syncPoint) noexc
     }
 }
 
-YaGE::CommandBuffer::CommandBuffer()
+auto YaGE::CommandBuffer::SetUploadRingSize(size_t size) noexcept -> void {
+    uploadRingSize.store(size, std::memory_order_relaxed);
+}
+
+YaGE::CommandBuffer::CommandBuffer() : CommandBuffer(D3D12_COMMAND_LIST_TYPE_DIRECT) {}
+
+YaGE::CommandBuffer::CommandBuffer(D3D12_COMMAND_LIST_TYPE type)
     : renderDevice(RenderDevice::Singleton()),
+      commandListType(type),
       commandList(),
       allocator(),
       lastSubmitSyncPoint(),
-      tempBufferAllocator(),
+      pendingWaitSyncPoints(),
+      pendingReadbacks(),
+      tempBufferAllocator(type),
       graphicsRootSignature(),
       computeRootSignature(),
-      dynamicDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV),
-      dynamicSamplerHeap(D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER) {
+      dynamicDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, type),
+      dynamicSamplerHeap(D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER, type),
+      stateTracking(true),
+      declaredResources(),
+      pendingBarrierCount(),
+      pendingBarriers(),
+      boundPipelineState(),
+      boundTopology(D3D12_PRIMITIVE_TOPOLOGY_UNDEFINED),
+      isViewportBound(),
+      isScissorRectBound(),
+      boundViewport(),
+      boundScissorRect(),
+      boundVertexBuffers(),
+      boundIndexBuffer(),
+      filteredStateCount() {
     // Acquire allocator.
-    allocator = renderDevice.AcquireCommandAllocator();
+    allocator = renderDevice.AcquireCommandAllocator(commandListType);
 
     // Create command list.
-    HRESULT hr = renderDevice.Device()->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, allocator, nullptr,
+    HRESULT hr = renderDevice.Device()->CreateCommandList(0, commandListType, allocator, nullptr,
                                                           IID_PPV_ARGS(commandList.GetAddressOf()));
 
     if (FAILED(hr)) {
-        renderDevice.FreeCommandAllocator(0, allocator);
+        renderDevice.FreeCommandAllocator(commandListType, 0, allocator);
         throw RenderAPIException(hr, u"Failed to create command list.");
     }
+
+    // Copy command lists could not build acceleration structures or dispatch rays.
+    if (commandListType != D3D12_COMMAND_LIST_TYPE_COPY && renderDevice.SupportRayTracing())
+        commandList.As(&commandList4);
+
+#ifdef __ID3D12GraphicsCommandList6_INTERFACE_DEFINED__
+    // Mesh dispatches are only recorded in graphics command lists.
+    if (commandListType == D3D12_COMMAND_LIST_TYPE_DIRECT && renderDevice.SupportMeshShaders())
+        commandList.As(&commandList6);
+#endif
+
+#ifdef __ID3D12GraphicsCommandList7_INTERFACE_DEFINED__
+    // Enhanced barriers are only available if both the runtime and the driver support them.
+    if (renderDevice.SupportEnhancedBarriers())
+        commandList.As(&commandList7);
+#endif
+
+    BindGlobalDescriptorHeaps();
 }
 
 YaGE::CommandBuffer::~CommandBuffer() noexcept {
     if (allocator != nullptr) {
-        renderDevice.FreeCommandAllocator(lastSubmitSyncPoint, allocator);
+        renderDevice.FreeCommandAllocator(commandListType, lastSubmitSyncPoint, allocator);
         allocator = nullptr;
     }
 
@@ -552,15 +1101,18 @@ YaGE::CommandBuffer::~CommandBuffer() noexcept {
 }
 
 auto YaGE::CommandBuffer::Submit() -> uint64_t {
-    commandList->Close();
+    CommandBuffer *const self = this;
+    return renderDevice.Submit(1, &self);
+}
 
-    { // Submit command list to execute.
-        ID3D12CommandList *list = commandList.Get();
-        renderDevice.CommandQueue()->ExecuteCommandLists(1, &list);
-    }
+auto YaGE::CommandBuffer::FinishSubmit(uint64_t syncPoint) -> void {
+    lastSubmitSyncPoint = syncPoint;
+    pendingWaitSyncPoints.clear();
 
-    // Acquire sync point.
-    lastSubmitSyncPoint = renderDevice.AcquireSyncPoint();
+    // Notify readback buffers that are written by this submission.
+    for (YaGE::ReadbackBuffer *buffer : pendingReadbacks)
+        buffer->syncPoint = syncPoint;
+    pendingReadbacks.clear();
 
     // Clean up temp buffer allocator.
     tempBufferAllocator.CleanUp(lastSubmitSyncPoint);
@@ -572,16 +1124,31 @@ auto YaGE::CommandBuffer::Submit() -> uint64_t {
     dynamicSamplerHeap.CleanUp(lastSubmitSyncPoint);
 
     // Reset allocator.
-    renderDevice.FreeCommandAllocator(lastSubmitSyncPoint, allocator);
-    allocator = renderDevice.AcquireCommandAllocator();
+    renderDevice.FreeCommandAllocator(commandListType, lastSubmitSyncPoint, allocator);
+    allocator = renderDevice.AcquireCommandAllocator(commandListType);
 
     // Reset command list.
     commandList->Reset(allocator, nullptr);
+    ResetBoundState();
+    BindGlobalDescriptorHeaps();
+}
+
+auto YaGE::CommandBuffer::BindGlobalDescriptorHeaps() noexcept -> void {
+    // Copy command lists could not use shader visible descriptor heaps.
+    if (commandListType == D3D12_COMMAND_LIST_TYPE_COPY)
+        return;
+
+    ID3D12DescriptorHeap *const heaps[] = {
+        GlobalDescriptorHeap::Singleton(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV).DescriptorHeap(),
+        GlobalDescriptorHeap::Singleton(D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER).DescriptorHeap(),
+    };
 
-    return lastSubmitSyncPoint;
+    commandList->SetDescriptorHeaps(2, heaps);
 }
 
 auto YaGE::CommandBuffer::Reset() -> void {
+    // Pending barriers belong to the commands that are being discarded.
+    pendingBarrierCount = 0;
     commandList->Close();
     tempBufferAllocator.CleanUp(lastSubmitSyncPoint);
 
@@ -590,111 +1157,583 @@ auto YaGE::CommandBuffer::Reset() -> void {
     computeRootSignature  = nullptr;
     dynamicDescriptorHeap.CleanUp(lastSubmitSyncPoint);
     dynamicSamplerHeap.CleanUp(lastSubmitSyncPoint);
+    pendingWaitSyncPoints.clear();
+    pendingReadbacks.clear();
 
     if (allocator == nullptr)
-        allocator = renderDevice.AcquireCommandAllocator();
+        allocator = renderDevice.AcquireCommandAllocator(commandListType);
     else
         allocator->Reset();
 
     commandList->Reset(allocator, nullptr);
+    ResetBoundState();
+    BindGlobalDescriptorHeaps();
+}
+
+auto YaGE::CommandBuffer::ExecuteIndirect(const CommandSignature &signature,
+                                          uint32_t                commandCount,
+                                          GpuResource            &argumentBuffer,
+                                          uint64_t                argumentOffset) noexcept -> void {
+    RequireState(argumentBuffer, D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT);
+    RecordExecuteIndirect(signature, commandCount, argumentBuffer.resource.Get(), argumentOffset, nullptr, 0);
+}
+
+auto YaGE::CommandBuffer::ExecuteIndirect(const CommandSignature &signature,
+                                          uint32_t                maxCommandCount,
+                                          GpuResource            &argumentBuffer,
+                                          uint64_t                argumentOffset,
+                                          GpuResource            &countBuffer,
+                                          uint64_t                countOffset) noexcept -> void {
+    RequireState(argumentBuffer, D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT);
+    if (&countBuffer != &argumentBuffer)
+        RequireState(countBuffer, D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT);
+
+    RecordExecuteIndirect(signature, maxCommandCount, argumentBuffer.resource.Get(), argumentOffset,
+                          countBuffer.resource.Get(), countOffset);
+}
+
+auto YaGE::CommandBuffer::DispatchIndirect(GpuResource &argumentBuffer, uint64_t argumentOffset) -> void {
+    ExecuteIndirect(CommandSignature::DispatchSignature(), 1, argumentBuffer, argumentOffset);
+}
+
+#ifdef __ID3D12GraphicsCommandList6_INTERFACE_DEFINED__
+auto YaGE::CommandBuffer::DispatchMeshIndirect(GpuResource &argumentBuffer, uint64_t argumentOffset) -> void {
+    ExecuteIndirect(CommandSignature::DispatchMeshSignature(), 1, argumentBuffer, argumentOffset);
+}
+#endif
+
+auto YaGE::CommandBuffer::BuildAccelerationStructures(uint32_t count, const AccelerationStructureBuild *builds)
+    -> void {
+    if (count == 0)
+        return;
+
+    // Each build uses its own range of the shared scratch buffer so that builds are not serialized by barriers.
+    std::vector<size_t> scratchOffsets(count);
+    size_t              scratchSize = 0;
+
+    for (uint32_t i = 0; i < count; ++i) {
+        const AccelerationStructureBuild &build  = builds[i];
+        AccelerationStructure            &dest   = *build.dest;
+        const bool                        update = IsUpdate(build.inputs);
+
+        const D3D12_RAYTRACING_ACCELERATION_STRUCTURE_PREBUILD_INFO info =
+            AccelerationStructure::PrebuildInfo(build.inputs);
+
+        // In-place updates never change size of the acceleration structure.
+        if (!(update && build.source == nullptr) &&
+            (dest.resource == nullptr || dest.Type() != build.inputs.Type ||
+             dest.Size() < info.ResultDataMaxSizeInBytes))
+            dest = AccelerationStructure(build.inputs.Type, static_cast<size_t>(info.ResultDataMaxSizeInBytes));
+
+        scratchOffsets[i] = scratchSize;
+        scratchSize += static_cast<size_t>(update ? info.UpdateScratchDataSizeInBytes : info.ScratchDataSizeInBytes);
+        scratchSize = (scratchSize + 255) & ~size_t(255);
+    }
+
+    TempBufferAllocation scratch(tempBufferAllocator.AllocateUnorderedAccessBuffer(scratchSize));
+    RequireState(*scratch.resource, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+    FlushResourceBarriers();
+
+    for (uint32_t i = 0; i < count; ++i) {
+        const AccelerationStructureBuild &build  = builds[i];
+        AccelerationStructure            &dest   = *build.dest;
+        const bool                        update = IsUpdate(build.inputs);
+
+        D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_DESC desc;
+        desc.DestAccelerationStructureData    = dest.GpuAddress();
+        desc.Inputs                           = build.inputs;
+        desc.SourceAccelerationStructureData  = 0;
+        desc.ScratchAccelerationStructureData = scratch.gpuAddress + scratchOffsets[i];
+
+        if (update)
+            desc.SourceAccelerationStructureData = (build.source != nullptr) ? build.source->GpuAddress()
+                                                                             : dest.GpuAddress();
+
+        commandList4->BuildRaytracingAccelerationStructure(&desc, 0, nullptr);
+
+        dest.buildFlags   = build.inputs.Flags & ~D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_PERFORM_UPDATE;
+        dest.elementCount = build.inputs.NumDescs;
+        dest.isBuilt      = true;
+    }
+
+    // Later builds, copies and ray dispatches must wait for these builds.
+    for (uint32_t i = 0; i < count; ++i)
+        QueueUnorderedAccessBarrier(builds[i].dest->resource.Get());
+}
+
+auto YaGE::CommandBuffer::BuildTopLevelAccelerationStructure(
+    AccelerationStructure                              &dest,
+    const D3D12_RAYTRACING_INSTANCE_DESC               *instances,
+    uint32_t                                            count,
+    D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAGS flags) -> void {
+    flags &= ~D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_PERFORM_UPDATE;
+
+    // Refit in place if the instance layout is unchanged since the last build.
+    const bool refit = dest.IsBuilt() && dest.Type() == D3D12_RAYTRACING_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL &&
+                       (flags & D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_ALLOW_UPDATE) &&
+                       dest.BuildFlags() == flags && dest.ElementCount() == count;
+
+    AccelerationStructureBuild build;
+    build.dest                 = &dest;
+    build.source               = nullptr;
+    build.inputs.Type          = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL;
+    build.inputs.Flags         = flags;
+    build.inputs.NumDescs      = count;
+    build.inputs.DescsLayout   = D3D12_ELEMENTS_LAYOUT_ARRAY;
+    build.inputs.InstanceDescs = 0;
+
+    if (refit)
+        build.inputs.Flags |= D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_PERFORM_UPDATE;
+
+    if (count != 0) {
+        const size_t size = count * sizeof(D3D12_RAYTRACING_INSTANCE_DESC);
+
+        TempBufferAllocation allocation(tempBufferAllocator.AllocateUploadBuffer(size));
+        memcpy(allocation.data, instances, size);
+        build.inputs.InstanceDescs = allocation.gpuAddress;
+    }
+
+    BuildAccelerationStructures(1, &build);
+}
+
+auto YaGE::CommandBuffer::CopyAccelerationStructure(AccelerationStructure                            &dest,
+                                                    AccelerationStructure                            &src,
+                                                    D3D12_RAYTRACING_ACCELERATION_STRUCTURE_COPY_MODE mode) noexcept
+    -> void {
+    FlushResourceBarriers();
+    commandList4->CopyRaytracingAccelerationStructure(dest.GpuAddress(), src.GpuAddress(), mode);
+
+    dest.buildFlags   = src.buildFlags;
+    dest.elementCount = src.elementCount;
+    dest.isBuilt      = src.isBuilt;
+
+    QueueUnorderedAccessBarrier(dest.resource.Get());
+}
+
+auto YaGE::CommandBuffer::EmitCompactedSizes(uint32_t                      count,
+                                             AccelerationStructure *const *structures,
+                                             YaGE::ReadbackBuffer         &dest,
+                                             size_t                        destOffset) -> ReadbackHandle {
+    using CompactedSizeDesc = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_COMPACTED_SIZE_DESC;
+
+    const size_t size = count * sizeof(CompactedSizeDesc);
+
+    // Postbuild info could only be written to unordered access buffers.
+    TempBufferAllocation allocation(tempBufferAllocator.AllocateUnorderedAccessBuffer(size));
+    RequireState(*allocation.resource, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+    FlushResourceBarriers();
+
+    std::vector<D3D12_GPU_VIRTUAL_ADDRESS> addresses(count);
+    for (uint32_t i = 0; i < count; ++i)
+        addresses[i] = structures[i]->GpuAddress();
+
+    const D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_DESC desc{
+        /* DestBuffer = */ allocation.gpuAddress,
+        /* InfoType   = */ D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_COMPACTED_SIZE,
+    };
+
+    commandList4->EmitRaytracingAccelerationStructurePostbuildInfo(&desc, count, addresses.data());
+    return CopyToReadback(*allocation.resource, allocation.offset, dest, destOffset, size);
+}
+
+auto YaGE::CommandBuffer::SetPipelineState(const RayTracingPipelineState &pso) noexcept -> void {
+    // SetPipelineState1() unbinds current pipeline state object.
+    boundPipelineState = nullptr;
+    commandList4->SetPipelineState1(pso.D3D12StateObject());
+}
+
+auto YaGE::CommandBuffer::DispatchRays(const ShaderTable &rayGeneration,
+                                       const ShaderTable &miss,
+                                       const ShaderTable &hitGroup,
+                                       uint32_t           width,
+                                       uint32_t           height,
+                                       uint32_t           depth) -> void {
+    constexpr const size_t ALIGNMENT = D3D12_RAYTRACING_SHADER_TABLE_BYTE_ALIGNMENT;
+
+    // Pack all shader tables into one temp upload buffer.
+    const size_t missOffset     = (rayGeneration.Size() + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    const size_t hitGroupOffset = missOffset + ((miss.Size() + ALIGNMENT - 1) & ~(ALIGNMENT - 1));
+    const size_t totalSize      = hitGroupOffset + hitGroup.Size();
+
+    TempBufferAllocation allocation(tempBufferAllocator.AllocateUploadBuffer(totalSize));
+
+    uint8_t *const data = static_cast<uint8_t *>(allocation.data);
+    if (rayGeneration.Size() != 0)
+        memcpy(data, rayGeneration.Data(), rayGeneration.Size());
+    if (miss.Size() != 0)
+        memcpy(data + missOffset, miss.Data(), miss.Size());
+    if (hitGroup.Size() != 0)
+        memcpy(data + hitGroupOffset, hitGroup.Data(), hitGroup.Size());
+
+    D3D12_DISPATCH_RAYS_DESC desc{};
+    desc.RayGenerationShaderRecord.StartAddress = allocation.gpuAddress;
+    desc.RayGenerationShaderRecord.SizeInBytes  = rayGeneration.RecordStride();
+    desc.MissShaderTable.StartAddress           = allocation.gpuAddress + missOffset;
+    desc.MissShaderTable.SizeInBytes            = miss.Size();
+    desc.MissShaderTable.StrideInBytes          = miss.RecordStride();
+    desc.HitGroupTable.StartAddress             = allocation.gpuAddress + hitGroupOffset;
+    desc.HitGroupTable.SizeInBytes              = hitGroup.Size();
+    desc.HitGroupTable.StrideInBytes            = hitGroup.RecordStride();
+    desc.Width                                  = width;
+    desc.Height                                 = height;
+    desc.Depth                                  = depth;
+
+    DispatchRays(desc);
+}
+
+auto YaGE::CommandBuffer::RecordExecuteIndirect(const CommandSignature &signature,
+                                                uint32_t                maxCommandCount,
+                                                ID3D12Resource         *argumentBuffer,
+                                                uint64_t                argumentOffset,
+                                                ID3D12Resource         *countBuffer,
+                                                uint64_t                countOffset) noexcept -> void {
+    dynamicDescriptorHeap.Commit(commandList.Get());
+    dynamicSamplerHeap.Commit(commandList.Get());
+    FlushResourceBarriers();
+
+    commandList->ExecuteIndirect(signature.D3D12CommandSignature(), maxCommandCount, argumentBuffer, argumentOffset,
+                                 countBuffer, countOffset);
+
+    // Bindings changed by indirect arguments are undefined after ExecuteIndirect. Use an address that never matches
+    // a real view so that the next bind call is never filtered.
+    for (uint32_t mask = signature.VertexBufferMask(); mask != 0; mask &= (mask - 1)) {
+        unsigned long slot;
+        _BitScanForward(&slot, mask);
+        boundVertexBuffers[slot].BufferLocation = UINT64_MAX;
+    }
+
+    if (signature.ChangesIndexBuffer())
+        boundIndexBuffer.BufferLocation = UINT64_MAX;
+}
+
+auto YaGE::CommandBuffer::ResetBoundState() noexcept -> void {
+    boundPipelineState = nullptr;
+    boundTopology      = D3D12_PRIMITIVE_TOPOLOGY_UNDEFINED;
+    isViewportBound    = false;
+    isScissorRectBound = false;
+    boundIndexBuffer   = D3D12_INDEX_BUFFER_VIEW{};
+
+    for (D3D12_VERTEX_BUFFER_VIEW &vbv : boundVertexBuffers)
+        vbv = D3D12_VERTEX_BUFFER_VIEW{};
 }
 
 auto YaGE::CommandBuffer::Transition(GpuResource &resource, D3D12_RESOURCE_STATES newState) noexcept -> void {
-    if (resource.State() == newState)
+    // Render graph passes must declare all resources they use, because their states are not tracked here.
+    assert(IsResourceDeclared(resource));
+
+    // Resources used in copy queue are implicitly promoted from common state and decay back to common state.
+    if (commandListType == D3D12_COMMAND_LIST_TYPE_COPY) {
+        TrackCopyAccess(resource);
         return;
+    }
+
+    if (!stateTracking)
+        return;
+
+    // Placed render targets and depth stencil buffers must be initialized before first use.
+    if (resource.isUninitialized && commandListType == D3D12_COMMAND_LIST_TYPE_DIRECT)
+        InitializePlacedResource(resource);
 
-    D3D12_RESOURCE_BARRIER barriers[2];
-    uint32_t               barrierCount = 1U;
+    ID3D12Resource *const d3d12Resource = resource.resource.Get();
 
-    const D3D12_RESOURCE_STATES oldState = resource.State();
+    if (resource.subresourceStates.empty()) {
+        if (resource.usageState != newState)
+            QueueTransition(d3d12Resource, D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES, resource.usageState, newState);
+    } else {
+        // Subresources are in different states. Transition them one by one.
+        const uint32_t count = static_cast<uint32_t>(resource.subresourceStates.size());
+        for (uint32_t i = 0; i < count; ++i) {
+            if (resource.subresourceStates[i] != newState)
+                QueueTransition(d3d12Resource, i, resource.subresourceStates[i], newState);
+        }
 
-    barriers[0].Type                   = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-    barriers[0].Flags                  = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-    barriers[0].Transition.pResource   = resource.resource.Get();
-    barriers[0].Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-    barriers[0].Transition.StateBefore = oldState;
-    barriers[0].Transition.StateAfter  = newState;
+        resource.subresourceStates.clear();
+    }
 
     resource.usageState = newState;
+}
 
-    if (newState == D3D12_RESOURCE_STATE_UNORDERED_ACCESS) {
-        barriers[1].Type          = D3D12_RESOURCE_BARRIER_TYPE_UAV;
-        barriers[1].Flags         = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-        barriers[1].UAV.pResource = resource.resource.Get();
+auto YaGE::CommandBuffer::Transition(GpuResource          &resource,
+                                     uint32_t              subresource,
+                                     D3D12_RESOURCE_STATES newState) noexcept -> void {
+    // Render graph passes must declare all resources they use, because their states are not tracked here.
+    assert(IsResourceDeclared(resource));
 
-        barrierCount = 2U;
+    // Resources used in copy queue are implicitly promoted from common state and decay back to common state.
+    if (commandListType == D3D12_COMMAND_LIST_TYPE_COPY) {
+        TrackCopyAccess(resource);
+        return;
     }
 
-    commandList->ResourceBarrier(barrierCount, barriers);
-}
+    if (!stateTracking)
+        return;
 
-auto YaGE::CommandBuffer::Copy(GpuResource &src, GpuResource &dest) noexcept -> void {
-    // Transition resource state.
-    D3D12_RESOURCE_BARRIER barriers[2];
-    uint32_t               barrierCount = 0;
+    // Placed render targets and depth stencil buffers must be initialized before first use.
+    if (resource.isUninitialized && commandListType == D3D12_COMMAND_LIST_TYPE_DIRECT)
+        InitializePlacedResource(resource);
 
-    if (!(src.State() & D3D12_RESOURCE_STATE_COPY_SOURCE)) {
-        barriers[barrierCount].Type                   = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-        barriers[barrierCount].Flags                  = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-        barriers[barrierCount].Transition.pResource   = src.resource.Get();
-        barriers[barrierCount].Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-        barriers[barrierCount].Transition.StateBefore = src.State();
-        barriers[barrierCount].Transition.StateAfter  = D3D12_RESOURCE_STATE_COPY_SOURCE;
+    if (resource.subresourceStates.empty()) {
+        if (resource.usageState == newState)
+            return;
 
-        barrierCount += 1;
-        src.usageState = D3D12_RESOURCE_STATE_COPY_SOURCE;
+        // Split resource state into per-subresource states.
+        const uint32_t count = SubresourceCount(resource.resource.Get());
+        if (subresource >= count) {
+            Transition(resource, newState);
+            return;
+        }
+
+        resource.subresourceStates.assign(count, resource.usageState);
+    } else if (subresource >= resource.subresourceStates.size()) {
+        Transition(resource, newState);
+        return;
     }
 
-    if (!(dest.State() & D3D12_RESOURCE_STATE_COPY_DEST)) {
-        barriers[barrierCount].Type                   = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-        barriers[barrierCount].Flags                  = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-        barriers[barrierCount].Transition.pResource   = dest.resource.Get();
-        barriers[barrierCount].Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-        barriers[barrierCount].Transition.StateBefore = dest.State();
-        barriers[barrierCount].Transition.StateAfter  = D3D12_RESOURCE_STATE_COPY_DEST;
+    D3D12_RESOURCE_STATES &state = resource.subresourceStates[subresource];
+    if (state == newState)
+        return;
 
-        barrierCount += 1;
-        dest.usageState = D3D12_RESOURCE_STATE_COPY_DEST;
+    QueueTransition(resource.resource.Get(), subresource, state, newState);
+    state = newState;
+
+    // Merge per-subresource states if all subresources are in the same state again.
+    for (const D3D12_RESOURCE_STATES subresourceState : resource.subresourceStates) {
+        if (subresourceState != newState)
+            return;
     }
 
-    if (barrierCount)
-        commandList->ResourceBarrier(barrierCount, barriers);
+    resource.usageState = newState;
+    resource.subresourceStates.clear();
+}
 
-    commandList->CopyResource(dest.resource.Get(), src.resource.Get());
+auto YaGE::CommandBuffer::BeginTransition(GpuResource &resource, D3D12_RESOURCE_STATES newState) noexcept -> void {
+    QueueSplitTransition(resource, newState, D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY);
 }
 
-auto YaGE::CommandBuffer::CopyBuffer(
-    GpuResource &src, size_t srcOffset, GpuResource &dest, size_t destOffset, size_t size) noexcept -> void {
-    // Transition resource state.
-    D3D12_RESOURCE_BARRIER barriers[2];
-    uint32_t               barrierCount = 0;
+auto YaGE::CommandBuffer::EndTransition(GpuResource &resource, D3D12_RESOURCE_STATES newState) noexcept -> void {
+    assert(IsResourceDeclared(resource));
+
+    // Resources used in copy queue are implicitly promoted from common state and decay back to common state.
+    if (commandListType == D3D12_COMMAND_LIST_TYPE_COPY || !stateTracking)
+        return;
+
+    QueueSplitTransition(resource, newState, D3D12_RESOURCE_BARRIER_FLAG_END_ONLY);
+
+    resource.usageState = newState;
+    resource.subresourceStates.clear();
+}
+
+auto YaGE::CommandBuffer::AliasingBarrier(GpuResource *before, GpuResource &after) noexcept -> void {
+    D3D12_RESOURCE_BARRIER barrier;
+
+    barrier.Type                     = D3D12_RESOURCE_BARRIER_TYPE_ALIASING;
+    barrier.Flags                    = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+    barrier.Aliasing.pResourceBefore = (before == nullptr) ? nullptr : before->resource.Get();
+    barrier.Aliasing.pResourceAfter  = after.resource.Get();
+
+    QueueBarrier(barrier);
+}
+
+auto YaGE::CommandBuffer::UnorderedAccessBarrier(GpuResource &resource) noexcept -> void {
+    QueueUnorderedAccessBarrier(resource.resource.Get());
+}
+
+auto YaGE::CommandBuffer::UnorderedAccessBarrier() noexcept -> void {
+    QueueUnorderedAccessBarrier(nullptr);
+}
+
+auto YaGE::CommandBuffer::DiscardResource(GpuResource &resource) noexcept -> void {
+    FlushResourceBarriers();
+    commandList->DiscardResource(resource.resource.Get(), nullptr);
+    resource.isUninitialized = false;
+}
+
+auto YaGE::CommandBuffer::InitializePlacedResource(GpuResource &resource) noexcept -> void {
+    const D3D12_RESOURCE_DESC   desc  = resource.resource->GetDesc();
+    const D3D12_RESOURCE_STATES state = (desc.Flags & D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL)
+                                            ? D3D12_RESOURCE_STATE_DEPTH_WRITE
+                                            : D3D12_RESOURCE_STATE_RENDER_TARGET;
+
+    // Clear the flag first so that the transition below does not initialize this resource again.
+    resource.isUninitialized = false;
+    Transition(resource, state);
+    DiscardResource(resource);
+}
+
+auto YaGE::CommandBuffer::TrackCopyAccess(GpuResource &resource) noexcept -> void {
+    // Resources in upload and readback heaps never leave their initial states.
+    D3D12_HEAP_PROPERTIES heapProperties{};
+    if (SUCCEEDED(resource.resource->GetHeapProperties(&heapProperties, nullptr)) &&
+        (heapProperties.Type == D3D12_HEAP_TYPE_UPLOAD || heapProperties.Type == D3D12_HEAP_TYPE_READBACK))
+        return;
+
+#ifndef NDEBUG
+    // Copy queue could only promote resources from common state. Resources in other states must be transitioned to
+    // common state on their last queue before being used in copy command buffers.
+    const D3D12_RESOURCE_STATES copyStates = D3D12_RESOURCE_STATE_COPY_SOURCE | D3D12_RESOURCE_STATE_COPY_DEST;
+    assert((resource.usageState & ~copyStates) == 0);
+    for (const D3D12_RESOURCE_STATES state : resource.subresourceStates)
+        assert((state & ~copyStates) == 0);
+#endif
+
+    resource.usageState = D3D12_RESOURCE_STATE_COMMON;
+    resource.subresourceStates.clear();
+}
+
+auto YaGE::CommandBuffer::QueueSplitTransition(GpuResource                 &resource,
+                                               D3D12_RESOURCE_STATES        newState,
+                                               D3D12_RESOURCE_BARRIER_FLAGS flags) noexcept -> void {
+    assert(IsResourceDeclared(resource));
+    if (commandListType == D3D12_COMMAND_LIST_TYPE_COPY || !stateTracking)
+        return;
+
+    if (resource.isUninitialized && commandListType == D3D12_COMMAND_LIST_TYPE_DIRECT)
+        InitializePlacedResource(resource);
+
+    ID3D12Resource *const d3d12Resource = resource.resource.Get();
+
+    if (resource.subresourceStates.empty()) {
+        if (resource.usageState != newState)
+            QueueTransition(d3d12Resource, D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES, resource.usageState, newState,
+                            flags);
+        return;
+    }
+
+    // Begin and end barriers must match, so subresources are always transitioned one by one here.
+    const uint32_t count = static_cast<uint32_t>(resource.subresourceStates.size());
+    for (uint32_t i = 0; i < count; ++i) {
+        if (resource.subresourceStates[i] != newState)
+            QueueTransition(d3d12Resource, i, resource.subresourceStates[i], newState, flags);
+    }
+}
+
+YAGE_NODISCARD auto YaGE::CommandBuffer::IsResourceDeclared(const GpuResource &resource) const noexcept -> bool {
+    // Temp buffer pages are owned by command buffers and could not be declared by render graph passes.
+    if (declaredResources == nullptr || dynamic_cast<const TempBufferPage *>(&resource) != nullptr)
+        return true;
+    return std::find(declaredResources->begin(), declaredResources->end(), &resource) != declaredResources->end();
+}
+
+auto YaGE::CommandBuffer::RequireState(GpuResource &resource, D3D12_RESOURCE_STATES state) noexcept -> void {
+    if (commandListType == D3D12_COMMAND_LIST_TYPE_COPY) {
+        TrackCopyAccess(resource);
+        return;
+    }
 
-    if (!(src.State() & D3D12_RESOURCE_STATE_COPY_SOURCE)) {
-        barriers[barrierCount].Type                   = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-        barriers[barrierCount].Flags                  = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-        barriers[barrierCount].Transition.pResource   = src.resource.Get();
-        barriers[barrierCount].Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-        barriers[barrierCount].Transition.StateBefore = src.State();
-        barriers[barrierCount].Transition.StateAfter  = D3D12_RESOURCE_STATE_COPY_SOURCE;
+    if (resource.subresourceStates.empty() && (resource.usageState & state) == state)
+        return;
+    Transition(resource, state);
+}
 
-        barrierCount += 1;
-        src.usageState = D3D12_RESOURCE_STATE_COPY_SOURCE;
+auto YaGE::CommandBuffer::RequireState(GpuResource          &resource,
+                                       uint32_t              subresource,
+                                       D3D12_RESOURCE_STATES state) noexcept -> void {
+    if (commandListType == D3D12_COMMAND_LIST_TYPE_COPY) {
+        TrackCopyAccess(resource);
+        return;
     }
 
-    if (!(dest.State() & D3D12_RESOURCE_STATE_COPY_DEST)) {
-        barriers[barrierCount].Type                   = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-        barriers[barrierCount].Flags                  = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-        barriers[barrierCount].Transition.pResource   = dest.resource.Get();
-        barriers[barrierCount].Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-        barriers[barrierCount].Transition.StateBefore = dest.State();
-        barriers[barrierCount].Transition.StateAfter  = D3D12_RESOURCE_STATE_COPY_DEST;
+    if ((resource.SubresourceState(subresource) & state) == state)
+        return;
+    Transition(resource, subresource, state);
+}
+
+auto YaGE::CommandBuffer::QueueTransition(ID3D12Resource              *resource,
+                                          uint32_t                     subresource,
+                                          D3D12_RESOURCE_STATES        stateBefore,
+                                          D3D12_RESOURCE_STATES        stateAfter,
+                                          D3D12_RESOURCE_BARRIER_FLAGS flags) noexcept -> void {
+    // Find the last pending barrier of the same resource. Barriers before it could not be merged without reordering.
+    for (uint32_t i = (flags == D3D12_RESOURCE_BARRIER_FLAG_NONE) ? pendingBarrierCount : 0; i > 0; --i) {
+        D3D12_RESOURCE_BARRIER &barrier = pendingBarriers[i - 1];
+
+        // Transitions must not be moved across aliasing barriers of the same resource.
+        if (barrier.Type == D3D12_RESOURCE_BARRIER_TYPE_ALIASING &&
+            (barrier.Aliasing.pResourceBefore == resource || barrier.Aliasing.pResourceAfter == resource))
+            break;
+
+        // Transitions must not be moved across unordered access barriers, which require the resource to stay in
+        // unordered access state.
+        if (barrier.Type == D3D12_RESOURCE_BARRIER_TYPE_UAV &&
+            (barrier.UAV.pResource == nullptr || barrier.UAV.pResource == resource))
+            break;
+
+        if (barrier.Type != D3D12_RESOURCE_BARRIER_TYPE_TRANSITION || barrier.Transition.pResource != resource)
+            continue;
+
+        if (barrier.Flags != D3D12_RESOURCE_BARRIER_FLAG_NONE || barrier.Transition.Subresource != subresource)
+            break;
+
+        assert(barrier.Transition.StateAfter == stateBefore);
+        barrier.Transition.StateAfter = stateAfter;
+
+        // The pending transition is cancelled out.
+        if (barrier.Transition.StateBefore == stateAfter) {
+            for (uint32_t j = i; j < pendingBarrierCount; ++j)
+                pendingBarriers[j - 1] = pendingBarriers[j];
+            pendingBarrierCount -= 1;
+
+            // A transition pair from and back to unordered access also ordered unordered access before and after it.
+            // Keep that with an unordered access barrier.
+            if (stateAfter == D3D12_RESOURCE_STATE_UNORDERED_ACCESS)
+                QueueUnorderedAccessBarrier(resource);
+        }
 
-        barrierCount += 1;
-        dest.usageState = D3D12_RESOURCE_STATE_COPY_DEST;
+        return;
     }
 
-    if (barrierCount)
-        commandList->ResourceBarrier(barrierCount, barriers);
+    D3D12_RESOURCE_BARRIER barrier;
+
+    barrier.Type                   = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+    barrier.Flags                  = flags;
+    barrier.Transition.pResource   = resource;
+    barrier.Transition.Subresource = subresource;
+    barrier.Transition.StateBefore = stateBefore;
+    barrier.Transition.StateAfter  = stateAfter;
+
+    QueueBarrier(barrier);
+}
+
+auto YaGE::CommandBuffer::QueueBarrier(const D3D12_RESOURCE_BARRIER &barrier) noexcept -> void {
+    if (pendingBarrierCount == MAX_PENDING_BARRIERS)
+        FlushResourceBarriers();
+
+    pendingBarriers[pendingBarrierCount++] = barrier;
+}
+
+auto YaGE::CommandBuffer::QueueUnorderedAccessBarrier(ID3D12Resource *resource) noexcept -> void {
+    // Unordered access barriers are not reordered with other barriers, so only duplicates are skipped here.
+    for (uint32_t i = 0; i < pendingBarrierCount; ++i) {
+        const D3D12_RESOURCE_BARRIER &barrier = pendingBarriers[i];
+        if (barrier.Type == D3D12_RESOURCE_BARRIER_TYPE_UAV &&
+            (barrier.UAV.pResource == nullptr || barrier.UAV.pResource == resource))
+            return;
+    }
+
+    D3D12_RESOURCE_BARRIER barrier;
+
+    barrier.Type          = D3D12_RESOURCE_BARRIER_TYPE_UAV;
+    barrier.Flags         = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+    barrier.UAV.pResource = resource;
+
+    QueueBarrier(barrier);
+}
+
+auto YaGE::CommandBuffer::Copy(GpuResource &src, GpuResource &dest) noexcept -> void {
+    // Resources used in copy queue are implicitly promoted from common state.
+    RequireState(src, D3D12_RESOURCE_STATE_COPY_SOURCE);
+    RequireState(dest, D3D12_RESOURCE_STATE_COPY_DEST);
+    FlushResourceBarriers();
+
+    commandList->CopyResource(dest.resource.Get(), src.resource.Get());
+}
+
+auto YaGE::CommandBuffer::CopyBuffer(
+    GpuResource &src, size_t srcOffset, GpuResource &dest, size_t destOffset, size_t size) noexcept -> void {
+    // Resources used in copy queue are implicitly promoted from common state.
+    RequireState(src, D3D12_RESOURCE_STATE_COPY_SOURCE);
+    RequireState(dest, D3D12_RESOURCE_STATE_COPY_DEST);
+    FlushResourceBarriers();
 
     commandList->CopyBufferRegion(dest.resource.Get(), destOffset, src.resource.Get(), srcOffset, size);
 }
@@ -705,6 +1744,71 @@ auto YaGE::CommandBuffer::CopyBuffer(const void *src, GpuResource &dest, size_t
     CopyBuffer(*allocation.resource, allocation.offset, dest, destOffset, size);
 }
 
+auto YaGE::CommandBuffer::CopyToReadback(
+    GpuResource &src, size_t srcOffset, YaGE::ReadbackBuffer &dest, size_t destOffset, size_t size) -> ReadbackHandle {
+    CopyBuffer(src, srcOffset, dest, destOffset, size);
+    TrackReadback(dest);
+    return ReadbackHandle(dest, destOffset, size, static_cast<uint32_t>(size), 1);
+}
+
+auto YaGE::CommandBuffer::CopyToReadback(PixelBuffer          &src,
+                                         uint32_t              subresource,
+                                         YaGE::ReadbackBuffer &dest,
+                                         size_t                destOffset) -> ReadbackHandle {
+    const D3D12_RESOURCE_DESC desc = src.resource->GetDesc();
+
+    D3D12_PLACED_SUBRESOURCE_FOOTPRINT layout;
+    UINT                               rowCount;
+    UINT64                             size;
+    renderDevice.Device()->GetCopyableFootprints(&desc, subresource, 1, destOffset, &layout, &rowCount, nullptr,
+                                                 &size);
+
+    if (destOffset + size > dest.Size())
+        return ReadbackHandle();
+
+    RequireState(src, subresource, D3D12_RESOURCE_STATE_COPY_SOURCE);
+    FlushResourceBarriers();
+
+    D3D12_TEXTURE_COPY_LOCATION srcLocation;
+    srcLocation.pResource        = src.resource.Get();
+    srcLocation.Type             = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+    srcLocation.SubresourceIndex = subresource;
+
+    D3D12_TEXTURE_COPY_LOCATION destLocation;
+    destLocation.pResource       = dest.resource.Get();
+    destLocation.Type            = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
+    destLocation.PlacedFootprint = layout;
+
+    commandList->CopyTextureRegion(&destLocation, 0, 0, 0, &srcLocation, nullptr);
+    TrackReadback(dest);
+
+    return ReadbackHandle(dest, destOffset, static_cast<size_t>(size), layout.Footprint.RowPitch,
+                          rowCount * layout.Footprint.Depth);
+}
+
+auto YaGE::CommandBuffer::ResolveQueryData(ID3D12QueryHeap      *queryHeap,
+                                           D3D12_QUERY_TYPE      type,
+                                           uint32_t              first,
+                                           uint32_t              count,
+                                           size_t                size,
+                                           YaGE::ReadbackBuffer &dest,
+                                           uint64_t              destOffset) -> ReadbackHandle {
+    FlushResourceBarriers();
+    commandList->ResolveQueryData(queryHeap, type, first, count, dest.resource.Get(), destOffset);
+    TrackReadback(dest);
+
+    return ReadbackHandle(dest, static_cast<size_t>(destOffset), size * count, static_cast<uint32_t>(size), count);
+}
+
+auto YaGE::CommandBuffer::TrackReadback(YaGE::ReadbackBuffer &buffer) -> void {
+    if (buffer.syncPoint != YaGE::ReadbackBuffer::PENDING_SYNC_POINT) {
+        buffer.syncPoint = YaGE::ReadbackBuffer::PENDING_SYNC_POINT;
+        pendingReadbacks.push_back(&buffer);
+    } else if (std::find(pendingReadbacks.begin(), pendingReadbacks.end(), &buffer) == pendingReadbacks.end()) {
+        pendingReadbacks.push_back(&buffer);
+    }
+}
+
 auto YaGE::CommandBuffer::CopyTexture(uint32_t     width,
                                       uint32_t     height,
                                       DXGI_FORMAT  srcFormat,
@@ -718,8 +1822,7 @@ auto YaGE::CommandBuffer::CopyTexture(uint32_t     width,
 
     // Align up row pitch.
     const uint32_t       rowPitch  = (srcRowPitch + 255) & ~uint32_t(255);
-    const size_t         allocSize = (size_t(height) * rowPitch + 511) & ~size_t(511);
-    TempBufferAllocation allocation(tempBufferAllocator.AllocateUploadBuffer(allocSize));
+    TempBufferAllocation allocation(AllocateTextureUploadBuffer(size_t(height) * rowPitch));
 
     { // Copy data to temp upload buffer.
         uint8_t       *buffer = static_cast<uint8_t *>(allocation.data);
@@ -731,9 +1834,414 @@ auto YaGE::CommandBuffer::CopyTexture(uint32_t     width,
         }
     }
 
-    // Transition resource state if necessary.
-    if (!(dest.State() & D3D12_RESOURCE_STATE_COPY_DEST))
-        this->Transition(dest, D3D12_RESOURCE_STATE_COPY_DEST);
+    CopyTexture(allocation, width, height, srcFormat, rowPitch, dest, mipLevel);
+}
+
+auto YaGE::CommandBuffer::CopyTexture(const ImageDecoder &image, PixelBuffer &dest, uint32_t mipLevel) -> void {
+    // No such mipmap level. Do nothing.
+    if (mipLevel >= dest.MipLevels())
+        return;
+
+    const uint32_t rowPitch = static_cast<uint32_t>(
+        (image.RowPitch() + D3D12_TEXTURE_DATA_PITCH_ALIGNMENT - 1) & ~size_t(D3D12_TEXTURE_DATA_PITCH_ALIGNMENT - 1));
+    TempBufferAllocation allocation(AllocateTextureUploadBuffer(size_t(image.Height()) * rowPitch));
+
+    // Decode pixels directly into the mapped upload buffer.
+    image.CopyPixels(allocation.data, rowPitch, allocation.size);
+    CopyTexture(allocation, image.Width(), image.Height(), image.PixelFormat(), rowPitch, dest, mipLevel);
+}
+
+auto YaGE::CommandBuffer::CopyTexture(const void *src, size_t size, PixelBuffer &dest) -> void {
+    const D3D12_RESOURCE_DESC desc  = dest.resource->GetDesc();
+    const uint32_t            count = dest.MipLevels() * dest.ArraySize();
+
+    LinearArena &arena = FrameArena();
+    ArenaScope   scope(arena);
+
+    D3D12_PLACED_SUBRESOURCE_FOOTPRINT *layouts   = arena.AllocateArray<D3D12_PLACED_SUBRESOURCE_FOOTPRINT>(count);
+    UINT64                              totalSize = 0;
+
+    renderDevice.Device()->GetCopyableFootprints(&desc, 0, count, 0, layouts, nullptr, nullptr, &totalSize);
+    if (totalSize != size)
+        throw RenderAPIException(E_INVALIDARG, u"Pre-baked texture data does not match the destination texture.");
+
+    // Source data is already in placed footprint layout. Copy it as a whole.
+    TempBufferAllocation allocation(AllocateTextureUploadBuffer(size));
+    memcpy(allocation.data, src, size);
+
+    RequireState(dest, D3D12_RESOURCE_STATE_COPY_DEST);
+    FlushResourceBarriers();
+
+    for (uint32_t i = 0; i < count; ++i) {
+        D3D12_TEXTURE_COPY_LOCATION srcLocation;
+        srcLocation.pResource              = allocation.resource->resource.Get();
+        srcLocation.Type                   = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
+        srcLocation.PlacedFootprint        = layouts[i];
+        srcLocation.PlacedFootprint.Offset = allocation.offset + layouts[i].Offset;
+
+        D3D12_TEXTURE_COPY_LOCATION destLocation;
+        destLocation.pResource        = dest.resource.Get();
+        destLocation.Type             = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+        destLocation.SubresourceIndex = i;
+
+        commandList->CopyTextureRegion(&destLocation, 0, 0, 0, &srcLocation, nullptr);
+    }
+}
+
+auto YaGE::CommandBuffer::CopySubresources(PixelBuffer                  &dest,
+                                           uint32_t                      firstSubresource,
+                                           uint32_t                      count,
+                                           const D3D12_SUBRESOURCE_DATA *data) -> void {
+    if (count == 0)
+        return;
+
+    // Query placed footprints of the subresources.
+    const D3D12_RESOURCE_DESC desc = dest.resource->GetDesc();
+
+    LinearArena &arena = FrameArena();
+    ArenaScope   scope(arena);
+
+    D3D12_PLACED_SUBRESOURCE_FOOTPRINT *layouts   = arena.AllocateArray<D3D12_PLACED_SUBRESOURCE_FOOTPRINT>(count);
+    UINT                               *rowCounts = arena.AllocateArray<UINT>(count);
+    UINT64                             *rowSizes  = arena.AllocateArray<UINT64>(count);
+    UINT64                              totalSize = 0;
+
+    renderDevice.Device()->GetCopyableFootprints(&desc, firstSubresource, count, 0, layouts, rowCounts, rowSizes,
+                                                 &totalSize);
+
+    TempBufferAllocation allocation(AllocateTextureUploadBuffer(static_cast<size_t>(totalSize)));
+
+    // Copy data to temp upload buffer.
+    for (uint32_t i = 0; i < count; ++i) {
+        const D3D12_SUBRESOURCE_FOOTPRINT &footprint      = layouts[i].Footprint;
+        const size_t                       rowSize        = static_cast<size_t>(rowSizes[i]);
+        const size_t                       destSlicePitch = size_t(footprint.RowPitch) * rowCounts[i];
+
+        uint8_t *const destBase = static_cast<uint8_t *>(allocation.data) + layouts[i].Offset;
+        const auto    *srcBase  = static_cast<const uint8_t *>(data[i].pData);
+
+        for (uint32_t z = 0; z < footprint.Depth; ++z) {
+            uint8_t       *destPtr = destBase + z * destSlicePitch;
+            const uint8_t *srcPtr  = srcBase + z * size_t(data[i].SlicePitch);
+            for (uint32_t row = 0; row < rowCounts[i]; ++row) {
+                memcpy(destPtr, srcPtr, rowSize);
+                destPtr += footprint.RowPitch;
+                srcPtr += data[i].RowPitch;
+            }
+        }
+    }
+
+    // Only the copied subresources are transitioned.
+    if (firstSubresource == 0 && count == dest.MipLevels() * dest.ArraySize()) {
+        RequireState(dest, D3D12_RESOURCE_STATE_COPY_DEST);
+    } else {
+        for (uint32_t i = 0; i < count; ++i)
+            RequireState(dest, firstSubresource + i, D3D12_RESOURCE_STATE_COPY_DEST);
+    }
+
+    FlushResourceBarriers();
+
+    for (uint32_t i = 0; i < count; ++i) {
+        D3D12_TEXTURE_COPY_LOCATION srcLocation;
+        srcLocation.pResource              = allocation.resource->resource.Get();
+        srcLocation.Type                   = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
+        srcLocation.PlacedFootprint        = layouts[i];
+        srcLocation.PlacedFootprint.Offset = allocation.offset + layouts[i].Offset;
+
+        D3D12_TEXTURE_COPY_LOCATION destLocation;
+        destLocation.pResource        = dest.resource.Get();
+        destLocation.Type             = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+        destLocation.SubresourceIndex = firstSubresource + i;
+
+        commandList->CopyTextureRegion(&destLocation, 0, 0, 0, &srcLocation, nullptr);
+    }
+}
+
+auto YaGE::CommandBuffer::UploadBuffers(uint32_t count, const BufferUploadRegion *regions) -> void {
+    if (count == 0)
+        return;
+
+    // Pack all regions into one temp upload buffer. Offsets are kept 16-byte aligned for fast memory copy.
+    constexpr const size_t ALIGNMENT = 16;
+
+    size_t totalSize = 0;
+    for (uint32_t i = 0; i < count; ++i)
+        totalSize = ((totalSize + ALIGNMENT - 1) & ~(ALIGNMENT - 1)) + regions[i].size;
+
+    TempBufferAllocation allocation(tempBufferAllocator.AllocateUploadBuffer(totalSize));
+
+    size_t offset = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        offset = (offset + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+        memcpy(static_cast<uint8_t *>(allocation.data) + offset, regions[i].data, regions[i].size);
+        offset += regions[i].size;
+    }
+
+    // Issue all barriers at once.
+    RequireState(*allocation.resource, D3D12_RESOURCE_STATE_COPY_SOURCE);
+    for (uint32_t i = 0; i < count; ++i)
+        RequireState(*regions[i].dest, D3D12_RESOURCE_STATE_COPY_DEST);
+    FlushResourceBarriers();
+
+    ID3D12Resource *const srcResource = allocation.resource->resource.Get();
+
+    offset = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        const BufferUploadRegion &region = regions[i];
+
+        offset = (offset + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+        commandList->CopyBufferRegion(region.dest->resource.Get(), region.destOffset, srcResource,
+                                      allocation.offset + offset, region.size);
+        offset += region.size;
+    }
+}
+
+auto YaGE::CommandBuffer::UploadSubresources(uint32_t count, const SubresourceUploadRegion *regions) -> void {
+    if (count == 0)
+        return;
+
+    // Query placed footprints of all subresources. Each subresource is placed with texture placement alignment.
+    constexpr const UINT64 ALIGNMENT = D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT;
+
+    LinearArena &arena = FrameArena();
+    ArenaScope   scope(arena);
+
+    D3D12_PLACED_SUBRESOURCE_FOOTPRINT *layouts   = arena.AllocateArray<D3D12_PLACED_SUBRESOURCE_FOOTPRINT>(count);
+    UINT                               *rowCounts = arena.AllocateArray<UINT>(count);
+    UINT64                             *rowSizes  = arena.AllocateArray<UINT64>(count);
+    UINT64                              totalSize = 0;
+
+    ID3D12Device1 *const device = renderDevice.Device();
+    for (uint32_t i = 0; i < count; ++i) {
+        const D3D12_RESOURCE_DESC desc   = regions[i].dest->resource->GetDesc();
+        const UINT64              offset = (totalSize + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+
+        UINT64 size = 0;
+        device->GetCopyableFootprints(&desc, regions[i].subresource, 1, offset, &layouts[i], &rowCounts[i],
+                                      &rowSizes[i], &size);
+        totalSize = offset + size;
+    }
+
+    TempBufferAllocation allocation(AllocateTextureUploadBuffer(static_cast<size_t>(totalSize)));
+
+    // Copy data to temp upload buffer.
+    for (uint32_t i = 0; i < count; ++i) {
+        const D3D12_SUBRESOURCE_FOOTPRINT &footprint      = layouts[i].Footprint;
+        const D3D12_SUBRESOURCE_DATA      &data           = regions[i].data;
+        const size_t                       rowSize        = static_cast<size_t>(rowSizes[i]);
+        const size_t                       destSlicePitch = size_t(footprint.RowPitch) * rowCounts[i];
+
+        uint8_t *const destBase = static_cast<uint8_t *>(allocation.data) + layouts[i].Offset;
+        const auto    *srcBase  = static_cast<const uint8_t *>(data.pData);
+
+        for (uint32_t z = 0; z < footprint.Depth; ++z) {
+            uint8_t       *destPtr = destBase + z * destSlicePitch;
+            const uint8_t *srcPtr  = srcBase + z * size_t(data.SlicePitch);
+            for (uint32_t row = 0; row < rowCounts[i]; ++row) {
+                memcpy(destPtr, srcPtr, rowSize);
+                destPtr += footprint.RowPitch;
+                srcPtr += data.RowPitch;
+            }
+        }
+    }
+
+    // Issue all barriers at once.
+    for (uint32_t i = 0; i < count; ++i)
+        RequireState(*regions[i].dest, regions[i].subresource, D3D12_RESOURCE_STATE_COPY_DEST);
+    FlushResourceBarriers();
+
+    for (uint32_t i = 0; i < count; ++i) {
+        D3D12_TEXTURE_COPY_LOCATION srcLocation;
+        srcLocation.pResource              = allocation.resource->resource.Get();
+        srcLocation.Type                   = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
+        srcLocation.PlacedFootprint        = layouts[i];
+        srcLocation.PlacedFootprint.Offset = allocation.offset + layouts[i].Offset;
+
+        D3D12_TEXTURE_COPY_LOCATION destLocation;
+        destLocation.pResource        = regions[i].dest->resource.Get();
+        destLocation.Type             = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+        destLocation.SubresourceIndex = regions[i].subresource;
+
+        commandList->CopyTextureRegion(&destLocation, 0, 0, 0, &srcLocation, nullptr);
+    }
+}
+
+auto YaGE::CommandBuffer::GenerateMips(PixelBuffer &buffer) -> bool {
+    if (commandListType == D3D12_COMMAND_LIST_TYPE_COPY || buffer.SampleCount() > 1 || buffer.MipLevels() <= 1)
+        return false;
+
+    const D3D12_RESOURCE_DESC desc = buffer.resource->GetDesc();
+    if ((desc.Flags & D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS) == 0)
+        return false;
+
+    // sRGB resources must be typeless so that mip levels could be written via UNORM unordered access views.
+    const DXGI_FORMAT format    = buffer.PixelFormat();
+    const DXGI_FORMAT uavFormat = MipGenerator::UnorderedAccessFormat(format);
+    const bool        isSRGB    = (MipGenerator::TypelessFormat(format) != format);
+    if (desc.Format != uavFormat && desc.Format != MipGenerator::TypelessFormat(format))
+        return false;
+
+    if (!renderDevice.SupportUnorderedAccess(uavFormat))
+        return false;
+
+    MipGenerator &generator = MipGenerator::Singleton();
+
+    // Temporary descriptors are copied to the dynamic descriptor heap on commit, so they are reused by all dispatches.
+    constexpr const uint32_t MAX_MIPS = MipGenerator::MAX_MIPS_PER_DISPATCH;
+
+    CpuDescriptorHandle srv = renderDevice.AllocateShaderResourceView();
+    CpuDescriptorHandle uavs[MAX_MIPS];
+    try {
+        for (auto &uav : uavs)
+            uav = renderDevice.AllocateUnorderedAccessView();
+    } catch (...) {
+        renderDevice.FreeShaderResourceView(srv);
+        for (auto &uav : uavs) {
+            if (!uav.IsNull())
+                renderDevice.FreeUnorderedAccessView(uav);
+        }
+        throw;
+    }
+
+    ID3D12Device1 *device    = renderDevice.Device();
+    const uint32_t mipLevels = buffer.MipLevels();
+    const uint32_t arraySize = buffer.ArraySize();
+
+    SetComputeRootSignature(generator.RootSignature());
+    boundPipelineState = generator.D3D12PipelineState();
+    commandList->SetPipelineState(boundPipelineState);
+
+    for (uint32_t srcMip = 0; srcMip + 1 < mipLevels;) {
+        const uint32_t srcWidth  = std::max(buffer.Width() >> srcMip, 1U);
+        const uint32_t srcHeight = std::max(buffer.Height() >> srcMip, 1U);
+        const uint32_t dstWidth  = std::max(srcWidth >> 1, 1U);
+        const uint32_t dstHeight = std::max(srcHeight >> 1, 1U);
+
+        // Each extra mip level requires the previous level to be evenly divided. Dimensions of 1 are ignored.
+        const uint32_t sizeBits = (dstWidth == 1 ? dstHeight : dstWidth) | (dstHeight == 1 ? dstWidth : dstHeight);
+        uint32_t       mipCount = 1;
+        while (mipCount < MAX_MIPS && (sizeBits & (1U << (mipCount - 1))) == 0)
+            mipCount += 1;
+        mipCount = std::min(mipCount, mipLevels - srcMip - 1);
+
+        // Bit 0 is set if width is odd and bit 1 is set if height is odd.
+        const uint32_t srcDimension = (srcWidth & 1) | ((srcHeight & 1) << 1);
+
+        { // Create shader resource view of the source mip level.
+            D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc;
+            srvDesc.Format                             = format;
+            srvDesc.ViewDimension                      = D3D12_SRV_DIMENSION_TEXTURE2DARRAY;
+            srvDesc.Shader4ComponentMapping            = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+            srvDesc.Texture2DArray.MostDetailedMip     = srcMip;
+            srvDesc.Texture2DArray.MipLevels           = 1;
+            srvDesc.Texture2DArray.FirstArraySlice     = 0;
+            srvDesc.Texture2DArray.ArraySize           = arraySize;
+            srvDesc.Texture2DArray.PlaneSlice          = 0;
+            srvDesc.Texture2DArray.ResourceMinLODClamp = 0.0f;
+
+            device->CreateShaderResourceView(buffer.resource.Get(), &srvDesc, srv);
+        }
+
+        // Create unordered access views of the destination mip levels. Unused slots are filled with null views.
+        for (uint32_t i = 0; i < MAX_MIPS; ++i) {
+            D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc;
+            uavDesc.Format                         = uavFormat;
+            uavDesc.ViewDimension                  = D3D12_UAV_DIMENSION_TEXTURE2DARRAY;
+            uavDesc.Texture2DArray.MipSlice        = (i < mipCount) ? srcMip + i + 1 : 0;
+            uavDesc.Texture2DArray.FirstArraySlice = 0;
+            uavDesc.Texture2DArray.ArraySize       = arraySize;
+            uavDesc.Texture2DArray.PlaneSlice      = 0;
+
+            device->CreateUnorderedAccessView((i < mipCount) ? buffer.resource.Get() : nullptr, nullptr, &uavDesc,
+                                              uavs[i]);
+        }
+
+        // Only the source mip level and destination mip levels of each array slice are transitioned.
+        for (uint32_t slice = 0; slice < arraySize; ++slice) {
+            const uint32_t base = slice * mipLevels;
+            RequireState(buffer, base + srcMip, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+            for (uint32_t i = 1; i <= mipCount; ++i)
+                RequireState(buffer, base + srcMip + i, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+        }
+
+        SetComputeConstant(0, 0, srcMip, mipCount, srcDimension, static_cast<uint32_t>(isSRGB),
+                           1.0f / static_cast<float>(dstWidth), 1.0f / static_cast<float>(dstHeight));
+        SetComputeDescriptor(1, 0, srv);
+        for (uint32_t i = 0; i < MAX_MIPS; ++i)
+            SetComputeDescriptor(2, i, uavs[i]);
+
+        dynamicDescriptorHeap.Commit(commandList.Get());
+        FlushResourceBarriers();
+
+        constexpr const uint32_t GROUP_SIZE = MipGenerator::GROUP_SIZE;
+        commandList->Dispatch((dstWidth + GROUP_SIZE - 1) / GROUP_SIZE, (dstHeight + GROUP_SIZE - 1) / GROUP_SIZE,
+                              arraySize);
+
+        srcMip += mipCount;
+    }
+
+    renderDevice.FreeShaderResourceView(srv);
+    for (auto &uav : uavs)
+        renderDevice.FreeUnorderedAccessView(uav);
+
+    return true;
+}
+
+auto YaGE::CommandBuffer::Upscale(ColorBuffer &source, uint32_t sourceWidth, uint32_t sourceHeight, ColorBuffer &dest)
+    -> bool {
+    if (commandListType != D3D12_COMMAND_LIST_TYPE_DIRECT || source.SampleCount() > 1)
+        return false;
+
+    Upscaler              &upscaler      = Upscaler::Singleton();
+    GraphicsPipelineState &pipelineState = upscaler.PipelineState(dest.PixelFormat());
+
+    // Sample texel centers of the source region only, so that texels outside the region never bleed in.
+    const float width  = static_cast<float>(source.Width());
+    const float height = static_cast<float>(source.Height());
+    const float scaleU = static_cast<float>(std::min(sourceWidth, source.Width())) / width;
+    const float scaleV = static_cast<float>(std::min(sourceHeight, source.Height())) / height;
+
+    RequireState(source, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+    SetRenderTarget(dest);
+
+    SetGraphicsRootSignature(upscaler.RootSignature());
+    SetPipelineState(pipelineState);
+    SetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    SetViewport(0, 0, dest.Width(), dest.Height());
+    SetScissorRect(0, 0, dest.Width(), dest.Height());
+
+    SetGraphicsConstant(0, 0, scaleU, scaleV, scaleU - 0.5f / width, scaleV - 0.5f / height);
+    SetGraphicsDescriptor(1, 0, source.ShaderResourceView());
+
+    Draw(3);
+    return true;
+}
+
+auto YaGE::CommandBuffer::AllocateTextureUploadBuffer(size_t size) -> TempBufferAllocation {
+    constexpr const size_t ALIGNMENT = D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT;
+
+    // Temp upload buffers are only aligned up with 256 bytes. Allocate extra space to align up the offset.
+    TempBufferAllocation allocation(tempBufferAllocator.AllocateUploadBuffer(size + ALIGNMENT - 256));
+
+    const size_t padding = ((allocation.offset + ALIGNMENT - 1) & ~(ALIGNMENT - 1)) - allocation.offset;
+    allocation.size -= padding;
+    allocation.offset += padding;
+    allocation.data = static_cast<uint8_t *>(allocation.data) + padding;
+    allocation.gpuAddress += padding;
+
+    return allocation;
+}
+
+auto YaGE::CommandBuffer::CopyTexture(const TempBufferAllocation &allocation,
+                                      uint32_t                    width,
+                                      uint32_t                    height,
+                                      DXGI_FORMAT                 srcFormat,
+                                      uint32_t                    rowPitch,
+                                      PixelBuffer                &dest,
+                                      uint32_t                    mipLevel) noexcept -> void {
+    // Only the destination mip level is transitioned.
+    RequireState(dest, mipLevel, D3D12_RESOURCE_STATE_COPY_DEST);
+    FlushResourceBarriers();
 
     // Copy data to texture.
     D3D12_TEXTURE_COPY_LOCATION srcLocation;
@@ -755,43 +2263,15 @@ auto YaGE::CommandBuffer::CopyTexture(uint32_t     width,
 }
 
 auto YaGE::CommandBuffer::SetRenderTarget(ColorBuffer &renderTarget) noexcept -> void {
-    if (!(renderTarget.State() & D3D12_RESOURCE_STATE_RENDER_TARGET))
-        this->Transition(renderTarget, D3D12_RESOURCE_STATE_RENDER_TARGET);
+    RequireState(renderTarget, D3D12_RESOURCE_STATE_RENDER_TARGET);
 
     D3D12_CPU_DESCRIPTOR_HANDLE rtv = renderTarget.RenderTargetView();
     commandList->OMSetRenderTargets(1, &rtv, FALSE, nullptr);
 }
 
 auto YaGE::CommandBuffer::SetRenderTarget(ColorBuffer &renderTarget, DepthBuffer &depthTarget) noexcept -> void {
-    D3D12_RESOURCE_BARRIER barriers[2];
-    uint32_t               barrierCount = 0;
-
-    if (!(renderTarget.State() & D3D12_RESOURCE_STATE_RENDER_TARGET)) {
-        barriers[barrierCount].Type                   = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-        barriers[barrierCount].Flags                  = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-        barriers[barrierCount].Transition.pResource   = renderTarget.resource.Get();
-        barriers[barrierCount].Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-        barriers[barrierCount].Transition.StateBefore = renderTarget.State();
-        barriers[barrierCount].Transition.StateAfter  = D3D12_RESOURCE_STATE_RENDER_TARGET;
-
-        renderTarget.usageState = D3D12_RESOURCE_STATE_RENDER_TARGET;
-        barrierCount += 1;
-    }
-
-    if (!(depthTarget.State() & D3D12_RESOURCE_STATE_DEPTH_WRITE)) {
-        barriers[barrierCount].Type                   = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-        barriers[barrierCount].Flags                  = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-        barriers[barrierCount].Transition.pResource   = depthTarget.resource.Get();
-        barriers[barrierCount].Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-        barriers[barrierCount].Transition.StateBefore = depthTarget.State();
-        barriers[barrierCount].Transition.StateAfter  = D3D12_RESOURCE_STATE_DEPTH_WRITE;
-
-        depthTarget.usageState = D3D12_RESOURCE_STATE_DEPTH_WRITE;
-        barrierCount += 1;
-    }
-
-    if (barrierCount > 0)
-        commandList->ResourceBarrier(barrierCount, barriers);
+    RequireState(renderTarget, D3D12_RESOURCE_STATE_RENDER_TARGET);
+    RequireState(depthTarget, D3D12_RESOURCE_STATE_DEPTH_WRITE);
 
     D3D12_CPU_DESCRIPTOR_HANDLE rtv = renderTarget.RenderTargetView();
     D3D12_CPU_DESCRIPTOR_HANDLE dsv = depthTarget.DepthStencilView();
@@ -800,8 +2280,7 @@ auto YaGE::CommandBuffer::SetRenderTarget(ColorBuffer &renderTarget, DepthBuffer
 }
 
 auto YaGE::CommandBuffer::SetRenderTarget(DepthBuffer &depthTarget) noexcept -> void {
-    if (!(depthTarget.State() & D3D12_RESOURCE_STATE_DEPTH_WRITE))
-        this->Transition(depthTarget, D3D12_RESOURCE_STATE_DEPTH_WRITE);
+    RequireState(depthTarget, D3D12_RESOURCE_STATE_DEPTH_WRITE);
 
     D3D12_CPU_DESCRIPTOR_HANDLE dsv = depthTarget.DepthStencilView();
     commandList->OMSetRenderTargets(0, nullptr, FALSE, &dsv);
@@ -809,69 +2288,28 @@ auto YaGE::CommandBuffer::SetRenderTarget(DepthBuffer &depthTarget) noexcept ->
 
 auto YaGE::CommandBuffer::SetRenderTargets(uint32_t count, ColorBuffer **renderTargets) noexcept -> void {
     D3D12_CPU_DESCRIPTOR_HANDLE rtvs[8];
-    D3D12_RESOURCE_BARRIER      barriers[8];
-    uint32_t                    barrierCount = 0;
 
     for (uint32_t i = 0; i < count; ++i) {
-        if (!(renderTargets[i]->State() & D3D12_RESOURCE_STATE_RENDER_TARGET)) {
-            barriers[barrierCount].Type                   = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-            barriers[barrierCount].Flags                  = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-            barriers[barrierCount].Transition.pResource   = renderTargets[i]->resource.Get();
-            barriers[barrierCount].Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-            barriers[barrierCount].Transition.StateBefore = renderTargets[i]->State();
-            barriers[barrierCount].Transition.StateAfter  = D3D12_RESOURCE_STATE_RENDER_TARGET;
-
-            renderTargets[i]->usageState = D3D12_RESOURCE_STATE_RENDER_TARGET;
-            barrierCount += 1;
-        }
-
+        RequireState(*renderTargets[i], D3D12_RESOURCE_STATE_RENDER_TARGET);
         rtvs[i] = renderTargets[i]->RenderTargetView();
     }
 
-    if (barrierCount > 0)
-        commandList->ResourceBarrier(barrierCount, barriers);
     commandList->OMSetRenderTargets(count, rtvs, FALSE, nullptr);
 }
 
 auto YaGE::CommandBuffer::SetRenderTargets(uint32_t      count,
                                            ColorBuffer **renderTargets,
                                            DepthBuffer  &depthTarget) noexcept -> void {
-    D3D12_CPU_DESCRIPTOR_HANDLE rtvs[9];
-    D3D12_RESOURCE_BARRIER      barriers[8];
-    uint32_t                    barrierCount = 0;
+    D3D12_CPU_DESCRIPTOR_HANDLE rtvs[8];
 
     for (uint32_t i = 0; i < count; ++i) {
-        if (!(renderTargets[i]->State() & D3D12_RESOURCE_STATE_RENDER_TARGET)) {
-            barriers[barrierCount].Type                   = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-            barriers[barrierCount].Flags                  = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-            barriers[barrierCount].Transition.pResource   = renderTargets[i]->resource.Get();
-            barriers[barrierCount].Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-            barriers[barrierCount].Transition.StateBefore = renderTargets[i]->State();
-            barriers[barrierCount].Transition.StateAfter  = D3D12_RESOURCE_STATE_RENDER_TARGET;
-
-            renderTargets[i]->usageState = D3D12_RESOURCE_STATE_RENDER_TARGET;
-            barrierCount += 1;
-        }
-
+        RequireState(*renderTargets[i], D3D12_RESOURCE_STATE_RENDER_TARGET);
         rtvs[i] = renderTargets[i]->RenderTargetView();
     }
 
-    if (!(depthTarget.State() & D3D12_RESOURCE_STATE_DEPTH_WRITE)) {
-        barriers[barrierCount].Type                   = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-        barriers[barrierCount].Flags                  = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-        barriers[barrierCount].Transition.pResource   = depthTarget.resource.Get();
-        barriers[barrierCount].Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-        barriers[barrierCount].Transition.StateBefore = depthTarget.State();
-        barriers[barrierCount].Transition.StateAfter  = D3D12_RESOURCE_STATE_DEPTH_WRITE;
-
-        depthTarget.usageState = D3D12_RESOURCE_STATE_DEPTH_WRITE;
-        barrierCount += 1;
-    }
+    RequireState(depthTarget, D3D12_RESOURCE_STATE_DEPTH_WRITE);
 
     D3D12_CPU_DESCRIPTOR_HANDLE dsv = depthTarget.DepthStencilView();
-
-    if (barrierCount > 0)
-        commandList->ResourceBarrier(barrierCount, barriers);
     commandList->OMSetRenderTargets(count, rtvs, FALSE, &dsv);
 }
 
@@ -879,6 +2317,13 @@ auto YaGE::CommandBuffer::SetGraphicsRootSignature(RootSignature &rootSig) noexc
     if (graphicsRootSignature == &rootSig)
         return;
 
+    // Identical root signatures share the same D3D12 object. Bound descriptor tables are still valid in this case.
+    if (graphicsRootSignature != nullptr &&
+        graphicsRootSignature->D3D12RootSignature() == rootSig.D3D12RootSignature()) {
+        graphicsRootSignature = &rootSig;
+        return;
+    }
+
     graphicsRootSignature = &rootSig;
     dynamicDescriptorHeap.ParseGraphicsRootSignature(rootSig);
     dynamicSamplerHeap.ParseGraphicsRootSignature(rootSig);
@@ -889,6 +2334,12 @@ auto YaGE::CommandBuffer::SetComputeRootSignature(RootSignature &rootSig) noexce
     if (computeRootSignature == &rootSig)
         return;
 
+    // Identical root signatures share the same D3D12 object. Bound descriptor tables are still valid in this case.
+    if (computeRootSignature != nullptr && computeRootSignature->D3D12RootSignature() == rootSig.D3D12RootSignature()) {
+        computeRootSignature = &rootSig;
+        return;
+    }
+
     computeRootSignature = &rootSig;
     dynamicDescriptorHeap.ParseComputeRootSignature(rootSig);
     dynamicSamplerHeap.ParseComputeRootSignature(rootSig);
@@ -923,6 +2374,18 @@ auto YaGE::CommandBuffer::SetComputeConstantBuffer(uint32_t rootParam, uint32_t
     dynamicDescriptorHeap.BindComputeDescriptor(rootParam, offset, desc);
 }
 
+auto YaGE::CommandBuffer::SetGraphicsStructuredBuffer(uint32_t rootParam, const void *data, size_t size) -> void {
+    TempBufferAllocation allocation(tempBufferAllocator.AllocateUploadBuffer(size));
+    memcpy(allocation.data, data, size);
+    commandList->SetGraphicsRootShaderResourceView(rootParam, allocation.gpuAddress);
+}
+
+auto YaGE::CommandBuffer::SetComputeStructuredBuffer(uint32_t rootParam, const void *data, size_t size) -> void {
+    TempBufferAllocation allocation(tempBufferAllocator.AllocateUploadBuffer(size));
+    memcpy(allocation.data, data, size);
+    commandList->SetComputeRootShaderResourceView(rootParam, allocation.gpuAddress);
+}
+
 auto YaGE::CommandBuffer::SetVertexBuffer(uint32_t slot, const void *data, uint32_t vertexCount, uint32_t stride)
     -> void {
     const size_t         size = size_t(vertexCount) * stride;
@@ -934,7 +2397,7 @@ auto YaGE::CommandBuffer::SetVertexBuffer(uint32_t slot, const void *data, uint3
         /* SizeInBytes    = */ static_cast<UINT>(size),
         /* StrideInBytes  = */ stride,
     };
-    commandList->IASetVertexBuffers(slot, 1, &vbv);
+    BindVertexBuffer(slot, vbv);
 }
 
 auto YaGE::CommandBuffer::SetIndexBuffer(const void *data, uint32_t indexCount, bool isUInt16) -> void {
@@ -948,5 +2411,5 @@ auto YaGE::CommandBuffer::SetIndexBuffer(const void *data, uint32_t indexCount,
         /* Format         = */ isUInt16 ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT,
     };
 
-    commandList->IASetIndexBuffer(&ibv);
+    BindIndexBuffer(ibv);
 }
@@ -1,15 +1,53 @@
 #pragma once
 
+#include "../Core/Profiler.h"
 #include "ColorBuffer.h"
 #include "DepthBuffer.h"
 #include "DynamicDescriptorHeap.h"
 #include "GpuBuffer.h"
 #include "PipelineState.h"
+#include "ReadbackBuffer.h"
 #include "RenderDevice.h"
 
 namespace YaGE {
 
+class AccelerationStructure;
+class CommandSignature;
+class ImageDecoder;
+class RayTracingPipelineState;
+class ShaderTable;
+
+struct AccelerationStructureBuild;
+
+struct BufferUploadRegion {
+    /// @brief  Source data in system memory to be uploaded.
+    const void *data;
+
+    /// @brief  Destination buffer to be copied to.
+    GpuResource *dest;
+
+    /// @brief  Offset in byte from start of @p dest to start of the copy.
+    size_t destOffset;
+
+    /// @brief  Size in byte of data to be uploaded.
+    size_t size;
+};
+
+struct SubresourceUploadRegion {
+    /// @brief  Destination texture to be copied to.
+    PixelBuffer *dest;
+
+    /// @brief  Index of the destination subresource.
+    uint32_t subresource;
+
+    /// @brief  Source data of the subresource. @p RowPitch and @p SlicePitch are row and depth pitch of the source data.
+    D3D12_SUBRESOURCE_DATA data;
+};
+
 class CommandBuffer {
+    friend class RenderDevice;
+    friend class RenderGraph;
+
 private:
     struct TempBufferAllocation {
         /// @brief  The GPU resource that this allocation belongs to.
@@ -32,7 +70,9 @@ private:
     public:
         /// @brief
         ///   Create a temp buffer allocator.
-        TempBufferAllocator() noexcept;
+        ///
+        /// @param queueType    Type of the command queue that the temp buffers are used in.
+        explicit TempBufferAllocator(D3D12_COMMAND_LIST_TYPE queueType) noexcept;
 
         /// @brief
         ///   Copy constructor of TempBufferAllocator is disabled.
@@ -49,7 +89,9 @@ private:
         /// @brief
         ///   Allocate a temporary upload buffer.
         /// @remarks
-        ///   It is guaranteed that the allocation is aligned up with 256 bytes.
+        ///   It is guaranteed that the allocation is aligned up with 256 bytes. Small allocations are sub-allocated from
+        ///   the upload ring of the command queue. Temp buffer pages are used if the upload ring is full. Allocations
+        ///   that are larger than default page size are allocated from pooled large pages.
         ///
         /// @param size     Expected size in byte of the temp buffer to be allocated.
         ///
@@ -75,6 +117,24 @@ private:
         auto CleanUp(uint64_t syncPoint) noexcept -> void;
 
     private:
+        /// @brief  Type of the command queue that the temp buffers are used in.
+        const D3D12_COMMAND_LIST_TYPE queueType;
+
+        /// @brief  Upload ring of the command queue. This is type-erased pointer.
+        void *uploadRing;
+
+        /// @brief  Offset from start of the upload ring to current ring chunk.
+        size_t ringChunkOffset;
+
+        /// @brief  Size in byte of current ring chunk.
+        size_t ringChunkSize;
+
+        /// @brief  Offset from start of current ring chunk to the first free byte.
+        size_t ringChunkUsed;
+
+        /// @brief  ID of ring chunks that are acquired since last clean up.
+        std::vector<uint64_t> ringChunks;
+
         /// @brief  Current temp upload buffer page. This is type-erased pointer.
         void *uploadPage;
 
@@ -96,12 +156,24 @@ private:
 
 public:
     /// @brief
-    ///   Create a new CommandBuffer.
+    ///   Create a new direct CommandBuffer.
     ///
     /// @throw RenderAPIException
     ///   Thrown if failed to create new command buffer or failed to acquire new command allocator.
     YAGE_API CommandBuffer();
 
+    /// @brief
+    ///   Create a new CommandBuffer for the specified command queue.
+    /// @remarks
+    ///   Copy command buffers are submitted to the copy command queue of RenderDevice and only copy commands could be recorded. Resources used in copy command buffers should be in common state. They are implicitly promoted to copy states and decay back to common state once the submission is finished, so no resource barrier is recorded for copy command buffers and tracked states of these resources are reset to common state. Other command buffers must wait for the copy submission before using these resources.
+    ///   Compute command buffers are submitted to the compute command queue of RenderDevice. Only copy and compute commands could be recorded, and resources could not be transitioned to or from graphics-only states such as render target or depth write.
+    ///
+    /// @param type     Type of the command buffer. Only direct, compute and copy command buffers are supported.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to create new command buffer or failed to acquire new command allocator.
+    YAGE_API explicit CommandBuffer(D3D12_COMMAND_LIST_TYPE type);
+
     /// @brief
     ///   Destroy this CommandBuffer.
     YAGE_API ~CommandBuffer() noexcept;
@@ -109,7 +181,8 @@ public:
     /// @brief
     ///   Submit this command buffer to start executing on GPU.
     /// @remarks
-    ///   This method will automatically reset current command buffer once submission is done.
+    ///   This method will automatically reset current command buffer once submission is done. Use @p RenderDevice::Submit() to submit multiple command buffers at once.
+    ///   Different command buffers could be recorded and submitted concurrently from different threads, but a single command buffer must not be used by multiple threads at the same time.
     ///
     /// @return uint64_t
     ///   Return a sync point that indicates when this command buffer will finish executing on GPU.
@@ -128,13 +201,126 @@ public:
     ///   Wait for last submission finishes executing on GPU.
     auto WaitForComplete() const noexcept -> void { renderDevice.Sync(lastSubmitSyncPoint); }
 
+    /// @brief
+    ///   Make the next submission of this command buffer wait for the specified sync point on GPU side. This method does not block current thread.
+    /// @remarks
+    ///   The wait is inserted into the command queue right before this command buffer is submitted. This could be used to wait for uploads on the copy command queue without calling @p RenderDevice::Sync().
+    ///
+    /// @param syncPoint    The sync point to be waited for. This could be a sync point of any command queue.
+    auto WaitForSyncPoint(uint64_t syncPoint) -> void { pendingWaitSyncPoints.push_back(syncPoint); }
+
+    /// @brief
+    ///   Get type of this command buffer.
+    ///
+    /// @return D3D12_COMMAND_LIST_TYPE
+    ///   Return type of this command buffer.
+    YAGE_NODISCARD auto Type() const noexcept -> D3D12_COMMAND_LIST_TYPE { return commandListType; }
+
+    /// @brief
+    ///   Set size of the persistent mapped upload ring of each command queue. Temporary upload buffers are sub-allocated from the upload ring of the command queue that the command buffer is submitted to.
+    /// @remarks
+    ///   Upload rings are created on first use, so this method only affects upload rings that have not been created yet and should be called before recording any command buffer. The default size is 32 MiB. Setting size to 0 disables upload rings.
+    ///
+    /// @param size     Size in byte of each upload ring. This will be aligned up with 64 KiB.
+    YAGE_API static auto SetUploadRingSize(size_t size) noexcept -> void;
+
     /// @brief
     ///   Transition the specified resource to new state.
+    /// @remarks
+    ///   Resource barriers are not recorded immediately. They are batched and flushed before the next draw, clear or copy command, or before this command buffer is submitted. Transitions of the same resource that are queued but not yet flushed are merged, and a transition that restores the original state is removed.
     ///
     /// @param[in] resource The GPU resource to be transitioned.
     /// @param     newState The new state of the resource.
     YAGE_API auto Transition(GpuResource &resource, D3D12_RESOURCE_STATES newState) noexcept -> void;
 
+    /// @brief
+    ///   Transition the specified subresource to new state. States of other subresources are not affected.
+    /// @remarks
+    ///   Subresource index is calculated as @p mipLevel + @p arraySlice * @p mipLevels. The whole resource is transitioned if @p subresource is out of range.
+    ///
+    /// @param[in] resource     The GPU resource to be transitioned.
+    /// @param     subresource  Index of the subresource to be transitioned.
+    /// @param     newState     The new state of the subresource.
+    YAGE_API auto Transition(GpuResource &resource, uint32_t subresource, D3D12_RESOURCE_STATES newState) noexcept
+        -> void;
+
+    /// @brief
+    ///   Begin a split transition of the specified resource. The resource must not be used until @p EndTransition() is called with the same state.
+    /// @remarks
+    ///   Split barriers allow GPU to overlap the transition, for example flushing render target caches, with unrelated work between @p BeginTransition() and @p EndTransition(). Tracked state of the resource is not changed until @p EndTransition() is called. Split barriers are ignored in copy command buffers.
+    ///
+    /// @param[in] resource The GPU resource to be transitioned.
+    /// @param     newState The new state of the resource.
+    YAGE_API auto BeginTransition(GpuResource &resource, D3D12_RESOURCE_STATES newState) noexcept -> void;
+
+    /// @brief
+    ///   End a split transition of the specified resource that was started by @p BeginTransition().
+    ///
+    /// @param[in] resource The GPU resource to be transitioned.
+    /// @param     newState The new state of the resource. Must be the same as the one passed to @p BeginTransition().
+    YAGE_API auto EndTransition(GpuResource &resource, D3D12_RESOURCE_STATES newState) noexcept -> void;
+
+    /// @brief
+    ///   Record an aliasing barrier. This barrier is required before using a placed resource whose memory may have been used by other placed resources.
+    /// @remarks
+    ///   Aliasing barriers are batched with transition barriers. Transitions of @p after that are queued later are never merged across this barrier.
+    ///
+    /// @param[in] before   The placed resource that previously used the memory. Pass nullptr if it is unknown or there are multiple of them.
+    /// @param[in] after    The placed resource that is going to use the memory.
+    YAGE_API auto AliasingBarrier(GpuResource *before, GpuResource &after) noexcept -> void;
+
+    /// @brief
+    ///   Record an unordered access barrier for the specified resource. This barrier is required between two dispatches or draws that access the same resource as unordered access view if the latter one depends on result of the former one.
+    /// @remarks
+    ///   Unordered access barriers are batched with transition barriers. Duplicate unordered access barriers of the same resource are merged.
+    ///
+    /// @param[in] resource The resource that is accessed as unordered access view.
+    YAGE_API auto UnorderedAccessBarrier(GpuResource &resource) noexcept -> void;
+
+    /// @brief
+    ///   Record an unordered access barrier for all resources. All unordered access reads and writes before this barrier must complete before any unordered access after this barrier.
+    YAGE_API auto UnorderedAccessBarrier() noexcept -> void;
+
+    /// @brief
+    ///   Discard content of the specified resource. This is the cheapest way to initialize an aliased render target or depth stencil buffer if its content is going to be fully overwritten.
+    /// @note
+    ///   Render targets must be in @p D3D12_RESOURCE_STATE_RENDER_TARGET state and depth stencil buffers must be in @p D3D12_RESOURCE_STATE_DEPTH_WRITE state. Pending barriers are flushed before discarding. Placed render targets and depth stencil buffers are discarded automatically on their first transition.
+    ///
+    /// @param[in] resource The resource to be discarded.
+    YAGE_API auto DiscardResource(GpuResource &resource) noexcept -> void;
+
+#ifdef __ID3D12GraphicsCommandList7_INTERFACE_DEFINED__
+    /// @brief
+    ///   Checks if enhanced barriers could be recorded into this command buffer.
+    ///
+    /// @return bool
+    /// @retval true    Enhanced barriers are supported by this command buffer.
+    /// @retval false   Enhanced barriers are not supported by this command buffer.
+    YAGE_NODISCARD auto SupportEnhancedBarriers() const noexcept -> bool { return commandList7 != nullptr; }
+
+    /// @brief
+    ///   Record enhanced barriers with explicit sync, access and layout scopes. Pending legacy barriers are flushed before the enhanced barriers.
+    /// @note
+    ///   Resources transitioned with enhanced barriers are not tracked by this command buffer. Legacy transitions must not be used for these resources until they are transitioned back to a layout that is compatible with their tracked state. This method should only be called if @p SupportEnhancedBarriers() returns true.
+    ///
+    /// @param count    Number of barrier groups.
+    /// @param groups   Array of barrier groups to be recorded.
+    auto Barrier(uint32_t count, const D3D12_BARRIER_GROUP *groups) noexcept -> void {
+        FlushResourceBarriers();
+        commandList7->Barrier(count, groups);
+    }
+#endif
+
+    /// @brief
+    ///   Record all pending resource barriers into the command list. This method is called automatically before draw, clear and copy commands, and before this command buffer is submitted.
+    auto FlushResourceBarriers() noexcept -> void {
+        if (pendingBarrierCount > 0) {
+            YAGE_PROFILE_COUNT(BarriersIssued, pendingBarrierCount);
+            commandList->ResourceBarrier(pendingBarrierCount, pendingBarriers);
+            pendingBarrierCount = 0;
+        }
+    }
+
     /// @brief
     ///   Copy all data from @p src to @p dest.
     /// @remarks
@@ -167,6 +353,42 @@ public:
     ///   Thrown if failed to allocate temporary upload buffer.
     YAGE_API auto CopyBuffer(const void *src, GpuResource &dest, size_t destOffset, size_t size) -> void;
 
+    /// @brief
+    ///   Copy @p size bytes of data from a buffer to readback buffer. The returned handle becomes ready once this command buffer is submitted and executed by GPU.
+    /// @note
+    ///   @p dest must be alive until this command buffer is submitted or reset. Copies that are discarded by @p Reset() never become ready.
+    ///
+    /// @param[in]  src         Source buffer to be copied from.
+    /// @param      srcOffset   Offset from start of @p src to start of the copy.
+    /// @param[out] dest        Readback buffer to be copied to.
+    /// @param      destOffset  Offset from start of @p dest to start of the copy.
+    /// @param      size        Size in byte of data to be copied.
+    ///
+    /// @return ReadbackHandle
+    ///   Return a handle that could be polled to check if the data is available for CPU.
+    YAGE_API auto CopyToReadback(GpuResource          &src,
+                                 size_t                srcOffset,
+                                 YaGE::ReadbackBuffer &dest,
+                                 size_t                destOffset,
+                                 size_t                size) -> ReadbackHandle;
+
+    /// @brief
+    ///   Copy a texture subresource to readback buffer. The subresource is copied with D3D12 aligned row pitch, use @p ReadbackHandle::RowPitch() to access each row. The returned handle becomes ready once this command buffer is submitted and executed by GPU.
+    /// @note
+    ///   @p dest must be alive until this command buffer is submitted or reset. Copies that are discarded by @p Reset() never become ready.
+    ///
+    /// @param[in]  src         Source texture to be copied from.
+    /// @param      subresource Index of the subresource to be copied.
+    /// @param[out] dest        Readback buffer to be copied to.
+    /// @param      destOffset  Offset from start of @p dest to start of the copy. Must be aligned with @p D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT.
+    ///
+    /// @return ReadbackHandle
+    ///   Return a handle that could be polled to check if the data is available for CPU. Return an empty handle if @p dest does not have enough space for the subresource. Use @p ReadbackBuffer::SubresourceSize() to get the required size.
+    YAGE_API auto CopyToReadback(PixelBuffer          &src,
+                                 uint32_t              subresource,
+                                 YaGE::ReadbackBuffer &dest,
+                                 size_t                destOffset) -> ReadbackHandle;
+
     /// @brief
     ///   Copy data from system memory to texture.
     ///
@@ -188,6 +410,107 @@ public:
                               PixelBuffer &dest,
                               uint32_t     mipLevel) -> void;
 
+    /// @brief
+    ///   Decode an image directly into temporary upload buffer and copy it to texture.
+    /// @remarks
+    ///   Pixels are decoded into the mapped upload buffer with D3D12 aligned row pitch, so that no intermediate system memory copy is required.
+    ///
+    /// @param[in]  image       The image decoder to decode pixels from. Pixel format of @p image must be compatible with @p dest.
+    /// @param[out] dest        Destination texture to be copied to.
+    /// @param      mipLevel    Mip level of the destination texture to be copied to.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to allocate temporary upload buffer.
+    /// @throw SystemErrorException
+    ///   Thrown if failed to decode pixels of @p image.
+    YAGE_API auto CopyTexture(const ImageDecoder &image, PixelBuffer &dest, uint32_t mipLevel) -> void;
+
+    /// @brief
+    ///   Copy pre-baked texture data to all subresources of texture. The data is copied to temporary upload buffer with a single memory copy, so that texture blobs of memory-mapped @p AssetArchive could be uploaded without any intermediate buffer.
+    /// @note
+    ///   Source data must be laid out as the placed footprints returned by @p ID3D12Device::GetCopyableFootprints() for all subresources of @p dest with base offset 0.
+    ///
+    /// @param[in]  src     Source data in placed footprint layout.
+    /// @param      size    Size in byte of @p src.
+    /// @param[out] dest    Destination texture to be copied to.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if @p size does not match the placed footprints of @p dest or failed to allocate temporary upload buffer.
+    YAGE_API auto CopyTexture(const void *src, size_t size, PixelBuffer &dest) -> void;
+
+    /// @brief
+    ///   Copy data from system memory to subresources of texture. Placed footprints of the subresources are queried via @p GetCopyableFootprints(), so that block-compressed formats, texture arrays and mip chains are handled.
+    /// @note
+    ///   Only the copied subresources are transitioned to copy destination state.
+    ///
+    /// @param[out] dest                Destination texture to be copied to.
+    /// @param      firstSubresource    Index of the first subresource to be copied to.
+    /// @param      count               Number of subresources to be copied.
+    /// @param[in]  data                Source data of each subresource. @p RowPitch and @p SlicePitch are row and depth pitch of the source data.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to allocate temporary upload buffer.
+    YAGE_API auto CopySubresources(PixelBuffer                  &dest,
+                                   uint32_t                      firstSubresource,
+                                   uint32_t                      count,
+                                   const D3D12_SUBRESOURCE_DATA *data) -> void;
+
+    /// @brief
+    ///   Upload a batch of system memory regions to buffers. All regions are packed into a single temporary upload buffer, all barriers are issued at once and the copies are recorded back to back.
+    ///
+    /// @param count    Number of regions to be uploaded.
+    /// @param regions  Regions to be uploaded.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to allocate temporary upload buffer.
+    YAGE_API auto UploadBuffers(uint32_t count, const BufferUploadRegion *regions) -> void;
+
+    /// @brief
+    ///   Upload a batch of system memory regions to texture subresources. Subresources could belong to different textures. All regions are packed into a single temporary upload buffer, all barriers are issued at once and the copies are recorded back to back.
+    /// @note
+    ///   Only the copied subresources are transitioned to copy destination state.
+    ///
+    /// @param count    Number of regions to be uploaded.
+    /// @param regions  Regions to be uploaded.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to allocate temporary upload buffer.
+    YAGE_API auto UploadSubresources(uint32_t count, const SubresourceUploadRegion *regions) -> void;
+
+    /// @brief
+    ///   Generate all mip levels of the specified pixel buffer from its most detailed mip level with compute shader. Up to 4 mip levels are generated per dispatch, non-power-of-two sizes and sRGB formats are handled.
+    /// @note
+    ///   The pixel buffer must be created with unordered access enabled, for example a @p Texture with mip levels of an uncompressed format or a @p ColorBuffer that @p SupportUnorderedAccess(). Copy command buffers could not generate mip levels.
+    ///   Current compute root signature and pipeline state are replaced by this method. Mip levels are left in either non-pixel shader resource or unordered access state, so the pixel buffer should be transitioned before used.
+    ///
+    /// @param[in, out] buffer  The pixel buffer to generate mip levels for.
+    ///
+    /// @return bool
+    /// @retval true    Mip level generation commands are recorded.
+    /// @retval false   Mip levels of the pixel buffer could not be generated by compute shader. No command is recorded.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to create the mipmap generator or failed to allocate temporary descriptors.
+    YAGE_API auto GenerateMips(PixelBuffer &buffer) -> bool;
+
+    /// @brief
+    ///   Scale the top-left region of the source color buffer to the whole destination color buffer with bilinear filtering. This is usually used to upscale the active region of dynamic resolution render targets to the back buffer.
+    /// @note
+    ///   Current graphics root signature, pipeline state, primitive topology, render target, viewport and scissor rectangle are replaced by this method. The source color buffer is left in pixel shader resource state and the destination color buffer is left in render target state.
+    ///
+    /// @param[in]      source          The color buffer to be scaled. Multisample color buffers are not supported.
+    /// @param          sourceWidth     Width in pixels of the source region. This is usually @p DynamicResolution::RenderWidth().
+    /// @param          sourceHeight    Height in pixels of the source region. This is usually @p DynamicResolution::RenderHeight().
+    /// @param[in, out] dest            The color buffer to be rendered to, for example the current back buffer.
+    ///
+    /// @return bool
+    /// @retval true    Upscaling commands are recorded.
+    /// @retval false   The source color buffer is a multisample color buffer or this is not a direct command buffer. No command is recorded.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to create the upscaler or the pipeline state of the destination format.
+    YAGE_API auto Upscale(ColorBuffer &source, uint32_t sourceWidth, uint32_t sourceHeight, ColorBuffer &dest) -> bool;
+
     /// @brief
     ///   Set a single render target for current pipeline.
     /// @note
@@ -239,6 +562,7 @@ public:
     /// @param[in, out] colorBuffer The color buffer to be cleared.
     auto ClearColor(ColorBuffer &colorBuffer) noexcept -> void {
         const Color &color = colorBuffer.ClearColor();
+        FlushResourceBarriers();
         commandList->ClearRenderTargetView(colorBuffer.RenderTargetView(), reinterpret_cast<const float *>(&color), 0,
                                            nullptr);
     }
@@ -249,6 +573,7 @@ public:
     /// @param[in, out] colorBuffer The color buffer to be cleared.
     /// @param[in]      color       The color to be used to clear the color buffer.
     auto ClearColor(ColorBuffer &colorBuffer, const Color &color) noexcept -> void {
+        FlushResourceBarriers();
         commandList->ClearRenderTargetView(colorBuffer.RenderTargetView(), reinterpret_cast<const float *>(&color), 0,
                                            nullptr);
     }
@@ -258,6 +583,7 @@ public:
     ///
     /// @param[in] depthBuffer  The depth buffer to be cleared.
     auto ClearDepth(DepthBuffer &depthBuffer) noexcept -> void {
+        FlushResourceBarriers();
         commandList->ClearDepthStencilView(depthBuffer.DepthStencilView(), D3D12_CLEAR_FLAG_DEPTH,
                                            depthBuffer.ClearDepth(), depthBuffer.ClearStencil(), 0, nullptr);
     }
@@ -268,6 +594,7 @@ public:
     /// @param[in, out] depthBuffer The depth buffer to be cleared.
     /// @param          clearDepth  The depth value to be used to clear the depth buffer.
     auto ClearDepth(DepthBuffer &depthBuffer, float clearDepth) noexcept -> void {
+        FlushResourceBarriers();
         commandList->ClearDepthStencilView(depthBuffer.DepthStencilView(), D3D12_CLEAR_FLAG_DEPTH, clearDepth,
                                            depthBuffer.ClearStencil(), 0, nullptr);
     }
@@ -277,6 +604,7 @@ public:
     ///
     /// @param[in, out] depthBuffer  The depth buffer to be cleared.
     auto ClearStencil(DepthBuffer &depthBuffer) noexcept -> void {
+        FlushResourceBarriers();
         commandList->ClearDepthStencilView(depthBuffer.DepthStencilView(), D3D12_CLEAR_FLAG_STENCIL,
                                            depthBuffer.ClearDepth(), depthBuffer.ClearStencil(), 0, nullptr);
     }
@@ -287,6 +615,7 @@ public:
     /// @param[in, out] depthBuffer  The depth buffer to be cleared.
     /// @param          stencil      The stencil value to be used to clear the depth buffer.
     auto ClearStencil(DepthBuffer &depthBuffer, uint8_t stencil) noexcept -> void {
+        FlushResourceBarriers();
         commandList->ClearDepthStencilView(depthBuffer.DepthStencilView(), D3D12_CLEAR_FLAG_STENCIL,
                                            depthBuffer.ClearDepth(), stencil, 0, nullptr);
     }
@@ -296,6 +625,7 @@ public:
     ///
     /// @param[in, out] depthBuffer  The depth buffer to be cleared.
     auto ClearDepthStencil(DepthBuffer &depthBuffer) noexcept -> void {
+        FlushResourceBarriers();
         commandList->ClearDepthStencilView(depthBuffer.DepthStencilView(),
                                            D3D12_CLEAR_FLAG_DEPTH | D3D12_CLEAR_FLAG_STENCIL, depthBuffer.ClearDepth(),
                                            depthBuffer.ClearStencil(), 0, nullptr);
@@ -308,6 +638,7 @@ public:
     /// @param          depth        The depth value to be used to clear the depth buffer.
     /// @param          stencil      The stencil value to be used to clear the depth buffer.
     auto ClearDepthStencil(DepthBuffer &depthBuffer, float depth, uint8_t stencil) noexcept -> void {
+        FlushResourceBarriers();
         commandList->ClearDepthStencilView(depthBuffer.DepthStencilView(),
                                            D3D12_CLEAR_FLAG_DEPTH | D3D12_CLEAR_FLAG_STENCIL, depth, stencil, 0,
                                            nullptr);
@@ -335,6 +666,18 @@ public:
         dynamicDescriptorHeap.BindGraphicsDescriptor(rootParam, offset, descriptor);
     }
 
+    /// @brief
+    ///   Set contiguous non-sampler graphics descriptor table descriptors. Contiguous descriptors are uploaded with a single descriptor range.
+    ///
+    /// @param rootParam    The root parameter index of the descriptor table.
+    /// @param offset       Offset of the first descriptor in the descriptor table.
+    /// @param first        The first descriptor to be set. Descriptors must be contiguous in the same CPU descriptor heap.
+    /// @param count        Number of descriptors to be set.
+    auto SetGraphicsDescriptors(uint32_t rootParam, uint32_t offset, CpuDescriptorHandle first, uint32_t count) noexcept
+        -> void {
+        dynamicDescriptorHeap.BindGraphicsDescriptors(rootParam, offset, first, count);
+    }
+
     /// @brief
     ///   Set a sampler graphics descriptor table descriptor.
     ///
@@ -410,6 +753,18 @@ public:
         dynamicDescriptorHeap.BindComputeDescriptor(rootParam, offset, descriptor);
     }
 
+    /// @brief
+    ///   Set contiguous non-sampler compute descriptor table descriptors. Contiguous descriptors are uploaded with a single descriptor range.
+    ///
+    /// @param rootParam    The root parameter index of the descriptor table.
+    /// @param offset       Offset of the first descriptor in the descriptor table.
+    /// @param first        The first descriptor to be set. Descriptors must be contiguous in the same CPU descriptor heap.
+    /// @param count        Number of descriptors to be set.
+    auto SetComputeDescriptors(uint32_t rootParam, uint32_t offset, CpuDescriptorHandle first, uint32_t count) noexcept
+        -> void {
+        dynamicDescriptorHeap.BindComputeDescriptors(rootParam, offset, first, count);
+    }
+
     /// @brief
     ///   Set a sampler compute descriptor table descriptor.
     ///
@@ -475,6 +830,112 @@ public:
     ///   Thrown if failed to allocate temporary upload buffer.
     YAGE_API auto SetComputeConstantBuffer(uint32_t rootParam, uint32_t offset, const void *data, size_t size) -> void;
 
+    /// @brief
+    ///   Copy data to temporary upload buffer and set it as graphics root shader resource view. This could be used to upload per-instance data that is read as structured buffer with @p SV_InstanceID.
+    ///
+    /// @param rootParam    The root parameter index of the root shader resource view.
+    /// @param data         The data to be copied.
+    /// @param size         Size in byte of the data to be copied.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to allocate temporary upload buffer.
+    YAGE_API auto SetGraphicsStructuredBuffer(uint32_t rootParam, const void *data, size_t size) -> void;
+
+    /// @brief
+    ///   Set a graphics root constant buffer view with GPU address, for example an allocation of @p DynamicBuffer.
+    ///
+    /// @param rootParam    The root parameter index of the root constant buffer view.
+    /// @param gpuAddress   GPU address to start of the constant buffer. Must be aligned up with 256 bytes.
+    auto SetGraphicsConstantBuffer(uint32_t rootParam, uint64_t gpuAddress) noexcept -> void {
+        commandList->SetGraphicsRootConstantBufferView(rootParam, gpuAddress);
+    }
+
+    /// @brief
+    ///   Set a graphics root shader resource view with GPU address, for example an allocation of @p DynamicBuffer.
+    ///
+    /// @param rootParam    The root parameter index of the root shader resource view.
+    /// @param gpuAddress   GPU address to start of the buffer.
+    auto SetGraphicsStructuredBuffer(uint32_t rootParam, uint64_t gpuAddress) noexcept -> void {
+        commandList->SetGraphicsRootShaderResourceView(rootParam, gpuAddress);
+    }
+
+    /// @brief
+    ///   Copy data to temporary upload buffer and set it as compute root shader resource view.
+    ///
+    /// @param rootParam    The root parameter index of the root shader resource view.
+    /// @param data         The data to be copied.
+    /// @param size         Size in byte of the data to be copied.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to allocate temporary upload buffer.
+    YAGE_API auto SetComputeStructuredBuffer(uint32_t rootParam, const void *data, size_t size) -> void;
+
+    /// @brief
+    ///   Set a compute root constant buffer view with GPU address, for example an allocation of @p DynamicBuffer.
+    ///
+    /// @param rootParam    The root parameter index of the root constant buffer view.
+    /// @param gpuAddress   GPU address to start of the constant buffer. Must be aligned up with 256 bytes.
+    auto SetComputeConstantBuffer(uint32_t rootParam, uint64_t gpuAddress) noexcept -> void {
+        commandList->SetComputeRootConstantBufferView(rootParam, gpuAddress);
+    }
+
+    /// @brief
+    ///   Set a compute root shader resource view with GPU address, for example an allocation of @p DynamicBuffer.
+    ///
+    /// @param rootParam    The root parameter index of the root shader resource view.
+    /// @param gpuAddress   GPU address to start of the buffer.
+    auto SetComputeStructuredBuffer(uint32_t rootParam, uint64_t gpuAddress) noexcept -> void {
+        commandList->SetComputeRootShaderResourceView(rootParam, gpuAddress);
+    }
+
+    /// @brief
+    ///   Bind the bindless region of the global descriptor heap to the specified graphics bindless descriptor table.
+    ///
+    /// @param rootParam    The root parameter index of the unbounded descriptor table.
+    /// @param type         Type of the global descriptor heap. Must be the same as type of the descriptor table.
+    auto SetGraphicsBindlessTable(uint32_t                   rootParam,
+                                  D3D12_DESCRIPTOR_HEAP_TYPE type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV) noexcept
+        -> void {
+        const GlobalDescriptorHeap &globalHeap = GlobalDescriptorHeap::Singleton(type);
+        commandList->SetGraphicsRootDescriptorTable(rootParam, globalHeap.BindlessTableStart());
+    }
+
+    /// @brief
+    ///   Bind the bindless region of the global descriptor heap to the specified compute bindless descriptor table.
+    ///
+    /// @param rootParam    The root parameter index of the unbounded descriptor table.
+    /// @param type         Type of the global descriptor heap. Must be the same as type of the descriptor table.
+    auto SetComputeBindlessTable(uint32_t                   rootParam,
+                                 D3D12_DESCRIPTOR_HEAP_TYPE type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV) noexcept
+        -> void {
+        const GlobalDescriptorHeap &globalHeap = GlobalDescriptorHeap::Singleton(type);
+        commandList->SetComputeRootDescriptorTable(rootParam, globalHeap.BindlessTableStart());
+    }
+
+    /// @brief
+    ///   Pass bindless index of the specified view to shaders as a graphics root constant.
+    ///
+    /// @tparam View        Type of the view. Must be @p ShaderResourceView, @p UnorderedAccessView or @p SamplerView.
+    /// @param rootParam    The root parameter index of the constant value.
+    /// @param offset       Offset of the constant.
+    /// @param view         The view whose bindless index is to be set.
+    template <typename View>
+    auto SetGraphicsBindlessIndex(uint32_t rootParam, uint32_t offset, const View &view) noexcept -> void {
+        commandList->SetGraphicsRoot32BitConstant(rootParam, view.BindlessIndex(), offset);
+    }
+
+    /// @brief
+    ///   Pass bindless index of the specified view to shaders as a compute root constant.
+    ///
+    /// @tparam View        Type of the view. Must be @p ShaderResourceView, @p UnorderedAccessView or @p SamplerView.
+    /// @param rootParam    The root parameter index of the constant value.
+    /// @param offset       Offset of the constant.
+    /// @param view         The view whose bindless index is to be set.
+    template <typename View>
+    auto SetComputeBindlessIndex(uint32_t rootParam, uint32_t offset, const View &view) noexcept -> void {
+        commandList->SetComputeRoot32BitConstant(rootParam, view.BindlessIndex(), offset);
+    }
+
     /// @brief
     ///   Set a vertex buffer to the specified slot.
     ///
@@ -488,7 +949,7 @@ public:
             /* SizeInBytes    = */ vertexCount * stride,
             /* StrideInBytes  = */ stride,
         };
-        commandList->IASetVertexBuffers(slot, 1, &vbv);
+        BindVertexBuffer(slot, vbv);
     }
 
     /// @brief
@@ -503,7 +964,7 @@ public:
             /* StrideInBytes  = */ buffer.ElementSize(),
         };
 
-        commandList->IASetVertexBuffers(slot, 1, &vbv);
+        BindVertexBuffer(slot, vbv);
     }
 
     /// @brief
@@ -520,6 +981,22 @@ public:
     ///   Thrown if failed to allocate temporary upload buffer.
     YAGE_API auto SetVertexBuffer(uint32_t slot, const void *data, uint32_t vertexCount, uint32_t stride) -> void;
 
+    /// @brief
+    ///   Upload per-instance data to temporary upload buffer and use it as vertex buffer of the specified slot.
+    /// @note
+    ///   Input elements of @p slot must be declared with @p D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_VERTEX_DATA in input layout of the pipeline state.
+    ///
+    /// @param     slot             The slot to set the instance buffer.
+    /// @param[in] data             The per-instance data to be copied.
+    /// @param     instanceCount    Number of instances to be copied.
+    /// @param     stride           Stride size in byte of each instance.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to allocate temporary upload buffer.
+    auto SetInstanceBuffer(uint32_t slot, const void *data, uint32_t instanceCount, uint32_t stride) -> void {
+        SetVertexBuffer(slot, data, instanceCount, stride);
+    }
+
     /// @brief
     ///   Set index buffer for current draw call.
     ///
@@ -534,7 +1011,7 @@ public:
             /* Format         = */ format,
         };
 
-        commandList->IASetIndexBuffer(&ibv);
+        BindIndexBuffer(ibv);
     }
 
     /// @brief
@@ -551,7 +1028,7 @@ public:
             /* Format         = */ format,
         };
 
-        commandList->IASetIndexBuffer(&ibv);
+        BindIndexBuffer(ibv);
     }
 
     /// @brief
@@ -574,7 +1051,14 @@ public:
     ///
     /// @param pipelineState   The pipeline state to be set.
     auto SetPipelineState(const PipelineState &pso) noexcept -> void {
-        commandList->SetPipelineState(pso.D3D12PipelineState());
+        ID3D12PipelineState *const pipelineState = pso.D3D12PipelineState();
+        if (pipelineState == boundPipelineState) {
+            CountFilteredState();
+            return;
+        }
+
+        boundPipelineState = pipelineState;
+        commandList->SetPipelineState(pipelineState);
     }
 
     /// @brief
@@ -582,6 +1066,12 @@ public:
     ///
     /// @param topology   Primitive topology for current draw call.
     auto SetPrimitiveTopology(D3D12_PRIMITIVE_TOPOLOGY topology) noexcept -> void {
+        if (topology == boundTopology) {
+            CountFilteredState();
+            return;
+        }
+
+        boundTopology = topology;
         commandList->IASetPrimitiveTopology(topology);
     }
 
@@ -612,7 +1102,7 @@ public:
             /* MaxDepth = */ zFar,
         };
 
-        commandList->RSSetViewports(1, &viewport);
+        BindViewport(viewport);
     }
 
     /// @brief
@@ -623,6 +1113,12 @@ public:
     /// @param count      Number of viewports to be set.
     /// @param viewports  Array of viewports to be set.
     auto SetViewports(uint32_t count, const D3D12_VIEWPORT *viewports) noexcept -> void {
+        if (count == 1) {
+            BindViewport(*viewports);
+            return;
+        }
+
+        isViewportBound = false;
         commandList->RSSetViewports(count, viewports);
     }
 
@@ -649,7 +1145,7 @@ public:
             /* bottom = */ static_cast<LONG>(y + height),
         };
 
-        commandList->RSSetScissorRects(1, &rect);
+        BindScissorRect(rect);
     }
 
     /// @brief
@@ -660,9 +1156,24 @@ public:
     /// @param numRects   Number of scissor rectangles.
     /// @param rects      Array of scissor rectangles.
     auto SetScissorRects(uint32_t numRects, const D3D12_RECT *rects) noexcept -> void {
+        if (numRects == 1) {
+            BindScissorRect(*rects);
+            return;
+        }
+
+        isScissorRectBound = false;
         commandList->RSSetScissorRects(numRects, rects);
     }
 
+    /// @brief
+    ///   Get number of redundant pipeline state, primitive topology, viewport, scissor rectangle, vertex buffer and index buffer calls that are filtered by this command buffer since it is created.
+    /// @remarks
+    ///   State shadowing is reset when this command buffer is submitted or reset. Filtered calls are also counted by the @p RedundantStatesFiltered profiler counter.
+    ///
+    /// @return uint64_t
+    ///   Return number of filtered redundant state calls.
+    YAGE_NODISCARD auto FilteredStateCount() const noexcept -> uint64_t { return filteredStateCount; }
+
     /// @brief
     ///   Draw primitives.
     ///
@@ -671,6 +1182,7 @@ public:
     auto Draw(uint32_t vertexCount, uint32_t firstVertex = 0) noexcept -> void {
         dynamicDescriptorHeap.Commit(commandList.Get());
         dynamicSamplerHeap.Commit(commandList.Get());
+        FlushResourceBarriers();
         commandList->DrawInstanced(vertexCount, 1, firstVertex, 0);
     }
 
@@ -683,22 +1195,635 @@ public:
     auto DrawIndexed(uint32_t indexCount, uint32_t firstIndex, uint32_t firstVertex = 0) noexcept -> void {
         dynamicDescriptorHeap.Commit(commandList.Get());
         dynamicSamplerHeap.Commit(commandList.Get());
+        FlushResourceBarriers();
         commandList->DrawIndexedInstanced(indexCount, 1, firstIndex, firstVertex, 0);
     }
 
+    /// @brief
+    ///   Draw instanced primitives.
+    ///
+    /// @param vertexCount      Number of vertices of each instance.
+    /// @param instanceCount    Number of instances to be drawn.
+    /// @param firstVertex      Index of the first vertex to be drawn.
+    /// @param firstInstance    Index of the first instance to be drawn.
+    auto DrawInstanced(uint32_t vertexCount,
+                       uint32_t instanceCount,
+                       uint32_t firstVertex   = 0,
+                       uint32_t firstInstance = 0) noexcept -> void {
+        dynamicDescriptorHeap.Commit(commandList.Get());
+        dynamicSamplerHeap.Commit(commandList.Get());
+        FlushResourceBarriers();
+        commandList->DrawInstanced(vertexCount, instanceCount, firstVertex, firstInstance);
+    }
+
+    /// @brief
+    ///   Draw instanced primitives according to index buffer.
+    ///
+    /// @param indexCount       Number of indices of each instance.
+    /// @param instanceCount    Number of instances to be drawn.
+    /// @param firstIndex       Index of the first index in index buffer.
+    /// @param firstVertex      Value added to each index before reading a vertex from vertex buffer.
+    /// @param firstInstance    Index of the first instance to be drawn.
+    auto DrawIndexedInstanced(uint32_t indexCount,
+                              uint32_t instanceCount,
+                              uint32_t firstIndex,
+                              uint32_t firstVertex   = 0,
+                              uint32_t firstInstance = 0) noexcept -> void {
+        dynamicDescriptorHeap.Commit(commandList.Get());
+        dynamicSamplerHeap.Commit(commandList.Get());
+        FlushResourceBarriers();
+        commandList->DrawIndexedInstanced(indexCount, instanceCount, firstIndex, firstVertex, firstInstance);
+    }
+
+    /// @brief
+    ///   Record multiple draws that share current pipeline state and bindings. Descriptors and resource barriers are committed only once for all draws.
+    ///
+    /// @param count    Number of draws.
+    /// @param draws    Arguments of each draw.
+    auto MultiDraw(uint32_t count, const D3D12_DRAW_ARGUMENTS *draws) noexcept -> void {
+        dynamicDescriptorHeap.Commit(commandList.Get());
+        dynamicSamplerHeap.Commit(commandList.Get());
+        FlushResourceBarriers();
+        for (uint32_t i = 0; i < count; ++i) {
+            const D3D12_DRAW_ARGUMENTS &draw = draws[i];
+            commandList->DrawInstanced(draw.VertexCountPerInstance, draw.InstanceCount, draw.StartVertexLocation,
+                                       draw.StartInstanceLocation);
+        }
+    }
+
+    /// @brief
+    ///   Record multiple indexed draws that share current pipeline state and bindings. Descriptors and resource barriers are committed only once for all draws.
+    ///
+    /// @param count    Number of draws.
+    /// @param draws    Arguments of each draw.
+    auto MultiDrawIndexed(uint32_t count, const D3D12_DRAW_INDEXED_ARGUMENTS *draws) noexcept -> void {
+        dynamicDescriptorHeap.Commit(commandList.Get());
+        dynamicSamplerHeap.Commit(commandList.Get());
+        FlushResourceBarriers();
+        for (uint32_t i = 0; i < count; ++i) {
+            const D3D12_DRAW_INDEXED_ARGUMENTS &draw = draws[i];
+            commandList->DrawIndexedInstanced(draw.IndexCountPerInstance, draw.InstanceCount, draw.StartIndexLocation,
+                                              draw.BaseVertexLocation, draw.StartInstanceLocation);
+        }
+    }
+
+    /// @brief
+    ///   Dispatch compute thread groups with current compute pipeline state and bindings.
+    ///
+    /// @param groupCountX  Number of thread groups in X dimension.
+    /// @param groupCountY  Number of thread groups in Y dimension.
+    /// @param groupCountZ  Number of thread groups in Z dimension.
+    auto Dispatch(uint32_t groupCountX, uint32_t groupCountY = 1, uint32_t groupCountZ = 1) noexcept -> void {
+        dynamicDescriptorHeap.Commit(commandList.Get());
+        dynamicSamplerHeap.Commit(commandList.Get());
+        FlushResourceBarriers();
+        commandList->Dispatch(groupCountX, groupCountY, groupCountZ);
+    }
+
+    /// @brief
+    ///   Dispatch enough thread groups to cover the specified number of threads in one dimension.
+    ///
+    /// @param threadCountX Number of threads in X dimension.
+    /// @param groupSizeX   Number of threads in each thread group in X dimension. Must match the compute shader.
+    auto Dispatch1D(uint32_t threadCountX, uint32_t groupSizeX = 64) noexcept -> void {
+        Dispatch((threadCountX + groupSizeX - 1) / groupSizeX);
+    }
+
+    /// @brief
+    ///   Dispatch enough thread groups to cover the specified number of threads in two dimensions.
+    ///
+    /// @param threadCountX Number of threads in X dimension.
+    /// @param threadCountY Number of threads in Y dimension.
+    /// @param groupSizeX   Number of threads in each thread group in X dimension. Must match the compute shader.
+    /// @param groupSizeY   Number of threads in each thread group in Y dimension. Must match the compute shader.
+    auto Dispatch2D(uint32_t threadCountX,
+                    uint32_t threadCountY,
+                    uint32_t groupSizeX = 8,
+                    uint32_t groupSizeY = 8) noexcept -> void {
+        Dispatch((threadCountX + groupSizeX - 1) / groupSizeX, (threadCountY + groupSizeY - 1) / groupSizeY);
+    }
+
+    /// @brief
+    ///   Dispatch enough thread groups to cover the specified number of threads in three dimensions.
+    ///
+    /// @param threadCountX Number of threads in X dimension.
+    /// @param threadCountY Number of threads in Y dimension.
+    /// @param threadCountZ Number of threads in Z dimension.
+    /// @param groupSizeX   Number of threads in each thread group in X dimension. Must match the compute shader.
+    /// @param groupSizeY   Number of threads in each thread group in Y dimension. Must match the compute shader.
+    /// @param groupSizeZ   Number of threads in each thread group in Z dimension. Must match the compute shader.
+    auto Dispatch3D(uint32_t threadCountX,
+                    uint32_t threadCountY,
+                    uint32_t threadCountZ,
+                    uint32_t groupSizeX,
+                    uint32_t groupSizeY,
+                    uint32_t groupSizeZ) noexcept -> void {
+        Dispatch((threadCountX + groupSizeX - 1) / groupSizeX, (threadCountY + groupSizeY - 1) / groupSizeY,
+                 (threadCountZ + groupSizeZ - 1) / groupSizeZ);
+    }
+
+    /// @brief
+    ///   Dispatch compute thread groups with a @p D3D12_DISPATCH_ARGUMENTS structure that is generated on GPU.
+    ///
+    /// @param[in,out] argumentBuffer   The buffer that contains the dispatch arguments.
+    /// @param         argumentOffset   Offset in byte of the dispatch arguments from start of @p argumentBuffer.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to create the dispatch command signature.
+    YAGE_API auto DispatchIndirect(GpuResource &argumentBuffer, uint64_t argumentOffset = 0) -> void;
+
+#ifdef __ID3D12GraphicsCommandList6_INTERFACE_DEFINED__
+    /// @brief
+    ///   Checks if mesh dispatches could be recorded into this command buffer.
+    ///
+    /// @return bool
+    /// @retval true    Amplification shaders and mesh shaders are supported by this command buffer.
+    /// @retval false   Amplification shaders and mesh shaders are not supported by this command buffer.
+    YAGE_NODISCARD auto SupportMeshShaders() const noexcept -> bool { return commandList6 != nullptr; }
+
+    /// @brief
+    ///   Dispatch amplification shader or mesh shader thread groups with current graphics pipeline state and bindings.
+    /// @note
+    ///   This method should only be called if @p SupportMeshShaders() returns true.
+    ///
+    /// @param groupCountX  Number of thread groups in X dimension.
+    /// @param groupCountY  Number of thread groups in Y dimension.
+    /// @param groupCountZ  Number of thread groups in Z dimension.
+    auto DispatchMesh(uint32_t groupCountX, uint32_t groupCountY = 1, uint32_t groupCountZ = 1) noexcept -> void {
+        dynamicDescriptorHeap.Commit(commandList.Get());
+        dynamicSamplerHeap.Commit(commandList.Get());
+        FlushResourceBarriers();
+        commandList6->DispatchMesh(groupCountX, groupCountY, groupCountZ);
+    }
+
+    /// @brief
+    ///   Dispatch amplification shader or mesh shader thread groups with a @p D3D12_DISPATCH_MESH_ARGUMENTS structure that is generated on GPU.
+    /// @note
+    ///   This method should only be called if @p SupportMeshShaders() returns true.
+    ///
+    /// @param[in,out] argumentBuffer   The buffer that contains the mesh dispatch arguments.
+    /// @param         argumentOffset   Offset in byte of the mesh dispatch arguments from start of @p argumentBuffer.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to create the mesh dispatch command signature.
+    YAGE_API auto DispatchMeshIndirect(GpuResource &argumentBuffer, uint64_t argumentOffset = 0) -> void;
+#endif
+
+    /// @brief
+    ///   Checks if ray tracing commands could be recorded into this command buffer.
+    ///
+    /// @return bool
+    /// @retval true    Acceleration structure builds and ray dispatches are supported by this command buffer.
+    /// @retval false   Ray tracing is not supported by this command buffer.
+    YAGE_NODISCARD auto SupportRayTracing() const noexcept -> bool { return commandList4 != nullptr; }
+
+    /// @brief
+    ///   Build or update a batch of acceleration structures.
+    /// @remarks
+    ///   Scratch memory of all builds is sub-allocated from the temporary unordered access buffer of this command buffer, so that all builds are recorded back-to-back without barriers in between and could overlap on GPU. An unordered access barrier is queued for each built acceleration structure, so bottom-level acceleration structures could be used by top-level builds that are recorded later. Destination acceleration structures that are empty or too small are recreated, they must not be referenced by commands that are recorded earlier in this command buffer.
+    /// @note
+    ///   Vertex, index and transform buffers that are referenced by @p builds must be in @p D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE state. This method should only be called if @p SupportRayTracing() returns true.
+    ///
+    /// @param count    Number of acceleration structures to be built.
+    /// @param builds   Array of acceleration structure builds.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to allocate scratch memory or failed to create destination acceleration structures.
+    YAGE_API auto BuildAccelerationStructures(uint32_t count, const AccelerationStructureBuild *builds) -> void;
+
+    /// @brief
+    ///   Build a top-level acceleration structure from instances in system memory.
+    /// @remarks
+    ///   Instance descriptions are uploaded with a temporary upload buffer. The acceleration structure is refit in place if it was built with @p D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_ALLOW_UPDATE, the same flags and the same number of instances, which is much cheaper than a rebuild for moving instances. Call @p AccelerationStructure::Invalidate() to force a rebuild, for example when many instances are added, removed or moved far away.
+    ///
+    /// @param[in,out] dest         The top-level acceleration structure to be built.
+    /// @param[in]     instances    Instance descriptions of the acceleration structure.
+    /// @param         count        Number of instances.
+    /// @param         flags        Build flags of the acceleration structure. @p D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_PREFER_FAST_TRACE and @p D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_ALLOW_UPDATE are recommended for dynamic scenes.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to allocate temporary buffers or failed to create the acceleration structure.
+    YAGE_API auto BuildTopLevelAccelerationStructure(AccelerationStructure                              &dest,
+                                                     const D3D12_RAYTRACING_INSTANCE_DESC               *instances,
+                                                     uint32_t                                            count,
+                                                     D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAGS flags) -> void;
+
+    /// @brief
+    ///   Copy, compact, clone or serialize an acceleration structure.
+    /// @note
+    ///   @p dest must be large enough for the copy mode. Use @p EmitCompactedSizes() to get size of compacted acceleration structures.
+    ///
+    /// @param[out] dest    The destination acceleration structure.
+    /// @param[in]  src     The source acceleration structure.
+    /// @param      mode    Copy mode of the acceleration structure.
+    YAGE_API auto CopyAccelerationStructure(AccelerationStructure                            &dest,
+                                            AccelerationStructure                            &src,
+                                            D3D12_RAYTRACING_ACCELERATION_STRUCTURE_COPY_MODE mode) noexcept -> void;
+
+    /// @brief
+    ///   Emit compacted sizes of acceleration structures into a readback buffer. Each size is a @p D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_COMPACTED_SIZE_DESC structure. The returned handle becomes ready once this command buffer is submitted and executed by GPU.
+    /// @note
+    ///   The acceleration structures must have been built with @p D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_ALLOW_COMPACTION. @p dest must be alive until this command buffer is submitted or reset.
+    ///
+    /// @param      count       Number of acceleration structures.
+    /// @param[in]  structures  Array of acceleration structures to be queried.
+    /// @param[out] dest        Readback buffer to be copied to.
+    /// @param      destOffset  Offset from start of @p dest to start of the compacted sizes.
+    ///
+    /// @return ReadbackHandle
+    ///   Return a handle that could be polled to check if the compacted sizes are available for CPU.
+    /// @throw RenderAPIException
+    ///   Thrown if failed to allocate temporary unordered access buffer.
+    YAGE_API auto EmitCompactedSizes(uint32_t                      count,
+                                     AccelerationStructure *const *structures,
+                                     YaGE::ReadbackBuffer         &dest,
+                                     size_t                        destOffset) -> ReadbackHandle;
+
+    /// @brief
+    ///   Set ray tracing pipeline state for this command buffer.
+    /// @note
+    ///   Root signatures will not be affected by this method. Global root signature of ray tracing pipeline state should be set with @p SetComputeRootSignature().
+    ///
+    /// @param pso  The ray tracing pipeline state to be set.
+    YAGE_API auto SetPipelineState(const RayTracingPipelineState &pso) noexcept -> void;
+
+    /// @brief
+    ///   Dispatch rays with current ray tracing pipeline state and compute bindings.
+    /// @note
+    ///   This method should only be called if @p SupportRayTracing() returns true.
+    ///
+    /// @param desc     Shader tables and dimensions of the ray dispatch.
+    auto DispatchRays(const D3D12_DISPATCH_RAYS_DESC &desc) noexcept -> void {
+        dynamicDescriptorHeap.Commit(commandList.Get());
+        dynamicSamplerHeap.Commit(commandList.Get());
+        FlushResourceBarriers();
+        commandList4->DispatchRays(&desc);
+    }
+
+    /// @brief
+    ///   Dispatch rays with shader tables in system memory. All shader tables are packed into one temporary upload buffer.
+    /// @note
+    ///   Only the first record of @p rayGeneration is used. This method should only be called if @p SupportRayTracing() returns true.
+    ///
+    /// @param[in] rayGeneration    Shader table that contains the ray generation shader record.
+    /// @param[in] miss             Shader table of miss shaders.
+    /// @param[in] hitGroup         Shader table of hit groups.
+    /// @param     width            Width of the ray dispatch.
+    /// @param     height           Height of the ray dispatch.
+    /// @param     depth            Depth of the ray dispatch.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to allocate temporary upload buffer.
+    YAGE_API auto DispatchRays(const ShaderTable &rayGeneration,
+                               const ShaderTable &miss,
+                               const ShaderTable &hitGroup,
+                               uint32_t           width,
+                               uint32_t           height,
+                               uint32_t           depth = 1) -> void;
+
+    /// @brief
+    ///   Execute commands from an argument buffer that is generated on GPU.
+    /// @remarks
+    ///   The argument buffer is transitioned to indirect argument state. Bindings that are changed by the command signature, such as vertex buffers and index buffer, are undefined after this call and must be set again before next draw.
+    ///
+    /// @param[in]     signature        The command signature that describes layout of the argument buffer.
+    /// @param         commandCount     Number of commands to be executed.
+    /// @param[in,out] argumentBuffer   The buffer that contains indirect arguments.
+    /// @param         argumentOffset   Offset in byte of the first command from start of @p argumentBuffer.
+    YAGE_API auto ExecuteIndirect(const CommandSignature &signature,
+                                  uint32_t                commandCount,
+                                  GpuResource            &argumentBuffer,
+                                  uint64_t                argumentOffset = 0) noexcept -> void;
+
+    /// @brief
+    ///   Execute commands from an argument buffer with a command count that are both generated on GPU.
+    /// @remarks
+    ///   The argument buffer and the count buffer are transitioned to indirect argument state. Bindings that are changed by the command signature, such as vertex buffers and index buffer, are undefined after this call and must be set again before next draw.
+    ///
+    /// @param[in]     signature        The command signature that describes layout of the argument buffer.
+    /// @param         maxCommandCount  Maximum number of commands to be executed.
+    /// @param[in,out] argumentBuffer   The buffer that contains indirect arguments.
+    /// @param         argumentOffset   Offset in byte of the first command from start of @p argumentBuffer.
+    /// @param[in,out] countBuffer      The buffer that contains a 32-bit command count. Number of executed commands is the minimum of this value and @p maxCommandCount.
+    /// @param         countOffset      Offset in byte of the command count from start of @p countBuffer.
+    YAGE_API auto ExecuteIndirect(const CommandSignature &signature,
+                                  uint32_t                maxCommandCount,
+                                  GpuResource            &argumentBuffer,
+                                  uint64_t                argumentOffset,
+                                  GpuResource            &countBuffer,
+                                  uint64_t                countOffset) noexcept -> void;
+
+    /// @brief
+    ///   Begin a query. Timestamp queries should use @p EndQuery() only.
+    ///
+    /// @param[in] queryHeap    The query heap that the query belongs to.
+    /// @param     type         Type of the query.
+    /// @param     index        Index of the query in the query heap.
+    auto BeginQuery(ID3D12QueryHeap *queryHeap, D3D12_QUERY_TYPE type, uint32_t index) noexcept -> void {
+        commandList->BeginQuery(queryHeap, type, index);
+    }
+
+    /// @brief
+    ///   End a query. For timestamp queries, this writes the current GPU timestamp into the query.
+    ///
+    /// @param[in] queryHeap    The query heap that the query belongs to.
+    /// @param     type         Type of the query.
+    /// @param     index        Index of the query in the query heap.
+    auto EndQuery(ID3D12QueryHeap *queryHeap, D3D12_QUERY_TYPE type, uint32_t index) noexcept -> void {
+        commandList->EndQuery(queryHeap, type, index);
+    }
+
+    /// @brief
+    ///   Resolve query data into a buffer. The destination buffer must be in @p D3D12_RESOURCE_STATE_COPY_DEST state. Buffers in readback heaps are always in this state.
+    ///
+    /// @param[in] queryHeap    The query heap that contains the queries to be resolved.
+    /// @param     type         Type of the queries.
+    /// @param     first        Index of the first query to be resolved.
+    /// @param     count        Number of queries to be resolved.
+    /// @param[in] dest         The destination buffer.
+    /// @param     destOffset   Offset in byte of the destination buffer. Must be 8-byte aligned.
+    auto ResolveQueryData(ID3D12QueryHeap *queryHeap,
+                          D3D12_QUERY_TYPE type,
+                          uint32_t         first,
+                          uint32_t         count,
+                          GpuResource     &dest,
+                          uint64_t         destOffset) noexcept -> void {
+        FlushResourceBarriers();
+        commandList->ResolveQueryData(queryHeap, type, first, count, dest.resource.Get(), destOffset);
+    }
+
+    /// @brief
+    ///   Resolve query data into a readback buffer. The returned handle becomes ready once this command buffer is submitted and executed by GPU.
+    ///
+    /// @param[in]  queryHeap   The query heap that contains the queries to be resolved.
+    /// @param      type        Type of the queries.
+    /// @param      first       Index of the first query to be resolved.
+    /// @param      count       Number of queries to be resolved.
+    /// @param      size        Size in byte of the resolved data of each query.
+    /// @param[out] dest        The destination readback buffer.
+    /// @param      destOffset  Offset in byte of the destination buffer. Must be 8-byte aligned.
+    ///
+    /// @return ReadbackHandle
+    ///   Return a handle that could be polled to check if the query data is available for CPU.
+    YAGE_API auto ResolveQueryData(ID3D12QueryHeap      *queryHeap,
+                                   D3D12_QUERY_TYPE      type,
+                                   uint32_t              first,
+                                   uint32_t              count,
+                                   size_t                size,
+                                   YaGE::ReadbackBuffer &dest,
+                                   uint64_t              destOffset) -> ReadbackHandle;
+
+private:
+    /// @brief
+    ///   Clean up temporary resources and reset this command buffer after it has been submitted.
+    ///
+    /// @param syncPoint    The sync point that indicates when the submission will be finished.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to acquire new command allocator.
+    auto FinishSubmit(uint64_t syncPoint) -> void;
+
+    /// @brief
+    ///   Mark the specified readback buffer as pending. The readback buffer is notified with sync point of the next submission of this command buffer.
+    ///
+    /// @param[in] buffer   The readback buffer that is written by this command buffer.
+    auto TrackReadback(YaGE::ReadbackBuffer &buffer) -> void;
+
+    /// @brief
+    ///   Bind global descriptor heaps to the command list. This method should be called once the command list is reset.
+    auto BindGlobalDescriptorHeaps() noexcept -> void;
+
+    /// @brief
+    ///   Transition a newly placed render target or depth stencil buffer to render target or depth write state and discard it, so that its metadata is initialized before first use.
+    ///
+    /// @param[in, out] resource    The placed resource to be initialized.
+    auto InitializePlacedResource(GpuResource &resource) noexcept -> void;
+
+    /// @brief
+    ///   Track state of a resource that is accessed by this copy command buffer. Resources in default heaps must be in common or copy states. They decay to common state once the submission is finished, so their tracked state is reset to common state here and is valid for other command queues that wait for the copy submission.
+    ///
+    /// @param[in, out] resource    The resource that is accessed by this copy command buffer.
+    auto TrackCopyAccess(GpuResource &resource) noexcept -> void;
+
+    /// @brief
+    ///   Checks if the specified resource is declared by the render graph pass that is being recorded.
+    ///
+    /// @param resource The GPU resource to be checked.
+    ///
+    /// @return bool
+    /// @retval true    The resource is declared, or no render graph pass is being recorded.
+    /// @retval false   The resource is used by a render graph pass without being declared.
+    YAGE_NODISCARD auto IsResourceDeclared(const GpuResource &resource) const noexcept -> bool;
+
+    /// @brief
+    ///   Transition the specified resource to @p state if it is not already in @p state. Unlike @p Transition(), resources in a combined state that contains @p state are not transitioned.
+    ///
+    /// @param[in] resource The GPU resource to be transitioned.
+    /// @param     state    The state that is required by the next command.
+    auto RequireState(GpuResource &resource, D3D12_RESOURCE_STATES state) noexcept -> void;
+
+    /// @brief
+    ///   Transition the specified subresource to @p state if it is not already in @p state.
+    ///
+    /// @param[in] resource     The GPU resource to be transitioned.
+    /// @param     subresource  Index of the subresource to be transitioned.
+    /// @param     state        The state that is required by the next command.
+    auto RequireState(GpuResource &resource, uint32_t subresource, D3D12_RESOURCE_STATES state) noexcept -> void;
+
+    /// @brief
+    ///   Queue a transition barrier. The barrier is merged with the last pending barrier of the same resource if they transition the same subresource. Merged transitions that return to the original state are removed, and an unordered access barrier is queued instead if that state is @p D3D12_RESOURCE_STATE_UNORDERED_ACCESS.
+    ///
+    /// @param[in] resource     The D3D12 resource to be transitioned.
+    /// @param     subresource  Index of the subresource to be transitioned.
+    /// @param     stateBefore  Current state of the subresource.
+    /// @param     stateAfter   New state of the subresource.
+    /// @param     flags        Flags of the barrier. Split barriers are never merged.
+    auto QueueTransition(ID3D12Resource              *resource,
+                         uint32_t                     subresource,
+                         D3D12_RESOURCE_STATES        stateBefore,
+                         D3D12_RESOURCE_STATES        stateAfter,
+                         D3D12_RESOURCE_BARRIER_FLAGS flags = D3D12_RESOURCE_BARRIER_FLAG_NONE) noexcept -> void;
+
+    /// @brief
+    ///   Append a resource barrier to pending barriers. Pending barriers are flushed if there is no free slot.
+    ///
+    /// @param barrier  The resource barrier to be queued.
+    auto QueueBarrier(const D3D12_RESOURCE_BARRIER &barrier) noexcept -> void;
+
+    /// @brief
+    ///   Queue an unordered access barrier. The barrier is skipped if an unordered access barrier of the same resource or of all resources is already pending.
+    ///
+    /// @param[in] resource The D3D12 resource that is accessed as unordered access view. Pass nullptr for all resources.
+    auto QueueUnorderedAccessBarrier(ID3D12Resource *resource) noexcept -> void;
+
+    /// @brief
+    ///   Queue split transition barriers of all subresources of the specified resource that are not in @p newState.
+    ///
+    /// @param[in] resource The GPU resource to be transitioned.
+    /// @param     newState The new state of the resource.
+    /// @param     flags    Either @p D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY or @p D3D12_RESOURCE_BARRIER_FLAG_END_ONLY.
+    auto QueueSplitTransition(GpuResource                 &resource,
+                              D3D12_RESOURCE_STATES        newState,
+                              D3D12_RESOURCE_BARRIER_FLAGS flags) noexcept -> void;
+
+    /// @brief
+    ///   Allocate a temporary upload buffer whose offset is aligned up with @p D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT, so that it could be used as placed footprint of texture copies.
+    ///
+    /// @param size     Expected size in byte of the temp buffer to be allocated.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to create new temporary upload page.
+    YAGE_NODISCARD auto AllocateTextureUploadBuffer(size_t size) -> TempBufferAllocation;
+
+    /// @brief
+    ///   Copy pixels from temporary upload buffer to the specified mip level of texture.
+    ///
+    /// @param      allocation  The temporary upload buffer allocation that contains source pixels.
+    /// @param      width       Width of the source image.
+    /// @param      height      Height of the source image.
+    /// @param      srcFormat   Format of the source image.
+    /// @param      rowPitch    Row pitch size in byte of the source pixels. Must be aligned up with 256 bytes.
+    /// @param[out] dest        Destination texture to be copied to.
+    /// @param      mipLevel    Mip level of the destination texture to be copied to.
+    auto CopyTexture(const TempBufferAllocation &allocation,
+                     uint32_t                    width,
+                     uint32_t                    height,
+                     DXGI_FORMAT                 srcFormat,
+                     uint32_t                    rowPitch,
+                     PixelBuffer                &dest,
+                     uint32_t                    mipLevel) noexcept -> void;
+
+    /// @brief
+    ///   Reset shadowed pipeline state, primitive topology, viewport, scissor rectangle, vertex buffers and index buffer to the default state of a newly reset command list.
+    auto ResetBoundState() noexcept -> void;
+
+    /// @brief
+    ///   Record an indirect execution and invalidate shadowed bindings that are changed by the command signature.
+    ///
+    /// @param[in] signature        The command signature that describes layout of the argument buffer.
+    /// @param     maxCommandCount  Maximum number of commands to be executed.
+    /// @param[in] argumentBuffer   The D3D12 buffer that contains indirect arguments.
+    /// @param     argumentOffset   Offset in byte of the first command from start of @p argumentBuffer.
+    /// @param[in] countBuffer      The D3D12 buffer that contains command count. May be @p nullptr.
+    /// @param     countOffset      Offset in byte of the command count from start of @p countBuffer.
+    auto RecordExecuteIndirect(const CommandSignature &signature,
+                               uint32_t                maxCommandCount,
+                               ID3D12Resource         *argumentBuffer,
+                               uint64_t                argumentOffset,
+                               ID3D12Resource         *countBuffer,
+                               uint64_t                countOffset) noexcept -> void;
+
+    /// @brief
+    ///   Count a filtered redundant state call.
+    auto CountFilteredState() noexcept -> void {
+        ++filteredStateCount;
+        YAGE_PROFILE_COUNT(RedundantStatesFiltered, 1);
+    }
+
+    /// @brief
+    ///   Bind a single viewport if it differs from the current one.
+    ///
+    /// @param viewport The viewport to be bound.
+    auto BindViewport(const D3D12_VIEWPORT &viewport) noexcept -> void {
+        if (isViewportBound && viewport.TopLeftX == boundViewport.TopLeftX &&
+            viewport.TopLeftY == boundViewport.TopLeftY && viewport.Width == boundViewport.Width &&
+            viewport.Height == boundViewport.Height && viewport.MinDepth == boundViewport.MinDepth &&
+            viewport.MaxDepth == boundViewport.MaxDepth) {
+            CountFilteredState();
+            return;
+        }
+
+        isViewportBound = true;
+        boundViewport   = viewport;
+        commandList->RSSetViewports(1, &viewport);
+    }
+
+    /// @brief
+    ///   Bind a single scissor rectangle if it differs from the current one.
+    ///
+    /// @param rect     The scissor rectangle to be bound.
+    auto BindScissorRect(const D3D12_RECT &rect) noexcept -> void {
+        if (isScissorRectBound && rect.left == boundScissorRect.left && rect.top == boundScissorRect.top &&
+            rect.right == boundScissorRect.right && rect.bottom == boundScissorRect.bottom) {
+            CountFilteredState();
+            return;
+        }
+
+        isScissorRectBound = true;
+        boundScissorRect   = rect;
+        commandList->RSSetScissorRects(1, &rect);
+    }
+
+    /// @brief
+    ///   Bind a vertex buffer view to the specified slot if it differs from the current one.
+    ///
+    /// @param slot     The slot to bind the vertex buffer.
+    /// @param vbv      The vertex buffer view to be bound.
+    auto BindVertexBuffer(uint32_t slot, const D3D12_VERTEX_BUFFER_VIEW &vbv) noexcept -> void {
+        D3D12_VERTEX_BUFFER_VIEW &bound = boundVertexBuffers[slot];
+        if (vbv.BufferLocation == bound.BufferLocation && vbv.SizeInBytes == bound.SizeInBytes &&
+            vbv.StrideInBytes == bound.StrideInBytes) {
+            CountFilteredState();
+            return;
+        }
+
+        bound = vbv;
+        commandList->IASetVertexBuffers(slot, 1, &vbv);
+    }
+
+    /// @brief
+    ///   Bind an index buffer view if it differs from the current one.
+    ///
+    /// @param ibv      The index buffer view to be bound.
+    auto BindIndexBuffer(const D3D12_INDEX_BUFFER_VIEW &ibv) noexcept -> void {
+        if (ibv.BufferLocation == boundIndexBuffer.BufferLocation && ibv.SizeInBytes == boundIndexBuffer.SizeInBytes &&
+            ibv.Format == boundIndexBuffer.Format) {
+            CountFilteredState();
+            return;
+        }
+
+        boundIndexBuffer = ibv;
+        commandList->IASetIndexBuffer(&ibv);
+    }
+
+    /// @brief  Maximum number of pending resource barriers. Pending barriers are flushed once this limit is reached.
+    static constexpr const uint32_t MAX_PENDING_BARRIERS = 16;
+
 private:
     /// @brief  The render device that is used to create this command buffer.
     RenderDevice &renderDevice;
 
-    /// @brief  Direct D3D12 command list.
+    /// @brief  Type of this command buffer.
+    const D3D12_COMMAND_LIST_TYPE commandListType;
+
+    /// @brief  D3D12 command list.
     Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> commandList;
 
+    /// @brief  D3D12 command list that supports ray tracing. This is null if ray tracing is not supported.
+    Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList4> commandList4;
+
+#ifdef __ID3D12GraphicsCommandList6_INTERFACE_DEFINED__
+    /// @brief  D3D12 command list that supports mesh dispatches. This is null if mesh shaders are not supported.
+    Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList6> commandList6;
+#endif
+
+#ifdef __ID3D12GraphicsCommandList7_INTERFACE_DEFINED__
+    /// @brief  D3D12 command list that supports enhanced barriers. This is null if enhanced barriers are not supported.
+    Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList7> commandList7;
+#endif
+
     /// @brief  Current command allocator used by the command list.
     ID3D12CommandAllocator *allocator;
 
     /// @brief  The sync point that indicates when last submittion of this command buffer will be finished.
     uint64_t lastSubmitSyncPoint;
 
+    /// @brief  Sync points that the command queue should wait for before executing next submission.
+    std::vector<uint64_t> pendingWaitSyncPoints;
+
+    /// @brief  Readback buffers that are written by commands of current submission.
+    std::vector<YaGE::ReadbackBuffer *> pendingReadbacks;
+
     /// @brief  Temp buffer allocator that is used to allocate temporary upload and unordered access buffers.
     TempBufferAllocator tempBufferAllocator;
 
@@ -713,6 +1838,45 @@ private:
 
     /// @brief  Dynamic sampler descriptor heap.
     DynamicDescriptorHeap dynamicSamplerHeap;
+
+    /// @brief  Whether resource states are tracked by this command buffer. Disabled when resource states are managed by a render graph.
+    bool stateTracking;
+
+    /// @brief  Resources declared by the render graph pass that is being recorded. Only used to validate resource usage in debug builds. Null if no render graph pass is being recorded.
+    const std::vector<GpuResource *> *declaredResources;
+
+    /// @brief  Number of pending resource barriers.
+    uint32_t pendingBarrierCount;
+
+    /// @brief  Resource barriers that have not been recorded into the command list.
+    D3D12_RESOURCE_BARRIER pendingBarriers[MAX_PENDING_BARRIERS];
+
+    /// @brief  Pipeline state that is currently bound to the command list.
+    ID3D12PipelineState *boundPipelineState;
+
+    /// @brief  Primitive topology that is currently bound to the command list.
+    D3D12_PRIMITIVE_TOPOLOGY boundTopology;
+
+    /// @brief  Whether a single viewport is bound and shadowed by @p boundViewport.
+    bool isViewportBound;
+
+    /// @brief  Whether a single scissor rectangle is bound and shadowed by @p boundScissorRect.
+    bool isScissorRectBound;
+
+    /// @brief  Viewport that is currently bound to the command list.
+    D3D12_VIEWPORT boundViewport;
+
+    /// @brief  Scissor rectangle that is currently bound to the command list.
+    D3D12_RECT boundScissorRect;
+
+    /// @brief  Vertex buffer views that are currently bound to the command list.
+    D3D12_VERTEX_BUFFER_VIEW boundVertexBuffers[D3D12_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT];
+
+    /// @brief  Index buffer view that is currently bound to the command list.
+    D3D12_INDEX_BUFFER_VIEW boundIndexBuffer;
+
+    /// @brief  Number of redundant state calls that are filtered since this command buffer is created.
+    uint64_t filteredStateCount;
 };
 
 } // namespace YaGE
@@ -0,0 +1,60 @@
+#include "CommandSignature.h"
+#include "../Core/Exception.h"
+#include "RenderDevice.h"
+
+using namespace YaGE;
+
+YaGE::CommandSignature::CommandSignature(uint32_t                            stride,
+                                         uint32_t                            argumentCount,
+                                         const D3D12_INDIRECT_ARGUMENT_DESC *arguments,
+                                         YaGE::RootSignature                *rootSignature)
+    : commandSignature(), byteStride(stride), vertexBufferMask(), changesIndexBuffer() {
+    for (uint32_t i = 0; i < argumentCount; ++i) {
+        if (arguments[i].Type == D3D12_INDIRECT_ARGUMENT_TYPE_VERTEX_BUFFER_VIEW)
+            vertexBufferMask |= (1U << arguments[i].VertexBuffer.Slot);
+        else if (arguments[i].Type == D3D12_INDIRECT_ARGUMENT_TYPE_INDEX_BUFFER_VIEW)
+            changesIndexBuffer = true;
+    }
+
+    const D3D12_COMMAND_SIGNATURE_DESC desc{
+        /* ByteStride       = */ stride,
+        /* NumArgumentDescs = */ argumentCount,
+        /* pArgumentDescs   = */ arguments,
+        /* NodeMask         = */ 0,
+    };
+
+    ID3D12RootSignature *const rootSig = rootSignature == nullptr ? nullptr : rootSignature->D3D12RootSignature();
+    ID3D12Device1 *const       device  = RenderDevice::Singleton().Device();
+
+    HRESULT hr = device->CreateCommandSignature(&desc, rootSig, IID_PPV_ARGS(commandSignature.GetAddressOf()));
+    if (FAILED(hr))
+        throw RenderAPIException(hr, u"Failed to create command signature.");
+}
+
+YaGE::CommandSignature::~CommandSignature() noexcept {}
+
+auto YaGE::CommandSignature::DrawSignature() -> CommandSignature & {
+    static const D3D12_INDIRECT_ARGUMENT_DESC argument{D3D12_INDIRECT_ARGUMENT_TYPE_DRAW};
+    static CommandSignature                  instance(sizeof(D3D12_DRAW_ARGUMENTS), 1, &argument);
+    return instance;
+}
+
+auto YaGE::CommandSignature::DrawIndexedSignature() -> CommandSignature & {
+    static const D3D12_INDIRECT_ARGUMENT_DESC argument{D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED};
+    static CommandSignature                  instance(sizeof(D3D12_DRAW_INDEXED_ARGUMENTS), 1, &argument);
+    return instance;
+}
+
+auto YaGE::CommandSignature::DispatchSignature() -> CommandSignature & {
+    static const D3D12_INDIRECT_ARGUMENT_DESC argument{D3D12_INDIRECT_ARGUMENT_TYPE_DISPATCH};
+    static CommandSignature                  instance(sizeof(D3D12_DISPATCH_ARGUMENTS), 1, &argument);
+    return instance;
+}
+
+#ifdef __ID3D12GraphicsCommandList6_INTERFACE_DEFINED__
+auto YaGE::CommandSignature::DispatchMeshSignature() -> CommandSignature & {
+    static const D3D12_INDIRECT_ARGUMENT_DESC argument{D3D12_INDIRECT_ARGUMENT_TYPE_DISPATCH_MESH};
+    static CommandSignature                  instance(sizeof(D3D12_DISPATCH_MESH_ARGUMENTS), 1, &argument);
+    return instance;
+}
+#endif
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "RootSignature.h"
+
+namespace YaGE {
+
+class CommandSignature {
+public:
+    /// @brief
+    ///   Create a command signature that describes layout of indirect arguments for @p CommandBuffer::ExecuteIndirect().
+    /// @remarks
+    ///   The last argument must be a draw, indexed draw, dispatch or mesh dispatch argument. Arguments before it could change vertex buffers, index buffer, root constants and root descriptors of each command.
+    ///
+    /// @param stride           Size in byte of each command in the argument buffer.
+    /// @param argumentCount    Number of arguments of each command.
+    /// @param arguments        Array of indirect arguments of each command.
+    /// @param rootSignature    Root signature that root constant and root descriptor arguments refer to. Must be @p nullptr if the command signature does not change any root argument.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to create D3D12 command signature.
+    YAGE_API CommandSignature(uint32_t                            stride,
+                              uint32_t                            argumentCount,
+                              const D3D12_INDIRECT_ARGUMENT_DESC *arguments,
+                              YaGE::RootSignature                *rootSignature = nullptr);
+
+    /// @brief
+    ///   Copy constructor is disabled.
+    CommandSignature(const CommandSignature &) = delete;
+
+    /// @brief
+    ///   Copy assignment is disabled.
+    auto operator=(const CommandSignature &) = delete;
+
+    /// @brief
+    ///   Destroy this command signature.
+    YAGE_API ~CommandSignature() noexcept;
+
+    /// @brief
+    ///   Get D3D12 command signature object.
+    ///
+    /// @return ID3D12CommandSignature *
+    ///   Return D3D12 command signature object.
+    YAGE_NODISCARD auto D3D12CommandSignature() const noexcept -> ID3D12CommandSignature * {
+        return commandSignature.Get();
+    }
+
+    /// @brief
+    ///   Get size in byte of each command in the argument buffer.
+    ///
+    /// @return uint32_t
+    ///   Return size in byte of each command.
+    YAGE_NODISCARD auto ByteStride() const noexcept -> uint32_t { return byteStride; }
+
+    /// @brief
+    ///   Get mask of vertex buffer slots that are changed by this command signature.
+    ///
+    /// @return uint32_t
+    ///   Return bitmask of vertex buffer slots that are changed by this command signature.
+    YAGE_NODISCARD auto VertexBufferMask() const noexcept -> uint32_t { return vertexBufferMask; }
+
+    /// @brief
+    ///   Checks if this command signature changes index buffer.
+    ///
+    /// @return bool
+    /// @retval true    This command signature changes index buffer.
+    /// @retval false   This command signature does not change index buffer.
+    YAGE_NODISCARD auto ChangesIndexBuffer() const noexcept -> bool { return changesIndexBuffer; }
+
+    /// @brief
+    ///   Get command signature of draw commands. Each command is a @p D3D12_DRAW_ARGUMENTS.
+    ///
+    /// @return CommandSignature &
+    ///   Return reference to the draw command signature.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to create the command signature.
+    YAGE_NODISCARD YAGE_API static auto DrawSignature() -> CommandSignature &;
+
+    /// @brief
+    ///   Get command signature of indexed draw commands. Each command is a @p D3D12_DRAW_INDEXED_ARGUMENTS.
+    ///
+    /// @return CommandSignature &
+    ///   Return reference to the indexed draw command signature.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to create the command signature.
+    YAGE_NODISCARD YAGE_API static auto DrawIndexedSignature() -> CommandSignature &;
+
+    /// @brief
+    ///   Get command signature of dispatch commands. Each command is a @p D3D12_DISPATCH_ARGUMENTS.
+    ///
+    /// @return CommandSignature &
+    ///   Return reference to the dispatch command signature.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to create the command signature.
+    YAGE_NODISCARD YAGE_API static auto DispatchSignature() -> CommandSignature &;
+
+#ifdef __ID3D12GraphicsCommandList6_INTERFACE_DEFINED__
+    /// @brief
+    ///   Get command signature of mesh dispatch commands. Each command is a @p D3D12_DISPATCH_MESH_ARGUMENTS.
+    ///
+    /// @return CommandSignature &
+    ///   Return reference to the mesh dispatch command signature.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to create the command signature.
+    YAGE_NODISCARD YAGE_API static auto DispatchMeshSignature() -> CommandSignature &;
+#endif
+
+private:
+    /// @brief  D3D12 command signature object.
+    Microsoft::WRL::ComPtr<ID3D12CommandSignature> commandSignature;
+
+    /// @brief  Size in byte of each command in the argument buffer.
+    uint32_t byteStride;
+
+    /// @brief  Bitmask of vertex buffer slots that are changed by this command signature.
+    uint32_t vertexBufferMask;
+
+    /// @brief  Whether this command signature changes index buffer.
+    bool changesIndexBuffer;
+};
+
+} // namespace YaGE
@@ -38,60 +38,102 @@ YaGE::DepthBuffer::DepthBuffer() noexcept
 
 YaGE::DepthBuffer::DepthBuffer(uint32_t width, uint32_t height, DXGI_FORMAT format, uint32_t sampleCount)
     : PixelBuffer(), clearDepth(1.0f), clearStencil(), dsv(), depthReadOnlyView(), srv() {
-    if (sampleCount == 0)
-        sampleCount = 1;
+    const D3D12_RESOURCE_DESC desc = ResourceDesc(width, height, format, sampleCount);
 
     this->width       = width;
     this->height      = height;
     this->arraySize   = 1;
-    this->sampleCount = sampleCount;
+    this->sampleCount = desc.SampleDesc.Count;
     this->mipLevels   = 1;
     this->pixelFormat = format;
 
-    // Create D3D12 resources.
-    RenderDevice &device = RenderDevice::Singleton();
-
-    { // Create ID3D12Resource.
-        const D3D12_HEAP_PROPERTIES heapProps{
-            /* Type                 = */ D3D12_HEAP_TYPE_DEFAULT,
-            /* CPUPageProperty      = */ D3D12_CPU_PAGE_PROPERTY_UNKNOWN,
-            /* MemoryPoolPreference = */ D3D12_MEMORY_POOL_UNKNOWN,
-            /* CreationNodeMask     = */ 0,
-            /* VisibleNodeMask      = */ 0,
-        };
-
-        const D3D12_RESOURCE_DESC desc{
-            /* Dimension        = */ D3D12_RESOURCE_DIMENSION_TEXTURE2D,
-            /* Alignment        = */ 0,
-            /* Width            = */ width,
-            /* Height           = */ height,
-            /* DepthOrArraySize = */ 1,
-            /* MipLevels        = */ 1,
-            /* Format           = */ format,
-            /* SampleDesc       = */
-            {
-                /* Count   = */ sampleCount,
-                /* Quality = */ 0,
-            },
-            /* Layout = */ D3D12_TEXTURE_LAYOUT_UNKNOWN,
-            /* Flags  = */ D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL,
-        };
-
-        D3D12_CLEAR_VALUE clearValue;
-        clearValue.Format               = format;
-        clearValue.DepthStencil.Depth   = 1.0f;
-        clearValue.DepthStencil.Stencil = 0;
-
-        HRESULT hr = device.Device()->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &desc,
-                                                              D3D12_RESOURCE_STATE_COMMON, &clearValue,
-                                                              IID_PPV_ARGS(resource.GetAddressOf()));
-        if (FAILED(hr))
-            throw RenderAPIException(hr, u"Failed to create ID3D12Resource for DepthBuffer.");
-    }
+    D3D12_CLEAR_VALUE clearValue;
+    clearValue.Format               = format;
+    clearValue.DepthStencil.Depth   = 1.0f;
+    clearValue.DepthStencil.Stencil = 0;
+
+    HRESULT hr = CreateResource(D3D12_HEAP_TYPE_DEFAULT, desc, D3D12_RESOURCE_STATE_COMMON, &clearValue);
+    if (FAILED(hr))
+        throw RenderAPIException(hr, u"Failed to create ID3D12Resource for DepthBuffer.");
+
+    CreateViews();
+}
+
+YaGE::DepthBuffer::DepthBuffer(ID3D12Heap *heap, uint64_t heapOffset, const D3D12_RESOURCE_DESC &desc)
+    : PixelBuffer(), clearDepth(1.0f), clearStencil(), dsv(), depthReadOnlyView(), srv() {
+    this->width       = static_cast<uint32_t>(desc.Width);
+    this->height      = desc.Height;
+    this->arraySize   = 1;
+    this->sampleCount = desc.SampleDesc.Count;
+    this->mipLevels   = 1;
+    this->pixelFormat = desc.Format;
+
+    D3D12_CLEAR_VALUE clearValue;
+    clearValue.Format               = desc.Format;
+    clearValue.DepthStencil.Depth   = 1.0f;
+    clearValue.DepthStencil.Stencil = 0;
+
+    HRESULT hr = CreatePlacedResource(heap, heapOffset, desc, D3D12_RESOURCE_STATE_COMMON, &clearValue);
+    if (FAILED(hr))
+        throw RenderAPIException(hr, u"Failed to create placed ID3D12Resource for DepthBuffer.");
+
+    CreateViews();
+}
+
+YaGE::DepthBuffer::DepthBuffer(DepthBuffer &&other) noexcept
+    : PixelBuffer(std::move(other)),
+      clearDepth(other.clearDepth),
+      clearStencil(other.clearStencil),
+      dsv(std::move(other.dsv)),
+      depthReadOnlyView(std::move(other.depthReadOnlyView)),
+      srv(std::move(other.srv)) {
+    other.clearDepth   = 1.0f;
+    other.clearStencil = 0;
+}
+
+auto YaGE::DepthBuffer::operator=(DepthBuffer &&other) noexcept -> DepthBuffer & {
+    PixelBuffer::operator=(std::move(other));
+
+    clearDepth        = other.clearDepth;
+    clearStencil      = other.clearStencil;
+    dsv               = std::move(other.dsv);
+    depthReadOnlyView = std::move(other.depthReadOnlyView);
+    srv               = std::move(other.srv);
+
+    other.clearDepth   = 1.0f;
+    other.clearStencil = 0;
 
+    return *this;
+}
+
+YaGE::DepthBuffer::~DepthBuffer() noexcept {}
+
+YAGE_NODISCARD auto YaGE::DepthBuffer::ResourceDesc(uint32_t    width,
+                                                    uint32_t    height,
+                                                    DXGI_FORMAT format,
+                                                    uint32_t    sampleCount) noexcept -> D3D12_RESOURCE_DESC {
+    return D3D12_RESOURCE_DESC{
+        /* Dimension        = */ D3D12_RESOURCE_DIMENSION_TEXTURE2D,
+        /* Alignment        = */ 0,
+        /* Width            = */ width,
+        /* Height           = */ height,
+        /* DepthOrArraySize = */ 1,
+        /* MipLevels        = */ 1,
+        /* Format           = */ format,
+        /* SampleDesc       = */
+        {
+            /* Count   = */ (sampleCount == 0 ? 1U : sampleCount),
+            /* Quality = */ 0,
+        },
+        /* Layout = */ D3D12_TEXTURE_LAYOUT_UNKNOWN,
+        /* Flags  = */ D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL,
+    };
+}
+
+auto YaGE::DepthBuffer::CreateViews() -> void {
     { // Create depth stencil view.
         D3D12_DEPTH_STENCIL_VIEW_DESC desc;
-        desc.Format = format;
+        desc.Format = pixelFormat;
         desc.Flags  = D3D12_DSV_FLAG_NONE;
 
         if (sampleCount > 1) {
@@ -106,7 +148,7 @@ YaGE::DepthBuffer::DepthBuffer(uint32_t width, uint32_t height, DXGI_FORMAT form
 
     { // Create depth read-only view.
         D3D12_DEPTH_STENCIL_VIEW_DESC desc;
-        desc.Format = format;
+        desc.Format = pixelFormat;
         desc.Flags  = D3D12_DSV_FLAG_READ_ONLY_DEPTH;
 
         if (sampleCount > 1) {
@@ -121,7 +163,7 @@ YaGE::DepthBuffer::DepthBuffer(uint32_t width, uint32_t height, DXGI_FORMAT form
 
     { // Create shader resource view.
         D3D12_SHADER_RESOURCE_VIEW_DESC desc;
-        desc.Format                  = GetDepthFormat(format);
+        desc.Format                  = GetDepthFormat(pixelFormat);
         desc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
 
         if (sampleCount > 1) {
@@ -137,31 +179,3 @@ YaGE::DepthBuffer::DepthBuffer(uint32_t width, uint32_t height, DXGI_FORMAT form
         srv.Create(this->resource.Get(), desc);
     }
 }
-
-YaGE::DepthBuffer::DepthBuffer(DepthBuffer &&other) noexcept
-    : PixelBuffer(std::move(other)),
-      clearDepth(other.clearDepth),
-      clearStencil(other.clearStencil),
-      dsv(std::move(other.dsv)),
-      depthReadOnlyView(std::move(other.depthReadOnlyView)),
-      srv(std::move(other.srv)) {
-    other.clearDepth   = 1.0f;
-    other.clearStencil = 0;
-}
-
-auto YaGE::DepthBuffer::operator=(DepthBuffer &&other) noexcept -> DepthBuffer & {
-    PixelBuffer::operator=(std::move(other));
-
-    clearDepth        = other.clearDepth;
-    clearStencil      = other.clearStencil;
-    dsv               = std::move(other.dsv);
-    depthReadOnlyView = std::move(other.depthReadOnlyView);
-    srv               = std::move(other.srv);
-
-    other.clearDepth   = 1.0f;
-    other.clearStencil = 0;
-
-    return *this;
-}
-
-YaGE::DepthBuffer::~DepthBuffer() noexcept {}
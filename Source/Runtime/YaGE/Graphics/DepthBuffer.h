@@ -23,6 +23,19 @@ public:
     ///   Thrown if failed to create D3D12 resource for this depth buffer.
     YAGE_API DepthBuffer(uint32_t width, uint32_t height, DXGI_FORMAT format, uint32_t sampleCount = 1);
 
+    /// @brief
+    ///   Create a new depth buffer that is placed in the specified heap. Placed depth buffers could alias memory with other placed resources in the same heap.
+    /// @note
+    ///   Content of an aliased depth buffer is undefined. An aliasing barrier must be recorded before using it, and it must be initialized with a clear, discard or copy operation.
+    ///
+    /// @param[in] heap         The heap that this depth buffer is placed in. The heap must be alive until this depth buffer is destroyed.
+    /// @param     heapOffset   Offset in byte from start of the heap. Must be aligned with the alignment of this resource.
+    /// @param     desc         Description of the depth buffer resource. This is usually created by @p ResourceDesc().
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to create D3D12 resource for this depth buffer.
+    YAGE_API DepthBuffer(ID3D12Heap *heap, uint64_t heapOffset, const D3D12_RESOURCE_DESC &desc);
+
     /// @brief
     ///   Move constructor of DepthBuffer. The moved DepthBuffer will be invalidated.
     ///
@@ -89,6 +102,28 @@ public:
     ///   Return depth shader resource view CPU descriptor handle of this depth buffer.
     YAGE_NODISCARD auto DepthShaderResourceView() const noexcept -> CpuDescriptorHandle { return srv; }
 
+    /// @brief
+    ///   Get D3D12 resource description of a depth buffer. This is the same description that is used by the constructor.
+    ///
+    /// @param width        Width in pixel of the depth buffer.
+    /// @param height       Height in pixel of the depth buffer.
+    /// @param format       Pixel format of the depth buffer.
+    /// @param sampleCount  Number of samples of the depth buffer.
+    ///
+    /// @return D3D12_RESOURCE_DESC
+    ///   Return description of the depth buffer resource.
+    YAGE_NODISCARD YAGE_API static auto
+    ResourceDesc(uint32_t width, uint32_t height, DXGI_FORMAT format, uint32_t sampleCount = 1) noexcept
+        -> D3D12_RESOURCE_DESC;
+
+private:
+    /// @brief
+    ///   Create depth stencil views and shader resource view for the whole depth buffer.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to allocate descriptors.
+    auto CreateViews() -> void;
+
 private:
     /// @brief  Depth clear value of this depth buffer. Default value is 1.0f.
     float clearDepth;
@@ -1,9 +1,83 @@
 #include "Descriptor.h"
 #include "../Core/Exception.h"
+#include "GlobalDescriptorHeap.h"
 #include "RenderDevice.h"
 
+#include <atomic>
+#include <cassert>
+
 using namespace YaGE;
 
+namespace {
+
+/// @brief  Number of descriptors in each CPU descriptor heap. Use a small number of descriptors to avoid wasting too
+///         much memory.
+static constexpr const uint32_t CPU_DESCRIPTOR_HEAP_SIZE = 64;
+
+/// @brief  Number of descriptor heap types.
+static constexpr const uint32_t DESCRIPTOR_HEAP_TYPE_COUNT = D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES;
+
+/// @brief  Maximum number of descriptors in each thread-local descriptor cache.
+static constexpr const uint32_t THREAD_CACHE_CAPACITY = 64;
+
+/// @brief  Number of descriptors to be moved between thread-local caches and descriptor allocators at a time.
+static constexpr const uint32_t THREAD_CACHE_BATCH_SIZE = 32;
+
+/// @brief  Set once any CPU descriptor allocator is destroyed. CPU descriptor allocators are only owned by the render
+///         device, so that this happens only on device teardown.
+static std::atomic_bool descriptorAllocatorDestroyed{false};
+
+struct CpuDescriptorCache {
+    /// @brief  Allocators that cached descriptors belong to. Indexed by descriptor heap type.
+    CpuDescriptorAllocator *owners[DESCRIPTOR_HEAP_TYPE_COUNT];
+
+    /// @brief  Cached descriptors. Indexed by descriptor heap type.
+    CpuDescriptorHandle handles[DESCRIPTOR_HEAP_TYPE_COUNT][THREAD_CACHE_CAPACITY];
+
+    /// @brief  Number of cached descriptors. Indexed by descriptor heap type.
+    uint32_t counts[DESCRIPTOR_HEAP_TYPE_COUNT];
+
+    /// @brief
+    ///   Return all cached descriptors of the specified type to the owner allocator.
+    ///
+    /// @param type     Descriptor heap type of the cached descriptors.
+    auto Flush(uint32_t type) noexcept -> void {
+        // Thread local caches may be destroyed after the render device, for example on worker threads of the thread
+        // pool singleton. Descriptors of destroyed allocators are dropped because their heaps have been released.
+        const bool ownerDestroyed = descriptorAllocatorDestroyed.load(std::memory_order_acquire);
+        if (owners[type] != nullptr && counts[type] != 0 && !ownerDestroyed)
+            owners[type]->FreeBatch(handles[type], counts[type]);
+        counts[type] = 0;
+    }
+
+    /// @brief
+    ///   Return all cached descriptors to their owner allocators on thread exit.
+    ~CpuDescriptorCache() noexcept {
+        for (uint32_t i = 0; i < DESCRIPTOR_HEAP_TYPE_COUNT; ++i)
+            Flush(i);
+    }
+};
+
+static thread_local CpuDescriptorCache threadDescriptorCache{};
+
+/// @brief
+///   Allocate a new bindless descriptor for a view that is being created or recreated. The previous bindless descriptor
+///   may still be read by submitted commands, so that it is freed with the deferred retirement instead of overwritten.
+///
+/// @param[in] globalHeap   The global descriptor heap that the bindless descriptor belongs to.
+/// @param[in, out] index   Index of the previous bindless descriptor. Receives index of the new bindless descriptor.
+///
+/// @throw RenderAPIException
+///   Thrown if there is no free descriptor in the bindless region.
+auto ReplaceBindless(GlobalDescriptorHeap &globalHeap, uint32_t &index) -> void {
+    const uint32_t newIndex = globalHeap.AllocateBindless();
+    if (index != UINT32_MAX)
+        globalHeap.FreeBindless(index);
+    index = newIndex;
+}
+
+} // namespace
+
 YaGE::CpuDescriptorAllocator::CpuDescriptorAllocator() noexcept
     : device(),
       heapType(),
@@ -11,10 +85,21 @@ YaGE::CpuDescriptorAllocator::CpuDescriptorAllocator() noexcept
       heapPool(),
       heapPoolMutex(),
       freeHandles(),
+      freeRanges(),
       currentHandle(),
       freeDescriptorCount() {}
 
-YaGE::CpuDescriptorAllocator::~CpuDescriptorAllocator() noexcept {}
+YaGE::CpuDescriptorAllocator::~CpuDescriptorAllocator() noexcept {
+    descriptorAllocatorDestroyed.store(true, std::memory_order_release);
+
+    // Drop descriptors of this allocator that are cached by current thread.
+    CpuDescriptorCache &cache = threadDescriptorCache;
+    const uint32_t      type  = static_cast<uint32_t>(heapType);
+    if (cache.owners[type] == this) {
+        cache.owners[type] = nullptr;
+        cache.counts[type] = 0;
+    }
+}
 
 auto YaGE::CpuDescriptorAllocator::Initialize(ID3D12Device1 *dev, D3D12_DESCRIPTOR_HEAP_TYPE descriptorType) noexcept
     -> void {
@@ -24,48 +109,160 @@ auto YaGE::CpuDescriptorAllocator::Initialize(ID3D12Device1 *dev, D3D12_DESCRIPT
 }
 
 YAGE_NODISCARD auto YaGE::CpuDescriptorAllocator::Allocate() -> CpuDescriptorHandle {
-    { // Try to get one from free handle queue.
-        CpuDescriptorHandle handle;
-        if (freeHandles.try_pop(handle))
-            return handle;
+    CpuDescriptorCache &cache = threadDescriptorCache;
+    const uint32_t      type  = static_cast<uint32_t>(heapType);
+
+    // Descriptors in the thread-local cache may belong to another allocator.
+    if (cache.owners[type] != this) {
+        cache.Flush(type);
+        cache.owners[type] = this;
     }
 
-    std::lock_guard<std::mutex> lock(heapPoolMutex);
+    if (cache.counts[type] == 0) {
+        AllocateBatch(cache.handles[type], THREAD_CACHE_BATCH_SIZE);
+        cache.counts[type] = THREAD_CACHE_BATCH_SIZE;
+    }
 
-    // No more free descriptors. Create a new descriptor heap.
-    if (freeDescriptorCount == 0) {
-        Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> newHeap;
+    cache.counts[type] -= 1;
+    return cache.handles[type][cache.counts[type]];
+}
 
-        // Use a small number of descriptors to avoid wasting too much memory.
-        const D3D12_DESCRIPTOR_HEAP_DESC desc{
-            /* Type           = */ heapType,
-            /* NumDescriptors = */ 64,
-            /* Flags          = */ D3D12_DESCRIPTOR_HEAP_FLAG_NONE,
-            /* NodeMask       = */ 0,
-        };
+auto YaGE::CpuDescriptorAllocator::Free(CpuDescriptorHandle handle) noexcept -> void {
+    CpuDescriptorCache &cache = threadDescriptorCache;
+    const uint32_t      type  = static_cast<uint32_t>(heapType);
 
-        HRESULT hr = device->CreateDescriptorHeap(&desc, IID_PPV_ARGS(newHeap.GetAddressOf()));
-        if (FAILED(hr))
-            throw RenderAPIException(hr, u"Failed to create new descriptor heap.");
+    if (cache.owners[type] != this) {
+        cache.Flush(type);
+        cache.owners[type] = this;
+    }
+
+    // Return half of the cached descriptors if the cache is full.
+    if (cache.counts[type] == THREAD_CACHE_CAPACITY) {
+        cache.counts[type] -= THREAD_CACHE_BATCH_SIZE;
+        FreeBatch(cache.handles[type] + cache.counts[type], THREAD_CACHE_BATCH_SIZE);
+    }
 
-        currentHandle       = newHeap->GetCPUDescriptorHandleForHeapStart();
-        freeDescriptorCount = desc.NumDescriptors;
+    cache.handles[type][cache.counts[type]] = handle;
+    cache.counts[type] += 1;
+}
+
+YAGE_NODISCARD auto YaGE::CpuDescriptorAllocator::AllocateContiguous(uint32_t count) -> CpuDescriptorHandle {
+    assert(count != 0);
 
-        heapPool.push(std::move(newHeap));
+    std::lock_guard<std::mutex> lock(heapPoolMutex);
+
+    // Reuse a free range of the same size first.
+    auto ranges = freeRanges.find(count);
+    if (ranges != freeRanges.end() && !ranges->second.empty()) {
+        CpuDescriptorHandle result = ranges->second.back();
+        ranges->second.pop_back();
+        return result;
+    }
+
+    if (freeDescriptorCount < count) {
+        HRESULT hr = NewHeap(count > CPU_DESCRIPTOR_HEAP_SIZE ? count : CPU_DESCRIPTOR_HEAP_SIZE);
+        if (FAILED(hr))
+            throw RenderAPIException(hr, u"Failed to create new descriptor heap.");
     }
 
     CpuDescriptorHandle result = currentHandle;
 
-    currentHandle += descriptorSize;
-    freeDescriptorCount -= 1;
+    currentHandle += static_cast<ptrdiff_t>(count) * descriptorSize;
+    freeDescriptorCount -= count;
 
     return result;
 }
 
+auto YaGE::CpuDescriptorAllocator::FreeContiguous(CpuDescriptorHandle first, uint32_t count) noexcept -> void {
+    if (count == 0)
+        return;
+
+    std::lock_guard<std::mutex> lock(heapPoolMutex);
+    freeRanges[count].push_back(first);
+}
+
+auto YaGE::CpuDescriptorAllocator::AllocateBatch(CpuDescriptorHandle *handles, uint32_t count) -> void {
+    std::lock_guard<std::mutex> lock(heapPoolMutex);
+
+    uint32_t allocated = 0;
+    while (allocated < count) {
+        // Reuse free handles first.
+        if (!freeHandles.empty()) {
+            handles[allocated++] = freeHandles.back();
+            freeHandles.pop_back();
+            continue;
+        }
+
+        // Split free contiguous ranges before creating a new descriptor heap.
+        if (freeDescriptorCount == 0 && SplitFreeRange())
+            continue;
+
+        // No more free descriptors. Create a new descriptor heap.
+        if (freeDescriptorCount == 0) {
+            HRESULT hr = NewHeap(CPU_DESCRIPTOR_HEAP_SIZE);
+            if (FAILED(hr)) {
+                freeHandles.insert(freeHandles.end(), handles, handles + allocated);
+                throw RenderAPIException(hr, u"Failed to create new descriptor heap.");
+            }
+        }
+
+        handles[allocated++] = currentHandle;
+
+        currentHandle += descriptorSize;
+        freeDescriptorCount -= 1;
+    }
+}
+
+auto YaGE::CpuDescriptorAllocator::FreeBatch(const CpuDescriptorHandle *handles, uint32_t count) noexcept -> void {
+    std::lock_guard<std::mutex> lock(heapPoolMutex);
+    freeHandles.insert(freeHandles.end(), handles, handles + count);
+}
+
+auto YaGE::CpuDescriptorAllocator::NewHeap(uint32_t numDescriptors) noexcept -> HRESULT {
+    Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> newHeap;
+
+    const D3D12_DESCRIPTOR_HEAP_DESC desc{
+        /* Type           = */ heapType,
+        /* NumDescriptors = */ numDescriptors,
+        /* Flags          = */ D3D12_DESCRIPTOR_HEAP_FLAG_NONE,
+        /* NodeMask       = */ 0,
+    };
+
+    HRESULT hr = device->CreateDescriptorHeap(&desc, IID_PPV_ARGS(newHeap.GetAddressOf()));
+    if (FAILED(hr))
+        return hr;
+
+    // Do not waste remaining descriptors in current heap.
+    for (uint32_t i = 0; i < freeDescriptorCount; ++i)
+        freeHandles.push_back(currentHandle + static_cast<ptrdiff_t>(i) * descriptorSize);
+
+    currentHandle       = newHeap->GetCPUDescriptorHandleForHeapStart();
+    freeDescriptorCount = numDescriptors;
+
+    heapPool.push(std::move(newHeap));
+    return S_OK;
+}
+
+auto YaGE::CpuDescriptorAllocator::SplitFreeRange() noexcept -> bool {
+    for (auto &ranges : freeRanges) {
+        if (ranges.second.empty())
+            continue;
+
+        const CpuDescriptorHandle first = ranges.second.back();
+        ranges.second.pop_back();
+
+        for (uint32_t i = 0; i < ranges.first; ++i)
+            freeHandles.push_back(first + static_cast<ptrdiff_t>(i) * descriptorSize);
+        return true;
+    }
+
+    return false;
+}
+
 auto YaGE::ConstantBufferView::operator=(ConstantBufferView &&other) noexcept -> ConstantBufferView & {
     RenderDevice &device = RenderDevice::Singleton();
     if (!handle.IsNull())
-        device.FreeConstantBufferView(handle);
+        device.DeferFreeDescriptor(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, handle);
 
     handle       = other.handle;
     other.handle = CpuDescriptorHandle();
@@ -75,7 +272,7 @@ auto YaGE::ConstantBufferView::operator=(ConstantBufferView &&other) noexcept ->
 
 YaGE::ConstantBufferView::~ConstantBufferView() noexcept {
     if (!handle.IsNull())
-        RenderDevice::Singleton().FreeConstantBufferView(handle);
+        RenderDevice::Singleton().DeferFreeDescriptor(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, handle);
 }
 
 auto YaGE::ConstantBufferView::Create(uint64_t gpuAddress, uint32_t size) -> void {
@@ -104,102 +301,135 @@ auto YaGE::ConstantBufferView::Create(const D3D12_CONSTANT_BUFFER_VIEW_DESC &des
 auto YaGE::ShaderResourceView::operator=(ShaderResourceView &&other) noexcept -> ShaderResourceView & {
     RenderDevice &device = RenderDevice::Singleton();
     if (!handle.IsNull())
-        device.FreeShaderResourceView(handle);
+        device.DeferFreeDescriptor(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, handle);
+    if (bindlessIndex != UINT32_MAX)
+        GlobalDescriptorHeap::Singleton(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV).FreeBindless(bindlessIndex);
 
-    handle       = other.handle;
-    other.handle = CpuDescriptorHandle();
+    handle              = other.handle;
+    bindlessIndex       = other.bindlessIndex;
+    other.handle        = CpuDescriptorHandle();
+    other.bindlessIndex = UINT32_MAX;
 
     return *this;
 }
 
 YaGE::ShaderResourceView::~ShaderResourceView() noexcept {
     if (!handle.IsNull())
-        RenderDevice::Singleton().FreeShaderResourceView(handle);
+        RenderDevice::Singleton().DeferFreeDescriptor(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, handle);
+    if (bindlessIndex != UINT32_MAX)
+        GlobalDescriptorHeap::Singleton(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV).FreeBindless(bindlessIndex);
 }
 
 auto YaGE::ShaderResourceView::Create(ID3D12Resource *resource) -> void {
-    RenderDevice &device = RenderDevice::Singleton();
+    RenderDevice         &device     = RenderDevice::Singleton();
+    GlobalDescriptorHeap &globalHeap = GlobalDescriptorHeap::Singleton(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
 
     if (handle.IsNull())
         handle = device.AllocateShaderResourceView();
+    ReplaceBindless(globalHeap, bindlessIndex);
 
     device.Device()->CreateShaderResourceView(resource, nullptr, handle);
+    globalHeap.UpdateBindless(bindlessIndex, handle);
 }
 
 auto YaGE::ShaderResourceView::Create(ID3D12Resource *resource, const D3D12_SHADER_RESOURCE_VIEW_DESC &desc) -> void {
-    RenderDevice &device = RenderDevice::Singleton();
+    RenderDevice         &device     = RenderDevice::Singleton();
+    GlobalDescriptorHeap &globalHeap = GlobalDescriptorHeap::Singleton(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
 
     if (handle.IsNull())
         handle = device.AllocateShaderResourceView();
+    ReplaceBindless(globalHeap, bindlessIndex);
 
     device.Device()->CreateShaderResourceView(resource, &desc, handle);
+    globalHeap.UpdateBindless(bindlessIndex, handle);
 }
 
 auto YaGE::UnorderedAccessView::operator=(UnorderedAccessView &&other) noexcept -> UnorderedAccessView & {
     RenderDevice &device = RenderDevice::Singleton();
     if (!handle.IsNull())
-        device.FreeUnorderedAccessView(handle);
+        device.DeferFreeDescriptor(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, handle);
+    if (bindlessIndex != UINT32_MAX)
+        GlobalDescriptorHeap::Singleton(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV).FreeBindless(bindlessIndex);
 
-    handle       = other.handle;
-    other.handle = CpuDescriptorHandle();
+    handle              = other.handle;
+    bindlessIndex       = other.bindlessIndex;
+    other.handle        = CpuDescriptorHandle();
+    other.bindlessIndex = UINT32_MAX;
 
     return *this;
 }
 
 YaGE::UnorderedAccessView::~UnorderedAccessView() noexcept {
     if (!handle.IsNull())
-        RenderDevice::Singleton().FreeUnorderedAccessView(handle);
+        RenderDevice::Singleton().DeferFreeDescriptor(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, handle);
+    if (bindlessIndex != UINT32_MAX)
+        GlobalDescriptorHeap::Singleton(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV).FreeBindless(bindlessIndex);
 }
 
 auto YaGE::UnorderedAccessView::Create(ID3D12Resource *resource, const D3D12_UNORDERED_ACCESS_VIEW_DESC &desc) -> void {
-    RenderDevice &device = RenderDevice::Singleton();
+    RenderDevice         &device     = RenderDevice::Singleton();
+    GlobalDescriptorHeap &globalHeap = GlobalDescriptorHeap::Singleton(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
 
     if (handle.IsNull())
         handle = device.AllocateUnorderedAccessView();
+    ReplaceBindless(globalHeap, bindlessIndex);
 
     device.Device()->CreateUnorderedAccessView(resource, nullptr, &desc, handle);
+    globalHeap.UpdateBindless(bindlessIndex, handle);
 }
 
 auto YaGE::UnorderedAccessView::Create(ID3D12Resource                         *resource,
                                        ID3D12Resource                         *counter,
                                        const D3D12_UNORDERED_ACCESS_VIEW_DESC &desc) -> void {
-    RenderDevice &device = RenderDevice::Singleton();
+    RenderDevice         &device     = RenderDevice::Singleton();
+    GlobalDescriptorHeap &globalHeap = GlobalDescriptorHeap::Singleton(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
 
     if (handle.IsNull())
         handle = device.AllocateUnorderedAccessView();
+    ReplaceBindless(globalHeap, bindlessIndex);
 
     device.Device()->CreateUnorderedAccessView(resource, counter, &desc, handle);
+    globalHeap.UpdateBindless(bindlessIndex, handle);
 }
 
 auto YaGE::SamplerView::operator=(SamplerView &&other) noexcept -> SamplerView & {
     RenderDevice &device = RenderDevice::Singleton();
     if (!handle.IsNull())
-        device.FreeSamplerView(handle);
+        device.DeferFreeDescriptor(D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER, handle);
+    if (bindlessIndex != UINT32_MAX)
+        GlobalDescriptorHeap::Singleton(D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER).FreeBindless(bindlessIndex);
 
-    handle       = other.handle;
-    other.handle = CpuDescriptorHandle();
+    handle              = other.handle;
+    bindlessIndex       = other.bindlessIndex;
+    other.handle        = CpuDescriptorHandle();
+    other.bindlessIndex = UINT32_MAX;
 
     return *this;
 }
 
 YaGE::SamplerView::~SamplerView() noexcept {
     if (!handle.IsNull())
-        RenderDevice::Singleton().FreeSamplerView(handle);
+        RenderDevice::Singleton().DeferFreeDescriptor(D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER, handle);
+    if (bindlessIndex != UINT32_MAX)
+        GlobalDescriptorHeap::Singleton(D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER).FreeBindless(bindlessIndex);
 }
 
 auto YaGE::SamplerView::Create(const D3D12_SAMPLER_DESC &desc) -> void {
-    RenderDevice &device = RenderDevice::Singleton();
+    RenderDevice         &device     = RenderDevice::Singleton();
+    GlobalDescriptorHeap &globalHeap = GlobalDescriptorHeap::Singleton(D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER);
 
     if (handle.IsNull())
         handle = device.AllocateSamplerView();
+    ReplaceBindless(globalHeap, bindlessIndex);
 
     device.Device()->CreateSampler(&desc, handle);
+    globalHeap.UpdateBindless(bindlessIndex, handle);
 }
 
 auto YaGE::RenderTargetView::operator=(RenderTargetView &&other) noexcept -> RenderTargetView & {
     RenderDevice &device = RenderDevice::Singleton();
     if (!handle.IsNull())
-        device.FreeRenderTargetView(handle);
+        device.DeferFreeDescriptor(D3D12_DESCRIPTOR_HEAP_TYPE_RTV, handle);
 
     handle       = other.handle;
     other.handle = CpuDescriptorHandle();
@@ -209,7 +439,7 @@ auto YaGE::RenderTargetView::operator=(RenderTargetView &&other) noexcept -> Ren
 
 YaGE::RenderTargetView::~RenderTargetView() noexcept {
     if (!handle.IsNull())
-        RenderDevice::Singleton().FreeRenderTargetView(handle);
+        RenderDevice::Singleton().DeferFreeDescriptor(D3D12_DESCRIPTOR_HEAP_TYPE_RTV, handle);
 }
 
 auto YaGE::RenderTargetView::Create(ID3D12Resource *resource, const D3D12_RENDER_TARGET_VIEW_DESC &desc) -> void {
@@ -224,7 +454,7 @@ auto YaGE::RenderTargetView::Create(ID3D12Resource *resource, const D3D12_RENDER
 auto YaGE::DepthStencilView::operator=(DepthStencilView &&other) noexcept -> DepthStencilView & {
     RenderDevice &device = RenderDevice::Singleton();
     if (!handle.IsNull())
-        device.FreeDepthStencilView(handle);
+        device.DeferFreeDescriptor(D3D12_DESCRIPTOR_HEAP_TYPE_DSV, handle);
 
     handle       = other.handle;
     other.handle = CpuDescriptorHandle();
@@ -234,7 +464,7 @@ auto YaGE::DepthStencilView::operator=(DepthStencilView &&other) noexcept -> Dep
 
 YaGE::DepthStencilView::~DepthStencilView() noexcept {
     if (!handle.IsNull())
-        RenderDevice::Singleton().FreeDepthStencilView(handle);
+        RenderDevice::Singleton().DeferFreeDescriptor(D3D12_DESCRIPTOR_HEAP_TYPE_DSV, handle);
 }
 
 auto YaGE::DepthStencilView::Create(ID3D12Resource *resource, const D3D12_DEPTH_STENCIL_VIEW_DESC &desc) -> void {
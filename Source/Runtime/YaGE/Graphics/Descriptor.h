@@ -2,12 +2,13 @@
 
 #include "../Core/Common.h"
 
-#include <concurrent_queue.h>
 #include <d3d12.h>
 #include <wrl/client.h>
 
 #include <mutex>
 #include <stack>
+#include <unordered_map>
+#include <vector>
 
 namespace YaGE {
 
@@ -166,7 +167,7 @@ public:
     YAGE_API CpuDescriptorAllocator() noexcept;
 
     /// @brief
-    ///   Destroy this CPU descriptor allocator and free all descriptor heaps.
+    ///   Destroy this CPU descriptor allocator and free all descriptor heaps. Descriptors that are still cached by other threads are dropped when these threads exit.
     YAGE_API ~CpuDescriptorAllocator() noexcept;
 
     /// @brief
@@ -179,7 +180,7 @@ public:
     /// @brief
     ///   Allocate a new CPU descriptor.
     /// @note
-    ///   A new descriptor heap will be created if there is no more free descriptors.
+    ///   Descriptors are allocated from a thread-local cache, which is refilled from this allocator in batches. A new descriptor heap will be created if there is no more free descriptors.
     ///
     /// @return CpuDescriptorHandle
     ///   Return a free CPU descriptor handle.
@@ -189,9 +190,48 @@ public:
 
     /// @brief
     ///   Free the specified CPU descriptor handle.
+    /// @note
+    ///   The descriptor is returned to a thread-local cache. Cached descriptors are returned to this allocator in batches.
     ///
     /// @param handle   The CPU descriptor handle to be freed.
-    auto Free(CpuDescriptorHandle handle) noexcept -> void { freeHandles.push(handle); }
+    YAGE_API auto Free(CpuDescriptorHandle handle) noexcept -> void;
+
+    /// @brief
+    ///   Allocate contiguous CPU descriptors in the same descriptor heap.
+    /// @note
+    ///   Freed contiguous descriptors are kept in free lists of their sizes, so that they could be reused by allocations of the same size.
+    ///
+    /// @param count    Number of descriptors to be allocated. Must not be 0.
+    ///
+    /// @return CpuDescriptorHandle
+    ///   Return the first allocated CPU descriptor handle. The rest descriptors follow the first one with descriptor increment size.
+    /// @throw RenderAPIException
+    ///   Thrown if failed to create new descriptor heap.
+    YAGE_NODISCARD YAGE_API auto AllocateContiguous(uint32_t count) -> CpuDescriptorHandle;
+
+    /// @brief
+    ///   Free contiguous CPU descriptors.
+    ///
+    /// @param first    The first CPU descriptor handle to be freed.
+    /// @param count    Number of descriptors to be freed. Must be the same as the number passed to @p AllocateContiguous().
+    YAGE_API auto FreeContiguous(CpuDescriptorHandle first, uint32_t count) noexcept -> void;
+
+    /// @brief
+    ///   Allocate a batch of CPU descriptors with a single lock. The allocated descriptors are not guaranteed to be contiguous.
+    ///
+    /// @param[out] handles     Receives the allocated CPU descriptor handles.
+    /// @param count            Number of descriptors to be allocated.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to create new descriptor heap. No descriptor is allocated in this case.
+    YAGE_API auto AllocateBatch(CpuDescriptorHandle *handles, uint32_t count) -> void;
+
+    /// @brief
+    ///   Free a batch of CPU descriptors with a single lock.
+    ///
+    /// @param handles  The CPU descriptor handles to be freed.
+    /// @param count    Number of descriptors to be freed.
+    YAGE_API auto FreeBatch(const CpuDescriptorHandle *handles, uint32_t count) noexcept -> void;
 
     /// @brief
     ///   Get the descriptor heap type of this CPU descriptor allocator.
@@ -200,6 +240,28 @@ public:
     ///   Return the descriptor heap type of this CPU descriptor allocator.
     YAGE_NODISCARD auto DescriptorType() const noexcept -> D3D12_DESCRIPTOR_HEAP_TYPE { return heapType; }
 
+private:
+    /// @brief
+    ///   Create a new descriptor heap and use it as the current descriptor heap. Remaining descriptors in the previous descriptor heap are moved to the free list.
+    /// @note
+    ///   Heap pool mutex must be locked before calling this method.
+    ///
+    /// @param numDescriptors   Number of descriptors in the new descriptor heap.
+    ///
+    /// @return HRESULT
+    ///   Return @p S_OK if succeeded to create the descriptor heap. Otherwise, return the error code.
+    auto NewHeap(uint32_t numDescriptors) noexcept -> HRESULT;
+
+    /// @brief
+    ///   Split a free contiguous range into free single descriptors.
+    /// @note
+    ///   Heap pool mutex must be locked before calling this method.
+    ///
+    /// @return bool
+    /// @retval true    A free contiguous range is split into @p freeHandles.
+    /// @retval false   There is no free contiguous range.
+    auto SplitFreeRange() noexcept -> bool;
+
 private:
     /// @brief  D3D12 device that is used to create new descriptor heaps.
     ID3D12Device1 *device;
@@ -213,11 +275,14 @@ private:
     /// @brief  Used to cache all descriptor heaps to avoid being destroyed.
     std::stack<Microsoft::WRL::ComPtr<ID3D12DescriptorHeap>> heapPool;
 
-    /// @brief  Used to protect heap pool.
+    /// @brief  Used to protect heap pool, free handles and the current descriptor heap.
     mutable std::mutex heapPoolMutex;
 
     /// @brief  Free CPU descriptor handles.
-    ::Concurrency::concurrent_queue<CpuDescriptorHandle> freeHandles;
+    std::vector<CpuDescriptorHandle> freeHandles;
+
+    /// @brief  First handles of free contiguous ranges, keyed by number of descriptors in each range.
+    std::unordered_map<uint32_t, std::vector<CpuDescriptorHandle>> freeRanges;
 
     /// @brief  Current CPU descriptor handle in the last free heap.
     CpuDescriptorHandle currentHandle;
@@ -255,7 +320,7 @@ public:
     YAGE_API auto operator=(ConstantBufferView &&other) noexcept -> ConstantBufferView &;
 
     /// @brief
-    ///   Destroy this constant buffer view and free the descriptor.
+    ///   Destroy this constant buffer view. The descriptor is freed once GPU has finished all submitted commands.
     YAGE_API ~ConstantBufferView() noexcept;
 
     /// @brief
@@ -304,7 +369,7 @@ private:
 class ShaderResourceView {
 public:
     /// @brief  Create a null shader resource view.
-    ShaderResourceView() noexcept : handle() {}
+    ShaderResourceView() noexcept : handle(), bindlessIndex(UINT32_MAX) {}
 
     /// @brief
     ///   Copy constructor is disabled.
@@ -318,8 +383,9 @@ public:
     ///   Move constructor. The moved shader resource view will be invalidated.
     ///
     /// @param other    The shader resource view to be moved.
-    ShaderResourceView(ShaderResourceView &&other) noexcept : handle(other.handle) {
-        other.handle = CpuDescriptorHandle();
+    ShaderResourceView(ShaderResourceView &&other) noexcept : handle(other.handle), bindlessIndex(other.bindlessIndex) {
+        other.handle        = CpuDescriptorHandle();
+        other.bindlessIndex = UINT32_MAX;
     }
 
     /// @brief
@@ -329,11 +395,11 @@ public:
     YAGE_API auto operator=(ShaderResourceView &&other) noexcept -> ShaderResourceView &;
 
     /// @brief
-    ///   Destroy this shader resource view and free the descriptor.
+    ///   Destroy this shader resource view. The descriptor is freed once GPU has finished all submitted commands.
     YAGE_API ~ShaderResourceView() noexcept;
 
     /// @brief
-    ///   Create a shader resource view. A new CPU descriptor handle will be allocated if this is a null shader resource view.
+    ///   Create a shader resource view. A new CPU descriptor handle and a bindless descriptor will be allocated if this is a null shader resource view. Recreating a shader resource view allocates a new bindless descriptor, and the previous one is freed once GPU has finished submitted commands.
     ///
     /// @param resource     Resource to be viewed.
     ///
@@ -342,7 +408,7 @@ public:
     YAGE_API auto Create(ID3D12Resource *resource) -> void;
 
     /// @brief
-    ///   Create a shader resource view. A new CPU descriptor handle will be allocated if this is a null shader resource view.
+    ///   Create a shader resource view. A new CPU descriptor handle and a bindless descriptor will be allocated if this is a null shader resource view. Recreating a shader resource view allocates a new bindless descriptor, and the previous one is freed once GPU has finished submitted commands.
     ///
     /// @param resource     Resource to be viewed.
     /// @param desc         Describes how to create this shader resource view.
@@ -370,15 +436,25 @@ public:
     ///   Allow implicit conversion to CPU descriptor handle.
     operator CpuDescriptorHandle() const noexcept { return handle; }
 
+    /// @brief
+    ///   Get index of this shader resource view in the bindless region of the global descriptor heap. The index is stable until this shader resource view is recreated and could be passed to shaders via root constants.
+    ///
+    /// @return uint32_t
+    ///   Return bindless index of this shader resource view. Return @p UINT32_MAX if this is a null shader resource view.
+    YAGE_NODISCARD auto BindlessIndex() const noexcept -> uint32_t { return bindlessIndex; }
+
 private:
     /// @brief  Descriptor handle of this shader resource view.
     CpuDescriptorHandle handle;
+
+    /// @brief  Index of this shader resource view in the bindless region of the global descriptor heap.
+    uint32_t bindlessIndex;
 };
 
 class UnorderedAccessView {
 public:
     /// @brief  Create a null unordered access view.
-    UnorderedAccessView() noexcept : handle() {}
+    UnorderedAccessView() noexcept : handle(), bindlessIndex(UINT32_MAX) {}
 
     /// @brief
     ///   Copy constructor is disabled.
@@ -392,8 +468,10 @@ public:
     ///   Move constructor. The moved unordered access view will be invalidated.
     ///
     /// @param other    The unordered access view to be moved.
-    UnorderedAccessView(UnorderedAccessView &&other) noexcept : handle(other.handle) {
-        other.handle = CpuDescriptorHandle();
+    UnorderedAccessView(UnorderedAccessView &&other) noexcept
+        : handle(other.handle), bindlessIndex(other.bindlessIndex) {
+        other.handle        = CpuDescriptorHandle();
+        other.bindlessIndex = UINT32_MAX;
     }
 
     /// @brief
@@ -403,11 +481,11 @@ public:
     YAGE_API auto operator=(UnorderedAccessView &&other) noexcept -> UnorderedAccessView &;
 
     /// @brief
-    ///   Destroy this unordered access view and free the descriptor.
+    ///   Destroy this unordered access view. The descriptor is freed once GPU has finished all submitted commands.
     YAGE_API ~UnorderedAccessView() noexcept;
 
     /// @brief
-    ///   Create an unordered access view. A new CPU descriptor handle will be allocated if this is a null unordered access view.
+    ///   Create an unordered access view. A new CPU descriptor handle and a bindless descriptor will be allocated if this is a null unordered access view. Recreating an unordered access view allocates a new bindless descriptor, and the previous one is freed once GPU has finished submitted commands.
     /// @note
     ///   No counter resource is specified.
     ///
@@ -419,7 +497,7 @@ public:
     YAGE_API auto Create(ID3D12Resource *resource, const D3D12_UNORDERED_ACCESS_VIEW_DESC &desc) -> void;
 
     /// @brief
-    ///   Create an unordered access view. A new CPU descriptor handle will be allocated if this is a null unordered access view.
+    ///   Create an unordered access view. A new CPU descriptor handle and a bindless descriptor will be allocated if this is a null unordered access view. Recreating an unordered access view allocates a new bindless descriptor, and the previous one is freed once GPU has finished submitted commands.
     ///
     /// @param resource     Resource to be viewed.
     /// @param counter      Counter resource.
@@ -449,15 +527,25 @@ public:
     ///   Allow implicit conversion to CPU descriptor handle.
     operator CpuDescriptorHandle() const noexcept { return handle; }
 
+    /// @brief
+    ///   Get index of this unordered access view in the bindless region of the global descriptor heap. The index is stable until this unordered access view is recreated and could be passed to shaders via root constants.
+    ///
+    /// @return uint32_t
+    ///   Return bindless index of this unordered access view. Return @p UINT32_MAX if this is a null unordered access view.
+    YAGE_NODISCARD auto BindlessIndex() const noexcept -> uint32_t { return bindlessIndex; }
+
 private:
     /// @brief  Descriptor handle of this unordered access view.
     CpuDescriptorHandle handle;
+
+    /// @brief  Index of this unordered access view in the bindless region of the global descriptor heap.
+    uint32_t bindlessIndex;
 };
 
 class SamplerView {
 public:
     /// @brief  Create a null sampler view.
-    SamplerView() noexcept : handle() {}
+    SamplerView() noexcept : handle(), bindlessIndex(UINT32_MAX) {}
 
     /// @brief
     ///   Copy constructor is disabled.
@@ -471,7 +559,10 @@ public:
     ///   Move constructor. The moved sampler view will be invalidated.
     ///
     /// @param other    The sampler view to be moved.
-    SamplerView(SamplerView &&other) noexcept : handle(other.handle) { other.handle = CpuDescriptorHandle(); }
+    SamplerView(SamplerView &&other) noexcept : handle(other.handle), bindlessIndex(other.bindlessIndex) {
+        other.handle        = CpuDescriptorHandle();
+        other.bindlessIndex = UINT32_MAX;
+    }
 
     /// @brief
     ///   Move assignment. The moved sampler view will be invalidated.
@@ -480,11 +571,11 @@ public:
     YAGE_API auto operator=(SamplerView &&other) noexcept -> SamplerView &;
 
     /// @brief
-    ///   Destroy this sampler view and free the descriptor.
+    ///   Destroy this sampler view. The descriptor is freed once GPU has finished all submitted commands.
     YAGE_API ~SamplerView() noexcept;
 
     /// @brief
-    ///   Create a sampler view. A new CPU descriptor handle will be allocated if this is a null sampler view.
+    ///   Create a sampler view. A new CPU descriptor handle and a bindless descriptor will be allocated if this is a null sampler view. Recreating a sampler view allocates a new bindless descriptor, and the previous one is freed once GPU has finished submitted commands.
     ///
     /// @param desc        Describes how to create this sampler view.
     ///
@@ -511,9 +602,19 @@ public:
     ///   Allow implicit conversion to CPU descriptor handle.
     operator CpuDescriptorHandle() const noexcept { return handle; }
 
+    /// @brief
+    ///   Get index of this sampler view in the bindless region of the global descriptor heap. The index is stable until this sampler view is recreated and could be passed to shaders via root constants.
+    ///
+    /// @return uint32_t
+    ///   Return bindless index of this sampler view. Return @p UINT32_MAX if this is a null sampler view.
+    YAGE_NODISCARD auto BindlessIndex() const noexcept -> uint32_t { return bindlessIndex; }
+
 private:
     /// @brief  Descriptor handle of this sampler view.
     CpuDescriptorHandle handle;
+
+    /// @brief  Index of this sampler view in the bindless region of the global descriptor heap.
+    uint32_t bindlessIndex;
 };
 
 class RenderTargetView {
@@ -542,7 +643,7 @@ public:
     YAGE_API auto operator=(RenderTargetView &&other) noexcept -> RenderTargetView &;
 
     /// @brief
-    ///   Destroy this render target view and free the descriptor.
+    ///   Destroy this render target view. The descriptor is freed once GPU has finished all submitted commands.
     YAGE_API ~RenderTargetView() noexcept;
 
     /// @brief
@@ -605,7 +706,7 @@ public:
     YAGE_API auto operator=(DepthStencilView &&other) noexcept -> DepthStencilView &;
 
     /// @brief
-    ///   Destroy this depth stencil view and free the descriptor.
+    ///   Destroy this depth stencil view. The descriptor is freed once GPU has finished all submitted commands.
     YAGE_API ~DepthStencilView() noexcept;
 
     /// @brief
@@ -0,0 +1,78 @@
+#include "DynamicBuffer.h"
+#include "../Core/Exception.h"
+#include "RenderDevice.h"
+
+using namespace YaGE;
+
+namespace {
+
+/// @brief
+///   Get type of heap that dynamic buffers should be created in.
+///
+/// @return D3D12_HEAP_TYPE
+///   Return @p D3D12_HEAP_TYPE_GPU_UPLOAD if GPU upload heaps are supported. Otherwise, return @p D3D12_HEAP_TYPE_UPLOAD.
+auto DynamicHeapType() noexcept -> D3D12_HEAP_TYPE {
+#ifdef __ID3D12GraphicsCommandList10_INTERFACE_DEFINED__
+    if (RenderDevice::Singleton().SupportGpuUploadHeap())
+        return D3D12_HEAP_TYPE_GPU_UPLOAD;
+#endif
+    return D3D12_HEAP_TYPE_UPLOAD;
+}
+
+} // namespace
+
+YaGE::DynamicBuffer::DynamicBuffer(size_t size, uint32_t count)
+    : GpuBuffer(((size + 255) & ~size_t(255)) * count,
+                DynamicHeapType(),
+                D3D12_RESOURCE_FLAG_NONE,
+                D3D12_RESOURCE_STATE_GENERIC_READ),
+      mappedData(),
+      isVideoMemory(DynamicHeapType() != D3D12_HEAP_TYPE_UPLOAD),
+      frameSize((size + 255) & ~size_t(255)),
+      frameCount(count),
+      frameIndex(0),
+      frameOffset(0),
+      frameSyncPoints(count) {
+    // Dynamic buffers are persistently mapped. CPU never reads from them.
+    const D3D12_RANGE readRange{0, 0};
+
+    void   *data = nullptr;
+    HRESULT hr   = resource->Map(0, &readRange, &data);
+    if (FAILED(hr))
+        throw RenderAPIException(hr, u"Failed to map dynamic buffer.");
+
+    mappedData = static_cast<uint8_t *>(data);
+}
+
+YaGE::DynamicBuffer::~DynamicBuffer() noexcept {
+    if (mappedData != nullptr)
+        resource->Unmap(0, nullptr);
+}
+
+auto YaGE::DynamicBuffer::Allocate(size_t size, size_t alignment) -> DynamicAllocation {
+    size_t offset = frameOffset.load(std::memory_order_relaxed);
+    size_t aligned;
+
+    do {
+        aligned = (offset + alignment - 1) & ~(alignment - 1);
+        if (aligned + size > frameSize)
+            throw RenderAPIException(E_OUTOFMEMORY, u"No enough free space in current frame of dynamic buffer.");
+    } while (!frameOffset.compare_exchange_weak(offset, aligned + size, std::memory_order_relaxed));
+
+    return DynamicAllocation{
+        /* data       = */ static_cast<uint8_t *>(FrameData()) + aligned,
+        /* gpuAddress = */ FrameGpuAddress() + aligned,
+        /* size       = */ size,
+    };
+}
+
+auto YaGE::DynamicBuffer::NextFrame(uint64_t syncPoint) noexcept -> void {
+    frameSyncPoints[frameIndex] = syncPoint;
+    frameIndex                  = (frameIndex + 1) % frameCount;
+    frameOffset.store(0, std::memory_order_relaxed);
+
+    // Wait for GPU to finish using the next frame region.
+    RenderDevice &renderDevice = RenderDevice::Singleton();
+    if (!renderDevice.IsSyncPointReached(frameSyncPoints[frameIndex]))
+        renderDevice.Sync(frameSyncPoints[frameIndex]);
+}
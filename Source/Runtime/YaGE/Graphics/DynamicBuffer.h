@@ -0,0 +1,139 @@
+#pragma once
+
+#include "GpuBuffer.h"
+
+#include <atomic>
+
+namespace YaGE {
+
+struct DynamicAllocation {
+    /// @brief  CPU pointer to start of this allocation. The memory may be write-combined and should never be read by CPU.
+    void *data;
+
+    /// @brief  GPU address to start of this allocation.
+    uint64_t gpuAddress;
+
+    /// @brief  Size in byte of this allocation.
+    size_t size;
+};
+
+class DynamicBuffer : public GpuBuffer {
+public:
+    /// @brief
+    ///   Create a persistently mapped dynamic buffer that is split into one region per frame in flight.
+    /// @remarks
+    ///   The buffer is created in GPU upload heap if @p RenderDevice::SupportGpuUploadHeap() returns true, so that data is read by GPU from video memory. Otherwise, the buffer is created in upload heap and read by GPU from system memory.
+    ///
+    /// @param size     Size in byte of each frame region. This value will be aligned up with 256 bytes.
+    /// @param count    Number of frame regions. This should be at least the number of frames in flight.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to create or map D3D12 resource for this dynamic buffer.
+    YAGE_API explicit DynamicBuffer(size_t size, uint32_t count = DEFAULT_FRAME_COUNT);
+
+    /// @brief
+    ///   Copy constructor is disabled.
+    DynamicBuffer(const DynamicBuffer &) = delete;
+
+    /// @brief
+    ///   Copy assignment is disabled.
+    auto operator=(const DynamicBuffer &) = delete;
+
+    /// @brief
+    ///   Destroy this dynamic buffer. The buffer must not be used by GPU when destroyed.
+    YAGE_API ~DynamicBuffer() noexcept override;
+
+    /// @brief
+    ///   Checks if this dynamic buffer is located in video memory.
+    ///
+    /// @return bool
+    /// @retval true    This dynamic buffer is created in GPU upload heap.
+    /// @retval false   This dynamic buffer is created in upload heap.
+    YAGE_NODISCARD auto IsVideoMemory() const noexcept -> bool { return isVideoMemory; }
+
+    /// @brief
+    ///   Get size in byte of each frame region.
+    ///
+    /// @return size_t
+    ///   Return size in byte of each frame region.
+    YAGE_NODISCARD auto FrameSize() const noexcept -> size_t { return frameSize; }
+
+    /// @brief
+    ///   Get number of frame regions.
+    ///
+    /// @return uint32_t
+    ///   Return number of frame regions.
+    YAGE_NODISCARD auto FrameCount() const noexcept -> uint32_t { return frameCount; }
+
+    /// @brief
+    ///   Get index of current frame region.
+    ///
+    /// @return uint32_t
+    ///   Return index of current frame region.
+    YAGE_NODISCARD auto FrameIndex() const noexcept -> uint32_t { return frameIndex; }
+
+    /// @brief
+    ///   Get CPU pointer to start of current frame region. Data written at the same offset of each frame has the same GPU address offset from @p FrameGpuAddress().
+    ///
+    /// @return void *
+    ///   Return CPU pointer to start of current frame region.
+    YAGE_NODISCARD auto FrameData() const noexcept -> void * { return mappedData + size_t(frameIndex) * frameSize; }
+
+    /// @brief
+    ///   Get GPU address to start of current frame region.
+    ///
+    /// @return uint64_t
+    ///   Return GPU address to start of current frame region.
+    YAGE_NODISCARD auto FrameGpuAddress() const noexcept -> uint64_t {
+        return GpuAddress() + uint64_t(frameIndex) * frameSize;
+    }
+
+    /// @brief
+    ///   Allocate memory from current frame region. This method is thread-safe and lock free.
+    ///
+    /// @param size         Size in byte of memory to be allocated.
+    /// @param alignment    Alignment of the allocation. Must be a power of 2.
+    ///
+    /// @return DynamicAllocation
+    ///   Return the allocated memory. The allocation is valid until the frame region is reused.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if there is no enough free space in current frame region.
+    YAGE_API auto Allocate(size_t size, size_t alignment = D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT)
+        -> DynamicAllocation;
+
+    /// @brief
+    ///   Finish current frame and switch to the next frame region. Allocations of current frame are freed once the specified sync point is reached.
+    /// @note
+    ///   This method blocks current thread if the next frame region is still being used by GPU. This method must not be called concurrently with @p Allocate().
+    ///
+    /// @param syncPoint    The sync point that indicates when GPU finishes using current frame region.
+    YAGE_API auto NextFrame(uint64_t syncPoint) noexcept -> void;
+
+    /// @brief  Default number of frame regions.
+    static constexpr const uint32_t DEFAULT_FRAME_COUNT = 3;
+
+private:
+    /// @brief  CPU pointer to start of the mapped buffer.
+    uint8_t *mappedData;
+
+    /// @brief  Whether this buffer is created in GPU upload heap.
+    bool isVideoMemory;
+
+    /// @brief  Size in byte of each frame region.
+    size_t frameSize;
+
+    /// @brief  Number of frame regions.
+    uint32_t frameCount;
+
+    /// @brief  Index of current frame region.
+    uint32_t frameIndex;
+
+    /// @brief  Offset in byte of the next allocation in current frame region.
+    std::atomic<size_t> frameOffset;
+
+    /// @brief  Sync points that indicate when GPU finishes using each frame region.
+    std::vector<uint64_t> frameSyncPoints;
+};
+
+} // namespace YaGE
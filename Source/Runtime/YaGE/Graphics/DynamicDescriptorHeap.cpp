@@ -1,178 +1,74 @@
 #include "DynamicDescriptorHeap.h"
 #include "../Core/Exception.h"
+#include "../Core/Profiler.h"
 #include "RenderDevice.h"
 
+#include <intrin.h>
+
 #include <cassert>
-#include <mutex>
-#include <queue>
-#include <stack>
 
 using namespace YaGE;
-using Microsoft::WRL::ComPtr;
 
 namespace {
 
-static constexpr const uint32_t NUM_DESCRIPTORS_PER_HEAP = 1024;
-
-class DescriptorHeapAllocator {
-public:
-    /// @brief
-    ///   Create a new descriptor heap allocator.
-    ///
-    /// @param heapType Descriptor heap type.
-    DescriptorHeapAllocator(D3D12_DESCRIPTOR_HEAP_TYPE heapType);
-
-    /// @brief
-    ///   Copy constructor is disabled.
-    DescriptorHeapAllocator(const DescriptorHeapAllocator &) = delete;
-
-    /// @brief
-    ///   Copy assignment is disabled.
-    auto operator=(const DescriptorHeapAllocator &) = delete;
-
-    /// @brief
-    ///   Destroy this descriptor heap allocator.
-    ~DescriptorHeapAllocator() noexcept;
-
-    /// @brief
-    ///   Allocate a free descriptor heap.
-    ///
-    /// @return ID3D12DescriptorHeap *
-    ///   Return a free descriptor heap.
-    /// @throw RenderAPIException
-    ///   Thrown if failed to create new descriptor heap.
-    YAGE_NODISCARD auto Allocate() -> ID3D12DescriptorHeap *;
-
-    /// @brief
-    ///   Free descriptor heaps.
-    ///
-    /// @param syncPoint  Sync point that is used to determine when the freed descriptor heaps could be reused.
-    /// @param heaps      Descriptor heaps to be freed.
-    auto Free(uint64_t syncPoint, const std::vector<ID3D12DescriptorHeap *> &heaps) noexcept -> void;
-
-    /// @brief
-    ///   Get singleton instance of this class.
-    ///
-    /// @param heapType Type of descriptor heap allocator to get.
-    YAGE_NODISCARD static auto Singleton(D3D12_DESCRIPTOR_HEAP_TYPE heapType) -> DescriptorHeapAllocator &;
-
-private:
-    /// @brief  Render device that is used to create descriptor heaps.
-    RenderDevice &renderDevice;
-
-    /// @brief  Descriptor heap type.
-    const D3D12_DESCRIPTOR_HEAP_TYPE heapType;
-
-    /// @brief  Allocated descriptor heaps.
-    std::stack<ComPtr<ID3D12DescriptorHeap>> heapPool;
-
-    /// @brief  Mutex that is used to protect heap pool.
-    mutable std::mutex heapPoolMutex;
-
-    /// @brief  Retired descriptor heap queue.
-    std::queue<std::pair<uint64_t, ID3D12DescriptorHeap *>> retiredHeaps;
-
-    /// @brief  Mutex that is used to protect retired heap queue.
-    mutable std::mutex retiredHeapsMutex;
-};
-
-DescriptorHeapAllocator::DescriptorHeapAllocator(D3D12_DESCRIPTOR_HEAP_TYPE heapType)
-    : renderDevice(RenderDevice::Singleton()),
-      heapType(heapType),
-      heapPool(),
-      heapPoolMutex(),
-      retiredHeaps(),
-      retiredHeapsMutex() {}
-
-DescriptorHeapAllocator::~DescriptorHeapAllocator() noexcept {}
-
-YAGE_NODISCARD auto DescriptorHeapAllocator::Allocate() -> ID3D12DescriptorHeap * {
-    { // Try to acquire one from retired queue.
-        std::lock_guard<std::mutex> lock(retiredHeapsMutex);
-        if (!retiredHeaps.empty()) {
-            auto &front = retiredHeaps.front();
-            if (renderDevice.IsSyncPointReached(front.first)) {
-                ID3D12DescriptorHeap *heap = front.second;
-                retiredHeaps.pop();
-                return heap;
-            }
-        }
-    }
-
-    // Try to create a new one.
-    ComPtr<ID3D12DescriptorHeap> descriptorHeap;
-
-    const D3D12_DESCRIPTOR_HEAP_DESC desc{
-        /* Type           = */ heapType,
-        /* NumDescriptors = */ NUM_DESCRIPTORS_PER_HEAP,
-        /* Flags          = */ D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE,
-        /* NodeMask       = */ 0,
-    };
-
-    HRESULT hr = renderDevice.Device()->CreateDescriptorHeap(&desc, IID_PPV_ARGS(&descriptorHeap));
-    if (FAILED(hr))
-        throw RenderAPIException(hr, u"Failed to create dynamic descriptor heap.");
-
-    ID3D12DescriptorHeap *result = descriptorHeap.Get();
-
-    // Add to heap pool.
-    std::lock_guard<std::mutex> lock(heapPoolMutex);
-    heapPool.push(std::move(descriptorHeap));
-    return result;
-}
-
-auto DescriptorHeapAllocator::Free(uint64_t syncPoint, const std::vector<ID3D12DescriptorHeap *> &heaps) noexcept
-    -> void {
-    std::lock_guard<std::mutex> lock(retiredHeapsMutex);
-    for (auto heap : heaps)
-        retiredHeaps.emplace(syncPoint, heap);
-}
-
-YAGE_NODISCARD auto DescriptorHeapAllocator::Singleton(D3D12_DESCRIPTOR_HEAP_TYPE heapType)
-    -> DescriptorHeapAllocator & {
-    if (heapType == D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER) {
-        static DescriptorHeapAllocator instance(D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER);
-        return instance;
-    } else {
-        static DescriptorHeapAllocator instance(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-        return instance;
-    }
+/// @brief
+///   Get index of the lowest set bit.
+///
+/// @param mask     The bit mask. Must not be 0.
+///
+/// @return uint32_t
+///   Return index of the lowest set bit.
+YAGE_FORCEINLINE static auto LowestBitIndex(uint64_t mask) noexcept -> uint32_t {
+    unsigned long index;
+    _BitScanForward64(&index, mask);
+    return static_cast<uint32_t>(index);
 }
 
 } // namespace
 
-YaGE::DynamicDescriptorHeap::DynamicDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE descriptorType)
+YaGE::DynamicDescriptorHeap::DynamicDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE descriptorType,
+                                                   D3D12_COMMAND_LIST_TYPE    queueType)
     : device(RenderDevice::Singleton().Device()),
       descriptorType(descriptorType),
+      queueType(queueType),
       descriptorSize(device->GetDescriptorHandleIncrementSize(descriptorType)),
       graphicsRootSignature(nullptr),
       computeRootSignature(nullptr),
-      currentHeap(nullptr),
+      globalHeap(GlobalDescriptorHeap::Singleton(descriptorType)),
+      currentBlock(UINT32_MAX),
       currentHandle(),
       freeDescriptorCount(),
-      retiredHeaps(),
+      retiredBlocks(),
+      lastSyncPoint(),
       graphicsCachedParameters(),
       computeCachedParameters(),
       graphicsTableCache(),
-      computeTableCache() {}
+      computeTableCache(),
+      graphicsDirtyTables(),
+      computeDirtyTables(),
+      copyCount(),
+      copySrc(),
+      copyDest(),
+      copySizes() {}
 
 YaGE::DynamicDescriptorHeap::~DynamicDescriptorHeap() noexcept {
-    if (currentHeap != nullptr) {
-        retiredHeaps.push_back(currentHeap);
-        currentHeap = nullptr;
+    if (currentBlock != UINT32_MAX) {
+        retiredBlocks.push_back(currentBlock);
+        currentBlock = UINT32_MAX;
     }
 
-    const uint64_t syncPoint = RenderDevice::Singleton().AcquireSyncPoint();
-    DescriptorHeapAllocator::Singleton(descriptorType).Free(syncPoint, retiredHeaps);
-    retiredHeaps.clear();
+    // Blocks are only referenced by submissions of the command buffer that owns this heap.
+    globalHeap.FreeDynamicBlocks(lastSyncPoint, retiredBlocks);
+    retiredBlocks.clear();
 }
 
 auto YaGE::DynamicDescriptorHeap::CleanUp(uint64_t syncPoint) noexcept -> void {
-    if (retiredHeaps.empty())
+    lastSyncPoint = syncPoint;
+    if (retiredBlocks.empty())
         return;
 
-    DescriptorHeapAllocator::Singleton(descriptorType).Free(syncPoint, retiredHeaps);
-    retiredHeaps.clear();
+    globalHeap.FreeDynamicBlocks(syncPoint, retiredBlocks);
+    retiredBlocks.clear();
 
     graphicsRootSignature = nullptr;
     computeRootSignature  = nullptr;
@@ -182,10 +78,14 @@ auto YaGE::DynamicDescriptorHeap::CleanUp(uint64_t syncPoint) noexcept -> void {
 
     memset(graphicsTableCache, 0, sizeof(graphicsTableCache));
     memset(computeTableCache, 0, sizeof(computeTableCache));
+
+    graphicsDirtyTables = 0;
+    computeDirtyTables  = 0;
 }
 
 auto YaGE::DynamicDescriptorHeap::ParseGraphicsRootSignature(RootSignature &rootSig) noexcept -> void {
     graphicsRootSignature = &rootSig;
+    graphicsDirtyTables   = 0;
 
     const uint32_t paramCount = (descriptorType == D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER ? rootSig.TableSamplerCount()
                                                                                       : rootSig.TableDescriptorCount());
@@ -200,6 +100,8 @@ auto YaGE::DynamicDescriptorHeap::ParseGraphicsRootSignature(RootSignature &root
             graphicsTableCache[i].parameterCount = tableSize;
             graphicsTableCache[i].parameters     = graphicsCachedParameters.data() + offset;
             offset += tableSize;
+            if (tableSize != 0)
+                graphicsDirtyTables |= (uint64_t(1) << i);
         }
     } else {
         for (uint32_t i = 0; i < 64; ++i) {
@@ -207,6 +109,8 @@ auto YaGE::DynamicDescriptorHeap::ParseGraphicsRootSignature(RootSignature &root
             graphicsTableCache[i].parameterCount = tableSize;
             graphicsTableCache[i].parameters     = graphicsCachedParameters.data() + offset;
             offset += tableSize;
+            if (tableSize != 0)
+                graphicsDirtyTables |= (uint64_t(1) << i);
         }
     }
 }
@@ -224,6 +128,30 @@ auto YaGE::DynamicDescriptorHeap::BindGraphicsDescriptor(uint32_t            par
 
     param.parameterType              = ParameterType::DescriptorHandle;
     param.parameter.descriptorHandle = descriptor;
+
+    graphicsDirtyTables |= (uint64_t(1) << paramIndex);
+}
+
+auto YaGE::DynamicDescriptorHeap::BindGraphicsDescriptors(uint32_t            paramIndex,
+                                                          uint32_t            offset,
+                                                          CpuDescriptorHandle first,
+                                                          uint32_t            count) noexcept -> void {
+    assert(paramIndex < 64);
+
+    DescriptorTableCache &tableCache = graphicsTableCache[paramIndex];
+    if (offset >= tableCache.parameterCount)
+        return; // No such descriptor.
+
+    if (count > tableCache.parameterCount - offset)
+        count = tableCache.parameterCount - offset;
+
+    CachedParameter *param = tableCache.parameters + offset;
+    for (uint32_t i = 0; i < count; ++i, ++param) {
+        param->parameterType              = ParameterType::DescriptorHandle;
+        param->parameter.descriptorHandle = first + static_cast<ptrdiff_t>(i) * descriptorSize;
+    }
+
+    graphicsDirtyTables |= (uint64_t(1) << paramIndex);
 }
 
 auto YaGE::DynamicDescriptorHeap::BindGraphicsDescriptor(uint32_t                               paramIndex,
@@ -240,10 +168,13 @@ auto YaGE::DynamicDescriptorHeap::BindGraphicsDescriptor(uint32_t
 
     param.parameterType                = ParameterType::ConstantBufferView;
     param.parameter.constantBufferView = desc;
+
+    graphicsDirtyTables |= (uint64_t(1) << paramIndex);
 }
 
 auto YaGE::DynamicDescriptorHeap::ParseComputeRootSignature(RootSignature &rootSig) noexcept -> void {
     computeRootSignature = &rootSig;
+    computeDirtyTables   = 0;
 
     const uint32_t paramCount = (descriptorType == D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER ? rootSig.TableSamplerCount()
                                                                                       : rootSig.TableDescriptorCount());
@@ -258,6 +189,8 @@ auto YaGE::DynamicDescriptorHeap::ParseComputeRootSignature(RootSignature &rootS
             computeTableCache[i].parameterCount = tableSize;
             computeTableCache[i].parameters     = computeCachedParameters.data() + offset;
             offset += tableSize;
+            if (tableSize != 0)
+                computeDirtyTables |= (uint64_t(1) << i);
         }
     } else {
         for (uint32_t i = 0; i < 64; ++i) {
@@ -265,6 +198,8 @@ auto YaGE::DynamicDescriptorHeap::ParseComputeRootSignature(RootSignature &rootS
             computeTableCache[i].parameterCount = tableSize;
             computeTableCache[i].parameters     = computeCachedParameters.data() + offset;
             offset += tableSize;
+            if (tableSize != 0)
+                computeDirtyTables |= (uint64_t(1) << i);
         }
     }
 }
@@ -282,6 +217,30 @@ auto YaGE::DynamicDescriptorHeap::BindComputeDescriptor(uint32_t            para
 
     param.parameterType              = ParameterType::DescriptorHandle;
     param.parameter.descriptorHandle = descriptor;
+
+    computeDirtyTables |= (uint64_t(1) << paramIndex);
+}
+
+auto YaGE::DynamicDescriptorHeap::BindComputeDescriptors(uint32_t            paramIndex,
+                                                         uint32_t            offset,
+                                                         CpuDescriptorHandle first,
+                                                         uint32_t            count) noexcept -> void {
+    assert(paramIndex < 64);
+
+    DescriptorTableCache &tableCache = computeTableCache[paramIndex];
+    if (offset >= tableCache.parameterCount)
+        return; // No such descriptor.
+
+    if (count > tableCache.parameterCount - offset)
+        count = tableCache.parameterCount - offset;
+
+    CachedParameter *param = tableCache.parameters + offset;
+    for (uint32_t i = 0; i < count; ++i, ++param) {
+        param->parameterType              = ParameterType::DescriptorHandle;
+        param->parameter.descriptorHandle = first + static_cast<ptrdiff_t>(i) * descriptorSize;
+    }
+
+    computeDirtyTables |= (uint64_t(1) << paramIndex);
 }
 
 auto YaGE::DynamicDescriptorHeap::BindComputeDescriptor(uint32_t                               paramIndex,
@@ -297,116 +256,105 @@ auto YaGE::DynamicDescriptorHeap::BindComputeDescriptor(uint32_t
 
     param.parameterType                = ParameterType::ConstantBufferView;
     param.parameter.constantBufferView = desc;
+
+    computeDirtyTables |= (uint64_t(1) << paramIndex);
 }
 
 auto YaGE::DynamicDescriptorHeap::Commit(ID3D12GraphicsCommandList *cmdList) noexcept -> void {
-    assert(graphicsCachedParameters.size() + computeCachedParameters.size() < 1024);
+    // Nothing changed since last commit.
+    if ((graphicsDirtyTables | computeDirtyTables) == 0)
+        return;
+
+    YAGE_PROFILE_SCOPE(DescriptorHeapCommit);
 
-    // Require new descriptor heap if no enough space.
-    const uint32_t requiredCount =
-        static_cast<uint32_t>(graphicsCachedParameters.size() + computeCachedParameters.size());
+    // Count descriptors in dirty descriptor tables.
+    uint32_t requiredCount = 0;
+    for (uint64_t mask = graphicsDirtyTables; mask != 0; mask &= (mask - 1))
+        requiredCount += graphicsTableCache[LowestBitIndex(mask)].parameterCount;
+    for (uint64_t mask = computeDirtyTables; mask != 0; mask &= (mask - 1))
+        requiredCount += computeTableCache[LowestBitIndex(mask)].parameterCount;
 
+    assert(requiredCount <= globalHeap.BlockSize());
+    YAGE_PROFILE_COUNT(DescriptorsCopied, requiredCount);
+
+    // Require new dynamic block if no enough space. Clean tables still point to the previous block, which is retired
+    // together with this command buffer.
     if (requiredCount > freeDescriptorCount) {
-        if (currentHeap != nullptr)
-            retiredHeaps.push_back(currentHeap);
-
-        auto &allocator     = DescriptorHeapAllocator::Singleton(descriptorType);
-        currentHeap         = allocator.Allocate();
-        currentHandle       = DescriptorHandle(currentHeap->GetCPUDescriptorHandleForHeapStart(),
-                                               currentHeap->GetGPUDescriptorHandleForHeapStart());
-        freeDescriptorCount = NUM_DESCRIPTORS_PER_HEAP;
+        if (currentBlock != UINT32_MAX)
+            retiredBlocks.push_back(currentBlock);
+
+        currentBlock        = globalHeap.AllocateDynamicBlock();
+        currentHandle       = globalHeap.Handle(currentBlock);
+        freeDescriptorCount = globalHeap.BlockSize();
     }
 
-    if (requiredCount != 0)
-        cmdList->SetDescriptorHeaps(1, &currentHeap);
+    // Upload graphics descriptor tables.
+    for (uint64_t mask = graphicsDirtyTables; mask != 0; mask &= (mask - 1)) {
+        const uint32_t i = LowestBitIndex(mask);
+        cmdList->SetGraphicsRootDescriptorTable(i, currentHandle);
+        UploadTable(graphicsTableCache[i]);
+    }
 
-    // Copy graphics descriptors.
-    if (graphicsRootSignature != nullptr) {
-        std::vector<D3D12_CPU_DESCRIPTOR_HANDLE> copySrc;
-        std::vector<D3D12_CPU_DESCRIPTOR_HANDLE> copyDest;
-        std::vector<UINT>                        copyCount;
+    // Upload compute descriptor tables.
+    for (uint64_t mask = computeDirtyTables; mask != 0; mask &= (mask - 1)) {
+        const uint32_t i = LowestBitIndex(mask);
+        cmdList->SetComputeRootDescriptorTable(i, currentHandle);
+        UploadTable(computeTableCache[i]);
+    }
 
-        copySrc.reserve(graphicsCachedParameters.size());
-        copyDest.reserve(graphicsCachedParameters.size());
-        copyCount.reserve(graphicsCachedParameters.size());
+    FlushCopies();
 
-        for (uint32_t i = 0; i < 64; ++i) {
-            DescriptorTableCache &tableCache = graphicsTableCache[i];
-            if (tableCache.parameterCount != 0)
-                cmdList->SetGraphicsRootDescriptorTable(i, currentHandle);
-
-            const CachedParameter *paramStart = tableCache.parameters;
-            const CachedParameter *paramEnd   = paramStart + tableCache.parameterCount;
-
-            for (const CachedParameter *param = paramStart; param != paramEnd; ++param) {
-                switch (param->parameterType) {
-                case ParameterType::DescriptorHandle:
-                    copySrc.push_back(param->parameter.descriptorHandle);
-                    copyDest.push_back(currentHandle);
-                    copyCount.push_back(1);
-                    break;
-
-                case ParameterType::ConstantBufferView:
-                    device->CreateConstantBufferView(&(param->parameter.constantBufferView), currentHandle);
-                    break;
+    graphicsDirtyTables = 0;
+    computeDirtyTables  = 0;
+}
 
-                default:
+auto YaGE::DynamicDescriptorHeap::UploadTable(const DescriptorTableCache &tableCache) noexcept -> void {
+    const CachedParameter *paramStart = tableCache.parameters;
+    const CachedParameter *paramEnd   = paramStart + tableCache.parameterCount;
+
+    for (const CachedParameter *param = paramStart; param != paramEnd; ++param) {
+        switch (param->parameterType) {
+        case ParameterType::DescriptorHandle: {
+            const D3D12_CPU_DESCRIPTOR_HANDLE src  = param->parameter.descriptorHandle;
+            const D3D12_CPU_DESCRIPTOR_HANDLE dest = currentHandle;
+
+            // Extend the last range if both source and destination descriptors are contiguous.
+            if (copyCount != 0) {
+                const SIZE_T rangeSize = static_cast<SIZE_T>(copySizes[copyCount - 1]) * descriptorSize;
+                if (copySrc[copyCount - 1].ptr + rangeSize == src.ptr &&
+                    copyDest[copyCount - 1].ptr + rangeSize == dest.ptr) {
+                    copySizes[copyCount - 1] += 1;
                     break;
                 }
-
-                currentHandle += descriptorSize;
-                freeDescriptorCount -= 1;
             }
-        }
-
-        if (!copySrc.empty())
-            device->CopyDescriptors(static_cast<UINT>(copyDest.size()), copyDest.data(), copyCount.data(),
-                                    static_cast<UINT>(copySrc.size()), copySrc.data(), copyCount.data(),
-                                    descriptorType);
-    }
-
-    // Copy compute descriptors.
-    if (computeRootSignature != nullptr) {
-        std::vector<D3D12_CPU_DESCRIPTOR_HANDLE> copySrc;
-        std::vector<D3D12_CPU_DESCRIPTOR_HANDLE> copyDest;
-        std::vector<UINT>                        copyCount;
 
-        copySrc.reserve(computeCachedParameters.size());
-        copyDest.reserve(computeCachedParameters.size());
-        copyCount.reserve(computeCachedParameters.size());
+            if (copyCount == COPY_BATCH_SIZE)
+                FlushCopies();
 
-        for (uint32_t i = 0; i < 64; ++i) {
-            DescriptorTableCache &tableCache = computeTableCache[i];
-            if (tableCache.parameterCount != 0)
-                cmdList->SetComputeRootDescriptorTable(i, currentHandle);
-
-            const CachedParameter *paramStart = tableCache.parameters;
-            const CachedParameter *paramEnd   = paramStart + tableCache.parameterCount;
-
-            for (const CachedParameter *param = paramStart; param != paramEnd; ++param) {
-                switch (param->parameterType) {
-                case ParameterType::DescriptorHandle:
-                    copySrc.push_back(param->parameter.descriptorHandle);
-                    copyDest.push_back(currentHandle);
-                    copyCount.push_back(1);
-                    break;
-
-                case ParameterType::ConstantBufferView:
-                    device->CreateConstantBufferView(&(param->parameter.constantBufferView), currentHandle);
-                    break;
+            copySrc[copyCount]   = src;
+            copyDest[copyCount]  = dest;
+            copySizes[copyCount] = 1;
+            copyCount += 1;
+            break;
+        }
 
-                default:
-                    break;
-                }
+        case ParameterType::ConstantBufferView:
+            device->CreateConstantBufferView(&(param->parameter.constantBufferView), currentHandle);
+            break;
 
-                currentHandle += descriptorSize;
-                freeDescriptorCount -= 1;
-            }
+        default:
+            break;
         }
 
-        if (!copySrc.empty())
-            device->CopyDescriptors(static_cast<UINT>(copyDest.size()), copyDest.data(), copyCount.data(),
-                                    static_cast<UINT>(copySrc.size()), copySrc.data(), copyCount.data(),
-                                    descriptorType);
+        currentHandle += descriptorSize;
+        freeDescriptorCount -= 1;
     }
 }
+
+auto YaGE::DynamicDescriptorHeap::FlushCopies() noexcept -> void {
+    if (copyCount == 0)
+        return;
+
+    device->CopyDescriptors(copyCount, copyDest, copySizes, copyCount, copySrc, copySizes, descriptorType);
+    copyCount = 0;
+}
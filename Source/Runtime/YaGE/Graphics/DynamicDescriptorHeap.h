@@ -1,6 +1,6 @@
 #pragma once
 
-#include "Descriptor.h"
+#include "GlobalDescriptorHeap.h"
 #include "RootSignature.h"
 
 #include <vector>
@@ -35,10 +35,12 @@ public:
     ///   Create a new dynamic descriptor heap for the specified type of descriptor.
     ///
     /// @param descriptorType   Type of this descriptor heap. Must be @p D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV or @p D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER.
+    /// @param queueType        Type of the command queue that this descriptor heap is used on. Remaining descriptor heaps are retired with sync point of this queue on destruction.
     ///
     /// @throw RenderAPIException
     ///   Thrown if failed to acquire D3D12 device.
-    YAGE_API DynamicDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE descriptorType);
+    YAGE_API DynamicDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE descriptorType,
+                                   D3D12_COMMAND_LIST_TYPE    queueType = D3D12_COMMAND_LIST_TYPE_DIRECT);
 
     /// @brief
     ///   Copy constructor is disabled.
@@ -73,6 +75,18 @@ public:
     YAGE_API auto BindGraphicsDescriptor(uint32_t paramIndex, uint32_t offset, CpuDescriptorHandle descriptor) noexcept
         -> void;
 
+    /// @brief
+    ///   Bind contiguous graphics descriptors to the specified descriptor table. Descriptors out of range of the descriptor table are ignored.
+    ///
+    /// @param paramIndex   Root parameter index of the descriptor table in the root signature.
+    /// @param offset       Offset of the first descriptor from start of the descriptor table.
+    /// @param first        The first descriptor to bind. Descriptors to bind must be contiguous in the same CPU descriptor heap.
+    /// @param count        Number of descriptors to bind.
+    YAGE_API auto BindGraphicsDescriptors(uint32_t            paramIndex,
+                                    uint32_t            offset,
+                                    CpuDescriptorHandle first,
+                                    uint32_t            count) noexcept -> void;
+
     /// @brief
     ///   Create a new constant buffer view at the specified offset of the descriptor table.
     ///
@@ -98,6 +112,18 @@ public:
     YAGE_API auto BindComputeDescriptor(uint32_t paramIndex, uint32_t offset, CpuDescriptorHandle descriptor) noexcept
         -> void;
 
+    /// @brief
+    ///   Bind contiguous compute descriptors to the specified descriptor table. Descriptors out of range of the descriptor table are ignored.
+    ///
+    /// @param paramIndex   Root parameter index of the descriptor table in the root signature.
+    /// @param offset       Offset of the first descriptor from start of the descriptor table.
+    /// @param first        The first descriptor to bind. Descriptors to bind must be contiguous in the same CPU descriptor heap.
+    /// @param count        Number of descriptors to bind.
+    YAGE_API auto BindComputeDescriptors(uint32_t            paramIndex,
+                                   uint32_t            offset,
+                                   CpuDescriptorHandle first,
+                                   uint32_t            count) noexcept -> void;
+
     /// @brief
     ///   Create a new constant buffer view at the specified offset of the descriptor table.
     ///
@@ -109,11 +135,27 @@ public:
                                         const D3D12_CONSTANT_BUFFER_VIEW_DESC &desc) noexcept -> void;
 
     /// @brief
-    ///   Upload all descriptors in the cached descriptor tables to GPU. This method will also bind the descriptor heap to the command list.
+    ///   Upload descriptors in the changed descriptor tables to GPU and bind these descriptor tables to the command list.
+    /// @note
+    ///   Descriptors are uploaded to the global descriptor heap of this descriptor type. The global descriptor heap must be bound to the command list before calling this method. Only descriptor tables that are bound with new descriptors since last commit are uploaded, so descriptors should be bound again if content of the CPU descriptors is changed.
     ///
     /// @param cmdList  Command list to upload descriptors.
     YAGE_API auto Commit(ID3D12GraphicsCommandList *cmdList) noexcept -> void;
 
+private:
+    /// @brief
+    ///   Upload descriptors in the specified descriptor table to current position of current dynamic block.
+    ///
+    /// @param tableCache   The descriptor table to be uploaded.
+    auto UploadTable(const DescriptorTableCache &tableCache) noexcept -> void;
+
+    /// @brief
+    ///   Copy all pending descriptors in the copy scratch buffer.
+    auto FlushCopies() noexcept -> void;
+
+    /// @brief  Maximum number of pending descriptor copy ranges.
+    static constexpr const uint32_t COPY_BATCH_SIZE = 128;
+
 private:
     /// @brief  Device that is used to create and copy descriptors.
     ID3D12Device *const device;
@@ -121,6 +163,9 @@ private:
     /// @brief  Descriptor type of this dynamic descriptor heap.
     const D3D12_DESCRIPTOR_HEAP_TYPE descriptorType;
 
+    /// @brief  Type of the command queue that this dynamic descriptor heap is used on.
+    const D3D12_COMMAND_LIST_TYPE queueType;
+
     /// @brief  Descriptor increment size.
     const uint32_t descriptorSize;
 
@@ -130,17 +175,23 @@ private:
     /// @brief  Current compute root signature.
     RootSignature *computeRootSignature;
 
-    /// @brief  Current dynamic descriptor heap.
-    ID3D12DescriptorHeap *currentHeap;
+    /// @brief  The global shader visible descriptor heap that dynamic descriptors are allocated from.
+    GlobalDescriptorHeap &globalHeap;
+
+    /// @brief  Index of the first descriptor of current dynamic block. This is @p UINT32_MAX if there is no current block.
+    uint32_t currentBlock;
 
     /// @brief  Descriptor handle to next allocation position.
     DescriptorHandle currentHandle;
 
-    /// @brief  Number of free descriptors in current descriptor heap.
+    /// @brief  Number of free descriptors in current dynamic block.
     uint32_t freeDescriptorCount;
 
-    /// @brief  Retired descriptor heaps.
-    std::vector<ID3D12DescriptorHeap *> retiredHeaps;
+    /// @brief  Retired dynamic blocks.
+    std::vector<uint32_t> retiredBlocks;
+
+    /// @brief  Sync point of the last submission of the command buffer that owns this heap. Current block may be referenced by it.
+    uint64_t lastSyncPoint;
 
     /// @brief  Cached parameters for graphics root signature.
     std::vector<CachedParameter> graphicsCachedParameters;
@@ -153,6 +204,24 @@ private:
 
     /// @brief  Cached descriptor tables for compute root signature.
     DescriptorTableCache computeTableCache[64];
+
+    /// @brief  One bit is set for each graphics descriptor table that should be uploaded in next commit.
+    uint64_t graphicsDirtyTables;
+
+    /// @brief  One bit is set for each compute descriptor table that should be uploaded in next commit.
+    uint64_t computeDirtyTables;
+
+    /// @brief  Number of pending descriptor copy ranges.
+    uint32_t copyCount;
+
+    /// @brief  Start of source descriptor ranges of pending descriptor copies.
+    D3D12_CPU_DESCRIPTOR_HANDLE copySrc[COPY_BATCH_SIZE];
+
+    /// @brief  Start of destination descriptor ranges of pending descriptor copies.
+    D3D12_CPU_DESCRIPTOR_HANDLE copyDest[COPY_BATCH_SIZE];
+
+    /// @brief  Number of descriptors in each pending descriptor range. Source and destination ranges have the same size.
+    UINT copySizes[COPY_BATCH_SIZE];
 };
 
 } // namespace YaGE
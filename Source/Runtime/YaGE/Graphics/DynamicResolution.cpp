@@ -0,0 +1,103 @@
+#include "DynamicResolution.h"
+#include "GpuProfiler.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace YaGE;
+
+YaGE::DynamicResolution::DynamicResolution(uint32_t maxWidth,
+                                           uint32_t maxHeight,
+                                           double   targetFrameTime,
+                                           float    minScale,
+                                           float    maxScale) noexcept
+    : maxRenderWidth(maxWidth),
+      maxRenderHeight(maxHeight),
+      renderWidth(),
+      renderHeight(),
+      targetTime(targetFrameTime),
+      smoothedTime(0.0),
+      minResolutionScale(),
+      maxResolutionScale(),
+      resolutionScale(1.0f),
+      settleFrames(0) {
+    SetScaleRange(minScale, maxScale);
+    resolutionScale = maxResolutionScale;
+    UpdateRenderSize();
+}
+
+auto YaGE::DynamicResolution::Update(double gpuFrameTime) noexcept -> bool {
+    if (gpuFrameTime <= 0.0 || targetTime <= 0.0)
+        return false;
+
+    // React quickly to GPU time spikes and slowly to GPU time drops to avoid oscillation.
+    if (smoothedTime <= 0.0)
+        smoothedTime = gpuFrameTime;
+    else
+        smoothedTime += (gpuFrameTime - smoothedTime) * (gpuFrameTime > smoothedTime ? 0.5 : 0.1);
+
+    // Frame time of the previous resolution scale may still be measured.
+    if (settleFrames > 0) {
+        settleFrames -= 1;
+        return false;
+    }
+
+    float scale = resolutionScale;
+    if (smoothedTime > targetTime * DECREASE_THRESHOLD) {
+        // Pixel count is proportional to square of resolution scale.
+        scale *= static_cast<float>(std::sqrt(targetTime * DECREASE_THRESHOLD / smoothedTime));
+    } else if (smoothedTime < targetTime * INCREASE_THRESHOLD) {
+        const float expected = scale * static_cast<float>(std::sqrt(targetTime * DECREASE_THRESHOLD / smoothedTime));
+        scale                = std::min(expected, scale + MAX_INCREASE_STEP);
+    }
+
+    scale = std::min(std::max(scale, minResolutionScale), maxResolutionScale);
+
+    // Ignore tiny changes that do not affect render size much.
+    if (std::abs(scale - resolutionScale) < 0.01f && scale != minResolutionScale && scale != maxResolutionScale)
+        return false;
+
+    const uint32_t oldWidth  = renderWidth;
+    const uint32_t oldHeight = renderHeight;
+
+    resolutionScale = scale;
+    UpdateRenderSize();
+
+    if (renderWidth == oldWidth && renderHeight == oldHeight)
+        return false;
+
+    settleFrames = SETTLE_FRAME_COUNT;
+    return true;
+}
+
+auto YaGE::DynamicResolution::Update(const GpuProfiler &profiler) noexcept -> bool {
+    return Update(profiler.FrameTime());
+}
+
+auto YaGE::DynamicResolution::SetMaxSize(uint32_t maxWidth, uint32_t maxHeight) noexcept -> void {
+    maxRenderWidth  = maxWidth;
+    maxRenderHeight = maxHeight;
+    UpdateRenderSize();
+}
+
+auto YaGE::DynamicResolution::SetScaleRange(float minScale, float maxScale) noexcept -> void {
+    minResolutionScale = std::min(std::max(minScale, 0.01f), 1.0f);
+    maxResolutionScale = std::min(std::max(maxScale, minResolutionScale), 1.0f);
+    resolutionScale    = std::min(std::max(resolutionScale, minResolutionScale), maxResolutionScale);
+    UpdateRenderSize();
+}
+
+auto YaGE::DynamicResolution::SetScale(float scale) noexcept -> void {
+    resolutionScale = std::min(std::max(scale, minResolutionScale), maxResolutionScale);
+    settleFrames    = SETTLE_FRAME_COUNT;
+    UpdateRenderSize();
+}
+
+auto YaGE::DynamicResolution::UpdateRenderSize() noexcept -> void {
+    const double   scale        = static_cast<double>(resolutionScale);
+    const uint32_t scaledWidth  = static_cast<uint32_t>(std::lround(maxRenderWidth * scale));
+    const uint32_t scaledHeight = static_cast<uint32_t>(std::lround(maxRenderHeight * scale));
+
+    renderWidth  = std::min(std::max(scaledWidth, 1U), std::max(maxRenderWidth, 1U));
+    renderHeight = std::min(std::max(scaledHeight, 1U), std::max(maxRenderHeight, 1U));
+}
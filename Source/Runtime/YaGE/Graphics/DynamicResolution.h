@@ -0,0 +1,212 @@
+#pragma once
+
+#include "../Core/Common.h"
+
+#include <d3d12.h>
+
+namespace YaGE {
+
+class GpuProfiler;
+
+class DynamicResolution {
+public:
+    /// @brief
+    ///   Create a dynamic resolution controller. Render targets should be created with the maximum size and only the active region returned by @p Viewport() is rendered to, so that changing resolution scale never recreates resources.
+    /// @remarks
+    ///   The controller starts at the maximum resolution scale. Call @p Update() once per frame with GPU frame time to adjust the resolution scale, then use @p CommandBuffer::Upscale() to scale the active region to the back buffer.
+    ///
+    /// @param maxWidth         Maximum render width in pixels. This is usually width of the back buffer.
+    /// @param maxHeight        Maximum render height in pixels. This is usually height of the back buffer.
+    /// @param targetFrameTime  Expected GPU frame time in millisecond.
+    /// @param minScale         Minimum resolution scale of each dimension. Will be clamped to (0, 1].
+    /// @param maxScale         Maximum resolution scale of each dimension. Will be clamped to [@p minScale, 1].
+    YAGE_API DynamicResolution(uint32_t maxWidth,
+                               uint32_t maxHeight,
+                               double   targetFrameTime,
+                               float    minScale = 0.5f,
+                               float    maxScale = 1.0f) noexcept;
+
+    /// @brief
+    ///   Update resolution scale with the latest GPU frame time.
+    /// @remarks
+    ///   Pixel cost is assumed to be proportional to the rendered pixel count. Resolution scale drops immediately when GPU frame time exceeds the target and grows slowly when there is enough headroom. Resolution scale is kept unchanged for a few frames after each change, because GPU frame time is measured a few frames later.
+    ///
+    /// @param gpuFrameTime     GPU time in millisecond of the latest finished frame. Non-positive values are ignored.
+    ///
+    /// @return bool
+    /// @retval true    Resolution scale is changed.
+    /// @retval false   Resolution scale is not changed.
+    YAGE_API auto Update(double gpuFrameTime) noexcept -> bool;
+
+    /// @brief
+    ///   Update resolution scale with frame time of the latest finished frame measured by the specified GPU profiler.
+    ///
+    /// @param[in] profiler     The GPU profiler that profiles the whole frame.
+    ///
+    /// @return bool
+    /// @retval true    Resolution scale is changed.
+    /// @retval false   Resolution scale is not changed.
+    YAGE_API auto Update(const GpuProfiler &profiler) noexcept -> bool;
+
+    /// @brief
+    ///   Set maximum render size. This should be called when the back buffer is resized. Render targets should be recreated with the new maximum size.
+    ///
+    /// @param maxWidth     Maximum render width in pixels.
+    /// @param maxHeight    Maximum render height in pixels.
+    YAGE_API auto SetMaxSize(uint32_t maxWidth, uint32_t maxHeight) noexcept -> void;
+
+    /// @brief
+    ///   Get maximum render width.
+    ///
+    /// @return uint32_t
+    ///   Return maximum render width in pixels.
+    YAGE_NODISCARD auto MaxWidth() const noexcept -> uint32_t { return maxRenderWidth; }
+
+    /// @brief
+    ///   Get maximum render height.
+    ///
+    /// @return uint32_t
+    ///   Return maximum render height in pixels.
+    YAGE_NODISCARD auto MaxHeight() const noexcept -> uint32_t { return maxRenderHeight; }
+
+    /// @brief
+    ///   Set expected GPU frame time.
+    ///
+    /// @param targetFrameTime  Expected GPU frame time in millisecond.
+    auto SetTargetFrameTime(double targetFrameTime) noexcept -> void { targetTime = targetFrameTime; }
+
+    /// @brief
+    ///   Get expected GPU frame time.
+    ///
+    /// @return double
+    ///   Return expected GPU frame time in millisecond.
+    YAGE_NODISCARD auto TargetFrameTime() const noexcept -> double { return targetTime; }
+
+    /// @brief
+    ///   Set range of resolution scale. Current resolution scale is clamped to the new range.
+    ///
+    /// @param minScale     Minimum resolution scale of each dimension. Will be clamped to (0, 1].
+    /// @param maxScale     Maximum resolution scale of each dimension. Will be clamped to [@p minScale, 1].
+    YAGE_API auto SetScaleRange(float minScale, float maxScale) noexcept -> void;
+
+    /// @brief
+    ///   Get minimum resolution scale.
+    ///
+    /// @return float
+    ///   Return minimum resolution scale of each dimension.
+    YAGE_NODISCARD auto MinScale() const noexcept -> float { return minResolutionScale; }
+
+    /// @brief
+    ///   Get maximum resolution scale.
+    ///
+    /// @return float
+    ///   Return maximum resolution scale of each dimension.
+    YAGE_NODISCARD auto MaxScale() const noexcept -> float { return maxResolutionScale; }
+
+    /// @brief
+    ///   Set resolution scale manually. This is usually used to disable dynamic resolution by not calling @p Update().
+    ///
+    /// @param scale    Resolution scale of each dimension. Will be clamped to [@p MinScale(), @p MaxScale()].
+    YAGE_API auto SetScale(float scale) noexcept -> void;
+
+    /// @brief
+    ///   Get current resolution scale.
+    ///
+    /// @return float
+    ///   Return current resolution scale of each dimension.
+    YAGE_NODISCARD auto Scale() const noexcept -> float { return resolutionScale; }
+
+    /// @brief
+    ///   Get width of the active render region.
+    ///
+    /// @return uint32_t
+    ///   Return width in pixels of the active render region.
+    YAGE_NODISCARD auto RenderWidth() const noexcept -> uint32_t { return renderWidth; }
+
+    /// @brief
+    ///   Get height of the active render region.
+    ///
+    /// @return uint32_t
+    ///   Return height in pixels of the active render region.
+    YAGE_NODISCARD auto RenderHeight() const noexcept -> uint32_t { return renderHeight; }
+
+    /// @brief
+    ///   Get viewport of the active render region. The active region always starts at the top-left corner of render targets.
+    ///
+    /// @return D3D12_VIEWPORT
+    ///   Return viewport of the active render region.
+    YAGE_NODISCARD auto Viewport() const noexcept -> D3D12_VIEWPORT {
+        return D3D12_VIEWPORT{
+            /* TopLeftX = */ 0.0f,
+            /* TopLeftY = */ 0.0f,
+            /* Width    = */ static_cast<float>(renderWidth),
+            /* Height   = */ static_cast<float>(renderHeight),
+            /* MinDepth = */ 0.0f,
+            /* MaxDepth = */ 1.0f,
+        };
+    }
+
+    /// @brief
+    ///   Get scissor rectangle of the active render region.
+    ///
+    /// @return D3D12_RECT
+    ///   Return scissor rectangle of the active render region.
+    YAGE_NODISCARD auto ScissorRect() const noexcept -> D3D12_RECT {
+        return D3D12_RECT{
+            /* left   = */ 0,
+            /* top    = */ 0,
+            /* right  = */ static_cast<LONG>(renderWidth),
+            /* bottom = */ static_cast<LONG>(renderHeight),
+        };
+    }
+
+    /// @brief  Resolution scale is kept unchanged for this number of frames after each change.
+    static constexpr const uint32_t SETTLE_FRAME_COUNT = 4;
+
+    /// @brief  Resolution scale drops once the smoothed GPU frame time exceeds this ratio of the target frame time.
+    static constexpr const double DECREASE_THRESHOLD = 0.95;
+
+    /// @brief  Resolution scale grows once the smoothed GPU frame time is less than this ratio of the target frame time.
+    static constexpr const double INCREASE_THRESHOLD = 0.85;
+
+    /// @brief  Maximum increment of resolution scale per change.
+    static constexpr const float MAX_INCREASE_STEP = 0.05f;
+
+private:
+    /// @brief
+    ///   Update size of the active render region with current resolution scale.
+    auto UpdateRenderSize() noexcept -> void;
+
+private:
+    /// @brief  Maximum render width in pixels.
+    uint32_t maxRenderWidth;
+
+    /// @brief  Maximum render height in pixels.
+    uint32_t maxRenderHeight;
+
+    /// @brief  Width in pixels of the active render region.
+    uint32_t renderWidth;
+
+    /// @brief  Height in pixels of the active render region.
+    uint32_t renderHeight;
+
+    /// @brief  Expected GPU frame time in millisecond.
+    double targetTime;
+
+    /// @brief  Exponentially smoothed GPU frame time in millisecond. 0 if no frame time has been measured.
+    double smoothedTime;
+
+    /// @brief  Minimum resolution scale of each dimension.
+    float minResolutionScale;
+
+    /// @brief  Maximum resolution scale of each dimension.
+    float maxResolutionScale;
+
+    /// @brief  Current resolution scale of each dimension.
+    float resolutionScale;
+
+    /// @brief  Number of frames to skip before resolution scale could be changed again.
+    uint32_t settleFrames;
+};
+
+} // namespace YaGE
@@ -0,0 +1,214 @@
+#include "GlobalDescriptorHeap.h"
+#include "../Core/Exception.h"
+#include "RenderDevice.h"
+
+#include <cassert>
+#include <chrono>
+
+using namespace YaGE;
+
+namespace {
+
+/// @brief  Number of bindless CBV/SRV/UAV descriptors.
+static constexpr const uint32_t BINDLESS_DESCRIPTOR_COUNT = 0x40000;
+
+/// @brief  Number of CBV/SRV/UAV descriptors in each dynamic block.
+static constexpr const uint32_t DESCRIPTOR_BLOCK_SIZE = 1024;
+
+/// @brief  Number of CBV/SRV/UAV dynamic blocks.
+static constexpr const uint32_t DESCRIPTOR_BLOCK_COUNT = 512;
+
+/// @brief  Number of bindless sampler descriptors. Shader visible sampler heaps could contain at most 2048 samplers.
+static constexpr const uint32_t BINDLESS_SAMPLER_COUNT = 1024;
+
+/// @brief  Number of sampler descriptors in each dynamic block.
+static constexpr const uint32_t SAMPLER_BLOCK_SIZE = 128;
+
+/// @brief  Number of sampler dynamic blocks.
+static constexpr const uint32_t SAMPLER_BLOCK_COUNT = 8;
+
+/// @brief  Freed bindless descriptors are retired in batches to avoid signaling command queues for every descriptor.
+static constexpr const size_t BINDLESS_RETIRE_BATCH_SIZE = 256;
+
+/// @brief  Maximum time in millisecond to wait for other command buffers to retire dynamic blocks.
+static constexpr const uint32_t BLOCK_RETIRE_TIMEOUT = 5000;
+
+} // namespace
+
+YaGE::GlobalDescriptorHeap::GlobalDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE descriptorType)
+    : renderDevice(RenderDevice::Singleton()),
+      descriptorType(descriptorType),
+      descriptorSize(renderDevice.Device()->GetDescriptorHandleIncrementSize(descriptorType)),
+      bindlessCapacity(descriptorType == D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER ? BINDLESS_SAMPLER_COUNT
+                                                                            : BINDLESS_DESCRIPTOR_COUNT),
+      blockSize(descriptorType == D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER ? SAMPLER_BLOCK_SIZE : DESCRIPTOR_BLOCK_SIZE),
+      blockCount(descriptorType == D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER ? SAMPLER_BLOCK_COUNT : DESCRIPTOR_BLOCK_COUNT),
+      heap(),
+      heapStart(),
+      bindlessAllocated(0),
+      bindlessLimit(bindlessCapacity),
+      freeBindless(),
+      pendingBindless(),
+      retiredBindless(),
+      bindlessMutex(),
+      blocksAllocated(0),
+      retiredBlocks(),
+      blockMutex(),
+      blockRetiredCondition() {
+    const D3D12_DESCRIPTOR_HEAP_DESC desc{
+        /* Type           = */ descriptorType,
+        /* NumDescriptors = */ bindlessCapacity + blockSize * blockCount,
+        /* Flags          = */ D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE,
+        /* NodeMask       = */ 0,
+    };
+
+    HRESULT hr = renderDevice.Device()->CreateDescriptorHeap(&desc, IID_PPV_ARGS(heap.GetAddressOf()));
+    if (FAILED(hr))
+        throw RenderAPIException(hr, u"Failed to create global descriptor heap.");
+
+    const uint64_t heapSize = uint64_t(desc.NumDescriptors) * descriptorSize;
+    renderDevice.TrackMemoryUsage(GpuMemoryCategory::DescriptorHeap, static_cast<int64_t>(heapSize));
+
+    heapStart = DescriptorHandle(heap->GetCPUDescriptorHandleForHeapStart(),
+                                 heap->GetGPUDescriptorHandleForHeapStart());
+}
+
+YaGE::GlobalDescriptorHeap::~GlobalDescriptorHeap() noexcept {
+    renderDevice.Sync();
+
+    const uint64_t heapSize = uint64_t(heap->GetDesc().NumDescriptors) * descriptorSize;
+    renderDevice.TrackMemoryUsage(GpuMemoryCategory::DescriptorHeap, -static_cast<int64_t>(heapSize));
+}
+
+YAGE_NODISCARD auto YaGE::GlobalDescriptorHeap::AllocateBindless() -> uint32_t {
+    std::lock_guard<std::mutex> lock(bindlessMutex);
+
+    if (freeBindless.empty())
+        ReclaimBindless(false);
+
+    if (!freeBindless.empty()) {
+        const uint32_t index = freeBindless.back();
+        freeBindless.pop_back();
+        return index;
+    }
+
+    if (bindlessAllocated < bindlessLimit)
+        return bindlessAllocated++;
+
+    // Bindless region is exhausted. Wait for freed descriptors.
+    RetirePendingBindless();
+    ReclaimBindless(true);
+
+    if (freeBindless.empty())
+        throw RenderAPIException(E_OUTOFMEMORY, u"No free descriptor in the bindless descriptor heap.");
+
+    const uint32_t index = freeBindless.back();
+    freeBindless.pop_back();
+    return index;
+}
+
+auto YaGE::GlobalDescriptorHeap::FreeBindless(uint32_t index) noexcept -> void {
+    std::lock_guard<std::mutex> lock(bindlessMutex);
+
+    pendingBindless.push_back(index);
+    if (pendingBindless.size() >= BINDLESS_RETIRE_BATCH_SIZE)
+        RetirePendingBindless();
+}
+
+auto YaGE::GlobalDescriptorHeap::UpdateBindless(uint32_t index, CpuDescriptorHandle descriptor) noexcept -> void {
+    assert(index < bindlessCapacity);
+    renderDevice.Device()->CopyDescriptorsSimple(1, Handle(index), descriptor, descriptorType);
+}
+
+YAGE_NODISCARD auto YaGE::GlobalDescriptorHeap::AllocateDynamicBlock() -> uint32_t {
+    std::unique_lock<std::mutex> lock(blockMutex);
+
+    // Try to acquire one from retired queue.
+    if (!retiredBlocks.empty() && renderDevice.IsSyncPointReached(retiredBlocks.front().first)) {
+        const uint32_t block = retiredBlocks.front().second;
+        retiredBlocks.pop_front();
+        return block;
+    }
+
+    if (blocksAllocated < blockCount)
+        return bindlessCapacity + (blocksAllocated++) * blockSize;
+
+    if (retiredBlocks.empty()) {
+        // All blocks are held by command buffers that are being recorded, for example by render graph passes that are
+        // submitted together. Grow the dynamic region downwards into bindless descriptors that are never allocated.
+        std::lock_guard<std::mutex> bindlessLock(bindlessMutex);
+        if (bindlessLimit - bindlessAllocated >= blockSize) {
+            bindlessLimit -= blockSize;
+            return bindlessLimit;
+        }
+    }
+
+    // Wait for other command buffers to be submitted. They may never be submitted if they are waiting for this thread.
+    if (!blockRetiredCondition.wait_for(lock, std::chrono::milliseconds(BLOCK_RETIRE_TIMEOUT),
+                                        [this]() { return !retiredBlocks.empty(); }))
+        throw RenderAPIException(E_OUTOFMEMORY, u"All dynamic descriptor blocks are held by command buffers.");
+
+    // Wait for the oldest retired one.
+    renderDevice.Sync(retiredBlocks.front().first);
+
+    const uint32_t block = retiredBlocks.front().second;
+    retiredBlocks.pop_front();
+    return block;
+}
+
+auto YaGE::GlobalDescriptorHeap::FreeDynamicBlocks(uint64_t syncPoint, const std::vector<uint32_t> &blocks) noexcept
+    -> void {
+    { // Lock scope.
+        std::lock_guard<std::mutex> lock(blockMutex);
+        for (auto block : blocks)
+            retiredBlocks.emplace_back(syncPoint, block);
+    }
+
+    if (!blocks.empty())
+        blockRetiredCondition.notify_all();
+}
+
+YAGE_NODISCARD auto YaGE::GlobalDescriptorHeap::Singleton(D3D12_DESCRIPTOR_HEAP_TYPE descriptorType)
+    -> GlobalDescriptorHeap & {
+    if (descriptorType == D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER) {
+        static GlobalDescriptorHeap instance(D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER);
+        return instance;
+    } else {
+        static GlobalDescriptorHeap instance(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+        return instance;
+    }
+}
+
+auto YaGE::GlobalDescriptorHeap::RetirePendingBindless() noexcept -> void {
+    if (pendingBindless.empty())
+        return;
+
+    // Copy command lists could not access shader visible descriptors.
+    retiredBindless.push_back(RetiredBindlessBatch{
+        /* directSyncPoint  = */ renderDevice.AcquireSyncPoint(D3D12_COMMAND_LIST_TYPE_DIRECT),
+        /* computeSyncPoint = */ renderDevice.AcquireSyncPoint(D3D12_COMMAND_LIST_TYPE_COMPUTE),
+        /* indices          = */ std::move(pendingBindless),
+    });
+
+    pendingBindless.clear();
+}
+
+auto YaGE::GlobalDescriptorHeap::ReclaimBindless(bool wait) noexcept -> void {
+    while (!retiredBindless.empty()) {
+        RetiredBindlessBatch &batch = retiredBindless.front();
+
+        const bool reached = renderDevice.IsSyncPointReached(batch.directSyncPoint) &&
+                             renderDevice.IsSyncPointReached(batch.computeSyncPoint);
+
+        if (!reached) {
+            if (!wait || !freeBindless.empty())
+                break;
+
+            renderDevice.Sync(batch.directSyncPoint);
+            renderDevice.Sync(batch.computeSyncPoint);
+        }
+
+        freeBindless.insert(freeBindless.end(), batch.indices.begin(), batch.indices.end());
+        retiredBindless.pop_front();
+    }
+}
@@ -0,0 +1,215 @@
+#pragma once
+
+#include "Descriptor.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace YaGE {
+
+class RenderDevice;
+
+class GlobalDescriptorHeap {
+public:
+    /// @brief
+    ///   Create a persistent shader visible descriptor heap.
+    /// @remarks
+    ///   The descriptor heap is split into two regions. The bindless region starts from the beginning of the descriptor heap, descriptors in this region have stable indices and could be accessed in shaders with these indices directly. The dynamic region is split into fixed-size blocks which are used by dynamic descriptor heaps to upload descriptor tables.
+    ///
+    /// @param descriptorType   Type of this descriptor heap. Must be @p D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV or @p D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to create the D3D12 descriptor heap.
+    YAGE_API GlobalDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE descriptorType);
+
+    /// @brief
+    ///   Copy constructor is disabled.
+    GlobalDescriptorHeap(const GlobalDescriptorHeap &) = delete;
+
+    /// @brief
+    ///   Copy assignment is disabled.
+    auto operator=(const GlobalDescriptorHeap &) = delete;
+
+    /// @brief
+    ///   Destroy this global descriptor heap.
+    YAGE_API ~GlobalDescriptorHeap() noexcept;
+
+    /// @brief
+    ///   Allocate a descriptor in the bindless region.
+    /// @remarks
+    ///   Freed bindless descriptors are reused only after GPU has finished all commands that were submitted before they were freed. This method may block current thread if the bindless region is exhausted and there are descriptors waiting for GPU. This method is thread-safe.
+    ///
+    /// @return uint32_t
+    ///   Return index of the allocated descriptor. The index is relative to the beginning of this descriptor heap.
+    /// @throw RenderAPIException
+    ///   Thrown if there is no free descriptor in the bindless region.
+    YAGE_NODISCARD YAGE_API auto AllocateBindless() -> uint32_t;
+
+    /// @brief
+    ///   Free a descriptor in the bindless region. This method is thread-safe.
+    ///
+    /// @param index    Index of the descriptor to be freed.
+    YAGE_API auto FreeBindless(uint32_t index) noexcept -> void;
+
+    /// @brief
+    ///   Copy a CPU descriptor into the specified bindless descriptor.
+    /// @note
+    ///   The bindless descriptor should not be in use by GPU.
+    ///
+    /// @param index        Index of the bindless descriptor to be updated.
+    /// @param descriptor   The CPU descriptor to be copied.
+    YAGE_API auto UpdateBindless(uint32_t index, CpuDescriptorHandle descriptor) noexcept -> void;
+
+    /// @brief
+    ///   Allocate a block of descriptors in the dynamic region.
+    /// @remarks
+    ///   This method may block current thread if all blocks are retired but not yet reached by GPU. If all blocks are used by command buffers that are still being recorded, the dynamic region grows into bindless descriptors that have never been allocated. If the bindless region is also exhausted, this method waits for a bounded time for any other command buffer to be submitted. This method is thread-safe.
+    ///
+    /// @return uint32_t
+    ///   Return index of the first descriptor in the allocated block.
+    /// @throw RenderAPIException
+    ///   Thrown if no dynamic block is retired in time. Descriptor commits are noexcept, so that this terminates the program instead of blocking forever.
+    YAGE_NODISCARD YAGE_API auto AllocateDynamicBlock() -> uint32_t;
+
+    /// @brief
+    ///   Free dynamic descriptor blocks. This method is thread-safe.
+    ///
+    /// @param syncPoint    Sync point that is used to determine when the freed blocks could be reused.
+    /// @param blocks       Index of the first descriptor of each block to be freed.
+    YAGE_API auto FreeDynamicBlocks(uint64_t syncPoint, const std::vector<uint32_t> &blocks) noexcept -> void;
+
+    /// @brief
+    ///   Get number of descriptors in each dynamic block.
+    ///
+    /// @return uint32_t
+    ///   Return number of descriptors in each dynamic block.
+    YAGE_NODISCARD auto BlockSize() const noexcept -> uint32_t { return blockSize; }
+
+    /// @brief
+    ///   Get maximum number of descriptors in the bindless region.
+    ///
+    /// @return uint32_t
+    ///   Return maximum number of descriptors in the bindless region.
+    YAGE_NODISCARD auto BindlessCapacity() const noexcept -> uint32_t { return bindlessCapacity; }
+
+    /// @brief
+    ///   Get CPU and GPU descriptor handle of the specified descriptor.
+    ///
+    /// @param index    Index of the descriptor.
+    ///
+    /// @return DescriptorHandle
+    ///   Return the shader visible descriptor handle.
+    YAGE_NODISCARD auto Handle(uint32_t index) const noexcept -> DescriptorHandle {
+        return heapStart + static_cast<ptrdiff_t>(index) * descriptorSize;
+    }
+
+    /// @brief
+    ///   Get GPU descriptor handle to start of the bindless region. This could be used to bind unbounded descriptor tables.
+    ///
+    /// @return D3D12_GPU_DESCRIPTOR_HANDLE
+    ///   Return GPU descriptor handle to start of the bindless region.
+    YAGE_NODISCARD auto BindlessTableStart() const noexcept -> D3D12_GPU_DESCRIPTOR_HANDLE { return heapStart; }
+
+    /// @brief
+    ///   Get the D3D12 descriptor heap object.
+    ///
+    /// @return ID3D12DescriptorHeap *
+    ///   Return the D3D12 descriptor heap object.
+    YAGE_NODISCARD auto DescriptorHeap() const noexcept -> ID3D12DescriptorHeap * { return heap.Get(); }
+
+    /// @brief
+    ///   Get global descriptor heap singleton instance of the specified type.
+    ///
+    /// @param descriptorType   Type of the global descriptor heap. Must be @p D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV or @p D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER.
+    ///
+    /// @return GlobalDescriptorHeap &
+    ///   Return reference to the global descriptor heap singleton instance.
+    /// @throw RenderAPIException
+    ///   Thrown if failed to create the global descriptor heap.
+    YAGE_NODISCARD YAGE_API static auto Singleton(D3D12_DESCRIPTOR_HEAP_TYPE descriptorType) -> GlobalDescriptorHeap &;
+
+private:
+    /// @brief
+    ///   Retire pending freed bindless descriptors with sync points of all command queues that could access them.
+    /// @note
+    ///   Bindless mutex must be locked before calling this method.
+    auto RetirePendingBindless() noexcept -> void;
+
+    /// @brief
+    ///   Move retired bindless descriptors that have been reached by GPU into the free list.
+    /// @note
+    ///   Bindless mutex must be locked before calling this method.
+    ///
+    /// @param wait     Wait for the oldest retired batch if no descriptor could be reclaimed.
+    auto ReclaimBindless(bool wait) noexcept -> void;
+
+private:
+    struct RetiredBindlessBatch {
+        /// @brief  Sync point of the direct command queue when these descriptors were freed.
+        uint64_t directSyncPoint;
+
+        /// @brief  Sync point of the compute command queue when these descriptors were freed.
+        uint64_t computeSyncPoint;
+
+        /// @brief  Freed bindless descriptor indices.
+        std::vector<uint32_t> indices;
+    };
+
+    /// @brief  Render device that is used to create the descriptor heap.
+    RenderDevice &renderDevice;
+
+    /// @brief  Type of this descriptor heap.
+    const D3D12_DESCRIPTOR_HEAP_TYPE descriptorType;
+
+    /// @brief  Descriptor increment size.
+    const uint32_t descriptorSize;
+
+    /// @brief  Maximum number of descriptors in the bindless region.
+    const uint32_t bindlessCapacity;
+
+    /// @brief  Number of descriptors in each dynamic block.
+    const uint32_t blockSize;
+
+    /// @brief  Number of dynamic blocks.
+    const uint32_t blockCount;
+
+    /// @brief  The D3D12 shader visible descriptor heap.
+    Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> heap;
+
+    /// @brief  Descriptor handle to start of the descriptor heap.
+    DescriptorHandle heapStart;
+
+    /// @brief  Number of bindless descriptors that have ever been allocated.
+    uint32_t bindlessAllocated;
+
+    /// @brief  End of the bindless region. Descriptors after this limit are borrowed as dynamic blocks.
+    uint32_t bindlessLimit;
+
+    /// @brief  Free bindless descriptor indices that could be reused immediately.
+    std::vector<uint32_t> freeBindless;
+
+    /// @brief  Freed bindless descriptor indices that have not been retired with a sync point.
+    std::vector<uint32_t> pendingBindless;
+
+    /// @brief  Retired bindless descriptors waiting for GPU.
+    std::deque<RetiredBindlessBatch> retiredBindless;
+
+    /// @brief  Mutex to protect bindless region.
+    mutable std::mutex bindlessMutex;
+
+    /// @brief  Number of dynamic blocks that have ever been allocated.
+    uint32_t blocksAllocated;
+
+    /// @brief  Retired dynamic blocks waiting for GPU.
+    std::deque<std::pair<uint64_t, uint32_t>> retiredBlocks;
+
+    /// @brief  Mutex to protect dynamic region. This mutex must be locked before bindless mutex if both are locked.
+    mutable std::mutex blockMutex;
+
+    /// @brief  Notified when dynamic blocks are retired.
+    std::condition_variable blockRetiredCondition;
+};
+
+} // namespace YaGE
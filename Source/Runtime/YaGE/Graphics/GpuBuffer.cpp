@@ -6,23 +6,22 @@ using namespace YaGE;
 
 YaGE::GpuBuffer::GpuBuffer() noexcept : GpuResource(), bufferSize(), address() {}
 
-YaGE::GpuBuffer::GpuBuffer(size_t size) : GpuResource(), bufferSize(), address() {
+YaGE::GpuBuffer::GpuBuffer(size_t size)
+    : GpuBuffer(size,
+                D3D12_HEAP_TYPE_DEFAULT,
+                D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS,
+                D3D12_RESOURCE_STATE_COMMON) {}
+
+YaGE::GpuBuffer::GpuBuffer(size_t                size,
+                           D3D12_HEAP_TYPE       heapType,
+                           D3D12_RESOURCE_FLAGS  flags,
+                           D3D12_RESOURCE_STATES initialState)
+    : GpuResource(), bufferSize(), address(), byteAddressUAV() {
     // Align up.
     size       = ((size + 255) & ~size_t(255));
     bufferSize = size;
 
-    // Create D3D12 resources.
-    RenderDevice &device = RenderDevice::Singleton();
-
     { // Create ID3D12Resource.
-        const D3D12_HEAP_PROPERTIES heapProps{
-            /* Type                 = */ D3D12_HEAP_TYPE_DEFAULT,
-            /* CPUPageProperty      = */ D3D12_CPU_PAGE_PROPERTY_UNKNOWN,
-            /* MemoryPoolPreference = */ D3D12_MEMORY_POOL_UNKNOWN,
-            /* CreationNodeMask     = */ 0,
-            /* VisibleNodeMask      = */ 0,
-        };
-
         const D3D12_RESOURCE_DESC desc{
             /* Dimension        = */ D3D12_RESOURCE_DIMENSION_BUFFER,
             /* Alignment        = */ 0,
@@ -37,19 +36,18 @@ YaGE::GpuBuffer::GpuBuffer(size_t size) : GpuResource(), bufferSize(), address()
                 /* Quality = */ 0,
             },
             /* Layout = */ D3D12_TEXTURE_LAYOUT_ROW_MAJOR,
-            /* Flags  = */ D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS,
+            /* Flags  = */ flags,
         };
 
-        HRESULT hr = device.Device()->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &desc,
-                                                              D3D12_RESOURCE_STATE_COMMON, nullptr,
-                                                              IID_PPV_ARGS(resource.GetAddressOf()));
+        HRESULT hr = CreateResource(heapType, desc, initialState, nullptr);
         if (FAILED(hr))
             throw RenderAPIException(hr, u"Failed to create ID3D12Resource for GpuBuffer.");
 
         this->address = resource->GetGPUVirtualAddress();
     }
 
-    { // Create byte address unordered access view.
+    // Unordered access views could only be created for buffers that allow unordered access.
+    if (flags & D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS) {
         D3D12_UNORDERED_ACCESS_VIEW_DESC desc;
         desc.Format                      = DXGI_FORMAT_R32_TYPELESS;
         desc.ViewDimension               = D3D12_UAV_DIMENSION_BUFFER;
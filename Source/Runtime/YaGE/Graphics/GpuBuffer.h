@@ -64,6 +64,22 @@ public:
         return byteAddressUAV;
     }
 
+protected:
+    /// @brief
+    ///   Create a new GpuBuffer with at least the given size in the specified heap. Byte address unordered access view is created only if @p flags allows unordered access.
+    ///
+    /// @param size         Expected buffer size in byte of this GpuBuffer. The actual buffer size might be greater than the given size.
+    /// @param heapType     Type of heap that this GpuBuffer should be created in.
+    /// @param flags        Resource flags of this GpuBuffer.
+    /// @param initialState Initial state of this GpuBuffer.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to create D3D12 resource for this GpuBuffer.
+    YAGE_API GpuBuffer(size_t                size,
+                       D3D12_HEAP_TYPE       heapType,
+                       D3D12_RESOURCE_FLAGS  flags,
+                       D3D12_RESOURCE_STATES initialState);
+
 private:
     /// @brief  Size in byte of this GpuBuffer.
     size_t bufferSize;
@@ -0,0 +1,340 @@
+#include "GpuMemoryAllocator.h"
+
+#include <algorithm>
+
+using namespace YaGE;
+
+namespace {
+
+/// @brief  Size in byte of each heap block.
+constexpr const uint64_t HEAP_BLOCK_SIZE = 0x4000000;
+
+/// @brief  Minimum allocation size. This is also the default placement alignment of resources.
+constexpr const uint64_t MIN_ALLOCATION_SIZE = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+
+/// @brief  Maximum buddy order of heap blocks. Allocation size of order n is (MIN_ALLOCATION_SIZE << n).
+constexpr const uint32_t MAX_ORDER = 10;
+
+/// @brief  Resources larger than this size are created as committed resources to avoid wasting too much heap space.
+constexpr const uint64_t MAX_PLACED_RESOURCE_SIZE = HEAP_BLOCK_SIZE / 4;
+
+/// @brief
+///   Get buddy order of the specified allocation size.
+///
+/// @param size     Size in byte of the allocation.
+///
+/// @return uint32_t
+///   Return the minimum buddy order that could hold the allocation.
+YAGE_NODISCARD YAGE_FORCEINLINE auto BuddyOrder(uint64_t size) noexcept -> uint32_t {
+    uint32_t order = 0;
+    while ((MIN_ALLOCATION_SIZE << order) < size)
+        order += 1;
+    return order;
+}
+
+class HeapBlock {
+public:
+    /// @brief
+    ///   Create a heap block.
+    ///
+    /// @param heap         The D3D12 heap of this block. Size of the heap must be @p HEAP_BLOCK_SIZE.
+    /// @param poolIndex    Index of the heap pool that this block belongs to.
+    HeapBlock(Microsoft::WRL::ComPtr<ID3D12Heap> heap, uint32_t poolIndex) noexcept
+        : heap(std::move(heap)), poolIndex(poolIndex), allocatedSize(), freeLists() {
+        freeLists[MAX_ORDER].push_back(0);
+    }
+
+    /// @brief
+    ///   Try to allocate a buddy block of the specified order.
+    ///
+    /// @param order        Buddy order of the allocation.
+    /// @param[out] offset  Receives offset in byte from start of the heap.
+    ///
+    /// @return bool
+    /// @retval true    Succeeded to allocate memory from this block.
+    /// @retval false   There is no enough free space in this block.
+    auto Allocate(uint32_t order, uint64_t &offset) noexcept -> bool {
+        uint32_t current = order;
+        while (current <= MAX_ORDER && freeLists[current].empty())
+            current += 1;
+
+        if (current > MAX_ORDER)
+            return false;
+
+        uint32_t unit = freeLists[current].back();
+        freeLists[current].pop_back();
+
+        // Split larger blocks and put the higher halves back to free lists.
+        while (current > order) {
+            current -= 1;
+            freeLists[current].push_back(unit + (1U << current));
+        }
+
+        allocatedSize += (MIN_ALLOCATION_SIZE << order);
+        offset = uint64_t(unit) * MIN_ALLOCATION_SIZE;
+        return true;
+    }
+
+    /// @brief
+    ///   Free a buddy block and merge it with free buddies.
+    ///
+    /// @param offset   Offset in byte from start of the heap.
+    /// @param order    Buddy order of the allocation.
+    auto Free(uint64_t offset, uint32_t order) noexcept -> void {
+        allocatedSize -= (MIN_ALLOCATION_SIZE << order);
+
+        uint32_t unit = static_cast<uint32_t>(offset / MIN_ALLOCATION_SIZE);
+        while (order < MAX_ORDER) {
+            const uint32_t buddy = unit ^ (1U << order);
+
+            auto &list = freeLists[order];
+            auto  iter = std::find(list.begin(), list.end(), buddy);
+            if (iter == list.end())
+                break;
+
+            *iter = list.back();
+            list.pop_back();
+
+            unit = std::min(unit, buddy);
+            order += 1;
+        }
+
+        freeLists[order].push_back(unit);
+    }
+
+    /// @brief
+    ///   Checks if there is no allocation in this block.
+    ///
+    /// @return bool
+    /// @retval true    There is no allocation in this block.
+    /// @retval false   There is at least one allocation in this block.
+    YAGE_NODISCARD auto IsEmpty() const noexcept -> bool { return allocatedSize == 0; }
+
+    /// @brief
+    ///   Get D3D12 heap of this block.
+    ///
+    /// @return ID3D12Heap *
+    ///   Return D3D12 heap of this block.
+    YAGE_NODISCARD auto Heap() const noexcept -> ID3D12Heap * { return heap.Get(); }
+
+    /// @brief
+    ///   Get index of the heap pool that this block belongs to.
+    ///
+    /// @return uint32_t
+    ///   Return index of the heap pool.
+    YAGE_NODISCARD auto PoolIndex() const noexcept -> uint32_t { return poolIndex; }
+
+private:
+    /// @brief  The D3D12 heap object.
+    Microsoft::WRL::ComPtr<ID3D12Heap> heap;
+
+    /// @brief  Index of the heap pool that this block belongs to.
+    uint32_t poolIndex;
+
+    /// @brief  Total allocated size in byte.
+    uint64_t allocatedSize;
+
+    /// @brief  Free buddy lists for each order. Offsets are stored in units of @p MIN_ALLOCATION_SIZE.
+    std::vector<uint32_t> freeLists[MAX_ORDER + 1];
+};
+
+} // namespace
+
+YaGE::GpuMemoryAllocator::GpuMemoryAllocator() noexcept : device(), pools(), usage() {
+    for (auto &value : usage)
+        value.store(0, std::memory_order_relaxed);
+
+    // Default heap pools.
+    pools[0].heapType      = D3D12_HEAP_TYPE_DEFAULT;
+    pools[0].heapFlags     = D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS;
+    pools[0].heapAlignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+
+    pools[1].heapType      = D3D12_HEAP_TYPE_DEFAULT;
+    pools[1].heapFlags     = D3D12_HEAP_FLAG_ALLOW_ONLY_RT_DS_TEXTURES;
+    pools[1].heapAlignment = D3D12_DEFAULT_MSAA_RESOURCE_PLACEMENT_ALIGNMENT;
+
+    pools[2].heapType      = D3D12_HEAP_TYPE_DEFAULT;
+    pools[2].heapFlags     = D3D12_HEAP_FLAG_ALLOW_ONLY_NON_RT_DS_TEXTURES;
+    pools[2].heapAlignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+
+    // Upload and readback heaps only support buffers.
+    pools[3].heapType      = D3D12_HEAP_TYPE_UPLOAD;
+    pools[3].heapFlags     = D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS;
+    pools[3].heapAlignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+
+    pools[4].heapType      = D3D12_HEAP_TYPE_READBACK;
+    pools[4].heapFlags     = D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS;
+    pools[4].heapAlignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+}
+
+YaGE::GpuMemoryAllocator::~GpuMemoryAllocator() noexcept {
+    for (auto &pool : pools) {
+        for (auto block : pool.blocks)
+            delete static_cast<HeapBlock *>(block);
+        pool.blocks.clear();
+    }
+}
+
+auto YaGE::GpuMemoryAllocator::Initialize(ID3D12Device1 *dev) noexcept -> void { this->device = dev; }
+
+YAGE_NODISCARD auto YaGE::GpuMemoryAllocator::CreateResource(D3D12_HEAP_TYPE            heapType,
+                                                             const D3D12_RESOURCE_DESC &desc,
+                                                             D3D12_RESOURCE_STATES      initialState,
+                                                             const D3D12_CLEAR_VALUE   *clearValue,
+                                                             ID3D12Resource           **resource,
+                                                             GpuMemoryAllocation       &allocation) noexcept
+    -> HRESULT {
+    HRESULT hr = S_OK;
+    allocation = GpuMemoryAllocation{};
+
+    allocation.category = ResourceCategory(desc);
+
+    const uint32_t                       poolIndex = PoolIndex(heapType, desc);
+    const D3D12_RESOURCE_ALLOCATION_INFO info      = device->GetResourceAllocationInfo(0, 1, &desc);
+
+    if (poolIndex != UINT32_MAX && info.SizeInBytes != UINT64_MAX && info.SizeInBytes <= MAX_PLACED_RESOURCE_SIZE) {
+        HeapPool      &pool  = pools[poolIndex];
+        const uint32_t order = BuddyOrder(std::max(info.SizeInBytes, info.Alignment));
+
+        HeapBlock *block  = nullptr;
+        uint64_t   offset = 0;
+
+        { // Lock scope.
+            std::lock_guard<std::mutex> lock(pool.mutex);
+            for (auto b : pool.blocks) {
+                if (static_cast<HeapBlock *>(b)->Allocate(order, offset)) {
+                    block = static_cast<HeapBlock *>(b);
+                    break;
+                }
+            }
+
+            // Create a new heap block.
+            if (block == nullptr) {
+                const D3D12_HEAP_DESC heapDesc{
+                    /* SizeInBytes = */ HEAP_BLOCK_SIZE,
+                    /* Properties  = */
+                    {
+                        /* Type                 = */ pool.heapType,
+                        /* CPUPageProperty      = */ D3D12_CPU_PAGE_PROPERTY_UNKNOWN,
+                        /* MemoryPoolPreference = */ D3D12_MEMORY_POOL_UNKNOWN,
+                        /* CreationNodeMask     = */ 0,
+                        /* VisibleNodeMask      = */ 0,
+                    },
+                    /* Alignment = */ pool.heapAlignment,
+                    /* Flags     = */ pool.heapFlags,
+                };
+
+                Microsoft::WRL::ComPtr<ID3D12Heap> heap;
+                hr = device->CreateHeap(&heapDesc, IID_PPV_ARGS(heap.GetAddressOf()));
+                if (SUCCEEDED(hr)) {
+                    block = new HeapBlock(std::move(heap), poolIndex);
+                    pool.blocks.push_back(block);
+                    block->Allocate(order, offset);
+                }
+            }
+        }
+
+        if (block != nullptr) {
+            allocation.heap   = block->Heap();
+            allocation.offset = offset;
+            allocation.size   = (MIN_ALLOCATION_SIZE << order);
+            allocation.block  = block;
+            TrackUsage(allocation.category, static_cast<int64_t>(allocation.size));
+
+            hr = device->CreatePlacedResource(allocation.heap, allocation.offset, &desc, initialState, clearValue,
+                                              IID_PPV_ARGS(resource));
+            if (SUCCEEDED(hr))
+                return hr;
+
+            // Failed to place this resource. Try committed resource instead.
+            Free(allocation);
+            allocation.heap   = nullptr;
+            allocation.offset = 0;
+            allocation.size   = 0;
+            allocation.block  = nullptr;
+        }
+    }
+
+    // Create committed resource.
+    const D3D12_HEAP_PROPERTIES heapProps{
+        /* Type                 = */ heapType,
+        /* CPUPageProperty      = */ D3D12_CPU_PAGE_PROPERTY_UNKNOWN,
+        /* MemoryPoolPreference = */ D3D12_MEMORY_POOL_UNKNOWN,
+        /* CreationNodeMask     = */ 0,
+        /* VisibleNodeMask      = */ 0,
+    };
+
+    hr = device->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &desc, initialState, clearValue,
+                                         IID_PPV_ARGS(resource));
+    if (SUCCEEDED(hr)) {
+        allocation.size = info.SizeInBytes;
+        TrackUsage(allocation.category, static_cast<int64_t>(allocation.size));
+    }
+
+    return hr;
+}
+
+auto YaGE::GpuMemoryAllocator::Free(const GpuMemoryAllocation &allocation) noexcept -> void {
+    TrackUsage(allocation.category, -static_cast<int64_t>(allocation.size));
+    if (allocation.block == nullptr)
+        return;
+
+    HeapBlock *const block = static_cast<HeapBlock *>(allocation.block);
+    HeapPool        &pool  = pools[block->PoolIndex()];
+
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    block->Free(allocation.offset, BuddyOrder(allocation.size));
+
+    // Keep at least one heap block in each pool to avoid creating heaps frequently.
+    if (block->IsEmpty() && pool.blocks.size() > 1) {
+        auto iter = std::find(pool.blocks.begin(), pool.blocks.end(), allocation.block);
+        if (iter != pool.blocks.end()) {
+            *iter = pool.blocks.back();
+            pool.blocks.pop_back();
+        }
+
+        delete block;
+    }
+}
+
+auto YaGE::GpuMemoryAllocator::SetCategory(GpuMemoryAllocation &allocation, GpuMemoryCategory category) noexcept
+    -> void {
+    TrackUsage(allocation.category, -static_cast<int64_t>(allocation.size));
+    TrackUsage(category, static_cast<int64_t>(allocation.size));
+    allocation.category = category;
+}
+
+YAGE_NODISCARD auto YaGE::GpuMemoryAllocator::ResourceCategory(const D3D12_RESOURCE_DESC &desc) noexcept
+    -> GpuMemoryCategory {
+    if (desc.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER)
+        return GpuMemoryCategory::Buffer;
+
+    if (desc.Flags & (D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET | D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL))
+        return GpuMemoryCategory::RenderTarget;
+
+    return GpuMemoryCategory::Texture;
+}
+
+YAGE_NODISCARD auto YaGE::GpuMemoryAllocator::PoolIndex(D3D12_HEAP_TYPE            heapType,
+                                                        const D3D12_RESOURCE_DESC &desc) noexcept -> uint32_t {
+    if (desc.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER) {
+        switch (heapType) {
+        case D3D12_HEAP_TYPE_DEFAULT:
+            return 0;
+        case D3D12_HEAP_TYPE_UPLOAD:
+            return 3;
+        case D3D12_HEAP_TYPE_READBACK:
+            return 4;
+        default:
+            return UINT32_MAX;
+        }
+    }
+
+    if (heapType != D3D12_HEAP_TYPE_DEFAULT)
+        return UINT32_MAX;
+
+    if (desc.Flags & (D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET | D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL))
+        return 1;
+
+    return 2;
+}
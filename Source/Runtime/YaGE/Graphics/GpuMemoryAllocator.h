@@ -0,0 +1,173 @@
+#pragma once
+
+#include "../Core/Common.h"
+
+#include <d3d12.h>
+#include <wrl/client.h>
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace YaGE {
+
+enum class GpuMemoryCategory : uint32_t {
+    Buffer,
+    Texture,
+    RenderTarget,
+    TempPage,
+    DescriptorHeap,
+    AccelerationStructure,
+    Count,
+};
+
+struct GpuMemoryAllocation {
+    /// @brief  The heap that this allocation belongs to. This is nullptr if the resource is a committed resource.
+    ID3D12Heap *heap;
+
+    /// @brief  Offset in byte from start of the heap.
+    uint64_t offset;
+
+    /// @brief  Size in byte of this allocation.
+    uint64_t size;
+
+    /// @brief  The heap block that this allocation belongs to. This is type-erased pointer.
+    void *block;
+
+    /// @brief  Usage category that size of this allocation is accounted to.
+    GpuMemoryCategory category;
+};
+
+class GpuMemoryAllocator {
+public:
+    /// @brief
+    ///   Create a GPU memory allocator. This object must be manually initialized before using.
+    YAGE_API GpuMemoryAllocator() noexcept;
+
+    /// @brief
+    ///   Copy constructor is disabled.
+    GpuMemoryAllocator(const GpuMemoryAllocator &) = delete;
+
+    /// @brief
+    ///   Copy assignment is disabled.
+    auto operator=(const GpuMemoryAllocator &) = delete;
+
+    /// @brief
+    ///   Destroy this GPU memory allocator and release all heaps.
+    /// @note
+    ///   All resources created by this allocator must be released before destroying the allocator.
+    YAGE_API ~GpuMemoryAllocator() noexcept;
+
+    /// @brief
+    ///   Initialize this GPU memory allocator. Duplicate initialization check is not performed.
+    ///
+    /// @param dev  D3D12 device that is used to create heaps and resources.
+    YAGE_API auto Initialize(ID3D12Device1 *dev) noexcept -> void;
+
+    /// @brief
+    ///   Create a D3D12 resource.
+    /// @remarks
+    ///   The resource is placed in a large shared heap block if possible. Buffers, render target/depth stencil textures and other textures are allocated from different heap pools so that resource heap tier 1 devices are supported. Placed render target and depth stencil textures must be initialized before first use. @p CommandBuffer discards them on their first transition. Resources that are too large or could not be placed are created as committed resources.
+    ///
+    /// @param heapType         Type of heap that the resource should be created in.
+    /// @param desc             Description of the resource to be created.
+    /// @param initialState     Initial state of the resource.
+    /// @param clearValue       Optimized clear value of the resource. Could be nullptr.
+    /// @param[out] resource    Receives the created resource.
+    /// @param[out] allocation  Receives the memory allocation of the created resource. The allocation should be freed after the resource is released.
+    ///
+    /// @return HRESULT
+    ///   Return @p S_OK if succeeded to create the resource. Otherwise, return the error code.
+    YAGE_NODISCARD YAGE_API auto CreateResource(D3D12_HEAP_TYPE            heapType,
+                                                const D3D12_RESOURCE_DESC &desc,
+                                                D3D12_RESOURCE_STATES      initialState,
+                                                const D3D12_CLEAR_VALUE   *clearValue,
+                                                ID3D12Resource           **resource,
+                                                GpuMemoryAllocation       &allocation) noexcept -> HRESULT;
+
+    /// @brief
+    ///   Free the specified memory allocation. Committed resource allocations are only removed from memory usage.
+    ///
+    /// @param allocation   The memory allocation to be freed.
+    YAGE_API auto Free(const GpuMemoryAllocation &allocation) noexcept -> void;
+
+    /// @brief
+    ///   Account the specified memory allocation to another usage category.
+    ///
+    /// @param[in, out] allocation  The memory allocation to be accounted.
+    /// @param          category    The new usage category of the allocation.
+    YAGE_API auto SetCategory(GpuMemoryAllocation &allocation, GpuMemoryCategory category) noexcept -> void;
+
+    /// @brief
+    ///   Add or remove memory usage that is not allocated by this allocator, for example descriptor heaps and user created heaps. This method is thread-safe.
+    ///
+    /// @param category     Usage category of the memory.
+    /// @param size         Size in byte of the memory. Negative values remove memory usage.
+    auto TrackUsage(GpuMemoryCategory category, int64_t size) noexcept -> void {
+        usage[static_cast<uint32_t>(category)].fetch_add(static_cast<uint64_t>(size), std::memory_order_relaxed);
+    }
+
+    /// @brief
+    ///   Get size of memory that is currently used by the specified category. Placed resources are accounted by their allocation sizes rather than sizes of heap blocks.
+    ///
+    /// @param category     Usage category of the memory.
+    ///
+    /// @return uint64_t
+    ///   Return size in byte of memory that is used by @p category.
+    YAGE_NODISCARD auto Usage(GpuMemoryCategory category) const noexcept -> uint64_t {
+        return usage[static_cast<uint32_t>(category)].load(std::memory_order_relaxed);
+    }
+
+    /// @brief
+    ///   Get usage category of the specified resource.
+    ///
+    /// @param desc     Description of the resource.
+    ///
+    /// @return GpuMemoryCategory
+    ///   Return @p RenderTarget for render target and depth stencil textures, @p Texture for other textures and @p Buffer for buffers.
+    YAGE_NODISCARD YAGE_API static auto ResourceCategory(const D3D12_RESOURCE_DESC &desc) noexcept
+        -> GpuMemoryCategory;
+
+private:
+    struct HeapPool {
+        /// @brief  Type of heaps in this pool.
+        D3D12_HEAP_TYPE heapType;
+
+        /// @brief  Flags of heaps in this pool.
+        D3D12_HEAP_FLAGS heapFlags;
+
+        /// @brief  Alignment of heaps in this pool.
+        uint64_t heapAlignment;
+
+        /// @brief  Heap blocks in this pool. These are type-erased pointers.
+        std::vector<void *> blocks;
+
+        /// @brief  Mutex that is used to protect heap blocks.
+        mutable std::mutex mutex;
+    };
+
+    /// @brief
+    ///   Get index of heap pool for the specified resource.
+    ///
+    /// @param heapType     Type of heap that the resource should be created in.
+    /// @param desc         Description of the resource.
+    ///
+    /// @return uint32_t
+    ///   Return index of the heap pool. Return @p UINT32_MAX if the resource could not be placed in any heap pool.
+    YAGE_NODISCARD static auto PoolIndex(D3D12_HEAP_TYPE heapType, const D3D12_RESOURCE_DESC &desc) noexcept
+        -> uint32_t;
+
+    /// @brief  Number of heap pools.
+    static constexpr const uint32_t POOL_COUNT = 5;
+
+    /// @brief  D3D12 device that is used to create heaps and resources.
+    ID3D12Device1 *device;
+
+    /// @brief  Heap pools.
+    HeapPool pools[POOL_COUNT];
+
+    /// @brief  Size in byte of memory that is used by each category. Indexed by @p GpuMemoryCategory.
+    std::atomic_uint64_t usage[static_cast<uint32_t>(GpuMemoryCategory::Count)];
+};
+
+} // namespace YaGE
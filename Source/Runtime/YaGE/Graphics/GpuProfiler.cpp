@@ -0,0 +1,317 @@
+#include "GpuProfiler.h"
+#include "../Core/Exception.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace YaGE;
+
+namespace {
+
+/// @brief  Size in byte of a resolved timestamp query.
+constexpr const size_t TIMESTAMP_SIZE = sizeof(uint64_t);
+
+/// @brief  Size in byte of a resolved pipeline statistics query.
+constexpr const size_t PIPELINE_STATISTICS_SIZE = sizeof(D3D12_QUERY_DATA_PIPELINE_STATISTICS);
+
+} // namespace
+
+YaGE::GpuProfiler::QueryBuffer::QueryBuffer(size_t size) : GpuResource() {
+    const D3D12_RESOURCE_DESC desc{
+        /* Dimension        = */ D3D12_RESOURCE_DIMENSION_BUFFER,
+        /* Alignment        = */ 0,
+        /* Width            = */ size,
+        /* Height           = */ 1,
+        /* DepthOrArraySize = */ 1,
+        /* MipLevels        = */ 1,
+        /* Format           = */ DXGI_FORMAT_UNKNOWN,
+        /* SampleDesc       = */
+        {
+            /* Count   = */ 1,
+            /* Quality = */ 0,
+        },
+        /* Layout = */ D3D12_TEXTURE_LAYOUT_ROW_MAJOR,
+        /* Flags  = */ D3D12_RESOURCE_FLAG_NONE,
+    };
+
+    HRESULT hr = CreateResource(D3D12_HEAP_TYPE_READBACK, desc, D3D12_RESOURCE_STATE_COPY_DEST, nullptr);
+    if (FAILED(hr))
+        throw RenderAPIException(hr, u"Failed to create readback buffer for GPU profiler.");
+}
+
+auto YaGE::GpuProfiler::QueryBuffer::Map(size_t offset, size_t size) noexcept -> const void * {
+    const D3D12_RANGE range{offset, offset + size};
+
+    void   *data = nullptr;
+    HRESULT hr   = resource->Map(0, &range, &data);
+    if (FAILED(hr))
+        return nullptr;
+
+    return static_cast<const uint8_t *>(data) + offset;
+}
+
+auto YaGE::GpuProfiler::QueryBuffer::Unmap() noexcept -> void {
+    const D3D12_RANGE range{0, 0};
+    resource->Unmap(0, &range);
+}
+
+YaGE::GpuProfiler::GpuProfiler(uint32_t maxScopes, bool enablePipelineStatistics, D3D12_COMMAND_LIST_TYPE queueType)
+    : renderDevice(RenderDevice::Singleton()),
+      maxScopes(maxScopes),
+      timestampFrequency(),
+      timestampHeap(),
+      pipelineStatisticsHeap(),
+      readbackBuffer(static_cast<size_t>(FRAME_COUNT) * maxScopes *
+                     (2 * TIMESTAMP_SIZE + (enablePipelineStatistics ? PIPELINE_STATISTICS_SIZE : 0))),
+      frames(),
+      currentFrame(),
+      statisticsScopes(),
+      mutex(),
+      results(),
+      frameTime() {
+    ID3D12Device1 *const device = renderDevice.Device();
+
+    HRESULT hr = renderDevice.CommandQueue(queueType)->GetTimestampFrequency(&timestampFrequency);
+    if (FAILED(hr))
+        throw RenderAPIException(hr, u"Failed to get timestamp frequency of command queue.");
+
+    { // Create timestamp query heap.
+        const D3D12_QUERY_HEAP_DESC desc{
+            /* Type     = */ D3D12_QUERY_HEAP_TYPE_TIMESTAMP,
+            /* Count    = */ FRAME_COUNT * maxScopes * 2,
+            /* NodeMask = */ 0,
+        };
+
+        hr = device->CreateQueryHeap(&desc, IID_PPV_ARGS(timestampHeap.GetAddressOf()));
+        if (FAILED(hr))
+            throw RenderAPIException(hr, u"Failed to create timestamp query heap.");
+    }
+
+    if (enablePipelineStatistics) { // Create pipeline statistics query heap.
+        const D3D12_QUERY_HEAP_DESC desc{
+            /* Type     = */ D3D12_QUERY_HEAP_TYPE_PIPELINE_STATISTICS,
+            /* Count    = */ FRAME_COUNT * maxScopes,
+            /* NodeMask = */ 0,
+        };
+
+        hr = device->CreateQueryHeap(&desc, IID_PPV_ARGS(pipelineStatisticsHeap.GetAddressOf()));
+        if (FAILED(hr))
+            throw RenderAPIException(hr, u"Failed to create pipeline statistics query heap.");
+    }
+}
+
+YaGE::GpuProfiler::~GpuProfiler() noexcept {
+    for (const auto &frame : frames) {
+        if (frame.syncPoint != 0)
+            renderDevice.Sync(frame.syncPoint);
+    }
+}
+
+auto YaGE::GpuProfiler::BeginScope(CommandBuffer &commandBuffer, StringView name) -> uint32_t {
+    // Handle of the scope is its query index, so that the scope is ended in the frame that it begins in.
+    uint32_t query;
+    bool     hasStatistics = false;
+
+    { // Lock scope.
+        std::lock_guard<std::mutex> lock(mutex);
+
+        Frame &frame = frames[currentFrame];
+        if (frame.scopes.size() >= maxScopes)
+            return UINT32_MAX;
+
+        query = currentFrame * maxScopes + static_cast<uint32_t>(frame.scopes.size());
+
+        // Pipeline statistics queries could not be nested. Only the outermost scope on each command buffer has one.
+        if (pipelineStatisticsHeap != nullptr) {
+            hasStatistics = std::none_of(statisticsScopes.begin(), statisticsScopes.end(),
+                                         [&commandBuffer](const std::pair<const CommandBuffer *, uint32_t> &active) {
+                                             return active.first == &commandBuffer;
+                                         });
+            if (hasStatistics)
+                statisticsScopes.emplace_back(&commandBuffer, query);
+        }
+
+        frame.scopes.push_back(Scope{String(name), false, false, hasStatistics});
+    }
+
+    commandBuffer.EndQuery(timestampHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP, query * 2);
+    if (hasStatistics)
+        commandBuffer.BeginQuery(pipelineStatisticsHeap.Get(), D3D12_QUERY_TYPE_PIPELINE_STATISTICS, query);
+
+    return query;
+}
+
+auto YaGE::GpuProfiler::EndScope(CommandBuffer &commandBuffer, uint32_t scope) noexcept -> void {
+    if (scope == UINT32_MAX)
+        return;
+
+    const uint32_t frameIndex    = scope / maxScopes;
+    bool           hasStatistics = false;
+
+    { // Lock scope.
+        std::lock_guard<std::mutex> lock(mutex);
+
+        // Scopes must not span EndFrame(). Queries of the frame that this scope begins in may have been resolved and
+        // read back, so the scope is discarded.
+        assert(frameIndex == currentFrame);
+        if (frameIndex == currentFrame)
+            frames[currentFrame].scopes[scope % maxScopes].ended = true;
+
+        const std::pair<const CommandBuffer *, uint32_t> key(&commandBuffer, scope);
+
+        auto iter = std::find(statisticsScopes.begin(), statisticsScopes.end(), key);
+        if (iter != statisticsScopes.end()) {
+            hasStatistics = true;
+            statisticsScopes.erase(iter);
+        }
+    }
+
+    // Active queries are always ended, so that the command list is valid even if the scope is discarded.
+    if (hasStatistics)
+        commandBuffer.EndQuery(pipelineStatisticsHeap.Get(), D3D12_QUERY_TYPE_PIPELINE_STATISTICS, scope);
+    commandBuffer.EndQuery(timestampHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP, scope * 2 + 1);
+}
+
+auto YaGE::GpuProfiler::Resolve(CommandBuffer &commandBuffer) noexcept -> void {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    Frame         &frame           = frames[currentFrame];
+    const uint32_t count           = static_cast<uint32_t>(frame.scopes.size());
+    const size_t   statisticsStart = static_cast<size_t>(FRAME_COUNT) * maxScopes * 2 * TIMESTAMP_SIZE;
+
+    // Queries that are never ended must not be resolved. Resolve contiguous runs of ended scopes.
+    uint32_t first = frame.resolvedCount;
+    while (first < count) {
+        if (!frame.scopes[first].ended) {
+            first += 1;
+            continue;
+        }
+
+        uint32_t last = first + 1;
+        while (last < count && frame.scopes[last].ended)
+            last += 1;
+
+        for (uint32_t i = first; i < last; ++i)
+            frame.scopes[i].resolved = true;
+
+        const uint32_t query = currentFrame * maxScopes + first;
+        commandBuffer.ResolveQueryData(timestampHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP, query * 2, (last - first) * 2,
+                                       readbackBuffer, query * 2 * TIMESTAMP_SIZE);
+
+        // Nested scopes have no pipeline statistics query. Resolve contiguous runs of outermost scopes.
+        for (uint32_t i = first; pipelineStatisticsHeap != nullptr && i < last;) {
+            if (!frame.scopes[i].hasStatistics) {
+                i += 1;
+                continue;
+            }
+
+            uint32_t end = i + 1;
+            while (end < last && frame.scopes[end].hasStatistics)
+                end += 1;
+
+            const uint32_t statisticsQuery = currentFrame * maxScopes + i;
+            commandBuffer.ResolveQueryData(pipelineStatisticsHeap.Get(), D3D12_QUERY_TYPE_PIPELINE_STATISTICS,
+                                           statisticsQuery, end - i, readbackBuffer,
+                                           statisticsStart + statisticsQuery * PIPELINE_STATISTICS_SIZE);
+            i = end;
+        }
+
+        first = last;
+    }
+
+    frame.resolvedCount = count;
+}
+
+auto YaGE::GpuProfiler::EndFrame(uint64_t syncPoint) -> void {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    frames[currentFrame].syncPoint = syncPoint;
+    currentFrame                   = (currentFrame + 1) % FRAME_COUNT;
+
+    // The oldest frame is reused as the new frame. Wait for it only if CPU is too far ahead of GPU.
+    Frame &next = frames[currentFrame];
+    if (next.syncPoint != 0 && !renderDevice.IsSyncPointReached(next.syncPoint))
+        renderDevice.Sync(next.syncPoint);
+
+    // Read back finished frames from the oldest to the latest.
+    for (uint32_t i = 0; i < FRAME_COUNT; ++i) {
+        const uint32_t frameIndex = (currentFrame + i) % FRAME_COUNT;
+        const Frame   &frame      = frames[frameIndex];
+        if (frame.syncPoint != 0 && renderDevice.IsSyncPointReached(frame.syncPoint))
+            ReadBack(frameIndex);
+    }
+
+    next.scopes.clear();
+    next.resolvedCount = 0;
+    next.syncPoint     = 0;
+}
+
+auto YaGE::GpuProfiler::ReadBack(uint32_t frameIndex) -> void {
+    Frame         &frame           = frames[frameIndex];
+    const uint32_t count           = frame.resolvedCount;
+    const size_t   firstQuery      = static_cast<size_t>(frameIndex) * maxScopes;
+    const size_t   statisticsStart = static_cast<size_t>(FRAME_COUNT) * maxScopes * 2 * TIMESTAMP_SIZE;
+
+    // Keep results of the previous frame if nothing is profiled in this frame.
+    if (count == 0) {
+        frame.scopes.clear();
+        frame.syncPoint = 0;
+        return;
+    }
+
+    const auto *timestamps =
+        static_cast<const uint64_t *>(readbackBuffer.Map(firstQuery * 2 * TIMESTAMP_SIZE, count * 2 * TIMESTAMP_SIZE));
+
+    const D3D12_QUERY_DATA_PIPELINE_STATISTICS *statistics = nullptr;
+    if (pipelineStatisticsHeap != nullptr && timestamps != nullptr) {
+        const void *data = readbackBuffer.Map(statisticsStart + firstQuery * PIPELINE_STATISTICS_SIZE,
+                                              count * PIPELINE_STATISTICS_SIZE);
+        statistics       = static_cast<const D3D12_QUERY_DATA_PIPELINE_STATISTICS *>(data);
+    }
+
+    if (timestamps != nullptr) {
+        // Find the first timestamp of this frame.
+        uint64_t frameBegin = UINT64_MAX;
+        uint64_t frameEnd   = 0;
+        for (uint32_t i = 0; i < count; ++i) {
+            if (frame.scopes[i].resolved) {
+                frameBegin = std::min(frameBegin, timestamps[i * 2]);
+                frameEnd   = std::max(frameEnd, timestamps[i * 2 + 1]);
+            }
+        }
+
+        const double msPerTick = 1000.0 / static_cast<double>(timestampFrequency);
+
+        results.clear();
+        for (uint32_t i = 0; i < count; ++i) {
+            const Scope &scope = frame.scopes[i];
+            if (!scope.resolved)
+                continue;
+
+            const uint64_t begin = timestamps[i * 2];
+            const uint64_t end   = std::max(begin, timestamps[i * 2 + 1]);
+
+            GpuProfileResult result{
+                /* name       = */ scope.name,
+                /* beginTime  = */ static_cast<double>(begin - frameBegin) * msPerTick,
+                /* duration   = */ static_cast<double>(end - begin) * msPerTick,
+                /* statistics = */ {},
+            };
+
+            if (statistics != nullptr && scope.hasStatistics)
+                result.statistics = statistics[i];
+
+            results.push_back(std::move(result));
+        }
+
+        frameTime = (frameEnd > frameBegin) ? static_cast<double>(frameEnd - frameBegin) * msPerTick : 0.0;
+        readbackBuffer.Unmap();
+    }
+
+    if (statistics != nullptr)
+        readbackBuffer.Unmap();
+
+    frame.scopes.clear();
+    frame.resolvedCount = 0;
+    frame.syncPoint     = 0;
+}
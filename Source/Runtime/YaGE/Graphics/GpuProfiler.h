@@ -0,0 +1,250 @@
+#pragma once
+
+#include "../Core/String.h"
+#include "CommandBuffer.h"
+
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace YaGE {
+
+struct GpuProfileResult {
+    /// @brief  Name of the profile scope.
+    String name;
+
+    /// @brief  Time in millisecond when this scope begins, relative to the first scope of the frame.
+    double beginTime;
+
+    /// @brief  Time in millisecond that this scope takes on GPU.
+    double duration;
+
+    /// @brief  Pipeline statistics of this scope. All zero if pipeline statistics are not enabled or this scope is nested in another scope on the same command buffer.
+    D3D12_QUERY_DATA_PIPELINE_STATISTICS statistics;
+};
+
+class GpuProfiler {
+public:
+    /// @brief
+    ///   Create a GPU profiler.
+    /// @remarks
+    ///   Timestamps of each frame are resolved into a readback buffer and read back a few frames later once the frame is finished on GPU, so that profiling never stalls CPU unless CPU runs more than @p FRAME_COUNT frames ahead of GPU.
+    ///
+    /// @param maxScopes                Maximum number of profile scopes in a single frame. Scopes beyond this limit are ignored.
+    /// @param enablePipelineStatistics Whether to collect pipeline statistics for each scope.
+    /// @param queueType                Type of the command queue that profiled command buffers are submitted to. Copy queues are not supported.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to create query heaps or readback buffer.
+    YAGE_API explicit GpuProfiler(uint32_t                maxScopes                = 1024,
+                                  bool                    enablePipelineStatistics = false,
+                                  D3D12_COMMAND_LIST_TYPE queueType                = D3D12_COMMAND_LIST_TYPE_DIRECT);
+
+    /// @brief
+    ///   Copy constructor is disabled.
+    GpuProfiler(const GpuProfiler &) = delete;
+
+    /// @brief
+    ///   Copy assignment is disabled.
+    auto operator=(const GpuProfiler &) = delete;
+
+    /// @brief
+    ///   Destroy this GPU profiler. This method waits for all profiled frames to be finished on GPU.
+    YAGE_API ~GpuProfiler() noexcept;
+
+    /// @brief
+    ///   Begin a named profile scope on the specified command buffer. This method is thread safe.
+    /// @remarks
+    ///   Scopes must be ended before @p EndFrame() is called. Pipeline statistics queries could not be nested in a command list, so pipeline statistics are only collected by the outermost scope on each command buffer.
+    ///
+    /// @param[in] commandBuffer    The command buffer that the scope is recorded on.
+    /// @param     name             Name of the scope.
+    ///
+    /// @return uint32_t
+    ///   Return handle of the scope, which identifies both the scope and the frame it begins in. Return @p UINT32_MAX if there are too many scopes in current frame.
+    YAGE_API auto BeginScope(CommandBuffer &commandBuffer, StringView name) -> uint32_t;
+
+    /// @brief
+    ///   End a profile scope. The scope must be ended on the same command buffer that it begins on, and in the same frame. Scopes that are ended after @p EndFrame() are discarded.
+    ///
+    /// @param[in] commandBuffer    The command buffer that the scope is recorded on.
+    /// @param     scope            Handle of the scope returned by @p BeginScope().
+    YAGE_API auto EndScope(CommandBuffer &commandBuffer, uint32_t scope) noexcept -> void;
+
+    /// @brief
+    ///   Resolve queries of current frame into the readback buffer. This should be recorded on the last command buffer of the frame, after all scopes are ended.
+    ///
+    /// @param[in] commandBuffer    The command buffer to record resolve commands on.
+    YAGE_API auto Resolve(CommandBuffer &commandBuffer) noexcept -> void;
+
+    /// @brief
+    ///   Finish current frame and start a new frame. Results of finished frames are read back without waiting for GPU.
+    ///
+    /// @param syncPoint    The sync point that indicates when the command buffer that @p Resolve() is recorded on is finished on GPU.
+    YAGE_API auto EndFrame(uint64_t syncPoint) -> void;
+
+    /// @brief
+    ///   Get results of the latest frame that has been finished on GPU.
+    ///
+    /// @return const std::vector<GpuProfileResult> &
+    ///   Return results of the latest finished frame, in the order that scopes begin on CPU.
+    YAGE_NODISCARD auto Results() const noexcept -> const std::vector<GpuProfileResult> & { return results; }
+
+    /// @brief
+    ///   Get total time in millisecond of the latest finished frame on GPU, from the first scope begins to the last scope ends.
+    ///
+    /// @return double
+    ///   Return total time in millisecond of the latest finished frame.
+    YAGE_NODISCARD auto FrameTime() const noexcept -> double { return frameTime; }
+
+    /// @brief
+    ///   Checks if pipeline statistics are collected by this profiler.
+    ///
+    /// @return bool
+    /// @retval true    Pipeline statistics are collected.
+    /// @retval false   Pipeline statistics are not collected.
+    YAGE_NODISCARD auto IsPipelineStatisticsEnabled() const noexcept -> bool {
+        return pipelineStatisticsHeap != nullptr;
+    }
+
+    /// @brief
+    ///   Get timestamp frequency of the profiled command queue.
+    ///
+    /// @return uint64_t
+    ///   Return number of timestamp ticks per second.
+    YAGE_NODISCARD auto TimestampFrequency() const noexcept -> uint64_t { return timestampFrequency; }
+
+    /// @brief  Number of frames that could be profiled at the same time.
+    static constexpr const uint32_t FRAME_COUNT = 3;
+
+private:
+    class QueryBuffer : public GpuResource {
+    public:
+        /// @brief
+        ///   Create a buffer in readback heap that query data are resolved into.
+        ///
+        /// @param size Size in byte of the buffer.
+        ///
+        /// @throw RenderAPIException
+        ///   Thrown if failed to create the readback buffer.
+        explicit QueryBuffer(size_t size);
+
+        /// @brief
+        ///   Map the specified range of this buffer for reading.
+        ///
+        /// @param offset   Offset in byte of the range to be read.
+        /// @param size     Size in byte of the range to be read.
+        ///
+        /// @return const void *
+        ///   Return pointer to start of the range. Return nullptr if failed to map the buffer.
+        YAGE_NODISCARD auto Map(size_t offset, size_t size) noexcept -> const void *;
+
+        /// @brief
+        ///   Unmap this buffer. Nothing is written by CPU.
+        auto Unmap() noexcept -> void;
+    };
+
+    struct Scope {
+        /// @brief  Name of the scope.
+        String name;
+
+        /// @brief  Whether the scope has been ended.
+        bool ended;
+
+        /// @brief  Whether queries of the scope have been resolved.
+        bool resolved;
+
+        /// @brief  Whether the scope has a pipeline statistics query. Only outermost scopes of each command buffer have.
+        bool hasStatistics;
+    };
+
+    struct Frame {
+        /// @brief  Profile scopes recorded in this frame.
+        std::vector<Scope> scopes;
+
+        /// @brief  Number of scopes whose queries have been resolved.
+        uint32_t resolvedCount;
+
+        /// @brief  The sync point that indicates when this frame is finished on GPU. 0 if this frame is not submitted.
+        uint64_t syncPoint;
+    };
+
+    /// @brief
+    ///   Read back results of the specified frame and reset it. The frame must be finished on GPU.
+    ///
+    /// @param frameIndex   Index of the frame to be read back.
+    auto ReadBack(uint32_t frameIndex) -> void;
+
+private:
+    /// @brief  The render device that command buffers are submitted to.
+    RenderDevice &renderDevice;
+
+    /// @brief  Maximum number of profile scopes in a single frame.
+    uint32_t maxScopes;
+
+    /// @brief  Timestamp ticks per second of the profiled command queue.
+    uint64_t timestampFrequency;
+
+    /// @brief  Query heap for timestamps. Each scope uses 2 timestamps.
+    Microsoft::WRL::ComPtr<ID3D12QueryHeap> timestampHeap;
+
+    /// @brief  Query heap for pipeline statistics. This is nullptr if pipeline statistics are not enabled.
+    Microsoft::WRL::ComPtr<ID3D12QueryHeap> pipelineStatisticsHeap;
+
+    /// @brief  Readback buffer that query data of all frames are resolved into.
+    QueryBuffer readbackBuffer;
+
+    /// @brief  Profiled frames.
+    Frame frames[FRAME_COUNT];
+
+    /// @brief  Index of current frame.
+    uint32_t currentFrame;
+
+    /// @brief  Command buffers that have an active pipeline statistics query, and handle of the scope that owns the query.
+    std::vector<std::pair<const CommandBuffer *, uint32_t>> statisticsScopes;
+
+    /// @brief  Mutex that protects scopes of current frame and @p statisticsScopes.
+    std::mutex mutex;
+
+    /// @brief  Results of the latest finished frame.
+    std::vector<GpuProfileResult> results;
+
+    /// @brief  Total time in millisecond of the latest finished frame.
+    double frameTime;
+};
+
+class GpuProfileScope {
+public:
+    /// @brief
+    ///   Begin a named profile scope on the specified command buffer. The scope is ended when this object is destroyed.
+    ///
+    /// @param[in] profiler         The GPU profiler that the scope is recorded by.
+    /// @param[in] commandBuffer    The command buffer that the scope is recorded on.
+    /// @param     name             Name of the scope.
+    GpuProfileScope(GpuProfiler &profiler, CommandBuffer &commandBuffer, StringView name)
+        : profiler(profiler), commandBuffer(commandBuffer), scope(profiler.BeginScope(commandBuffer, name)) {}
+
+    /// @brief
+    ///   Copy constructor is disabled.
+    GpuProfileScope(const GpuProfileScope &) = delete;
+
+    /// @brief
+    ///   Copy assignment is disabled.
+    auto operator=(const GpuProfileScope &) = delete;
+
+    /// @brief
+    ///   End the profile scope.
+    ~GpuProfileScope() noexcept { profiler.EndScope(commandBuffer, scope); }
+
+private:
+    /// @brief  The GPU profiler that the scope is recorded by.
+    GpuProfiler &profiler;
+
+    /// @brief  The command buffer that the scope is recorded on.
+    CommandBuffer &commandBuffer;
+
+    /// @brief  Handle of the scope.
+    uint32_t scope;
+};
+
+} // namespace YaGE
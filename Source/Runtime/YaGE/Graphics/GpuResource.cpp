@@ -1,5 +1,104 @@
 #include "GpuResource.h"
+#include "RenderDevice.h"
 
 using namespace YaGE;
 
-YaGE::GpuResource::~GpuResource() noexcept {}
+YaGE::GpuResource::~GpuResource() noexcept { ReleaseResource(); }
+
+auto YaGE::GpuResource::operator=(GpuResource &&other) noexcept -> GpuResource & {
+    ReleaseResource();
+
+    resource          = std::move(other.resource);
+    usageState        = other.usageState;
+    subresourceStates = std::move(other.subresourceStates);
+    allocation        = other.allocation;
+    isEvicted         = other.isEvicted;
+    isUninitialized   = other.isUninitialized;
+
+    other.resource   = nullptr;
+    other.usageState = D3D12_RESOURCE_STATE_COMMON;
+    other.subresourceStates.clear();
+    other.allocation      = GpuMemoryAllocation{};
+    other.isEvicted       = false;
+    other.isUninitialized = false;
+
+    return *this;
+}
+
+YAGE_NODISCARD auto YaGE::GpuResource::CreateResource(D3D12_HEAP_TYPE            heapType,
+                                                      const D3D12_RESOURCE_DESC &desc,
+                                                      D3D12_RESOURCE_STATES      initialState,
+                                                      const D3D12_CLEAR_VALUE   *clearValue) noexcept -> HRESULT {
+    RenderDevice &device = RenderDevice::Singleton();
+    ReleaseResource();
+
+    HRESULT hr = device.CreateResource(heapType, desc, initialState, clearValue, resource.ReleaseAndGetAddressOf(),
+                                       allocation);
+    if (SUCCEEDED(hr)) {
+        usageState = initialState;
+        subresourceStates.clear();
+
+        // Placed render targets and depth stencil buffers must be cleared or discarded before first use.
+        isUninitialized = (allocation.heap != nullptr &&
+                           (desc.Flags & (D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET |
+                                          D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL)) != 0);
+    }
+
+    return hr;
+}
+
+YAGE_NODISCARD auto YaGE::GpuResource::CreatePlacedResource(ID3D12Heap                *heap,
+                                                            uint64_t                   heapOffset,
+                                                            const D3D12_RESOURCE_DESC &desc,
+                                                            D3D12_RESOURCE_STATES      initialState,
+                                                            const D3D12_CLEAR_VALUE   *clearValue) noexcept -> HRESULT {
+    RenderDevice &device = RenderDevice::Singleton();
+    ReleaseResource();
+
+    HRESULT hr = device.Device()->CreatePlacedResource(heap, heapOffset, &desc, initialState, clearValue,
+                                                       IID_PPV_ARGS(resource.ReleaseAndGetAddressOf()));
+    if (SUCCEEDED(hr)) {
+        usageState = initialState;
+        subresourceStates.clear();
+    }
+
+    return hr;
+}
+
+YAGE_NODISCARD auto YaGE::GpuResource::CreateReservedResource(const D3D12_RESOURCE_DESC &desc,
+                                                              D3D12_RESOURCE_STATES      initialState) noexcept
+    -> HRESULT {
+    RenderDevice &device = RenderDevice::Singleton();
+    ReleaseResource();
+
+    HRESULT hr = device.Device()->CreateReservedResource(&desc, initialState, nullptr,
+                                                         IID_PPV_ARGS(resource.ReleaseAndGetAddressOf()));
+    if (SUCCEEDED(hr)) {
+        usageState = initialState;
+        subresourceStates.clear();
+    }
+
+    return hr;
+}
+
+auto YaGE::GpuResource::ReleaseResource() noexcept -> void {
+    if (resource == nullptr && allocation.block == nullptr)
+        return;
+
+    // The resource may still be used by GPU. Release it once all submitted commands are finished.
+    RenderDevice::Singleton().DeferRelease(std::move(resource), allocation);
+    resource        = nullptr;
+    allocation      = GpuMemoryAllocation{};
+    isEvicted       = false;
+    isUninitialized = false;
+}
+
+auto YaGE::GpuResource::Evict() noexcept -> HRESULT {
+    GpuResource *const self = this;
+    return RenderDevice::Singleton().Evict(1, &self);
+}
+
+auto YaGE::GpuResource::MakeResident() noexcept -> HRESULT {
+    GpuResource *const self = this;
+    return RenderDevice::Singleton().MakeResident(1, &self);
+}
@@ -1,11 +1,9 @@
 #pragma once
 
-#include "../Core/Common.h"
-
-#include <d3d12.h>
-#include <wrl/client.h>
+#include "GpuMemoryAllocator.h"
 
 #include <utility>
+#include <vector>
 
 namespace YaGE {
 
@@ -13,7 +11,13 @@ class GpuResource {
 protected:
     /// @brief
     ///   Create an empty GPU resource.
-    GpuResource() noexcept : resource(nullptr), usageState(D3D12_RESOURCE_STATE_COMMON) {}
+    GpuResource() noexcept
+        : resource(nullptr),
+          usageState(D3D12_RESOURCE_STATE_COMMON),
+          subresourceStates(),
+          allocation(),
+          isEvicted(false),
+          isUninitialized(false) {}
 
     /// @brief
     ///   Copy constructor is disabled.
@@ -27,45 +31,173 @@ protected:
     ///   Move constructor. The moved GpuResource will be invalidated.
     ///
     /// @param other    The GpuResource to be moved.
-    GpuResource(GpuResource &&other) noexcept : resource(std::move(other.resource)), usageState(other.usageState) {
+    GpuResource(GpuResource &&other) noexcept
+        : resource(std::move(other.resource)),
+          usageState(other.usageState),
+          subresourceStates(std::move(other.subresourceStates)),
+          allocation(other.allocation),
+          isEvicted(other.isEvicted),
+          isUninitialized(other.isUninitialized) {
         other.resource   = nullptr;
         other.usageState = D3D12_RESOURCE_STATE_COMMON;
+        other.subresourceStates.clear();
+        other.allocation      = GpuMemoryAllocation{};
+        other.isEvicted       = false;
+        other.isUninitialized = false;
     }
 
     /// @brief
     ///   Move assignment. The moved GpuResource will be invalidated.
     ///
     /// @param other    The GpuResource to be moved.
-    auto operator=(GpuResource &&other) noexcept -> GpuResource & {
-        resource   = std::move(other.resource);
-        usageState = other.usageState;
+    YAGE_API auto operator=(GpuResource &&other) noexcept -> GpuResource &;
 
-        other.resource   = nullptr;
-        other.usageState = D3D12_RESOURCE_STATE_COMMON;
+    /// @brief
+    ///   Create D3D12 resource for this GPU resource from GPU memory pools of RenderDevice. Current resource of this object should be released before calling this method.
+    /// @remarks
+    ///   Render targets and depth stencil buffers that are placed in heap blocks are discarded by @p CommandBuffer on their first transition, because placed render targets and depth stencil buffers must be initialized before used.
+    ///
+    /// @param heapType     Type of heap that the resource should be created in.
+    /// @param desc         Description of the resource to be created.
+    /// @param initialState Initial state of the resource.
+    /// @param clearValue   Optimized clear value of the resource. Could be nullptr.
+    ///
+    /// @return HRESULT
+    ///   Return @p S_OK if succeeded to create the resource. Otherwise, return the error code.
+    YAGE_NODISCARD YAGE_API auto CreateResource(D3D12_HEAP_TYPE            heapType,
+                                                const D3D12_RESOURCE_DESC &desc,
+                                                D3D12_RESOURCE_STATES      initialState,
+                                                const D3D12_CLEAR_VALUE   *clearValue) noexcept -> HRESULT;
 
-        return *this;
-    }
+    /// @brief
+    ///   Create D3D12 resource for this GPU resource in the specified heap. Current resource of this object should be released before calling this method.
+    /// @remarks
+    ///   The heap memory is not owned by this GPU resource. Placed resources in the same heap could alias with each other.
+    ///
+    /// @param heap         The heap that the resource should be placed in.
+    /// @param heapOffset   Offset in byte from start of the heap.
+    /// @param desc         Description of the resource to be created.
+    /// @param initialState Initial state of the resource.
+    /// @param clearValue   Optimized clear value of the resource. Could be nullptr.
+    ///
+    /// @return HRESULT
+    ///   Return @p S_OK if succeeded to create the resource. Otherwise, return the error code.
+    YAGE_NODISCARD YAGE_API auto CreatePlacedResource(ID3D12Heap                *heap,
+                                                      uint64_t                   heapOffset,
+                                                      const D3D12_RESOURCE_DESC &desc,
+                                                      D3D12_RESOURCE_STATES      initialState,
+                                                      const D3D12_CLEAR_VALUE   *clearValue) noexcept -> HRESULT;
+
+    /// @brief
+    ///   Create a reserved D3D12 resource for this GPU resource. Current resource of this object should be released before calling this method.
+    /// @remarks
+    ///   No memory is backed by reserved resources. Tiles of the resource should be mapped to heaps with @p ID3D12CommandQueue::UpdateTileMappings() before used.
+    ///
+    /// @param desc         Description of the resource to be created. Layout of textures must be @p D3D12_TEXTURE_LAYOUT_64KB_UNDEFINED_SWIZZLE.
+    /// @param initialState Initial state of the resource.
+    ///
+    /// @return HRESULT
+    ///   Return @p S_OK if succeeded to create the resource. Otherwise, return the error code.
+    YAGE_NODISCARD YAGE_API auto CreateReservedResource(const D3D12_RESOURCE_DESC &desc,
+                                                        D3D12_RESOURCE_STATES      initialState) noexcept -> HRESULT;
+
+    /// @brief
+    ///   Release D3D12 resource and GPU memory of this GPU resource. The resource is released by @p RenderDevice::DeferRelease() once GPU has finished all submitted commands, so that resources in flight could be destroyed without synchronization.
+    YAGE_API auto ReleaseResource() noexcept -> void;
 
 public:
     /// @brief
-    ///   Destroy this GPU resource.
+    ///   Destroy this GPU resource. This GPU resource could be destroyed while it is still used by submitted commands. It must not be referenced by command buffers that have not been submitted yet.
     YAGE_API virtual ~GpuResource() noexcept;
 
     /// @brief
     ///   Get current state of this GPU resource.
+    /// @remarks
+    ///   If subresources of this GPU resource are in different states, state of the first subresource is returned. Use @p SubresourceState() to get state of a specific subresource.
     ///
     /// @return D3D12_RESOURCE_STATUS
     ///   Return current state of this GPU resource.
-    YAGE_NODISCARD auto State() const noexcept -> D3D12_RESOURCE_STATES { return usageState; }
+    YAGE_NODISCARD auto State() const noexcept -> D3D12_RESOURCE_STATES {
+        return subresourceStates.empty() ? usageState : subresourceStates.front();
+    }
+
+    /// @brief
+    ///   Get current state of the specified subresource.
+    ///
+    /// @param subresource  Index of the subresource.
+    ///
+    /// @return D3D12_RESOURCE_STATES
+    ///   Return current state of the specified subresource.
+    YAGE_NODISCARD auto SubresourceState(uint32_t subresource) const noexcept -> D3D12_RESOURCE_STATES {
+        return subresource < subresourceStates.size() ? subresourceStates[subresource] : usageState;
+    }
+
+    /// @brief
+    ///   Checks if all subresources of this GPU resource are in the same state.
+    ///
+    /// @return
+    /// @retval true  All subresources are in the same state.
+    /// @retval false Subresources are in different states.
+    YAGE_NODISCARD auto IsStateUniform() const noexcept -> bool { return subresourceStates.empty(); }
+
+    /// @brief
+    ///   Checks if this GPU resource could be evicted individually. Only committed resources own their memory. Resources that are placed in shared heaps could not be evicted without evicting other resources in the same heap.
+    ///
+    /// @return bool
+    /// @retval true    This GPU resource could be evicted.
+    /// @retval false   This GPU resource is empty or placed in a heap.
+    YAGE_NODISCARD auto IsEvictable() const noexcept -> bool {
+        return resource != nullptr && allocation.heap == nullptr && allocation.size != 0;
+    }
+
+    /// @brief
+    ///   Checks if this GPU resource has been evicted by @p Evict().
+    ///
+    /// @return bool
+    /// @retval true    This GPU resource has been evicted and must be made resident before used by GPU.
+    /// @retval false   This GPU resource is resident.
+    YAGE_NODISCARD auto IsEvicted() const noexcept -> bool { return isEvicted; }
+
+    /// @brief
+    ///   Evict this GPU resource from GPU memory. Prefer @p RenderDevice::Evict() to evict multiple resources at once.
+    /// @note
+    ///   This GPU resource must not be used by GPU when evicted. Nothing happens if this resource is not evictable.
+    ///
+    /// @return HRESULT
+    ///   Return @p S_OK if succeeded. Otherwise, return the error code.
+    YAGE_API auto Evict() noexcept -> HRESULT;
+
+    /// @brief
+    ///   Make this GPU resource resident again if it is evicted. This method blocks until the resource is resident. Prefer @p RenderDevice::MakeResident() to make multiple resources resident at once.
+    ///
+    /// @return HRESULT
+    ///   Return @p S_OK if succeeded. Return @p E_OUTOFMEMORY if there is no enough memory to make this resource resident.
+    YAGE_API auto MakeResident() noexcept -> HRESULT;
 
     friend class CommandBuffer;
+    friend class RenderGraph;
+    friend class DirectStorageLoader;
+    friend class ReadbackBuffer;
+    friend class RenderDevice;
 
 protected:
     /// @brief  D3D12 resource handle.
     Microsoft::WRL::ComPtr<ID3D12Resource> resource;
 
-    /// @brief  D3D12 resource state.
+    /// @brief  D3D12 resource state. Only valid if all subresources are in the same state.
     D3D12_RESOURCE_STATES usageState;
+
+    /// @brief  Per-subresource states. Empty if all subresources are in the same state.
+    std::vector<D3D12_RESOURCE_STATES> subresourceStates;
+
+    /// @brief  GPU memory allocation of this resource.
+    GpuMemoryAllocation allocation;
+
+    /// @brief  Whether this resource has been evicted from GPU memory.
+    bool isEvicted;
+
+    /// @brief  Whether this is a placed render target or depth stencil buffer that has not been initialized yet.
+    bool isUninitialized;
 };
 
 } // namespace YaGE
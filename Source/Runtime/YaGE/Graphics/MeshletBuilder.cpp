@@ -0,0 +1,277 @@
+#include "MeshletBuilder.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+using namespace YaGE;
+
+namespace {
+
+/// @brief  Local index of vertices that are not referenced by current meshlet.
+constexpr const uint32_t INVALID_LOCAL_INDEX = UINT32_MAX;
+
+/// @brief
+///   Load position of the specified vertex from a strided vertex buffer.
+///
+/// @param positions        Pointer to position of the first vertex.
+/// @param positionStride   Stride in byte between positions of two adjacent vertices.
+/// @param vertex           Index of the vertex.
+///
+/// @return Vector3
+///   Return position of the specified vertex.
+YAGE_NODISCARD auto LoadPosition(const Vector3 *positions, size_t positionStride, uint32_t vertex) noexcept
+    -> Vector3 {
+    // Vertex buffers are not guaranteed to be aligned for Vector3.
+    Vector3 position;
+    memcpy(&position, reinterpret_cast<const uint8_t *>(positions) + vertex * positionStride, sizeof(Vector3));
+    return position;
+}
+
+/// @brief
+///   Count vertices of a triangle that are not referenced by current meshlet.
+///
+/// @param localIndices     Meshlet-local index of each vertex.
+/// @param triangle         Vertex indices of the triangle.
+///
+/// @return uint32_t
+///   Return number of vertices that should be added to current meshlet if the triangle is added.
+YAGE_NODISCARD auto NewVertexCount(const uint32_t *localIndices, const uint32_t *triangle) noexcept -> uint32_t {
+    return static_cast<uint32_t>(localIndices[triangle[0]] == INVALID_LOCAL_INDEX) +
+           static_cast<uint32_t>(localIndices[triangle[1]] == INVALID_LOCAL_INDEX) +
+           static_cast<uint32_t>(localIndices[triangle[2]] == INVALID_LOCAL_INDEX);
+}
+
+} // namespace
+
+YaGE::MeshletBuilder::MeshletBuilder(uint32_t maxVertices, uint32_t maxPrimitives) noexcept
+    : maxVertices(maxVertices < 3 ? 3 : (maxVertices > MAX_VERTEX_LIMIT ? MAX_VERTEX_LIMIT : maxVertices)),
+      maxPrimitives(maxPrimitives < 1 ? 1
+                                      : (maxPrimitives > MAX_PRIMITIVE_LIMIT ? MAX_PRIMITIVE_LIMIT : maxPrimitives)),
+      meshlets(),
+      bounds(),
+      vertexIndices(),
+      primitiveIndices() {}
+
+YaGE::MeshletBuilder::~MeshletBuilder() noexcept {}
+
+auto YaGE::MeshletBuilder::Build(const uint32_t *indices,
+                                 size_t          indexCount,
+                                 const Vector3  *positions,
+                                 size_t          vertexCount,
+                                 size_t          positionStride) -> void {
+    meshlets.clear();
+    bounds.clear();
+    vertexIndices.clear();
+    primitiveIndices.clear();
+
+    const size_t triangleCount = indexCount / 3;
+
+    // Invalid triangles are treated as emitted so that they are never added to any meshlet.
+    std::vector<uint8_t>  emitted(triangleCount);
+    std::vector<uint32_t> adjacencyOffsets(vertexCount + 1);
+
+    for (size_t i = 0; i < triangleCount; ++i) {
+        const uint32_t *triangle = indices + i * 3;
+        if (triangle[0] >= vertexCount || triangle[1] >= vertexCount || triangle[2] >= vertexCount ||
+            triangle[0] == triangle[1] || triangle[1] == triangle[2] || triangle[0] == triangle[2]) {
+            emitted[i] = 1;
+            continue;
+        }
+
+        adjacencyOffsets[triangle[0] + 1] += 1;
+        adjacencyOffsets[triangle[1] + 1] += 1;
+        adjacencyOffsets[triangle[2] + 1] += 1;
+    }
+
+    for (size_t i = 0; i < vertexCount; ++i)
+        adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+
+    // Triangles that reference each vertex.
+    std::vector<uint32_t> adjacency(adjacencyOffsets[vertexCount]);
+    {
+        std::vector<uint32_t> cursors(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (size_t i = 0; i < triangleCount; ++i) {
+            if (emitted[i])
+                continue;
+
+            const uint32_t *triangle = indices + i * 3;
+            for (uint32_t j = 0; j < 3; ++j)
+                adjacency[cursors[triangle[j]]++] = static_cast<uint32_t>(i);
+        }
+    }
+
+    std::vector<uint32_t> localIndices(vertexCount, INVALID_LOCAL_INDEX);
+
+    Meshlet current{0, 0, 0, 0};
+    size_t  cursor = 0;
+    Vector3 positionSum;
+
+    for (;;) {
+        size_t   best         = SIZE_MAX;
+        uint32_t bestNewCount = 4;
+        float    bestDistance = FLT_MAX;
+
+        const Vector3 centroid =
+            (current.vertexCount == 0) ? Vector3() : positionSum / static_cast<float>(current.vertexCount);
+
+        // Prefer adjacent triangles that introduce the fewest new vertices.
+        for (uint32_t i = 0; i < current.vertexCount && bestNewCount != 0; ++i) {
+            const uint32_t vertex = vertexIndices[current.vertexOffset + i];
+            for (uint32_t j = adjacencyOffsets[vertex]; j < adjacencyOffsets[vertex + 1]; ++j) {
+                const uint32_t triangle = adjacency[j];
+                if (emitted[triangle])
+                    continue;
+
+                const uint32_t *triangleIndices = indices + triangle * size_t(3);
+                const uint32_t  newCount        = NewVertexCount(localIndices.data(), triangleIndices);
+
+                if (newCount > bestNewCount)
+                    continue;
+
+                // Prefer triangles that are closer to center of current meshlet to keep it compact.
+                const Vector3 offset = LoadPosition(positions, positionStride, triangleIndices[0]) +
+                                       LoadPosition(positions, positionStride, triangleIndices[1]) +
+                                       LoadPosition(positions, positionStride, triangleIndices[2]) - centroid * 3.0f;
+                const float   distance = Dot(offset, offset);
+
+                if (newCount < bestNewCount || distance < bestDistance) {
+                    best         = triangle;
+                    bestNewCount = newCount;
+                    bestDistance = distance;
+                }
+            }
+        }
+
+        // Continue with the next triangle in index buffer order if there is no adjacent triangle.
+        if (best == SIZE_MAX) {
+            while (cursor < triangleCount && emitted[cursor])
+                ++cursor;
+
+            if (cursor == triangleCount)
+                break;
+
+            const uint32_t *triangleIndices = indices + cursor * 3;
+
+            best         = cursor;
+            bestNewCount = NewVertexCount(localIndices.data(), triangleIndices);
+        }
+
+        // Start a new meshlet if the triangle does not fit into current meshlet.
+        if (current.vertexCount + bestNewCount > maxVertices || current.primitiveCount == maxPrimitives) {
+            FinishMeshlet(current, positions, positionStride);
+
+            for (uint32_t i = 0; i < current.vertexCount; ++i)
+                localIndices[vertexIndices[current.vertexOffset + i]] = INVALID_LOCAL_INDEX;
+
+            current.vertexOffset    = static_cast<uint32_t>(vertexIndices.size());
+            current.vertexCount     = 0;
+            current.primitiveOffset = static_cast<uint32_t>(primitiveIndices.size());
+            current.primitiveCount  = 0;
+            positionSum             = Vector3();
+            continue;
+        }
+
+        const uint32_t *triangleIndices = indices + best * 3;
+
+        uint32_t packed = 0;
+        for (uint32_t i = 0; i < 3; ++i) {
+            uint32_t &local = localIndices[triangleIndices[i]];
+            if (local == INVALID_LOCAL_INDEX) {
+                local = current.vertexCount++;
+                vertexIndices.push_back(triangleIndices[i]);
+                positionSum += LoadPosition(positions, positionStride, triangleIndices[i]);
+            }
+
+            packed |= (local << (i * 10));
+        }
+
+        primitiveIndices.push_back(packed);
+        current.primitiveCount += 1;
+        emitted[best] = 1;
+    }
+
+    if (current.primitiveCount != 0)
+        FinishMeshlet(current, positions, positionStride);
+}
+
+auto YaGE::MeshletBuilder::Build(const uint16_t *indices,
+                                 size_t          indexCount,
+                                 const Vector3  *positions,
+                                 size_t          vertexCount,
+                                 size_t          positionStride) -> void {
+    const std::vector<uint32_t> indices32(indices, indices + indexCount);
+    Build(indices32.data(), indexCount, positions, vertexCount, positionStride);
+}
+
+auto YaGE::MeshletBuilder::FinishMeshlet(const Meshlet &meshlet, const Vector3 *positions, size_t positionStride)
+    -> void {
+    MeshletBounds result;
+
+    { // Bounding sphere is centered at the bounding box.
+        Vector3 minPosition(LoadPosition(positions, positionStride, vertexIndices[meshlet.vertexOffset]));
+        Vector3 maxPosition(minPosition);
+
+        for (uint32_t i = 1; i < meshlet.vertexCount; ++i) {
+            const Vector3 p = LoadPosition(positions, positionStride, vertexIndices[meshlet.vertexOffset + i]);
+            minPosition     = Vector3(std::min(minPosition.x, p.x), std::min(minPosition.y, p.y),
+                                      std::min(minPosition.z, p.z));
+            maxPosition     = Vector3(std::max(maxPosition.x, p.x), std::max(maxPosition.y, p.y),
+                                      std::max(maxPosition.z, p.z));
+        }
+
+        result.center = (minPosition + maxPosition) * 0.5f;
+        result.radius = 0.0f;
+
+        for (uint32_t i = 0; i < meshlet.vertexCount; ++i) {
+            const Vector3 p = LoadPosition(positions, positionStride, vertexIndices[meshlet.vertexOffset + i]);
+            result.radius   = std::max(result.radius, (p - result.center).Length());
+        }
+    }
+
+    { // Normal cone.
+        Vector3  normals[MAX_PRIMITIVE_LIMIT];
+        uint32_t normalCount = 0;
+        Vector3  axis;
+
+        for (uint32_t i = 0; i < meshlet.primitiveCount; ++i) {
+            const uint32_t  packed = primitiveIndices[meshlet.primitiveOffset + i];
+            const uint32_t *local  = vertexIndices.data() + meshlet.vertexOffset;
+
+            const Vector3 p0 = LoadPosition(positions, positionStride, local[packed & 0x3FF]);
+            const Vector3 p1 = LoadPosition(positions, positionStride, local[(packed >> 10) & 0x3FF]);
+            const Vector3 p2 = LoadPosition(positions, positionStride, local[(packed >> 20) & 0x3FF]);
+
+            const Vector3 normal = Cross(p1 - p0, p2 - p0);
+            const float   length = normal.Length();
+
+            // Zero-area triangles do not contribute to the normal cone.
+            if (length <= 0.0f)
+                continue;
+
+            normals[normalCount] = normal / length;
+            axis += normals[normalCount];
+            normalCount += 1;
+        }
+
+        const float axisLength = axis.Length();
+        if (normalCount == 0 || axisLength <= 1e-6f) {
+            result.coneAxis   = Vector3();
+            result.coneCutoff = 1.0f;
+        } else {
+            axis /= axisLength;
+
+            float minDot = 1.0f;
+            for (uint32_t i = 0; i < normalCount; ++i)
+                minDot = std::min(minDot, Dot(axis, normals[i]));
+
+            // The cone spreads over a hemisphere. This meshlet could never be back-face culled.
+            result.coneAxis   = axis;
+            result.coneCutoff = (minDot <= 0.0f) ? 1.0f : std::sqrt(1.0f - minDot * minDot);
+        }
+    }
+
+    meshlets.push_back(meshlet);
+    bounds.push_back(result);
+}
@@ -0,0 +1,170 @@
+#pragma once
+
+#include "../Math/Vector3.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace YaGE {
+
+/// @brief
+///   A meshlet is a small cluster of triangles that is processed by a single mesh shader thread group. Layout of this structure is compatible with HLSL structured buffers.
+struct Meshlet {
+    /// @brief  Offset of the first vertex index of this meshlet in the vertex index buffer.
+    uint32_t vertexOffset;
+
+    /// @brief  Number of unique vertices referenced by this meshlet.
+    uint32_t vertexCount;
+
+    /// @brief  Offset of the first primitive of this meshlet in the primitive index buffer.
+    uint32_t primitiveOffset;
+
+    /// @brief  Number of triangles in this meshlet.
+    uint32_t primitiveCount;
+};
+
+static_assert(sizeof(Meshlet) == 16, "Size of Meshlet must be 16 bytes.");
+
+/// @brief
+///   Culling data of a meshlet. Layout of this structure is compatible with HLSL structured buffers.
+/// @remarks
+///   A meshlet is entirely back-facing and could be culled if @p dot(center - cameraPosition, coneAxis) >= coneCutoff * length(center - cameraPosition) + radius.
+struct MeshletBounds {
+    /// @brief  Center of the bounding sphere of this meshlet in object space.
+    Vector3 center;
+
+    /// @brief  Radius of the bounding sphere of this meshlet.
+    float radius;
+
+    /// @brief  Average normal direction of triangles in this meshlet. This is a zero vector if the normal cone is degenerated.
+    Vector3 coneAxis;
+
+    /// @brief  Sine of the spread angle of the normal cone. This is 1 if this meshlet could never be back-face culled.
+    float coneCutoff;
+};
+
+static_assert(sizeof(MeshletBounds) == 32, "Size of MeshletBounds must be 32 bytes.");
+
+class MeshletBuilder {
+public:
+    /// @brief  Maximum number of vertices of a meshlet that is supported by D3D12 mesh shaders.
+    static constexpr const uint32_t MAX_VERTEX_LIMIT = 256;
+
+    /// @brief  Maximum number of primitives of a meshlet that is supported by D3D12 mesh shaders.
+    static constexpr const uint32_t MAX_PRIMITIVE_LIMIT = 256;
+
+    /// @brief
+    ///   Create a meshlet builder with the specified meshlet size limits.
+    /// @remarks
+    ///   64 vertices and 124 primitives are recommended by most GPU vendors. Limits are clamped to range supported by D3D12 mesh shaders.
+    ///
+    /// @param maxVertices      Maximum number of unique vertices of each meshlet.
+    /// @param maxPrimitives    Maximum number of triangles of each meshlet.
+    YAGE_API explicit MeshletBuilder(uint32_t maxVertices = 64, uint32_t maxPrimitives = 124) noexcept;
+
+    /// @brief
+    ///   Destroy this meshlet builder.
+    YAGE_API ~MeshletBuilder() noexcept;
+
+    /// @brief
+    ///   Split a triangle list into meshlets. Results of the previous build are discarded.
+    /// @remarks
+    ///   Triangles are grown greedily from a seed triangle by adding adjacent triangles that introduce the fewest new vertices and are closest to center of the meshlet, so that each meshlet is spatially compact and has a tight normal cone. Degenerated triangles and triangles that reference out-of-range vertices are skipped. Index buffers optimized for post-transform vertex cache produce fewer meshlets.
+    ///
+    /// @param indices          Triangle list index buffer.
+    /// @param indexCount       Number of indices. Trailing indices that do not form a triangle are ignored.
+    /// @param positions        Pointer to position of the first vertex.
+    /// @param vertexCount      Number of vertices in the vertex buffer.
+    /// @param positionStride   Stride in byte between positions of two adjacent vertices.
+    YAGE_API auto Build(const uint32_t *indices,
+                        size_t          indexCount,
+                        const Vector3  *positions,
+                        size_t          vertexCount,
+                        size_t          positionStride = sizeof(Vector3)) -> void;
+
+    /// @brief
+    ///   Split a triangle list with 16-bit indices into meshlets. Results of the previous build are discarded.
+    ///
+    /// @param indices          Triangle list index buffer.
+    /// @param indexCount       Number of indices. Trailing indices that do not form a triangle are ignored.
+    /// @param positions        Pointer to position of the first vertex.
+    /// @param vertexCount      Number of vertices in the vertex buffer.
+    /// @param positionStride   Stride in byte between positions of two adjacent vertices.
+    YAGE_API auto Build(const uint16_t *indices,
+                        size_t          indexCount,
+                        const Vector3  *positions,
+                        size_t          vertexCount,
+                        size_t          positionStride = sizeof(Vector3)) -> void;
+
+    /// @brief
+    ///   Get maximum number of unique vertices of each meshlet.
+    ///
+    /// @return uint32_t
+    ///   Return maximum number of unique vertices of each meshlet.
+    YAGE_NODISCARD auto MaxVertices() const noexcept -> uint32_t { return maxVertices; }
+
+    /// @brief
+    ///   Get maximum number of triangles of each meshlet.
+    ///
+    /// @return uint32_t
+    ///   Return maximum number of triangles of each meshlet.
+    YAGE_NODISCARD auto MaxPrimitives() const noexcept -> uint32_t { return maxPrimitives; }
+
+    /// @brief
+    ///   Get meshlets that are generated by the last build.
+    ///
+    /// @return const std::vector<Meshlet> &
+    ///   Return reference to the generated meshlets.
+    YAGE_NODISCARD auto Meshlets() const noexcept -> const std::vector<Meshlet> & { return meshlets; }
+
+    /// @brief
+    ///   Get culling data of each meshlet that is generated by the last build.
+    ///
+    /// @return const std::vector<MeshletBounds> &
+    ///   Return reference to culling data of each meshlet.
+    YAGE_NODISCARD auto Bounds() const noexcept -> const std::vector<MeshletBounds> & { return bounds; }
+
+    /// @brief
+    ///   Get vertex index buffer. Each element is an index into the original vertex buffer.
+    ///
+    /// @return const std::vector<uint32_t> &
+    ///   Return reference to the vertex index buffer.
+    YAGE_NODISCARD auto VertexIndices() const noexcept -> const std::vector<uint32_t> & { return vertexIndices; }
+
+    /// @brief
+    ///   Get primitive index buffer. Each element is a triangle that packs 3 meshlet-local vertex indices into bits 0-9, 10-19 and 20-29.
+    ///
+    /// @return const std::vector<uint32_t> &
+    ///   Return reference to the primitive index buffer.
+    YAGE_NODISCARD auto PrimitiveIndices() const noexcept -> const std::vector<uint32_t> & { return primitiveIndices; }
+
+private:
+    /// @brief
+    ///   Append a meshlet to the result and calculate its culling data.
+    ///
+    /// @param meshlet          The meshlet to be appended. Its vertices and primitives must have been appended.
+    /// @param positions        Pointer to position of the first vertex.
+    /// @param positionStride   Stride in byte between positions of two adjacent vertices.
+    auto FinishMeshlet(const Meshlet &meshlet, const Vector3 *positions, size_t positionStride) -> void;
+
+private:
+    /// @brief  Maximum number of unique vertices of each meshlet.
+    uint32_t maxVertices;
+
+    /// @brief  Maximum number of triangles of each meshlet.
+    uint32_t maxPrimitives;
+
+    /// @brief  Generated meshlets.
+    std::vector<Meshlet> meshlets;
+
+    /// @brief  Culling data of each meshlet.
+    std::vector<MeshletBounds> bounds;
+
+    /// @brief  Vertex index buffer of all meshlets.
+    std::vector<uint32_t> vertexIndices;
+
+    /// @brief  Packed primitive index buffer of all meshlets.
+    std::vector<uint32_t> primitiveIndices;
+};
+
+} // namespace YaGE
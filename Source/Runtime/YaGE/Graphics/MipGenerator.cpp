@@ -0,0 +1,277 @@
+#include "MipGenerator.h"
+#include "../Core/Exception.h"
+#include "RenderDevice.h"
+
+#include <d3dcompiler.h>
+
+using namespace YaGE;
+using Microsoft::WRL::ComPtr;
+
+namespace {
+
+/// @brief
+///   HLSL source of the mipmap generation compute shader. Each thread group downsamples an 8x8 tile of the first destination mip level and reduces it in group shared memory to generate up to 3 more mip levels.
+///   SrcDimension specifies whether width (bit 0) or height (bit 1) of the source mip level is odd. More samples are taken in this case so that no source texel is skipped.
+constexpr const char MIP_GENERATOR_SHADER[] = R"(
+cbuffer MipConstants : register(b0) {
+    uint   SrcMipLevel;
+    uint   NumMipLevels;
+    uint   SrcDimension;
+    uint   IsSRGB;
+    float2 TexelSize;
+};
+
+Texture2DArray<float4>   SrcMip  : register(t0);
+RWTexture2DArray<float4> OutMip1 : register(u0);
+RWTexture2DArray<float4> OutMip2 : register(u1);
+RWTexture2DArray<float4> OutMip3 : register(u2);
+RWTexture2DArray<float4> OutMip4 : register(u3);
+SamplerState             LinearClampSampler : register(s0);
+
+groupshared float gsR[64];
+groupshared float gsG[64];
+groupshared float gsB[64];
+groupshared float gsA[64];
+
+void StoreColor(uint index, float4 color) {
+    gsR[index] = color.r;
+    gsG[index] = color.g;
+    gsB[index] = color.b;
+    gsA[index] = color.a;
+}
+
+float4 LoadColor(uint index) {
+    return float4(gsR[index], gsG[index], gsB[index], gsA[index]);
+}
+
+float3 LinearToSRGB(float3 x) {
+    return x < 0.0031308 ? 12.92 * x : 1.055 * pow(abs(x), 1.0 / 2.4) - 0.055;
+}
+
+float4 PackColor(float4 color) {
+    return IsSRGB ? float4(LinearToSRGB(color.rgb), color.a) : color;
+}
+
+float4 SampleSource(float2 uv, float slice) {
+    return SrcMip.SampleLevel(LinearClampSampler, float3(uv, slice), SrcMipLevel);
+}
+
+[numthreads(8, 8, 1)]
+void main(uint GI : SV_GroupIndex, uint3 DTid : SV_DispatchThreadID) {
+    const float slice = DTid.z;
+
+    float4 src1;
+    if (SrcDimension == 0) {
+        // Both width and height are even. A single bilinear sample covers 2x2 source texels.
+        float2 uv = TexelSize * (DTid.xy + 0.5);
+        src1 = SampleSource(uv, slice);
+    } else if (SrcDimension == 1) {
+        // Width is odd. Take 2 samples horizontally.
+        float2 uv  = TexelSize * (DTid.xy + float2(0.25, 0.5));
+        float2 off = TexelSize * float2(0.5, 0.0);
+        src1 = 0.5 * (SampleSource(uv, slice) + SampleSource(uv + off, slice));
+    } else if (SrcDimension == 2) {
+        // Height is odd. Take 2 samples vertically.
+        float2 uv  = TexelSize * (DTid.xy + float2(0.5, 0.25));
+        float2 off = TexelSize * float2(0.0, 0.5);
+        src1 = 0.5 * (SampleSource(uv, slice) + SampleSource(uv + off, slice));
+    } else {
+        // Both width and height are odd. Take 4 samples.
+        float2 uv  = TexelSize * (DTid.xy + 0.25);
+        float2 off = TexelSize * 0.5;
+        src1 = SampleSource(uv, slice);
+        src1 += SampleSource(uv + float2(off.x, 0.0), slice);
+        src1 += SampleSource(uv + float2(0.0, off.y), slice);
+        src1 += SampleSource(uv + off, slice);
+        src1 *= 0.25;
+    }
+
+    OutMip1[DTid] = PackColor(src1);
+    if (NumMipLevels == 1)
+        return;
+
+    StoreColor(GI, src1);
+    GroupMemoryBarrierWithGroupSync();
+
+    // Threads whose X and Y are both even.
+    if ((GI & 0x9) == 0) {
+        float4 src2 = LoadColor(GI + 0x01);
+        float4 src3 = LoadColor(GI + 0x08);
+        float4 src4 = LoadColor(GI + 0x09);
+        src1 = 0.25 * (src1 + src2 + src3 + src4);
+
+        OutMip2[uint3(DTid.xy / 2, DTid.z)] = PackColor(src1);
+        StoreColor(GI, src1);
+    }
+
+    if (NumMipLevels == 2)
+        return;
+
+    GroupMemoryBarrierWithGroupSync();
+
+    // Threads whose X and Y are both multiples of 4.
+    if ((GI & 0x1B) == 0) {
+        float4 src2 = LoadColor(GI + 0x02);
+        float4 src3 = LoadColor(GI + 0x10);
+        float4 src4 = LoadColor(GI + 0x12);
+        src1 = 0.25 * (src1 + src2 + src3 + src4);
+
+        OutMip3[uint3(DTid.xy / 4, DTid.z)] = PackColor(src1);
+        StoreColor(GI, src1);
+    }
+
+    if (NumMipLevels == 3)
+        return;
+
+    GroupMemoryBarrierWithGroupSync();
+
+    // Only the first thread of each group.
+    if (GI == 0) {
+        float4 src2 = LoadColor(GI + 0x04);
+        float4 src3 = LoadColor(GI + 0x20);
+        float4 src4 = LoadColor(GI + 0x24);
+        src1 = 0.25 * (src1 + src2 + src3 + src4);
+
+        OutMip4[uint3(DTid.xy / 8, DTid.z)] = PackColor(src1);
+    }
+}
+)";
+
+/// @brief
+///   Create root signature description of the mipmap generation compute shader.
+///
+/// @return D3D12_ROOT_SIGNATURE_DESC
+///   Return the root signature description. Parameters and static samplers are stored in static storage.
+YAGE_NODISCARD auto MipGeneratorRootSignatureDesc() noexcept -> D3D12_ROOT_SIGNATURE_DESC {
+    static const D3D12_DESCRIPTOR_RANGE ranges[2]{
+        {
+            /* RangeType                         = */ D3D12_DESCRIPTOR_RANGE_TYPE_SRV,
+            /* NumDescriptors                    = */ 1,
+            /* BaseShaderRegister                = */ 0,
+            /* RegisterSpace                     = */ 0,
+            /* OffsetInDescriptorsFromTableStart = */ 0,
+        },
+        {
+            /* RangeType                         = */ D3D12_DESCRIPTOR_RANGE_TYPE_UAV,
+            /* NumDescriptors                    = */ MipGenerator::MAX_MIPS_PER_DISPATCH,
+            /* BaseShaderRegister                = */ 0,
+            /* RegisterSpace                     = */ 0,
+            /* OffsetInDescriptorsFromTableStart = */ 0,
+        },
+    };
+
+    static D3D12_ROOT_PARAMETER parameters[3];
+    parameters[0].ParameterType            = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
+    parameters[0].Constants.ShaderRegister = 0;
+    parameters[0].Constants.RegisterSpace  = 0;
+    parameters[0].Constants.Num32BitValues = 6;
+    parameters[0].ShaderVisibility         = D3D12_SHADER_VISIBILITY_ALL;
+
+    parameters[1].ParameterType                       = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
+    parameters[1].DescriptorTable.NumDescriptorRanges = 1;
+    parameters[1].DescriptorTable.pDescriptorRanges   = &ranges[0];
+    parameters[1].ShaderVisibility                    = D3D12_SHADER_VISIBILITY_ALL;
+
+    parameters[2].ParameterType                       = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
+    parameters[2].DescriptorTable.NumDescriptorRanges = 1;
+    parameters[2].DescriptorTable.pDescriptorRanges   = &ranges[1];
+    parameters[2].ShaderVisibility                    = D3D12_SHADER_VISIBILITY_ALL;
+
+    static const D3D12_STATIC_SAMPLER_DESC sampler{
+        /* Filter           = */ D3D12_FILTER_MIN_MAG_MIP_LINEAR,
+        /* AddressU         = */ D3D12_TEXTURE_ADDRESS_MODE_CLAMP,
+        /* AddressV         = */ D3D12_TEXTURE_ADDRESS_MODE_CLAMP,
+        /* AddressW         = */ D3D12_TEXTURE_ADDRESS_MODE_CLAMP,
+        /* MipLODBias       = */ 0.0f,
+        /* MaxAnisotropy    = */ 1,
+        /* ComparisonFunc   = */ D3D12_COMPARISON_FUNC_NEVER,
+        /* BorderColor      = */ D3D12_STATIC_BORDER_COLOR_TRANSPARENT_BLACK,
+        /* MinLOD           = */ 0.0f,
+        /* MaxLOD           = */ D3D12_FLOAT32_MAX,
+        /* ShaderRegister   = */ 0,
+        /* RegisterSpace    = */ 0,
+        /* ShaderVisibility = */ D3D12_SHADER_VISIBILITY_ALL,
+    };
+
+    return D3D12_ROOT_SIGNATURE_DESC{
+        /* NumParameters     = */ 3,
+        /* pParameters       = */ parameters,
+        /* NumStaticSamplers = */ 1,
+        /* pStaticSamplers   = */ &sampler,
+        /* Flags             = */ D3D12_ROOT_SIGNATURE_FLAG_NONE,
+    };
+}
+
+} // namespace
+
+YaGE::MipGenerator::MipGenerator() : rootSignature(MipGeneratorRootSignatureDesc()), pipelineState() {
+    // Compile the compute shader.
+    ComPtr<ID3DBlob> shader;
+    ComPtr<ID3DBlob> error;
+
+    HRESULT hr = D3DCompile(MIP_GENERATOR_SHADER, sizeof(MIP_GENERATOR_SHADER) - 1, "MipGenerator", nullptr, nullptr,
+                            "main", "cs_5_1", D3DCOMPILE_OPTIMIZATION_LEVEL3, 0, shader.GetAddressOf(),
+                            error.GetAddressOf());
+    if (FAILED(hr))
+        throw RenderAPIException(hr, u"Failed to compile mipmap generation compute shader.");
+
+    // Create compute pipeline state.
+    const D3D12_COMPUTE_PIPELINE_STATE_DESC desc{
+        /* pRootSignature = */ rootSignature.D3D12RootSignature(),
+        /* CS             = */
+        {
+            /* pShaderBytecode = */ shader->GetBufferPointer(),
+            /* BytecodeLength  = */ shader->GetBufferSize(),
+        },
+        /* NodeMask  = */ 0,
+        /* CachedPSO = */ {},
+        /* Flags     = */ D3D12_PIPELINE_STATE_FLAG_NONE,
+    };
+
+    ID3D12Device1 *device = RenderDevice::Singleton().Device();
+    hr                    = device->CreateComputePipelineState(&desc, IID_PPV_ARGS(pipelineState.GetAddressOf()));
+    if (FAILED(hr))
+        throw RenderAPIException(hr, u"Failed to create mipmap generation compute pipeline state.");
+}
+
+YaGE::MipGenerator::~MipGenerator() noexcept {}
+
+auto YaGE::MipGenerator::UnorderedAccessFormat(DXGI_FORMAT format) noexcept -> DXGI_FORMAT {
+    switch (format) {
+    case DXGI_FORMAT_R8G8B8A8_TYPELESS:
+    case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+        return DXGI_FORMAT_R8G8B8A8_UNORM;
+
+    case DXGI_FORMAT_B8G8R8A8_TYPELESS:
+    case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+        return DXGI_FORMAT_B8G8R8A8_UNORM;
+
+    case DXGI_FORMAT_B8G8R8X8_TYPELESS:
+    case DXGI_FORMAT_B8G8R8X8_UNORM_SRGB:
+        return DXGI_FORMAT_B8G8R8X8_UNORM;
+
+    default:
+        return format;
+    }
+}
+
+auto YaGE::MipGenerator::TypelessFormat(DXGI_FORMAT format) noexcept -> DXGI_FORMAT {
+    switch (format) {
+    case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+        return DXGI_FORMAT_R8G8B8A8_TYPELESS;
+
+    case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+        return DXGI_FORMAT_B8G8R8A8_TYPELESS;
+
+    case DXGI_FORMAT_B8G8R8X8_UNORM_SRGB:
+        return DXGI_FORMAT_B8G8R8X8_TYPELESS;
+
+    default:
+        return format;
+    }
+}
+
+auto YaGE::MipGenerator::Singleton() -> MipGenerator & {
+    static MipGenerator instance;
+    return instance;
+}
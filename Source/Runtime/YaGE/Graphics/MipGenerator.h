@@ -0,0 +1,86 @@
+#pragma once
+
+#include "RootSignature.h"
+
+namespace YaGE {
+
+class MipGenerator {
+public:
+    /// @brief
+    ///   Create a compute mipmap generator. The compute shader is compiled and the pipeline state is created in this constructor.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to compile the compute shader or failed to create root signature or pipeline state.
+    YAGE_API MipGenerator();
+
+    /// @brief
+    ///   Copy constructor is disabled.
+    MipGenerator(const MipGenerator &) = delete;
+
+    /// @brief
+    ///   Copy assignment is disabled.
+    auto operator=(const MipGenerator &) = delete;
+
+    /// @brief
+    ///   Destroy this mipmap generator.
+    YAGE_API ~MipGenerator() noexcept;
+
+    /// @brief
+    ///   Get root signature of the mipmap generation compute shader.
+    /// @remarks
+    ///   Root parameter 0 is 6 32-bit root constants, root parameter 1 is a descriptor table of the source mip level SRV and root parameter 2 is a descriptor table of 4 destination mip level UAVs.
+    ///
+    /// @return RootSignature &
+    ///   Return reference to the root signature.
+    YAGE_NODISCARD auto RootSignature() noexcept -> YaGE::RootSignature & { return rootSignature; }
+
+    /// @brief
+    ///   Get compute pipeline state of the mipmap generation compute shader.
+    ///
+    /// @return ID3D12PipelineState *
+    ///   Return the D3D12 compute pipeline state.
+    YAGE_NODISCARD auto D3D12PipelineState() const noexcept -> ID3D12PipelineState * { return pipelineState.Get(); }
+
+    /// @brief  Maximum number of mip levels that are generated per dispatch.
+    static constexpr const uint32_t MAX_MIPS_PER_DISPATCH = 4;
+
+    /// @brief  Width and height of thread groups of the compute shader.
+    static constexpr const uint32_t GROUP_SIZE = 8;
+
+    /// @brief
+    ///   Get the format that unordered access views use to write mip levels of the specified format. sRGB formats are converted to their UNORM formats.
+    ///
+    /// @param format   Pixel format of the pixel buffer.
+    ///
+    /// @return DXGI_FORMAT
+    ///   Return format of unordered access views.
+    YAGE_NODISCARD YAGE_API static auto UnorderedAccessFormat(DXGI_FORMAT format) noexcept -> DXGI_FORMAT;
+
+    /// @brief
+    ///   Get the typeless format of the specified sRGB format. Resources of sRGB formats must be created as typeless to be written by unordered access views.
+    ///
+    /// @param format   Pixel format of the pixel buffer.
+    ///
+    /// @return DXGI_FORMAT
+    ///   Return the typeless format if @p format is a sRGB format. Otherwise, return @p format.
+    YAGE_NODISCARD YAGE_API static auto TypelessFormat(DXGI_FORMAT format) noexcept -> DXGI_FORMAT;
+
+    /// @brief
+    ///   Get global singleton instance of mipmap generator. The mipmap generator is created on first use.
+    ///
+    /// @return MipGenerator &
+    ///   Return reference to the mipmap generator singleton instance.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to create the mipmap generator.
+    YAGE_NODISCARD YAGE_API static auto Singleton() -> MipGenerator &;
+
+private:
+    /// @brief  Root signature of the mipmap generation compute shader.
+    YaGE::RootSignature rootSignature;
+
+    /// @brief  Compute pipeline state of the mipmap generation compute shader.
+    Microsoft::WRL::ComPtr<ID3D12PipelineState> pipelineState;
+};
+
+} // namespace YaGE
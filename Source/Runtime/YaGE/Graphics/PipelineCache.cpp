@@ -0,0 +1,628 @@
+#include "PipelineCache.h"
+#include "../Core/Exception.h"
+#include "../Core/Hash.h"
+#include "RenderDevice.h"
+
+#include <cstring>
+
+using namespace YaGE;
+using Microsoft::WRL::ComPtr;
+
+namespace {
+
+class DescHasher {
+public:
+    /// @brief
+    ///   Create a new description hasher.
+    ///
+    /// @param seed     Initial hash value.
+    explicit DescHasher(uint64_t seed) noexcept : value(seed) {}
+
+    /// @brief
+    ///   Append raw data to this hasher.
+    ///
+    /// @param data     Pointer to start of data to be hashed.
+    /// @param size     Size in byte of data to be hashed.
+    auto Append(const void *data, size_t size) noexcept -> void { value = FastHash64(data, size, value); }
+
+    /// @brief
+    ///   Append a scalar value to this hasher. Structures with paddings or pointers must not be appended with this
+    ///   method.
+    ///
+    /// @tparam T   Type of the scalar value.
+    /// @param v    The value to be hashed.
+    template <typename T>
+    auto Append(const T &v) noexcept -> void {
+        Append(&v, sizeof(T));
+    }
+
+    /// @brief
+    ///   Append a null-terminated string to this hasher.
+    ///
+    /// @param str  The string to be hashed. Could be nullptr.
+    auto AppendString(const char *str) noexcept -> void {
+        const uint64_t length = (str == nullptr ? 0 : strlen(str));
+        Append(length);
+        Append(str, static_cast<size_t>(length));
+    }
+
+    /// @brief
+    ///   Append shader bytecode to this hasher.
+    ///
+    /// @param shader   The shader bytecode to be hashed.
+    auto AppendShader(const D3D12_SHADER_BYTECODE &shader) noexcept -> void {
+        const uint64_t length = (shader.pShaderBytecode == nullptr ? 0 : shader.BytecodeLength);
+        Append(length);
+        Append(shader.pShaderBytecode, static_cast<size_t>(length));
+    }
+
+    /// @brief
+    ///   Append blend state to this hasher. Blend state contains paddings and is hashed member by member.
+    ///
+    /// @param blend    The blend state to be hashed.
+    auto AppendBlendState(const D3D12_BLEND_DESC &blend) noexcept -> void {
+        Append(blend.AlphaToCoverageEnable);
+        Append(blend.IndependentBlendEnable);
+        for (const auto &rt : blend.RenderTarget) {
+            Append(rt.BlendEnable);
+            Append(rt.LogicOpEnable);
+            Append(rt.SrcBlend);
+            Append(rt.DestBlend);
+            Append(rt.BlendOp);
+            Append(rt.SrcBlendAlpha);
+            Append(rt.DestBlendAlpha);
+            Append(rt.BlendOpAlpha);
+            Append(rt.LogicOp);
+            Append(rt.RenderTargetWriteMask);
+        }
+    }
+
+    /// @brief
+    ///   Append depth stencil state to this hasher. Depth stencil state contains paddings and is hashed member by
+    ///   member.
+    ///
+    /// @param ds   The depth stencil state to be hashed.
+    auto AppendDepthStencilState(const D3D12_DEPTH_STENCIL_DESC &ds) noexcept -> void {
+        Append(ds.DepthEnable);
+        Append(ds.DepthWriteMask);
+        Append(ds.DepthFunc);
+        Append(ds.StencilEnable);
+        Append(ds.StencilReadMask);
+        Append(ds.StencilWriteMask);
+        Append(&ds.FrontFace, sizeof(ds.FrontFace));
+        Append(&ds.BackFace, sizeof(ds.BackFace));
+    }
+
+    /// @brief
+    ///   Get current hash value.
+    ///
+    /// @return uint64_t
+    ///   Return current hash value.
+    YAGE_NODISCARD auto Value() const noexcept -> uint64_t { return value; }
+
+private:
+    /// @brief  Current hash value.
+    uint64_t value;
+};
+
+/// @brief
+///   Calculate hash value of a graphics pipeline state description. Pointers are followed so that the hash value is
+///   stable across different runs.
+///
+/// @param rootSignatureHash    Hash value of the root signature.
+/// @param desc                 The graphics pipeline state description to be hashed.
+///
+/// @return uint64_t
+///   Return hash value of the graphics pipeline state description.
+YAGE_NODISCARD static auto HashGraphicsPipelineDesc(uint64_t                                  rootSignatureHash,
+                                                    const D3D12_GRAPHICS_PIPELINE_STATE_DESC &desc) noexcept
+    -> uint64_t {
+    DescHasher hasher(rootSignatureHash);
+
+    hasher.AppendShader(desc.VS);
+    hasher.AppendShader(desc.PS);
+    hasher.AppendShader(desc.DS);
+    hasher.AppendShader(desc.HS);
+    hasher.AppendShader(desc.GS);
+
+    { // Stream output.
+        const D3D12_STREAM_OUTPUT_DESC &so = desc.StreamOutput;
+        hasher.Append(so.NumEntries);
+        for (UINT i = 0; i < so.NumEntries; ++i) {
+            const D3D12_SO_DECLARATION_ENTRY &entry = so.pSODeclaration[i];
+            hasher.Append(entry.Stream);
+            hasher.AppendString(entry.SemanticName);
+            hasher.Append(entry.SemanticIndex);
+            hasher.Append(entry.StartComponent);
+            hasher.Append(entry.ComponentCount);
+            hasher.Append(entry.OutputSlot);
+        }
+
+        hasher.Append(so.NumStrides);
+        if (so.NumStrides != 0)
+            hasher.Append(so.pBufferStrides, so.NumStrides * sizeof(UINT));
+        hasher.Append(so.RasterizedStream);
+    }
+
+    hasher.AppendBlendState(desc.BlendState);
+
+    hasher.Append(desc.SampleMask);
+
+    // Rasterizer state does not contain any padding.
+    hasher.Append(&desc.RasterizerState, sizeof(desc.RasterizerState));
+
+    hasher.AppendDepthStencilState(desc.DepthStencilState);
+
+    { // Input layout.
+        const D3D12_INPUT_LAYOUT_DESC &layout = desc.InputLayout;
+        hasher.Append(layout.NumElements);
+        for (UINT i = 0; i < layout.NumElements; ++i) {
+            const D3D12_INPUT_ELEMENT_DESC &element = layout.pInputElementDescs[i];
+            hasher.AppendString(element.SemanticName);
+            hasher.Append(element.SemanticIndex);
+            hasher.Append(element.Format);
+            hasher.Append(element.InputSlot);
+            hasher.Append(element.AlignedByteOffset);
+            hasher.Append(element.InputSlotClass);
+            hasher.Append(element.InstanceDataStepRate);
+        }
+    }
+
+    hasher.Append(desc.IBStripCutValue);
+    hasher.Append(desc.PrimitiveTopologyType);
+    hasher.Append(desc.NumRenderTargets);
+    hasher.Append(desc.RTVFormats, sizeof(desc.RTVFormats));
+    hasher.Append(desc.DSVFormat);
+    hasher.Append(desc.SampleDesc.Count);
+    hasher.Append(desc.SampleDesc.Quality);
+    hasher.Append(desc.NodeMask);
+    hasher.Append(desc.Flags);
+
+    return hasher.Value();
+}
+
+/// @brief
+///   Calculate hash value of a compute pipeline state description.
+///
+/// @param rootSignatureHash    Hash value of the root signature.
+/// @param desc                 The compute pipeline state description to be hashed.
+///
+/// @return uint64_t
+///   Return hash value of the compute pipeline state description.
+YAGE_NODISCARD static auto HashComputePipelineDesc(uint64_t                                 rootSignatureHash,
+                                                   const D3D12_COMPUTE_PIPELINE_STATE_DESC &desc) noexcept
+    -> uint64_t {
+    DescHasher hasher(rootSignatureHash);
+
+    // Compute pipeline states share the same pipeline library with graphics pipeline states.
+    hasher.Append(D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_CS);
+    hasher.AppendShader(desc.CS);
+    hasher.Append(desc.NodeMask);
+    hasher.Append(desc.Flags);
+
+    return hasher.Value();
+}
+
+#ifdef __ID3D12GraphicsCommandList6_INTERFACE_DEFINED__
+/// @brief
+///   Calculate hash value of a mesh shader pipeline state description.
+///
+/// @param rootSignatureHash    Hash value of the root signature.
+/// @param desc                 The mesh shader pipeline state description to be hashed.
+///
+/// @return uint64_t
+///   Return hash value of the mesh shader pipeline state description.
+YAGE_NODISCARD static auto HashMeshPipelineDesc(uint64_t rootSignatureHash, const MeshPipelineStateDesc &desc) noexcept
+    -> uint64_t {
+    DescHasher hasher(rootSignatureHash);
+
+    // Mesh pipeline states share the same pipeline library with graphics pipeline states.
+    hasher.Append(D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_MS);
+    hasher.AppendShader(desc.AS);
+    hasher.AppendShader(desc.MS);
+    hasher.AppendShader(desc.PS);
+    hasher.AppendBlendState(desc.BlendState);
+    hasher.Append(desc.SampleMask);
+    hasher.Append(&desc.RasterizerState, sizeof(desc.RasterizerState));
+    hasher.AppendDepthStencilState(desc.DepthStencilState);
+    hasher.Append(desc.PrimitiveTopologyType);
+    hasher.Append(desc.NumRenderTargets);
+    hasher.Append(desc.RTVFormats, sizeof(desc.RTVFormats));
+    hasher.Append(desc.DSVFormat);
+    hasher.Append(desc.SampleDesc.Count);
+    hasher.Append(desc.SampleDesc.Quality);
+    hasher.Append(desc.NodeMask);
+    hasher.Append(desc.Flags);
+
+    return hasher.Value();
+}
+
+/// @brief
+///   A pipeline state stream subobject. Each subobject must be aligned to pointer size.
+///
+/// @tparam Type    Type of the subobject.
+/// @tparam T       Type of the subobject value.
+template <D3D12_PIPELINE_STATE_SUBOBJECT_TYPE Type, typename T>
+struct alignas(void *) StreamSubobject {
+    /// @brief  Type of this subobject.
+    D3D12_PIPELINE_STATE_SUBOBJECT_TYPE type;
+
+    /// @brief  Value of this subobject.
+    T value;
+
+    /// @brief
+    ///   Create a pipeline state stream subobject.
+    ///
+    /// @param v    Value of this subobject.
+    StreamSubobject(const T &v) noexcept : type(Type), value(v) {}
+};
+
+/// @brief
+///   Pipeline state stream of mesh shader pipeline states.
+struct MeshPipelineStream {
+    /// @brief  Root signature subobject.
+    StreamSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_ROOT_SIGNATURE, ID3D12RootSignature *> rootSignature;
+
+    /// @brief  Amplification shader subobject.
+    StreamSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_AS, D3D12_SHADER_BYTECODE> as;
+
+    /// @brief  Mesh shader subobject.
+    StreamSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_MS, D3D12_SHADER_BYTECODE> ms;
+
+    /// @brief  Pixel shader subobject.
+    StreamSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_PS, D3D12_SHADER_BYTECODE> ps;
+
+    /// @brief  Blend state subobject.
+    StreamSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_BLEND, D3D12_BLEND_DESC> blendState;
+
+    /// @brief  Sample mask subobject.
+    StreamSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_SAMPLE_MASK, UINT> sampleMask;
+
+    /// @brief  Rasterizer state subobject.
+    StreamSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_RASTERIZER, D3D12_RASTERIZER_DESC> rasterizerState;
+
+    /// @brief  Depth stencil state subobject.
+    StreamSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_DEPTH_STENCIL, D3D12_DEPTH_STENCIL_DESC> depthStencilState;
+
+    /// @brief  Primitive topology type subobject.
+    StreamSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_PRIMITIVE_TOPOLOGY, D3D12_PRIMITIVE_TOPOLOGY_TYPE> topology;
+
+    /// @brief  Render target formats subobject.
+    StreamSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_RENDER_TARGET_FORMATS, D3D12_RT_FORMAT_ARRAY> rtvFormats;
+
+    /// @brief  Depth stencil format subobject.
+    StreamSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_DEPTH_STENCIL_FORMAT, DXGI_FORMAT> dsvFormat;
+
+    /// @brief  Sample description subobject.
+    StreamSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_SAMPLE_DESC, DXGI_SAMPLE_DESC> sampleDesc;
+
+    /// @brief  Node mask subobject.
+    StreamSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_NODE_MASK, UINT> nodeMask;
+
+    /// @brief  Pipeline state flags subobject.
+    StreamSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_FLAGS, D3D12_PIPELINE_STATE_FLAGS> flags;
+
+    /// @brief
+    ///   Create a pipeline state stream from mesh shader pipeline state description.
+    ///
+    /// @param rootSig  The D3D12 root signature of the pipeline state.
+    /// @param desc     The mesh shader pipeline state description.
+    MeshPipelineStream(ID3D12RootSignature *rootSig, const MeshPipelineStateDesc &desc) noexcept
+        : rootSignature(rootSig),
+          as(desc.AS),
+          ms(desc.MS),
+          ps(desc.PS),
+          blendState(desc.BlendState),
+          sampleMask(desc.SampleMask),
+          rasterizerState(desc.RasterizerState),
+          depthStencilState(desc.DepthStencilState),
+          topology(desc.PrimitiveTopologyType),
+          rtvFormats(D3D12_RT_FORMAT_ARRAY{}),
+          dsvFormat(desc.DSVFormat),
+          sampleDesc(desc.SampleDesc),
+          nodeMask(desc.NodeMask),
+          flags(desc.Flags) {
+        rtvFormats.value.NumRenderTargets = desc.NumRenderTargets;
+        for (UINT i = 0; i < 8; ++i)
+            rtvFormats.value.RTFormats[i] = desc.RTVFormats[i];
+    }
+};
+#endif
+
+/// @brief
+///   Get name of the pipeline state in pipeline library.
+///
+/// @param      hash    Hash value of the pipeline state description.
+/// @param[out] name    Receives the null-terminated pipeline name.
+static auto PipelineName(uint64_t hash, wchar_t (&name)[17]) noexcept -> void {
+    constexpr const wchar_t digits[] = L"0123456789ABCDEF";
+    for (int i = 15; i >= 0; --i) {
+        name[i] = digits[hash & 0xF];
+        hash >>= 4;
+    }
+    name[16] = L'\0';
+}
+
+/// @brief
+///   Open a file with Win32 API.
+///
+/// @param path         Path to the file.
+/// @param access       Desired access of the file.
+/// @param disposition  Action to take on the file.
+///
+/// @return HANDLE
+///   Return handle to the file. Return @p INVALID_HANDLE_VALUE if failed to open the file.
+YAGE_NODISCARD static auto OpenFile(StringView path, DWORD access, DWORD disposition) noexcept -> HANDLE {
+    if (path.IsNullTerminated())
+        return CreateFileW(reinterpret_cast<LPCWSTR>(path.Data()), access, FILE_SHARE_READ, nullptr, disposition,
+                           FILE_ATTRIBUTE_NORMAL, nullptr);
+
+    String tempPath(path);
+    return CreateFileW(reinterpret_cast<LPCWSTR>(tempPath.Data()), access, FILE_SHARE_READ, nullptr, disposition,
+                       FILE_ATTRIBUTE_NORMAL, nullptr);
+}
+
+} // namespace
+
+YaGE::PipelineCache::PipelineCache()
+    : device(RenderDevice::Singleton().Device()),
+      library(),
+      libraryData(),
+      libraryMutex(),
+      pipelineStates(),
+      pipelineStateMutex() {
+    // Pipeline library is optional. Pipeline states are only cached in memory if not supported.
+    HRESULT hr = device->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(library.GetAddressOf()));
+    if (FAILED(hr))
+        library.Reset();
+}
+
+YaGE::PipelineCache::~PipelineCache() noexcept {}
+
+auto YaGE::PipelineCache::Load(StringView path) noexcept -> bool {
+    std::vector<uint8_t> data;
+
+    { // Read file.
+        HANDLE file = OpenFile(path, GENERIC_READ, OPEN_EXISTING);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER fileSize{};
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart <= 0 || fileSize.QuadPart > UINT32_MAX) {
+            CloseHandle(file);
+            return false;
+        }
+
+        data.resize(static_cast<size_t>(fileSize.QuadPart));
+
+        DWORD      bytesRead = 0;
+        const BOOL succeeded = ReadFile(file, data.data(), static_cast<DWORD>(data.size()), &bytesRead, nullptr);
+        CloseHandle(file);
+
+        if (!succeeded || bytesRead != data.size())
+            return false;
+    }
+
+    // Driver or device mismatch is reported here. Caller should rebuild the pipeline library in this case.
+    ComPtr<ID3D12PipelineLibrary> newLibrary;
+    HRESULT hr = device->CreatePipelineLibrary(data.data(), data.size(), IID_PPV_ARGS(newLibrary.GetAddressOf()));
+    if (FAILED(hr))
+        return false;
+
+    // Release old library before releasing its data. Moving vector does not invalidate its data pointer.
+    std::lock_guard<std::mutex> lock(libraryMutex);
+    library     = std::move(newLibrary);
+    libraryData = std::move(data);
+
+    return true;
+}
+
+auto YaGE::PipelineCache::Save(StringView path) -> void {
+    std::vector<uint8_t> data;
+
+    { // Serialize pipeline library.
+        std::lock_guard<std::mutex> lock(libraryMutex);
+        if (library == nullptr)
+            throw SystemErrorException(DXGI_ERROR_UNSUPPORTED, u"Pipeline library is not supported.");
+
+        data.resize(library->GetSerializedSize());
+
+        HRESULT hr = library->Serialize(data.data(), data.size());
+        if (FAILED(hr))
+            throw SystemErrorException(hr, u"Failed to serialize pipeline library.");
+    }
+
+    HANDLE file = OpenFile(path, GENERIC_WRITE, CREATE_ALWAYS);
+    if (file == INVALID_HANDLE_VALUE)
+        throw SystemErrorException(static_cast<int32_t>(GetLastError()),
+                                   Format(u"Failed to create pipeline library file: {}.", path));
+
+    DWORD      bytesWritten = 0;
+    const BOOL succeeded    = WriteFile(file, data.data(), static_cast<DWORD>(data.size()), &bytesWritten, nullptr);
+    const auto errorCode    = static_cast<int32_t>(GetLastError());
+    CloseHandle(file);
+
+    if (!succeeded || bytesWritten != data.size())
+        throw SystemErrorException(errorCode, Format(u"Failed to write pipeline library file: {}.", path));
+}
+
+YAGE_NODISCARD auto YaGE::PipelineCache::CreateGraphicsPipelineState(
+    const RootSignature &rootSignature, const D3D12_GRAPHICS_PIPELINE_STATE_DESC &desc) -> ComPtr<ID3D12PipelineState> {
+    const uint64_t hash = HashGraphicsPipelineDesc(rootSignature.Hash(), desc);
+
+    { // Try to find an existing pipeline state.
+        std::lock_guard<std::mutex> lock(pipelineStateMutex);
+
+        auto iter = pipelineStates.Find(hash);
+        if (iter != pipelineStates.end())
+            return iter->second;
+    }
+
+    D3D12_GRAPHICS_PIPELINE_STATE_DESC pipelineDesc(desc);
+    pipelineDesc.pRootSignature = rootSignature.D3D12RootSignature();
+
+    wchar_t name[17];
+    PipelineName(hash, name);
+
+    ComPtr<ID3D12PipelineState> pipelineState;
+
+    HRESULT hr = E_FAIL;
+    { // Try to load from pipeline library.
+        std::lock_guard<std::mutex> lock(libraryMutex);
+        if (library != nullptr)
+            hr = library->LoadGraphicsPipeline(name, &pipelineDesc, IID_PPV_ARGS(pipelineState.GetAddressOf()));
+    }
+
+    // Compile pipeline state. Do not lock here so that pipeline states could be compiled in parallel.
+    const bool loaded = SUCCEEDED(hr);
+    if (!loaded) {
+        hr = device->CreateGraphicsPipelineState(&pipelineDesc, IID_PPV_ARGS(pipelineState.ReleaseAndGetAddressOf()));
+        if (FAILED(hr))
+            throw RenderAPIException(hr, u"Failed to create graphics pipeline state.");
+    }
+
+    { // Another thread may have created the same pipeline state.
+        std::lock_guard<std::mutex> lock(pipelineStateMutex);
+
+        auto result = pipelineStates.TryEmplace(hash, pipelineState);
+        if (!result.second)
+            return result.first->second;
+    }
+
+    if (!loaded) {
+        std::lock_guard<std::mutex> lock(libraryMutex);
+        if (library != nullptr)
+            library->StorePipeline(name, pipelineState.Get());
+    }
+
+    return pipelineState;
+}
+
+YAGE_NODISCARD auto YaGE::PipelineCache::CreateComputePipelineState(
+    const RootSignature &rootSignature, const D3D12_COMPUTE_PIPELINE_STATE_DESC &desc) -> ComPtr<ID3D12PipelineState> {
+    const uint64_t hash = HashComputePipelineDesc(rootSignature.Hash(), desc);
+
+    { // Try to find an existing pipeline state.
+        std::lock_guard<std::mutex> lock(pipelineStateMutex);
+
+        auto iter = pipelineStates.Find(hash);
+        if (iter != pipelineStates.end())
+            return iter->second;
+    }
+
+    D3D12_COMPUTE_PIPELINE_STATE_DESC pipelineDesc(desc);
+    pipelineDesc.pRootSignature = rootSignature.D3D12RootSignature();
+
+    wchar_t name[17];
+    PipelineName(hash, name);
+
+    ComPtr<ID3D12PipelineState> pipelineState;
+
+    HRESULT hr = E_FAIL;
+    { // Try to load from pipeline library.
+        std::lock_guard<std::mutex> lock(libraryMutex);
+        if (library != nullptr)
+            hr = library->LoadComputePipeline(name, &pipelineDesc, IID_PPV_ARGS(pipelineState.GetAddressOf()));
+    }
+
+    // Compile pipeline state. Do not lock here so that pipeline states could be compiled in parallel.
+    const bool loaded = SUCCEEDED(hr);
+    if (!loaded) {
+        hr = device->CreateComputePipelineState(&pipelineDesc, IID_PPV_ARGS(pipelineState.ReleaseAndGetAddressOf()));
+        if (FAILED(hr))
+            throw RenderAPIException(hr, u"Failed to create compute pipeline state.");
+    }
+
+    { // Another thread may have created the same pipeline state.
+        std::lock_guard<std::mutex> lock(pipelineStateMutex);
+
+        auto result = pipelineStates.TryEmplace(hash, pipelineState);
+        if (!result.second)
+            return result.first->second;
+    }
+
+    if (!loaded) {
+        std::lock_guard<std::mutex> lock(libraryMutex);
+        if (library != nullptr)
+            library->StorePipeline(name, pipelineState.Get());
+    }
+
+    return pipelineState;
+}
+
+#ifdef __ID3D12GraphicsCommandList6_INTERFACE_DEFINED__
+YAGE_NODISCARD auto YaGE::PipelineCache::CreateMeshPipelineState(const RootSignature         &rootSignature,
+                                                                 const MeshPipelineStateDesc &desc)
+    -> ComPtr<ID3D12PipelineState> {
+    const uint64_t hash = HashMeshPipelineDesc(rootSignature.Hash(), desc);
+
+    { // Try to find an existing pipeline state.
+        std::lock_guard<std::mutex> lock(pipelineStateMutex);
+
+        auto iter = pipelineStates.Find(hash);
+        if (iter != pipelineStates.end())
+            return iter->second;
+    }
+
+    // Mesh shader pipeline states could only be created with pipeline state streams.
+    ComPtr<ID3D12Device2> device2;
+    HRESULT               hr = device->QueryInterface(IID_PPV_ARGS(device2.GetAddressOf()));
+    if (FAILED(hr))
+        throw RenderAPIException(hr, u"Pipeline state stream is not supported.");
+
+    MeshPipelineStream stream(rootSignature.D3D12RootSignature(), desc);
+
+    const D3D12_PIPELINE_STATE_STREAM_DESC streamDesc{
+        /* SizeInBytes                   = */ sizeof(stream),
+        /* pPipelineStateSubobjectStream = */ &stream,
+    };
+
+    wchar_t name[17];
+    PipelineName(hash, name);
+
+    ComPtr<ID3D12PipelineState> pipelineState;
+
+    hr = E_FAIL;
+    { // Try to load from pipeline library. Loading pipeline state streams requires ID3D12PipelineLibrary1.
+        std::lock_guard<std::mutex> lock(libraryMutex);
+
+        ComPtr<ID3D12PipelineLibrary1> library1;
+        if (library != nullptr && SUCCEEDED(library.As(&library1)))
+            hr = library1->LoadPipeline(name, &streamDesc, IID_PPV_ARGS(pipelineState.GetAddressOf()));
+    }
+
+    // Compile pipeline state. Do not lock here so that pipeline states could be compiled in parallel.
+    const bool loaded = SUCCEEDED(hr);
+    if (!loaded) {
+        hr = device2->CreatePipelineState(&streamDesc, IID_PPV_ARGS(pipelineState.ReleaseAndGetAddressOf()));
+        if (FAILED(hr))
+            throw RenderAPIException(hr, u"Failed to create mesh shader pipeline state.");
+    }
+
+    { // Another thread may have created the same pipeline state.
+        std::lock_guard<std::mutex> lock(pipelineStateMutex);
+
+        auto result = pipelineStates.TryEmplace(hash, pipelineState);
+        if (!result.second)
+            return result.first->second;
+    }
+
+    if (!loaded) {
+        std::lock_guard<std::mutex> lock(libraryMutex);
+        if (library != nullptr)
+            library->StorePipeline(name, pipelineState.Get());
+    }
+
+    return pipelineState;
+}
+#endif
+
+YAGE_NODISCARD auto YaGE::PipelineCache::Count() const noexcept -> size_t {
+    std::lock_guard<std::mutex> lock(pipelineStateMutex);
+    return pipelineStates.Size();
+}
+
+YAGE_NODISCARD auto YaGE::PipelineCache::Singleton() -> PipelineCache & {
+    static PipelineCache instance;
+    return instance;
+}
@@ -0,0 +1,138 @@
+#pragma once
+
+#include "../Core/HashMap.h"
+#include "../Core/StringView.h"
+#include "PipelineState.h"
+
+#include <mutex>
+#include <vector>
+
+namespace YaGE {
+
+class PipelineCache {
+public:
+    /// @brief
+    ///   Create an empty pipeline cache. A D3D12 pipeline library is created if supported by current device.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to create the RenderDevice singleton instance.
+    YAGE_API PipelineCache();
+
+    /// @brief
+    ///   Copy constructor is disabled.
+    PipelineCache(const PipelineCache &) = delete;
+
+    /// @brief
+    ///   Copy assignment is disabled.
+    auto operator=(const PipelineCache &) = delete;
+
+    /// @brief
+    ///   Destroy this pipeline cache and release all cached pipeline states.
+    YAGE_API ~PipelineCache() noexcept;
+
+    /// @brief
+    ///   Load a serialized pipeline library from file.
+    /// @remarks
+    ///   Pipeline states that are currently in this cache are kept, but pipeline states in the previous pipeline library could not be loaded anymore. Incompatible pipeline library files, such as files created with different driver versions, are ignored silently. This method should be called before creating any pipeline state.
+    ///
+    /// @param path     Path to the pipeline library file.
+    ///
+    /// @return bool
+    /// @retval true   The pipeline library is loaded.
+    /// @retval false  The file does not exist or the pipeline library is not compatible with current device.
+    YAGE_API auto Load(StringView path) noexcept -> bool;
+
+    /// @brief
+    ///   Serialize all pipeline states in the pipeline library and save to file.
+    ///
+    /// @param path     Path to the pipeline library file.
+    ///
+    /// @throw SystemErrorException
+    ///   Thrown if failed to serialize the pipeline library or failed to write the file.
+    YAGE_API auto Save(StringView path) -> void;
+
+    /// @brief
+    ///   Get or create a graphics pipeline state object.
+    /// @remarks
+    ///   The pipeline state description is hashed, including shader bytecode, input layout, stream output and all states. Existing pipeline state object is returned if a pipeline state with the same description has been created. Otherwise, the pipeline state object is loaded from the pipeline library or compiled and stored into the pipeline library. This method is thread-safe and shader compilation does not block other threads.
+    ///
+    /// @param rootSignature    Root signature of the pipeline state.
+    /// @param desc             D3D12 graphics pipeline state description. @p pRootSignature is ignored.
+    ///
+    /// @return Microsoft::WRL::ComPtr<ID3D12PipelineState>
+    ///   Return the graphics pipeline state object.
+    /// @throw RenderAPIException
+    ///   Thrown if failed to create the graphics pipeline state object.
+    YAGE_NODISCARD YAGE_API auto CreateGraphicsPipelineState(const RootSignature                      &rootSignature,
+                                                             const D3D12_GRAPHICS_PIPELINE_STATE_DESC &desc)
+        -> Microsoft::WRL::ComPtr<ID3D12PipelineState>;
+
+    /// @brief
+    ///   Get or create a compute pipeline state object.
+    /// @remarks
+    ///   Compute pipeline states are cached in the same way as graphics pipeline states. This method is thread-safe and shader compilation does not block other threads.
+    ///
+    /// @param rootSignature    Root signature of the pipeline state.
+    /// @param desc             D3D12 compute pipeline state description. @p pRootSignature is ignored.
+    ///
+    /// @return Microsoft::WRL::ComPtr<ID3D12PipelineState>
+    ///   Return the compute pipeline state object.
+    /// @throw RenderAPIException
+    ///   Thrown if failed to create the compute pipeline state object.
+    YAGE_NODISCARD YAGE_API auto CreateComputePipelineState(const RootSignature                     &rootSignature,
+                                                            const D3D12_COMPUTE_PIPELINE_STATE_DESC &desc)
+        -> Microsoft::WRL::ComPtr<ID3D12PipelineState>;
+
+#ifdef __ID3D12GraphicsCommandList6_INTERFACE_DEFINED__
+    /// @brief
+    ///   Get or create a mesh shader graphics pipeline state object.
+    /// @remarks
+    ///   The pipeline state object is created from a pipeline state stream and cached in the same way as other pipeline states. This method is thread-safe and shader compilation does not block other threads.
+    ///
+    /// @param rootSignature    Root signature of the pipeline state.
+    /// @param desc             Mesh shader pipeline state description.
+    ///
+    /// @return Microsoft::WRL::ComPtr<ID3D12PipelineState>
+    ///   Return the mesh shader graphics pipeline state object.
+    /// @throw RenderAPIException
+    ///   Thrown if the device does not support pipeline state streams or failed to create the pipeline state object.
+    YAGE_NODISCARD YAGE_API auto CreateMeshPipelineState(const RootSignature         &rootSignature,
+                                                         const MeshPipelineStateDesc &desc)
+        -> Microsoft::WRL::ComPtr<ID3D12PipelineState>;
+#endif
+
+    /// @brief
+    ///   Get number of pipeline state objects in this cache.
+    ///
+    /// @return size_t
+    ///   Return number of pipeline state objects in this cache.
+    YAGE_NODISCARD YAGE_API auto Count() const noexcept -> size_t;
+
+    /// @brief
+    ///   Get global singleton instance of pipeline cache. Pipeline state objects are created with this instance.
+    ///
+    /// @return PipelineCache &
+    ///   Return reference to the pipeline cache singleton instance.
+    YAGE_NODISCARD YAGE_API static auto Singleton() -> PipelineCache &;
+
+private:
+    /// @brief  D3D12 device that is used to create pipeline states.
+    ID3D12Device1 *device;
+
+    /// @brief  D3D12 pipeline library. This may be nullptr if pipeline library is not supported.
+    Microsoft::WRL::ComPtr<ID3D12PipelineLibrary> library;
+
+    /// @brief  Serialized pipeline library data. This must be kept alive as long as the pipeline library is alive.
+    std::vector<uint8_t> libraryData;
+
+    /// @brief  Mutex to protect pipeline library.
+    mutable std::mutex libraryMutex;
+
+    /// @brief  Cached pipeline state objects. Indexed by hash value of pipeline state description.
+    HashMap<uint64_t, Microsoft::WRL::ComPtr<ID3D12PipelineState>> pipelineStates;
+
+    /// @brief  Mutex to protect cached pipeline state objects.
+    mutable std::mutex pipelineStateMutex;
+};
+
+} // namespace YaGE
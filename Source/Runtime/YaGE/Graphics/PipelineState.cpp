@@ -1,9 +1,226 @@
 #include "PipelineState.h"
-#include "../Core/Exception.h"
-#include "RenderDevice.h"
+#include "../Core/ThreadPool.h"
+#include "PipelineCache.h"
+
+#include <string>
+#include <vector>
 
 using namespace YaGE;
 
+namespace {
+
+/// @brief
+///   Copy shader bytecode to the specified storage.
+///
+/// @param[in, out] shader  The shader bytecode to be copied. This will be redirected to @p storage.
+/// @param[out]     storage The storage to copy shader bytecode to.
+auto CopyBytecode(D3D12_SHADER_BYTECODE &shader, std::vector<uint8_t> &storage) -> void {
+    const auto *data = static_cast<const uint8_t *>(shader.pShaderBytecode);
+    if (data == nullptr || shader.BytecodeLength == 0) {
+        shader.pShaderBytecode = nullptr;
+        shader.BytecodeLength  = 0;
+        return;
+    }
+
+    storage.assign(data, data + shader.BytecodeLength);
+    shader.pShaderBytecode = storage.data();
+}
+
+/// @brief
+///   Copy cached pipeline state blob to the specified storage.
+///
+/// @param[in, out] cachedPSO   The cached pipeline state blob to be copied. This will be redirected to @p storage.
+/// @param[out]     storage     The storage to copy cached pipeline state blob to.
+auto CopyCachedBlob(D3D12_CACHED_PIPELINE_STATE &cachedPSO, std::vector<uint8_t> &storage) -> void {
+    const auto *blob = static_cast<const uint8_t *>(cachedPSO.pCachedBlob);
+    if (blob != nullptr && cachedPSO.CachedBlobSizeInBytes != 0) {
+        storage.assign(blob, blob + cachedPSO.CachedBlobSizeInBytes);
+        cachedPSO.pCachedBlob = storage.data();
+    } else {
+        cachedPSO.pCachedBlob           = nullptr;
+        cachedPSO.CachedBlobSizeInBytes = 0;
+    }
+}
+
+class GraphicsPipelineDescStorage {
+public:
+    /// @brief
+    ///   Deep copy a graphics pipeline state description.
+    ///
+    /// @param src  The graphics pipeline state description to be copied.
+    explicit GraphicsPipelineDescStorage(const D3D12_GRAPHICS_PIPELINE_STATE_DESC &src);
+
+    /// @brief
+    ///   Copy constructor is disabled. Copied description refers to data stored in this object.
+    GraphicsPipelineDescStorage(const GraphicsPipelineDescStorage &) = delete;
+
+    /// @brief
+    ///   Copy assignment is disabled.
+    auto operator=(const GraphicsPipelineDescStorage &) = delete;
+
+    /// @brief
+    ///   Get the copied graphics pipeline state description.
+    ///
+    /// @return const D3D12_GRAPHICS_PIPELINE_STATE_DESC &
+    ///   Return reference to the copied graphics pipeline state description.
+    YAGE_NODISCARD auto Desc() const noexcept -> const D3D12_GRAPHICS_PIPELINE_STATE_DESC & { return desc; }
+
+private:
+    /// @brief
+    ///   Copy a null-terminated string into string storage.
+    ///
+    /// @param str  The string to be copied. Could be nullptr.
+    ///
+    /// @return const char *
+    ///   Return pointer to the copied string.
+    YAGE_NODISCARD auto CopyString(const char *str) -> const char *;
+
+private:
+    /// @brief  The copied description.
+    D3D12_GRAPHICS_PIPELINE_STATE_DESC desc;
+
+    /// @brief  Shader bytecode storage for VS, PS, DS, HS, GS and cached pipeline state blob.
+    std::vector<uint8_t> bytecodes[6];
+
+    /// @brief  Stream output declaration entries.
+    std::vector<D3D12_SO_DECLARATION_ENTRY> streamOutputEntries;
+
+    /// @brief  Stream output buffer strides.
+    std::vector<UINT> streamOutputStrides;
+
+    /// @brief  Input layout elements.
+    std::vector<D3D12_INPUT_ELEMENT_DESC> inputElements;
+
+    /// @brief  Semantic name storage. Capacity is reserved so that no reallocation happens.
+    std::vector<std::string> semanticNames;
+};
+
+GraphicsPipelineDescStorage::GraphicsPipelineDescStorage(const D3D12_GRAPHICS_PIPELINE_STATE_DESC &src)
+    : desc(src),
+      bytecodes(),
+      streamOutputEntries(),
+      streamOutputStrides(),
+      inputElements(),
+      semanticNames() {
+    desc.pRootSignature = nullptr;
+
+    CopyBytecode(desc.VS, bytecodes[0]);
+    CopyBytecode(desc.PS, bytecodes[1]);
+    CopyBytecode(desc.DS, bytecodes[2]);
+    CopyBytecode(desc.HS, bytecodes[3]);
+    CopyBytecode(desc.GS, bytecodes[4]);
+    CopyCachedBlob(desc.CachedPSO, bytecodes[5]);
+
+    semanticNames.reserve(src.StreamOutput.NumEntries + src.InputLayout.NumElements);
+
+    { // Copy stream output.
+        D3D12_STREAM_OUTPUT_DESC &so = desc.StreamOutput;
+        if (so.pSODeclaration != nullptr && so.NumEntries != 0) {
+            streamOutputEntries.assign(so.pSODeclaration, so.pSODeclaration + so.NumEntries);
+            for (auto &entry : streamOutputEntries)
+                entry.SemanticName = CopyString(entry.SemanticName);
+            so.pSODeclaration = streamOutputEntries.data();
+        }
+
+        if (so.pBufferStrides != nullptr && so.NumStrides != 0) {
+            streamOutputStrides.assign(so.pBufferStrides, so.pBufferStrides + so.NumStrides);
+            so.pBufferStrides = streamOutputStrides.data();
+        }
+    }
+
+    { // Copy input layout.
+        D3D12_INPUT_LAYOUT_DESC &layout = desc.InputLayout;
+        if (layout.pInputElementDescs != nullptr && layout.NumElements != 0) {
+            inputElements.assign(layout.pInputElementDescs, layout.pInputElementDescs + layout.NumElements);
+            for (auto &element : inputElements)
+                element.SemanticName = CopyString(element.SemanticName);
+            layout.pInputElementDescs = inputElements.data();
+        }
+    }
+}
+
+YAGE_NODISCARD auto GraphicsPipelineDescStorage::CopyString(const char *str) -> const char * {
+    if (str == nullptr)
+        return nullptr;
+
+    semanticNames.emplace_back(str);
+    return semanticNames.back().c_str();
+}
+
+class ComputePipelineDescStorage {
+public:
+    /// @brief
+    ///   Deep copy a compute pipeline state description.
+    ///
+    /// @param src  The compute pipeline state description to be copied.
+    explicit ComputePipelineDescStorage(const D3D12_COMPUTE_PIPELINE_STATE_DESC &src) : desc(src), bytecodes() {
+        desc.pRootSignature = nullptr;
+        CopyBytecode(desc.CS, bytecodes[0]);
+        CopyCachedBlob(desc.CachedPSO, bytecodes[1]);
+    }
+
+    /// @brief
+    ///   Copy constructor is disabled. Copied description refers to data stored in this object.
+    ComputePipelineDescStorage(const ComputePipelineDescStorage &) = delete;
+
+    /// @brief
+    ///   Copy assignment is disabled.
+    auto operator=(const ComputePipelineDescStorage &) = delete;
+
+    /// @brief
+    ///   Get the copied compute pipeline state description.
+    ///
+    /// @return const D3D12_COMPUTE_PIPELINE_STATE_DESC &
+    ///   Return reference to the copied compute pipeline state description.
+    YAGE_NODISCARD auto Desc() const noexcept -> const D3D12_COMPUTE_PIPELINE_STATE_DESC & { return desc; }
+
+private:
+    /// @brief  The copied description.
+    D3D12_COMPUTE_PIPELINE_STATE_DESC desc;
+
+    /// @brief  Shader bytecode storage for CS and cached pipeline state blob.
+    std::vector<uint8_t> bytecodes[2];
+};
+
+#ifdef __ID3D12GraphicsCommandList6_INTERFACE_DEFINED__
+class MeshPipelineDescStorage {
+public:
+    /// @brief
+    ///   Deep copy a mesh shader pipeline state description.
+    ///
+    /// @param src  The mesh shader pipeline state description to be copied.
+    explicit MeshPipelineDescStorage(const MeshPipelineStateDesc &src) : desc(src), bytecodes() {
+        CopyBytecode(desc.AS, bytecodes[0]);
+        CopyBytecode(desc.MS, bytecodes[1]);
+        CopyBytecode(desc.PS, bytecodes[2]);
+    }
+
+    /// @brief
+    ///   Copy constructor is disabled. Copied description refers to data stored in this object.
+    MeshPipelineDescStorage(const MeshPipelineDescStorage &) = delete;
+
+    /// @brief
+    ///   Copy assignment is disabled.
+    auto operator=(const MeshPipelineDescStorage &) = delete;
+
+    /// @brief
+    ///   Get the copied mesh shader pipeline state description.
+    ///
+    /// @return const MeshPipelineStateDesc &
+    ///   Return reference to the copied mesh shader pipeline state description.
+    YAGE_NODISCARD auto Desc() const noexcept -> const MeshPipelineStateDesc & { return desc; }
+
+private:
+    /// @brief  The copied description.
+    MeshPipelineStateDesc desc;
+
+    /// @brief  Shader bytecode storage for AS, MS and PS.
+    std::vector<uint8_t> bytecodes[3];
+};
+#endif
+
+} // namespace
+
 YaGE::PipelineState::~PipelineState() noexcept {}
 
 YaGE::GraphicsPipelineState::GraphicsPipelineState(YaGE::RootSignature                      &rootSignature,
@@ -17,17 +234,25 @@ YaGE::GraphicsPipelineState::GraphicsPipelineState(YaGE::RootSignature
       depthStencilFormat(desc.DSVFormat),
       primitiveTopology(desc.PrimitiveTopologyType),
       sampleCount(desc.SampleDesc.Count) {
-    HRESULT hr = S_OK;
-
-    // Set root signature.
-    D3D12_GRAPHICS_PIPELINE_STATE_DESC pipelineDesc(desc);
-    pipelineDesc.pRootSignature = rootSignature.D3D12RootSignature();
+    // Identical pipeline states are shared and persisted by pipeline cache.
+    pipelineState = PipelineCache::Singleton().CreateGraphicsPipelineState(rootSignature, desc);
+}
 
-    RenderDevice &device = RenderDevice::Singleton();
-    hr = device.Device()->CreateGraphicsPipelineState(&pipelineDesc, IID_PPV_ARGS(pipelineState.GetAddressOf()));
-    if (FAILED(hr))
-        throw RenderAPIException(hr, u"Failed to create graphics pipeline state.");
+#ifdef __ID3D12GraphicsCommandList6_INTERFACE_DEFINED__
+YaGE::GraphicsPipelineState::GraphicsPipelineState(YaGE::RootSignature         &rootSignature,
+                                                   const MeshPipelineStateDesc &desc)
+    : PipelineState(rootSignature),
+      renderTargetCount(desc.NumRenderTargets),
+      renderTargetFormats{
+          desc.RTVFormats[0], desc.RTVFormats[1], desc.RTVFormats[2], desc.RTVFormats[3],
+          desc.RTVFormats[4], desc.RTVFormats[5], desc.RTVFormats[6], desc.RTVFormats[7],
+      },
+      depthStencilFormat(desc.DSVFormat),
+      primitiveTopology(desc.PrimitiveTopologyType),
+      sampleCount(desc.SampleDesc.Count) {
+    pipelineState = PipelineCache::Singleton().CreateMeshPipelineState(rootSignature, desc);
 }
+#endif
 
 YaGE::GraphicsPipelineState::GraphicsPipelineState(GraphicsPipelineState &&other) noexcept
     : PipelineState(std::move(other)),
@@ -87,3 +312,53 @@ auto YaGE::GraphicsPipelineState::operator=(GraphicsPipelineState &&other) noexc
 }
 
 YaGE::GraphicsPipelineState::~GraphicsPipelineState() noexcept {}
+
+YAGE_NODISCARD auto YaGE::GraphicsPipelineState::CreateAsync(YaGE::RootSignature                      &rootSignature,
+                                                             const D3D12_GRAPHICS_PIPELINE_STATE_DESC &desc)
+    -> std::future<GraphicsPipelineState> {
+    YaGE::RootSignature *const rootSig = &rootSignature;
+    auto                       storage = std::make_shared<GraphicsPipelineDescStorage>(desc);
+
+    return ThreadPool::Singleton().Submit(
+        [rootSig, storage]() -> GraphicsPipelineState { return GraphicsPipelineState(*rootSig, storage->Desc()); });
+}
+
+#ifdef __ID3D12GraphicsCommandList6_INTERFACE_DEFINED__
+YAGE_NODISCARD auto YaGE::GraphicsPipelineState::CreateAsync(YaGE::RootSignature         &rootSignature,
+                                                             const MeshPipelineStateDesc &desc)
+    -> std::future<GraphicsPipelineState> {
+    YaGE::RootSignature *const rootSig = &rootSignature;
+    auto                       storage = std::make_shared<MeshPipelineDescStorage>(desc);
+
+    return ThreadPool::Singleton().Submit(
+        [rootSig, storage]() -> GraphicsPipelineState { return GraphicsPipelineState(*rootSig, storage->Desc()); });
+}
+#endif
+
+YaGE::ComputePipelineState::ComputePipelineState(YaGE::RootSignature                     &rootSignature,
+                                                 const D3D12_COMPUTE_PIPELINE_STATE_DESC &desc)
+    : PipelineState(rootSignature) {
+    // Identical pipeline states are shared and persisted by pipeline cache.
+    pipelineState = PipelineCache::Singleton().CreateComputePipelineState(rootSignature, desc);
+}
+
+YaGE::ComputePipelineState::ComputePipelineState(YaGE::RootSignature         &rootSignature,
+                                                 const D3D12_SHADER_BYTECODE &computeShader)
+    : PipelineState(rootSignature) {
+    D3D12_COMPUTE_PIPELINE_STATE_DESC desc{};
+    desc.CS = computeShader;
+
+    pipelineState = PipelineCache::Singleton().CreateComputePipelineState(rootSignature, desc);
+}
+
+YaGE::ComputePipelineState::~ComputePipelineState() noexcept {}
+
+YAGE_NODISCARD auto YaGE::ComputePipelineState::CreateAsync(YaGE::RootSignature                     &rootSignature,
+                                                            const D3D12_COMPUTE_PIPELINE_STATE_DESC &desc)
+    -> std::future<ComputePipelineState> {
+    YaGE::RootSignature *const rootSig = &rootSignature;
+    auto                       storage = std::make_shared<ComputePipelineDescStorage>(desc);
+
+    return ThreadPool::Singleton().Submit(
+        [rootSig, storage]() -> ComputePipelineState { return ComputePipelineState(*rootSig, storage->Desc()); });
+}
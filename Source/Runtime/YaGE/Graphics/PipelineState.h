@@ -2,8 +2,58 @@
 
 #include "RootSignature.h"
 
+#include <future>
+
 namespace YaGE {
 
+#ifdef __ID3D12GraphicsCommandList6_INTERFACE_DEFINED__
+/// @brief
+///   Description of a graphics pipeline state that uses amplification shader and mesh shader instead of input assembler and vertex processing stages. Pipeline states with this description are created with pipeline state streams.
+struct MeshPipelineStateDesc {
+    /// @brief  Amplification shader bytecode. This is optional.
+    D3D12_SHADER_BYTECODE AS;
+
+    /// @brief  Mesh shader bytecode.
+    D3D12_SHADER_BYTECODE MS;
+
+    /// @brief  Pixel shader bytecode. This is optional for depth-only passes.
+    D3D12_SHADER_BYTECODE PS;
+
+    /// @brief  Blend state.
+    D3D12_BLEND_DESC BlendState;
+
+    /// @brief  Sample mask for blend state.
+    UINT SampleMask;
+
+    /// @brief  Rasterizer state.
+    D3D12_RASTERIZER_DESC RasterizerState;
+
+    /// @brief  Depth stencil state.
+    D3D12_DEPTH_STENCIL_DESC DepthStencilState;
+
+    /// @brief  Type of primitives that are output by the mesh shader.
+    D3D12_PRIMITIVE_TOPOLOGY_TYPE PrimitiveTopologyType;
+
+    /// @brief  Number of render targets.
+    UINT NumRenderTargets;
+
+    /// @brief  Render target formats.
+    DXGI_FORMAT RTVFormats[8];
+
+    /// @brief  Depth stencil format.
+    DXGI_FORMAT DSVFormat;
+
+    /// @brief  Multisample count and quality.
+    DXGI_SAMPLE_DESC SampleDesc;
+
+    /// @brief  Node mask for multi-adapter.
+    UINT NodeMask;
+
+    /// @brief  Pipeline state flags.
+    D3D12_PIPELINE_STATE_FLAGS Flags;
+};
+#endif
+
 class PipelineState {
 protected:
     /// @brief
@@ -64,6 +114,8 @@ class GraphicsPipelineState : public PipelineState {
 public:
     /// @brief
     ///   Create a graphics pipeline state object.
+    /// @remarks
+    ///   The D3D12 pipeline state object is created with @p PipelineCache::Singleton(). Graphics pipeline states with the same description share the same D3D12 pipeline state object.
     ///
     /// @param[in] rootSignature    Root signature of this graphics pipeline state.
     /// @param[in] desc             D3D12 graphics pipeline state description.
@@ -72,6 +124,20 @@ public:
     ///   Thrown if failed to create graphics pipeline state object.
     YAGE_API GraphicsPipelineState(YaGE::RootSignature &rootSignature, const D3D12_GRAPHICS_PIPELINE_STATE_DESC &desc);
 
+#ifdef __ID3D12GraphicsCommandList6_INTERFACE_DEFINED__
+    /// @brief
+    ///   Create a graphics pipeline state object with amplification shader and mesh shader.
+    /// @remarks
+    ///   The D3D12 pipeline state object is created from a pipeline state stream with @p PipelineCache::Singleton(). Mesh pipeline states should only be created if @p RenderDevice::SupportMeshShaders() returns true.
+    ///
+    /// @param[in] rootSignature    Root signature of this graphics pipeline state.
+    /// @param[in] desc             Mesh shader pipeline state description.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to create graphics pipeline state object.
+    YAGE_API GraphicsPipelineState(YaGE::RootSignature &rootSignature, const MeshPipelineStateDesc &desc);
+#endif
+
     /// @brief
     ///   Move constructor of graphics pipeline state object.
     ///
@@ -91,6 +157,36 @@ public:
     ///   Destroy this graphics pipeline state object.
     YAGE_API ~GraphicsPipelineState() noexcept override;
 
+    /// @brief
+    ///   Create a graphics pipeline state object asynchronously on worker threads of @p ThreadPool::Singleton().
+    /// @remarks
+    ///   The description is deep copied, including shader bytecode, input layout and stream output, so that the caller could release them once this method returns. The root signature must be kept alive until the pipeline state is created. This method is thread-safe and could be used to compile pipeline states ahead of time from multiple threads.
+    ///
+    /// @param[in] rootSignature    Root signature of the graphics pipeline state.
+    /// @param[in] desc             D3D12 graphics pipeline state description.
+    ///
+    /// @return std::future<GraphicsPipelineState>
+    ///   Return a future that could be used to poll or wait for the graphics pipeline state. @p RenderAPIException is rethrown by @p std::future::get() if failed to create the graphics pipeline state.
+    YAGE_NODISCARD YAGE_API static auto CreateAsync(YaGE::RootSignature                      &rootSignature,
+                                                    const D3D12_GRAPHICS_PIPELINE_STATE_DESC &desc)
+        -> std::future<GraphicsPipelineState>;
+
+#ifdef __ID3D12GraphicsCommandList6_INTERFACE_DEFINED__
+    /// @brief
+    ///   Create a mesh shader graphics pipeline state object asynchronously on worker threads of @p ThreadPool::Singleton().
+    /// @remarks
+    ///   Shader bytecode is deep copied so that the caller could release them once this method returns. The root signature must be kept alive until the pipeline state is created.
+    ///
+    /// @param[in] rootSignature    Root signature of the graphics pipeline state.
+    /// @param[in] desc             Mesh shader pipeline state description.
+    ///
+    /// @return std::future<GraphicsPipelineState>
+    ///   Return a future that could be used to poll or wait for the graphics pipeline state. @p RenderAPIException is rethrown by @p std::future::get() if failed to create the graphics pipeline state.
+    YAGE_NODISCARD YAGE_API static auto CreateAsync(YaGE::RootSignature         &rootSignature,
+                                                    const MeshPipelineStateDesc &desc)
+        -> std::future<GraphicsPipelineState>;
+#endif
+
     /// @brief
     ///   Get number of render targets in this graphics pipeline state.
     ///
@@ -152,4 +248,62 @@ private:
     uint32_t sampleCount;
 };
 
+class ComputePipelineState : public PipelineState {
+public:
+    /// @brief
+    ///   Create a compute pipeline state object.
+    /// @remarks
+    ///   The D3D12 pipeline state object is created with @p PipelineCache::Singleton(). Compute pipeline states with the same description share the same D3D12 pipeline state object.
+    ///
+    /// @param[in] rootSignature    Root signature of this compute pipeline state.
+    /// @param[in] desc             D3D12 compute pipeline state description.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to create compute pipeline state object.
+    YAGE_API ComputePipelineState(YaGE::RootSignature &rootSignature, const D3D12_COMPUTE_PIPELINE_STATE_DESC &desc);
+
+    /// @brief
+    ///   Create a compute pipeline state object from compute shader bytecode, for example bytecode from @p ShaderLibrary.
+    ///
+    /// @param[in] rootSignature    Root signature of this compute pipeline state.
+    /// @param[in] computeShader    Bytecode of the compute shader.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to create compute pipeline state object.
+    YAGE_API ComputePipelineState(YaGE::RootSignature &rootSignature, const D3D12_SHADER_BYTECODE &computeShader);
+
+    /// @brief
+    ///   Move constructor of compute pipeline state object.
+    ///
+    /// @param other    The compute pipeline state object to moved. The moved compute pipeline state object will be invalidated.
+    ComputePipelineState(ComputePipelineState &&other) noexcept = default;
+
+    /// @brief
+    ///   Move assignment of compute pipeline state object.
+    ///
+    /// @param other    The compute pipeline state object to moved. The moved compute pipeline state object will be invalidated.
+    ///
+    /// @return ComputePipelineState &
+    ///   Return reference to this compute pipeline state object.
+    auto operator=(ComputePipelineState &&other) noexcept -> ComputePipelineState & = default;
+
+    /// @brief
+    ///   Destroy this compute pipeline state object.
+    YAGE_API ~ComputePipelineState() noexcept override;
+
+    /// @brief
+    ///   Create a compute pipeline state object asynchronously on worker threads of @p ThreadPool::Singleton().
+    /// @remarks
+    ///   The description is deep copied, including shader bytecode, so that the caller could release them once this method returns. The root signature must be kept alive until the pipeline state is created.
+    ///
+    /// @param[in] rootSignature    Root signature of the compute pipeline state.
+    /// @param[in] desc             D3D12 compute pipeline state description.
+    ///
+    /// @return std::future<ComputePipelineState>
+    ///   Return a future that could be used to poll or wait for the compute pipeline state. @p RenderAPIException is rethrown by @p std::future::get() if failed to create the compute pipeline state.
+    YAGE_NODISCARD YAGE_API static auto CreateAsync(YaGE::RootSignature                     &rootSignature,
+                                                    const D3D12_COMPUTE_PIPELINE_STATE_DESC &desc)
+        -> std::future<ComputePipelineState>;
+};
+
 } // namespace YaGE
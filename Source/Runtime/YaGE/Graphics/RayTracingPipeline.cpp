@@ -0,0 +1,61 @@
+#include "RayTracingPipeline.h"
+#include "../Core/Exception.h"
+#include "../Core/String.h"
+#include "RenderDevice.h"
+
+#include <cstring>
+
+using namespace YaGE;
+using Microsoft::WRL::ComPtr;
+
+YaGE::RayTracingPipelineState::RayTracingPipelineState(YaGE::RootSignature           &rootSignature,
+                                                       const D3D12_STATE_OBJECT_DESC &desc)
+    : rootSignature(&rootSignature), stateObject(), properties() {
+    // State objects could only be created with ID3D12Device5.
+    ComPtr<ID3D12Device5> device5;
+
+    HRESULT hr = RenderDevice::Singleton().Device()->QueryInterface(IID_PPV_ARGS(device5.GetAddressOf()));
+    if (FAILED(hr))
+        throw RenderAPIException(hr, u"Ray tracing is not supported.");
+
+    hr = device5->CreateStateObject(&desc, IID_PPV_ARGS(stateObject.GetAddressOf()));
+    if (FAILED(hr))
+        throw RenderAPIException(hr, u"Failed to create ray tracing state object.");
+
+    hr = stateObject.As(&properties);
+    if (FAILED(hr))
+        throw RenderAPIException(hr, u"Failed to query ray tracing state object properties.");
+}
+
+YaGE::RayTracingPipelineState::~RayTracingPipelineState() noexcept {}
+
+YAGE_NODISCARD auto YaGE::RayTracingPipelineState::ShaderIdentifier(StringView exportName) const noexcept
+    -> const void * {
+    if (exportName.IsNullTerminated())
+        return properties->GetShaderIdentifier(reinterpret_cast<LPCWSTR>(exportName.Data()));
+
+    String tempName(exportName);
+    return properties->GetShaderIdentifier(reinterpret_cast<LPCWSTR>(tempName.Data()));
+}
+
+YaGE::ShaderTable::ShaderTable(uint32_t localRootArgumentSize) noexcept
+    : recordStride((D3D12_SHADER_IDENTIFIER_SIZE_IN_BYTES + localRootArgumentSize +
+                    D3D12_RAYTRACING_SHADER_RECORD_BYTE_ALIGNMENT - 1) &
+                   ~uint32_t(D3D12_RAYTRACING_SHADER_RECORD_BYTE_ALIGNMENT - 1)),
+      records() {}
+
+YaGE::ShaderTable::~ShaderTable() noexcept {}
+
+auto YaGE::ShaderTable::AddRecord(const void *shaderIdentifier, const void *localRootArguments, size_t size)
+    -> uint32_t {
+    const uint32_t index  = RecordCount();
+    const size_t   offset = records.size();
+
+    // Unused bytes of the record are zero-filled.
+    records.resize(offset + recordStride);
+    memcpy(records.data() + offset, shaderIdentifier, D3D12_SHADER_IDENTIFIER_SIZE_IN_BYTES);
+    if (size != 0)
+        memcpy(records.data() + offset + D3D12_SHADER_IDENTIFIER_SIZE_IN_BYTES, localRootArguments, size);
+
+    return index;
+}
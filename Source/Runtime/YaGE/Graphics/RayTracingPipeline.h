@@ -0,0 +1,151 @@
+#pragma once
+
+#include "../Core/StringView.h"
+#include "RootSignature.h"
+
+#include <vector>
+
+namespace YaGE {
+
+class RayTracingPipelineState {
+public:
+    /// @brief
+    ///   Create a ray tracing pipeline state object.
+    /// @remarks
+    ///   Ray tracing state objects are not cached by @p PipelineCache because D3D12 pipeline libraries could not store state objects. Create ray tracing pipeline states once at load time.
+    ///
+    /// @param[in] rootSignature    Global root signature of this pipeline state. @p desc must contain a global root signature subobject that refers to this root signature.
+    /// @param[in] desc             D3D12 state object description. Type must be @p D3D12_STATE_OBJECT_TYPE_RAYTRACING_PIPELINE.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if ray tracing is not supported or failed to create the state object.
+    YAGE_API RayTracingPipelineState(YaGE::RootSignature &rootSignature, const D3D12_STATE_OBJECT_DESC &desc);
+
+    /// @brief
+    ///   Copy constructor is disabled.
+    RayTracingPipelineState(const RayTracingPipelineState &) = delete;
+
+    /// @brief
+    ///   Copy assignment is disabled.
+    auto operator=(const RayTracingPipelineState &) = delete;
+
+    /// @brief
+    ///   Move constructor of ray tracing pipeline state object.
+    ///
+    /// @param other    The ray tracing pipeline state object to moved. The moved ray tracing pipeline state object will be invalidated.
+    RayTracingPipelineState(RayTracingPipelineState &&other) noexcept = default;
+
+    /// @brief
+    ///   Move assignment of ray tracing pipeline state object.
+    ///
+    /// @param other    The ray tracing pipeline state object to moved. The moved ray tracing pipeline state object will be invalidated.
+    ///
+    /// @return RayTracingPipelineState &
+    ///   Return reference to this ray tracing pipeline state object.
+    auto operator=(RayTracingPipelineState &&other) noexcept -> RayTracingPipelineState & = default;
+
+    /// @brief
+    ///   Destroy this ray tracing pipeline state object.
+    YAGE_API ~RayTracingPipelineState() noexcept;
+
+    /// @brief
+    ///   Get global root signature of this pipeline state.
+    ///
+    /// @return RootSignature &
+    ///   Return reference to global root signature of this pipeline state.
+    YAGE_NODISCARD auto RootSignature() const noexcept -> YaGE::RootSignature & { return *rootSignature; }
+
+    /// @brief
+    ///   Get D3D12 state object.
+    ///
+    /// @return ID3D12StateObject *
+    ///   Return D3D12 state object.
+    YAGE_NODISCARD auto D3D12StateObject() const noexcept -> ID3D12StateObject * { return stateObject.Get(); }
+
+    /// @brief
+    ///   Get shader identifier of the specified export.
+    ///
+    /// @param exportName   Name of a ray generation shader, miss shader, hit group or callable shader export.
+    ///
+    /// @return const void *
+    ///   Return pointer to the @p D3D12_SHADER_IDENTIFIER_SIZE_IN_BYTES bytes shader identifier. Return nullptr if the export does not exist.
+    YAGE_NODISCARD YAGE_API auto ShaderIdentifier(StringView exportName) const noexcept -> const void *;
+
+private:
+    /// @brief  Global root signature of this pipeline state. This pointer should never be nullptr for valid pipeline state.
+    YaGE::RootSignature *rootSignature;
+
+    /// @brief  D3D12 ray tracing state object.
+    Microsoft::WRL::ComPtr<ID3D12StateObject> stateObject;
+
+    /// @brief  Properties of the state object that are used to query shader identifiers.
+    Microsoft::WRL::ComPtr<ID3D12StateObjectProperties> properties;
+};
+
+class ShaderTable {
+public:
+    /// @brief
+    ///   Create an empty shader table.
+    ///
+    /// @param localRootArgumentSize    Maximum size in byte of local root arguments of each record. Pass 0 if no local root signature is used.
+    YAGE_API explicit ShaderTable(uint32_t localRootArgumentSize = 0) noexcept;
+
+    /// @brief
+    ///   Destroy this shader table.
+    YAGE_API ~ShaderTable() noexcept;
+
+    /// @brief
+    ///   Append a shader record to this shader table.
+    ///
+    /// @param[in] shaderIdentifier     Shader identifier that is returned by @p RayTracingPipelineState::ShaderIdentifier().
+    /// @param[in] localRootArguments   Local root arguments of this record. Could be nullptr if @p size is 0.
+    /// @param     size                 Size in byte of @p localRootArguments. Must not be greater than local root argument size of this shader table.
+    ///
+    /// @return uint32_t
+    ///   Return index of the appended record.
+    YAGE_API auto AddRecord(const void *shaderIdentifier, const void *localRootArguments = nullptr, size_t size = 0)
+        -> uint32_t;
+
+    /// @brief
+    ///   Remove all records in this shader table.
+    auto Clear() noexcept -> void { records.clear(); }
+
+    /// @brief
+    ///   Get number of records in this shader table.
+    ///
+    /// @return uint32_t
+    ///   Return number of records in this shader table.
+    YAGE_NODISCARD auto RecordCount() const noexcept -> uint32_t {
+        return static_cast<uint32_t>(records.size() / recordStride);
+    }
+
+    /// @brief
+    ///   Get stride in byte between two adjacent records. Stride is aligned up with @p D3D12_RAYTRACING_SHADER_RECORD_BYTE_ALIGNMENT.
+    ///
+    /// @return uint32_t
+    ///   Return stride in byte of each record.
+    YAGE_NODISCARD auto RecordStride() const noexcept -> uint32_t { return recordStride; }
+
+    /// @brief
+    ///   Get size in byte of this shader table.
+    ///
+    /// @return size_t
+    ///   Return size in byte of all records.
+    YAGE_NODISCARD auto Size() const noexcept -> size_t { return records.size(); }
+
+    /// @brief
+    ///   Get CPU pointer to the first record of this shader table.
+    ///
+    /// @return const void *
+    ///   Return CPU pointer to the first record.
+    YAGE_NODISCARD auto Data() const noexcept -> const void * { return records.data(); }
+
+private:
+    /// @brief  Stride in byte between two adjacent records.
+    uint32_t recordStride;
+
+    /// @brief  Packed shader records.
+    std::vector<uint8_t> records;
+};
+
+} // namespace YaGE
@@ -0,0 +1,52 @@
+#include "ReadbackBuffer.h"
+#include "../Core/Exception.h"
+#include "PixelBuffer.h"
+#include "RenderDevice.h"
+
+using namespace YaGE;
+
+YaGE::ReadbackBuffer::ReadbackBuffer(size_t size)
+    : GpuBuffer(size, D3D12_HEAP_TYPE_READBACK, D3D12_RESOURCE_FLAG_NONE, D3D12_RESOURCE_STATE_COPY_DEST),
+      mappedData(),
+      syncPoint() {
+    // Readback buffers are persistently mapped. GPU never reads from them.
+    void   *data = nullptr;
+    HRESULT hr   = resource->Map(0, nullptr, &data);
+    if (FAILED(hr))
+        throw RenderAPIException(hr, u"Failed to map readback buffer.");
+
+    mappedData = static_cast<const uint8_t *>(data);
+}
+
+YaGE::ReadbackBuffer::~ReadbackBuffer() noexcept {
+    if (mappedData != nullptr) {
+        const D3D12_RANGE writeRange{0, 0};
+        resource->Unmap(0, &writeRange);
+    }
+}
+
+auto YaGE::ReadbackBuffer::IsReady() const noexcept -> bool {
+    if (syncPoint == PENDING_SYNC_POINT)
+        return false;
+    return RenderDevice::Singleton().IsSyncPointReached(syncPoint);
+}
+
+auto YaGE::ReadbackBuffer::Wait() const noexcept -> bool {
+    if (syncPoint == PENDING_SYNC_POINT)
+        return false;
+
+    RenderDevice &renderDevice = RenderDevice::Singleton();
+    if (!renderDevice.IsSyncPointReached(syncPoint))
+        renderDevice.Sync(syncPoint);
+
+    return true;
+}
+
+auto YaGE::ReadbackBuffer::SubresourceSize(const PixelBuffer &buffer, uint32_t subresource) noexcept -> size_t {
+    const D3D12_RESOURCE_DESC desc = buffer.resource->GetDesc();
+
+    UINT64 size = 0;
+    RenderDevice::Singleton().Device()->GetCopyableFootprints(&desc, subresource, 1, 0, nullptr, nullptr, nullptr,
+                                                              &size);
+    return static_cast<size_t>(size);
+}
@@ -0,0 +1,170 @@
+#pragma once
+
+#include "GpuBuffer.h"
+
+namespace YaGE {
+
+class PixelBuffer;
+
+class ReadbackBuffer : public GpuBuffer {
+public:
+    /// @brief
+    ///   Create a persistently mapped buffer in readback heap. Readback buffers are always in copy destination state and could only be written via @p CommandBuffer::CopyToReadback() and @p CommandBuffer::ResolveQueryData().
+    ///
+    /// @param size     Expected buffer size in byte of this readback buffer. The actual buffer size might be greater than the given size.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to create or map D3D12 resource for this readback buffer.
+    YAGE_API explicit ReadbackBuffer(size_t size);
+
+    /// @brief
+    ///   Copy constructor is disabled.
+    ReadbackBuffer(const ReadbackBuffer &) = delete;
+
+    /// @brief
+    ///   Copy assignment is disabled.
+    auto operator=(const ReadbackBuffer &) = delete;
+
+    /// @brief
+    ///   Destroy this readback buffer. The buffer must not be used by GPU when destroyed.
+    YAGE_API ~ReadbackBuffer() noexcept override;
+
+    /// @brief
+    ///   Checks if the last submission that copies data to this readback buffer has been finished by GPU. This method never blocks.
+    ///
+    /// @return bool
+    /// @retval true    Data of this readback buffer is available for CPU.
+    /// @retval false   The copy commands have not been submitted or are still being executed by GPU.
+    YAGE_NODISCARD YAGE_API auto IsReady() const noexcept -> bool;
+
+    /// @brief
+    ///   Get sync point of the last submission that copies data to this readback buffer.
+    ///
+    /// @return uint64_t
+    ///   Return sync point of the last submission. Return @p PENDING_SYNC_POINT if the copy commands have not been submitted yet.
+    YAGE_NODISCARD auto SyncPoint() const noexcept -> uint64_t { return syncPoint; }
+
+    /// @brief
+    ///   Get CPU pointer to start of this readback buffer. Content of this buffer is only valid if @p IsReady() returns true.
+    ///
+    /// @return const void *
+    ///   Return CPU pointer to start of this readback buffer.
+    YAGE_NODISCARD auto Data() const noexcept -> const void * { return mappedData; }
+
+    /// @brief
+    ///   Block current thread until data of this readback buffer is available. Prefer polling @p IsReady() once per frame to avoid stalling CPU.
+    ///
+    /// @return bool
+    /// @retval true    Data of this readback buffer is available for CPU.
+    /// @retval false   The copy commands have not been submitted yet, so there is nothing to wait for.
+    YAGE_API auto Wait() const noexcept -> bool;
+
+    /// @brief
+    ///   Get size in byte of the readback buffer region that is required to copy the specified subresource.
+    ///
+    /// @param[in] buffer       The pixel buffer to be read back.
+    /// @param     subresource  Index of the subresource to be read back.
+    ///
+    /// @return size_t
+    ///   Return size in byte of the placed footprint of the subresource.
+    YAGE_NODISCARD YAGE_API static auto SubresourceSize(const PixelBuffer &buffer, uint32_t subresource) noexcept
+        -> size_t;
+
+    /// @brief  Sync point of readback buffers whose copy commands are recorded but not submitted yet.
+    static constexpr const uint64_t PENDING_SYNC_POINT = UINT64_MAX;
+
+    friend class CommandBuffer;
+
+private:
+    /// @brief  CPU pointer to start of the mapped buffer.
+    const uint8_t *mappedData;
+
+    /// @brief  Sync point of the last submission that copies data to this buffer.
+    uint64_t syncPoint;
+};
+
+class ReadbackHandle {
+public:
+    /// @brief
+    ///   Create an empty readback handle. Empty readback handles are never ready.
+    ReadbackHandle() noexcept : buffer(), offset(), size(), rowPitch(), rowCount() {}
+
+    /// @brief
+    ///   Create a readback handle that refers to a region of readback buffer.
+    ///
+    /// @param[in] readbackBuffer   The readback buffer that the data is copied to.
+    /// @param     byteOffset       Offset in byte from start of @p readbackBuffer to start of the data.
+    /// @param     byteSize         Size in byte of the data.
+    /// @param     pitch            Row pitch in byte of the data.
+    /// @param     rows             Number of rows of the data.
+    ReadbackHandle(ReadbackBuffer &readbackBuffer,
+                   size_t          byteOffset,
+                   size_t          byteSize,
+                   uint32_t        pitch,
+                   uint32_t        rows) noexcept
+        : buffer(&readbackBuffer), offset(byteOffset), size(byteSize), rowPitch(pitch), rowCount(rows) {}
+
+    /// @brief
+    ///   Checks if this readback handle refers to a readback buffer region.
+    ///
+    /// @return bool
+    /// @retval true    This readback handle is not empty.
+    /// @retval false   This readback handle is empty.
+    YAGE_NODISCARD auto IsValid() const noexcept -> bool { return buffer != nullptr; }
+
+    /// @brief
+    ///   Checks if data of this readback handle is available for CPU. This method never blocks.
+    ///
+    /// @return bool
+    /// @retval true    Data of this readback handle is available.
+    /// @retval false   This readback handle is empty or the data is still being copied by GPU.
+    YAGE_NODISCARD auto IsReady() const noexcept -> bool { return buffer != nullptr && buffer->IsReady(); }
+
+    /// @brief
+    ///   Get CPU pointer to start of the data. The data is only valid if @p IsReady() returns true.
+    ///
+    /// @return const void *
+    ///   Return CPU pointer to start of the data.
+    YAGE_NODISCARD auto Data() const noexcept -> const void * {
+        return static_cast<const uint8_t *>(buffer->Data()) + offset;
+    }
+
+    /// @brief
+    ///   Get size in byte of the data.
+    ///
+    /// @return size_t
+    ///   Return size in byte of the data.
+    YAGE_NODISCARD auto Size() const noexcept -> size_t { return size; }
+
+    /// @brief
+    ///   Get row pitch in byte of the data. Row pitch of buffer data is the same as its size.
+    ///
+    /// @return uint32_t
+    ///   Return row pitch in byte of the data.
+    YAGE_NODISCARD auto RowPitch() const noexcept -> uint32_t { return rowPitch; }
+
+    /// @brief
+    ///   Get number of rows of the data, including rows of all depth slices. Buffer data always has a single row.
+    ///
+    /// @return uint32_t
+    ///   Return number of rows of the data.
+    YAGE_NODISCARD auto RowCount() const noexcept -> uint32_t { return rowCount; }
+
+private:
+    /// @brief  The readback buffer that the data is copied to.
+    ReadbackBuffer *buffer;
+
+    /// @brief  Offset in byte from start of the readback buffer to start of the data.
+    size_t offset;
+
+    /// @brief  Size in byte of the data.
+    size_t size;
+
+    /// @brief  Row pitch in byte of the data.
+    uint32_t rowPitch;
+
+    /// @brief  Number of rows of the data.
+    uint32_t rowCount;
+};
+
+} // namespace YaGE
@@ -1,5 +1,11 @@
 #include "RenderDevice.h"
 #include "../Core/Exception.h"
+#include "../Core/Profiler.h"
+#include "CommandBuffer.h"
+#include "GpuResource.h"
+
+#include <algorithm>
+#include <cassert>
 
 using namespace YaGE;
 
@@ -13,17 +19,23 @@ YaGE::RenderDevice::RenderDevice()
     : dxgiFactory(),
       adapter(),
       device(),
-      commandQueue(),
-      fence(),
-      nextFenceValue(1),
-      allocatorPool(),
-      allocatorPoolMutex(),
-      freeAllocatorQueue(),
-      freeAllocatorQueueMutex(),
+      queues(),
+      gpuMemoryAllocator(),
       constantBufferViewAllocator(),
       samplerViewAllocator(),
       renderTargetViewAllocator(),
-      depthStencilViewAllocator() {
+      depthStencilViewAllocator(),
+      retiredObjectPool(),
+      retiredObjects(PoolAllocator<RetiredObjectBatch>(retiredObjectPool)),
+      deferredObjectMutex(),
+      callbackMutex(),
+      callbackWakeEvent(),
+      callbackFenceEvent(),
+      budgetChangeEvent(),
+      budgetChangeCookie(),
+      budgetCallbacks(),
+      isCallbackThreadExiting(),
+      callbackThread() {
     HRESULT hr = S_OK;
 
 #if defined(_DEBUG) || !defined(NDEBUG)
@@ -59,23 +71,32 @@ YaGE::RenderDevice::RenderDevice()
     if (device == nullptr)
         throw RenderAPIException(hr, u"No suitable GPU found.");
 
-    { // Create CommandQueue.
+    // Create command queues and fences.
+    queues[DIRECT_QUEUE_INDEX].type  = D3D12_COMMAND_LIST_TYPE_DIRECT;
+    queues[COPY_QUEUE_INDEX].type    = D3D12_COMMAND_LIST_TYPE_COPY;
+    queues[COMPUTE_QUEUE_INDEX].type = D3D12_COMMAND_LIST_TYPE_COMPUTE;
+
+    for (auto &context : queues) {
         const D3D12_COMMAND_QUEUE_DESC desc{
-            /* Type     = */ D3D12_COMMAND_LIST_TYPE_DIRECT,
+            /* Type     = */ context.type,
             /* Priority = */ D3D12_COMMAND_QUEUE_PRIORITY_NORMAL,
             /* Flags    = */ D3D12_COMMAND_QUEUE_FLAG_NONE,
             /* NodeMask = */ 0,
         };
 
-        hr = device->CreateCommandQueue(&desc, IID_PPV_ARGS(commandQueue.GetAddressOf()));
+        hr = device->CreateCommandQueue(&desc, IID_PPV_ARGS(context.queue.GetAddressOf()));
         if (FAILED(hr))
             throw RenderAPIException(hr, u"Failed to create command queue.");
+
+        hr = device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(context.fence.GetAddressOf()));
+        if (FAILED(hr))
+            throw RenderAPIException(hr, u"Failed to create fence.");
+
+        context.nextFenceValue.store(1, std::memory_order_relaxed);
     }
 
-    // Create fence.
-    hr = device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(fence.GetAddressOf()));
-    if (FAILED(hr))
-        throw RenderAPIException(hr, u"Failed to create fence.");
+    // Initialize GPU memory allocator.
+    gpuMemoryAllocator.Initialize(device.Get());
 
     // Initialize descriptor allocators.
     constantBufferViewAllocator.Initialize(device.Get(), D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
@@ -84,12 +105,49 @@ YaGE::RenderDevice::RenderDevice()
     depthStencilViewAllocator.Initialize(device.Get(), D3D12_DESCRIPTOR_HEAP_TYPE_DSV);
 }
 
-YaGE::RenderDevice::~RenderDevice() noexcept { Sync(); }
+YaGE::RenderDevice::~RenderDevice() noexcept {
+    Sync();
+
+    // All sync points have been reached. Release all deferred objects before GPU memory allocator is destroyed. The
+    // callback thread may be reclaiming objects at the same time.
+    { // Lock scope.
+        std::lock_guard<std::mutex> lock(deferredObjectMutex);
+        for (auto &batch : retiredObjects) {
+            for (auto &object : batch.objects)
+                FreeDeferredObject(object);
+        }
+
+        retiredObjects.clear();
+    }
+
+    // All sync points have been reached, so that the callback thread invokes all pending callbacks before exiting.
+    if (callbackThread.joinable()) {
+        { // Lock scope.
+            std::lock_guard<std::mutex> lock(callbackMutex);
+            isCallbackThreadExiting = true;
+        }
+
+        SetEvent(callbackWakeEvent);
+        callbackThread.join();
+    }
+
+    if (budgetChangeEvent != nullptr) {
+        adapter->UnregisterVideoMemoryBudgetChangeNotification(budgetChangeCookie);
+        CloseHandle(budgetChangeEvent);
+    }
+
+    if (callbackWakeEvent != nullptr)
+        CloseHandle(callbackWakeEvent);
+    if (callbackFenceEvent != nullptr)
+        CloseHandle(callbackFenceEvent);
+}
 
 auto YaGE::RenderDevice::Sync(uint64_t syncPoint) const noexcept -> void {
     if (IsSyncPointReached(syncPoint))
         return;
 
+    YAGE_PROFILE_SCOPE(DeviceSync);
+
     struct FenceEvent {
         HANDLE handle;
 
@@ -99,21 +157,422 @@ auto YaGE::RenderDevice::Sync(uint64_t syncPoint) const noexcept -> void {
 
     static thread_local FenceEvent fenceEvent;
 
-    const HANDLE event = fenceEvent.handle;
-    fence->SetEventOnCompletion(syncPoint, event);
+    const auto  &context = queues[SyncPointQueueIndex(syncPoint)];
+    const HANDLE event   = fenceEvent.handle;
+    context.fence->SetEventOnCompletion(SyncPointValue(syncPoint), event);
     WaitForSingleObject(event, INFINITE);
 }
 
-YAGE_NODISCARD auto YaGE::RenderDevice::AcquireCommandAllocator() -> ID3D12CommandAllocator * {
+auto YaGE::RenderDevice::OnSyncPointReached(uint64_t syncPoint, std::function<void()> &&callback) -> void {
+    if (IsSyncPointReached(syncPoint)) {
+        callback();
+        return;
+    }
+
+    { // Lock scope.
+        std::lock_guard<std::mutex> lock(callbackMutex);
+        StartCallbackThread();
+
+        auto &context = queues[SyncPointQueueIndex(syncPoint)];
+        context.callbacks.emplace(SyncPointValue(syncPoint), std::move(callback));
+    }
+
+    SetEvent(callbackWakeEvent);
+}
+
+auto YaGE::RenderDevice::StartCallbackThread() -> void {
+    if (callbackThread.joinable())
+        return;
+
+    if (callbackWakeEvent == nullptr)
+        callbackWakeEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+    if (callbackFenceEvent == nullptr)
+        callbackFenceEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+    if (callbackWakeEvent == nullptr || callbackFenceEvent == nullptr)
+        throw RenderAPIException(HRESULT_FROM_WIN32(GetLastError()), u"Failed to create callback event.");
+
+    callbackThread = std::thread(&RenderDevice::CallbackThreadMain, this);
+}
+
+auto YaGE::RenderDevice::CallbackThreadMain() noexcept -> void {
+    std::vector<std::function<void()>> readyCallbacks;
+
+    for (;;) {
+        ID3D12Fence *fences[QUEUE_COUNT];
+        UINT64       fenceValues[QUEUE_COUNT];
+        UINT         fenceCount = 0;
+        HANDLE       budgetEvent;
+        bool         isExiting;
+
+        { // Lock scope.
+            std::lock_guard<std::mutex> lock(callbackMutex);
+
+            // Budget change event is auto-reset, so it is consumed by this check.
+            budgetEvent = budgetChangeEvent;
+            if (budgetEvent != nullptr && WaitForSingleObject(budgetEvent, 0) == WAIT_OBJECT_0)
+                readyCallbacks.insert(readyCallbacks.end(), budgetCallbacks.begin(), budgetCallbacks.end());
+            for (auto &context : queues) {
+                const uint64_t completedValue = context.fence->GetCompletedValue();
+
+                auto end = context.callbacks.upper_bound(completedValue);
+                for (auto i = context.callbacks.begin(); i != end; ++i)
+                    readyCallbacks.push_back(std::move(i->second));
+                context.callbacks.erase(context.callbacks.begin(), end);
+
+                // Wait for the smallest pending fence value of this queue.
+                if (!context.callbacks.empty()) {
+                    fences[fenceCount]      = context.fence.Get();
+                    fenceValues[fenceCount] = context.callbacks.begin()->first;
+                    ++fenceCount;
+                }
+            }
+
+            isExiting = isCallbackThreadExiting;
+        }
+
+        // Invoke callbacks without holding the lock, so that callbacks could register new callbacks.
+        for (auto &callback : readyCallbacks)
+            callback();
+        readyCallbacks.clear();
+
+        if (isExiting)
+            break;
+
+        HANDLE events[3];
+        DWORD  eventCount = 0;
+
+        events[eventCount++] = callbackWakeEvent;
+        if (budgetEvent != nullptr)
+            events[eventCount++] = budgetEvent;
+
+        if (fenceCount != 0) {
+            device->SetEventOnMultipleFenceCompletion(fences, fenceValues, fenceCount,
+                                                      D3D12_MULTIPLE_FENCE_WAIT_FLAG_ANY, callbackFenceEvent);
+            events[eventCount++] = callbackFenceEvent;
+        }
+
+        // Signaled budget change event is consumed by the wait, so it is checked again with the returned index.
+        const DWORD result = WaitForMultipleObjects(eventCount, events, FALSE, INFINITE);
+        if (budgetEvent != nullptr && result == WAIT_OBJECT_0 + 1)
+            SetEvent(budgetEvent);
+    }
+}
+
+auto YaGE::RenderDevice::Sync() const noexcept -> void {
+    for (const auto &context : queues)
+        Sync(AcquireSyncPoint(context.type));
+}
+
+auto YaGE::RenderDevice::Submit(uint32_t count, CommandBuffer *const *commandBuffers) -> uint64_t {
+    if (count == 0)
+        return 0;
+
+    YAGE_PROFILE_SCOPE(CommandBufferSubmit);
+
+    const D3D12_COMMAND_LIST_TYPE type       = commandBuffers[0]->commandListType;
+    const uint32_t                queueIndex = QueueIndex(type);
+    auto                         &context    = queues[queueIndex];
+
+    // Command list array is scratch memory of current thread.
+    LinearArena        &arena = FrameArena();
+    ArenaScope          scope(arena);
+    ID3D12CommandList **lists = arena.AllocateArray<ID3D12CommandList *>(count);
+
+    for (uint32_t i = 0; i < count; ++i) {
+        // Command buffers must be fully recorded: not inside a render graph pass and not submitted twice in a batch.
+        assert(commandBuffers[i]->commandListType == type);
+        assert(commandBuffers[i]->stateTracking && commandBuffers[i]->declaredResources == nullptr);
+        assert(std::find(commandBuffers, commandBuffers + i, commandBuffers[i]) == commandBuffers + i);
+
+        commandBuffers[i]->FlushResourceBarriers();
+        commandBuffers[i]->commandList->Close();
+        lists[i] = commandBuffers[i]->commandList.Get();
+    }
+
+    uint64_t syncPoint = 0;
+    { // Lock scope.
+        std::lock_guard<std::mutex> lock(context.submitMutex);
+
+        // Wait for other command queues on GPU side.
+        for (uint32_t i = 0; i < count; ++i) {
+            for (const uint64_t waitSyncPoint : commandBuffers[i]->pendingWaitSyncPoints)
+                WaitForSyncPoint(type, waitSyncPoint);
+        }
+
+        context.queue->ExecuteCommandLists(count, lists);
+
+        const uint64_t value = context.nextFenceValue.fetch_add(1, std::memory_order_relaxed);
+        context.queue->Signal(context.fence.Get(), value);
+        syncPoint = MakeSyncPoint(queueIndex, value);
+    }
+
+    for (uint32_t i = 0; i < count; ++i)
+        commandBuffers[i]->FinishSubmit(syncPoint);
+
+    ReleaseDeferredObjects();
+    return syncPoint;
+}
+
+auto YaGE::RenderDevice::DeferRelease(Microsoft::WRL::ComPtr<ID3D12Pageable> &&object,
+                                      const GpuMemoryAllocation             &allocation) noexcept -> void {
+    if (object == nullptr && allocation.block == nullptr)
+        return;
+
+    RetireDeferredObject(DeferredObject{
+        /* object              = */ std::move(object),
+        /* allocation          = */ allocation,
+        /* descriptorAllocator = */ nullptr,
+        /* descriptor          = */ CpuDescriptorHandle(),
+    });
+}
+
+auto YaGE::RenderDevice::DeferFreeDescriptor(D3D12_DESCRIPTOR_HEAP_TYPE type, CpuDescriptorHandle handle) noexcept
+    -> void {
+    if (handle.IsNull())
+        return;
+
+    CpuDescriptorAllocator *allocator = nullptr;
+    switch (type) {
+    case D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV:
+        allocator = &constantBufferViewAllocator;
+        break;
+    case D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER:
+        allocator = &samplerViewAllocator;
+        break;
+    case D3D12_DESCRIPTOR_HEAP_TYPE_RTV:
+        allocator = &renderTargetViewAllocator;
+        break;
+    case D3D12_DESCRIPTOR_HEAP_TYPE_DSV:
+        allocator = &depthStencilViewAllocator;
+        break;
+    default:
+        assert(false && "Invalid descriptor heap type.");
+        return;
+    }
+
+    RetireDeferredObject(DeferredObject{
+        /* object              = */ nullptr,
+        /* allocation          = */ GpuMemoryAllocation{},
+        /* descriptorAllocator = */ allocator,
+        /* descriptor          = */ handle,
+    });
+}
+
+auto YaGE::RenderDevice::ReleaseDeferredObjects() noexcept -> void {
+    LinearArena &arena = FrameArena();
+    ArenaScope   scope(arena);
+
+    std::vector<DeferredObject, ArenaAllocator<DeferredObject>> reachedObjects{ArenaAllocator<DeferredObject>(arena)};
+
+    { // Lock scope.
+        std::lock_guard<std::mutex> lock(deferredObjectMutex);
+
+        // Sync points of retired batches are non-decreasing, so that only the front batches need to be checked.
+        while (!retiredObjects.empty()) {
+            RetiredObjectBatch &batch = retiredObjects.front();
+
+            bool reached = true;
+            for (const uint64_t syncPoint : batch.syncPoints)
+                reached = reached && IsSyncPointReached(syncPoint);
+
+            if (!reached)
+                break;
+
+            for (auto &object : batch.objects)
+                reachedObjects.push_back(std::move(object));
+            retiredObjects.pop_front();
+        }
+    }
+
+    // Release objects without holding the lock.
+    for (auto &object : reachedObjects)
+        FreeDeferredObject(object);
+}
+
+auto YaGE::RenderDevice::RetireDeferredObject(DeferredObject &&object) noexcept -> void {
+    uint64_t syncPoints[QUEUE_COUNT];
+    bool     reached  = true;
+    bool     newBatch = false;
+
+    { // Lock scope.
+        std::lock_guard<std::mutex> lock(deferredObjectMutex);
+
+        // Last submitted sync points cover all commands that may use the object. Fence value 0 is always reached, so
+        // that command queues that have never been used do not block the batch. Sync points are taken under the lock
+        // so that retired batches stay in order.
+        for (uint32_t i = 0; i < QUEUE_COUNT; ++i) {
+            syncPoints[i] = LastSubmittedSyncPoint(queues[i].type);
+            reached       = reached && IsSyncPointReached(syncPoints[i]);
+        }
+
+        if (!reached) {
+            if (!retiredObjects.empty() &&
+                std::equal(syncPoints, syncPoints + QUEUE_COUNT, retiredObjects.back().syncPoints)) {
+                retiredObjects.back().objects.push_back(std::move(object));
+            } else {
+                RetiredObjectBatch batch;
+                std::copy(syncPoints, syncPoints + QUEUE_COUNT, batch.syncPoints);
+                batch.objects.push_back(std::move(object));
+
+                retiredObjects.push_back(std::move(batch));
+                newBatch = true;
+            }
+        }
+    }
+
+    // GPU has finished all commands that may use the object.
+    if (reached) {
+        FreeDeferredObject(object);
+        return;
+    }
+
+    if (!newBatch)
+        return;
+
+    // Reclaim the batch once GPU reaches it, even if nothing else is submitted.
+    try {
+        for (const uint64_t syncPoint : syncPoints) {
+            if (!IsSyncPointReached(syncPoint))
+                OnSyncPointReached(syncPoint, [this]() { ReleaseDeferredObjects(); });
+        }
+    } catch (...) {
+        // The batch is still reclaimed by the next submission.
+    }
+}
+
+auto YaGE::RenderDevice::FreeDeferredObject(DeferredObject &object) noexcept -> void {
+    object.object.Reset();
+    if (object.allocation.block != nullptr || object.allocation.size != 0)
+        gpuMemoryAllocator.Free(object.allocation);
+    if (object.descriptorAllocator != nullptr)
+        object.descriptorAllocator->Free(object.descriptor);
+}
+
+auto YaGE::RenderDevice::TotalMemoryUsage() const noexcept -> uint64_t {
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < static_cast<uint32_t>(GpuMemoryCategory::Count); ++i)
+        total += gpuMemoryAllocator.Usage(static_cast<GpuMemoryCategory>(i));
+    return total;
+}
+
+auto YaGE::RenderDevice::QueryMemoryBudget(DXGI_MEMORY_SEGMENT_GROUP group) const noexcept
+    -> DXGI_QUERY_VIDEO_MEMORY_INFO {
+    DXGI_QUERY_VIDEO_MEMORY_INFO info{};
+    if (FAILED(adapter->QueryVideoMemoryInfo(0, group, &info)))
+        info = DXGI_QUERY_VIDEO_MEMORY_INFO{};
+    return info;
+}
+
+auto YaGE::RenderDevice::IsOverBudget() const noexcept -> bool {
+    const DXGI_QUERY_VIDEO_MEMORY_INFO info = QueryMemoryBudget(DXGI_MEMORY_SEGMENT_GROUP_LOCAL);
+    return info.Budget != 0 && info.CurrentUsage > info.Budget;
+}
+
+auto YaGE::RenderDevice::OnMemoryBudgetChanged(std::function<void()> &&callback) -> void {
+    { // Lock scope.
+        std::lock_guard<std::mutex> lock(callbackMutex);
+        StartCallbackThread();
+
+        // Register budget change notification on first use.
+        if (budgetChangeEvent == nullptr) {
+            HANDLE event = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+            if (event == nullptr)
+                throw RenderAPIException(HRESULT_FROM_WIN32(GetLastError()), u"Failed to create budget change event.");
+
+            HRESULT hr = adapter->RegisterVideoMemoryBudgetChangeNotificationEvent(event, &budgetChangeCookie);
+            if (FAILED(hr)) {
+                CloseHandle(event);
+                throw RenderAPIException(hr, u"Failed to register memory budget change notification.");
+            }
+
+            budgetChangeEvent = event;
+        }
+
+        budgetCallbacks.push_back(std::move(callback));
+    }
+
+    // Let the callback thread wait for the budget change event.
+    SetEvent(callbackWakeEvent);
+}
+
+auto YaGE::RenderDevice::MakeResident(uint32_t count, GpuResource *const *resources) noexcept -> HRESULT {
+    LinearArena &arena = FrameArena();
+    ArenaScope   scope(arena);
+
+    ID3D12Pageable **objects     = arena.AllocateArray<ID3D12Pageable *>(count);
+    UINT             objectCount = 0;
+
+    for (uint32_t i = 0; i < count; ++i) {
+        if (resources[i]->isEvicted)
+            objects[objectCount++] = resources[i]->resource.Get();
+    }
+
+    if (objectCount == 0)
+        return S_OK;
+
+    HRESULT hr = device->MakeResident(objectCount, objects);
+    if (FAILED(hr))
+        return hr;
+
+    for (uint32_t i = 0; i < count; ++i)
+        resources[i]->isEvicted = false;
+
+    return S_OK;
+}
+
+auto YaGE::RenderDevice::Evict(uint32_t count, GpuResource *const *resources) noexcept -> HRESULT {
+    LinearArena &arena = FrameArena();
+    ArenaScope   scope(arena);
+
+    ID3D12Pageable **objects     = arena.AllocateArray<ID3D12Pageable *>(count);
+    UINT             objectCount = 0;
+
+    for (uint32_t i = 0; i < count; ++i) {
+        if (resources[i]->IsEvictable() && !resources[i]->isEvicted)
+            objects[objectCount++] = resources[i]->resource.Get();
+    }
+
+    if (objectCount == 0)
+        return S_OK;
+
+    HRESULT hr = device->Evict(objectCount, objects);
+    if (FAILED(hr))
+        return hr;
+
+    for (uint32_t i = 0; i < count; ++i) {
+        if (resources[i]->IsEvictable())
+            resources[i]->isEvicted = true;
+    }
+
+    return S_OK;
+}
+
+auto YaGE::RenderDevice::WaitForSyncPoint(D3D12_COMMAND_LIST_TYPE queueType, uint64_t syncPoint) const noexcept
+    -> void {
+    const uint32_t waitQueueIndex   = QueueIndex(queueType);
+    const uint32_t signalQueueIndex = SyncPointQueueIndex(syncPoint);
+
+    // Commands in the same queue are already executed in order.
+    if (waitQueueIndex == signalQueueIndex || IsSyncPointReached(syncPoint))
+        return;
+
+    const auto &signalContext = queues[signalQueueIndex];
+    queues[waitQueueIndex].queue->Wait(signalContext.fence.Get(), SyncPointValue(syncPoint));
+}
+
+YAGE_NODISCARD auto YaGE::RenderDevice::AcquireCommandAllocator(D3D12_COMMAND_LIST_TYPE type)
+    -> ID3D12CommandAllocator * {
+    auto &context = queues[QueueIndex(type)];
+
     { // Try to get one from free allocator queue.
         ID3D12CommandAllocator *allocator = nullptr;
         { // Lock scope.
-            std::lock_guard<std::mutex> lock(freeAllocatorQueueMutex);
-            if (!freeAllocatorQueue.empty()) {
-                auto &front = freeAllocatorQueue.front();
+            std::lock_guard<std::mutex> lock(context.freeAllocatorQueueMutex);
+            if (!context.freeAllocatorQueue.empty()) {
+                auto &front = context.freeAllocatorQueue.front();
                 if (IsSyncPointReached(front.first)) {
                     allocator = front.second;
-                    freeAllocatorQueue.pop();
+                    context.freeAllocatorQueue.pop();
                 }
             }
         }
@@ -126,21 +585,24 @@ YAGE_NODISCARD auto YaGE::RenderDevice::AcquireCommandAllocator() -> ID3D12Comma
 
     // Try to create a new command allocaator.
     Microsoft::WRL::ComPtr<ID3D12CommandAllocator> allocator;
-    HRESULT hr = device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(allocator.GetAddressOf()));
+    HRESULT hr = device->CreateCommandAllocator(context.type, IID_PPV_ARGS(allocator.GetAddressOf()));
     if (FAILED(hr))
         throw RenderAPIException(hr, u"Failed to create command allocator.");
 
     // Add to allocator pool.
     ID3D12CommandAllocator     *result = allocator.Get();
-    std::lock_guard<std::mutex> lock(allocatorPoolMutex);
-    allocatorPool.push(std::move(allocator));
+    std::lock_guard<std::mutex> lock(context.allocatorPoolMutex);
+    context.allocatorPool.push(std::move(allocator));
 
     return result;
 }
 
-auto YaGE::RenderDevice::FreeCommandAllocator(uint64_t syncPoint, ID3D12CommandAllocator *allocator) noexcept -> void {
-    std::lock_guard<std::mutex> lock(freeAllocatorQueueMutex);
-    freeAllocatorQueue.emplace(syncPoint, allocator);
+auto YaGE::RenderDevice::FreeCommandAllocator(D3D12_COMMAND_LIST_TYPE type,
+                                              uint64_t                syncPoint,
+                                              ID3D12CommandAllocator *allocator) noexcept -> void {
+    auto                       &context = queues[QueueIndex(type)];
+    std::lock_guard<std::mutex> lock(context.freeAllocatorQueueMutex);
+    context.freeAllocatorQueue.emplace(syncPoint, allocator);
 }
 
 YAGE_NODISCARD auto YaGE::RenderDevice::SupportRayTracing() const noexcept -> bool {
@@ -153,6 +615,59 @@ YAGE_NODISCARD auto YaGE::RenderDevice::SupportRayTracing() const noexcept -> bo
     return feature.RaytracingTier != D3D12_RAYTRACING_TIER_NOT_SUPPORTED;
 }
 
+YAGE_NODISCARD auto YaGE::RenderDevice::SupportMeshShaders() const noexcept -> bool {
+#ifdef __ID3D12GraphicsCommandList6_INTERFACE_DEFINED__
+    D3D12_FEATURE_DATA_D3D12_OPTIONS7 feature{};
+
+    HRESULT hr = device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS7, &feature, sizeof(feature));
+    if (FAILED(hr))
+        return false;
+
+    return feature.MeshShaderTier != D3D12_MESH_SHADER_TIER_NOT_SUPPORTED;
+#else
+    return false;
+#endif
+}
+
+YAGE_NODISCARD auto YaGE::RenderDevice::SupportEnhancedBarriers() const noexcept -> bool {
+#ifdef __ID3D12GraphicsCommandList7_INTERFACE_DEFINED__
+    D3D12_FEATURE_DATA_D3D12_OPTIONS12 feature{};
+
+    HRESULT hr = device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS12, &feature, sizeof(feature));
+    if (FAILED(hr))
+        return false;
+
+    return feature.EnhancedBarriersSupported != FALSE;
+#else
+    return false;
+#endif
+}
+
+YAGE_NODISCARD auto YaGE::RenderDevice::SupportTiledResources() const noexcept -> bool {
+    D3D12_FEATURE_DATA_D3D12_OPTIONS feature{};
+
+    HRESULT hr = device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS, &feature, sizeof(feature));
+    if (FAILED(hr))
+        return false;
+
+    return feature.TiledResourcesTier != D3D12_TILED_RESOURCES_TIER_NOT_SUPPORTED;
+}
+
+YAGE_NODISCARD auto YaGE::RenderDevice::SupportGpuUploadHeap() const noexcept -> bool {
+// GPU upload heaps are introduced together with ID3D12GraphicsCommandList10 in D3D12 SDK 1.613.
+#ifdef __ID3D12GraphicsCommandList10_INTERFACE_DEFINED__
+    D3D12_FEATURE_DATA_D3D12_OPTIONS16 feature{};
+
+    HRESULT hr = device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS16, &feature, sizeof(feature));
+    if (FAILED(hr))
+        return false;
+
+    return feature.GPUUploadHeapSupported != FALSE;
+#else
+    return false;
+#endif
+}
+
 YAGE_NODISCARD auto YaGE::RenderDevice::SupportUnorderedAccess(DXGI_FORMAT format) const noexcept -> bool {
     switch (format) {
     case DXGI_FORMAT_R32G32B32A32_FLOAT:
@@ -1,17 +1,31 @@
 #pragma once
 
+#include "../Core/Memory.h"
+#include "../Core/Task.h"
 #include "Descriptor.h"
+#include "GpuMemoryAllocator.h"
 
 #include <dxgi1_6.h>
 
 #include <atomic>
+#include <deque>
+#include <functional>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <queue>
 #include <stack>
+#include <thread>
 
 namespace YaGE {
 
+class CommandBuffer;
+class GpuResource;
+
+#ifdef YAGE_HAS_COROUTINE
+class SyncPointAwaiter;
+#endif
+
 class RenderDevice {
 public:
     /// @brief
@@ -37,7 +51,7 @@ public:
     ///
     /// @return IDXGIAdapter3 *
     ///   Return the DXGI adapter that is used to create this RenderDevice.
-    YAGE_NODISCARD auto Adapter() const noexcept -> IDXGIAdapter1 * { return adapter.Get(); }
+    YAGE_NODISCARD auto Adapter() const noexcept -> IDXGIAdapter3 * { return adapter.Get(); }
 
     /// @brief
     ///   Get D3D12 device of this RenderDevice.
@@ -51,17 +65,82 @@ public:
     ///
     /// @return ID3D12CommandQueue *
     ///   Return direct command queue of this RenderDevice.
-    YAGE_NODISCARD auto CommandQueue() const noexcept -> ID3D12CommandQueue * { return commandQueue.Get(); }
+    YAGE_NODISCARD auto CommandQueue() const noexcept -> ID3D12CommandQueue * {
+        return queues[DIRECT_QUEUE_INDEX].queue.Get();
+    }
+
+    /// @brief
+    ///   Get copy command queue of this RenderDevice.
+    ///
+    /// @return ID3D12CommandQueue *
+    ///   Return copy command queue of this RenderDevice.
+    YAGE_NODISCARD auto CopyQueue() const noexcept -> ID3D12CommandQueue * {
+        return queues[COPY_QUEUE_INDEX].queue.Get();
+    }
+
+    /// @brief
+    ///   Get compute command queue of this RenderDevice.
+    ///
+    /// @return ID3D12CommandQueue *
+    ///   Return compute command queue of this RenderDevice.
+    YAGE_NODISCARD auto ComputeQueue() const noexcept -> ID3D12CommandQueue * {
+        return queues[COMPUTE_QUEUE_INDEX].queue.Get();
+    }
+
+    /// @brief
+    ///   Get command queue of the specified type.
+    ///
+    /// @param type     Type of the command queue. Only direct, compute and copy command queues are supported.
+    ///
+    /// @return ID3D12CommandQueue *
+    ///   Return command queue of the specified type.
+    YAGE_NODISCARD auto CommandQueue(D3D12_COMMAND_LIST_TYPE type) const noexcept -> ID3D12CommandQueue * {
+        return queues[QueueIndex(type)].queue.Get();
+    }
 
     /// @brief
-    ///   Signal and increment sync point for this RenderDevice. This value could be used for CPU-GPU sync.
+    ///   Signal and increment sync point for the direct command queue. This value could be used for CPU-GPU sync.
     ///
     /// @return uint64_t
     ///   Return the signaled sync point value.
     YAGE_NODISCARD auto AcquireSyncPoint() const noexcept -> uint64_t {
-        const uint64_t value = nextFenceValue.fetch_add(1, std::memory_order_relaxed);
-        commandQueue->Signal(fence.Get(), value);
-        return value;
+        return AcquireSyncPoint(D3D12_COMMAND_LIST_TYPE_DIRECT);
+    }
+
+    /// @brief
+    ///   Signal and increment sync point for the specified command queue. This value could be used for CPU-GPU sync and cross-queue sync.
+    /// @remarks
+    ///   Sync points from different command queues could be used in the same way. The owner command queue is encoded in the highest bits of the sync point value, so sync points of the direct command queue are the same as raw fence values.
+    ///   This method is thread-safe. Signals are serialized with submissions so that fence values are always signaled in increasing order.
+    ///
+    /// @param type     Type of the command queue to signal.
+    ///
+    /// @return uint64_t
+    ///   Return the signaled sync point value.
+    YAGE_NODISCARD auto AcquireSyncPoint(D3D12_COMMAND_LIST_TYPE type) const noexcept -> uint64_t {
+        const uint32_t queueIndex = QueueIndex(type);
+        auto          &context    = queues[queueIndex];
+
+        std::lock_guard<std::mutex> lock(context.submitMutex);
+
+        const uint64_t value = context.nextFenceValue.fetch_add(1, std::memory_order_relaxed);
+        context.queue->Signal(context.fence.Get(), value);
+        return MakeSyncPoint(queueIndex, value);
+    }
+
+    /// @brief
+    ///   Get the last sync point that has been submitted to the specified command queue. No signal is issued. This method is thread-safe.
+    /// @remarks
+    ///   The returned sync point covers all command buffers that have been submitted to the command queue before this call. Sync point of a command queue that has never been used is always reached.
+    ///
+    /// @param type     Type of the command queue.
+    ///
+    /// @return uint64_t
+    ///   Return the last submitted sync point of the specified command queue.
+    YAGE_NODISCARD auto LastSubmittedSyncPoint(D3D12_COMMAND_LIST_TYPE type) const noexcept -> uint64_t {
+        const uint32_t queueIndex = QueueIndex(type);
+        const uint64_t value      = queues[queueIndex].nextFenceValue.load(std::memory_order_relaxed) - 1;
+        return MakeSyncPoint(queueIndex, value);
     }
 
     /// @brief
@@ -73,7 +152,8 @@ public:
     /// @retval true    The specified sync point has been reached.
     /// @retval false   The specified sync point has not been reached.
     YAGE_NODISCARD auto IsSyncPointReached(uint64_t syncPoint) const noexcept -> bool {
-        return syncPoint <= fence->GetCompletedValue();
+        const auto &context = queues[SyncPointQueueIndex(syncPoint)];
+        return SyncPointValue(syncPoint) <= context.fence->GetCompletedValue();
     }
 
     /// @brief
@@ -83,26 +163,242 @@ public:
     YAGE_API auto Sync(uint64_t syncPoint) const noexcept -> void;
 
     /// @brief
-    ///   Wait for all tasks in command queue to be finished. This method will block current thread until all tasks in command queue are finished.
-    auto Sync() const noexcept -> void { Sync(AcquireSyncPoint()); }
+    ///   Register a callback that is invoked once the specified sync point is reached by GPU. This method never blocks.
+    /// @remarks
+    ///   Callbacks are invoked by a single background thread that waits for all command queue fences at once, so that resource release, readback processing and streaming could resume without blocking a thread for each sync point. Callbacks of the same command queue are invoked in sync point order. Callbacks should be short and must not throw.
+    ///   If the sync point has already been reached, the callback is invoked immediately on current thread. This method is thread-safe.
+    ///
+    /// @param syncPoint    The sync point to be waited for.
+    /// @param callback     The callback to be invoked once @p syncPoint is reached.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to start the background callback thread.
+    YAGE_API auto OnSyncPointReached(uint64_t syncPoint, std::function<void()> &&callback) -> void;
+
+#ifdef YAGE_HAS_COROUTINE
+    /// @brief
+    ///   Suspend current coroutine until the specified sync point is reached by GPU. The coroutine is resumed on worker threads of @p ThreadPool::Singleton(), so that the sync point callback thread is never blocked by coroutines.
+    ///
+    /// @param syncPoint    The sync point to be waited for.
+    ///
+    /// @return SyncPointAwaiter
+    ///   Return an awaiter that resumes current coroutine once @p syncPoint is reached.
+    YAGE_NODISCARD auto WhenReached(uint64_t syncPoint) noexcept -> SyncPointAwaiter;
+#endif
+
+    /// @brief
+    ///   Submit a batch of command buffers with a single @p ExecuteCommandLists call and a single signal.
+    /// @remarks
+    ///   All command buffers must have the same type and are executed in the given order. Pending GPU-side waits of all command buffers are inserted before the batch. Each command buffer is reset once submission is done, the same as @p CommandBuffer::Submit().
+    ///   Every command buffer must be fully recorded before this method is called: threads that record it must have finished, no render graph pass, split transition or query may be left open, and the same command buffer must not appear twice in the batch. Command buffers are closed here, so commands recorded concurrently with this call are lost or corrupt the command list.
+    ///   This method is thread-safe. Different command buffers could be recorded concurrently from worker threads and then submitted together from any thread. A single command buffer must not be used by multiple threads at the same time, and resources whose states are tracked automatically should not be transitioned by command buffers that are recorded concurrently.
+    ///
+    /// @param count            Number of command buffers to be submitted.
+    /// @param commandBuffers   Command buffers to be submitted.
+    ///
+    /// @return uint64_t
+    ///   Return a sync point that indicates when all of the command buffers will finish executing on GPU.
+    /// @throw RenderAPIException
+    ///   Thrown if failed to acquire new command allocator.
+    YAGE_API auto Submit(uint32_t count, CommandBuffer *const *commandBuffers) -> uint64_t;
+
+    /// @brief
+    ///   Wait for all tasks in all command queues to be finished. This method will block current thread until all tasks in all command queues are finished.
+    YAGE_API auto Sync() const noexcept -> void;
+
+    /// @brief
+    ///   Make the specified command queue wait for the specified sync point on GPU side. This method returns immediately.
+    /// @remarks
+    ///   Commands submitted to @p queueType command queue after this call will not be executed until @p syncPoint is reached. This could be used to synchronize command queues without blocking CPU, for example, let the direct command queue wait for uploading on the copy command queue.
+    ///
+    /// @param queueType    Type of the command queue that should wait for the sync point.
+    /// @param syncPoint    The sync point to be waited for. This could be a sync point of any command queue.
+    YAGE_API auto WaitForSyncPoint(D3D12_COMMAND_LIST_TYPE queueType, uint64_t syncPoint) const noexcept -> void;
 
     /// @brief
-    ///   Try to acquire a new direct command allocator from this RenderDevice.
+    ///   Try to acquire a new command allocator from this RenderDevice.
     /// @remarks
-    ///   This method will try to acquire a new direct command allocator from this RenderDevice. If there is no available command allocator in the pool, a new command allocator will be created and returned.
+    ///   This method will try to acquire a new command allocator from this RenderDevice. If there is no available command allocator in the pool, a new command allocator will be created and returned. Each type of command queue has its own command allocator pool.
+    ///
+    /// @param type     Type of the command allocator. Only direct, compute and copy command allocators are supported.
     ///
     /// @return ID3D12CommandAllocator *
-    ///   Return a new direct command allocator.
+    ///   Return a new command allocator of the specified type.
     /// @throw RenderAPIException
     ///   Thrown if failed to create new command allocator.
-    YAGE_NODISCARD YAGE_API auto AcquireCommandAllocator() -> ID3D12CommandAllocator *;
+    YAGE_NODISCARD YAGE_API auto AcquireCommandAllocator(D3D12_COMMAND_LIST_TYPE type = D3D12_COMMAND_LIST_TYPE_DIRECT)
+        -> ID3D12CommandAllocator *;
+
+    /// @brief
+    ///   Free a command allocator of the specified type.
+    ///
+    /// @param type             Type of the command allocator to be freed.
+    /// @param syncPoint        The sync point that is signaled when the command allocator is no longer in use.
+    /// @param allocator[in]    The command allocator to be freed.
+    YAGE_API auto FreeCommandAllocator(D3D12_COMMAND_LIST_TYPE type,
+                                       uint64_t                syncPoint,
+                                       ID3D12CommandAllocator *allocator) noexcept -> void;
 
     /// @brief
     ///   Free a direct command allocator.
     ///
-    /// @param syncPoint        The fence value that is signaled when the command allocator is no longer in use.
+    /// @param syncPoint        The sync point that is signaled when the command allocator is no longer in use.
     /// @param allocator[in]    The command allocator to be freed.
-    YAGE_API auto FreeCommandAllocator(uint64_t syncPoint, ID3D12CommandAllocator *allocator) noexcept -> void;
+    auto FreeCommandAllocator(uint64_t syncPoint, ID3D12CommandAllocator *allocator) noexcept -> void {
+        FreeCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, syncPoint, allocator);
+    }
+
+    /// @brief
+    ///   Create a D3D12 resource in GPU memory pools of this RenderDevice.
+    /// @remarks
+    ///   The resource is placed in a shared heap block if possible. Otherwise, a committed resource will be created.
+    ///
+    /// @param heapType         Type of heap that the resource should be created in.
+    /// @param desc             Description of the resource to be created.
+    /// @param initialState     Initial state of the resource.
+    /// @param clearValue       Optimized clear value of the resource. Could be nullptr.
+    /// @param[out] resource    Receives the created resource.
+    /// @param[out] allocation  Receives the memory allocation of the created resource. The allocation should be freed by @p FreeGpuMemory() after the resource is released.
+    ///
+    /// @return HRESULT
+    ///   Return @p S_OK if succeeded to create the resource. Otherwise, return the error code.
+    YAGE_NODISCARD auto CreateResource(D3D12_HEAP_TYPE            heapType,
+                                       const D3D12_RESOURCE_DESC &desc,
+                                       D3D12_RESOURCE_STATES      initialState,
+                                       const D3D12_CLEAR_VALUE   *clearValue,
+                                       ID3D12Resource           **resource,
+                                       GpuMemoryAllocation       &allocation) noexcept -> HRESULT {
+        return gpuMemoryAllocator.CreateResource(heapType, desc, initialState, clearValue, resource, allocation);
+    }
+
+    /// @brief
+    ///   Free GPU memory allocation of a released resource.
+    ///
+    /// @param allocation   The memory allocation to be freed.
+    auto FreeGpuMemory(const GpuMemoryAllocation &allocation) noexcept -> void { gpuMemoryAllocator.Free(allocation); }
+
+    /// @brief
+    ///   Account GPU memory allocation of a resource to another usage category. This is used for resources whose usage could not be inferred from resource description, for example temporary buffer pages.
+    ///
+    /// @param[in, out] allocation  The memory allocation to be accounted.
+    /// @param          category    The new usage category of the allocation.
+    auto SetMemoryCategory(GpuMemoryAllocation &allocation, GpuMemoryCategory category) noexcept -> void {
+        gpuMemoryAllocator.SetCategory(allocation, category);
+    }
+
+    /// @brief
+    ///   Add or remove memory usage that is not allocated from GPU memory pools of this RenderDevice, for example descriptor heaps and heaps created by transient resource allocators. This method is thread-safe.
+    ///
+    /// @param category     Usage category of the memory.
+    /// @param size         Size in byte of the memory. Negative values remove memory usage.
+    auto TrackMemoryUsage(GpuMemoryCategory category, int64_t size) noexcept -> void {
+        gpuMemoryAllocator.TrackUsage(category, size);
+    }
+
+    /// @brief
+    ///   Get size of GPU memory that is currently used by YaGE objects of the specified category. Memory of released resources is accounted until GPU finishes using them.
+    ///
+    /// @param category     Usage category of the memory.
+    ///
+    /// @return uint64_t
+    ///   Return size in byte of memory that is used by @p category.
+    YAGE_NODISCARD auto MemoryUsage(GpuMemoryCategory category) const noexcept -> uint64_t {
+        return gpuMemoryAllocator.Usage(category);
+    }
+
+    /// @brief
+    ///   Get total size of GPU memory that is currently used by YaGE objects of all categories.
+    ///
+    /// @return uint64_t
+    ///   Return total size in byte of memory that is used by YaGE objects.
+    YAGE_NODISCARD YAGE_API auto TotalMemoryUsage() const noexcept -> uint64_t;
+
+    /// @brief
+    ///   Query memory budget and current usage of this process of the specified memory segment group from the operating system.
+    /// @remarks
+    ///   Usage in the returned information includes memory that is allocated by the driver and other libraries. Exceeding @p Budget causes the operating system to page memory of this process out to system memory, which usually results in severe frame time spikes.
+    ///
+    /// @param group    The memory segment group to query. Local segment group is video memory on discrete GPUs.
+    ///
+    /// @return DXGI_QUERY_VIDEO_MEMORY_INFO
+    ///   Return memory budget information of @p group. All members are 0 if failed to query memory budget.
+    YAGE_NODISCARD YAGE_API auto QueryMemoryBudget(DXGI_MEMORY_SEGMENT_GROUP group) const noexcept
+        -> DXGI_QUERY_VIDEO_MEMORY_INFO;
+
+    /// @brief
+    ///   Query memory budget and current usage of this process of the local memory segment group.
+    ///
+    /// @return DXGI_QUERY_VIDEO_MEMORY_INFO
+    ///   Return memory budget information of the local memory segment group. All members are 0 if failed to query memory budget.
+    YAGE_NODISCARD auto QueryMemoryBudget() const noexcept -> DXGI_QUERY_VIDEO_MEMORY_INFO {
+        return QueryMemoryBudget(DXGI_MEMORY_SEGMENT_GROUP_LOCAL);
+    }
+
+    /// @brief
+    ///   Checks if current memory usage of this process exceeds budget of the local memory segment group.
+    ///
+    /// @return bool
+    /// @retval true    Memory usage exceeds budget. Idle resources should be released or evicted.
+    /// @retval false   Memory usage is within budget.
+    YAGE_NODISCARD YAGE_API auto IsOverBudget() const noexcept -> bool;
+
+    /// @brief
+    ///   Register a callback that is invoked every time the operating system changes memory budget of this process. This method never blocks.
+    /// @remarks
+    ///   Callbacks are invoked on the same background thread as @p OnSyncPointReached() callbacks. Use @p QueryMemoryBudget() in the callback to get the new budget. Callbacks should be short and must not throw. This method is thread-safe.
+    ///
+    /// @param callback     The callback to be invoked once memory budget is changed.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to register budget change notification or failed to start the background callback thread.
+    YAGE_API auto OnMemoryBudgetChanged(std::function<void()> &&callback) -> void;
+
+    /// @brief
+    ///   Make the specified evicted resources resident again with a single call. This method blocks until all resources are resident.
+    /// @remarks
+    ///   Resources that are not evicted are ignored. Resources must be made resident before they are used by GPU again.
+    ///
+    /// @param count        Number of resources.
+    /// @param resources    Resources to be made resident.
+    ///
+    /// @return HRESULT
+    ///   Return @p S_OK if succeeded. Return @p E_OUTOFMEMORY if there is no enough memory to make the resources resident.
+    YAGE_API auto MakeResident(uint32_t count, GpuResource *const *resources) noexcept -> HRESULT;
+
+    /// @brief
+    ///   Evict the specified idle resources from GPU memory with a single call. Content of evicted resources is preserved, and memory of evicted resources is returned to the budget.
+    /// @remarks
+    ///   Only resources that @p GpuResource::IsEvictable() are evicted, other resources are ignored. Resources must not be used by GPU when evicted, for example resources that have not been used for a few frames.
+    ///
+    /// @param count        Number of resources.
+    /// @param resources    Resources to be evicted.
+    ///
+    /// @return HRESULT
+    ///   Return @p S_OK if succeeded. Otherwise, return the error code.
+    YAGE_API auto Evict(uint32_t count, GpuResource *const *resources) noexcept -> HRESULT;
+
+    /// @brief
+    ///   Release a D3D12 object and its GPU memory allocation once GPU has finished all commands that were submitted to any command queue before this call. This method never blocks.
+    /// @remarks
+    ///   Released objects are retired with the last submitted sync point of each command queue and no extra signal is issued. Objects are released immediately if GPU has already reached these sync points. Otherwise, they are reclaimed by @p ReleaseDeferredObjects() once the sync points are reached, which is called on each submission and from the sync point callback thread. The object must not be referenced by command buffers that have not been submitted yet. This method is thread-safe.
+    ///
+    /// @param object       The D3D12 object to be released. Could be null.
+    /// @param allocation   GPU memory allocation of the object. Could be empty.
+    YAGE_API auto DeferRelease(Microsoft::WRL::ComPtr<ID3D12Pageable> &&object,
+                               const GpuMemoryAllocation             &allocation) noexcept -> void;
+
+    /// @brief
+    ///   Free a CPU descriptor once GPU has finished all commands that were submitted to any command queue before this call. This method never blocks.
+    /// @remarks
+    ///   Descriptors are retired in the same way as @p DeferRelease(), so that descriptor views could be destroyed while command buffers that use them are in flight. The descriptor must not be referenced by command buffers that have not been submitted yet. This method is thread-safe.
+    ///
+    /// @param type     Type of the descriptor heap that the descriptor is allocated from.
+    /// @param handle   The descriptor to be freed. Could be null.
+    YAGE_API auto DeferFreeDescriptor(D3D12_DESCRIPTOR_HEAP_TYPE type, CpuDescriptorHandle handle) noexcept -> void;
+
+    /// @brief
+    ///   Release deferred objects whose sync points have been reached. This method never blocks and is thread-safe.
+    YAGE_API auto ReleaseDeferredObjects() noexcept -> void;
 
     /// @brief
     ///   Allocate a constant buffer view descriptor.
@@ -146,6 +442,30 @@ public:
         constantBufferViewAllocator.Free(handle);
     }
 
+    /// @brief
+    ///   Allocate contiguous CBV/SRV/UAV descriptors in the same descriptor heap. Contiguous descriptors could be bound to descriptor tables with a single descriptor range.
+    /// @note
+    ///   The returned descriptors are not initialized.
+    ///
+    /// @param count    Number of descriptors to be allocated. Must not be 0.
+    ///
+    /// @return CpuDescriptorHandle
+    ///   Return the first allocated descriptor.
+    /// @throw RenderAPIException
+    ///   Thrown if descriptor allocator failed to create new descriptor heap.
+    YAGE_NODISCARD auto AllocateShaderResourceViews(uint32_t count) -> CpuDescriptorHandle {
+        return constantBufferViewAllocator.AllocateContiguous(count);
+    }
+
+    /// @brief
+    ///   Free contiguous CBV/SRV/UAV descriptors.
+    ///
+    /// @param first    The first descriptor to be freed.
+    /// @param count    Number of descriptors to be freed. Must be the same as the number passed to @p AllocateShaderResourceViews().
+    auto FreeShaderResourceViews(CpuDescriptorHandle first, uint32_t count) noexcept -> void {
+        constantBufferViewAllocator.FreeContiguous(first, count);
+    }
+
     /// @brief
     ///   Allocate an unordered access view descriptor.
     /// @note
@@ -230,6 +550,44 @@ public:
     /// @retval false   This RenderDevice does not support DirectX ray tracing.
     YAGE_NODISCARD YAGE_API auto SupportRayTracing() const noexcept -> bool;
 
+    /// @brief
+    ///   Checks if this RenderDevice supports amplification shaders and mesh shaders.
+    /// @remarks
+    ///   Always return false if YaGE is built with a Windows SDK that does not provide @p ID3D12GraphicsCommandList6.
+    ///
+    /// @return bool
+    /// @retval true    This RenderDevice supports amplification shaders and mesh shaders.
+    /// @retval false   This RenderDevice does not support amplification shaders and mesh shaders.
+    YAGE_NODISCARD YAGE_API auto SupportMeshShaders() const noexcept -> bool;
+
+    /// @brief
+    ///   Checks if this RenderDevice supports D3D12 enhanced barriers.
+    /// @remarks
+    ///   Always return false if YaGE is built with a Windows SDK that does not provide @p ID3D12GraphicsCommandList7.
+    ///
+    /// @return bool
+    /// @retval true    This RenderDevice supports D3D12 enhanced barriers.
+    /// @retval false   This RenderDevice does not support D3D12 enhanced barriers.
+    YAGE_NODISCARD YAGE_API auto SupportEnhancedBarriers() const noexcept -> bool;
+
+    /// @brief
+    ///   Checks if this RenderDevice supports tiled resources. Reserved resources could only be created if tiled resources are supported.
+    ///
+    /// @return bool
+    /// @retval true    This RenderDevice supports tiled resources.
+    /// @retval false   This RenderDevice does not support tiled resources.
+    YAGE_NODISCARD YAGE_API auto SupportTiledResources() const noexcept -> bool;
+
+    /// @brief
+    ///   Checks if this RenderDevice supports GPU upload heaps. GPU upload heaps are CPU-visible video memory that requires resizable BAR to be enabled.
+    /// @remarks
+    ///   Always return false if YaGE is built with a D3D12 SDK that does not provide @p D3D12_HEAP_TYPE_GPU_UPLOAD.
+    ///
+    /// @return bool
+    /// @retval true    This RenderDevice supports GPU upload heaps.
+    /// @retval false   This RenderDevice does not support GPU upload heaps.
+    YAGE_NODISCARD YAGE_API auto SupportGpuUploadHeap() const noexcept -> bool;
+
     /// @brief
     ///   Checks if the specified pixel format is supported for unordered access.
     ///
@@ -250,35 +608,175 @@ public:
     YAGE_NODISCARD YAGE_API static auto Singleton() -> RenderDevice &;
 
 private:
-    /// @brief  DXGI factory object that is used to create D3D12 objects.
-    Microsoft::WRL::ComPtr<IDXGIFactory6> dxgiFactory;
+    /// @brief
+    ///   Get index of the command queue context for the specified command list type.
+    ///
+    /// @param type     Type of the command list.
+    ///
+    /// @return uint32_t
+    ///   Return index of the command queue context.
+    YAGE_NODISCARD static constexpr auto QueueIndex(D3D12_COMMAND_LIST_TYPE type) noexcept -> uint32_t {
+        return (type == D3D12_COMMAND_LIST_TYPE_COPY)      ? COPY_QUEUE_INDEX
+               : (type == D3D12_COMMAND_LIST_TYPE_COMPUTE) ? COMPUTE_QUEUE_INDEX
+                                                           : DIRECT_QUEUE_INDEX;
+    }
 
-    /// @brief  The adapter that is used to create D3D12 device.
-    Microsoft::WRL::ComPtr<IDXGIAdapter1> adapter;
+    /// @brief
+    ///   Encode command queue index and fence value into a sync point.
+    ///
+    /// @param queueIndex   Index of the command queue context.
+    /// @param fenceValue   Fence value of the command queue.
+    ///
+    /// @return uint64_t
+    ///   Return the encoded sync point.
+    YAGE_NODISCARD static constexpr auto MakeSyncPoint(uint32_t queueIndex, uint64_t fenceValue) noexcept -> uint64_t {
+        return (static_cast<uint64_t>(queueIndex) << 62) | fenceValue;
+    }
 
-    /// @brief  D3D12 virtual device object.
-    Microsoft::WRL::ComPtr<ID3D12Device1> device;
+    /// @brief
+    ///   Get index of the command queue context that the specified sync point belongs to.
+    ///
+    /// @param syncPoint    The sync point to be decoded.
+    ///
+    /// @return uint32_t
+    ///   Return index of the command queue context.
+    YAGE_NODISCARD static constexpr auto SyncPointQueueIndex(uint64_t syncPoint) noexcept -> uint32_t {
+        return static_cast<uint32_t>(syncPoint >> 62);
+    }
+
+    /// @brief
+    ///   Get fence value of the specified sync point.
+    ///
+    /// @param syncPoint    The sync point to be decoded.
+    ///
+    /// @return uint64_t
+    ///   Return fence value of the sync point.
+    YAGE_NODISCARD static constexpr auto SyncPointValue(uint64_t syncPoint) noexcept -> uint64_t {
+        return syncPoint & ((uint64_t(1) << 62) - 1);
+    }
+
+    /// @brief
+    ///   Entry of the background callback thread. Invokes callbacks whose sync points are reached and waits for the smallest pending fence value of each command queue with a single event.
+    auto CallbackThreadMain() noexcept -> void;
 
-    /// @brief  Direct command queue for this RenderDevice.
-    Microsoft::WRL::ComPtr<ID3D12CommandQueue> commandQueue;
+    /// @brief
+    ///   Create callback events and start the background callback thread if it is not started yet. @p callbackMutex must be locked.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to create callback events.
+    auto StartCallbackThread() -> void;
 
-    /// @brief  Fence object that is used to synchronize CPU and GPU for this device.
-    Microsoft::WRL::ComPtr<ID3D12Fence1> fence;
+    /// @brief
+    ///   Command queue and its synchronization objects and command allocators.
+    struct CommandQueueContext {
+        using FreeAllocatorEntry = std::pair<uint64_t, ID3D12CommandAllocator *>;
 
-    /// @brief  Next fence value to be signaled.
-    mutable std::atomic_uint64_t nextFenceValue;
+        /// @brief
+        ///   Create an empty command queue context. Nodes of the free allocator queue are allocated from its own memory pool.
+        CommandQueueContext()
+            : type(),
+              freeAllocatorQueuePool(),
+              freeAllocatorQueue(PoolAllocator<FreeAllocatorEntry>(freeAllocatorQueuePool)) {}
 
-    /// @brief  D3D12 command allocator pool.
-    std::stack<Microsoft::WRL::ComPtr<ID3D12CommandAllocator>> allocatorPool;
+        /// @brief  Type of this command queue.
+        D3D12_COMMAND_LIST_TYPE type;
 
-    /// @brief  Allocator that is used to protect D3D12 command allocator pool.
-    mutable std::mutex allocatorPoolMutex;
+        /// @brief  D3D12 command queue object.
+        Microsoft::WRL::ComPtr<ID3D12CommandQueue> queue;
 
-    /// @brief  Freed D3D12 command allocator queue to be reused.
-    std::queue<std::pair<uint64_t, ID3D12CommandAllocator *>> freeAllocatorQueue;
+        /// @brief  Fence object that is used to synchronize CPU and GPU for this command queue.
+        Microsoft::WRL::ComPtr<ID3D12Fence1> fence;
 
-    /// @brief  Mutex that is used to protect free command allocator queue.
-    mutable std::mutex freeAllocatorQueueMutex;
+        /// @brief  Next fence value to be signaled.
+        mutable std::atomic_uint64_t nextFenceValue;
+
+        /// @brief  Mutex that is used to serialize command list execution and fence signals on this command queue.
+        mutable std::mutex submitMutex;
+
+        /// @brief  D3D12 command allocator pool.
+        std::stack<Microsoft::WRL::ComPtr<ID3D12CommandAllocator>> allocatorPool;
+
+        /// @brief  Allocator that is used to protect D3D12 command allocator pool.
+        mutable std::mutex allocatorPoolMutex;
+
+        /// @brief  Memory pool of free command allocator queue nodes. Protected by @p freeAllocatorQueueMutex.
+        MemoryPool freeAllocatorQueuePool;
+
+        /// @brief  Freed D3D12 command allocator queue to be reused.
+        std::queue<FreeAllocatorEntry, std::deque<FreeAllocatorEntry, PoolAllocator<FreeAllocatorEntry>>>
+            freeAllocatorQueue;
+
+        /// @brief  Mutex that is used to protect free command allocator queue.
+        mutable std::mutex freeAllocatorQueueMutex;
+
+        /// @brief  Callbacks that are waiting for fence values of this command queue. Protected by @p callbackMutex.
+        std::multimap<uint64_t, std::function<void()>> callbacks;
+    };
+
+    /// @brief  Index of the direct command queue context.
+    static constexpr const uint32_t DIRECT_QUEUE_INDEX = 0;
+
+    /// @brief  Index of the copy command queue context.
+    static constexpr const uint32_t COPY_QUEUE_INDEX = 1;
+
+    /// @brief  Index of the compute command queue context.
+    static constexpr const uint32_t COMPUTE_QUEUE_INDEX = 2;
+
+    /// @brief  Number of command queues in this RenderDevice.
+    static constexpr const uint32_t QUEUE_COUNT = 3;
+
+    /// @brief
+    ///   A D3D12 object or CPU descriptor that is waiting to be released.
+    struct DeferredObject {
+        /// @brief  The D3D12 object to be released.
+        Microsoft::WRL::ComPtr<ID3D12Pageable> object;
+
+        /// @brief  GPU memory allocation of the object.
+        GpuMemoryAllocation allocation;
+
+        /// @brief  The allocator that the descriptor is freed to. Null if there is no descriptor to be freed.
+        CpuDescriptorAllocator *descriptorAllocator;
+
+        /// @brief  The CPU descriptor to be freed.
+        CpuDescriptorHandle descriptor;
+    };
+
+    /// @brief
+    ///   Released objects that are waiting for sync points of all command queues.
+    struct RetiredObjectBatch {
+        /// @brief  Last submitted sync points of all command queues when the objects were retired. Indexed by @p QueueIndex().
+        uint64_t syncPoints[QUEUE_COUNT];
+
+        /// @brief  Objects to be released.
+        std::vector<DeferredObject> objects;
+    };
+
+    /// @brief
+    ///   Retire the specified deferred object with the last submitted sync points of all command queues, or release it immediately if these sync points have been reached.
+    ///
+    /// @param[in] object   The deferred object to be retired.
+    auto RetireDeferredObject(DeferredObject &&object) noexcept -> void;
+
+    /// @brief
+    ///   Release the specified deferred object and free its GPU memory allocation immediately.
+    ///
+    /// @param[in] object   The deferred object to be released.
+    auto FreeDeferredObject(DeferredObject &object) noexcept -> void;
+
+    /// @brief  DXGI factory object that is used to create D3D12 objects.
+    Microsoft::WRL::ComPtr<IDXGIFactory6> dxgiFactory;
+
+    /// @brief  The adapter that is used to create D3D12 device.
+    Microsoft::WRL::ComPtr<IDXGIAdapter3> adapter;
+
+    /// @brief  D3D12 virtual device object.
+    Microsoft::WRL::ComPtr<ID3D12Device1> device;
+
+    /// @brief  Command queues of this RenderDevice. Indexed by @p QueueIndex().
+    CommandQueueContext queues[QUEUE_COUNT];
+
+    /// @brief  GPU memory allocator for this device.
+    GpuMemoryAllocator gpuMemoryAllocator;
 
     /// @brief  CBV/SRV/UAV allocator for this device.
     CpuDescriptorAllocator constantBufferViewAllocator;
@@ -291,6 +789,79 @@ private:
 
     /// @brief  DSV allocator for this device.
     CpuDescriptorAllocator depthStencilViewAllocator;
+
+    /// @brief  Memory pool of retired object batch nodes. Protected by @p deferredObjectMutex.
+    MemoryPool retiredObjectPool;
+
+    /// @brief  Retired objects waiting for GPU. Sync points of batches are non-decreasing.
+    std::deque<RetiredObjectBatch, PoolAllocator<RetiredObjectBatch>> retiredObjects;
+
+    /// @brief  Mutex that is used to protect deferred objects.
+    std::mutex deferredObjectMutex;
+
+    /// @brief  Mutex that is used to protect sync point callbacks.
+    std::mutex callbackMutex;
+
+    /// @brief  Event that is signaled when new callbacks are registered or the callback thread should exit.
+    HANDLE callbackWakeEvent;
+
+    /// @brief  Event that is signaled when any of the pending fence values is reached.
+    HANDLE callbackFenceEvent;
+
+    /// @brief  Event that is signaled when memory budget of this process is changed. Created on first budget callback registration.
+    HANDLE budgetChangeEvent;
+
+    /// @brief  Cookie of the budget change notification registration.
+    DWORD budgetChangeCookie;
+
+    /// @brief  Callbacks that are invoked when memory budget is changed. Protected by @p callbackMutex.
+    std::vector<std::function<void()>> budgetCallbacks;
+
+    /// @brief  Whether the callback thread should exit.
+    bool isCallbackThreadExiting;
+
+    /// @brief  Background thread that invokes sync point callbacks. Started on first callback registration.
+    std::thread callbackThread;
 };
 
+#ifdef YAGE_HAS_COROUTINE
+class SyncPointAwaiter {
+public:
+    /// @brief
+    ///   Create an awaiter that waits for the specified sync point.
+    ///
+    /// @param[in] device   The render device that the sync point belongs to.
+    /// @param     sync     The sync point to be waited for.
+    SyncPointAwaiter(RenderDevice &device, uint64_t sync) noexcept : renderDevice(device), syncPoint(sync) {}
+
+    /// @brief
+    ///   Checks if the sync point has already been reached.
+    auto await_ready() const noexcept -> bool { return renderDevice.IsSyncPointReached(syncPoint); }
+
+    /// @brief
+    ///   Register a callback that resumes the awaiting coroutine on worker threads once the sync point is reached.
+    ///
+    /// @param handle   The awaiting coroutine.
+    auto await_suspend(std::coroutine_handle<> handle) -> void {
+        renderDevice.OnSyncPointReached(syncPoint,
+                                        [handle]() { ScheduleAwaiter::Post(ThreadPool::Singleton(), handle); });
+    }
+
+    /// @brief
+    ///   Nothing to return.
+    auto await_resume() const noexcept -> void {}
+
+private:
+    /// @brief  The render device that the sync point belongs to.
+    RenderDevice &renderDevice;
+
+    /// @brief  The sync point to be waited for.
+    uint64_t syncPoint;
+};
+
+inline auto RenderDevice::WhenReached(uint64_t syncPoint) noexcept -> SyncPointAwaiter {
+    return SyncPointAwaiter(*this, syncPoint);
+}
+#endif
+
 } // namespace YaGE
@@ -0,0 +1,504 @@
+#include "RenderGraph.h"
+#include "../Core/Exception.h"
+#include "../Core/ThreadPool.h"
+
+#include <algorithm>
+#include <cassert>
+#include <exception>
+#include <future>
+
+using namespace YaGE;
+
+namespace {
+
+/// @brief  Resource states that only allow read access. These states could be combined with each other.
+static constexpr const uint32_t READ_ONLY_STATES =
+    uint32_t(D3D12_RESOURCE_STATE_GENERIC_READ) | uint32_t(D3D12_RESOURCE_STATE_DEPTH_READ) |
+    uint32_t(D3D12_RESOURCE_STATE_RESOLVE_SOURCE) | uint32_t(D3D12_RESOURCE_STATE_SHADING_RATE_SOURCE);
+
+/// @brief
+///   Checks if a resource in @p current state could be accessed in @p required state without transition.
+///
+/// @param current  Current state of the resource.
+/// @param required Required state of the resource.
+///
+/// @return bool
+/// @retval true    The resource does not need to be transitioned.
+/// @retval false   The resource should be transitioned.
+auto IsStateCompatible(D3D12_RESOURCE_STATES current, D3D12_RESOURCE_STATES required) noexcept -> bool {
+    if (current == required)
+        return true;
+    return required != D3D12_RESOURCE_STATE_COMMON && (current & required) == required;
+}
+
+/// @brief
+///   Checks if the specified state could be used as a single resource state. Read-only states could be combined with
+///   each other, but write states could not be combined with any other state.
+///
+/// @param state    The state to be checked.
+///
+/// @return bool
+/// @retval true    The state is a valid resource state.
+/// @retval false   The state combines a write state with other states.
+auto IsValidState(D3D12_RESOURCE_STATES state) noexcept -> bool {
+    const uint32_t bits = static_cast<uint32_t>(state);
+    return (bits & ~READ_ONLY_STATES) == 0 || (bits & (bits - 1)) == 0;
+}
+
+/// @brief
+///   Checks if the specified state only contains read-only states.
+///
+/// @param state    The state to be checked.
+///
+/// @return bool
+/// @retval true    The state is not empty and only contains read-only states.
+/// @retval false   The state is empty or contains write states.
+auto IsReadOnlyState(D3D12_RESOURCE_STATES state) noexcept -> bool {
+    const uint32_t bits = static_cast<uint32_t>(state);
+    return bits != 0 && (bits & ~READ_ONLY_STATES) == 0;
+}
+
+} // namespace
+
+auto YaGE::RenderGraphBuilder::Read(RenderGraphResource resource, D3D12_RESOURCE_STATES state) -> void {
+    graph.AddAccess(passIndex, resource, state, false);
+}
+
+auto YaGE::RenderGraphBuilder::Write(RenderGraphResource resource, D3D12_RESOURCE_STATES state) -> void {
+    graph.AddAccess(passIndex, resource, state, true);
+}
+
+YaGE::RenderGraph::RenderGraph(uint32_t maxCommandBuffers)
+    : renderDevice(RenderDevice::Singleton()),
+      maxCommandBuffers(maxCommandBuffers == 0 ? ThreadPool::Singleton().ThreadCount() + 1 : maxCommandBuffers),
+      resources(),
+      passes(),
+      schedule(),
+      finalBarriers(),
+      finalStates(),
+      transientAllocator(),
+      commandBuffers(),
+      pendingWaitSyncPoints(),
+      lastSyncPoint() {}
+
+YaGE::RenderGraph::~RenderGraph() noexcept { renderDevice.Sync(lastSyncPoint); }
+
+auto YaGE::RenderGraph::ImportColorBuffer(ColorBuffer &colorBuffer) -> RenderGraphResource {
+    return ImportResource(colorBuffer);
+}
+
+auto YaGE::RenderGraph::ImportColorBuffer(ColorBuffer &colorBuffer, D3D12_RESOURCE_STATES finalState)
+    -> RenderGraphResource {
+    RenderGraphResource handle = ImportResource(colorBuffer);
+
+    resources.back().hasFinalState = true;
+    resources.back().finalState    = finalState;
+
+    return handle;
+}
+
+auto YaGE::RenderGraph::ImportDepthBuffer(DepthBuffer &depthBuffer) -> RenderGraphResource {
+    return ImportResource(depthBuffer);
+}
+
+auto YaGE::RenderGraph::ImportResource(GpuResource &resource) -> RenderGraphResource {
+    const uint32_t index = static_cast<uint32_t>(resources.size());
+
+    resources.push_back(VirtualResource{
+        /* type          = */ ResourceType::Imported,
+        /* resource      = */ &resource,
+        /* width         = */ 0,
+        /* height        = */ 0,
+        /* format        = */ DXGI_FORMAT_UNKNOWN,
+        /* sampleCount   = */ 0,
+        /* hasFinalState = */ false,
+        /* finalState    = */ D3D12_RESOURCE_STATE_COMMON,
+        /* firstPass     = */ UINT32_MAX,
+        /* lastPass      = */ 0,
+    });
+
+    return RenderGraphResource(index);
+}
+
+auto YaGE::RenderGraph::CreateColorBuffer(uint32_t width, uint32_t height, DXGI_FORMAT format, uint32_t sampleCount)
+    -> RenderGraphResource {
+    const uint32_t index = static_cast<uint32_t>(resources.size());
+
+    resources.push_back(VirtualResource{
+        /* type          = */ ResourceType::TransientColor,
+        /* resource      = */ nullptr,
+        /* width         = */ width,
+        /* height        = */ height,
+        /* format        = */ format,
+        /* sampleCount   = */ sampleCount,
+        /* hasFinalState = */ false,
+        /* finalState    = */ D3D12_RESOURCE_STATE_COMMON,
+        /* firstPass     = */ UINT32_MAX,
+        /* lastPass      = */ 0,
+    });
+
+    return RenderGraphResource(index);
+}
+
+auto YaGE::RenderGraph::CreateDepthBuffer(uint32_t width, uint32_t height, DXGI_FORMAT format, uint32_t sampleCount)
+    -> RenderGraphResource {
+    const uint32_t index = static_cast<uint32_t>(resources.size());
+
+    resources.push_back(VirtualResource{
+        /* type          = */ ResourceType::TransientDepth,
+        /* resource      = */ nullptr,
+        /* width         = */ width,
+        /* height        = */ height,
+        /* format        = */ format,
+        /* sampleCount   = */ sampleCount,
+        /* hasFinalState = */ false,
+        /* finalState    = */ D3D12_RESOURCE_STATE_COMMON,
+        /* firstPass     = */ UINT32_MAX,
+        /* lastPass      = */ 0,
+    });
+
+    return RenderGraphResource(index);
+}
+
+auto YaGE::RenderGraph::AddPass(StringView                                      name,
+                                const std::function<void(RenderGraphBuilder &)> &setup,
+                                std::function<void(CommandBuffer &)>            execute) -> void {
+    const uint32_t passIndex = static_cast<uint32_t>(passes.size());
+
+    passes.push_back(Pass{
+        /* name       = */ String(name),
+        /* execute    = */ std::move(execute),
+        /* accesses   = */ {},
+        /* sideEffect = */ false,
+        /* barriers   = */ {},
+        /* discards   = */ {},
+    });
+
+    // Do not keep partially declared passes.
+    RenderGraphBuilder builder(*this, passIndex);
+    try {
+        setup(builder);
+    } catch (...) {
+        passes.pop_back();
+        throw;
+    }
+
+    passes[passIndex].sideEffect = builder.sideEffect;
+}
+
+auto YaGE::RenderGraph::Execute() -> uint64_t {
+    try {
+        CullPasses();
+        AllocateTransientResources();
+
+        const size_t   passCount   = schedule.size();
+        const uint32_t bufferCount =
+            static_cast<uint32_t>(std::max<size_t>(1, std::min<size_t>(maxCommandBuffers, passCount)));
+
+        while (commandBuffers.size() < bufferCount)
+            commandBuffers.push_back(std::make_unique<CommandBuffer>(D3D12_COMMAND_LIST_TYPE_DIRECT));
+
+        CommandBuffer &mainBuffer = *commandBuffers[0];
+        for (const uint64_t syncPoint : pendingWaitSyncPoints)
+            mainBuffer.WaitForSyncPoint(syncPoint);
+        pendingWaitSyncPoints.clear();
+
+        // Barriers are computed per resource. Merge per-subresource states of imported resources first.
+        for (const auto &resource : resources) {
+            if (resource.resource != nullptr && !resource.resource->IsStateUniform())
+                mainBuffer.Transition(*resource.resource, resource.resource->State());
+        }
+
+        ComputeBarriers();
+
+        // Record passes in parallel. The first range is recorded on current thread.
+        const size_t passesPerBuffer = (passCount + bufferCount - 1) / bufferCount;
+
+        std::vector<std::future<void>> futures;
+        futures.reserve(bufferCount - 1);
+
+        ThreadPool &threadPool = ThreadPool::Singleton();
+        for (uint32_t i = 1; i < bufferCount; ++i) {
+            const size_t   first  = std::min(passCount, i * passesPerBuffer);
+            const size_t   last   = std::min(passCount, first + passesPerBuffer);
+            CommandBuffer *buffer = commandBuffers[i].get();
+            futures.push_back(threadPool.Submit([this, buffer, first, last]() { RecordPasses(*buffer, first, last); }));
+        }
+
+        std::exception_ptr exception;
+        try {
+            RecordPasses(mainBuffer, 0, std::min(passCount, passesPerBuffer));
+        } catch (...) {
+            exception = std::current_exception();
+        }
+
+        // All worker threads must be finished before command buffers could be reset or submitted.
+        for (auto &future : futures) {
+            try {
+                future.get();
+            } catch (...) {
+                if (exception == nullptr)
+                    exception = std::current_exception();
+            }
+        }
+
+        if (exception != nullptr) {
+            for (uint32_t i = 0; i < bufferCount; ++i)
+                commandBuffers[i]->Reset();
+            std::rethrow_exception(exception);
+        }
+
+        CommandBuffer &lastBuffer = *commandBuffers[bufferCount - 1];
+        for (const auto &barrier : finalBarriers)
+            lastBuffer.QueueBarrier(barrier);
+
+        // Resource states are only updated once all passes have been recorded.
+        for (const auto &entry : finalStates) {
+            entry.first->usageState = entry.second;
+            entry.first->subresourceStates.clear();
+        }
+
+        std::vector<CommandBuffer *> submitBuffers(bufferCount);
+        for (uint32_t i = 0; i < bufferCount; ++i)
+            submitBuffers[i] = commandBuffers[i].get();
+
+        lastSyncPoint = renderDevice.Submit(bufferCount, submitBuffers.data());
+        transientAllocator.Reset(lastSyncPoint);
+    } catch (...) {
+        transientAllocator.Reset(lastSyncPoint);
+        Clear();
+        throw;
+    }
+
+    Clear();
+    return lastSyncPoint;
+}
+
+auto YaGE::RenderGraph::AddAccess(uint32_t              passIndex,
+                                  RenderGraphResource   resource,
+                                  D3D12_RESOURCE_STATES state,
+                                  bool                  isWrite) -> void {
+    assert(!resource.IsNull() && resource.index < resources.size());
+
+    Pass &pass = passes[passIndex];
+    if (isWrite && IsReadOnlyState(state))
+        throw Exception(Format(u"Render graph pass {} writes a resource in a read-only state.", pass.name));
+
+    auto &accesses = pass.accesses;
+    for (auto &access : accesses) {
+        if (access.resource == resource.index) {
+            // Barriers transition the resource to the merged state, so that it must be a valid resource state.
+            if (!IsValidState(access.state | state))
+                throw Exception(Format(u"Render graph pass {} declares conflicting states of the same resource.",
+                                       pass.name));
+
+            access.state |= state;
+            access.isRead  = access.isRead || !isWrite;
+            access.isWrite = access.isWrite || isWrite;
+            return;
+        }
+    }
+
+    if (!IsValidState(state))
+        throw Exception(Format(u"Render graph pass {} declares an invalid resource state.", pass.name));
+
+    accesses.push_back(ResourceAccess{
+        /* resource = */ resource.index,
+        /* state    = */ state,
+        /* isRead   = */ !isWrite,
+        /* isWrite  = */ isWrite,
+    });
+}
+
+auto YaGE::RenderGraph::CullPasses() -> void {
+    // Imported resources are always needed after execution.
+    std::vector<bool> needed(resources.size());
+    for (size_t i = 0; i < resources.size(); ++i)
+        needed[i] = (resources[i].type == ResourceType::Imported);
+
+    // Walk passes backward. A pass is kept if it has side effects or writes a resource that is needed later.
+    std::vector<bool> alive(passes.size());
+    for (size_t i = passes.size(); i > 0; --i) {
+        const Pass &pass = passes[i - 1];
+
+        bool isAlive = pass.sideEffect;
+        for (const auto &access : pass.accesses)
+            isAlive = isAlive || (access.isWrite && needed[access.resource]);
+
+        if (!isAlive)
+            continue;
+
+        alive[i - 1] = true;
+        for (const auto &access : pass.accesses) {
+            if (access.isRead)
+                needed[access.resource] = true;
+        }
+    }
+
+    schedule.clear();
+    for (size_t i = 0; i < passes.size(); ++i) {
+        if (alive[i])
+            schedule.push_back(static_cast<uint32_t>(i));
+    }
+}
+
+auto YaGE::RenderGraph::AllocateTransientResources() -> void {
+    // Compute lifetime of each resource in scheduled order.
+    for (uint32_t i = 0; i < schedule.size(); ++i) {
+        for (const auto &access : passes[schedule[i]].accesses) {
+            VirtualResource &resource = resources[access.resource];
+            resource.firstPass        = std::min(resource.firstPass, i);
+            resource.lastPass         = std::max(resource.lastPass, i);
+        }
+    }
+
+    // Memory of transient resources is released after their last use so that later transient resources could alias it.
+    for (uint32_t i = 0; i < schedule.size(); ++i) {
+        for (auto &resource : resources) {
+            if (resource.type != ResourceType::Imported && resource.resource != nullptr && resource.lastPass + 1 == i)
+                transientAllocator.Release(*static_cast<PixelBuffer *>(resource.resource));
+        }
+
+        for (const auto &access : passes[schedule[i]].accesses) {
+            VirtualResource &resource = resources[access.resource];
+            if (resource.type == ResourceType::Imported || resource.resource != nullptr)
+                continue;
+
+            if (resource.type == ResourceType::TransientDepth)
+                resource.resource = &transientAllocator.AcquireDepthBuffer(resource.width, resource.height,
+                                                                           resource.format, resource.sampleCount);
+            else
+                resource.resource = &transientAllocator.AcquireColorBuffer(resource.width, resource.height,
+                                                                           resource.format, resource.sampleCount);
+        }
+    }
+}
+
+auto YaGE::RenderGraph::ComputeBarriers() -> void {
+    finalStates.clear();
+    finalBarriers.clear();
+
+    // Simulate resource states in scheduled order. Physical resources may be shared by multiple virtual resources.
+    auto currentState = [this](GpuResource *resource) -> D3D12_RESOURCE_STATES & {
+        auto iter = finalStates.find(resource);
+        if (iter == finalStates.end())
+            iter = finalStates.emplace(resource, resource->State()).first;
+        return iter->second;
+    };
+
+    for (uint32_t i = 0; i < schedule.size(); ++i) {
+        Pass &pass = passes[schedule[i]];
+        pass.barriers.clear();
+        pass.discards.clear();
+
+        for (const auto &access : pass.accesses) {
+            const VirtualResource &virtualResource = resources[access.resource];
+            GpuResource           *resource        = virtualResource.resource;
+            D3D12_RESOURCE_STATES &state           = currentState(resource);
+
+            // Memory of transient resources may have been used by other transient resources.
+            const bool isAliased = (virtualResource.type != ResourceType::Imported && virtualResource.firstPass == i);
+            if (isAliased) {
+                D3D12_RESOURCE_BARRIER barrier;
+                barrier.Type                     = D3D12_RESOURCE_BARRIER_TYPE_ALIASING;
+                barrier.Flags                    = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+                barrier.Aliasing.pResourceBefore = nullptr;
+                barrier.Aliasing.pResourceAfter  = resource->resource.Get();
+                pass.barriers.push_back(barrier);
+            }
+
+            // Aliased and newly placed render targets must be initialized. Discarding is cheaper than clearing.
+            const bool isUninitialized = isAliased || (virtualResource.firstPass == i && resource->isUninitialized);
+            if (isUninitialized && access.isWrite && !access.isRead &&
+                (access.state == D3D12_RESOURCE_STATE_RENDER_TARGET ||
+                 access.state == D3D12_RESOURCE_STATE_DEPTH_WRITE))
+                pass.discards.push_back(resource);
+
+            D3D12_RESOURCE_BARRIER barrier;
+            if (state == D3D12_RESOURCE_STATE_UNORDERED_ACCESS && access.state == state) {
+                // Unordered accesses in different passes must not overlap.
+                barrier.Type          = D3D12_RESOURCE_BARRIER_TYPE_UAV;
+                barrier.Flags         = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+                barrier.UAV.pResource = resource->resource.Get();
+            } else if (IsStateCompatible(state, access.state)) {
+                continue;
+            } else {
+                barrier.Type                   = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+                barrier.Flags                  = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+                barrier.Transition.pResource   = resource->resource.Get();
+                barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+                barrier.Transition.StateBefore = state;
+                barrier.Transition.StateAfter  = access.state;
+
+                state = access.state;
+            }
+
+            pass.barriers.push_back(barrier);
+        }
+    }
+
+    for (const auto &resource : resources) {
+        if (!resource.hasFinalState)
+            continue;
+
+        D3D12_RESOURCE_STATES &state = currentState(resource.resource);
+        if (state == resource.finalState)
+            continue;
+
+        D3D12_RESOURCE_BARRIER barrier;
+        barrier.Type                   = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+        barrier.Flags                  = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+        barrier.Transition.pResource   = resource.resource->resource.Get();
+        barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+        barrier.Transition.StateBefore = state;
+        barrier.Transition.StateAfter  = resource.finalState;
+
+        state = resource.finalState;
+        finalBarriers.push_back(barrier);
+    }
+}
+
+auto YaGE::RenderGraph::RecordPasses(CommandBuffer &commandBuffer, size_t first, size_t last) -> void {
+    // Resource states are managed by the render graph during pass execution.
+    commandBuffer.stateTracking = false;
+
+#ifndef NDEBUG
+    // Resources used without declaration would not be transitioned. Let the command buffer assert on them.
+    std::vector<GpuResource *> declaredResources;
+    commandBuffer.declaredResources = &declaredResources;
+#endif
+
+    try {
+        for (size_t i = first; i < last; ++i) {
+            Pass &pass = passes[schedule[i]];
+            for (const auto &barrier : pass.barriers)
+                commandBuffer.QueueBarrier(barrier);
+
+            for (GpuResource *resource : pass.discards)
+                commandBuffer.DiscardResource(*resource);
+
+#ifndef NDEBUG
+            declaredResources.clear();
+            for (const auto &access : pass.accesses)
+                declaredResources.push_back(resources[access.resource].resource);
+#endif
+
+            pass.execute(commandBuffer);
+        }
+    } catch (...) {
+        commandBuffer.stateTracking     = true;
+        commandBuffer.declaredResources = nullptr;
+        throw;
+    }
+
+    commandBuffer.stateTracking     = true;
+    commandBuffer.declaredResources = nullptr;
+}
+
+auto YaGE::RenderGraph::Clear() noexcept -> void {
+    resources.clear();
+    passes.clear();
+    schedule.clear();
+    finalBarriers.clear();
+    finalStates.clear();
+}
@@ -0,0 +1,395 @@
+#pragma once
+
+#include "../Core/String.h"
+#include "CommandBuffer.h"
+#include "TransientResourceAllocator.h"
+
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace YaGE {
+
+class RenderGraph;
+class RenderGraphBuilder;
+
+class RenderGraphResource {
+public:
+    /// @brief
+    ///   Create a null render graph resource handle.
+    RenderGraphResource() noexcept : index(UINT32_MAX) {}
+
+    /// @brief
+    ///   Checks if this is a null render graph resource handle.
+    ///
+    /// @return bool
+    /// @retval true    This is a null render graph resource handle.
+    /// @retval false   This is not a null render graph resource handle.
+    YAGE_NODISCARD auto IsNull() const noexcept -> bool { return index == UINT32_MAX; }
+
+    friend class RenderGraph;
+    friend class RenderGraphBuilder;
+
+private:
+    /// @brief
+    ///   For internal usage. Create a render graph resource handle from index of the virtual resource.
+    ///
+    /// @param index    Index of the virtual resource in the render graph.
+    explicit RenderGraphResource(uint32_t index) noexcept : index(index) {}
+
+private:
+    /// @brief  Index of the virtual resource in the render graph.
+    uint32_t index;
+};
+
+class RenderGraphBuilder {
+public:
+    /// @brief
+    ///   Declare that the current pass reads the specified resource.
+    ///
+    /// @param resource The resource to be read.
+    /// @param state    The state that the resource should be in when the pass is executed.
+    ///
+    /// @throw Exception
+    ///   Thrown if @p state could not be combined with other states of the same resource that are declared by this pass.
+    YAGE_API auto Read(RenderGraphResource   resource,
+                       D3D12_RESOURCE_STATES state = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE |
+                                                     D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE) -> void;
+
+    /// @brief
+    ///   Declare that the current pass writes the specified resource.
+    ///
+    /// @param resource The resource to be written.
+    /// @param state    The state that the resource should be in when the pass is executed. Must not be a read-only state.
+    ///
+    /// @throw Exception
+    ///   Thrown if @p state is a read-only state, or could not be combined with other states of the same resource that are declared by this pass.
+    YAGE_API auto Write(RenderGraphResource   resource,
+                        D3D12_RESOURCE_STATES state = D3D12_RESOURCE_STATE_RENDER_TARGET) -> void;
+
+    /// @brief
+    ///   Mark the current pass as having side effects. Passes with side effects are never culled.
+    auto HasSideEffect() noexcept -> void { sideEffect = true; }
+
+    friend class RenderGraph;
+
+private:
+    /// @brief
+    ///   For internal usage. Create a builder for the specified pass.
+    ///
+    /// @param graph        The render graph that the pass belongs to.
+    /// @param passIndex    Index of the pass in the render graph.
+    RenderGraphBuilder(RenderGraph &graph, uint32_t passIndex) noexcept
+        : graph(graph), passIndex(passIndex), sideEffect(false) {}
+
+private:
+    /// @brief  The render graph that the pass belongs to.
+    RenderGraph &graph;
+
+    /// @brief  Index of the pass in the render graph.
+    uint32_t passIndex;
+
+    /// @brief  Whether the pass has side effects.
+    bool sideEffect;
+};
+
+class RenderGraph {
+public:
+    /// @brief
+    ///   Create an empty render graph.
+    ///
+    /// @param maxCommandBuffers    Maximum number of command buffers that passes are recorded on in parallel. Pass 0 to use number of worker threads of the ThreadPool singleton plus 1.
+    YAGE_API explicit RenderGraph(uint32_t maxCommandBuffers = 0);
+
+    /// @brief
+    ///   Copy constructor is disabled.
+    RenderGraph(const RenderGraph &) = delete;
+
+    /// @brief
+    ///   Copy assignment is disabled.
+    auto operator=(const RenderGraph &) = delete;
+
+    /// @brief
+    ///   Destroy this render graph. This method waits for the last execution to finish on GPU.
+    YAGE_API ~RenderGraph() noexcept;
+
+    /// @brief
+    ///   Import an external color buffer into this render graph.
+    /// @remarks
+    ///   Imported resources are never released by the render graph. Passes that write imported resources are never culled.
+    ///
+    /// @param[in] colorBuffer  The color buffer to be imported. The color buffer must be alive until this render graph has been executed.
+    ///
+    /// @return RenderGraphResource
+    ///   Return handle to the imported resource.
+    YAGE_API auto ImportColorBuffer(ColorBuffer &colorBuffer) -> RenderGraphResource;
+
+    /// @brief
+    ///   Import an external color buffer into this render graph and transition it to @p finalState once all passes are done.
+    ///
+    /// @param[in] colorBuffer  The color buffer to be imported. The color buffer must be alive until this render graph has been executed.
+    /// @param     finalState   The state that the color buffer should be in after this render graph is executed. For example, @p D3D12_RESOURCE_STATE_PRESENT for swap chain back buffers.
+    ///
+    /// @return RenderGraphResource
+    ///   Return handle to the imported resource.
+    YAGE_API auto ImportColorBuffer(ColorBuffer &colorBuffer, D3D12_RESOURCE_STATES finalState) -> RenderGraphResource;
+
+    /// @brief
+    ///   Import an external depth buffer into this render graph.
+    ///
+    /// @param[in] depthBuffer  The depth buffer to be imported. The depth buffer must be alive until this render graph has been executed.
+    ///
+    /// @return RenderGraphResource
+    ///   Return handle to the imported resource.
+    YAGE_API auto ImportDepthBuffer(DepthBuffer &depthBuffer) -> RenderGraphResource;
+
+    /// @brief
+    ///   Import an external GPU resource, such as a buffer or a texture, into this render graph.
+    ///
+    /// @param[in] resource The GPU resource to be imported. The resource must be alive until this render graph has been executed.
+    ///
+    /// @return RenderGraphResource
+    ///   Return handle to the imported resource.
+    YAGE_API auto ImportResource(GpuResource &resource) -> RenderGraphResource;
+
+    /// @brief
+    ///   Declare a transient color buffer.
+    /// @remarks
+    ///   Transient color buffers are placed in heaps that are owned by the render graph and only live during execution of the render graph. Transient resources with non-overlapping lifetimes alias the same heap memory, and aliasing barriers are recorded automatically. Content of transient resources is undefined before the first pass that writes it. Transient render targets that are first written as render targets are discarded before the pass, so the pass should clear them or fully overwrite them.
+    ///
+    /// @param width        Width in pixel of the color buffer.
+    /// @param height       Height in pixel of the color buffer.
+    /// @param format       Pixel format of the color buffer.
+    /// @param sampleCount  Number of samples of the color buffer.
+    ///
+    /// @return RenderGraphResource
+    ///   Return handle to the transient resource.
+    YAGE_API auto CreateColorBuffer(uint32_t width, uint32_t height, DXGI_FORMAT format, uint32_t sampleCount = 1)
+        -> RenderGraphResource;
+
+    /// @brief
+    ///   Declare a transient depth buffer.
+    ///
+    /// @param width        Width in pixel of the depth buffer.
+    /// @param height       Height in pixel of the depth buffer.
+    /// @param format       Pixel format of the depth buffer.
+    /// @param sampleCount  Number of samples of the depth buffer.
+    ///
+    /// @return RenderGraphResource
+    ///   Return handle to the transient resource.
+    YAGE_API auto CreateDepthBuffer(uint32_t width, uint32_t height, DXGI_FORMAT format, uint32_t sampleCount = 1)
+        -> RenderGraphResource;
+
+    /// @brief
+    ///   Add a pass to this render graph.
+    /// @remarks
+    ///   @p setup is called immediately to declare resources that are accessed by this pass. @p execute is called when this render graph is executed, possibly on a worker thread and in parallel with other passes. Resource states are managed by the render graph: barriers are recorded before each pass according to the declared accesses, and automatic transitions of the command buffer are disabled inside @p execute. All resources used by @p execute must be declared in @p setup, which is asserted in debug builds. The pass is not added if @p setup throws.
+    ///
+    /// @param name     Name of this pass.
+    /// @param setup    The function that declares resource accesses of this pass.
+    /// @param execute  The function that records commands of this pass.
+    YAGE_API auto AddPass(StringView                                      name,
+                          const std::function<void(RenderGraphBuilder &)> &setup,
+                          std::function<void(CommandBuffer &)>            execute) -> void;
+
+    /// @brief
+    ///   Make the next execution of this render graph wait for the specified sync point on GPU side.
+    ///
+    /// @param syncPoint    The sync point to be waited for. This could be a sync point of any command queue.
+    auto WaitForSyncPoint(uint64_t syncPoint) -> void { pendingWaitSyncPoints.push_back(syncPoint); }
+
+    /// @brief
+    ///   Cull unused passes, compute resource barriers, allocate transient resources, record passes in parallel and submit them to the direct command queue with a single submission.
+    /// @remarks
+    ///   All passes and resource declarations are cleared after execution, so that this render graph could be rebuilt for the next frame. Heaps and placed transient resources are kept and reused across executions.
+    ///
+    /// @return uint64_t
+    ///   Return a sync point that indicates when all passes finish executing on GPU.
+    /// @throw RenderAPIException
+    ///   Thrown if failed to create transient resources or command buffers.
+    YAGE_API auto Execute() -> uint64_t;
+
+    /// @brief
+    ///   Get the physical color buffer of the specified resource. This method should only be called inside pass execute functions.
+    ///
+    /// @param resource Handle to a color buffer resource.
+    ///
+    /// @return ColorBuffer &
+    ///   Return reference to the physical color buffer.
+    YAGE_NODISCARD auto GetColorBuffer(RenderGraphResource resource) const noexcept -> ColorBuffer & {
+        return *static_cast<ColorBuffer *>(resources[resource.index].resource);
+    }
+
+    /// @brief
+    ///   Get the physical depth buffer of the specified resource. This method should only be called inside pass execute functions.
+    ///
+    /// @param resource Handle to a depth buffer resource.
+    ///
+    /// @return DepthBuffer &
+    ///   Return reference to the physical depth buffer.
+    YAGE_NODISCARD auto GetDepthBuffer(RenderGraphResource resource) const noexcept -> DepthBuffer & {
+        return *static_cast<DepthBuffer *>(resources[resource.index].resource);
+    }
+
+    /// @brief
+    ///   Get the physical GPU resource of the specified resource. This method should only be called inside pass execute functions.
+    ///
+    /// @param resource Handle to a render graph resource.
+    ///
+    /// @return GpuResource &
+    ///   Return reference to the physical GPU resource.
+    YAGE_NODISCARD auto GetResource(RenderGraphResource resource) const noexcept -> GpuResource & {
+        return *resources[resource.index].resource;
+    }
+
+    friend class RenderGraphBuilder;
+
+private:
+    enum class ResourceType {
+        Imported,
+        TransientColor,
+        TransientDepth,
+    };
+
+    struct VirtualResource {
+        /// @brief  Type of this resource.
+        ResourceType type;
+
+        /// @brief  The physical resource. This is nullptr for transient resources until they are allocated.
+        GpuResource *resource;
+
+        /// @brief  Width in pixel of transient resources.
+        uint32_t width;
+
+        /// @brief  Height in pixel of transient resources.
+        uint32_t height;
+
+        /// @brief  Pixel format of transient resources.
+        DXGI_FORMAT format;
+
+        /// @brief  Number of samples of transient resources.
+        uint32_t sampleCount;
+
+        /// @brief  Whether this resource should be transitioned to @p finalState after execution.
+        bool hasFinalState;
+
+        /// @brief  State of this resource after execution.
+        D3D12_RESOURCE_STATES finalState;
+
+        /// @brief  Index of the first scheduled pass that accesses this resource.
+        uint32_t firstPass;
+
+        /// @brief  Index of the last scheduled pass that accesses this resource.
+        uint32_t lastPass;
+    };
+
+    struct ResourceAccess {
+        /// @brief  Index of the accessed virtual resource.
+        uint32_t resource;
+
+        /// @brief  Required state of the resource.
+        D3D12_RESOURCE_STATES state;
+
+        /// @brief  Whether the resource is read by the pass.
+        bool isRead;
+
+        /// @brief  Whether the resource is written by the pass.
+        bool isWrite;
+    };
+
+    struct Pass {
+        /// @brief  Name of this pass.
+        String name;
+
+        /// @brief  The function that records commands of this pass.
+        std::function<void(CommandBuffer &)> execute;
+
+        /// @brief  Resources that are accessed by this pass.
+        std::vector<ResourceAccess> accesses;
+
+        /// @brief  Passes with side effects are never culled.
+        bool sideEffect;
+
+        /// @brief  Resource barriers that should be recorded before this pass.
+        std::vector<D3D12_RESOURCE_BARRIER> barriers;
+
+        /// @brief  Aliased transient resources that should be discarded before this pass.
+        std::vector<GpuResource *> discards;
+    };
+
+    /// @brief
+    ///   Add an access of the specified resource to the specified pass. Accesses of the same resource are merged.
+    ///
+    /// @param passIndex    Index of the pass.
+    /// @param resource     The accessed resource.
+    /// @param state        Required state of the resource.
+    /// @param isWrite      Whether the resource is written.
+    ///
+    /// @throw Exception
+    ///   Thrown if a write access uses a read-only state, or the merged state of the resource is not a valid resource state, for example a write state combined with any other state.
+    auto AddAccess(uint32_t passIndex, RenderGraphResource resource, D3D12_RESOURCE_STATES state, bool isWrite) -> void;
+
+    /// @brief
+    ///   Cull passes whose results are never used and fill @p schedule with indices of remaining passes.
+    auto CullPasses() -> void;
+
+    /// @brief
+    ///   Allocate physical resources for transient resources. Memory of transient resources is released after their last scheduled pass so that transient resources with non-overlapping lifetimes alias the same heap memory.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to create transient resources.
+    auto AllocateTransientResources() -> void;
+
+    /// @brief
+    ///   Compute resource barriers and discards of each scheduled pass and final barriers.
+    auto ComputeBarriers() -> void;
+
+    /// @brief
+    ///   Record the specified range of scheduled passes on the specified command buffer.
+    ///
+    /// @param commandBuffer    The command buffer to record passes on.
+    /// @param first            Index of the first scheduled pass to be recorded.
+    /// @param last             Index after the last scheduled pass to be recorded.
+    auto RecordPasses(CommandBuffer &commandBuffer, size_t first, size_t last) -> void;
+
+    /// @brief
+    ///   Clear all passes and resource declarations.
+    auto Clear() noexcept -> void;
+
+private:
+    /// @brief  The render device that is used to submit command buffers.
+    RenderDevice &renderDevice;
+
+    /// @brief  Maximum number of command buffers that passes are recorded on in parallel.
+    uint32_t maxCommandBuffers;
+
+    /// @brief  Declared virtual resources.
+    std::vector<VirtualResource> resources;
+
+    /// @brief  Declared passes.
+    std::vector<Pass> passes;
+
+    /// @brief  Indices of passes that are not culled, in execution order.
+    std::vector<uint32_t> schedule;
+
+    /// @brief  Resource barriers that should be recorded after all passes.
+    std::vector<D3D12_RESOURCE_BARRIER> finalBarriers;
+
+    /// @brief  Simulated states of physical resources after all passes.
+    std::unordered_map<GpuResource *, D3D12_RESOURCE_STATES> finalStates;
+
+    /// @brief  The allocator that transient resources are placed by. Heaps and placed resources are reused across executions.
+    TransientResourceAllocator transientAllocator;
+
+    /// @brief  Command buffers that passes are recorded on.
+    std::vector<std::unique_ptr<CommandBuffer>> commandBuffers;
+
+    /// @brief  Sync points that the next execution should wait for.
+    std::vector<uint64_t> pendingWaitSyncPoints;
+
+    /// @brief  The sync point that indicates when last execution will be finished.
+    uint64_t lastSyncPoint;
+};
+
+} // namespace YaGE
@@ -1,14 +1,94 @@
 #include "RootSignature.h"
 #include "../Core/Exception.h"
+#include "../Core/Hash.h"
 #include "RenderDevice.h"
 
 #include <d3dcompiler.h>
 
+#include <climits>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 using namespace YaGE;
 using Microsoft::WRL::ComPtr;
 
+namespace {
+
+class RootSignatureRegistry {
+public:
+    /// @brief
+    ///   Create an empty root signature registry.
+    RootSignatureRegistry() noexcept : entries(), mutex() {}
+
+    /// @brief
+    ///   Get or create a D3D12 root signature for the specified serialized root signature.
+    ///
+    /// @param device   D3D12 device that is used to create root signatures.
+    /// @param data     Pointer to start of the serialized root signature.
+    /// @param size     Size in byte of the serialized root signature.
+    /// @param hash     Hash value of the serialized root signature.
+    ///
+    /// @return ComPtr<ID3D12RootSignature>
+    ///   Return the shared D3D12 root signature object.
+    /// @throw RenderAPIException
+    ///   Thrown if failed to create the root signature.
+    YAGE_NODISCARD auto Acquire(ID3D12Device1 *device, const void *data, size_t size, uint64_t hash)
+        -> ComPtr<ID3D12RootSignature>;
+
+    /// @brief
+    ///   Get the singleton instance of root signature registry.
+    ///
+    /// @return RootSignatureRegistry &
+    ///   Return reference to the root signature registry singleton instance.
+    YAGE_NODISCARD static auto Singleton() -> RootSignatureRegistry &;
+
+private:
+    struct Entry {
+        /// @brief  The serialized root signature. Used to resolve hash collisions.
+        std::vector<uint8_t> serialized;
+
+        /// @brief  The shared D3D12 root signature object.
+        ComPtr<ID3D12RootSignature> rootSignature;
+    };
+
+    /// @brief  Registered root signatures. Indexed by hash value of serialized root signature.
+    std::unordered_multimap<uint64_t, Entry> entries;
+
+    /// @brief  Mutex to protect registered root signatures.
+    std::mutex mutex;
+};
+
+YAGE_NODISCARD auto RootSignatureRegistry::Acquire(ID3D12Device1 *device, const void *data, size_t size, uint64_t hash)
+    -> ComPtr<ID3D12RootSignature> {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto range = entries.equal_range(hash);
+    for (auto iter = range.first; iter != range.second; ++iter) {
+        const auto &serialized = iter->second.serialized;
+        if (serialized.size() == size && memcmp(serialized.data(), data, size) == 0)
+            return iter->second.rootSignature;
+    }
+
+    ComPtr<ID3D12RootSignature> rootSignature;
+    HRESULT hr = device->CreateRootSignature(0, data, size, IID_PPV_ARGS(rootSignature.GetAddressOf()));
+    if (FAILED(hr))
+        throw RenderAPIException(hr, u"Failed to create root signature.");
+
+    const auto *bytes = static_cast<const uint8_t *>(data);
+    entries.emplace(hash, Entry{std::vector<uint8_t>(bytes, bytes + size), rootSignature});
+
+    return rootSignature;
+}
+
+YAGE_NODISCARD auto RootSignatureRegistry::Singleton() -> RootSignatureRegistry & {
+    static RootSignatureRegistry instance;
+    return instance;
+}
+
+} // namespace
+
 YaGE::RootSignature::RootSignature(const D3D12_ROOT_SIGNATURE_DESC &desc)
     : rootSignature(),
       tableDescriptorCount(),
@@ -16,7 +96,9 @@ YaGE::RootSignature::RootSignature(const D3D12_ROOT_SIGNATURE_DESC &desc)
       samplerCount(),
       descriptorTableFlags(),
       samplerTableFlags(),
-      descriptorTableSizes() {
+      bindlessTableFlags(),
+      descriptorTableSizes(),
+      serializedHash() {
     // Serialize root signature desc.
     HRESULT          hr = S_OK;
     ComPtr<ID3DBlob> serializedDesc;
@@ -25,12 +107,11 @@ YaGE::RootSignature::RootSignature(const D3D12_ROOT_SIGNATURE_DESC &desc)
     if (FAILED(hr))
         throw RenderAPIException(hr, u"Failed to serialize root signature.");
 
-    // Create root signature.
+    // Identical root signatures share the same D3D12 root signature object.
     RenderDevice &device = RenderDevice::Singleton();
-    hr = device.Device()->CreateRootSignature(0, serializedDesc->GetBufferPointer(), serializedDesc->GetBufferSize(),
-                                              IID_PPV_ARGS(rootSignature.GetAddressOf()));
-    if (FAILED(hr))
-        throw RenderAPIException(hr, u"Failed to create root signature.");
+    serializedHash       = FastHash64(serializedDesc->GetBufferPointer(), serializedDesc->GetBufferSize());
+    rootSignature        = RootSignatureRegistry::Singleton().Acquire(
+        device.Device(), serializedDesc->GetBufferPointer(), serializedDesc->GetBufferSize(), serializedHash);
 
     // Cache metadata.
     staticSamplerCount = desc.NumStaticSamplers;
@@ -41,6 +122,16 @@ YaGE::RootSignature::RootSignature(const D3D12_ROOT_SIGNATURE_DESC &desc)
             const uint32_t numRanges = param.DescriptorTable.NumDescriptorRanges;
             const auto    *ranges    = param.DescriptorTable.pDescriptorRanges;
 
+            // Unbounded descriptor tables are bound to the bindless region of global descriptor heaps directly.
+            bool isBindless = false;
+            for (uint32_t j = 0; j < numRanges; ++j)
+                isBindless = isBindless || (ranges[j].NumDescriptors == UINT_MAX);
+
+            if (isBindless) {
+                bindlessTableFlags[i] = 1;
+                continue;
+            }
+
             for (uint32_t j = 0; j < numRanges; ++j)
                 descriptorTableSizes[i] += ranges[j].NumDescriptors;
 
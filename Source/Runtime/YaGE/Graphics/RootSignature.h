@@ -13,6 +13,8 @@ class RootSignature {
 public:
     /// @brief
     ///   Create a new root signature.
+    /// @remarks
+    ///   Root signatures with the same serialized description share the same D3D12 root signature object, so @p D3D12RootSignature() could be used to check whether two root signatures have the same layout.
     ///
     /// @param[in] desc     Root signature description that describes how to create this root signature.
     ///
@@ -73,6 +75,16 @@ public:
     /// @retval false The specified root parameter is not a sampler descriptor table.
     YAGE_NODISCARD auto IsSamplerTable(uint32_t slot) const noexcept -> bool { return samplerTableFlags[slot]; }
 
+    /// @brief
+    ///   Checks if the specified root parameter is a bindless descriptor table. Descriptor tables that contain unbounded descriptor ranges are bindless descriptor tables. Bindless descriptor tables are not managed by dynamic descriptor heaps and should be bound to the bindless region of global descriptor heaps.
+    ///
+    /// @param slot Root parameter index.
+    ///
+    /// @return
+    /// @retval true  The specified root parameter is a bindless descriptor table.
+    /// @retval false The specified root parameter is not a bindless descriptor table.
+    YAGE_NODISCARD auto IsBindlessTable(uint32_t slot) const noexcept -> bool { return bindlessTableFlags[slot]; }
+
     /// @brief
     ///   Get number of descriptors in the specified non-sampler descriptor table.
     ///
@@ -106,6 +118,13 @@ public:
     ///   Return D3D12 root signature object.
     YAGE_NODISCARD auto D3D12RootSignature() const noexcept -> ID3D12RootSignature * { return rootSignature.Get(); }
 
+    /// @brief
+    ///   Get hash value of the serialized root signature. Root signatures created from the same description always have the same hash value.
+    ///
+    /// @return uint64_t
+    ///   Return hash value of the serialized root signature.
+    YAGE_NODISCARD auto Hash() const noexcept -> uint64_t { return serializedHash; }
+
 private:
     /// @brief  D3D12 root signature object.
     Microsoft::WRL::ComPtr<ID3D12RootSignature> rootSignature;
@@ -125,8 +144,14 @@ private:
     /// @brief  One bit is set for sampler root descriptor table.
     std::bitset<64> samplerTableFlags;
 
+    /// @brief  One bit is set for bindless root descriptor table.
+    std::bitset<64> bindlessTableFlags;
+
     /// @brief  Number of descriptors in each descriptor table.
     uint32_t descriptorTableSizes[64];
+
+    /// @brief  Hash value of the serialized root signature.
+    uint64_t serializedHash;
 };
 
 } // namespace YaGE
@@ -0,0 +1,75 @@
+#include "ShaderLibrary.h"
+#include "../Core/Exception.h"
+#include "../Core/Hash.h"
+
+using namespace YaGE;
+
+namespace {
+
+/// @brief  Packed file format of shader libraries.
+constexpr const PackedFileFormat SHADER_LIBRARY_FORMAT{
+    /* magic         = */ ShaderLibrary::MAGIC,
+    /* version       = */ ShaderLibrary::VERSION,
+    /* entrySize     = */ sizeof(ShaderEntry),
+    /* dataAlignment = */ ShaderLibrary::BYTECODE_ALIGNMENT,
+    /* kind          = */ u"shader library",
+};
+
+} // namespace
+
+YaGE::ShaderLibrary::ShaderLibrary() noexcept : packedFile() {}
+
+YaGE::ShaderLibrary::ShaderLibrary(StringView path) : packedFile(path, SHADER_LIBRARY_FORMAT) {}
+
+YaGE::ShaderLibrary::ShaderLibrary(ShaderLibrary &&other) noexcept : packedFile(std::move(other.packedFile)) {}
+
+auto YaGE::ShaderLibrary::operator=(ShaderLibrary &&other) noexcept -> ShaderLibrary & {
+    packedFile = std::move(other.packedFile);
+    return *this;
+}
+
+YaGE::ShaderLibrary::~ShaderLibrary() noexcept {}
+
+auto YaGE::ShaderLibrary::Find(StringView name) const noexcept -> const ShaderEntry * {
+    return reinterpret_cast<const ShaderEntry *>(packedFile.Find(name));
+}
+
+auto YaGE::ShaderLibrary::Bytecode(StringView name) const -> D3D12_SHADER_BYTECODE {
+    const ShaderEntry *entry = Find(name);
+    if (entry == nullptr)
+        throw SystemErrorException(HRESULT_FROM_WIN32(ERROR_NOT_FOUND),
+                                   Format(u"Shader permutation not found in shader library: {}.", name));
+    return Bytecode(*entry);
+}
+
+auto YaGE::ShaderLibrary::HashName(StringView name) noexcept -> uint64_t {
+    return PackedFile::HashName(name);
+}
+
+YaGE::ShaderLibraryWriter::ShaderLibraryWriter() noexcept : shaders() {}
+
+YaGE::ShaderLibraryWriter::~ShaderLibraryWriter() noexcept {}
+
+auto YaGE::ShaderLibraryWriter::AddShader(StringView name, ShaderStage stage, const void *bytecode, size_t size)
+    -> void {
+    PendingShader shader{};
+    shader.name               = name;
+    shader.entry.nameHash     = ShaderLibrary::HashName(name);
+    shader.entry.size         = size;
+    shader.entry.bytecodeHash = Hash64(bytecode, size);
+    shader.entry.stage        = stage;
+
+    const auto *bytes = static_cast<const uint8_t *>(bytecode);
+    shader.bytecode.assign(bytes, bytes + size);
+
+    shaders.push_back(std::move(shader));
+}
+
+auto YaGE::ShaderLibraryWriter::Save(StringView path) const -> void {
+    std::vector<PackedFileItem> items;
+    items.reserve(shaders.size());
+    for (const PendingShader &shader : shaders)
+        items.push_back({shader.name, &shader.entry, shader.bytecode.data(), shader.bytecode.size()});
+
+    PackedFile::Save(path, SHADER_LIBRARY_FORMAT, items.size(), items.data());
+}
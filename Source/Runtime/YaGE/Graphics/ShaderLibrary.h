@@ -0,0 +1,239 @@
+#pragma once
+
+#include "../Core/PackedFile.h"
+
+#include <d3d12.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace YaGE {
+
+/// @brief
+///   Pipeline stage of shaders in shader library.
+enum class ShaderStage : uint32_t {
+    Vertex        = 0,
+    Pixel         = 1,
+    Domain        = 2,
+    Hull          = 3,
+    Geometry      = 4,
+    Compute       = 5,
+    Amplification = 6,
+    Mesh          = 7,
+    RayTracing    = 8,
+};
+
+/// @brief
+///   Table of contents entry of a shader permutation in shader library.
+struct ShaderEntry {
+    /// @brief  64-bit hash value of name of this shader permutation. Entries are sorted by this value.
+    uint64_t nameHash;
+
+    /// @brief  Offset in characters of name of this shader permutation in the name table.
+    uint32_t nameOffset;
+
+    /// @brief  Length in characters of name of this shader permutation.
+    uint32_t nameLength;
+
+    /// @brief  Offset in byte of bytecode of this shader permutation from start of the library file.
+    uint64_t offset;
+
+    /// @brief  Size in byte of bytecode of this shader permutation.
+    uint64_t size;
+
+    /// @brief  64-bit hash value of bytecode of this shader permutation.
+    uint64_t bytecodeHash;
+
+    /// @brief  Pipeline stage of this shader permutation.
+    ShaderStage stage;
+
+    /// @brief  Reserved. Must be 0.
+    uint32_t reserved;
+};
+
+static_assert(sizeof(ShaderEntry) == 48, "Size of ShaderEntry must be 48 bytes.");
+static_assert(offsetof(ShaderEntry, offset) == offsetof(PackedFileEntry, offset) &&
+                  offsetof(ShaderEntry, size) == offsetof(PackedFileEntry, size),
+              "ShaderEntry must start with fields of PackedFileEntry.");
+
+class ShaderLibrary {
+public:
+    /// @brief
+    ///   Create an empty shader library.
+    YAGE_API ShaderLibrary() noexcept;
+
+    /// @brief
+    ///   Open and memory-map a shader library file. Only the header and the table of contents are validated, bytecode is paged in on demand when accessed.
+    ///
+    /// @param path     Path to the shader library file to be opened.
+    ///
+    /// @throw SystemErrorException
+    ///   Thrown if failed to open or map the file, or the file is not a valid shader library.
+    YAGE_API explicit ShaderLibrary(StringView path);
+
+    /// @brief
+    ///   Copy constructor is disabled.
+    ShaderLibrary(const ShaderLibrary &) = delete;
+
+    /// @brief
+    ///   Copy assignment is disabled.
+    auto operator=(const ShaderLibrary &) = delete;
+
+    /// @brief
+    ///   Move constructor. The moved shader library will be empty.
+    ///
+    /// @param other    The shader library to move from.
+    YAGE_API ShaderLibrary(ShaderLibrary &&other) noexcept;
+
+    /// @brief
+    ///   Move assignment. The moved shader library will be empty.
+    ///
+    /// @param other    The shader library to move from.
+    ///
+    /// @return ShaderLibrary &
+    ///   Return reference to this shader library.
+    YAGE_API auto operator=(ShaderLibrary &&other) noexcept -> ShaderLibrary &;
+
+    /// @brief
+    ///   Unmap and close this shader library. Bytecode returned by this library is invalidated.
+    YAGE_API ~ShaderLibrary() noexcept;
+
+    /// @brief
+    ///   Find a shader permutation by name.
+    /// @remarks
+    ///   Entries are sorted by name hash, so that lookup is a binary search and no lookup table is built when opening the library.
+    ///
+    /// @param name     Name of the shader permutation to be found.
+    ///
+    /// @return const ShaderEntry *
+    ///   Return pointer to table of contents entry of the shader permutation. Return @p nullptr if no such permutation.
+    YAGE_NODISCARD YAGE_API auto Find(StringView name) const noexcept -> const ShaderEntry *;
+
+    /// @brief
+    ///   Get bytecode of the specified shader permutation.
+    /// @remarks
+    ///   The bytecode could be passed to pipeline state descriptions directly and is valid as long as this library is alive. It is not required to keep this library alive after the pipeline state is created.
+    ///
+    /// @param entry    Table of contents entry of the shader permutation.
+    ///
+    /// @return D3D12_SHADER_BYTECODE
+    ///   Return the memory-mapped bytecode of the shader permutation.
+    YAGE_NODISCARD auto Bytecode(const ShaderEntry &entry) const noexcept -> D3D12_SHADER_BYTECODE {
+        return {packedFile.Data(entry.offset), static_cast<SIZE_T>(entry.size)};
+    }
+
+    /// @brief
+    ///   Get bytecode of the specified shader permutation by name.
+    ///
+    /// @param name     Name of the shader permutation.
+    ///
+    /// @return D3D12_SHADER_BYTECODE
+    ///   Return the memory-mapped bytecode of the shader permutation.
+    ///
+    /// @throw SystemErrorException
+    ///   Thrown if no such shader permutation in this library.
+    YAGE_NODISCARD YAGE_API auto Bytecode(StringView name) const -> D3D12_SHADER_BYTECODE;
+
+    /// @brief
+    ///   Get name of the specified shader permutation.
+    ///
+    /// @param entry    Table of contents entry of the shader permutation.
+    ///
+    /// @return StringView
+    ///   Return name of the shader permutation. The name is not null-terminated.
+    YAGE_NODISCARD auto Name(const ShaderEntry &entry) const noexcept -> StringView {
+        return packedFile.Name(entry.nameOffset, entry.nameLength);
+    }
+
+    /// @brief
+    ///   Get number of shader permutations in this library.
+    ///
+    /// @return uint32_t
+    ///   Return number of shader permutations in this library.
+    YAGE_NODISCARD auto EntryCount() const noexcept -> uint32_t { return packedFile.EntryCount(); }
+
+    /// @brief
+    ///   Get table of contents of this library.
+    ///
+    /// @return const ShaderEntry *
+    ///   Return pointer to the first table of contents entry.
+    YAGE_NODISCARD auto Entries() const noexcept -> const ShaderEntry * {
+        return static_cast<const ShaderEntry *>(packedFile.Entries());
+    }
+
+    /// @brief
+    ///   Calculate hash value of shader permutation name.
+    ///
+    /// @param name     Name of the shader permutation.
+    ///
+    /// @return uint64_t
+    ///   Return hash value of the shader permutation name.
+    YAGE_NODISCARD YAGE_API static auto HashName(StringView name) noexcept -> uint64_t;
+
+    /// @brief  Magic number of shader library files. "YAGS" in little endian.
+    static constexpr const uint32_t MAGIC = 0x53474159;
+
+    /// @brief  Version of shader library file format.
+    static constexpr const uint32_t VERSION = 1;
+
+    /// @brief  Alignment of bytecode in shader library files.
+    static constexpr const uint64_t BYTECODE_ALIGNMENT = 16;
+
+private:
+    /// @brief  The memory-mapped library file.
+    PackedFile packedFile;
+};
+
+class ShaderLibraryWriter {
+public:
+    /// @brief
+    ///   Create an empty shader library writer.
+    YAGE_API ShaderLibraryWriter() noexcept;
+
+    /// @brief
+    ///   Copy constructor is disabled.
+    ShaderLibraryWriter(const ShaderLibraryWriter &) = delete;
+
+    /// @brief
+    ///   Copy assignment is disabled.
+    auto operator=(const ShaderLibraryWriter &) = delete;
+
+    /// @brief
+    ///   Destroy this shader library writer and release all pending shaders.
+    YAGE_API ~ShaderLibraryWriter() noexcept;
+
+    /// @brief
+    ///   Add a compiled shader permutation to this library.
+    ///
+    /// @param      name        Name of the shader permutation. Names must be unique in a library.
+    /// @param      stage       Pipeline stage of the shader permutation.
+    /// @param[in]  bytecode    Compiled bytecode of the shader permutation.
+    /// @param      size        Size in byte of the bytecode.
+    YAGE_API auto AddShader(StringView name, ShaderStage stage, const void *bytecode, size_t size) -> void;
+
+    /// @brief
+    ///   Write all added shader permutations to a shader library file.
+    ///
+    /// @param path     Path to the shader library file to be written.
+    ///
+    /// @throw SystemErrorException
+    ///   Thrown if failed to write the file.
+    YAGE_API auto Save(StringView path) const -> void;
+
+private:
+    struct PendingShader {
+        /// @brief  Name of this shader permutation.
+        String name;
+
+        /// @brief  Table of contents entry of this shader permutation. Offsets are resolved when saving.
+        ShaderEntry entry;
+
+        /// @brief  Bytecode of this shader permutation.
+        std::vector<uint8_t> bytecode;
+    };
+
+    /// @brief  Shader permutations to be written.
+    std::vector<PendingShader> shaders;
+};
+
+} // namespace YaGE
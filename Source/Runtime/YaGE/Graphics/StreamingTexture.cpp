@@ -0,0 +1,539 @@
+#include "StreamingTexture.h"
+#include "../Core/Exception.h"
+#include "../Core/ThreadPool.h"
+#include "CommandBuffer.h"
+#include "RenderDevice.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+using namespace YaGE;
+using Microsoft::WRL::ComPtr;
+
+YaGE::StreamingTexture::StreamingTexture(DDSImage &&source)
+    : PixelBuffer(),
+      image(std::move(source)),
+      isCubeTexture(image.IsCubeMap()),
+      srv(),
+      standardMipCount(),
+      packedTileCount(),
+      tilings(),
+      mipTiles(),
+      requestedMip(0),
+      residentMip(image.MipLevels()),
+      pendingMip(image.MipLevels()),
+      pendingSyncPoint(0),
+      pendingUpload() {
+    RenderDevice &renderDevice = RenderDevice::Singleton();
+    if (!renderDevice.SupportTiledResources())
+        throw RenderAPIException(DXGI_ERROR_UNSUPPORTED, u"Tiled resources are not supported by current device.");
+
+    this->width       = image.Width();
+    this->height      = image.Height();
+    this->arraySize   = image.ArraySize();
+    this->sampleCount = 1;
+    this->mipLevels   = image.MipLevels();
+    this->pixelFormat = image.PixelFormat();
+
+    { // Create reserved resource.
+        const D3D12_RESOURCE_DESC desc{
+            /* Dimension        = */ D3D12_RESOURCE_DIMENSION_TEXTURE2D,
+            /* Alignment        = */ 0,
+            /* Width            = */ width,
+            /* Height           = */ height,
+            /* DepthOrArraySize = */ static_cast<UINT16>(arraySize),
+            /* MipLevels        = */ static_cast<UINT16>(mipLevels),
+            /* Format           = */ pixelFormat,
+            /* SampleDesc       = */
+            {
+                /* Count   = */ 1,
+                /* Quality = */ 0,
+            },
+            /* Layout = */ D3D12_TEXTURE_LAYOUT_64KB_UNDEFINED_SWIZZLE,
+            /* Flags  = */ D3D12_RESOURCE_FLAG_NONE,
+        };
+
+        HRESULT hr = CreateReservedResource(desc, D3D12_RESOURCE_STATE_COMMON);
+        if (FAILED(hr))
+            throw RenderAPIException(hr, u"Failed to create reserved resource for StreamingTexture.");
+    }
+
+    { // Query tiling of standard mip levels and the mip tail.
+        UINT                  tileCount = 0;
+        D3D12_PACKED_MIP_INFO packedMipInfo{};
+        D3D12_TILE_SHAPE      tileShape{};
+        UINT                  tilingCount = mipLevels;
+
+        tilings.resize(mipLevels);
+        renderDevice.Device()->GetResourceTiling(resource.Get(), &tileCount, &packedMipInfo, &tileShape, &tilingCount,
+                                                 0, tilings.data());
+
+        standardMipCount = packedMipInfo.NumStandardMips;
+        packedTileCount  = (packedMipInfo.NumPackedMips == 0) ? 0 : packedMipInfo.NumTilesForPackedMips;
+        tilings.resize(standardMipCount);
+        mipTiles.resize(standardMipCount + 1);
+    }
+
+    // Create shader resource view.
+    D3D12_SHADER_RESOURCE_VIEW_DESC desc;
+    desc.Format                  = pixelFormat;
+    desc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+    if (isCubeTexture && arraySize > 6) {
+        desc.ViewDimension                        = D3D12_SRV_DIMENSION_TEXTURECUBEARRAY;
+        desc.TextureCubeArray.MostDetailedMip     = 0;
+        desc.TextureCubeArray.MipLevels           = mipLevels;
+        desc.TextureCubeArray.First2DArrayFace    = 0;
+        desc.TextureCubeArray.NumCubes            = arraySize / 6;
+        desc.TextureCubeArray.ResourceMinLODClamp = 0.0f;
+    } else if (isCubeTexture) {
+        desc.ViewDimension                   = D3D12_SRV_DIMENSION_TEXTURECUBE;
+        desc.TextureCube.MostDetailedMip     = 0;
+        desc.TextureCube.MipLevels           = mipLevels;
+        desc.TextureCube.ResourceMinLODClamp = 0.0f;
+    } else if (arraySize > 1) {
+        desc.ViewDimension                      = D3D12_SRV_DIMENSION_TEXTURE2DARRAY;
+        desc.Texture2DArray.MostDetailedMip     = 0;
+        desc.Texture2DArray.MipLevels           = mipLevels;
+        desc.Texture2DArray.FirstArraySlice     = 0;
+        desc.Texture2DArray.ArraySize           = arraySize;
+        desc.Texture2DArray.PlaneSlice          = 0;
+        desc.Texture2DArray.ResourceMinLODClamp = 0.0f;
+    } else {
+        desc.ViewDimension                 = D3D12_SRV_DIMENSION_TEXTURE2D;
+        desc.Texture2D.MostDetailedMip     = 0;
+        desc.Texture2D.MipLevels           = mipLevels;
+        desc.Texture2D.PlaneSlice          = 0;
+        desc.Texture2D.ResourceMinLODClamp = 0.0f;
+    }
+
+    srv.Create(resource.Get(), desc);
+
+    TextureStreamer::Singleton().Register(this);
+}
+
+YaGE::StreamingTexture::~StreamingTexture() noexcept { TextureStreamer::Singleton().Unregister(this); }
+
+auto YaGE::StreamingTexture::RequestMipLevelForScreenSize(float screenSize) noexcept -> void {
+    if (!(screenSize > 0.0f)) {
+        RequestMipLevel(mipLevels - 1);
+        return;
+    }
+
+    const float ratio = static_cast<float>(std::max(width, height)) / screenSize;
+    RequestMipLevel(ratio > 1.0f ? static_cast<uint32_t>(std::log2(ratio)) : 0U);
+}
+
+auto YaGE::StreamingTexture::TileCount(uint32_t mipLevel) const noexcept -> uint32_t {
+    if (mipLevel >= standardMipCount)
+        return packedTileCount * arraySize;
+
+    const D3D12_SUBRESOURCE_TILING &tiling = tilings[mipLevel];
+    return tiling.WidthInTiles * tiling.HeightInTiles * tiling.DepthInTiles * arraySize;
+}
+
+auto YaGE::StreamingTexture::Upload(uint32_t mipLevel, const std::vector<TileMapping> &mappings) -> uint64_t {
+    // Copy command queue executes tile mappings and copy commands in order.
+    ID3D12CommandQueue *queue = RenderDevice::Singleton().CopyQueue();
+    for (const auto &mapping : mappings) {
+        const D3D12_TILE_REGION_SIZE regionSize{
+            /* NumTiles = */ mapping.tiles.tileCount,
+            /* UseBox   = */ FALSE,
+            /* Width    = */ 0,
+            /* Height   = */ 0,
+            /* Depth    = */ 0,
+        };
+
+        const D3D12_TILE_RANGE_FLAGS rangeFlags = D3D12_TILE_RANGE_FLAG_NONE;
+        const UINT                   rangeStart = mapping.tiles.firstTile;
+        const UINT                   rangeCount = mapping.tiles.tileCount;
+
+        queue->UpdateTileMappings(resource.Get(), 1, &mapping.coordinate, &regionSize, mapping.heap, 1, &rangeFlags,
+                                  &rangeStart, &rangeCount, D3D12_TILE_MAPPING_FLAG_NONE);
+    }
+
+    // The whole mip tail is uploaded together.
+    const uint32_t count = (mipLevel >= standardMipCount) ? mipLevels - mipLevel : 1;
+
+    CommandBuffer commandBuffer(D3D12_COMMAND_LIST_TYPE_COPY);
+    for (uint32_t slice = 0; slice < arraySize; ++slice) {
+        const uint32_t first = slice * mipLevels + mipLevel;
+        commandBuffer.CopySubresources(*this, first, count, image.Subresources() + first);
+    }
+
+    return commandBuffer.Submit();
+}
+
+YaGE::TextureStreamer::TextureStreamer() noexcept
+    : textures(), heaps(), retiredTiles(), maxBudget(0), budget(UINT64_MAX), usedSize(0), mutex() {}
+
+YaGE::TextureStreamer::~TextureStreamer() noexcept {}
+
+auto YaGE::TextureStreamer::Update() noexcept -> void {
+    RenderDevice &renderDevice = RenderDevice::Singleton();
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Free retired tiles that are no longer used by GPU.
+    for (auto iter = retiredTiles.begin(); iter != retiredTiles.end();) {
+        if (renderDevice.IsSyncPointReached(iter->syncPoint)) {
+            FreeTiles(iter->tiles);
+            iter = retiredTiles.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+
+    UpdateBudget();
+
+    // Finished uploads become resident.
+    uint32_t pendingCount = 0;
+    for (StreamingTexture *texture : textures) {
+        if (texture->pendingMip == texture->mipLevels)
+            continue;
+
+        if (texture->pendingSyncPoint == 0) {
+            if (texture->pendingUpload.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                pendingCount += 1;
+                continue;
+            }
+
+            try {
+                texture->pendingSyncPoint = texture->pendingUpload.get();
+            } catch (...) {
+                // Failed to upload. Tiles are never sampled, so they could be freed immediately and retried later.
+                auto &tiles = texture->mipTiles[std::min(texture->pendingMip, texture->standardMipCount)];
+                FreeTiles(tiles);
+                tiles.clear();
+                texture->pendingMip = texture->mipLevels;
+                continue;
+            }
+        }
+
+        if (!renderDevice.IsSyncPointReached(texture->pendingSyncPoint)) {
+            pendingCount += 1;
+            continue;
+        }
+
+        texture->residentMip.store(texture->pendingMip, std::memory_order_release);
+        texture->pendingMip       = texture->mipLevels;
+        texture->pendingSyncPoint = 0;
+    }
+
+    // Evicted tiles could be reused once GPU finishes all submitted commands.
+    uint64_t evictSyncPoint   = 0;
+    auto     acquireSyncPoint = [&renderDevice, &evictSyncPoint]() -> uint64_t {
+        if (evictSyncPoint == 0)
+            evictSyncPoint = renderDevice.AcquireSyncPoint();
+        return evictSyncPoint;
+    };
+
+    // Evict mip levels that are no longer requested. The mip tail is never evicted.
+    for (StreamingTexture *texture : textures) {
+        if (texture->pendingMip != texture->mipLevels)
+            continue;
+
+        while (texture->ResidentMipLevel() < std::min(texture->RequestedMipLevel(), texture->standardMipCount))
+            EvictMipLevel(*texture, acquireSyncPoint());
+    }
+
+    // Evict the most detailed mip levels until the memory budget is satisfied.
+    const uint64_t currentBudget = budget.load(std::memory_order_relaxed);
+    while (usedSize.load(std::memory_order_relaxed) > currentBudget) {
+        StreamingTexture *victim = nullptr;
+        for (StreamingTexture *texture : textures) {
+            if (texture->pendingMip != texture->mipLevels || texture->ResidentMipLevel() >= texture->standardMipCount)
+                continue;
+
+            if (victim == nullptr || texture->TileCount(texture->ResidentMipLevel()) >
+                                         victim->TileCount(victim->ResidentMipLevel()))
+                victim = texture;
+        }
+
+        if (victim == nullptr)
+            break;
+
+        EvictMipLevel(*victim, acquireSyncPoint());
+    }
+
+    // Upload missing mip levels. Textures that miss more mip levels are uploaded first.
+    try {
+        std::vector<StreamingTexture *> candidates;
+        for (StreamingTexture *texture : textures) {
+            if (texture->pendingMip == texture->mipLevels &&
+                texture->RequestedMipLevel() < texture->ResidentMipLevel())
+                candidates.push_back(texture);
+        }
+
+        std::stable_sort(candidates.begin(), candidates.end(),
+                         [](const StreamingTexture *lhs, const StreamingTexture *rhs) -> bool {
+                             return lhs->ResidentMipLevel() - lhs->RequestedMipLevel() >
+                                    rhs->ResidentMipLevel() - rhs->RequestedMipLevel();
+                         });
+
+        for (StreamingTexture *texture : candidates) {
+            if (pendingCount >= MAX_PENDING_UPLOADS)
+                break;
+
+            // The least detailed mip levels are always loaded so that the texture could be sampled.
+            const uint32_t mipLevel = texture->NextMipLevel();
+            const uint64_t size     = texture->TileCount(mipLevel) * TILE_SIZE;
+            if (texture->ResidentMipLevel() < texture->mipLevels &&
+                usedSize.load(std::memory_order_relaxed) + size > currentBudget)
+                continue;
+
+            std::vector<TileMapping> mappings;
+            AllocateMipTiles(*texture, mipLevel, mappings);
+
+            try {
+                texture->pendingUpload = ThreadPool::Singleton().Submit(
+                    [texture, mipLevel, mappings = std::move(mappings)]() -> uint64_t {
+                        return texture->Upload(mipLevel, mappings);
+                    });
+            } catch (...) {
+                auto &tiles = texture->mipTiles[std::min(mipLevel, texture->standardMipCount)];
+                FreeTiles(tiles);
+                tiles.clear();
+                throw;
+            }
+
+            texture->pendingMip       = mipLevel;
+            texture->pendingSyncPoint = 0;
+            pendingCount += 1;
+        }
+    } catch (...) {
+        // Failed to allocate tiles or submit uploads. Try again in the next update.
+    }
+
+    // Release empty tile heaps except one, so that memory could be returned when textures are evicted.
+    bool keepEmptyHeap = true;
+    for (auto &heap : heaps) {
+        if (heap.heap == nullptr || heap.freeTiles.size() != TILES_PER_HEAP)
+            continue;
+
+        if (keepEmptyHeap) {
+            keepEmptyHeap = false;
+            continue;
+        }
+
+        heap.heap.Reset();
+        heap.freeTiles.clear();
+        RenderDevice::Singleton().TrackMemoryUsage(GpuMemoryCategory::Texture,
+                                                   -static_cast<int64_t>(TILES_PER_HEAP * TILE_SIZE));
+        heap.freeTiles.shrink_to_fit();
+    }
+}
+
+auto YaGE::TextureStreamer::Singleton() -> TextureStreamer & {
+    static TextureStreamer instance;
+    return instance;
+}
+
+auto YaGE::TextureStreamer::Register(StreamingTexture *texture) -> void {
+    std::lock_guard<std::mutex> lock(mutex);
+    textures.push_back(texture);
+}
+
+auto YaGE::TextureStreamer::Unregister(StreamingTexture *texture) noexcept -> void {
+    { // Lock scope. No more upload is submitted once the texture is unregistered.
+        std::lock_guard<std::mutex> lock(mutex);
+        textures.erase(std::remove(textures.begin(), textures.end(), texture), textures.end());
+    }
+
+    uint64_t uploadSyncPoint = texture->pendingSyncPoint;
+    if (texture->pendingUpload.valid()) {
+        try {
+            uploadSyncPoint = texture->pendingUpload.get();
+        } catch (...) {
+        }
+    }
+
+    // Tiles could be reused once both the upload and commands that sample this texture are finished.
+    RenderDevice &renderDevice = RenderDevice::Singleton();
+    if (uploadSyncPoint != 0)
+        renderDevice.WaitForSyncPoint(D3D12_COMMAND_LIST_TYPE_DIRECT, uploadSyncPoint);
+
+    const uint64_t syncPoint = renderDevice.AcquireSyncPoint();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto &tiles : texture->mipTiles)
+        RetireTiles(syncPoint, tiles);
+}
+
+auto YaGE::TextureStreamer::AllocateMipTiles(StreamingTexture         &texture,
+                                             uint32_t                  mipLevel,
+                                             std::vector<TileMapping> &mappings) -> void {
+    const bool isPacked  = (mipLevel >= texture.standardMipCount);
+    auto      &mipTiles  = texture.mipTiles[isPacked ? texture.standardMipCount : mipLevel];
+    const auto rowTiles  = isPacked ? 0U : texture.tilings[mipLevel].WidthInTiles;
+    const auto sliceSize = isPacked ? texture.packedTileCount : texture.TileCount(mipLevel) / texture.arraySize;
+
+    try {
+        std::vector<TileRun> runs;
+        for (uint32_t slice = 0; slice < texture.arraySize; ++slice) {
+            // Tiles of different subresources are allocated separately, so that each run maps to a single subresource.
+            runs.clear();
+            AllocateTiles(sliceSize, runs);
+            mipTiles.insert(mipTiles.end(), runs.begin(), runs.end());
+
+            const uint32_t subresource = slice * texture.mipLevels + (isPacked ? texture.standardMipCount : mipLevel);
+
+            uint32_t offset = 0;
+            for (const auto &run : runs) {
+                TileMapping mapping;
+                mapping.coordinate.X           = isPacked ? offset : offset % rowTiles;
+                mapping.coordinate.Y           = isPacked ? 0 : offset / rowTiles;
+                mapping.coordinate.Z           = 0;
+                mapping.coordinate.Subresource = subresource;
+                mapping.heap                   = heaps[run.heapIndex].heap.Get();
+                mapping.tiles                  = run;
+
+                mappings.push_back(mapping);
+                offset += run.tileCount;
+            }
+        }
+    } catch (...) {
+        FreeTiles(mipTiles);
+        mipTiles.clear();
+        throw;
+    }
+}
+
+auto YaGE::TextureStreamer::AllocateTiles(uint32_t count, std::vector<TileRun> &runs) -> void {
+    std::vector<TileRun> allocated;
+
+    auto takeTiles = [this, &count, &allocated](uint32_t heapIndex) -> void {
+        auto &freeTiles = heaps[heapIndex].freeTiles;
+        while (count > 0 && !freeTiles.empty()) {
+            const uint32_t tile = freeTiles.back();
+            freeTiles.pop_back();
+            count -= 1;
+
+            if (!allocated.empty() && allocated.back().heapIndex == heapIndex &&
+                allocated.back().firstTile + allocated.back().tileCount == tile) {
+                allocated.back().tileCount += 1;
+            } else {
+                allocated.push_back(TileRun{heapIndex, tile, 1});
+            }
+        }
+    };
+
+    try {
+        for (uint32_t i = 0; i < static_cast<uint32_t>(heaps.size()) && count > 0; ++i) {
+            if (heaps[i].heap != nullptr)
+                takeTiles(i);
+        }
+
+        while (count > 0) {
+            // Reuse a released heap slot so that heap indices of allocated tiles are stable.
+            uint32_t heapIndex = 0;
+            while (heapIndex < heaps.size() && heaps[heapIndex].heap != nullptr)
+                heapIndex += 1;
+            if (heapIndex == heaps.size())
+                heaps.emplace_back();
+
+            const D3D12_HEAP_DESC desc{
+                /* SizeInBytes = */ TILES_PER_HEAP * TILE_SIZE,
+                /* Properties  = */
+                {
+                    /* Type                 = */ D3D12_HEAP_TYPE_DEFAULT,
+                    /* CPUPageProperty      = */ D3D12_CPU_PAGE_PROPERTY_UNKNOWN,
+                    /* MemoryPoolPreference = */ D3D12_MEMORY_POOL_UNKNOWN,
+                    /* CreationNodeMask     = */ 0,
+                    /* VisibleNodeMask      = */ 0,
+                },
+                /* Alignment = */ D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT,
+                /* Flags     = */ D3D12_HEAP_FLAG_ALLOW_ONLY_NON_RT_DS_TEXTURES,
+            };
+
+            TileHeap &heap = heaps[heapIndex];
+
+            HRESULT hr = RenderDevice::Singleton().Device()->CreateHeap(&desc, IID_PPV_ARGS(heap.heap.GetAddressOf()));
+            if (FAILED(hr))
+                throw RenderAPIException(hr, u"Failed to create tile heap for streaming textures.");
+
+            RenderDevice::Singleton().TrackMemoryUsage(GpuMemoryCategory::Texture,
+                                                       static_cast<int64_t>(TILES_PER_HEAP * TILE_SIZE));
+
+            // Free tiles are stored in reverse order so that tiles are allocated in increasing order.
+            heap.freeTiles.reserve(TILES_PER_HEAP);
+            for (uint32_t tile = TILES_PER_HEAP; tile > 0; --tile)
+                heap.freeTiles.push_back(tile - 1);
+
+            takeTiles(heapIndex);
+        }
+
+        runs.insert(runs.end(), allocated.begin(), allocated.end());
+    } catch (...) {
+        FreeTiles(allocated);
+        throw;
+    }
+
+    uint64_t allocatedCount = 0;
+    for (const auto &run : allocated)
+        allocatedCount += run.tileCount;
+    usedSize.fetch_add(allocatedCount * TILE_SIZE, std::memory_order_relaxed);
+}
+
+auto YaGE::TextureStreamer::FreeTiles(const std::vector<TileRun> &runs) noexcept -> void {
+    uint64_t freedCount = 0;
+    for (const auto &run : runs) {
+        auto &freeTiles = heaps[run.heapIndex].freeTiles;
+        for (uint32_t i = run.tileCount; i > 0; --i)
+            freeTiles.push_back(run.firstTile + i - 1);
+        freedCount += run.tileCount;
+    }
+
+    usedSize.fetch_sub(freedCount * TILE_SIZE, std::memory_order_relaxed);
+}
+
+auto YaGE::TextureStreamer::RetireTiles(uint64_t syncPoint, std::vector<TileRun> &runs) noexcept -> void {
+    if (runs.empty())
+        return;
+
+    // Reserve space before moving tiles, so that tiles are not lost if failed to allocate memory.
+    if (retiredTiles.size() == retiredTiles.capacity()) {
+        try {
+            retiredTiles.reserve(std::max<size_t>(16, retiredTiles.capacity() * 2));
+        } catch (...) {
+            RenderDevice::Singleton().Sync(syncPoint);
+            FreeTiles(runs);
+            runs.clear();
+            return;
+        }
+    }
+
+    retiredTiles.push_back(RetiredTiles{syncPoint, std::move(runs)});
+    runs.clear();
+}
+
+auto YaGE::TextureStreamer::EvictMipLevel(StreamingTexture &texture, uint64_t syncPoint) noexcept -> void {
+    const uint32_t mipLevel = texture.ResidentMipLevel();
+    texture.residentMip.store(mipLevel + 1, std::memory_order_release);
+    RetireTiles(syncPoint, texture.mipTiles[mipLevel]);
+}
+
+auto YaGE::TextureStreamer::UpdateBudget() noexcept -> void {
+    uint64_t newBudget = UINT64_MAX;
+
+    const DXGI_QUERY_VIDEO_MEMORY_INFO info = RenderDevice::Singleton().QueryMemoryBudget();
+    if (info.Budget != 0) {
+        uint64_t heapSize = 0;
+        for (const auto &heap : heaps) {
+            if (heap.heap != nullptr)
+                heapSize += TILES_PER_HEAP * TILE_SIZE;
+        }
+
+        // Video memory that is used by other resources is not available for streaming textures.
+        // 1/8 of the available memory is reserved as headroom.
+        const uint64_t otherUsage = (info.CurrentUsage > heapSize) ? info.CurrentUsage - heapSize : 0;
+        const uint64_t available  = (info.Budget > otherUsage) ? info.Budget - otherUsage : 0;
+        newBudget                 = available - available / 8;
+    }
+
+    const uint64_t limit = maxBudget.load(std::memory_order_relaxed);
+    if (limit != 0 && limit < newBudget)
+        newBudget = limit;
+
+    budget.store(newBudget, std::memory_order_relaxed);
+}
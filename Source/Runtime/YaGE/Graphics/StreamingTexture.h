@@ -0,0 +1,363 @@
+#pragma once
+
+#include "../Resource/DDSImage.h"
+#include "Descriptor.h"
+#include "PixelBuffer.h"
+
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <vector>
+
+namespace YaGE {
+
+class TextureStreamer;
+
+class StreamingTexture : public PixelBuffer {
+public:
+    /// @brief
+    ///   Create a streaming texture from a DDS image. A reserved resource is created for the texture and no mip level is resident at first. The streaming texture is registered to @p TextureStreamer::Singleton(), which maps and uploads mip levels in background.
+    /// @remarks
+    ///   Pixels of all mip levels are kept in system memory by the DDS image, only video memory is streamed. Mip levels that are packed into the mip tail are always loaded together with the least detailed standard mip level.
+    ///   Streaming textures must stay in common state, so that they could be written by the copy command queue. Do not transition streaming textures explicitly, they are implicitly promoted to shader resource state when sampled.
+    ///
+    /// @param source   The DDS image that contains pixels of all mip levels. Volume textures are not supported.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if tiled resources are not supported or failed to create the reserved resource or shader resource view.
+    YAGE_API explicit StreamingTexture(DDSImage &&source);
+
+    /// @brief
+    ///   Copy constructor is disabled.
+    StreamingTexture(const StreamingTexture &) = delete;
+
+    /// @brief
+    ///   Copy assignment is disabled.
+    auto operator=(const StreamingTexture &) = delete;
+
+    /// @brief
+    ///   Destroy this streaming texture. Pending uploads are waited for and tiles are returned to the texture streamer once GPU is no longer using them.
+    YAGE_API ~StreamingTexture() noexcept override;
+
+    /// @brief
+    ///   Request the specified mip level to be the most detailed resident mip level. Mip levels are loaded or evicted by @p TextureStreamer::Update() according to requests of all streaming textures and the memory budget. This method is thread-safe.
+    ///
+    /// @param mipLevel     The most detailed mip level that is expected to be resident. This value will be clamped to the mip levels of this texture.
+    auto RequestMipLevel(uint32_t mipLevel) noexcept -> void {
+        requestedMip.store(mipLevel < mipLevels ? mipLevel : mipLevels - 1, std::memory_order_relaxed);
+    }
+
+    /// @brief
+    ///   Request mip level according to size in pixel of this texture on screen. This is a distance based heuristic: the requested mip level is the one whose size matches @p screenSize. This method is thread-safe.
+    ///
+    /// @param screenSize   Size in pixel of the longest edge of this texture on screen.
+    YAGE_API auto RequestMipLevelForScreenSize(float screenSize) noexcept -> void;
+
+    /// @brief
+    ///   Get the requested most detailed mip level.
+    ///
+    /// @return uint32_t
+    ///   Return the requested most detailed mip level.
+    YAGE_NODISCARD auto RequestedMipLevel() const noexcept -> uint32_t {
+        return requestedMip.load(std::memory_order_relaxed);
+    }
+
+    /// @brief
+    ///   Get the most detailed resident mip level. Mip levels from this level to the least detailed level are mapped and uploaded.
+    ///
+    /// @return uint32_t
+    ///   Return the most detailed resident mip level. Return @p MipLevels() if no mip level is resident yet.
+    YAGE_NODISCARD auto ResidentMipLevel() const noexcept -> uint32_t {
+        return residentMip.load(std::memory_order_acquire);
+    }
+
+    /// @brief
+    ///   Get minimum level of detail that could be sampled from this texture. Shaders should clamp level of detail with this value, for example via the clamp parameter of @p Texture2D::Sample(), so that unmapped tiles are never sampled.
+    ///
+    /// @return float
+    ///   Return minimum level of detail that could be sampled.
+    YAGE_NODISCARD auto MinLOD() const noexcept -> float { return static_cast<float>(ResidentMipLevel()); }
+
+    /// @brief
+    ///   Checks whether this is a cube texture.
+    ///
+    /// @return bool
+    /// @retval true    This is a cube texture.
+    /// @retval false   This is not a cube texture.
+    YAGE_NODISCARD auto IsCubeTexture() const noexcept -> bool { return isCubeTexture; }
+
+    /// @brief
+    ///   Get shader resource view that referres to all mip levels of this texture. For cube texture, this is a texture cube shader resource view.
+    ///
+    /// @return CpuDescriptorHandle
+    ///   Return a CPU descriptor handle to the shader resource view.
+    YAGE_NODISCARD auto ShaderResourceView() const noexcept -> CpuDescriptorHandle { return srv; }
+
+    /// @brief
+    ///   Get bindless index of the shader resource view of this texture.
+    ///
+    /// @return uint32_t
+    ///   Return bindless index of the shader resource view.
+    YAGE_NODISCARD auto BindlessIndex() const noexcept -> uint32_t { return srv.BindlessIndex(); }
+
+    friend class TextureStreamer;
+
+private:
+    struct TileRun {
+        /// @brief  Index of the tile heap in the texture streamer.
+        uint32_t heapIndex;
+
+        /// @brief  Index of the first tile in the tile heap.
+        uint32_t firstTile;
+
+        /// @brief  Number of contiguous tiles.
+        uint32_t tileCount;
+    };
+
+    struct TileMapping {
+        /// @brief  Coordinate of the first tile to be mapped in this texture.
+        D3D12_TILED_RESOURCE_COORDINATE coordinate;
+
+        /// @brief  The heap that tiles are mapped to.
+        ID3D12Heap *heap;
+
+        /// @brief  The heap tiles to be mapped to.
+        TileRun tiles;
+    };
+
+    /// @brief
+    ///   Get number of tiles of the specified mip level of all array slices. For the first packed mip level, this is number of tiles of the mip tail.
+    ///
+    /// @param mipLevel     The mip level to be queried. Must be a standard mip level or the first packed mip level.
+    ///
+    /// @return uint32_t
+    ///   Return number of tiles of the mip level.
+    YAGE_NODISCARD auto TileCount(uint32_t mipLevel) const noexcept -> uint32_t;
+
+    /// @brief
+    ///   Get the mip level that should be loaded next to get closer to the requested mip level.
+    ///
+    /// @return uint32_t
+    ///   Return the mip level to be loaded. The whole mip tail is loaded if this is the first packed mip level.
+    YAGE_NODISCARD auto NextMipLevel() const noexcept -> uint32_t {
+        const uint32_t resident = ResidentMipLevel();
+        return (resident > standardMipCount) ? standardMipCount : resident - 1;
+    }
+
+    /// @brief
+    ///   Upload the specified mip level on the copy command queue. Tiles are mapped before the upload.
+    ///
+    /// @param mipLevel     The mip level to be uploaded. Packed mip levels are uploaded if this is the first packed mip level.
+    /// @param mappings     Tile mappings of the mip level.
+    ///
+    /// @return uint64_t
+    ///   Return sync point of the copy command queue that indicates when the upload is finished.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to record or submit the copy command buffer.
+    auto Upload(uint32_t mipLevel, const std::vector<TileMapping> &mappings) -> uint64_t;
+
+private:
+    /// @brief  The DDS image that provides pixels of all mip levels.
+    DDSImage image;
+
+    /// @brief  Specifies whether this is a cube texture.
+    bool isCubeTexture;
+
+    /// @brief  Shader resource view that referres to all mip levels of this texture.
+    YaGE::ShaderResourceView srv;
+
+    /// @brief  Number of mip levels that are not packed.
+    uint32_t standardMipCount;
+
+    /// @brief  Number of tiles of the mip tail of each array slice.
+    uint32_t packedTileCount;
+
+    /// @brief  Tiling of each standard mip level.
+    std::vector<D3D12_SUBRESOURCE_TILING> tilings;
+
+    /// @brief  Tiles that are allocated for each standard mip level. Tiles of the mip tail are stored at index @p standardMipCount.
+    std::vector<std::vector<TileRun>> mipTiles;
+
+    /// @brief  The requested most detailed mip level.
+    std::atomic<uint32_t> requestedMip;
+
+    /// @brief  The most detailed resident mip level.
+    std::atomic<uint32_t> residentMip;
+
+    /// @brief  The mip level that is being uploaded. Equals to @p mipLevels if there is no pending upload.
+    uint32_t pendingMip;
+
+    /// @brief  Sync point of the pending upload. Zero if the upload is not submitted yet.
+    uint64_t pendingSyncPoint;
+
+    /// @brief  Future of the pending upload task.
+    std::future<uint64_t> pendingUpload;
+};
+
+class TextureStreamer {
+public:
+    /// @brief
+    ///   Create a texture streamer. No tile heap is created until mip levels are loaded.
+    YAGE_API TextureStreamer() noexcept;
+
+    /// @brief
+    ///   Copy constructor is disabled.
+    TextureStreamer(const TextureStreamer &) = delete;
+
+    /// @brief
+    ///   Copy assignment is disabled.
+    auto operator=(const TextureStreamer &) = delete;
+
+    /// @brief
+    ///   Destroy this texture streamer and release all tile heaps. All streaming textures should be destroyed before this.
+    YAGE_API ~TextureStreamer() noexcept;
+
+    /// @brief
+    ///   Update residency of all streaming textures. Finished uploads become resident, mip levels are evicted if they are no longer requested or the memory budget is exceeded, and missing mip levels are uploaded in background within the memory budget.
+    /// @note
+    ///   This method should be called once per frame before recording commands of the frame, so that evicted mip levels are not sampled by commands recorded with old @p StreamingTexture::MinLOD().
+    YAGE_API auto Update() noexcept -> void;
+
+    /// @brief
+    ///   Set maximum size in byte of video memory that could be used by streaming textures. The actual budget is the smaller one of this value and the video memory budget reported by the DXGI adapter.
+    ///
+    /// @param size     Maximum size in byte of video memory for streaming textures. Pass 0 to use the video memory budget only.
+    auto SetMaxBudget(uint64_t size) noexcept -> void { maxBudget.store(size, std::memory_order_relaxed); }
+
+    /// @brief
+    ///   Get memory budget in byte of streaming textures that is computed in the last update.
+    ///
+    /// @return uint64_t
+    ///   Return memory budget in byte of streaming textures.
+    YAGE_NODISCARD auto Budget() const noexcept -> uint64_t { return budget.load(std::memory_order_relaxed); }
+
+    /// @brief
+    ///   Get size in byte of tiles that are allocated for streaming textures.
+    ///
+    /// @return uint64_t
+    ///   Return size in byte of allocated tiles.
+    YAGE_NODISCARD auto UsedSize() const noexcept -> uint64_t { return usedSize.load(std::memory_order_relaxed); }
+
+    /// @brief
+    ///   Get global singleton instance of texture streamer.
+    ///
+    /// @return TextureStreamer &
+    ///   Return reference to the texture streamer singleton instance.
+    YAGE_NODISCARD YAGE_API static auto Singleton() -> TextureStreamer &;
+
+    friend class StreamingTexture;
+
+private:
+    using TileRun     = StreamingTexture::TileRun;
+    using TileMapping = StreamingTexture::TileMapping;
+
+    struct TileHeap {
+        /// @brief  The D3D12 heap.
+        Microsoft::WRL::ComPtr<ID3D12Heap> heap;
+
+        /// @brief  Indices of free tiles in this heap.
+        std::vector<uint32_t> freeTiles;
+    };
+
+    struct RetiredTiles {
+        /// @brief  The sync point that indicates when GPU is no longer using the tiles.
+        uint64_t syncPoint;
+
+        /// @brief  The tiles to be freed.
+        std::vector<TileRun> tiles;
+    };
+
+    /// @brief
+    ///   Register a streaming texture. This method is thread-safe.
+    ///
+    /// @param[in] texture  The streaming texture to be registered.
+    ///
+    /// @throw std::bad_alloc
+    ///   Thrown if failed to allocate memory.
+    auto Register(StreamingTexture *texture) -> void;
+
+    /// @brief
+    ///   Unregister a streaming texture, wait for its pending upload and retire all of its tiles. This method is thread-safe.
+    ///
+    /// @param[in] texture  The streaming texture to be unregistered.
+    auto Unregister(StreamingTexture *texture) noexcept -> void;
+
+    /// @brief
+    ///   Allocate tiles for the specified mip level of a streaming texture and generate tile mappings. The mutex must be locked.
+    ///
+    /// @param[in]  texture     The streaming texture to allocate tiles for.
+    /// @param      mipLevel    The mip level to allocate tiles for.
+    /// @param[out] mappings    Tile mappings of the allocated tiles.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to create new tile heap.
+    auto AllocateMipTiles(StreamingTexture &texture, uint32_t mipLevel, std::vector<TileMapping> &mappings) -> void;
+
+    /// @brief
+    ///   Allocate the specified number of tiles from tile heaps. New tile heaps are created if necessary. The mutex must be locked.
+    ///
+    /// @param      count   Number of tiles to be allocated.
+    /// @param[out] runs    Allocated tiles are appended to this array. Contiguous tiles are merged.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to create new tile heap.
+    auto AllocateTiles(uint32_t count, std::vector<TileRun> &runs) -> void;
+
+    /// @brief
+    ///   Return tiles to tile heaps immediately. The mutex must be locked.
+    ///
+    /// @param runs     The tiles to be freed.
+    auto FreeTiles(const std::vector<TileRun> &runs) noexcept -> void;
+
+    /// @brief
+    ///   Free tiles once GPU reaches the specified sync point. The mutex must be locked.
+    ///
+    /// @param syncPoint    The sync point that indicates when GPU is no longer using the tiles.
+    /// @param runs         The tiles to be retired. This array is moved.
+    auto RetireTiles(uint64_t syncPoint, std::vector<TileRun> &runs) noexcept -> void;
+
+    /// @brief
+    ///   Evict the most detailed resident mip level of the specified streaming texture. The mutex must be locked.
+    ///
+    /// @param[in] texture      The streaming texture to evict mip level from.
+    /// @param     syncPoint    The sync point that indicates when GPU is no longer using the mip level.
+    auto EvictMipLevel(StreamingTexture &texture, uint64_t syncPoint) noexcept -> void;
+
+    /// @brief
+    ///   Update memory budget according to video memory information of the DXGI adapter. The mutex must be locked.
+    auto UpdateBudget() noexcept -> void;
+
+    /// @brief  Number of tiles in each tile heap.
+    static constexpr const uint32_t TILES_PER_HEAP = 256;
+
+    /// @brief  Size in byte of each tile.
+    static constexpr const uint64_t TILE_SIZE = D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES;
+
+    /// @brief  Maximum number of uploads in flight.
+    static constexpr const uint32_t MAX_PENDING_UPLOADS = 8;
+
+private:
+    /// @brief  Registered streaming textures.
+    std::vector<StreamingTexture *> textures;
+
+    /// @brief  Tile heaps. Released heaps are kept as empty slots so that heap indices are stable.
+    std::vector<TileHeap> heaps;
+
+    /// @brief  Tiles that are waiting for GPU before freed.
+    std::vector<RetiredTiles> retiredTiles;
+
+    /// @brief  User specified maximum budget in byte. Zero means unlimited.
+    std::atomic<uint64_t> maxBudget;
+
+    /// @brief  Memory budget in byte computed in the last update.
+    std::atomic<uint64_t> budget;
+
+    /// @brief  Size in byte of allocated tiles.
+    std::atomic<uint64_t> usedSize;
+
+    /// @brief  Mutex that protects registered textures and tile heaps.
+    std::mutex mutex;
+};
+
+} // namespace YaGE
@@ -1,5 +1,7 @@
 #include "SwapChain.h"
 #include "../Core/Exception.h"
+#include "../Core/Memory.h"
+#include "../Core/Profiler.h"
 #include "../Core/Window.h"
 
 using namespace YaGE;
@@ -7,10 +9,25 @@ using namespace YaGE;
 YaGE::SwapChain::SwapChain(HWND window, uint32_t numBuffers, DXGI_FORMAT bufferFormat, bool enableTearing)
     : renderDevice(RenderDevice::Singleton()),
       swapChain(),
+      frameLatencyWaitableObject(),
+      swapChainFlags(DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT),
       tearingEnabled(false),
+      tearingAllowed(false),
+      syncInterval(0),
+      frameRateLimit(0),
+      frameTimer(),
+      isFrameTimerHighResolution(),
+      counterFrequency(),
+      frameInterval(0),
+      nextFrameTime(0),
+      statistics(),
       bufferCount(numBuffers > 2 ? 3 : 2),
       bufferIndex(0),
+      maxFrameLatency(bufferCount - 1),
       pixelFormat(bufferFormat),
+      bufferWidth(),
+      bufferHeight(),
+      generation(),
       backBuffers(),
       presentSyncPoints() {
     IDXGIFactory6 *const dxgiFactory = renderDevice.DXGIFactory();
@@ -23,13 +40,20 @@ YaGE::SwapChain::SwapChain(HWND window, uint32_t numBuffers, DXGI_FORMAT bufferF
             tearingEnabled = (tearingSupport == TRUE);
     }
 
+    tearingAllowed = tearingEnabled;
+
+    { // Query performance counter frequency for frame pacing.
+        LARGE_INTEGER frequency;
+        QueryPerformanceFrequency(&frequency);
+        counterFrequency = frequency.QuadPart;
+    }
+
     // Create swap chain.
     RECT rect;
     GetClientRect(window, &rect);
 
-    UINT flags = 0;
     if (tearingEnabled)
-        flags |= DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING;
+        swapChainFlags |= DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING;
 
     const DXGI_SWAP_CHAIN_DESC1 desc{
         /* Width      = */ static_cast<UINT>(rect.right),
@@ -46,13 +70,32 @@ YaGE::SwapChain::SwapChain(HWND window, uint32_t numBuffers, DXGI_FORMAT bufferF
         /* Scaling     = */ DXGI_SCALING_NONE,
         /* SwapEffect  = */ DXGI_SWAP_EFFECT_FLIP_DISCARD,
         /* AlphaMode   = */ DXGI_ALPHA_MODE_UNSPECIFIED,
-        /* Flags       = */ flags,
+        /* Flags       = */ swapChainFlags,
     };
 
-    HRESULT hr = dxgiFactory->CreateSwapChainForHwnd(renderDevice.CommandQueue(), window, &desc, nullptr, nullptr,
-                                                     swapChain.GetAddressOf());
-    if (FAILED(hr))
-        throw RenderAPIException(hr, u"Failed to create swap chain.");
+    { // Create swap chain and get frame latency waitable object.
+        Microsoft::WRL::ComPtr<IDXGISwapChain1> swapChain1;
+
+        HRESULT hr = dxgiFactory->CreateSwapChainForHwnd(renderDevice.CommandQueue(), window, &desc, nullptr, nullptr,
+                                                         swapChain1.GetAddressOf());
+        if (FAILED(hr))
+            throw RenderAPIException(hr, u"Failed to create swap chain.");
+
+        hr = swapChain1.As(&swapChain);
+        if (FAILED(hr))
+            throw RenderAPIException(hr, u"Failed to query IDXGISwapChain2 from swap chain.");
+
+        swapChain->SetMaximumFrameLatency(maxFrameLatency);
+        frameLatencyWaitableObject = swapChain->GetFrameLatencyWaitableObject();
+    }
+
+    { // DXGI may adjust size of back buffers, for example, when the window is minimized.
+        DXGI_SWAP_CHAIN_DESC1 actualDesc;
+        if (SUCCEEDED(swapChain->GetDesc1(&actualDesc))) {
+            bufferWidth  = actualDesc.Width;
+            bufferHeight = actualDesc.Height;
+        }
+    }
 
     // Disable Alt+Enter.
     dxgiFactory->MakeWindowAssociation(window, DXGI_MWA_NO_ALT_ENTER);
@@ -60,7 +103,7 @@ YaGE::SwapChain::SwapChain(HWND window, uint32_t numBuffers, DXGI_FORMAT bufferF
     // Get back buffers.
     for (uint32_t i = 0; i < bufferCount; ++i) {
         Microsoft::WRL::ComPtr<ID3D12Resource> backBuffer;
-        hr = swapChain->GetBuffer(i, IID_PPV_ARGS(backBuffer.GetAddressOf()));
+        HRESULT hr = swapChain->GetBuffer(i, IID_PPV_ARGS(backBuffer.GetAddressOf()));
         if (FAILED(hr))
             throw RenderAPIException(hr, u"Failed to get swap chain back buffer.");
 
@@ -69,74 +112,124 @@ YaGE::SwapChain::SwapChain(HWND window, uint32_t numBuffers, DXGI_FORMAT bufferF
 }
 
 YaGE::SwapChain::SwapChain(Window &window, uint32_t numBuffers, DXGI_FORMAT bufferFormat, bool enableTearing)
-    : renderDevice(RenderDevice::Singleton()),
-      swapChain(),
-      tearingEnabled(false),
-      bufferCount(numBuffers > 2 ? 3 : 2),
-      bufferIndex(0),
-      pixelFormat(bufferFormat),
-      backBuffers(),
-      presentSyncPoints() {
+    : SwapChain(window.hWnd, numBuffers, bufferFormat, enableTearing) {}
 
-    IDXGIFactory6 *const dxgiFactory = renderDevice.DXGIFactory();
+YaGE::SwapChain::~SwapChain() noexcept {
+    renderDevice.Sync();
 
-    // Query tearing support.
-    if (enableTearing) {
-        BOOL tearingSupport = FALSE;
-        if (SUCCEEDED(dxgiFactory->CheckFeatureSupport(DXGI_FEATURE_PRESENT_ALLOW_TEARING, &tearingSupport,
-                                                       sizeof(tearingSupport))))
-            tearingEnabled = (tearingSupport == TRUE);
-    }
+    // Back buffers must be released before the swap chain. Do not defer them, DXGI requires all references to be
+    // released when the swap chain is destroyed or recreated.
+    for (uint32_t i = 0; i < bufferCount; ++i)
+        backBuffers[i].ReleaseSwapChainResource();
 
-    // Create swap chain.
-    RECT rect;
-    GetClientRect(window.hWnd, &rect);
+    if (frameLatencyWaitableObject != nullptr)
+        CloseHandle(frameLatencyWaitableObject);
+    if (frameTimer != nullptr)
+        CloseHandle(frameTimer);
+}
 
-    UINT flags = 0;
-    if (tearingEnabled)
-        flags |= DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING;
+auto YaGE::SwapChain::WaitForNextFrame() const noexcept -> void {
+    // Wait for DXGI to be ready to accept a new frame.
+    if (frameLatencyWaitableObject != nullptr)
+        WaitForSingleObjectEx(frameLatencyWaitableObject, 1000, TRUE);
 
-    const DXGI_SWAP_CHAIN_DESC1 desc{
-        /* Width      = */ static_cast<UINT>(rect.right),
-        /* Height     = */ static_cast<UINT>(rect.bottom),
-        /* Format     = */ pixelFormat,
-        /* Stereo     = */ FALSE,
-        /* SampleDesc = */
-        {
-            /* Count   = */ 1,
-            /* Quality = */ 0,
-        },
-        /* BufferUsage = */ DXGI_USAGE_RENDER_TARGET_OUTPUT | DXGI_USAGE_BACK_BUFFER,
-        /* BufferCount = */ bufferCount,
-        /* Scaling     = */ DXGI_SCALING_NONE,
-        /* SwapEffect  = */ DXGI_SWAP_EFFECT_FLIP_DISCARD,
-        /* AlphaMode   = */ DXGI_ALPHA_MODE_UNSPECIFIED,
-        /* Flags       = */ flags,
-    };
+    // Wait for the next back buffer to be released by GPU.
+    renderDevice.Sync(presentSyncPoints[bufferIndex]);
+}
 
-    HRESULT hr = dxgiFactory->CreateSwapChainForHwnd(renderDevice.CommandQueue(), window.hWnd, &desc, nullptr, nullptr,
-                                                     swapChain.GetAddressOf());
-    if (FAILED(hr))
-        throw RenderAPIException(hr, u"Failed to create swap chain.");
+auto YaGE::SwapChain::SetMaxFrameLatency(uint32_t frames) noexcept -> void {
+    if (frames < 1)
+        frames = 1;
+    else if (frames > DXGI_MAX_SWAP_CHAIN_BUFFERS)
+        frames = DXGI_MAX_SWAP_CHAIN_BUFFERS;
 
-    // Disable Alt+Enter.
-    dxgiFactory->MakeWindowAssociation(window.hWnd, DXGI_MWA_NO_ALT_ENTER);
+    if (SUCCEEDED(swapChain->SetMaximumFrameLatency(frames)))
+        maxFrameLatency = frames;
+}
 
-    // Get back buffers.
-    for (uint32_t i = 0; i < bufferCount; ++i) {
-        Microsoft::WRL::ComPtr<ID3D12Resource> backBuffer;
-        hr = swapChain->GetBuffer(i, IID_PPV_ARGS(backBuffer.GetAddressOf()));
-        if (FAILED(hr))
-            throw RenderAPIException(hr, u"Failed to get swap chain back buffer.");
+auto YaGE::SwapChain::SetFrameRateLimit(double framesPerSecond) noexcept -> void {
+    if (framesPerSecond <= 0) {
+        frameRateLimit = 0;
+        frameInterval  = 0;
+        return;
+    }
 
-        backBuffers[i].ResetSwapChainResource(std::move(backBuffer));
+    // Prefer high resolution timer, which is available since Windows 10 version 1803.
+    if (frameTimer == nullptr) {
+#ifdef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+        frameTimer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+        if (frameTimer != nullptr)
+            isFrameTimerHighResolution = true;
+#endif
+        if (frameTimer == nullptr)
+            frameTimer = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
     }
+
+    frameRateLimit = framesPerSecond;
+    frameInterval  = static_cast<int64_t>(static_cast<double>(counterFrequency) / framesPerSecond);
+    nextFrameTime  = 0;
 }
 
-YaGE::SwapChain::~SwapChain() noexcept { renderDevice.Sync(); }
+auto YaGE::SwapChain::WaitForFrameTime() noexcept -> void {
+    LARGE_INTEGER now;
+    QueryPerformanceCounter(&now);
+
+    if (now.QuadPart < nextFrameTime) {
+        // Low resolution timers may oversleep for a whole scheduler tick, so spin for a longer time.
+        const int64_t spinTicks = isFrameTimerHighResolution ? counterFrequency / 2000 : counterFrequency / 500;
+        const int64_t remaining = nextFrameTime - now.QuadPart;
+
+        if (frameTimer != nullptr && remaining > spinTicks) {
+            // Due time in 100-nanosecond intervals. Negative value means relative time.
+            LARGE_INTEGER dueTime;
+            dueTime.QuadPart = -((remaining - spinTicks) * 10000000 / counterFrequency);
+            if (SetWaitableTimerEx(frameTimer, &dueTime, 0, nullptr, nullptr, nullptr, 0))
+                WaitForSingleObject(frameTimer, INFINITE);
+        }
+
+        do {
+            YieldProcessor();
+            QueryPerformanceCounter(&now);
+        } while (now.QuadPart < nextFrameTime);
+    }
+
+    // Restart pacing if presentation falls behind by more than one frame, so that frames are not presented in bursts.
+    if (now.QuadPart - nextFrameTime > frameInterval)
+        nextFrameTime = now.QuadPart + frameInterval;
+    else
+        nextFrameTime += frameInterval;
+}
+
+auto YaGE::SwapChain::UpdateStatistics() noexcept -> void {
+    DXGI_FRAME_STATISTICS frameStatistics;
+    if (FAILED(swapChain->GetFrameStatistics(&frameStatistics)))
+        return;
+
+    const uint32_t presentDelta = frameStatistics.PresentCount - statistics.presentCount;
+    const int64_t  timeDelta    = frameStatistics.SyncQPCTime.QuadPart - statistics.syncQPCTime;
+    if (statistics.presentCount != 0 && presentDelta != 0 && timeDelta > 0)
+        statistics.displayedFrameTime =
+            static_cast<double>(timeDelta) / static_cast<double>(counterFrequency) / presentDelta;
+
+    statistics.presentCount        = frameStatistics.PresentCount;
+    statistics.presentRefreshCount = frameStatistics.PresentRefreshCount;
+    statistics.syncRefreshCount    = frameStatistics.SyncRefreshCount;
+    statistics.syncQPCTime         = frameStatistics.SyncQPCTime.QuadPart;
+}
 
 auto YaGE::SwapChain::Present() noexcept -> uint64_t {
-    swapChain->Present(0, tearingEnabled ? DXGI_PRESENT_ALLOW_TEARING : 0);
+    if (frameInterval > 0)
+        WaitForFrameTime();
+
+    { // Profile scope.
+        YAGE_PROFILE_SCOPE(SwapChainPresent);
+
+        // Tearing could only be used with sync interval 0.
+        const UINT flags = (syncInterval == 0 && tearingAllowed) ? DXGI_PRESENT_ALLOW_TEARING : 0;
+        swapChain->Present(syncInterval, flags);
+    }
+
+    UpdateStatistics();
 
     // Acquire a sync point.
     const uint64_t syncPoint       = renderDevice.AcquireSyncPoint();
@@ -145,21 +238,25 @@ auto YaGE::SwapChain::Present() noexcept -> uint64_t {
     // Increase buffer index.
     bufferIndex = (bufferIndex + 1) % bufferCount;
 
+    // Scratch memory of this frame is no longer in use.
+    AdvanceFrameArenas();
+
+    YAGE_PROFILE_FRAME();
     return syncPoint;
 }
 
 auto YaGE::SwapChain::Resize(uint32_t width, uint32_t height) -> void {
-    // Release resources.
-    renderDevice.Sync();
+    if (width == bufferWidth && height == bufferHeight && width != 0 && height != 0)
+        return;
+
+    // Back buffers may be referenced by any command buffer submitted to the direct queue after the last present, so
+    // waiting for present sync points is not enough. Wait for the last submission without signaling other queues.
+    renderDevice.Sync(renderDevice.LastSubmittedSyncPoint(D3D12_COMMAND_LIST_TYPE_DIRECT));
     for (uint32_t i = 0; i < bufferCount; ++i)
         backBuffers[i].ReleaseSwapChainResource();
 
-    // Resize back buffers.
-    UINT flags = 0;
-    if (tearingEnabled)
-        flags |= DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING;
-
-    HRESULT hr = swapChain->ResizeBuffers(0, width, height, DXGI_FORMAT_UNKNOWN, flags);
+    // Resize back buffers. Flags must match the flags used to create the swap chain.
+    HRESULT hr = swapChain->ResizeBuffers(0, width, height, DXGI_FORMAT_UNKNOWN, swapChainFlags);
     if (FAILED(hr))
         throw RenderAPIException(hr, u"Failed to resize back buffers.");
 
@@ -169,7 +266,13 @@ auto YaGE::SwapChain::Resize(uint32_t width, uint32_t height) -> void {
         hr = swapChain->GetBuffer(i, IID_PPV_ARGS(backBuffer.GetAddressOf()));
         if (FAILED(hr))
             throw RenderAPIException(hr, u"Failed to get swap chain back buffer.");
+
+        backBuffers[i].ResetSwapChainResource(std::move(backBuffer));
+        presentSyncPoints[i] = 0;
     }
 
-    bufferIndex = 0;
+    bufferWidth  = backBuffers[0].Width();
+    bufferHeight = backBuffers[0].Height();
+    bufferIndex  = 0;
+    ++generation;
 }
@@ -7,6 +7,23 @@ namespace YaGE {
 
 class Window;
 
+struct PresentStatistics {
+    /// @brief  Number of times that @p Present() has been called successfully, as reported by DXGI.
+    uint32_t presentCount;
+
+    /// @brief  Vertical blank count when the last presented frame was displayed.
+    uint32_t presentRefreshCount;
+
+    /// @brief  Vertical blank count when the statistics were sampled.
+    uint32_t syncRefreshCount;
+
+    /// @brief  Performance counter value when the statistics were sampled.
+    int64_t syncQPCTime;
+
+    /// @brief  Average time in second between displayed frames since the last sample. This is 0 if not available yet.
+    double displayedFrameTime;
+};
+
 class SwapChain {
 public:
     /// @brief
@@ -61,9 +78,29 @@ public:
     YAGE_API auto Present() noexcept -> uint64_t;
 
     /// @brief
-    ///   Resize back buffers in this swap chain.
+    ///   Wait until the swap chain is ready to accept a new frame. This method should be called before recording commands for each frame.
+    /// @remarks
+    ///   This method waits for the frame latency waitable object of the swap chain and then waits for the next back buffer to be released by GPU. This limits how far CPU could run ahead of display and reduces input latency.
+    YAGE_API auto WaitForNextFrame() const noexcept -> void;
+
+    /// @brief
+    ///   Set maximum number of frames that could be queued for presentation.
+    ///
+    /// @param frames   Maximum number of queued frames. This value will be clamped between 1 and 16. Default value is number of back buffers minus 1.
+    YAGE_API auto SetMaxFrameLatency(uint32_t frames) noexcept -> void;
+
+    /// @brief
+    ///   Get maximum number of frames that could be queued for presentation.
+    ///
+    /// @return uint32_t
+    ///   Return maximum number of queued frames.
+    YAGE_NODISCARD auto MaxFrameLatency() const noexcept -> uint32_t { return maxFrameLatency; }
+
+    /// @brief
+    ///   Resize back buffers in this swap chain. Nothing is done if size of back buffers is not changed.
     /// @note
-    ///   This method will wait for all pending GPU commands to finish before resizing back buffers.
+    ///   This method only waits for command buffers that have been submitted to the direct command queue to finish rather than syncing the whole device. Back buffers must not be referenced by other command queues. This method should be called after @p Present() and before any command that references back buffers of the next frame is recorded.
+    ///   Render targets whose size are relative to back buffers could compare @p Generation() with the value when they were created and be recreated lazily.
     ///
     /// @param width    New width of back buffers. Pass (0, 0) to use client size of the window.
     /// @param height   New height of back buffers. Pass (0, 0) to use client size of the window.
@@ -72,6 +109,27 @@ public:
     ///   Thrown if failed to resize back buffers or failed to retrieve new back buffers.
     YAGE_API auto Resize(uint32_t width, uint32_t height) -> void;
 
+    /// @brief
+    ///   Get width in pixel of back buffers.
+    ///
+    /// @return uint32_t
+    ///   Return width in pixel of back buffers.
+    YAGE_NODISCARD auto Width() const noexcept -> uint32_t { return bufferWidth; }
+
+    /// @brief
+    ///   Get height in pixel of back buffers.
+    ///
+    /// @return uint32_t
+    ///   Return height in pixel of back buffers.
+    YAGE_NODISCARD auto Height() const noexcept -> uint32_t { return bufferHeight; }
+
+    /// @brief
+    ///   Get number of times that back buffers have been resized. This could be used to detect size changes and recreate dependent render targets lazily.
+    ///
+    /// @return uint64_t
+    ///   Return number of times that back buffers have been resized.
+    YAGE_NODISCARD auto Generation() const noexcept -> uint64_t { return generation; }
+
     /// @brief
     ///   Checks if variable refresh rate is enabled.
     ///
@@ -80,6 +138,60 @@ public:
     /// @retval false   Variable refresh rate is disabled.
     YAGE_NODISCARD auto IsTearingEnabled() const noexcept -> bool { return tearingEnabled; }
 
+    /// @brief
+    ///   Set number of vertical blanks to wait for before presenting a frame.
+    ///
+    /// @param interval     Sync interval of presentation. Pass 0 to present immediately. This value will be clamped between 0 and 4.
+    auto SetSyncInterval(uint32_t interval) noexcept -> void { syncInterval = (interval > 4 ? 4 : interval); }
+
+    /// @brief
+    ///   Get number of vertical blanks to wait for before presenting a frame.
+    ///
+    /// @return uint32_t
+    ///   Return sync interval of presentation.
+    YAGE_NODISCARD auto SyncInterval() const noexcept -> uint32_t { return syncInterval; }
+
+    /// @brief
+    ///   Allow or disallow tearing when sync interval is 0. Tearing is required for variable refresh rate displays to present frames as soon as they are ready.
+    ///
+    /// @param allow    Whether to allow tearing.
+    ///
+    /// @return bool
+    /// @retval true    Tearing will be used when sync interval is 0.
+    /// @retval false   Tearing is disallowed or not supported by this swap chain. See @p IsTearingEnabled().
+    auto SetTearingAllowed(bool allow) noexcept -> bool {
+        tearingAllowed = (allow && tearingEnabled);
+        return tearingAllowed;
+    }
+
+    /// @brief
+    ///   Checks if tearing is used when sync interval is 0.
+    ///
+    /// @return bool
+    /// @retval true    Tearing is used when sync interval is 0.
+    /// @retval false   Tearing is never used.
+    YAGE_NODISCARD auto IsTearingAllowed() const noexcept -> bool { return tearingAllowed; }
+
+    /// @brief
+    ///   Limit frame rate of this swap chain. @p Present() sleeps on a high resolution waitable timer and then spins until the next frame time, so that frames are paced evenly even if sync interval is 0.
+    ///
+    /// @param framesPerSecond  Maximum number of frames presented per second. Pass 0 to disable frame rate limit.
+    YAGE_API auto SetFrameRateLimit(double framesPerSecond) noexcept -> void;
+
+    /// @brief
+    ///   Get maximum number of frames presented per second.
+    ///
+    /// @return double
+    ///   Return maximum number of frames presented per second. Return 0 if frame rate is not limited.
+    YAGE_NODISCARD auto FrameRateLimit() const noexcept -> double { return frameRateLimit; }
+
+    /// @brief
+    ///   Get present statistics that are sampled via @p IDXGISwapChain::GetFrameStatistics() on each @p Present(). This could be used to measure the real frame time on display.
+    ///
+    /// @return const PresentStatistics &
+    ///   Return the latest present statistics. All members are 0 if statistics are not available.
+    YAGE_NODISCARD auto Statistics() const noexcept -> const PresentStatistics & { return statistics; }
+
     /// @brief
     ///   Get current back buffer.
     /// @note
@@ -115,25 +227,79 @@ public:
             buffer.SetClearColor(color);
     }
 
+private:
+    /// @brief
+    ///   Block current thread until the next frame could be presented under the frame rate limit.
+    auto WaitForFrameTime() noexcept -> void;
+
+    /// @brief
+    ///   Sample present statistics from DXGI.
+    auto UpdateStatistics() noexcept -> void;
+
 private:
     /// @brief  The render device that created this swap chain.
     RenderDevice &renderDevice;
 
     /// @brief  The DXGI swap chain object.
-    Microsoft::WRL::ComPtr<IDXGISwapChain1> swapChain;
+    Microsoft::WRL::ComPtr<IDXGISwapChain2> swapChain;
+
+    /// @brief  Frame latency waitable object of the swap chain.
+    HANDLE frameLatencyWaitableObject;
+
+    /// @brief  Flags that are used to create the swap chain.
+    UINT swapChainFlags;
 
     /// @brief  Indicates whether variable refresh rate is enabled.
     bool tearingEnabled;
 
+    /// @brief  Indicates whether tearing is used when sync interval is 0.
+    bool tearingAllowed;
+
+    /// @brief  Number of vertical blanks to wait for before presenting a frame.
+    uint32_t syncInterval;
+
+    /// @brief  Maximum number of frames presented per second. 0 means frame rate is not limited.
+    double frameRateLimit;
+
+    /// @brief  Waitable timer that is used to limit frame rate. Created on first use.
+    HANDLE frameTimer;
+
+    /// @brief  Whether @p frameTimer is a high resolution timer.
+    bool isFrameTimerHighResolution;
+
+    /// @brief  Frequency of the performance counter.
+    int64_t counterFrequency;
+
+    /// @brief  Minimum performance counter ticks between two frames.
+    int64_t frameInterval;
+
+    /// @brief  Performance counter value when the next frame could be presented.
+    int64_t nextFrameTime;
+
+    /// @brief  The latest present statistics.
+    PresentStatistics statistics;
+
     /// @brief  Number of back buffers in this swap chain.
     const uint32_t bufferCount;
 
     /// @brief  Current back buffer index.
     uint32_t bufferIndex;
 
+    /// @brief  Maximum number of frames that could be queued for presentation.
+    uint32_t maxFrameLatency;
+
     /// @brief  Pixel format of back buffers.
     const DXGI_FORMAT pixelFormat;
 
+    /// @brief  Width in pixel of back buffers.
+    uint32_t bufferWidth;
+
+    /// @brief  Height in pixel of back buffers.
+    uint32_t bufferHeight;
+
+    /// @brief  Number of times that back buffers have been resized.
+    uint64_t generation;
+
     /// @brief  Swap chain back buffers.
     mutable ColorBuffer backBuffers[3];
 
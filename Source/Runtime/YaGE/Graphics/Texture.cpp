@@ -1,5 +1,11 @@
 #include "Texture.h"
 #include "../Core/Exception.h"
+#include "../Core/String.h"
+#include "../Core/ThreadPool.h"
+#include "../Resource/DDSImage.h"
+#include "../Resource/Image.h"
+#include "CommandBuffer.h"
+#include "MipGenerator.h"
 #include "RenderDevice.h"
 
 using namespace YaGE;
@@ -31,18 +37,13 @@ YaGE::Texture::Texture(
     this->mipLevels   = mipmapLevels;
     this->pixelFormat = format;
 
-    // Create D3D12 resources.
-    RenderDevice &device = RenderDevice::Singleton();
+    // Enable unordered access so that mip levels could be generated with compute shader.
+    // sRGB textures are created as typeless so that they could be written by UNORM unordered access views.
+    const bool supportMipGeneration =
+        (mipmapLevels > 1) &&
+        RenderDevice::Singleton().SupportUnorderedAccess(MipGenerator::UnorderedAccessFormat(format));
 
     { // Create ID3D12Resource
-        const D3D12_HEAP_PROPERTIES heapProps{
-            /* Type                 = */ D3D12_HEAP_TYPE_DEFAULT,
-            /* CPUPageProperty      = */ D3D12_CPU_PAGE_PROPERTY_UNKNOWN,
-            /* MemoryPoolPreference = */ D3D12_MEMORY_POOL_UNKNOWN,
-            /* CreationNodeMask     = */ 0,
-            /* VisibleNodeMask      = */ 0,
-        };
-
         const D3D12_RESOURCE_DESC desc{
             /* Dimension        = */ D3D12_RESOURCE_DIMENSION_TEXTURE2D,
             /* Alignment        = */ 0,
@@ -50,19 +51,17 @@ YaGE::Texture::Texture(
             /* Height           = */ height,
             /* DepthOrArraySize = */ static_cast<UINT16>(arraySize),
             /* MipLevels        = */ static_cast<UINT16>(mipmapLevels),
-            /* Format           = */ format,
+            /* Format           = */ supportMipGeneration ? MipGenerator::TypelessFormat(format) : format,
             /* SampleDesc       = */
             {
                 /* Count   = */ 1,
                 /* Quality = */ 0,
             },
             /* Layout = */ D3D12_TEXTURE_LAYOUT_UNKNOWN,
-            /* Flags  = */ D3D12_RESOURCE_FLAG_NONE,
+            /* Flags  = */ supportMipGeneration ? D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS : D3D12_RESOURCE_FLAG_NONE,
         };
 
-        HRESULT hr = device.Device()->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &desc,
-                                                              D3D12_RESOURCE_STATE_COMMON, nullptr,
-                                                              IID_PPV_ARGS(resource.GetAddressOf()));
+        HRESULT hr = CreateResource(D3D12_HEAP_TYPE_DEFAULT, desc, D3D12_RESOURCE_STATE_COMMON, nullptr);
         if (FAILED(hr))
             throw RenderAPIException(hr, u"Failed to create ID3D12Resource for Texture.");
     }
@@ -88,7 +87,26 @@ YaGE::Texture::Texture(
 
         srv.Create(resource.Get(), desc);
     } else {
-        srv.Create(resource.Get());
+        D3D12_SHADER_RESOURCE_VIEW_DESC desc;
+        desc.Format                  = format;
+        desc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+        if (arraySize > 1) {
+            desc.ViewDimension                      = D3D12_SRV_DIMENSION_TEXTURE2DARRAY;
+            desc.Texture2DArray.MostDetailedMip     = 0;
+            desc.Texture2DArray.MipLevels           = mipmapLevels;
+            desc.Texture2DArray.FirstArraySlice     = 0;
+            desc.Texture2DArray.ArraySize           = arraySize;
+            desc.Texture2DArray.PlaneSlice          = 0;
+            desc.Texture2DArray.ResourceMinLODClamp = 0.0f;
+        } else {
+            desc.ViewDimension                 = D3D12_SRV_DIMENSION_TEXTURE2D;
+            desc.Texture2D.MostDetailedMip     = 0;
+            desc.Texture2D.MipLevels           = mipmapLevels;
+            desc.Texture2D.PlaneSlice          = 0;
+            desc.Texture2D.ResourceMinLODClamp = 0.0f;
+        }
+
+        srv.Create(resource.Get(), desc);
     }
 }
 
@@ -106,18 +124,13 @@ YaGE::Texture::Texture(uint32_t width, uint32_t height, DXGI_FORMAT format, uint
     this->mipLevels   = mipmapLevels;
     this->pixelFormat = format;
 
-    // Create D3D12 resources.
-    RenderDevice &device = RenderDevice::Singleton();
+    // Enable unordered access so that mip levels could be generated with compute shader.
+    // sRGB textures are created as typeless so that they could be written by UNORM unordered access views.
+    const bool supportMipGeneration =
+        (mipmapLevels > 1) &&
+        RenderDevice::Singleton().SupportUnorderedAccess(MipGenerator::UnorderedAccessFormat(format));
 
     { // Create ID3D12Resource.
-        const D3D12_HEAP_PROPERTIES heapProps{
-            /* Type                 = */ D3D12_HEAP_TYPE_DEFAULT,
-            /* CPUPageProperty      = */ D3D12_CPU_PAGE_PROPERTY_UNKNOWN,
-            /* MemoryPoolPreference = */ D3D12_MEMORY_POOL_UNKNOWN,
-            /* CreationNodeMask     = */ 0,
-            /* VisibleNodeMask      = */ 0,
-        };
-
         const D3D12_RESOURCE_DESC desc{
             /* Dimension        = */ D3D12_RESOURCE_DIMENSION_TEXTURE2D,
             /* Alignment        = */ 0,
@@ -125,25 +138,33 @@ YaGE::Texture::Texture(uint32_t width, uint32_t height, DXGI_FORMAT format, uint
             /* Height           = */ height,
             /* DepthOrArraySize = */ 1,
             /* MipLevels        = */ static_cast<UINT16>(mipmapLevels),
-            /* Format           = */ format,
+            /* Format           = */ supportMipGeneration ? MipGenerator::TypelessFormat(format) : format,
             /* SampleDesc       = */
             {
                 /* Count   = */ 1,
                 /* Quality = */ 0,
             },
             /* Layout = */ D3D12_TEXTURE_LAYOUT_UNKNOWN,
-            /* Flags  = */ D3D12_RESOURCE_FLAG_NONE,
+            /* Flags  = */ supportMipGeneration ? D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS : D3D12_RESOURCE_FLAG_NONE,
         };
 
-        HRESULT hr = device.Device()->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &desc,
-                                                              D3D12_RESOURCE_STATE_COMMON, nullptr,
-                                                              IID_PPV_ARGS(resource.GetAddressOf()));
+        HRESULT hr = CreateResource(D3D12_HEAP_TYPE_DEFAULT, desc, D3D12_RESOURCE_STATE_COMMON, nullptr);
         if (FAILED(hr))
             throw RenderAPIException(hr, u"Failed to create ID3D12Resource for Texture.");
     }
 
-    // Create shader resource view.
-    srv.Create(resource.Get());
+    { // Create shader resource view. Format is specified explicitly because the resource may be typeless.
+        D3D12_SHADER_RESOURCE_VIEW_DESC desc;
+        desc.Format                        = format;
+        desc.ViewDimension                 = D3D12_SRV_DIMENSION_TEXTURE2D;
+        desc.Shader4ComponentMapping       = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+        desc.Texture2D.MostDetailedMip     = 0;
+        desc.Texture2D.MipLevels           = mipmapLevels;
+        desc.Texture2D.PlaneSlice          = 0;
+        desc.Texture2D.ResourceMinLODClamp = 0.0f;
+
+        srv.Create(resource.Get(), desc);
+    }
 }
 
 YaGE::Texture::Texture(Texture &&other) noexcept
@@ -163,3 +184,29 @@ auto YaGE::Texture::operator=(Texture &&other) noexcept -> Texture & {
 }
 
 YaGE::Texture::~Texture() noexcept {}
+
+auto YaGE::Texture::LoadAsync(StringView path) -> std::future<TextureLoadResult> {
+    return ThreadPool::Singleton().Submit([path = String(path)]() -> TextureLoadResult {
+        StringView pathView(path);
+        if (pathView.EndsWith(u".dds") || pathView.EndsWith(u".DDS")) {
+            DDSImage image(path);
+            Texture  texture(image.Width(), image.Height(), image.ArraySize(), image.PixelFormat(), image.MipLevels(),
+                             image.IsCubeMap());
+
+            CommandBuffer commandBuffer(D3D12_COMMAND_LIST_TYPE_COPY);
+            commandBuffer.CopySubresources(texture, 0, image.SubresourceCount(), image.Subresources());
+            const uint64_t syncPoint = commandBuffer.Submit();
+
+            return TextureLoadResult{std::move(texture), syncPoint};
+        }
+
+        ImageDecoder decoder(path);
+        Texture      texture(decoder.Width(), decoder.Height(), decoder.PixelFormat(), 1);
+
+        CommandBuffer commandBuffer(D3D12_COMMAND_LIST_TYPE_COPY);
+        commandBuffer.CopyTexture(decoder, texture, 0);
+        const uint64_t syncPoint = commandBuffer.Submit();
+
+        return TextureLoadResult{std::move(texture), syncPoint};
+    });
+}
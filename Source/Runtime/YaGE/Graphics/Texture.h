@@ -1,10 +1,15 @@
 #pragma once
 
+#include "../Core/StringView.h"
 #include "Descriptor.h"
 #include "PixelBuffer.h"
 
+#include <future>
+
 namespace YaGE {
 
+struct TextureLoadResult;
+
 class Texture : public PixelBuffer {
 public:
     /// @brief
@@ -18,7 +23,7 @@ public:
     /// @param height           Height in pixel of this texture.
     /// @param arraySize        2D texture array size. For 2D texture, this value is 1.
     /// @param format           Pixel format of this texture.
-    /// @param mipmapLevels     Number of mipmap levels of this texture. Please note that mipmap will not be automatically generated. Pass 0 to use maximum supported mipmap levels.
+    /// @param mipmapLevels     Number of mipmap levels of this texture. Pass 0 to use maximum supported mipmap levels. Mipmaps are not automatically generated, use @p CommandBuffer::GenerateMips() to generate them if the format supports unordered access.
     /// @param isCubeTexture    Specifies whether this is a cube texture. This value is used only when array size is a multiple of 6.
     ///
     /// @throw RenderAPIException
@@ -36,7 +41,7 @@ public:
     /// @param width            Width in pixel of this texture.
     /// @param height           Height in pixel of this texture.
     /// @param format           Pixel format of this texture.
-    /// @param mipmapLevels     Number of mipmap levels of this texture. Please note that mipmap will not be automatically generated. Pass 0 to use maximum supported mipmap levels.
+    /// @param mipmapLevels     Number of mipmap levels of this texture. Pass 0 to use maximum supported mipmap levels. Mipmaps are not automatically generated, use @p CommandBuffer::GenerateMips() to generate them if the format supports unordered access.
     ///
     /// @throw RenderAPIException
     ///   Thrown if failed to create D3D12 resource for this texture.
@@ -61,6 +66,17 @@ public:
     ///   Destroy this texture.
     YAGE_API ~Texture() noexcept override;
 
+    /// @brief
+    ///   Load a texture from image file asynchronously on worker threads of @p ThreadPool::Singleton().
+    /// @remarks
+    ///   The image is decoded directly into temporary upload buffer of a copy command buffer on the worker thread and then submitted to the copy command queue, so that pixels are written only once on CPU. Files with @p .dds extension are loaded as @p DDSImage, including block-compressed formats, texture arrays, cube maps and mip chains. The texture is in common state once the upload is finished. Use @p CommandBuffer::WaitForSyncPoint() with the returned sync point before using the texture on other command queues. This method is thread-safe.
+    ///
+    /// @param path     Path to the image file. The path is copied before this method returns.
+    ///
+    /// @return std::future<TextureLoadResult>
+    ///   Return a future that could be used to poll or wait for the texture. @p SystemErrorException or @p RenderAPIException is rethrown by @p std::future::get() if failed to load or upload the image.
+    YAGE_NODISCARD YAGE_API static auto LoadAsync(StringView path) -> std::future<TextureLoadResult>;
+
     /// @brief
     ///   Checks whether this is a cube texture.
     ///
@@ -84,4 +100,12 @@ private:
     YaGE::ShaderResourceView srv;
 };
 
+struct TextureLoadResult {
+    /// @brief  The loaded texture.
+    Texture texture;
+
+    /// @brief  The sync point that indicates when pixels are uploaded to the texture on the copy command queue.
+    uint64_t syncPoint;
+};
+
 } // namespace YaGE
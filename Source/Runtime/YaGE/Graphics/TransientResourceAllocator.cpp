@@ -0,0 +1,278 @@
+#include "TransientResourceAllocator.h"
+#include "../Core/Exception.h"
+
+#include <algorithm>
+
+using namespace YaGE;
+using Microsoft::WRL::ComPtr;
+
+namespace {
+
+/// @brief
+///   Align up the specified value.
+///
+/// @param value        The value to be aligned.
+/// @param alignment    The alignment. Must be power of 2.
+///
+/// @return uint64_t
+///   Return the aligned value.
+YAGE_NODISCARD YAGE_FORCEINLINE auto AlignUp(uint64_t value, uint64_t alignment) noexcept -> uint64_t {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+/// @brief
+///   Checks if two placed resource descriptions are the same.
+///
+/// @param lhs  The first resource description.
+/// @param rhs  The second resource description.
+///
+/// @return bool
+/// @retval true    The two descriptions are the same.
+/// @retval false   The two descriptions are different.
+YAGE_NODISCARD auto IsSameDesc(const D3D12_RESOURCE_DESC &lhs, const D3D12_RESOURCE_DESC &rhs) noexcept -> bool {
+    return lhs.Width == rhs.Width && lhs.Height == rhs.Height && lhs.DepthOrArraySize == rhs.DepthOrArraySize &&
+           lhs.MipLevels == rhs.MipLevels && lhs.Format == rhs.Format &&
+           lhs.SampleDesc.Count == rhs.SampleDesc.Count && lhs.Flags == rhs.Flags;
+}
+
+} // namespace
+
+YaGE::TransientResourceAllocator::TransientResourceAllocator(uint64_t heapSize)
+    : renderDevice(RenderDevice::Singleton()),
+      heapSize(AlignUp(heapSize, D3D12_DEFAULT_MSAA_RESOURCE_PLACEMENT_ALIGNMENT)),
+      heaps(),
+      entries(),
+      memoryUsage(),
+      peakMemoryUsage(),
+      lastSyncPoint() {}
+
+YaGE::TransientResourceAllocator::~TransientResourceAllocator() noexcept {
+    renderDevice.Sync(lastSyncPoint);
+
+    // Placed resources must be released before heaps.
+    entries.clear();
+    for (const auto &heap : heaps)
+        renderDevice.TrackMemoryUsage(GpuMemoryCategory::RenderTarget, -static_cast<int64_t>(heap->size));
+    heaps.clear();
+}
+
+auto YaGE::TransientResourceAllocator::AcquireColorBuffer(uint32_t    width,
+                                                          uint32_t    height,
+                                                          DXGI_FORMAT format,
+                                                          uint32_t    sampleCount) -> ColorBuffer & {
+    const D3D12_RESOURCE_DESC desc = ColorBuffer::ResourceDesc(width, height, 1, format, 1, sampleCount);
+    return static_cast<ColorBuffer &>(Acquire(desc, false));
+}
+
+auto YaGE::TransientResourceAllocator::AcquireDepthBuffer(uint32_t    width,
+                                                          uint32_t    height,
+                                                          DXGI_FORMAT format,
+                                                          uint32_t    sampleCount) -> DepthBuffer & {
+    const D3D12_RESOURCE_DESC desc = DepthBuffer::ResourceDesc(width, height, format, sampleCount);
+    return static_cast<DepthBuffer &>(Acquire(desc, true));
+}
+
+auto YaGE::TransientResourceAllocator::Release(PixelBuffer &buffer) noexcept -> void {
+    for (auto &entry : entries) {
+        if (entry.buffer.get() != &buffer)
+            continue;
+
+        if (entry.inUse) {
+            FreeRange(*entry.heap, entry.range);
+            entry.inUse = false;
+            memoryUsage -= entry.range.size;
+        }
+
+        return;
+    }
+}
+
+auto YaGE::TransientResourceAllocator::Reset(uint64_t syncPoint) noexcept -> void {
+    lastSyncPoint = syncPoint;
+
+    for (auto &entry : entries) {
+        if (entry.inUse) {
+            FreeRange(*entry.heap, entry.range);
+            entry.inUse = false;
+            memoryUsage -= entry.range.size;
+        }
+
+        if (entry.usedThisFrame) {
+            entry.usedThisFrame = false;
+            entry.idleFrames    = 0;
+            entry.syncPoint     = syncPoint;
+        } else {
+            entry.idleFrames += 1;
+        }
+    }
+
+    // Destroy transient buffers that have not been used for a while and are no longer used by GPU.
+    entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                 [this](const Entry &entry) -> bool {
+                                     return entry.idleFrames > MAX_IDLE_FRAMES &&
+                                            renderDevice.IsSyncPointReached(entry.syncPoint);
+                                 }),
+                  entries.end());
+
+    // Destroy heaps that no transient buffer is placed in.
+    heaps.erase(std::remove_if(heaps.begin(), heaps.end(),
+                               [this](const std::unique_ptr<Heap> &heap) -> bool {
+                                   for (const auto &entry : entries) {
+                                       if (entry.heap == heap.get())
+                                           return false;
+                                   }
+
+                                   renderDevice.TrackMemoryUsage(GpuMemoryCategory::RenderTarget,
+                                                                 -static_cast<int64_t>(heap->size));
+                                   return true;
+                               }),
+                heaps.end());
+}
+
+auto YaGE::TransientResourceAllocator::HeapMemorySize() const noexcept -> uint64_t {
+    uint64_t size = 0;
+    for (const auto &heap : heaps)
+        size += heap->size;
+    return size;
+}
+
+auto YaGE::TransientResourceAllocator::Acquire(const D3D12_RESOURCE_DESC &desc, bool isDepth) -> PixelBuffer & {
+    // Reuse placed buffers with the same description if their memory is still free.
+    for (auto &entry : entries) {
+        if (entry.inUse || !IsSameDesc(entry.desc, desc) || !AllocateRange(*entry.heap, entry.range))
+            continue;
+
+        entry.inUse         = true;
+        entry.usedThisFrame = true;
+        memoryUsage += entry.range.size;
+        peakMemoryUsage = std::max(peakMemoryUsage, memoryUsage);
+
+        return *entry.buffer;
+    }
+
+    ID3D12Device1 *const                 device = renderDevice.Device();
+    const D3D12_RESOURCE_ALLOCATION_INFO info   = device->GetResourceAllocationInfo(0, 1, &desc);
+
+    // Find the first free range that could hold the resource.
+    Heap       *heap = nullptr;
+    MemoryRange range{};
+    for (auto &candidate : heaps) {
+        for (const auto &freeRange : candidate->freeRanges) {
+            const uint64_t offset = AlignUp(freeRange.offset, info.Alignment);
+            if (offset + info.SizeInBytes <= freeRange.offset + freeRange.size) {
+                heap  = candidate.get();
+                range = MemoryRange{offset, info.SizeInBytes};
+                break;
+            }
+        }
+
+        if (heap != nullptr)
+            break;
+    }
+
+    // Create a new heap if there is no enough free space.
+    if (heap == nullptr) {
+        const uint64_t size =
+            std::max(heapSize, AlignUp(info.SizeInBytes, D3D12_DEFAULT_MSAA_RESOURCE_PLACEMENT_ALIGNMENT));
+
+        const D3D12_HEAP_DESC heapDesc{
+            /* SizeInBytes = */ size,
+            /* Properties  = */
+            {
+                /* Type                 = */ D3D12_HEAP_TYPE_DEFAULT,
+                /* CPUPageProperty      = */ D3D12_CPU_PAGE_PROPERTY_UNKNOWN,
+                /* MemoryPoolPreference = */ D3D12_MEMORY_POOL_UNKNOWN,
+                /* CreationNodeMask     = */ 0,
+                /* VisibleNodeMask      = */ 0,
+            },
+            /* Alignment = */ D3D12_DEFAULT_MSAA_RESOURCE_PLACEMENT_ALIGNMENT,
+            /* Flags     = */ D3D12_HEAP_FLAG_ALLOW_ONLY_RT_DS_TEXTURES,
+        };
+
+        ComPtr<ID3D12Heap> d3d12Heap;
+        HRESULT            hr = device->CreateHeap(&heapDesc, IID_PPV_ARGS(d3d12Heap.GetAddressOf()));
+        if (FAILED(hr))
+            throw RenderAPIException(hr, u"Failed to create ID3D12Heap for transient resources.");
+
+        renderDevice.TrackMemoryUsage(GpuMemoryCategory::RenderTarget, static_cast<int64_t>(size));
+
+        heaps.push_back(std::make_unique<Heap>(Heap{std::move(d3d12Heap), size, {MemoryRange{0, size}}}));
+        heap  = heaps.back().get();
+        range = MemoryRange{0, info.SizeInBytes};
+    }
+
+    std::unique_ptr<PixelBuffer> buffer;
+    if (isDepth)
+        buffer = std::make_unique<DepthBuffer>(heap->heap.Get(), range.offset, desc);
+    else
+        buffer = std::make_unique<ColorBuffer>(heap->heap.Get(), range.offset, desc);
+
+    AllocateRange(*heap, range);
+    memoryUsage += range.size;
+    peakMemoryUsage = std::max(peakMemoryUsage, memoryUsage);
+
+    entries.push_back(Entry{
+        /* buffer        = */ std::move(buffer),
+        /* desc          = */ desc,
+        /* heap          = */ heap,
+        /* range         = */ range,
+        /* inUse         = */ true,
+        /* usedThisFrame = */ true,
+        /* idleFrames    = */ 0,
+        /* syncPoint     = */ 0,
+    });
+
+    return *entries.back().buffer;
+}
+
+auto YaGE::TransientResourceAllocator::AllocateRange(Heap &heap, MemoryRange range) noexcept -> bool {
+    auto &freeRanges = heap.freeRanges;
+    for (size_t i = 0; i < freeRanges.size(); ++i) {
+        const MemoryRange freeRange = freeRanges[i];
+        if (range.offset < freeRange.offset || range.offset + range.size > freeRange.offset + freeRange.size)
+            continue;
+
+        const uint64_t tailOffset = range.offset + range.size;
+        const uint64_t tailSize   = freeRange.offset + freeRange.size - tailOffset;
+
+        // Split the free range into head and tail.
+        if (range.offset > freeRange.offset) {
+            freeRanges[i].size = range.offset - freeRange.offset;
+            if (tailSize != 0)
+                freeRanges.insert(freeRanges.begin() + i + 1, MemoryRange{tailOffset, tailSize});
+        } else if (tailSize != 0) {
+            freeRanges[i] = MemoryRange{tailOffset, tailSize};
+        } else {
+            freeRanges.erase(freeRanges.begin() + i);
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+auto YaGE::TransientResourceAllocator::FreeRange(Heap &heap, MemoryRange range) noexcept -> void {
+    auto &freeRanges = heap.freeRanges;
+
+    auto iter = std::lower_bound(
+        freeRanges.begin(), freeRanges.end(), range,
+        [](const MemoryRange &lhs, const MemoryRange &rhs) -> bool { return lhs.offset < rhs.offset; });
+    iter = freeRanges.insert(iter, range);
+
+    // Merge with the next range.
+    auto next = iter + 1;
+    if (next != freeRanges.end() && iter->offset + iter->size == next->offset) {
+        iter->size += next->size;
+        iter = freeRanges.erase(next) - 1;
+    }
+
+    // Merge with the previous range.
+    if (iter != freeRanges.begin()) {
+        auto prev = iter - 1;
+        if (prev->offset + prev->size == iter->offset) {
+            prev->size += iter->size;
+            freeRanges.erase(iter);
+        }
+    }
+}
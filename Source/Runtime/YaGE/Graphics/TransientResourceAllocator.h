@@ -0,0 +1,196 @@
+#pragma once
+
+#include "ColorBuffer.h"
+#include "DepthBuffer.h"
+#include "RenderDevice.h"
+
+#include <memory>
+#include <vector>
+
+namespace YaGE {
+
+class TransientResourceAllocator {
+public:
+    /// @brief
+    ///   Create an empty transient resource allocator. Heaps are created on demand.
+    ///
+    /// @param heapSize     Size in byte of each heap. Resources that are larger than this size are placed in dedicated heaps.
+    YAGE_API explicit TransientResourceAllocator(uint64_t heapSize = 0x10000000);
+
+    /// @brief
+    ///   Copy constructor is disabled.
+    TransientResourceAllocator(const TransientResourceAllocator &) = delete;
+
+    /// @brief
+    ///   Copy assignment is disabled.
+    auto operator=(const TransientResourceAllocator &) = delete;
+
+    /// @brief
+    ///   Destroy this transient resource allocator. This method waits for the last sync point passed to @p Reset() to be reached.
+    YAGE_API ~TransientResourceAllocator() noexcept;
+
+    /// @brief
+    ///   Acquire a transient color buffer. The color buffer is placed in a heap and may alias memory with other transient resources that are not in use.
+    /// @remarks
+    ///   Placed color buffers that were released with the same description are reused if their memory is still free, so that resource creation is avoided in steady state.
+    /// @note
+    ///   Content of the acquired color buffer is undefined. An aliasing barrier must be recorded before using it, and it must be initialized with a clear, discard or copy operation.
+    ///
+    /// @param width        Width in pixel of the color buffer.
+    /// @param height       Height in pixel of the color buffer.
+    /// @param format       Pixel format of the color buffer.
+    /// @param sampleCount  Number of samples of the color buffer.
+    ///
+    /// @return ColorBuffer &
+    ///   Return reference to the acquired color buffer. The reference is valid until this allocator is destroyed or the color buffer is evicted by @p Reset().
+    /// @throw RenderAPIException
+    ///   Thrown if failed to create heap or placed resource.
+    YAGE_NODISCARD YAGE_API auto
+    AcquireColorBuffer(uint32_t width, uint32_t height, DXGI_FORMAT format, uint32_t sampleCount = 1) -> ColorBuffer &;
+
+    /// @brief
+    ///   Acquire a transient depth buffer. The depth buffer is placed in a heap and may alias memory with other transient resources that are not in use.
+    /// @note
+    ///   Content of the acquired depth buffer is undefined. An aliasing barrier must be recorded before using it, and it must be initialized with a clear, discard or copy operation.
+    ///
+    /// @param width        Width in pixel of the depth buffer.
+    /// @param height       Height in pixel of the depth buffer.
+    /// @param format       Pixel format of the depth buffer.
+    /// @param sampleCount  Number of samples of the depth buffer.
+    ///
+    /// @return DepthBuffer &
+    ///   Return reference to the acquired depth buffer. The reference is valid until this allocator is destroyed or the depth buffer is evicted by @p Reset().
+    /// @throw RenderAPIException
+    ///   Thrown if failed to create heap or placed resource.
+    YAGE_NODISCARD YAGE_API auto
+    AcquireDepthBuffer(uint32_t width, uint32_t height, DXGI_FORMAT format, uint32_t sampleCount = 1) -> DepthBuffer &;
+
+    /// @brief
+    ///   Release a transient buffer so that its memory could be aliased by other transient resources. Commands that are recorded later in the same queue could reuse the memory once an aliasing barrier is recorded.
+    ///
+    /// @param buffer   The transient buffer to be released. This must be acquired from this allocator.
+    YAGE_API auto Release(PixelBuffer &buffer) noexcept -> void;
+
+    /// @brief
+    ///   Finish current frame. All transient buffers that are still in use are released. Transient buffers that have not been used for a while are destroyed once GPU finishes using them.
+    ///
+    /// @param syncPoint    The sync point that indicates when GPU finishes using transient buffers acquired in current frame.
+    YAGE_API auto Reset(uint64_t syncPoint) noexcept -> void;
+
+    /// @brief
+    ///   Get peak size in byte of heap memory that has been used by transient buffers at the same time.
+    ///
+    /// @return uint64_t
+    ///   Return peak size in byte of used heap memory.
+    YAGE_NODISCARD auto PeakMemoryUsage() const noexcept -> uint64_t { return peakMemoryUsage; }
+
+    /// @brief
+    ///   Get total size in byte of heaps that are created by this allocator.
+    ///
+    /// @return uint64_t
+    ///   Return total size in byte of heaps.
+    YAGE_NODISCARD YAGE_API auto HeapMemorySize() const noexcept -> uint64_t;
+
+private:
+    struct MemoryRange {
+        /// @brief  Offset in byte from start of the heap.
+        uint64_t offset;
+
+        /// @brief  Size in byte of this range.
+        uint64_t size;
+    };
+
+    struct Heap {
+        /// @brief  The D3D12 heap object.
+        Microsoft::WRL::ComPtr<ID3D12Heap> heap;
+
+        /// @brief  Size in byte of this heap.
+        uint64_t size;
+
+        /// @brief  Free ranges of this heap, sorted by offset. Adjacent free ranges are always merged.
+        std::vector<MemoryRange> freeRanges;
+    };
+
+    struct Entry {
+        /// @brief  The placed transient buffer.
+        std::unique_ptr<PixelBuffer> buffer;
+
+        /// @brief  Description of the placed resource.
+        D3D12_RESOURCE_DESC desc;
+
+        /// @brief  The heap that this buffer is placed in.
+        Heap *heap;
+
+        /// @brief  Memory range of this buffer in the heap.
+        MemoryRange range;
+
+        /// @brief  Whether this buffer is currently acquired.
+        bool inUse;
+
+        /// @brief  Whether this buffer has been acquired in current frame.
+        bool usedThisFrame;
+
+        /// @brief  Number of frames since this buffer was used last time.
+        uint32_t idleFrames;
+
+        /// @brief  The sync point that indicates when GPU finishes using this buffer.
+        uint64_t syncPoint;
+    };
+
+    /// @brief
+    ///   Acquire a transient buffer with the specified description.
+    ///
+    /// @param desc     Description of the placed resource.
+    /// @param isDepth  Whether to create a depth buffer or a color buffer.
+    ///
+    /// @return PixelBuffer &
+    ///   Return reference to the acquired transient buffer.
+    /// @throw RenderAPIException
+    ///   Thrown if failed to create heap or placed resource.
+    auto Acquire(const D3D12_RESOURCE_DESC &desc, bool isDepth) -> PixelBuffer &;
+
+    /// @brief
+    ///   Try to remove the specified range from free ranges of the heap.
+    ///
+    /// @param heap     The heap to allocate memory from.
+    /// @param range    The memory range to be allocated.
+    ///
+    /// @return bool
+    /// @retval true    The range is free and has been removed from free ranges.
+    /// @retval false   The range is not free.
+    static auto AllocateRange(Heap &heap, MemoryRange range) noexcept -> bool;
+
+    /// @brief
+    ///   Return the specified range to free ranges of the heap and merge it with adjacent free ranges.
+    ///
+    /// @param heap     The heap to free memory to.
+    /// @param range    The memory range to be freed.
+    static auto FreeRange(Heap &heap, MemoryRange range) noexcept -> void;
+
+    /// @brief  Number of frames that unused transient buffers are kept before being destroyed.
+    static constexpr const uint32_t MAX_IDLE_FRAMES = 8;
+
+private:
+    /// @brief  The render device that is used to create heaps.
+    RenderDevice &renderDevice;
+
+    /// @brief  Size in byte of each heap.
+    uint64_t heapSize;
+
+    /// @brief  Heaps that transient buffers are placed in.
+    std::vector<std::unique_ptr<Heap>> heaps;
+
+    /// @brief  Placed transient buffers.
+    std::vector<Entry> entries;
+
+    /// @brief  Size in byte of heap memory that is currently used.
+    uint64_t memoryUsage;
+
+    /// @brief  Peak size in byte of heap memory that has been used.
+    uint64_t peakMemoryUsage;
+
+    /// @brief  The last sync point passed to @p Reset().
+    uint64_t lastSyncPoint;
+};
+
+} // namespace YaGE
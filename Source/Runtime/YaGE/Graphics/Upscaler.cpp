@@ -0,0 +1,147 @@
+#include "Upscaler.h"
+#include "../Core/Exception.h"
+
+#include <d3dcompiler.h>
+
+#include <cstring>
+
+using namespace YaGE;
+using Microsoft::WRL::ComPtr;
+
+namespace {
+
+/// @brief
+///   HLSL source of the upscaling shaders. The vertex shader generates a fullscreen triangle without vertex buffers. The pixel shader maps the whole render target to the active region of the source texture and samples it bilinearly.
+///   UVClamp is the UV of the center of the last texel in the active region, so that texels outside the active region are never sampled.
+constexpr const char UPSCALER_SHADER[] = R"(
+cbuffer UpscaleConstants : register(b0) {
+    float2 UVScale;
+    float2 UVClamp;
+};
+
+Texture2D<float4> Source             : register(t0);
+SamplerState      LinearClampSampler : register(s0);
+
+struct VSOutput {
+    float4 position : SV_Position;
+    float2 uv       : TEXCOORD0;
+};
+
+VSOutput VSMain(uint vertexID : SV_VertexID) {
+    VSOutput output;
+    output.uv       = float2((vertexID << 1) & 2, vertexID & 2);
+    output.position = float4(output.uv * float2(2.0, -2.0) + float2(-1.0, 1.0), 0.0, 1.0);
+    return output;
+}
+
+float4 PSMain(VSOutput input) : SV_Target0 {
+    const float2 uv = min(input.uv * UVScale, UVClamp);
+    return Source.SampleLevel(LinearClampSampler, uv, 0);
+}
+)";
+
+/// @brief
+///   Create root signature description of the upscaling shaders.
+///
+/// @return D3D12_ROOT_SIGNATURE_DESC
+///   Return the root signature description. Parameters and static samplers are stored in static storage.
+YAGE_NODISCARD auto UpscalerRootSignatureDesc() noexcept -> D3D12_ROOT_SIGNATURE_DESC {
+    static const D3D12_DESCRIPTOR_RANGE range{
+        /* RangeType                         = */ D3D12_DESCRIPTOR_RANGE_TYPE_SRV,
+        /* NumDescriptors                    = */ 1,
+        /* BaseShaderRegister                = */ 0,
+        /* RegisterSpace                     = */ 0,
+        /* OffsetInDescriptorsFromTableStart = */ 0,
+    };
+
+    static D3D12_ROOT_PARAMETER parameters[2];
+    parameters[0].ParameterType            = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
+    parameters[0].Constants.ShaderRegister = 0;
+    parameters[0].Constants.RegisterSpace  = 0;
+    parameters[0].Constants.Num32BitValues = 4;
+    parameters[0].ShaderVisibility         = D3D12_SHADER_VISIBILITY_PIXEL;
+
+    parameters[1].ParameterType                       = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
+    parameters[1].DescriptorTable.NumDescriptorRanges = 1;
+    parameters[1].DescriptorTable.pDescriptorRanges   = &range;
+    parameters[1].ShaderVisibility                    = D3D12_SHADER_VISIBILITY_PIXEL;
+
+    static const D3D12_STATIC_SAMPLER_DESC sampler{
+        /* Filter           = */ D3D12_FILTER_MIN_MAG_MIP_LINEAR,
+        /* AddressU         = */ D3D12_TEXTURE_ADDRESS_MODE_CLAMP,
+        /* AddressV         = */ D3D12_TEXTURE_ADDRESS_MODE_CLAMP,
+        /* AddressW         = */ D3D12_TEXTURE_ADDRESS_MODE_CLAMP,
+        /* MipLODBias       = */ 0.0f,
+        /* MaxAnisotropy    = */ 1,
+        /* ComparisonFunc   = */ D3D12_COMPARISON_FUNC_NEVER,
+        /* BorderColor      = */ D3D12_STATIC_BORDER_COLOR_TRANSPARENT_BLACK,
+        /* MinLOD           = */ 0.0f,
+        /* MaxLOD           = */ D3D12_FLOAT32_MAX,
+        /* ShaderRegister   = */ 0,
+        /* RegisterSpace    = */ 0,
+        /* ShaderVisibility = */ D3D12_SHADER_VISIBILITY_PIXEL,
+    };
+
+    return D3D12_ROOT_SIGNATURE_DESC{
+        /* NumParameters     = */ 2,
+        /* pParameters       = */ parameters,
+        /* NumStaticSamplers = */ 1,
+        /* pStaticSamplers   = */ &sampler,
+        /* Flags             = */ D3D12_ROOT_SIGNATURE_FLAG_DENY_VERTEX_SHADER_ROOT_ACCESS,
+    };
+}
+
+} // namespace
+
+YaGE::Upscaler::Upscaler()
+    : rootSignature(UpscalerRootSignatureDesc()), vertexShader(), pixelShader(), mutex(), pipelineStates() {
+    ComPtr<ID3DBlob> error;
+
+    HRESULT hr = D3DCompile(UPSCALER_SHADER, sizeof(UPSCALER_SHADER) - 1, "Upscaler", nullptr, nullptr, "VSMain",
+                            "vs_5_1", D3DCOMPILE_OPTIMIZATION_LEVEL3, 0, vertexShader.GetAddressOf(),
+                            error.GetAddressOf());
+    if (FAILED(hr))
+        throw RenderAPIException(hr, u"Failed to compile upscaling vertex shader.");
+
+    hr = D3DCompile(UPSCALER_SHADER, sizeof(UPSCALER_SHADER) - 1, "Upscaler", nullptr, nullptr, "PSMain", "ps_5_1",
+                    D3DCOMPILE_OPTIMIZATION_LEVEL3, 0, pixelShader.GetAddressOf(), error.ReleaseAndGetAddressOf());
+    if (FAILED(hr))
+        throw RenderAPIException(hr, u"Failed to compile upscaling pixel shader.");
+}
+
+YaGE::Upscaler::~Upscaler() noexcept {}
+
+auto YaGE::Upscaler::PipelineState(DXGI_FORMAT format) -> GraphicsPipelineState & {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto iter = pipelineStates.find(format);
+    if (iter != pipelineStates.end())
+        return iter->second;
+
+    D3D12_GRAPHICS_PIPELINE_STATE_DESC desc;
+    std::memset(&desc, 0, sizeof(desc));
+
+    desc.pRootSignature                  = rootSignature.D3D12RootSignature();
+    desc.VS.pShaderBytecode              = vertexShader->GetBufferPointer();
+    desc.VS.BytecodeLength               = vertexShader->GetBufferSize();
+    desc.PS.pShaderBytecode              = pixelShader->GetBufferPointer();
+    desc.PS.BytecodeLength               = pixelShader->GetBufferSize();
+    desc.SampleMask                      = UINT_MAX;
+    desc.RasterizerState.FillMode        = D3D12_FILL_MODE_SOLID;
+    desc.RasterizerState.CullMode        = D3D12_CULL_MODE_NONE;
+    desc.RasterizerState.DepthClipEnable = TRUE;
+    desc.PrimitiveTopologyType           = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
+    desc.NumRenderTargets                = 1;
+    desc.RTVFormats[0]                   = format;
+    desc.SampleDesc.Count                = 1;
+
+    desc.BlendState.RenderTarget[0].RenderTargetWriteMask = D3D12_COLOR_WRITE_ENABLE_ALL;
+
+    auto result = pipelineStates.emplace(format, GraphicsPipelineState(rootSignature, desc));
+    return result.first->second;
+}
+
+auto YaGE::Upscaler::Singleton() -> Upscaler & {
+    static Upscaler instance;
+    return instance;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "PipelineState.h"
+
+#include <mutex>
+#include <unordered_map>
+
+namespace YaGE {
+
+class Upscaler {
+public:
+    /// @brief
+    ///   Create a bilinear upscaler. Shaders are compiled and the root signature is created in this constructor. Graphics pipeline states are created on demand for each render target format.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to compile the shaders or failed to create root signature.
+    YAGE_API Upscaler();
+
+    /// @brief
+    ///   Copy constructor is disabled.
+    Upscaler(const Upscaler &) = delete;
+
+    /// @brief
+    ///   Copy assignment is disabled.
+    auto operator=(const Upscaler &) = delete;
+
+    /// @brief
+    ///   Destroy this upscaler.
+    YAGE_API ~Upscaler() noexcept;
+
+    /// @brief
+    ///   Get root signature of the upscaling shaders.
+    /// @remarks
+    ///   Root parameter 0 is 4 32-bit root constants of UV scale and UV clamp bound, root parameter 1 is a descriptor table of the source SRV.
+    ///
+    /// @return RootSignature &
+    ///   Return reference to the root signature.
+    YAGE_NODISCARD auto RootSignature() noexcept -> YaGE::RootSignature & { return rootSignature; }
+
+    /// @brief
+    ///   Get graphics pipeline state that upscales to render targets of the specified format. The pipeline state is created on first use. This method is thread-safe.
+    ///
+    /// @param format   Render target view format of the destination render target.
+    ///
+    /// @return GraphicsPipelineState &
+    ///   Return reference to the graphics pipeline state.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to create the graphics pipeline state.
+    YAGE_NODISCARD YAGE_API auto PipelineState(DXGI_FORMAT format) -> GraphicsPipelineState &;
+
+    /// @brief
+    ///   Get global singleton instance of upscaler. The upscaler is created on first use.
+    ///
+    /// @return Upscaler &
+    ///   Return reference to the upscaler singleton instance.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to create the upscaler.
+    YAGE_NODISCARD YAGE_API static auto Singleton() -> Upscaler &;
+
+private:
+    /// @brief  Root signature of the upscaling shaders.
+    YaGE::RootSignature rootSignature;
+
+    /// @brief  Compiled fullscreen triangle vertex shader.
+    Microsoft::WRL::ComPtr<ID3DBlob> vertexShader;
+
+    /// @brief  Compiled bilinear sampling pixel shader.
+    Microsoft::WRL::ComPtr<ID3DBlob> pixelShader;
+
+    /// @brief  Mutex to protect pipeline states.
+    std::mutex mutex;
+
+    /// @brief  Graphics pipeline states of each render target format.
+    std::unordered_map<DXGI_FORMAT, GraphicsPipelineState> pipelineStates;
+};
+
+} // namespace YaGE
@@ -0,0 +1,330 @@
+#include "Batch.h"
+#include "BatchKernels.h"
+#include "../Core/Cpu.h"
+#include "../Core/ThreadPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+using namespace YaGE;
+
+namespace {
+
+/// @brief
+///   4-wide SSE lanes. Each lane processes one element of the input streams.
+struct SseLanes {
+    using Float = __m128;
+    using Mask  = __m128;
+
+    static constexpr const size_t WIDTH = 4;
+
+    static YAGE_FORCEINLINE auto Load(const float *p) noexcept -> Float { return _mm_loadu_ps(p); }
+    static YAGE_FORCEINLINE auto Store(float *p, Float v) noexcept -> void { _mm_storeu_ps(p, v); }
+    static YAGE_FORCEINLINE auto Set(float v) noexcept -> Float { return _mm_set1_ps(v); }
+    static YAGE_FORCEINLINE auto Add(Float a, Float b) noexcept -> Float { return _mm_add_ps(a, b); }
+    static YAGE_FORCEINLINE auto Sub(Float a, Float b) noexcept -> Float { return _mm_sub_ps(a, b); }
+    static YAGE_FORCEINLINE auto Mul(Float a, Float b) noexcept -> Float { return _mm_mul_ps(a, b); }
+    static YAGE_FORCEINLINE auto MulAdd(Float a, Float b, Float c) noexcept -> Float {
+        return _mm_add_ps(_mm_mul_ps(a, b), c);
+    }
+
+    static YAGE_FORCEINLINE auto Max(Float a, Float b) noexcept -> Float { return _mm_max_ps(a, b); }
+    static YAGE_FORCEINLINE auto Abs(Float a) noexcept -> Float { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+    static YAGE_FORCEINLINE auto Sqrt(Float a) noexcept -> Float { return _mm_sqrt_ps(a); }
+    static YAGE_FORCEINLINE auto CmpGe(Float a, Float b) noexcept -> Mask { return _mm_cmpge_ps(a, b); }
+    static YAGE_FORCEINLINE auto And(Mask a, Mask b) noexcept -> Mask { return _mm_and_ps(a, b); }
+
+    static YAGE_FORCEINLINE auto MoveMask(Mask a) noexcept -> uint32_t {
+        return static_cast<uint32_t>(_mm_movemask_ps(a));
+    }
+
+    /// @brief
+    ///   Load elements of 4 matrices. Element (row, column) of each matrix is stored in @p e[row * 4 + column].
+    static YAGE_FORCEINLINE auto LoadMatrices(const Matrix4 *matrices, Float e[16]) noexcept -> void {
+        const float *src = reinterpret_cast<const float *>(matrices);
+        for (size_t row = 0; row < 4; ++row) {
+            const float *p = src + row * 4;
+
+            Float a = _mm_loadu_ps(p);
+            Float b = _mm_loadu_ps(p + 16);
+            Float c = _mm_loadu_ps(p + 32);
+            Float d = _mm_loadu_ps(p + 48);
+            _MM_TRANSPOSE4_PS(a, b, c, d);
+
+            e[row * 4 + 0] = a;
+            e[row * 4 + 1] = b;
+            e[row * 4 + 2] = c;
+            e[row * 4 + 3] = d;
+        }
+    }
+
+    /// @brief
+    ///   Store elements of 4 matrices. Element (row, column) of each matrix is stored in @p e[row * 4 + column].
+    static YAGE_FORCEINLINE auto StoreMatrices(Matrix4 *matrices, Float e[16]) noexcept -> void {
+        float *dst = reinterpret_cast<float *>(matrices);
+        for (size_t row = 0; row < 4; ++row) {
+            float *p = dst + row * 4;
+
+            Float a = e[row * 4 + 0];
+            Float b = e[row * 4 + 1];
+            Float c = e[row * 4 + 2];
+            Float d = e[row * 4 + 3];
+            _MM_TRANSPOSE4_PS(a, b, c, d);
+
+            _mm_storeu_ps(p, a);
+            _mm_storeu_ps(p + 16, b);
+            _mm_storeu_ps(p + 32, c);
+            _mm_storeu_ps(p + 48, d);
+        }
+    }
+
+    /// @brief
+    ///   Multiply matrices by the same right-hand matrix. Each row of the result is a linear combination of rows of the right-hand matrix.
+    static auto MultiplyMatrices(const Matrix4 *matrices,
+                                 const Matrix4 &rhs,
+                                 Matrix4       *out,
+                                 size_t         first,
+                                 size_t         last) noexcept -> void {
+        const float *r  = reinterpret_cast<const float *>(&rhs);
+        const Float  r0 = _mm_loadu_ps(r);
+        const Float  r1 = _mm_loadu_ps(r + 4);
+        const Float  r2 = _mm_loadu_ps(r + 8);
+        const Float  r3 = _mm_loadu_ps(r + 12);
+
+        for (size_t i = first; i < last; ++i) {
+            const float *src = reinterpret_cast<const float *>(matrices + i);
+            float       *dst = reinterpret_cast<float *>(out + i);
+
+            for (size_t row = 0; row < 4; ++row) {
+                const Float v = _mm_loadu_ps(src + row * 4);
+
+                Float x = _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)), r0);
+                x       = _mm_add_ps(x, _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)), r1));
+                x       = _mm_add_ps(x, _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2)), r2));
+                x       = _mm_add_ps(x, _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)), r3));
+
+                _mm_storeu_ps(dst + row * 4, x);
+            }
+        }
+    }
+};
+
+/// @brief  Arrays smaller than twice of this size are processed on current thread.
+constexpr const size_t MIN_CHUNK_SIZE = 2048;
+
+/// @brief  Maximum number of chunks that an array is split into.
+constexpr const size_t MAX_CHUNK_COUNT = 64;
+
+/// @brief  Chunk size is aligned to this value, so that only the last chunk has scalar tails.
+constexpr const size_t CHUNK_ALIGNMENT = 8;
+
+/// @brief
+///   Get batch math kernels that are selected for current processor.
+YAGE_NODISCARD auto BatchKernels() noexcept -> const BatchKernelTable & {
+    static const BatchKernelTable sseKernels = MakeBatchKernelTable<SseLanes>();
+    static const BatchKernelTable &kernels   = IsAvx2Supported() ? Avx2BatchKernels() : sseKernels;
+    return kernels;
+}
+
+/// @brief
+///   Wait for the specified task. Current thread executes other pending tasks while waiting, so that calling batch functions on worker threads never blocks the whole thread pool.
+auto WaitFor(ThreadPool &threadPool, std::future<void> &future) noexcept -> void {
+    while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        bool executed = false;
+        try {
+            executed = threadPool.RunPendingTask();
+        } catch (...) {
+        }
+
+        if (!executed) {
+            future.wait();
+            return;
+        }
+    }
+}
+
+/// @brief
+///   Split [0, @p count) into chunks and call @p func(chunk, first, last) for each chunk. Chunks are processed in parallel on @p ThreadPool::Singleton() if the array is large enough. The first chunk is always processed on current thread.
+///
+/// @return size_t
+///   Return size of each chunk. Only the last chunk could be smaller.
+template <typename Func>
+auto ParallelFor(size_t count, Func &func) noexcept -> size_t {
+    ThreadPool *threadPool = nullptr;
+    size_t      chunkCount = 1;
+
+    if (count >= MIN_CHUNK_SIZE * 2) {
+        try {
+            threadPool = &ThreadPool::Singleton();
+            chunkCount = std::min<size_t>(threadPool->ThreadCount() + 1, count / MIN_CHUNK_SIZE);
+            chunkCount = std::min(chunkCount, MAX_CHUNK_COUNT);
+        } catch (...) {
+            chunkCount = 1;
+        }
+    }
+
+    if (chunkCount <= 1) {
+        func(0, 0, count);
+        return count;
+    }
+
+    size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+    chunkSize        = (chunkSize + CHUNK_ALIGNMENT - 1) / CHUNK_ALIGNMENT * CHUNK_ALIGNMENT;
+    chunkCount       = (count + chunkSize - 1) / chunkSize;
+
+    std::future<void> futures[MAX_CHUNK_COUNT];
+
+    size_t submitted = 1;
+    try {
+        for (; submitted < chunkCount; ++submitted) {
+            const size_t chunk = submitted;
+            const size_t first = chunk * chunkSize;
+            const size_t last  = std::min(count, first + chunkSize);
+            futures[chunk]     = threadPool->Submit([&func, chunk, first, last]() { func(chunk, first, last); });
+        }
+    } catch (...) {
+        // Chunks that failed to be submitted are processed on current thread.
+    }
+
+    for (size_t chunk = submitted; chunk < chunkCount; ++chunk)
+        func(chunk, chunk * chunkSize, std::min(count, (chunk + 1) * chunkSize));
+
+    func(0, 0, chunkSize);
+
+    for (size_t chunk = 1; chunk < submitted; ++chunk)
+        WaitFor(*threadPool, futures[chunk]);
+
+    return chunkSize;
+}
+
+/// @brief
+///   Cull an array with the specified kernel. Each chunk writes indices at its own offset, and results are packed after all chunks are finished.
+template <typename Cull>
+auto ParallelCull(size_t count, uint32_t *visible, Cull &&cull) noexcept -> size_t {
+    size_t visibleCounts[MAX_CHUNK_COUNT];
+
+    auto process = [&cull, &visibleCounts, visible](size_t chunk, size_t first, size_t last) {
+        visibleCounts[chunk] = cull(first, last, visible + first);
+    };
+
+    const size_t chunkSize = ParallelFor(count, process);
+
+    size_t total = visibleCounts[0];
+    for (size_t chunk = 1, first = chunkSize; first < count; ++chunk, first += chunkSize) {
+        std::memmove(visible + total, visible + first, visibleCounts[chunk] * sizeof(uint32_t));
+        total += visibleCounts[chunk];
+    }
+
+    return total;
+}
+
+} // namespace
+
+YaGE::Frustum::Frustum(const Matrix4 &viewProjection) noexcept : planes() {
+    const float *m = reinterpret_cast<const float *>(&viewProjection);
+
+    // Clip space position is p * M. Column j of M dot p gives clip space component j.
+    float columns[4][4];
+    for (size_t j = 0; j < 4; ++j) {
+        for (size_t i = 0; i < 4; ++i)
+            columns[j][i] = m[i * 4 + j];
+    }
+
+    float extracted[6][4];
+    for (size_t i = 0; i < 4; ++i) {
+        extracted[0][i] = columns[3][i] + columns[0][i]; // Left:   -w <= x.
+        extracted[1][i] = columns[3][i] - columns[0][i]; // Right:   x <= w.
+        extracted[2][i] = columns[3][i] + columns[1][i]; // Bottom: -w <= y.
+        extracted[3][i] = columns[3][i] - columns[1][i]; // Top:     y <= w.
+        extracted[4][i] = columns[2][i];                 // Near:    0 <= z.
+        extracted[5][i] = columns[3][i] - columns[2][i]; // Far:     z <= w.
+    }
+
+    for (size_t p = 0; p < 6; ++p) {
+        const float *plane  = extracted[p];
+        const float  length = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+        const float  scale  = length > 0.0f ? 1.0f / length : 0.0f;
+
+        planes[p] = Vector4(plane[0] * scale, plane[1] * scale, plane[2] * scale, plane[3] * scale);
+    }
+}
+
+auto YaGE::BatchUsesAvx2() noexcept -> bool {
+    return &BatchKernels() == &Avx2BatchKernels();
+}
+
+auto YaGE::BatchMultiply(const Matrix4 *matrices, const Matrix4 &rhs, Matrix4 *out, size_t count) noexcept -> void {
+    if (count == 0)
+        return;
+
+    // Right-hand matrix may be an element of the output array.
+    const Matrix4           right   = rhs;
+    const BatchKernelTable &kernels = BatchKernels();
+
+    auto process = [&](size_t, size_t first, size_t last) { kernels.multiply(matrices, right, out, first, last); };
+    ParallelFor(count, process);
+}
+
+auto YaGE::BatchCompose(Vector3Stream    scale,
+                        QuaternionStream rotation,
+                        Vector3Stream    translation,
+                        Matrix4         *out,
+                        size_t           count) noexcept -> void {
+    if (count == 0)
+        return;
+
+    const BatchKernelTable &kernels = BatchKernels();
+
+    auto process = [&](size_t, size_t first, size_t last) {
+        kernels.compose(scale, rotation, translation, out, first, last);
+    };
+    ParallelFor(count, process);
+}
+
+auto YaGE::BatchTransformSpheres(const Matrix4 *matrices, SphereStream spheres, SphereStream out, size_t count) noexcept
+    -> void {
+    if (count == 0)
+        return;
+
+    const BatchKernelTable &kernels = BatchKernels();
+
+    auto process = [&](size_t, size_t first, size_t last) {
+        kernels.transformSpheres(matrices, spheres, out, first, last);
+    };
+    ParallelFor(count, process);
+}
+
+auto YaGE::BatchTransformBoxes(const Matrix4 *matrices, BoxStream boxes, BoxStream out, size_t count) noexcept -> void {
+    if (count == 0)
+        return;
+
+    const BatchKernelTable &kernels = BatchKernels();
+
+    auto process = [&](size_t, size_t first, size_t last) {
+        kernels.transformBoxes(matrices, boxes, out, first, last);
+    };
+    ParallelFor(count, process);
+}
+
+auto YaGE::BatchCullSpheres(const Frustum &frustum, SphereStream spheres, size_t count, uint32_t *visible) noexcept
+    -> size_t {
+    if (count == 0)
+        return 0;
+
+    const BatchKernelTable &kernels = BatchKernels();
+    return ParallelCull(count, visible, [&](size_t first, size_t last, uint32_t *dst) {
+        return kernels.cullSpheres(frustum, spheres, first, last, dst);
+    });
+}
+
+auto YaGE::BatchCullBoxes(const Frustum &frustum, BoxStream boxes, size_t count, uint32_t *visible) noexcept -> size_t {
+    if (count == 0)
+        return 0;
+
+    const BatchKernelTable &kernels = BatchKernels();
+    return ParallelCull(count, visible, [&](size_t first, size_t last, uint32_t *dst) {
+        return kernels.cullBoxes(frustum, boxes, first, last, dst);
+    });
+}
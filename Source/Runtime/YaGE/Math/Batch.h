@@ -0,0 +1,185 @@
+#pragma once
+
+#include "Matrix4.h"
+
+#include <cstdint>
+
+namespace YaGE {
+
+/// @brief
+///   Structure-of-arrays stream of 3D vectors. Each pointer refers to an array of at least the number of elements that are processed.
+struct Vector3Stream {
+    /// @brief  X components of the vectors.
+    float *x;
+
+    /// @brief  Y components of the vectors.
+    float *y;
+
+    /// @brief  Z components of the vectors.
+    float *z;
+};
+
+/// @brief
+///   Structure-of-arrays stream of quaternions. Each pointer refers to an array of at least the number of elements that are processed.
+struct QuaternionStream {
+    /// @brief  X components of the quaternions.
+    float *x;
+
+    /// @brief  Y components of the quaternions.
+    float *y;
+
+    /// @brief  Z components of the quaternions.
+    float *z;
+
+    /// @brief  W components of the quaternions.
+    float *w;
+};
+
+/// @brief
+///   Structure-of-arrays stream of bounding spheres.
+struct SphereStream {
+    /// @brief  X coordinates of sphere centers.
+    float *x;
+
+    /// @brief  Y coordinates of sphere centers.
+    float *y;
+
+    /// @brief  Z coordinates of sphere centers.
+    float *z;
+
+    /// @brief  Radius of the spheres.
+    float *radius;
+};
+
+/// @brief
+///   Structure-of-arrays stream of axis-aligned bounding boxes.
+struct BoxStream {
+    /// @brief  Minimum X coordinates of the boxes.
+    float *minX;
+
+    /// @brief  Minimum Y coordinates of the boxes.
+    float *minY;
+
+    /// @brief  Minimum Z coordinates of the boxes.
+    float *minZ;
+
+    /// @brief  Maximum X coordinates of the boxes.
+    float *maxX;
+
+    /// @brief  Maximum Y coordinates of the boxes.
+    float *maxY;
+
+    /// @brief  Maximum Z coordinates of the boxes.
+    float *maxZ;
+};
+
+/// @brief
+///   View frustum that is used to cull bounding volumes.
+struct Frustum {
+    /// @brief
+    ///   Planes of this frustum in the order of left, right, bottom, top, near and far. Each plane is (a, b, c, d) with normalized normal (a, b, c) pointing inside, so that points inside satisfy a * x + b * y + c * z + d >= 0.
+    Vector4 planes[6];
+
+    /// @brief
+    ///   Create an empty frustum. All planes are initialized with 0, so that nothing is culled.
+    YAGE_FORCEINLINE Frustum() noexcept : planes() {}
+
+    /// @brief
+    ///   Extract frustum planes from the specified view-projection matrix. The matrix transforms row vectors and maps depth to [0, 1], the same as matrices created by @p Matrix4::PerspectiveFov().
+    ///
+    /// @param viewProjection   The view-projection matrix. Planes are in world space if this is a world-space view-projection matrix.
+    YAGE_API explicit Frustum(const Matrix4 &viewProjection) noexcept;
+};
+
+/// @brief
+///   Checks which SIMD instruction set is used by batch math kernels. Kernels are selected once at runtime.
+///
+/// @return bool
+/// @retval true    AVX2 and FMA kernels are used.
+/// @retval false   SSE kernels are used.
+YAGE_NODISCARD YAGE_API auto BatchUsesAvx2() noexcept -> bool;
+
+/// @brief
+///   Multiply each matrix by the same right-hand matrix, for example multiply world matrices by a view-projection matrix.
+/// @remarks
+///   Large arrays are split and processed in parallel on @p ThreadPool::Singleton(). Input and output arrays could be the same array.
+///
+/// @param[in]  matrices    Matrices to be multiplied.
+/// @param[in]  rhs         The right-hand matrix.
+/// @param[out] out         Receives @p matrices[i] * @p rhs.
+/// @param      count       Number of matrices.
+YAGE_API auto BatchMultiply(const Matrix4 *matrices, const Matrix4 &rhs, Matrix4 *out, size_t count) noexcept -> void;
+
+/// @brief
+///   Compose transform matrices from scale, rotation and translation streams. Each result is the same as scale matrix * rotation matrix * translation matrix.
+/// @remarks
+///   Large arrays are split and processed in parallel on @p ThreadPool::Singleton(). Rotation quaternions must be normalized.
+///
+/// @param      scale       Scale stream.
+/// @param      rotation    Rotation quaternion stream.
+/// @param      translation Translation stream.
+/// @param[out] out         Receives the composed matrices.
+/// @param      count       Number of transforms.
+YAGE_API auto BatchCompose(Vector3Stream    scale,
+                           QuaternionStream rotation,
+                           Vector3Stream    translation,
+                           Matrix4         *out,
+                           size_t           count) noexcept -> void;
+
+/// @brief
+///   Transform bounding spheres with their own matrices. Radius is scaled by the maximum scale factor of each matrix, so that transformed spheres always contain transformed objects.
+/// @remarks
+///   Large arrays are split and processed in parallel on @p ThreadPool::Singleton(). Input and output streams could be the same streams.
+///
+/// @param[in]  matrices    Transform matrix of each sphere.
+/// @param      spheres     Spheres to be transformed.
+/// @param      out         Receives the transformed spheres.
+/// @param      count       Number of spheres.
+YAGE_API auto BatchTransformSpheres(const Matrix4 *matrices,
+                                    SphereStream   spheres,
+                                    SphereStream   out,
+                                    size_t         count) noexcept -> void;
+
+/// @brief
+///   Transform axis-aligned bounding boxes with their own matrices. Results are axis-aligned boxes that contain the transformed boxes.
+/// @remarks
+///   Large arrays are split and processed in parallel on @p ThreadPool::Singleton(). Input and output streams could be the same streams.
+///
+/// @param[in]  matrices    Transform matrix of each box.
+/// @param      boxes       Boxes to be transformed.
+/// @param      out         Receives the transformed boxes.
+/// @param      count       Number of boxes.
+YAGE_API auto BatchTransformBoxes(const Matrix4 *matrices, BoxStream boxes, BoxStream out, size_t count) noexcept
+    -> void;
+
+/// @brief
+///   Cull bounding spheres against the specified frustum.
+/// @remarks
+///   Large arrays are split and processed in parallel on @p ThreadPool::Singleton(). Indices are always written in increasing order.
+///
+/// @param[in]  frustum     The frustum to cull against.
+/// @param      spheres     Spheres to be culled.
+/// @param      count       Number of spheres.
+/// @param[out] visible     Receives indices of spheres that intersect the frustum. Must have space for @p count indices.
+///
+/// @return size_t
+///   Return number of visible spheres.
+YAGE_API auto BatchCullSpheres(const Frustum &frustum, SphereStream spheres, size_t count, uint32_t *visible) noexcept
+    -> size_t;
+
+/// @brief
+///   Cull axis-aligned bounding boxes against the specified frustum.
+/// @remarks
+///   Large arrays are split and processed in parallel on @p ThreadPool::Singleton(). Indices are always written in increasing order.
+///
+/// @param[in]  frustum     The frustum to cull against.
+/// @param      boxes       Boxes to be culled.
+/// @param      count       Number of boxes.
+/// @param[out] visible     Receives indices of boxes that intersect the frustum. Must have space for @p count indices.
+///
+/// @return size_t
+///   Return number of visible boxes.
+YAGE_API auto BatchCullBoxes(const Frustum &frustum, BoxStream boxes, size_t count, uint32_t *visible) noexcept
+    -> size_t;
+
+} // namespace YaGE
@@ -0,0 +1,135 @@
+// This file is compiled with AVX2 and FMA enabled. Kernels in this file are only called if the processor supports them.
+#include "BatchKernels.h"
+
+using namespace YaGE;
+
+namespace {
+
+/// @brief
+///   8-wide AVX2 lanes. Each lane processes one element of the input streams.
+struct Avx2Lanes {
+    using Float = __m256;
+    using Mask  = __m256;
+
+    static constexpr const size_t WIDTH = 8;
+
+    static YAGE_FORCEINLINE auto Load(const float *p) noexcept -> Float { return _mm256_loadu_ps(p); }
+    static YAGE_FORCEINLINE auto Store(float *p, Float v) noexcept -> void { _mm256_storeu_ps(p, v); }
+    static YAGE_FORCEINLINE auto Set(float v) noexcept -> Float { return _mm256_set1_ps(v); }
+    static YAGE_FORCEINLINE auto Add(Float a, Float b) noexcept -> Float { return _mm256_add_ps(a, b); }
+    static YAGE_FORCEINLINE auto Sub(Float a, Float b) noexcept -> Float { return _mm256_sub_ps(a, b); }
+    static YAGE_FORCEINLINE auto Mul(Float a, Float b) noexcept -> Float { return _mm256_mul_ps(a, b); }
+    static YAGE_FORCEINLINE auto MulAdd(Float a, Float b, Float c) noexcept -> Float {
+        return _mm256_fmadd_ps(a, b, c);
+    }
+
+    static YAGE_FORCEINLINE auto Max(Float a, Float b) noexcept -> Float { return _mm256_max_ps(a, b); }
+    static YAGE_FORCEINLINE auto Abs(Float a) noexcept -> Float { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+    static YAGE_FORCEINLINE auto Sqrt(Float a) noexcept -> Float { return _mm256_sqrt_ps(a); }
+    static YAGE_FORCEINLINE auto CmpGe(Float a, Float b) noexcept -> Mask { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+    static YAGE_FORCEINLINE auto And(Mask a, Mask b) noexcept -> Mask { return _mm256_and_ps(a, b); }
+
+    static YAGE_FORCEINLINE auto MoveMask(Mask a) noexcept -> uint32_t {
+        return static_cast<uint32_t>(_mm256_movemask_ps(a));
+    }
+
+    /// @brief
+    ///   Transpose the 4x4 matrices in the lower and upper 128-bit halves of the specified rows separately.
+    static YAGE_FORCEINLINE auto Transpose(Float &a, Float &b, Float &c, Float &d) noexcept -> void {
+        const Float t0 = _mm256_unpacklo_ps(a, b);
+        const Float t1 = _mm256_unpackhi_ps(a, b);
+        const Float t2 = _mm256_unpacklo_ps(c, d);
+        const Float t3 = _mm256_unpackhi_ps(c, d);
+
+        a = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+        b = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+        c = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+        d = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+    }
+
+    /// @brief
+    ///   Load elements of 8 matrices. Element (row, column) of each matrix is stored in @p e[row * 4 + column].
+    static YAGE_FORCEINLINE auto LoadMatrices(const Matrix4 *matrices, Float e[16]) noexcept -> void {
+        const float *src = reinterpret_cast<const float *>(matrices);
+        for (size_t row = 0; row < 4; ++row) {
+            const float *p = src + row * 4;
+
+            // Matrix i is placed in the lower half and matrix i + 4 is placed in the upper half.
+            Float a = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p)), _mm_loadu_ps(p + 64), 1);
+            Float b = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 16)), _mm_loadu_ps(p + 80), 1);
+            Float c = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 32)), _mm_loadu_ps(p + 96), 1);
+            Float d = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 48)), _mm_loadu_ps(p + 112), 1);
+            Transpose(a, b, c, d);
+
+            e[row * 4 + 0] = a;
+            e[row * 4 + 1] = b;
+            e[row * 4 + 2] = c;
+            e[row * 4 + 3] = d;
+        }
+    }
+
+    /// @brief
+    ///   Store elements of 8 matrices. Element (row, column) of each matrix is stored in @p e[row * 4 + column].
+    static YAGE_FORCEINLINE auto StoreMatrices(Matrix4 *matrices, Float e[16]) noexcept -> void {
+        float *dst = reinterpret_cast<float *>(matrices);
+        for (size_t row = 0; row < 4; ++row) {
+            float *p = dst + row * 4;
+
+            Float a = e[row * 4 + 0];
+            Float b = e[row * 4 + 1];
+            Float c = e[row * 4 + 2];
+            Float d = e[row * 4 + 3];
+            Transpose(a, b, c, d);
+
+            _mm_storeu_ps(p, _mm256_castps256_ps128(a));
+            _mm_storeu_ps(p + 16, _mm256_castps256_ps128(b));
+            _mm_storeu_ps(p + 32, _mm256_castps256_ps128(c));
+            _mm_storeu_ps(p + 48, _mm256_castps256_ps128(d));
+            _mm_storeu_ps(p + 64, _mm256_extractf128_ps(a, 1));
+            _mm_storeu_ps(p + 80, _mm256_extractf128_ps(b, 1));
+            _mm_storeu_ps(p + 96, _mm256_extractf128_ps(c, 1));
+            _mm_storeu_ps(p + 112, _mm256_extractf128_ps(d, 1));
+        }
+    }
+
+    /// @brief
+    ///   Multiply matrices by the same right-hand matrix. Two rows of each matrix are computed at once.
+    static auto MultiplyMatrices(const Matrix4 *matrices,
+                                 const Matrix4 &rhs,
+                                 Matrix4       *out,
+                                 size_t         first,
+                                 size_t         last) noexcept -> void {
+        const __m128 *r  = reinterpret_cast<const __m128 *>(&rhs);
+        const Float   r0 = _mm256_broadcast_ps(r);
+        const Float   r1 = _mm256_broadcast_ps(r + 1);
+        const Float   r2 = _mm256_broadcast_ps(r + 2);
+        const Float   r3 = _mm256_broadcast_ps(r + 3);
+
+        for (size_t i = first; i < last; ++i) {
+            const float *src = reinterpret_cast<const float *>(matrices + i);
+            float       *dst = reinterpret_cast<float *>(out + i);
+
+            const Float lo = _mm256_loadu_ps(src);
+            const Float hi = _mm256_loadu_ps(src + 8);
+
+            Float x = _mm256_mul_ps(_mm256_shuffle_ps(lo, lo, _MM_SHUFFLE(0, 0, 0, 0)), r0);
+            Float y = _mm256_mul_ps(_mm256_shuffle_ps(hi, hi, _MM_SHUFFLE(0, 0, 0, 0)), r0);
+            x       = _mm256_fmadd_ps(_mm256_shuffle_ps(lo, lo, _MM_SHUFFLE(1, 1, 1, 1)), r1, x);
+            y       = _mm256_fmadd_ps(_mm256_shuffle_ps(hi, hi, _MM_SHUFFLE(1, 1, 1, 1)), r1, y);
+            x       = _mm256_fmadd_ps(_mm256_shuffle_ps(lo, lo, _MM_SHUFFLE(2, 2, 2, 2)), r2, x);
+            y       = _mm256_fmadd_ps(_mm256_shuffle_ps(hi, hi, _MM_SHUFFLE(2, 2, 2, 2)), r2, y);
+            x       = _mm256_fmadd_ps(_mm256_shuffle_ps(lo, lo, _MM_SHUFFLE(3, 3, 3, 3)), r3, x);
+            y       = _mm256_fmadd_ps(_mm256_shuffle_ps(hi, hi, _MM_SHUFFLE(3, 3, 3, 3)), r3, y);
+
+            _mm256_storeu_ps(dst, x);
+            _mm256_storeu_ps(dst + 8, y);
+        }
+    }
+};
+
+} // namespace
+
+auto YaGE::Avx2BatchKernels() noexcept -> const BatchKernelTable & {
+    static const BatchKernelTable kernels = MakeBatchKernelTable<Avx2Lanes>();
+    return kernels;
+}
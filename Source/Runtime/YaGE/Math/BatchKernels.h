@@ -0,0 +1,387 @@
+#pragma once
+
+#include "Batch.h"
+
+#include <immintrin.h>
+#include <intrin.h>
+
+namespace YaGE {
+
+/// @brief
+///   Batch math kernels that process the range [first, last) of the input arrays.
+struct BatchKernelTable {
+    /// @brief  Multiply matrices by the same right-hand matrix.
+    void (*multiply)(const Matrix4 *matrices, const Matrix4 &rhs, Matrix4 *out, size_t first, size_t last);
+
+    /// @brief  Compose transform matrices from scale, rotation and translation streams.
+    void (*compose)(Vector3Stream    scale,
+                    QuaternionStream rotation,
+                    Vector3Stream    translation,
+                    Matrix4         *out,
+                    size_t           first,
+                    size_t           last);
+
+    /// @brief  Transform bounding spheres.
+    void (*transformSpheres)(const Matrix4 *matrices,
+                             SphereStream   spheres,
+                             SphereStream   out,
+                             size_t         first,
+                             size_t         last);
+
+    /// @brief  Transform axis-aligned bounding boxes.
+    void (*transformBoxes)(const Matrix4 *matrices, BoxStream boxes, BoxStream out, size_t first, size_t last);
+
+    /// @brief  Cull bounding spheres. Indices of visible spheres are packed from the beginning of the output array.
+    size_t (*cullSpheres)(const Frustum &frustum, SphereStream spheres, size_t first, size_t last, uint32_t *visible);
+
+    /// @brief  Cull axis-aligned bounding boxes. Indices of visible boxes are packed from the beginning of the output array.
+    size_t (*cullBoxes)(const Frustum &frustum, BoxStream boxes, size_t first, size_t last, uint32_t *visible);
+};
+
+/// @brief
+///   Get batch math kernels that use AVX2 and FMA instructions. These kernels must not be called if the processor does not support AVX2 and FMA.
+///
+/// @return const BatchKernelTable &
+///   Return reference to the AVX2 kernel table.
+YAGE_NODISCARD auto Avx2BatchKernels() noexcept -> const BatchKernelTable &;
+
+// Everything below has internal linkage on purpose. This header is included by translation units that are compiled
+// with different instruction sets, and the linker may pick any copy of an inline function with external linkage. For
+// the same reason, kernels only use intrinsics and never call inline functions of other headers.
+namespace {
+
+/// @brief
+///   Scalar lanes that are used to process the remaining elements of SIMD kernels.
+struct ScalarLanes {
+    using Float = float;
+    using Mask  = bool;
+
+    static constexpr const size_t WIDTH = 1;
+
+    static YAGE_FORCEINLINE auto Load(const float *p) noexcept -> Float { return *p; }
+    static YAGE_FORCEINLINE auto Store(float *p, Float v) noexcept -> void { *p = v; }
+    static YAGE_FORCEINLINE auto Set(float v) noexcept -> Float { return v; }
+    static YAGE_FORCEINLINE auto Add(Float a, Float b) noexcept -> Float { return a + b; }
+    static YAGE_FORCEINLINE auto Sub(Float a, Float b) noexcept -> Float { return a - b; }
+    static YAGE_FORCEINLINE auto Mul(Float a, Float b) noexcept -> Float { return a * b; }
+    static YAGE_FORCEINLINE auto MulAdd(Float a, Float b, Float c) noexcept -> Float { return a * b + c; }
+    static YAGE_FORCEINLINE auto Max(Float a, Float b) noexcept -> Float { return a > b ? a : b; }
+    static YAGE_FORCEINLINE auto Abs(Float a) noexcept -> Float { return a < 0.0f ? -a : a; }
+    static YAGE_FORCEINLINE auto Sqrt(Float a) noexcept -> Float { return _mm_cvtss_f32(_mm_sqrt_ss(_mm_set_ss(a))); }
+    static YAGE_FORCEINLINE auto CmpGe(Float a, Float b) noexcept -> Mask { return a >= b; }
+    static YAGE_FORCEINLINE auto And(Mask a, Mask b) noexcept -> Mask { return a && b; }
+    static YAGE_FORCEINLINE auto MoveMask(Mask a) noexcept -> uint32_t { return a ? 1U : 0U; }
+
+    /// @brief
+    ///   Load elements of matrices. Element (row, column) of each matrix is stored in @p e[row * 4 + column].
+    static YAGE_FORCEINLINE auto LoadMatrices(const Matrix4 *matrices, Float e[16]) noexcept -> void {
+        const float *src = reinterpret_cast<const float *>(matrices);
+        for (size_t i = 0; i < 16; ++i)
+            e[i] = src[i];
+    }
+
+    /// @brief
+    ///   Store elements of matrices. Element (row, column) of each matrix is stored in @p e[row * 4 + column].
+    static YAGE_FORCEINLINE auto StoreMatrices(Matrix4 *matrices, Float e[16]) noexcept -> void {
+        float *dst = reinterpret_cast<float *>(matrices);
+        for (size_t i = 0; i < 16; ++i)
+            dst[i] = e[i];
+    }
+};
+
+/// @brief
+///   Multiply matrices by the same right-hand matrix. Each matrix row is computed as a linear combination of rows of the right-hand matrix.
+template <typename Lanes>
+auto MultiplyKernel(const Matrix4 *matrices, const Matrix4 &rhs, Matrix4 *out, size_t first, size_t last) noexcept
+    -> void {
+    Lanes::MultiplyMatrices(matrices, rhs, out, first, last);
+}
+
+template <typename Lanes>
+YAGE_FORCEINLINE auto ComposeBlock(Vector3Stream    scale,
+                                   QuaternionStream rotation,
+                                   Vector3Stream    translation,
+                                   Matrix4         *out,
+                                   size_t           i) noexcept -> void {
+    using Float = typename Lanes::Float;
+
+    const Float qx = Lanes::Load(rotation.x + i);
+    const Float qy = Lanes::Load(rotation.y + i);
+    const Float qz = Lanes::Load(rotation.z + i);
+    const Float qw = Lanes::Load(rotation.w + i);
+
+    const Float sx = Lanes::Load(scale.x + i);
+    const Float sy = Lanes::Load(scale.y + i);
+    const Float sz = Lanes::Load(scale.z + i);
+
+    const Float one = Lanes::Set(1.0f);
+    const Float two = Lanes::Set(2.0f);
+
+    const Float x2 = Lanes::Mul(qx, two);
+    const Float y2 = Lanes::Mul(qy, two);
+    const Float z2 = Lanes::Mul(qz, two);
+
+    const Float xx = Lanes::Mul(qx, x2);
+    const Float yy = Lanes::Mul(qy, y2);
+    const Float zz = Lanes::Mul(qz, z2);
+    const Float xy = Lanes::Mul(qx, y2);
+    const Float xz = Lanes::Mul(qx, z2);
+    const Float yz = Lanes::Mul(qy, z2);
+    const Float wx = Lanes::Mul(qw, x2);
+    const Float wy = Lanes::Mul(qw, y2);
+    const Float wz = Lanes::Mul(qw, z2);
+
+    // Rows of the rotation matrix are scaled by scale of each axis, which equals to scale matrix * rotation matrix.
+    Float e[16];
+    e[0]  = Lanes::Mul(Lanes::Sub(one, Lanes::Add(yy, zz)), sx);
+    e[1]  = Lanes::Mul(Lanes::Add(xy, wz), sx);
+    e[2]  = Lanes::Mul(Lanes::Sub(xz, wy), sx);
+    e[3]  = Lanes::Set(0.0f);
+    e[4]  = Lanes::Mul(Lanes::Sub(xy, wz), sy);
+    e[5]  = Lanes::Mul(Lanes::Sub(one, Lanes::Add(xx, zz)), sy);
+    e[6]  = Lanes::Mul(Lanes::Add(yz, wx), sy);
+    e[7]  = e[3];
+    e[8]  = Lanes::Mul(Lanes::Add(xz, wy), sz);
+    e[9]  = Lanes::Mul(Lanes::Sub(yz, wx), sz);
+    e[10] = Lanes::Mul(Lanes::Sub(one, Lanes::Add(xx, yy)), sz);
+    e[11] = e[3];
+    e[12] = Lanes::Load(translation.x + i);
+    e[13] = Lanes::Load(translation.y + i);
+    e[14] = Lanes::Load(translation.z + i);
+    e[15] = one;
+
+    Lanes::StoreMatrices(out + i, e);
+}
+
+template <typename Lanes>
+auto ComposeKernel(Vector3Stream    scale,
+                   QuaternionStream rotation,
+                   Vector3Stream    translation,
+                   Matrix4         *out,
+                   size_t           first,
+                   size_t           last) noexcept -> void {
+    size_t i = first;
+    for (; i + Lanes::WIDTH <= last; i += Lanes::WIDTH)
+        ComposeBlock<Lanes>(scale, rotation, translation, out, i);
+    for (; i < last; ++i)
+        ComposeBlock<ScalarLanes>(scale, rotation, translation, out, i);
+}
+
+template <typename Lanes>
+YAGE_FORCEINLINE auto TransformSpheresBlock(const Matrix4 *matrices,
+                                           SphereStream   spheres,
+                                           SphereStream   out,
+                                           size_t         i) noexcept -> void {
+    using Float = typename Lanes::Float;
+
+    Float m[16];
+    Lanes::LoadMatrices(matrices + i, m);
+
+    const Float x = Lanes::Load(spheres.x + i);
+    const Float y = Lanes::Load(spheres.y + i);
+    const Float z = Lanes::Load(spheres.z + i);
+    const Float r = Lanes::Load(spheres.radius + i);
+
+    const Float cx = Lanes::MulAdd(x, m[0], Lanes::MulAdd(y, m[4], Lanes::MulAdd(z, m[8], m[12])));
+    const Float cy = Lanes::MulAdd(x, m[1], Lanes::MulAdd(y, m[5], Lanes::MulAdd(z, m[9], m[13])));
+    const Float cz = Lanes::MulAdd(x, m[2], Lanes::MulAdd(y, m[6], Lanes::MulAdd(z, m[10], m[14])));
+
+    // Radius is scaled by the longest axis of the transform.
+    const Float s0 = Lanes::MulAdd(m[0], m[0], Lanes::MulAdd(m[1], m[1], Lanes::Mul(m[2], m[2])));
+    const Float s1 = Lanes::MulAdd(m[4], m[4], Lanes::MulAdd(m[5], m[5], Lanes::Mul(m[6], m[6])));
+    const Float s2 = Lanes::MulAdd(m[8], m[8], Lanes::MulAdd(m[9], m[9], Lanes::Mul(m[10], m[10])));
+    const Float s  = Lanes::Sqrt(Lanes::Max(s0, Lanes::Max(s1, s2)));
+
+    Lanes::Store(out.x + i, cx);
+    Lanes::Store(out.y + i, cy);
+    Lanes::Store(out.z + i, cz);
+    Lanes::Store(out.radius + i, Lanes::Mul(r, s));
+}
+
+template <typename Lanes>
+auto TransformSpheresKernel(const Matrix4 *matrices,
+                            SphereStream   spheres,
+                            SphereStream   out,
+                            size_t         first,
+                            size_t         last) noexcept -> void {
+    size_t i = first;
+    for (; i + Lanes::WIDTH <= last; i += Lanes::WIDTH)
+        TransformSpheresBlock<Lanes>(matrices, spheres, out, i);
+    for (; i < last; ++i)
+        TransformSpheresBlock<ScalarLanes>(matrices, spheres, out, i);
+}
+
+template <typename Lanes>
+YAGE_FORCEINLINE auto TransformBoxesBlock(const Matrix4 *matrices, BoxStream boxes, BoxStream out, size_t i) noexcept
+    -> void {
+    using Float = typename Lanes::Float;
+
+    Float m[16];
+    Lanes::LoadMatrices(matrices + i, m);
+
+    const Float minX = Lanes::Load(boxes.minX + i);
+    const Float minY = Lanes::Load(boxes.minY + i);
+    const Float minZ = Lanes::Load(boxes.minZ + i);
+    const Float maxX = Lanes::Load(boxes.maxX + i);
+    const Float maxY = Lanes::Load(boxes.maxY + i);
+    const Float maxZ = Lanes::Load(boxes.maxZ + i);
+
+    // Transform center and extent instead of 8 corners. Extent of the result is the sum of absolute projections of the
+    // transformed box axes.
+    const Float half = Lanes::Set(0.5f);
+    const Float x    = Lanes::Mul(Lanes::Add(minX, maxX), half);
+    const Float y    = Lanes::Mul(Lanes::Add(minY, maxY), half);
+    const Float z    = Lanes::Mul(Lanes::Add(minZ, maxZ), half);
+    const Float ex   = Lanes::Mul(Lanes::Sub(maxX, minX), half);
+    const Float ey   = Lanes::Mul(Lanes::Sub(maxY, minY), half);
+    const Float ez   = Lanes::Mul(Lanes::Sub(maxZ, minZ), half);
+
+    const Float cx = Lanes::MulAdd(x, m[0], Lanes::MulAdd(y, m[4], Lanes::MulAdd(z, m[8], m[12])));
+    const Float cy = Lanes::MulAdd(x, m[1], Lanes::MulAdd(y, m[5], Lanes::MulAdd(z, m[9], m[13])));
+    const Float cz = Lanes::MulAdd(x, m[2], Lanes::MulAdd(y, m[6], Lanes::MulAdd(z, m[10], m[14])));
+
+    const Float tx =
+        Lanes::MulAdd(ex, Lanes::Abs(m[0]), Lanes::MulAdd(ey, Lanes::Abs(m[4]), Lanes::Mul(ez, Lanes::Abs(m[8]))));
+    const Float ty =
+        Lanes::MulAdd(ex, Lanes::Abs(m[1]), Lanes::MulAdd(ey, Lanes::Abs(m[5]), Lanes::Mul(ez, Lanes::Abs(m[9]))));
+    const Float tz =
+        Lanes::MulAdd(ex, Lanes::Abs(m[2]), Lanes::MulAdd(ey, Lanes::Abs(m[6]), Lanes::Mul(ez, Lanes::Abs(m[10]))));
+
+    Lanes::Store(out.minX + i, Lanes::Sub(cx, tx));
+    Lanes::Store(out.minY + i, Lanes::Sub(cy, ty));
+    Lanes::Store(out.minZ + i, Lanes::Sub(cz, tz));
+    Lanes::Store(out.maxX + i, Lanes::Add(cx, tx));
+    Lanes::Store(out.maxY + i, Lanes::Add(cy, ty));
+    Lanes::Store(out.maxZ + i, Lanes::Add(cz, tz));
+}
+
+template <typename Lanes>
+auto TransformBoxesKernel(const Matrix4 *matrices, BoxStream boxes, BoxStream out, size_t first, size_t last) noexcept
+    -> void {
+    size_t i = first;
+    for (; i + Lanes::WIDTH <= last; i += Lanes::WIDTH)
+        TransformBoxesBlock<Lanes>(matrices, boxes, out, i);
+    for (; i < last; ++i)
+        TransformBoxesBlock<ScalarLanes>(matrices, boxes, out, i);
+}
+
+/// @brief
+///   Append indices of set bits in @p mask to @p visible.
+YAGE_FORCEINLINE auto AppendVisible(uint32_t mask, size_t base, uint32_t *visible, size_t count) noexcept -> size_t {
+    while (mask != 0) {
+        unsigned long bit;
+        _BitScanForward(&bit, mask);
+        visible[count++] = static_cast<uint32_t>(base + bit);
+        mask &= mask - 1;
+    }
+    return count;
+}
+
+template <typename Lanes>
+YAGE_FORCEINLINE auto CullSpheresBlock(const float *planes, SphereStream spheres, size_t i) noexcept -> uint32_t {
+    using Float = typename Lanes::Float;
+    using Mask  = typename Lanes::Mask;
+
+    const Float x    = Lanes::Load(spheres.x + i);
+    const Float y    = Lanes::Load(spheres.y + i);
+    const Float z    = Lanes::Load(spheres.z + i);
+    const Float negR = Lanes::Sub(Lanes::Set(0.0f), Lanes::Load(spheres.radius + i));
+
+    Mask inside{};
+    for (size_t p = 0; p < 6; ++p) {
+        const float *plane = planes + p * 4;
+
+        const Float distance = Lanes::MulAdd(
+            x, Lanes::Set(plane[0]),
+            Lanes::MulAdd(y, Lanes::Set(plane[1]), Lanes::MulAdd(z, Lanes::Set(plane[2]), Lanes::Set(plane[3]))));
+
+        const Mask mask = Lanes::CmpGe(distance, negR);
+        inside          = (p == 0) ? mask : Lanes::And(inside, mask);
+    }
+
+    return Lanes::MoveMask(inside);
+}
+
+template <typename Lanes>
+auto CullSpheresKernel(const Frustum &frustum,
+                       SphereStream   spheres,
+                       size_t         first,
+                       size_t         last,
+                       uint32_t      *visible) noexcept -> size_t {
+    const float *planes = reinterpret_cast<const float *>(frustum.planes);
+
+    size_t count = 0;
+    size_t i     = first;
+    for (; i + Lanes::WIDTH <= last; i += Lanes::WIDTH)
+        count = AppendVisible(CullSpheresBlock<Lanes>(planes, spheres, i), i, visible, count);
+    for (; i < last; ++i)
+        count = AppendVisible(CullSpheresBlock<ScalarLanes>(planes, spheres, i), i, visible, count);
+
+    return count;
+}
+
+template <typename Lanes>
+YAGE_FORCEINLINE auto CullBoxesBlock(const float *planes, BoxStream boxes, size_t i) noexcept -> uint32_t {
+    using Float = typename Lanes::Float;
+    using Mask  = typename Lanes::Mask;
+
+    const Float minX = Lanes::Load(boxes.minX + i);
+    const Float minY = Lanes::Load(boxes.minY + i);
+    const Float minZ = Lanes::Load(boxes.minZ + i);
+    const Float maxX = Lanes::Load(boxes.maxX + i);
+    const Float maxY = Lanes::Load(boxes.maxY + i);
+    const Float maxZ = Lanes::Load(boxes.maxZ + i);
+
+    Mask inside{};
+    for (size_t p = 0; p < 6; ++p) {
+        const float *plane = planes + p * 4;
+
+        // The box is outside of the plane if the corner that is farthest along the plane normal is outside. Plane
+        // normals are the same for all lanes, so the corner is selected per plane rather than per lane.
+        const Float px = plane[0] >= 0.0f ? maxX : minX;
+        const Float py = plane[1] >= 0.0f ? maxY : minY;
+        const Float pz = plane[2] >= 0.0f ? maxZ : minZ;
+
+        const Float distance = Lanes::MulAdd(
+            px, Lanes::Set(plane[0]),
+            Lanes::MulAdd(py, Lanes::Set(plane[1]), Lanes::MulAdd(pz, Lanes::Set(plane[2]), Lanes::Set(plane[3]))));
+
+        const Mask mask = Lanes::CmpGe(distance, Lanes::Set(0.0f));
+        inside          = (p == 0) ? mask : Lanes::And(inside, mask);
+    }
+
+    return Lanes::MoveMask(inside);
+}
+
+template <typename Lanes>
+auto CullBoxesKernel(const Frustum &frustum, BoxStream boxes, size_t first, size_t last, uint32_t *visible) noexcept
+    -> size_t {
+    const float *planes = reinterpret_cast<const float *>(frustum.planes);
+
+    size_t count = 0;
+    size_t i     = first;
+    for (; i + Lanes::WIDTH <= last; i += Lanes::WIDTH)
+        count = AppendVisible(CullBoxesBlock<Lanes>(planes, boxes, i), i, visible, count);
+    for (; i < last; ++i)
+        count = AppendVisible(CullBoxesBlock<ScalarLanes>(planes, boxes, i), i, visible, count);
+
+    return count;
+}
+
+/// @brief
+///   Create kernel table with the specified SIMD lanes.
+template <typename Lanes>
+auto MakeBatchKernelTable() noexcept -> BatchKernelTable {
+    return BatchKernelTable{
+        /* multiply         = */ &MultiplyKernel<Lanes>,
+        /* compose          = */ &ComposeKernel<Lanes>,
+        /* transformSpheres = */ &TransformSpheresKernel<Lanes>,
+        /* transformBoxes   = */ &TransformBoxesKernel<Lanes>,
+        /* cullSpheres      = */ &CullSpheresKernel<Lanes>,
+        /* cullBoxes        = */ &CullBoxesKernel<Lanes>,
+    };
+}
+
+} // namespace
+
+} // namespace YaGE
@@ -0,0 +1,136 @@
+#include "AssetArchive.h"
+#include "../Graphics/RenderDevice.h"
+#include "DDSImage.h"
+
+using namespace YaGE;
+
+namespace {
+
+/// @brief  Packed file format of asset archives.
+constexpr const PackedFileFormat ASSET_ARCHIVE_FORMAT{
+    /* magic         = */ AssetArchive::MAGIC,
+    /* version       = */ AssetArchive::VERSION,
+    /* entrySize     = */ sizeof(AssetEntry),
+    /* dataAlignment = */ AssetArchive::BLOB_ALIGNMENT,
+    /* kind          = */ u"asset archive",
+};
+
+} // namespace
+
+YaGE::AssetArchive::AssetArchive() noexcept : packedFile() {}
+
+YaGE::AssetArchive::AssetArchive(StringView path) : packedFile(path, ASSET_ARCHIVE_FORMAT) {}
+
+YaGE::AssetArchive::AssetArchive(AssetArchive &&other) noexcept : packedFile(std::move(other.packedFile)) {}
+
+auto YaGE::AssetArchive::operator=(AssetArchive &&other) noexcept -> AssetArchive & {
+    packedFile = std::move(other.packedFile);
+    return *this;
+}
+
+YaGE::AssetArchive::~AssetArchive() noexcept {}
+
+auto YaGE::AssetArchive::Find(StringView name) const noexcept -> const AssetEntry * {
+    return reinterpret_cast<const AssetEntry *>(packedFile.Find(name));
+}
+
+auto YaGE::AssetArchive::HashName(StringView name) noexcept -> uint64_t {
+    return PackedFile::HashName(name);
+}
+
+YaGE::AssetArchiveWriter::AssetArchiveWriter() noexcept : assets() {}
+
+YaGE::AssetArchiveWriter::~AssetArchiveWriter() noexcept {}
+
+auto YaGE::AssetArchiveWriter::AddBuffer(StringView name, const void *data, size_t size) -> void {
+    PendingAsset asset{};
+    asset.name           = name;
+    asset.entry.nameHash = AssetArchive::HashName(name);
+    asset.entry.size     = size;
+    asset.entry.type     = AssetType::Buffer;
+    asset.entry.format   = DXGI_FORMAT_UNKNOWN;
+
+    const auto *bytes = static_cast<const uint8_t *>(data);
+    asset.data.assign(bytes, bytes + size);
+
+    assets.push_back(std::move(asset));
+}
+
+auto YaGE::AssetArchiveWriter::AddTexture(StringView                    name,
+                                          uint32_t                      width,
+                                          uint32_t                      height,
+                                          uint32_t                      arraySize,
+                                          DXGI_FORMAT                   format,
+                                          uint32_t                      mipLevels,
+                                          bool                          isCubeTexture,
+                                          const D3D12_SUBRESOURCE_DATA *subresources) -> void {
+    const D3D12_RESOURCE_DESC desc{
+        /* Dimension        = */ D3D12_RESOURCE_DIMENSION_TEXTURE2D,
+        /* Alignment        = */ 0,
+        /* Width            = */ width,
+        /* Height           = */ height,
+        /* DepthOrArraySize = */ static_cast<UINT16>(arraySize),
+        /* MipLevels        = */ static_cast<UINT16>(mipLevels),
+        /* Format           = */ format,
+        /* SampleDesc       = */
+        {
+            /* Count   = */ 1,
+            /* Quality = */ 0,
+        },
+        /* Layout = */ D3D12_TEXTURE_LAYOUT_UNKNOWN,
+        /* Flags  = */ D3D12_RESOURCE_FLAG_NONE,
+    };
+
+    // Bake subresources into placed footprint layout.
+    const uint32_t count = mipLevels * arraySize;
+
+    std::vector<D3D12_PLACED_SUBRESOURCE_FOOTPRINT> layouts(count);
+    std::vector<UINT>                               rowCounts(count);
+    std::vector<UINT64>                             rowSizes(count);
+    UINT64                                          totalSize = 0;
+
+    RenderDevice::Singleton().Device()->GetCopyableFootprints(&desc, 0, count, 0, layouts.data(), rowCounts.data(),
+                                                              rowSizes.data(), &totalSize);
+
+    PendingAsset asset{};
+    asset.name                = name;
+    asset.entry.nameHash      = AssetArchive::HashName(name);
+    asset.entry.size          = totalSize;
+    asset.entry.type          = AssetType::Texture;
+    asset.entry.format        = format;
+    asset.entry.width         = width;
+    asset.entry.height        = height;
+    asset.entry.arraySize     = arraySize;
+    asset.entry.mipLevels     = mipLevels;
+    asset.entry.isCubeTexture = isCubeTexture ? 1 : 0;
+    asset.data.resize(static_cast<size_t>(totalSize));
+
+    for (uint32_t i = 0; i < count; ++i) {
+        const D3D12_SUBRESOURCE_FOOTPRINT &footprint = layouts[i].Footprint;
+        const size_t                       rowSize   = static_cast<size_t>(rowSizes[i]);
+
+        uint8_t       *destPtr = asset.data.data() + layouts[i].Offset;
+        const uint8_t *srcPtr  = static_cast<const uint8_t *>(subresources[i].pData);
+        for (uint32_t row = 0; row < rowCounts[i]; ++row) {
+            memcpy(destPtr, srcPtr, rowSize);
+            destPtr += footprint.RowPitch;
+            srcPtr += subresources[i].RowPitch;
+        }
+    }
+
+    assets.push_back(std::move(asset));
+}
+
+auto YaGE::AssetArchiveWriter::AddTexture(StringView name, const DDSImage &image) -> void {
+    AddTexture(name, image.Width(), image.Height(), image.ArraySize(), image.PixelFormat(), image.MipLevels(),
+               image.IsCubeMap(), image.Subresources());
+}
+
+auto YaGE::AssetArchiveWriter::Save(StringView path) const -> void {
+    std::vector<PackedFileItem> items;
+    items.reserve(assets.size());
+    for (const PendingAsset &asset : assets)
+        items.push_back({asset.name, &asset.entry, asset.data.data(), asset.data.size()});
+
+    PackedFile::Save(path, ASSET_ARCHIVE_FORMAT, items.size(), items.data());
+}
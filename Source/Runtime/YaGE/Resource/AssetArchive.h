@@ -0,0 +1,263 @@
+#pragma once
+
+#include "../Core/PackedFile.h"
+
+#include <d3d12.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace YaGE {
+
+class DDSImage;
+
+/// @brief
+///   Type of assets in asset archive.
+enum class AssetType : uint32_t {
+    Buffer  = 0,
+    Texture = 1,
+};
+
+/// @brief
+///   Table of contents entry of an asset in asset archive.
+struct AssetEntry {
+    /// @brief  64-bit hash value of name of this asset. Entries are sorted by this value.
+    uint64_t nameHash;
+
+    /// @brief  Offset in characters of name of this asset in the name table.
+    uint32_t nameOffset;
+
+    /// @brief  Length in characters of name of this asset.
+    uint32_t nameLength;
+
+    /// @brief  Offset in byte of data of this asset from start of the archive file. Aligned up with @p AssetArchive::BLOB_ALIGNMENT.
+    uint64_t offset;
+
+    /// @brief  Size in byte of data of this asset.
+    uint64_t size;
+
+    /// @brief  Type of this asset.
+    AssetType type;
+
+    /// @brief  Pixel format of this texture. Unknown for buffers.
+    DXGI_FORMAT format;
+
+    /// @brief  Width in pixel of this texture. 0 for buffers.
+    uint32_t width;
+
+    /// @brief  Height in pixel of this texture. 0 for buffers.
+    uint32_t height;
+
+    /// @brief  Number of 2D textures in this texture. For cube textures, this is 6 times the number of cubes. 0 for buffers.
+    uint32_t arraySize;
+
+    /// @brief  Number of mip levels of this texture. 0 for buffers.
+    uint32_t mipLevels;
+
+    /// @brief  Specifies whether this texture is a cube texture.
+    uint32_t isCubeTexture;
+
+    /// @brief  Reserved. Must be 0.
+    uint32_t reserved;
+};
+
+static_assert(sizeof(AssetEntry) == 64, "Size of AssetEntry must be 64 bytes.");
+static_assert(offsetof(AssetEntry, offset) == offsetof(PackedFileEntry, offset) &&
+                  offsetof(AssetEntry, size) == offsetof(PackedFileEntry, size),
+              "AssetEntry must start with fields of PackedFileEntry.");
+
+class AssetArchive {
+public:
+    /// @brief
+    ///   Create an empty asset archive.
+    YAGE_API AssetArchive() noexcept;
+
+    /// @brief
+    ///   Open and memory-map an asset archive file. Only the header and the table of contents are validated, asset data is paged in on demand when accessed.
+    ///
+    /// @param path     Path to the asset archive file to be opened.
+    ///
+    /// @throw SystemErrorException
+    ///   Thrown if failed to open or map the file, or the file is not a valid asset archive.
+    YAGE_API explicit AssetArchive(StringView path);
+
+    /// @brief
+    ///   Copy constructor is disabled.
+    AssetArchive(const AssetArchive &) = delete;
+
+    /// @brief
+    ///   Copy assignment is disabled.
+    auto operator=(const AssetArchive &) = delete;
+
+    /// @brief
+    ///   Move constructor. The moved asset archive will be empty.
+    ///
+    /// @param other    The asset archive to move from.
+    YAGE_API AssetArchive(AssetArchive &&other) noexcept;
+
+    /// @brief
+    ///   Move assignment. The moved asset archive will be empty.
+    ///
+    /// @param other    The asset archive to move from.
+    ///
+    /// @return AssetArchive &
+    ///   Return reference to this asset archive.
+    YAGE_API auto operator=(AssetArchive &&other) noexcept -> AssetArchive &;
+
+    /// @brief
+    ///   Unmap and close this asset archive. Pointers to asset data are invalidated.
+    YAGE_API ~AssetArchive() noexcept;
+
+    /// @brief
+    ///   Find an asset by name.
+    /// @remarks
+    ///   Entries are sorted by name hash, so that lookup is a binary search and no lookup table is built when opening the archive.
+    ///
+    /// @param name     Name of the asset to be found.
+    ///
+    /// @return const AssetEntry *
+    ///   Return pointer to table of contents entry of the asset. Return @p nullptr if no such asset.
+    YAGE_NODISCARD YAGE_API auto Find(StringView name) const noexcept -> const AssetEntry *;
+
+    /// @brief
+    ///   Get name of the specified asset.
+    ///
+    /// @param entry    Table of contents entry of the asset.
+    ///
+    /// @return StringView
+    ///   Return name of the asset. The name is not null-terminated.
+    YAGE_NODISCARD auto Name(const AssetEntry &entry) const noexcept -> StringView {
+        return packedFile.Name(entry.nameOffset, entry.nameLength);
+    }
+
+    /// @brief
+    ///   Get data of the specified asset.
+    /// @remarks
+    ///   Buffer data could be passed to @p CommandBuffer::CopyBuffer() and texture data could be passed to @p CommandBuffer::CopyTexture() directly. Texture data is stored in placed footprint layout.
+    ///
+    /// @param entry    Table of contents entry of the asset.
+    ///
+    /// @return const void *
+    ///   Return pointer to the memory-mapped data of the asset.
+    YAGE_NODISCARD auto Data(const AssetEntry &entry) const noexcept -> const void * {
+        return packedFile.Data(entry.offset);
+    }
+
+    /// @brief
+    ///   Get number of assets in this archive.
+    ///
+    /// @return uint32_t
+    ///   Return number of assets in this archive.
+    YAGE_NODISCARD auto EntryCount() const noexcept -> uint32_t { return packedFile.EntryCount(); }
+
+    /// @brief
+    ///   Get table of contents of this archive.
+    ///
+    /// @return const AssetEntry *
+    ///   Return pointer to the first table of contents entry.
+    YAGE_NODISCARD auto Entries() const noexcept -> const AssetEntry * {
+        return static_cast<const AssetEntry *>(packedFile.Entries());
+    }
+
+    /// @brief
+    ///   Calculate hash value of asset name.
+    ///
+    /// @param name     Name of the asset.
+    ///
+    /// @return uint64_t
+    ///   Return hash value of the asset name.
+    YAGE_NODISCARD YAGE_API static auto HashName(StringView name) noexcept -> uint64_t;
+
+    /// @brief  Magic number of asset archive files. "YAGA" in little endian.
+    static constexpr const uint32_t MAGIC = 0x41474159;
+
+    /// @brief  Version of asset archive file format.
+    static constexpr const uint32_t VERSION = 1;
+
+    /// @brief  Alignment of asset data in archive files. Equal to D3D12 texture placement alignment.
+    static constexpr const uint64_t BLOB_ALIGNMENT = D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT;
+
+private:
+    /// @brief  The memory-mapped archive file.
+    PackedFile packedFile;
+};
+
+class AssetArchiveWriter {
+public:
+    /// @brief
+    ///   Create an empty asset archive writer.
+    YAGE_API AssetArchiveWriter() noexcept;
+
+    /// @brief
+    ///   Copy constructor is disabled.
+    AssetArchiveWriter(const AssetArchiveWriter &) = delete;
+
+    /// @brief
+    ///   Copy assignment is disabled.
+    auto operator=(const AssetArchiveWriter &) = delete;
+
+    /// @brief
+    ///   Destroy this asset archive writer and release all pending assets.
+    YAGE_API ~AssetArchiveWriter() noexcept;
+
+    /// @brief
+    ///   Add a buffer asset to this archive.
+    ///
+    /// @param      name    Name of the asset. Names must be unique in an archive.
+    /// @param[in]  data    Data of the buffer.
+    /// @param      size    Size in byte of the buffer.
+    YAGE_API auto AddBuffer(StringView name, const void *data, size_t size) -> void;
+
+    /// @brief
+    ///   Add a texture asset to this archive. Subresources are baked into placed footprint layout of the current render device, so that the texture could be uploaded with a single memory copy.
+    ///
+    /// @param      name            Name of the asset. Names must be unique in an archive.
+    /// @param      width           Width in pixel of the texture.
+    /// @param      height          Height in pixel of the texture.
+    /// @param      arraySize       Number of 2D textures in the texture.
+    /// @param      format          Pixel format of the texture.
+    /// @param      mipLevels       Number of mip levels of each 2D texture.
+    /// @param      isCubeTexture   Specifies whether this is a cube texture.
+    /// @param[in]  subresources    Source data of each subresource, @p mipLevels * @p arraySize in total.
+    YAGE_API auto AddTexture(StringView                    name,
+                             uint32_t                      width,
+                             uint32_t                      height,
+                             uint32_t                      arraySize,
+                             DXGI_FORMAT                   format,
+                             uint32_t                      mipLevels,
+                             bool                          isCubeTexture,
+                             const D3D12_SUBRESOURCE_DATA *subresources) -> void;
+
+    /// @brief
+    ///   Add a DDS image as texture asset to this archive.
+    ///
+    /// @param name     Name of the asset. Names must be unique in an archive.
+    /// @param image    The DDS image to be added.
+    YAGE_API auto AddTexture(StringView name, const DDSImage &image) -> void;
+
+    /// @brief
+    ///   Write all added assets to an asset archive file.
+    ///
+    /// @param path     Path to the asset archive file to be written.
+    ///
+    /// @throw SystemErrorException
+    ///   Thrown if failed to write the file.
+    YAGE_API auto Save(StringView path) const -> void;
+
+private:
+    struct PendingAsset {
+        /// @brief  Name of this asset.
+        String name;
+
+        /// @brief  Table of contents entry of this asset. Offsets are resolved when saving.
+        AssetEntry entry;
+
+        /// @brief  Data of this asset.
+        std::vector<uint8_t> data;
+    };
+
+    /// @brief  Assets to be written.
+    std::vector<PendingAsset> assets;
+};
+
+} // namespace YaGE
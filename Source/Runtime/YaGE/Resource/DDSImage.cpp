@@ -0,0 +1,507 @@
+#include "DDSImage.h"
+#include "../Core/Exception.h"
+
+#include <Windows.h>
+
+#include <algorithm>
+#include <cstring>
+
+using namespace YaGE;
+
+namespace {
+
+/// @brief  Magic number at the beginning of DDS files. This is "DDS " in little endian.
+constexpr const uint32_t DDS_MAGIC = 0x20534444;
+
+constexpr const uint32_t DDPF_ALPHA       = 0x00000002;
+constexpr const uint32_t DDPF_FOURCC      = 0x00000004;
+constexpr const uint32_t DDPF_RGB         = 0x00000040;
+constexpr const uint32_t DDPF_LUMINANCE   = 0x00020000;
+constexpr const uint32_t DDPF_BUMPDUDV    = 0x00080000;
+constexpr const uint32_t DDSCAPS2_CUBEMAP = 0x00000200;
+constexpr const uint32_t DDSCAPS2_VOLUME  = 0x00200000;
+
+/// @brief  Resource misc flag in DX10 header that indicates a cube map.
+constexpr const uint32_t DDS_RESOURCE_MISC_TEXTURECUBE = 0x4;
+
+/// @brief  Resource dimensions in DX10 header.
+constexpr const uint32_t DDS_DIMENSION_TEXTURE1D = 2;
+constexpr const uint32_t DDS_DIMENSION_TEXTURE2D = 3;
+constexpr const uint32_t DDS_DIMENSION_TEXTURE3D = 4;
+
+struct DDSPixelFormat {
+    uint32_t size;
+    uint32_t flags;
+    uint32_t fourCC;
+    uint32_t rgbBitCount;
+    uint32_t rBitMask;
+    uint32_t gBitMask;
+    uint32_t bBitMask;
+    uint32_t aBitMask;
+};
+
+struct DDSHeader {
+    uint32_t       size;
+    uint32_t       flags;
+    uint32_t       height;
+    uint32_t       width;
+    uint32_t       pitchOrLinearSize;
+    uint32_t       depth;
+    uint32_t       mipMapCount;
+    uint32_t       reserved1[11];
+    DDSPixelFormat pixelFormat;
+    uint32_t       caps;
+    uint32_t       caps2;
+    uint32_t       caps3;
+    uint32_t       caps4;
+    uint32_t       reserved2;
+};
+
+struct DDSHeaderDX10 {
+    DXGI_FORMAT dxgiFormat;
+    uint32_t    resourceDimension;
+    uint32_t    miscFlag;
+    uint32_t    arraySize;
+    uint32_t    miscFlags2;
+};
+
+static_assert(sizeof(DDSHeader) == 124, "Size of DDS header must be 124 bytes.");
+static_assert(sizeof(DDSHeaderDX10) == 20, "Size of DDS DX10 header must be 20 bytes.");
+
+/// @brief
+///   Make a four character code.
+YAGE_NODISCARD constexpr auto MakeFourCC(char c0, char c1, char c2, char c3) noexcept -> uint32_t {
+    return uint32_t(uint8_t(c0)) | (uint32_t(uint8_t(c1)) << 8) | (uint32_t(uint8_t(c2)) << 16) |
+           (uint32_t(uint8_t(c3)) << 24);
+}
+
+/// @brief
+///   Checks if the DDS pixel format has the specified bit masks.
+YAGE_NODISCARD YAGE_FORCEINLINE auto
+IsBitMask(const DDSPixelFormat &format, uint32_t r, uint32_t g, uint32_t b, uint32_t a) noexcept -> bool {
+    return format.rBitMask == r && format.gBitMask == g && format.bBitMask == b && format.aBitMask == a;
+}
+
+/// @brief
+///   Convert legacy DDS pixel format to DXGI format.
+///
+/// @param format   The legacy DDS pixel format.
+///
+/// @return DXGI_FORMAT
+///   Return the DXGI format. Return @p DXGI_FORMAT_UNKNOWN if the pixel format is not supported.
+YAGE_NODISCARD auto ToDXGIFormat(const DDSPixelFormat &format) noexcept -> DXGI_FORMAT {
+    if (format.flags & DDPF_FOURCC) {
+        switch (format.fourCC) {
+        case MakeFourCC('D', 'X', 'T', '1'):
+            return DXGI_FORMAT_BC1_UNORM;
+        case MakeFourCC('D', 'X', 'T', '2'):
+        case MakeFourCC('D', 'X', 'T', '3'):
+            return DXGI_FORMAT_BC2_UNORM;
+        case MakeFourCC('D', 'X', 'T', '4'):
+        case MakeFourCC('D', 'X', 'T', '5'):
+            return DXGI_FORMAT_BC3_UNORM;
+        case MakeFourCC('A', 'T', 'I', '1'):
+        case MakeFourCC('B', 'C', '4', 'U'):
+            return DXGI_FORMAT_BC4_UNORM;
+        case MakeFourCC('B', 'C', '4', 'S'):
+            return DXGI_FORMAT_BC4_SNORM;
+        case MakeFourCC('A', 'T', 'I', '2'):
+        case MakeFourCC('B', 'C', '5', 'U'):
+            return DXGI_FORMAT_BC5_UNORM;
+        case MakeFourCC('B', 'C', '5', 'S'):
+            return DXGI_FORMAT_BC5_SNORM;
+        case 36:
+            return DXGI_FORMAT_R16G16B16A16_UNORM;
+        case 110:
+            return DXGI_FORMAT_R16G16B16A16_SNORM;
+        case 111:
+            return DXGI_FORMAT_R16_FLOAT;
+        case 112:
+            return DXGI_FORMAT_R16G16_FLOAT;
+        case 113:
+            return DXGI_FORMAT_R16G16B16A16_FLOAT;
+        case 114:
+            return DXGI_FORMAT_R32_FLOAT;
+        case 115:
+            return DXGI_FORMAT_R32G32_FLOAT;
+        case 116:
+            return DXGI_FORMAT_R32G32B32A32_FLOAT;
+        default:
+            return DXGI_FORMAT_UNKNOWN;
+        }
+    }
+
+    if (format.flags & DDPF_RGB) {
+        if (format.rgbBitCount == 32) {
+            if (IsBitMask(format, 0x000000FF, 0x0000FF00, 0x00FF0000, 0xFF000000))
+                return DXGI_FORMAT_R8G8B8A8_UNORM;
+            if (IsBitMask(format, 0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000))
+                return DXGI_FORMAT_B8G8R8A8_UNORM;
+            if (IsBitMask(format, 0x00FF0000, 0x0000FF00, 0x000000FF, 0x00000000))
+                return DXGI_FORMAT_B8G8R8X8_UNORM;
+            if (IsBitMask(format, 0x000003FF, 0x000FFC00, 0x3FF00000, 0xC0000000))
+                return DXGI_FORMAT_R10G10B10A2_UNORM;
+            if (IsBitMask(format, 0x0000FFFF, 0xFFFF0000, 0x00000000, 0x00000000))
+                return DXGI_FORMAT_R16G16_UNORM;
+            if (IsBitMask(format, 0xFFFFFFFF, 0x00000000, 0x00000000, 0x00000000))
+                return DXGI_FORMAT_R32_FLOAT;
+        } else if (format.rgbBitCount == 16) {
+            if (IsBitMask(format, 0x7C00, 0x03E0, 0x001F, 0x8000))
+                return DXGI_FORMAT_B5G5R5A1_UNORM;
+            if (IsBitMask(format, 0xF800, 0x07E0, 0x001F, 0x0000))
+                return DXGI_FORMAT_B5G6R5_UNORM;
+            if (IsBitMask(format, 0x0F00, 0x00F0, 0x000F, 0xF000))
+                return DXGI_FORMAT_B4G4R4A4_UNORM;
+        }
+
+        return DXGI_FORMAT_UNKNOWN;
+    }
+
+    if (format.flags & DDPF_LUMINANCE) {
+        if (format.rgbBitCount == 8 && IsBitMask(format, 0xFF, 0, 0, 0))
+            return DXGI_FORMAT_R8_UNORM;
+        if (format.rgbBitCount == 16 && IsBitMask(format, 0xFFFF, 0, 0, 0))
+            return DXGI_FORMAT_R16_UNORM;
+        if (format.rgbBitCount == 16 && IsBitMask(format, 0x00FF, 0, 0, 0xFF00))
+            return DXGI_FORMAT_R8G8_UNORM;
+        return DXGI_FORMAT_UNKNOWN;
+    }
+
+    if (format.flags & DDPF_ALPHA)
+        return (format.rgbBitCount == 8) ? DXGI_FORMAT_A8_UNORM : DXGI_FORMAT_UNKNOWN;
+
+    if (format.flags & DDPF_BUMPDUDV) {
+        if (format.rgbBitCount == 16 && IsBitMask(format, 0x00FF, 0xFF00, 0, 0))
+            return DXGI_FORMAT_R8G8_SNORM;
+        if (format.rgbBitCount == 32 && IsBitMask(format, 0x000000FF, 0x0000FF00, 0x00FF0000, 0xFF000000))
+            return DXGI_FORMAT_R8G8B8A8_SNORM;
+        if (format.rgbBitCount == 32 && IsBitMask(format, 0x0000FFFF, 0xFFFF0000, 0, 0))
+            return DXGI_FORMAT_R16G16_SNORM;
+        return DXGI_FORMAT_UNKNOWN;
+    }
+
+    return DXGI_FORMAT_UNKNOWN;
+}
+
+/// @brief
+///   Get size in byte of a 4x4 block of the specified block-compressed format.
+///
+/// @param format   The pixel format to be queried.
+///
+/// @return uint32_t
+///   Return size in byte of a 4x4 block. Return 0 if @p format is not block-compressed.
+YAGE_NODISCARD auto BlockSize(DXGI_FORMAT format) noexcept -> uint32_t {
+    switch (format) {
+    case DXGI_FORMAT_BC1_TYPELESS:
+    case DXGI_FORMAT_BC1_UNORM:
+    case DXGI_FORMAT_BC1_UNORM_SRGB:
+    case DXGI_FORMAT_BC4_TYPELESS:
+    case DXGI_FORMAT_BC4_UNORM:
+    case DXGI_FORMAT_BC4_SNORM:
+        return 8;
+
+    case DXGI_FORMAT_BC2_TYPELESS:
+    case DXGI_FORMAT_BC2_UNORM:
+    case DXGI_FORMAT_BC2_UNORM_SRGB:
+    case DXGI_FORMAT_BC3_TYPELESS:
+    case DXGI_FORMAT_BC3_UNORM:
+    case DXGI_FORMAT_BC3_UNORM_SRGB:
+    case DXGI_FORMAT_BC5_TYPELESS:
+    case DXGI_FORMAT_BC5_UNORM:
+    case DXGI_FORMAT_BC5_SNORM:
+    case DXGI_FORMAT_BC6H_TYPELESS:
+    case DXGI_FORMAT_BC6H_UF16:
+    case DXGI_FORMAT_BC6H_SF16:
+    case DXGI_FORMAT_BC7_TYPELESS:
+    case DXGI_FORMAT_BC7_UNORM:
+    case DXGI_FORMAT_BC7_UNORM_SRGB:
+        return 16;
+
+    default:
+        return 0;
+    }
+}
+
+/// @brief
+///   Get number of bits per pixel of the specified uncompressed format.
+///
+/// @param format   The pixel format to be queried.
+///
+/// @return uint32_t
+///   Return number of bits per pixel. Return 0 if @p format is not supported.
+YAGE_NODISCARD auto BitsPerPixel(DXGI_FORMAT format) noexcept -> uint32_t {
+    switch (format) {
+    case DXGI_FORMAT_R32G32B32A32_TYPELESS:
+    case DXGI_FORMAT_R32G32B32A32_FLOAT:
+    case DXGI_FORMAT_R32G32B32A32_UINT:
+    case DXGI_FORMAT_R32G32B32A32_SINT:
+        return 128;
+
+    case DXGI_FORMAT_R32G32B32_TYPELESS:
+    case DXGI_FORMAT_R32G32B32_FLOAT:
+    case DXGI_FORMAT_R32G32B32_UINT:
+    case DXGI_FORMAT_R32G32B32_SINT:
+        return 96;
+
+    case DXGI_FORMAT_R16G16B16A16_TYPELESS:
+    case DXGI_FORMAT_R16G16B16A16_FLOAT:
+    case DXGI_FORMAT_R16G16B16A16_UNORM:
+    case DXGI_FORMAT_R16G16B16A16_UINT:
+    case DXGI_FORMAT_R16G16B16A16_SNORM:
+    case DXGI_FORMAT_R16G16B16A16_SINT:
+    case DXGI_FORMAT_R32G32_TYPELESS:
+    case DXGI_FORMAT_R32G32_FLOAT:
+    case DXGI_FORMAT_R32G32_UINT:
+    case DXGI_FORMAT_R32G32_SINT:
+        return 64;
+
+    case DXGI_FORMAT_R10G10B10A2_TYPELESS:
+    case DXGI_FORMAT_R10G10B10A2_UNORM:
+    case DXGI_FORMAT_R10G10B10A2_UINT:
+    case DXGI_FORMAT_R11G11B10_FLOAT:
+    case DXGI_FORMAT_R8G8B8A8_TYPELESS:
+    case DXGI_FORMAT_R8G8B8A8_UNORM:
+    case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+    case DXGI_FORMAT_R8G8B8A8_UINT:
+    case DXGI_FORMAT_R8G8B8A8_SNORM:
+    case DXGI_FORMAT_R8G8B8A8_SINT:
+    case DXGI_FORMAT_R16G16_TYPELESS:
+    case DXGI_FORMAT_R16G16_FLOAT:
+    case DXGI_FORMAT_R16G16_UNORM:
+    case DXGI_FORMAT_R16G16_UINT:
+    case DXGI_FORMAT_R16G16_SNORM:
+    case DXGI_FORMAT_R16G16_SINT:
+    case DXGI_FORMAT_R32_TYPELESS:
+    case DXGI_FORMAT_R32_FLOAT:
+    case DXGI_FORMAT_R32_UINT:
+    case DXGI_FORMAT_R32_SINT:
+    case DXGI_FORMAT_R9G9B9E5_SHAREDEXP:
+    case DXGI_FORMAT_B8G8R8A8_UNORM:
+    case DXGI_FORMAT_B8G8R8X8_UNORM:
+    case DXGI_FORMAT_R10G10B10_XR_BIAS_A2_UNORM:
+    case DXGI_FORMAT_B8G8R8A8_TYPELESS:
+    case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+    case DXGI_FORMAT_B8G8R8X8_TYPELESS:
+    case DXGI_FORMAT_B8G8R8X8_UNORM_SRGB:
+        return 32;
+
+    case DXGI_FORMAT_R8G8_TYPELESS:
+    case DXGI_FORMAT_R8G8_UNORM:
+    case DXGI_FORMAT_R8G8_UINT:
+    case DXGI_FORMAT_R8G8_SNORM:
+    case DXGI_FORMAT_R8G8_SINT:
+    case DXGI_FORMAT_R16_TYPELESS:
+    case DXGI_FORMAT_R16_FLOAT:
+    case DXGI_FORMAT_R16_UNORM:
+    case DXGI_FORMAT_R16_UINT:
+    case DXGI_FORMAT_R16_SNORM:
+    case DXGI_FORMAT_R16_SINT:
+    case DXGI_FORMAT_B5G6R5_UNORM:
+    case DXGI_FORMAT_B5G5R5A1_UNORM:
+    case DXGI_FORMAT_B4G4R4A4_UNORM:
+        return 16;
+
+    case DXGI_FORMAT_R8_TYPELESS:
+    case DXGI_FORMAT_R8_UNORM:
+    case DXGI_FORMAT_R8_UINT:
+    case DXGI_FORMAT_R8_SNORM:
+    case DXGI_FORMAT_R8_SINT:
+    case DXGI_FORMAT_A8_UNORM:
+        return 8;
+
+    default:
+        return 0;
+    }
+}
+
+/// @brief
+///   Read all content of the specified file.
+///
+/// @param      path    Path of the file to be read.
+/// @param[out] data    Content of the file.
+///
+/// @throw SystemErrorException
+///   Thrown if failed to read the file.
+auto ReadWholeFile(StringView path, std::vector<uint8_t> &data) -> void {
+    HANDLE file = INVALID_HANDLE_VALUE;
+    if (path.IsNullTerminated()) {
+        file = CreateFileW(reinterpret_cast<LPCWSTR>(path.Data()), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                           OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    } else {
+        String tempPath(path);
+        file = CreateFileW(reinterpret_cast<LPCWSTR>(tempPath.Data()), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                           OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    }
+
+    if (file == INVALID_HANDLE_VALUE)
+        throw SystemErrorException(HRESULT_FROM_WIN32(GetLastError()), Format(u"Failed to open DDS file: {}.", path));
+
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart > UINT32_MAX) {
+        CloseHandle(file);
+        throw SystemErrorException(HRESULT_FROM_WIN32(ERROR_FILE_TOO_LARGE), Format(u"Invalid DDS file: {}.", path));
+    }
+
+    data.resize(static_cast<size_t>(fileSize.QuadPart));
+
+    DWORD      bytesRead = 0;
+    const BOOL succeeded = ReadFile(file, data.data(), static_cast<DWORD>(data.size()), &bytesRead, nullptr);
+    const DWORD error    = GetLastError();
+    CloseHandle(file);
+
+    if (!succeeded || bytesRead != data.size())
+        throw SystemErrorException(HRESULT_FROM_WIN32(error), Format(u"Failed to read DDS file: {}.", path));
+}
+
+} // namespace
+
+YaGE::DDSImage::DDSImage() noexcept
+    : width(), height(), arraySize(), mipLevels(), pixelFormat(), isCubeMap(), data(), subresources() {}
+
+YaGE::DDSImage::DDSImage(StringView path)
+    : width(), height(), arraySize(), mipLevels(), pixelFormat(), isCubeMap(), data(), subresources() {
+    ReadWholeFile(path, data);
+
+    const HRESULT invalidData = HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+    const HRESULT unsupported = HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+
+    // Validate header.
+    if (data.size() < sizeof(uint32_t) + sizeof(DDSHeader))
+        throw SystemErrorException(invalidData, Format(u"Invalid DDS file: {}.", path));
+
+    uint32_t  magic;
+    DDSHeader header;
+    memcpy(&magic, data.data(), sizeof(magic));
+    memcpy(&header, data.data() + sizeof(magic), sizeof(header));
+
+    if (magic != DDS_MAGIC || header.size != sizeof(DDSHeader) || header.pixelFormat.size != sizeof(DDSPixelFormat))
+        throw SystemErrorException(invalidData, Format(u"Invalid DDS file: {}.", path));
+
+    size_t offset = sizeof(uint32_t) + sizeof(DDSHeader);
+
+    width     = header.width;
+    height    = header.height;
+    mipLevels = (header.mipMapCount == 0) ? 1 : header.mipMapCount;
+    arraySize = 1;
+
+    if ((header.pixelFormat.flags & DDPF_FOURCC) && header.pixelFormat.fourCC == MakeFourCC('D', 'X', '1', '0')) {
+        if (data.size() < offset + sizeof(DDSHeaderDX10))
+            throw SystemErrorException(invalidData, Format(u"Invalid DDS file: {}.", path));
+
+        DDSHeaderDX10 dx10;
+        memcpy(&dx10, data.data() + offset, sizeof(dx10));
+        offset += sizeof(DDSHeaderDX10);
+
+        if (dx10.resourceDimension == DDS_DIMENSION_TEXTURE3D)
+            throw SystemErrorException(unsupported, u"Volume DDS texture is not supported.");
+
+        if (dx10.resourceDimension != DDS_DIMENSION_TEXTURE1D && dx10.resourceDimension != DDS_DIMENSION_TEXTURE2D)
+            throw SystemErrorException(invalidData, Format(u"Invalid DDS file: {}.", path));
+
+        if (dx10.resourceDimension == DDS_DIMENSION_TEXTURE1D)
+            height = 1;
+
+        pixelFormat = dx10.dxgiFormat;
+        arraySize   = (dx10.arraySize == 0) ? 1 : dx10.arraySize;
+
+        if (dx10.miscFlag & DDS_RESOURCE_MISC_TEXTURECUBE) {
+            isCubeMap = true;
+            arraySize *= 6;
+        }
+    } else {
+        if (header.caps2 & DDSCAPS2_VOLUME)
+            throw SystemErrorException(unsupported, u"Volume DDS texture is not supported.");
+
+        // Legacy cube maps without all 6 faces are not supported by D3D12.
+        if (header.caps2 & DDSCAPS2_CUBEMAP) {
+            if ((header.caps2 & 0xFC00) != 0xFC00)
+                throw SystemErrorException(unsupported, u"Partial DDS cube map is not supported.");
+
+            isCubeMap = true;
+            arraySize = 6;
+        }
+
+        pixelFormat = ToDXGIFormat(header.pixelFormat);
+    }
+
+    const uint32_t blockSize    = BlockSize(pixelFormat);
+    const uint32_t bitsPerPixel = (blockSize == 0) ? BitsPerPixel(pixelFormat) : 0;
+    if (blockSize == 0 && bitsPerPixel == 0)
+        throw SystemErrorException(unsupported, Format(u"Unsupported DDS pixel format: {}.", uint32_t(pixelFormat)));
+
+    if (width == 0 || height == 0 || mipLevels > D3D12_REQ_MIP_LEVELS)
+        throw SystemErrorException(invalidData, Format(u"Invalid DDS file: {}.", path));
+
+    // Build subresource data. Subresources are stored in D3D12 subresource order in DDS files.
+    subresources.reserve(size_t(arraySize) * mipLevels);
+    for (uint32_t slice = 0; slice < arraySize; ++slice) {
+        uint32_t w = width;
+        uint32_t h = height;
+
+        for (uint32_t mip = 0; mip < mipLevels; ++mip) {
+            size_t rowPitch;
+            size_t rowCount;
+            if (blockSize != 0) {
+                rowPitch = size_t(std::max(1U, (w + 3) / 4)) * blockSize;
+                rowCount = std::max(1U, (h + 3) / 4);
+            } else {
+                rowPitch = (size_t(w) * bitsPerPixel + 7) / 8;
+                rowCount = h;
+            }
+
+            const size_t slicePitch = rowPitch * rowCount;
+            if (offset + slicePitch > data.size())
+                throw SystemErrorException(HRESULT_FROM_WIN32(ERROR_HANDLE_EOF),
+                                           Format(u"DDS file is truncated: {}.", path));
+
+            subresources.push_back(D3D12_SUBRESOURCE_DATA{
+                /* pData      = */ data.data() + offset,
+                /* RowPitch   = */ static_cast<LONG_PTR>(rowPitch),
+                /* SlicePitch = */ static_cast<LONG_PTR>(slicePitch),
+            });
+
+            offset += slicePitch;
+            w = std::max(1U, w / 2);
+            h = std::max(1U, h / 2);
+        }
+    }
+}
+
+YaGE::DDSImage::DDSImage(DDSImage &&other) noexcept
+    : width(other.width),
+      height(other.height),
+      arraySize(other.arraySize),
+      mipLevels(other.mipLevels),
+      pixelFormat(other.pixelFormat),
+      isCubeMap(other.isCubeMap),
+      data(std::move(other.data)),
+      subresources(std::move(other.subresources)) {
+    other.width       = 0;
+    other.height      = 0;
+    other.arraySize   = 0;
+    other.mipLevels   = 0;
+    other.pixelFormat = DXGI_FORMAT_UNKNOWN;
+    other.isCubeMap   = false;
+}
+
+auto YaGE::DDSImage::operator=(DDSImage &&other) noexcept -> DDSImage & {
+    width        = other.width;
+    height       = other.height;
+    arraySize    = other.arraySize;
+    mipLevels    = other.mipLevels;
+    pixelFormat  = other.pixelFormat;
+    isCubeMap    = other.isCubeMap;
+    data         = std::move(other.data);
+    subresources = std::move(other.subresources);
+
+    other.width       = 0;
+    other.height      = 0;
+    other.arraySize   = 0;
+    other.mipLevels   = 0;
+    other.pixelFormat = DXGI_FORMAT_UNKNOWN;
+    other.isCubeMap   = false;
+
+    return *this;
+}
+
+YaGE::DDSImage::~DDSImage() noexcept {}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "../Core/StringView.h"
+
+#include <d3d12.h>
+
+#include <vector>
+
+namespace YaGE {
+
+class DDSImage {
+public:
+    /// @brief
+    ///   Create an empty DDS image.
+    YAGE_API DDSImage() noexcept;
+
+    /// @brief
+    ///   Load a DDS image from file. Block-compressed formats, texture arrays, cube maps and prebuilt mip chains are supported.
+    /// @note
+    ///   Volume textures are not supported. 1D textures are loaded as 2D textures with height 1.
+    ///
+    /// @param path     Path to the DDS file to be loaded.
+    ///
+    /// @throw SystemErrorException
+    ///   Thrown if failed to read the file, the file is not a valid DDS file or the pixel format is not supported.
+    YAGE_API explicit DDSImage(StringView path);
+
+    /// @brief
+    ///   Copy constructor is disabled.
+    DDSImage(const DDSImage &) = delete;
+
+    /// @brief
+    ///   Copy assignment is disabled.
+    auto operator=(const DDSImage &) = delete;
+
+    /// @brief
+    ///   Move constructor. The moved DDS image will be empty.
+    ///
+    /// @param other    The DDS image to move from.
+    YAGE_API DDSImage(DDSImage &&other) noexcept;
+
+    /// @brief
+    ///   Move assignment. The moved DDS image will be empty.
+    ///
+    /// @param other    The DDS image to move from.
+    ///
+    /// @return DDSImage &
+    ///   Return reference to this DDS image.
+    YAGE_API auto operator=(DDSImage &&other) noexcept -> DDSImage &;
+
+    /// @brief
+    ///   Destroy this DDS image and release all data.
+    YAGE_API ~DDSImage() noexcept;
+
+    /// @brief
+    ///   Get width in pixel of the most detailed mip level.
+    ///
+    /// @return uint32_t
+    ///   Return width in pixel of the most detailed mip level.
+    YAGE_NODISCARD auto Width() const noexcept -> uint32_t { return width; }
+
+    /// @brief
+    ///   Get height in pixel of the most detailed mip level.
+    ///
+    /// @return uint32_t
+    ///   Return height in pixel of the most detailed mip level.
+    YAGE_NODISCARD auto Height() const noexcept -> uint32_t { return height; }
+
+    /// @brief
+    ///   Get number of 2D textures in this image. For cube maps, this is 6 times the number of cubes.
+    ///
+    /// @return uint32_t
+    ///   Return number of 2D textures in this image.
+    YAGE_NODISCARD auto ArraySize() const noexcept -> uint32_t { return arraySize; }
+
+    /// @brief
+    ///   Get number of mip levels of each 2D texture in this image.
+    ///
+    /// @return uint32_t
+    ///   Return number of mip levels of each 2D texture in this image.
+    YAGE_NODISCARD auto MipLevels() const noexcept -> uint32_t { return mipLevels; }
+
+    /// @brief
+    ///   Get pixel format of this image.
+    ///
+    /// @return DXGI_FORMAT
+    ///   Return pixel format of this image.
+    YAGE_NODISCARD auto PixelFormat() const noexcept -> DXGI_FORMAT { return pixelFormat; }
+
+    /// @brief
+    ///   Checks whether this image is a cube map.
+    ///
+    /// @return bool
+    /// @retval true    This image is a cube map.
+    /// @retval false   This image is not a cube map.
+    YAGE_NODISCARD auto IsCubeMap() const noexcept -> bool { return isCubeMap; }
+
+    /// @brief
+    ///   Get number of subresources in this image. This is equal to ArraySize() * MipLevels().
+    ///
+    /// @return uint32_t
+    ///   Return number of subresources in this image.
+    YAGE_NODISCARD auto SubresourceCount() const noexcept -> uint32_t {
+        return static_cast<uint32_t>(subresources.size());
+    }
+
+    /// @brief
+    ///   Get data of all subresources in D3D12 subresource order. Subresource @p i is mip level @p i % MipLevels() of array slice @p i / MipLevels().
+    ///
+    /// @return const D3D12_SUBRESOURCE_DATA *
+    ///   Return pointer to the first subresource data. Pointers in subresource data point to memory owned by this image.
+    YAGE_NODISCARD auto Subresources() const noexcept -> const D3D12_SUBRESOURCE_DATA * { return subresources.data(); }
+
+private:
+    /// @brief  Width in pixel of the most detailed mip level.
+    uint32_t width;
+
+    /// @brief  Height in pixel of the most detailed mip level.
+    uint32_t height;
+
+    /// @brief  Number of 2D textures in this image.
+    uint32_t arraySize;
+
+    /// @brief  Number of mip levels of each 2D texture.
+    uint32_t mipLevels;
+
+    /// @brief  Pixel format of this image.
+    DXGI_FORMAT pixelFormat;
+
+    /// @brief  Whether this image is a cube map.
+    bool isCubeMap;
+
+    /// @brief  Content of the DDS file.
+    std::vector<uint8_t> data;
+
+    /// @brief  Subresource data that point into @p data.
+    std::vector<D3D12_SUBRESOURCE_DATA> subresources;
+};
+
+} // namespace YaGE
@@ -0,0 +1,150 @@
+#ifdef YAGE_ENABLE_DIRECTSTORAGE
+
+#    include "DirectStorageLoader.h"
+#    include "../Core/Exception.h"
+#    include "../Graphics/GpuBuffer.h"
+#    include "../Graphics/PixelBuffer.h"
+#    include "../Graphics/RenderDevice.h"
+
+using namespace YaGE;
+using Microsoft::WRL::ComPtr;
+
+YaGE::DirectStorageLoader::DirectStorageLoader() : factory(), queue(), fence(), nextFenceValue(1), submitMutex() {
+    HRESULT hr = DStorageGetFactory(IID_PPV_ARGS(factory.GetAddressOf()));
+    if (FAILED(hr))
+        throw RenderAPIException(hr, u"Failed to get DirectStorage factory.");
+
+    ID3D12Device1 *device = RenderDevice::Singleton().Device();
+
+    { // Create DirectStorage queue.
+        const DSTORAGE_QUEUE_DESC desc{
+            /* SourceType = */ DSTORAGE_REQUEST_SOURCE_FILE,
+            /* Capacity   = */ DSTORAGE_MAX_QUEUE_CAPACITY,
+            /* Priority   = */ DSTORAGE_PRIORITY_NORMAL,
+            /* Name       = */ "YaGE DirectStorage Queue",
+            /* Device     = */ device,
+        };
+
+        hr = factory->CreateQueue(&desc, IID_PPV_ARGS(queue.GetAddressOf()));
+        if (FAILED(hr))
+            throw RenderAPIException(hr, u"Failed to create DirectStorage queue.");
+    }
+
+    hr = device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(fence.GetAddressOf()));
+    if (FAILED(hr))
+        throw RenderAPIException(hr, u"Failed to create DirectStorage fence.");
+}
+
+YaGE::DirectStorageLoader::~DirectStorageLoader() noexcept {
+    // Requests may still be writing to GPU resources. Wait for all of them before releasing the queue.
+    if (nextFenceValue > 1 && fence->GetCompletedValue() < nextFenceValue - 1)
+        fence->SetEventOnCompletion(nextFenceValue - 1, nullptr);
+}
+
+auto YaGE::DirectStorageLoader::OpenFile(StringView path) -> ComPtr<IDStorageFile> {
+    ComPtr<IDStorageFile> file;
+
+    HRESULT hr;
+    if (path.IsNullTerminated()) {
+        hr = factory->OpenFile(reinterpret_cast<const WCHAR *>(path.Data()), IID_PPV_ARGS(file.GetAddressOf()));
+    } else {
+        String tempPath(path);
+        hr = factory->OpenFile(reinterpret_cast<const WCHAR *>(tempPath.Data()), IID_PPV_ARGS(file.GetAddressOf()));
+    }
+
+    if (FAILED(hr))
+        throw SystemErrorException(hr, Format(u"Failed to open DirectStorage file: {}.", path));
+
+    return file;
+}
+
+auto YaGE::DirectStorageLoader::EnqueueRead(IDStorageFile              *file,
+                                            uint64_t                    offset,
+                                            uint32_t                    size,
+                                            GpuBuffer                  &dest,
+                                            uint64_t                    destOffset,
+                                            DSTORAGE_COMPRESSION_FORMAT compression,
+                                            uint32_t                    uncompressedSize) noexcept -> void {
+    if (compression == DSTORAGE_COMPRESSION_FORMAT_NONE)
+        uncompressedSize = size;
+
+    DSTORAGE_REQUEST request{};
+    request.Options.SourceType        = DSTORAGE_REQUEST_SOURCE_FILE;
+    request.Options.DestinationType   = DSTORAGE_REQUEST_DESTINATION_BUFFER;
+    request.Options.CompressionFormat = compression;
+
+    request.Source.File.Source = file;
+    request.Source.File.Offset = offset;
+    request.Source.File.Size   = size;
+
+    request.Destination.Buffer.Resource = dest.resource.Get();
+    request.Destination.Buffer.Offset   = destOffset;
+    request.Destination.Buffer.Size     = uncompressedSize;
+
+    request.UncompressedSize = uncompressedSize;
+    queue->EnqueueRequest(&request);
+}
+
+auto YaGE::DirectStorageLoader::EnqueueRead(IDStorageFile              *file,
+                                            uint64_t                    offset,
+                                            uint32_t                    size,
+                                            PixelBuffer                &dest,
+                                            uint32_t                    firstSubresource,
+                                            DSTORAGE_COMPRESSION_FORMAT compression,
+                                            uint32_t                    uncompressedSize) noexcept -> void {
+    if (compression == DSTORAGE_COMPRESSION_FORMAT_NONE)
+        uncompressedSize = size;
+
+    DSTORAGE_REQUEST request{};
+    request.Options.SourceType        = DSTORAGE_REQUEST_SOURCE_FILE;
+    request.Options.DestinationType   = DSTORAGE_REQUEST_DESTINATION_MULTIPLE_SUBRESOURCES;
+    request.Options.CompressionFormat = compression;
+
+    request.Source.File.Source = file;
+    request.Source.File.Offset = offset;
+    request.Source.File.Size   = size;
+
+    request.Destination.MultipleSubresources.Resource         = dest.resource.Get();
+    request.Destination.MultipleSubresources.FirstSubresource = firstSubresource;
+
+    request.UncompressedSize = uncompressedSize;
+    queue->EnqueueRequest(&request);
+}
+
+auto YaGE::DirectStorageLoader::Submit() noexcept -> uint64_t {
+    RenderDevice &renderDevice = RenderDevice::Singleton();
+
+    std::lock_guard<std::mutex> lock(submitMutex);
+
+    const uint64_t fenceValue = nextFenceValue++;
+    queue->EnqueueSignal(fence.Get(), fenceValue);
+    queue->Submit();
+
+    // Chain the DirectStorage fence into the copy queue so that the requests could be tracked by a regular sync point.
+    renderDevice.CopyQueue()->Wait(fence.Get(), fenceValue);
+    return renderDevice.AcquireSyncPoint(D3D12_COMMAND_LIST_TYPE_COPY);
+}
+
+auto YaGE::DirectStorageLoader::CheckErrors() const -> void {
+    DSTORAGE_ERROR_RECORD record{};
+    queue->RetrieveErrorRecord(&record);
+
+    if (record.FailureCount != 0)
+        throw SystemErrorException(record.FirstFailure.HResult, u"DirectStorage request failed.");
+}
+
+auto YaGE::DirectStorageLoader::SupportGpuDecompression(DSTORAGE_COMPRESSION_FORMAT format) const noexcept -> bool {
+    ComPtr<IDStorageQueue2> queue2;
+    if (FAILED(queue.As(&queue2)))
+        return false;
+
+    const DSTORAGE_COMPRESSION_SUPPORT support = queue2->GetCompressionSupport(format);
+    return (support & (DSTORAGE_COMPRESSION_SUPPORT_GPU_OPTIMIZED | DSTORAGE_COMPRESSION_SUPPORT_GPU_FALLBACK)) != 0;
+}
+
+auto YaGE::DirectStorageLoader::Singleton() -> DirectStorageLoader & {
+    static DirectStorageLoader instance;
+    return instance;
+}
+
+#endif // YAGE_ENABLE_DIRECTSTORAGE
@@ -0,0 +1,146 @@
+#pragma once
+
+#ifdef YAGE_ENABLE_DIRECTSTORAGE
+
+#    include "../Core/StringView.h"
+
+#    include <d3d12.h>
+#    include <dstorage.h>
+#    include <wrl/client.h>
+
+#    include <mutex>
+
+namespace YaGE {
+
+class GpuBuffer;
+class PixelBuffer;
+
+class DirectStorageLoader {
+public:
+    /// @brief
+    ///   Create a DirectStorage file queue on the render device. Requests are read from files straight into GPU resources. Compressed requests are decompressed on GPU if supported, otherwise DirectStorage falls back to CPU decompression.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to create DirectStorage factory, queue or fence.
+    YAGE_API DirectStorageLoader();
+
+    /// @brief
+    ///   Copy constructor is disabled.
+    DirectStorageLoader(const DirectStorageLoader &) = delete;
+
+    /// @brief
+    ///   Copy assignment is disabled.
+    auto operator=(const DirectStorageLoader &) = delete;
+
+    /// @brief
+    ///   Destroy this DirectStorage loader. All submitted requests are waited for.
+    YAGE_API ~DirectStorageLoader() noexcept;
+
+    /// @brief
+    ///   Open a file to be read by DirectStorage requests.
+    ///
+    /// @param path     Path to the file to be opened.
+    ///
+    /// @return Microsoft::WRL::ComPtr<IDStorageFile>
+    ///   Return the opened DirectStorage file. The file should be kept alive until requests that read it are finished.
+    ///
+    /// @throw SystemErrorException
+    ///   Thrown if failed to open the file.
+    YAGE_NODISCARD YAGE_API auto OpenFile(StringView path) -> Microsoft::WRL::ComPtr<IDStorageFile>;
+
+    /// @brief
+    ///   Enqueue a request that reads data from file into GPU buffer. The request is not executed until @p Submit() is called. This method is thread-safe.
+    /// @note
+    ///   The destination buffer must be in common state and must not be used by other command queues until the request is finished.
+    ///
+    /// @param[in]  file                The file to read from.
+    /// @param      offset              Offset in byte of the data in the file.
+    /// @param      size                Size in byte of the data in the file.
+    /// @param[out] dest                The destination buffer.
+    /// @param      destOffset          Offset in byte of the destination buffer to write to.
+    /// @param      compression         Compression format of the data in the file.
+    /// @param      uncompressedSize    Size in byte of the data after decompression. Ignored if @p compression is @p DSTORAGE_COMPRESSION_FORMAT_NONE.
+    YAGE_API auto EnqueueRead(IDStorageFile              *file,
+                              uint64_t                    offset,
+                              uint32_t                    size,
+                              GpuBuffer                  &dest,
+                              uint64_t                    destOffset,
+                              DSTORAGE_COMPRESSION_FORMAT compression      = DSTORAGE_COMPRESSION_FORMAT_NONE,
+                              uint32_t                    uncompressedSize = 0) noexcept -> void;
+
+    /// @brief
+    ///   Enqueue a request that reads subresources from file into texture. The request is not executed until @p Submit() is called. This method is thread-safe.
+    /// @note
+    ///   Data in the file must be laid out as the placed footprints returned by @p ID3D12Device::GetCopyableFootprints() with base offset 0, from @p firstSubresource to the last subresource of @p dest. The destination texture must be in common state and must not be used by other command queues until the request is finished.
+    ///
+    /// @param[in]  file                The file to read from.
+    /// @param      offset              Offset in byte of the data in the file.
+    /// @param      size                Size in byte of the data in the file.
+    /// @param[out] dest                The destination texture.
+    /// @param      firstSubresource    Index of the first subresource to be written.
+    /// @param      compression         Compression format of the data in the file.
+    /// @param      uncompressedSize    Size in byte of the data after decompression. Ignored if @p compression is @p DSTORAGE_COMPRESSION_FORMAT_NONE.
+    YAGE_API auto EnqueueRead(IDStorageFile              *file,
+                              uint64_t                    offset,
+                              uint32_t                    size,
+                              PixelBuffer                &dest,
+                              uint32_t                    firstSubresource,
+                              DSTORAGE_COMPRESSION_FORMAT compression      = DSTORAGE_COMPRESSION_FORMAT_NONE,
+                              uint32_t                    uncompressedSize = 0) noexcept -> void;
+
+    /// @brief
+    ///   Submit all enqueued requests.
+    /// @remarks
+    ///   The copy command queue is made to wait for completion of the requests on GPU side, so that the returned value is a regular sync point that could be used with @p RenderDevice::Sync(), @p RenderDevice::IsSyncPointReached() and @p CommandBuffer::WaitForSyncPoint(). Commands that are submitted to the copy command queue later than this call are also delayed until the requests are finished.
+    ///
+    /// @return uint64_t
+    ///   Return a sync point of the copy command queue that indicates when all submitted requests are finished.
+    YAGE_API auto Submit() noexcept -> uint64_t;
+
+    /// @brief
+    ///   Check whether any request has failed since this loader is created.
+    ///
+    /// @throw SystemErrorException
+    ///   Thrown if any request has failed. Error code of the first failure is stored in the exception.
+    YAGE_API auto CheckErrors() const -> void;
+
+    /// @brief
+    ///   Checks if the specified compression format is decompressed on GPU by this loader.
+    ///
+    /// @param format   The compression format to be checked.
+    ///
+    /// @return bool
+    /// @retval true    Requests of the compression format are decompressed on GPU.
+    /// @retval false   Requests of the compression format are decompressed on CPU or the format is not supported.
+    YAGE_NODISCARD YAGE_API auto SupportGpuDecompression(DSTORAGE_COMPRESSION_FORMAT format) const noexcept -> bool;
+
+    /// @brief
+    ///   Get global singleton instance of DirectStorage loader. The loader is created on first use.
+    ///
+    /// @return DirectStorageLoader &
+    ///   Return reference to the DirectStorage loader singleton instance.
+    ///
+    /// @throw RenderAPIException
+    ///   Thrown if failed to create the DirectStorage loader.
+    YAGE_NODISCARD YAGE_API static auto Singleton() -> DirectStorageLoader &;
+
+private:
+    /// @brief  DirectStorage factory.
+    Microsoft::WRL::ComPtr<IDStorageFactory> factory;
+
+    /// @brief  DirectStorage queue that reads from files.
+    Microsoft::WRL::ComPtr<IDStorageQueue> queue;
+
+    /// @brief  Fence that is signaled by the DirectStorage queue.
+    Microsoft::WRL::ComPtr<ID3D12Fence> fence;
+
+    /// @brief  Next value to be signaled to the fence.
+    uint64_t nextFenceValue;
+
+    /// @brief  Mutex that serializes fence signals and submissions.
+    std::mutex submitMutex;
+};
+
+} // namespace YaGE
+
+#endif // YAGE_ENABLE_DIRECTSTORAGE
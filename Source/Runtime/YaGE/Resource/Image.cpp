@@ -1,8 +1,6 @@
 #include "Image.h"
 #include "../Core/Exception.h"
-
-#include <wincodec.h>
-#include <wrl/client.h>
+#include "../Core/ThreadPool.h"
 
 #include <cassert>
 
@@ -14,37 +12,53 @@ namespace {
 class WICImageFactory {
 private:
     /// @brief
-    ///   Create a WIC imaging factory.
+    ///   Initialize COM for current thread and create a WIC imaging factory.
     ///
     /// @throw SystemErrorException
     ///   Thrown if failed to initialize COM or failed to create WIC imaging factory.
-    WICImageFactory() {
+    WICImageFactory() : comInitialized(false), factory() {
         HRESULT hr = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
         if (FAILED(hr) && (hr != RPC_E_CHANGED_MODE))
             throw SystemErrorException(hr, u"Failed to initialize COM.");
 
+        // COM is already initialized as a single-threaded apartment if RPC_E_CHANGED_MODE is returned.
+        comInitialized = SUCCEEDED(hr);
+
         hr = CoCreateInstance(CLSID_WICImagingFactory2, nullptr, CLSCTX_INPROC_SERVER,
                               IID_PPV_ARGS(factory.GetAddressOf()));
         if (FAILED(hr)) {
-            CoUninitialize();
+            if (comInitialized)
+                CoUninitialize();
             throw SystemErrorException(hr, u"Failed to create WIC image factory.");
         }
     }
 
     /// @brief
-    ///   Destroy this WIC imaging factory and uninitialize COM.
+    ///   Destroy this WIC imaging factory and uninitialize COM for current thread.
     ~WICImageFactory() noexcept {
         factory.Reset();
-        CoUninitialize();
+        if (comInitialized)
+            CoUninitialize();
     }
 
 public:
-    YAGE_NODISCARD static auto Singleton() -> IWICImagingFactory * {
-        static WICImageFactory instance;
+    /// @brief
+    ///   Get WIC imaging factory of current thread. Each thread has its own COM apartment and WIC imaging factory, so that images could be decoded concurrently without contention.
+    ///
+    /// @return IWICImagingFactory *
+    ///   Return the WIC imaging factory of current thread.
+    ///
+    /// @throw SystemErrorException
+    ///   Thrown if failed to initialize COM or failed to create WIC imaging factory.
+    YAGE_NODISCARD static auto Current() -> IWICImagingFactory * {
+        thread_local WICImageFactory instance;
         return instance.factory.Get();
     }
 
 private:
+    /// @brief  Whether COM is initialized by this object.
+    bool comInitialized;
+
     /// @brief  WIC image factory object.
     ComPtr<IWICImagingFactory> factory;
 };
@@ -138,7 +152,7 @@ YAGE_NODISCARD static auto WICConvertFormat(const WICPixelFormatGUID &guid, WICP
 
 YAGE_NODISCARD static auto GetPixelBitSize(const WICPixelFormatGUID &format, uint32_t &bitSize) noexcept -> HRESULT {
     ComPtr<IWICComponentInfo> componentInfo;
-    HRESULT hr = WICImageFactory::Singleton()->CreateComponentInfo(format, componentInfo.GetAddressOf());
+    HRESULT hr = WICImageFactory::Current()->CreateComponentInfo(format, componentInfo.GetAddressOf());
     if (FAILED(hr))
         return hr;
 
@@ -166,12 +180,12 @@ YAGE_NODISCARD static auto GetPixelBitSize(const WICPixelFormatGUID &format, uin
 
 YaGE::Image::Image() noexcept : width(), height(), pixelFormat(), pixelBitSize(), rowPitch(), slicePitch(), data() {}
 
-YaGE::Image::Image(StringView path)
-    : width(), height(), pixelFormat(), pixelBitSize(), rowPitch(), slicePitch(), data() {
+YaGE::ImageDecoder::ImageDecoder(StringView path)
+    : width(), height(), pixelFormat(), pixelBitSize(), rowPitch(), source() {
     HRESULT hr = S_OK;
 
     // Get WIC imaging factory.
-    IWICImagingFactory *const wic = WICImageFactory::Singleton();
+    IWICImagingFactory *const wic = WICImageFactory::Current();
 
     // Load image from file.
     ComPtr<IWICBitmapDecoder> decoder;
@@ -199,8 +213,6 @@ YaGE::Image::Image(StringView path)
         throw SystemErrorException(hr, u"Failed to get image pixel format.");
 
     // Convert to DXGI format.
-    ComPtr<IWICBitmapSource> bmp;
-
     pixelFormat = ToDXGIFormat(wicFormat);
     if (pixelFormat == DXGI_FORMAT_UNKNOWN) {
         // Get convert format.
@@ -220,7 +232,7 @@ YaGE::Image::Image(StringView path)
             throw SystemErrorException(hr, u"Failed to convert image format.");
 
         // Get converted image.
-        hr = converter.As(&bmp);
+        hr = converter.As(&source);
         if (FAILED(hr))
             throw SystemErrorException(hr, u"Failed to get converted image.");
 
@@ -229,11 +241,11 @@ YaGE::Image::Image(StringView path)
         wicFormat   = targetFormat;
         assert(pixelFormat != DXGI_FORMAT_UNKNOWN);
     } else {
-        bmp = frame;
+        source = frame;
     }
 
     // Get metadata.
-    hr = bmp->GetSize(&width, &height);
+    hr = source->GetSize(&width, &height);
     if (FAILED(hr))
         throw SystemErrorException(hr, u"Failed to get image size.");
 
@@ -243,11 +255,85 @@ YaGE::Image::Image(StringView path)
         throw SystemErrorException(hr, u"Failed to get pixel bit size.");
 
     // Row pitch size. Rounded up with 1 byte.
-    rowPitch   = (size_t(width) * pixelBitSize + 7) / 8;
-    slicePitch = rowPitch * size_t(height);
+    rowPitch = (size_t(width) * pixelBitSize + 7) / 8;
+}
+
+YaGE::ImageDecoder::ImageDecoder(ImageDecoder &&other) noexcept
+    : width(other.width),
+      height(other.height),
+      pixelFormat(other.pixelFormat),
+      pixelBitSize(other.pixelBitSize),
+      rowPitch(other.rowPitch),
+      source(std::move(other.source)) {
+    other.width        = 0;
+    other.height       = 0;
+    other.pixelFormat  = DXGI_FORMAT_UNKNOWN;
+    other.pixelBitSize = 0;
+    other.rowPitch     = 0;
+}
+
+auto YaGE::ImageDecoder::operator=(ImageDecoder &&other) noexcept -> ImageDecoder & {
+    width        = other.width;
+    height       = other.height;
+    pixelFormat  = other.pixelFormat;
+    pixelBitSize = other.pixelBitSize;
+    rowPitch     = other.rowPitch;
+    source       = std::move(other.source);
+
+    other.width        = 0;
+    other.height       = 0;
+    other.pixelFormat  = DXGI_FORMAT_UNKNOWN;
+    other.pixelBitSize = 0;
+    other.rowPitch     = 0;
+
+    return *this;
+}
+
+YaGE::ImageDecoder::~ImageDecoder() noexcept {}
+
+auto YaGE::ImageDecoder::CopyPixels(void *dest, size_t destRowPitch, size_t destSize) const -> void {
+    assert(destRowPitch >= rowPitch);
+    assert(destSize >= destRowPitch * height);
+
+    HRESULT hr = source->CopyPixels(nullptr, static_cast<UINT>(destRowPitch), static_cast<UINT>(destSize),
+                                    static_cast<BYTE *>(dest));
+    if (FAILED(hr))
+        throw SystemErrorException(hr, u"Failed to decode image pixels.");
+}
+
+YaGE::Image::Image(StringView path)
+    : width(), height(), pixelFormat(), pixelBitSize(), rowPitch(), slicePitch(), data() {
+    ImageDecoder decoder(path);
+
+    width        = decoder.Width();
+    height       = decoder.Height();
+    pixelFormat  = decoder.PixelFormat();
+    pixelBitSize = decoder.PixelBitSize();
+    rowPitch     = decoder.RowPitch();
+    slicePitch   = rowPitch * size_t(height);
 
     data.resize(slicePitch);
-    bmp->CopyPixels(nullptr, static_cast<UINT>(rowPitch), static_cast<UINT>(slicePitch), data.data());
+    decoder.CopyPixels(data.data(), rowPitch, slicePitch);
+}
+
+auto YaGE::Image::LoadAsync(StringView path) -> std::future<Image> {
+    return ThreadPool::Singleton().Submit([path = String(path)]() -> Image { return Image(path); });
+}
+
+auto YaGE::Image::LoadAsync(StringView path, std::function<void(Image *image, std::exception_ptr error)> callback)
+    -> void {
+    ThreadPool::Singleton().Submit([path = String(path), callback = std::move(callback)]() {
+        std::unique_ptr<Image> image;
+        std::exception_ptr     error;
+
+        try {
+            image = std::make_unique<Image>(path);
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        callback(image.get(), error);
+    });
 }
 
 YaGE::Image::Image(const Image &other) noexcept
@@ -3,9 +3,120 @@
 #include "../Core/StringView.h"
 
 #include <dxgiformat.h>
+#include <exception>
+#include <functional>
+#include <future>
+#include <wincodec.h>
+#include <wrl/client.h>
 
 namespace YaGE {
 
+class ImageDecoder {
+public:
+    /// @brief
+    ///   Open an image file and read its metadata. Pixels are not decoded until @p CopyPixels() is called.
+    ///
+    /// @param path     Path to the image file to be decoded.
+    ///
+    /// @throw SystemErrorException
+    ///   Thrown if failed to open the image file or the image format is not supported.
+    YAGE_API explicit ImageDecoder(StringView path);
+
+    /// @brief
+    ///   Copy constructor is disabled.
+    ImageDecoder(const ImageDecoder &) = delete;
+
+    /// @brief
+    ///   Copy assignment is disabled.
+    auto operator=(const ImageDecoder &) = delete;
+
+    /// @brief
+    ///   Move constructor. The moved image decoder will be invalidated.
+    ///
+    /// @param other    The image decoder to move from.
+    YAGE_API ImageDecoder(ImageDecoder &&other) noexcept;
+
+    /// @brief
+    ///   Move assignment. The moved image decoder will be invalidated.
+    ///
+    /// @param other    The image decoder to move from.
+    ///
+    /// @return ImageDecoder &
+    ///   Return reference to this image decoder.
+    YAGE_API auto operator=(ImageDecoder &&other) noexcept -> ImageDecoder &;
+
+    /// @brief
+    ///   Close the image file.
+    YAGE_API ~ImageDecoder() noexcept;
+
+    /// @brief
+    ///   Decode pixels of this image into the specified memory. The memory could be a mapped upload heap allocation so that pixels are written only once on CPU.
+    /// @note
+    ///   This method is not thread safe. Decoders must not be shared between threads.
+    ///
+    /// @param[out] dest        Pointer to start of the destination memory.
+    /// @param      destRowPitch Number of bytes per row of @p dest. Must be greater than or equal to @p RowPitch().
+    /// @param      destSize    Size in byte of @p dest. Must be greater than or equal to @p destRowPitch * @p Height().
+    ///
+    /// @throw SystemErrorException
+    ///   Thrown if failed to decode pixels of this image.
+    YAGE_API auto CopyPixels(void *dest, size_t destRowPitch, size_t destSize) const -> void;
+
+    /// @brief
+    ///   Get width in pixel of this image.
+    ///
+    /// @return uint32_t
+    ///   Return width in pixel of this image.
+    YAGE_NODISCARD auto Width() const noexcept -> uint32_t { return width; }
+
+    /// @brief
+    ///   Get height in pixel of this image.
+    ///
+    /// @return uint32_t
+    ///   Return height in pixel of this image.
+    YAGE_NODISCARD auto Height() const noexcept -> uint32_t { return height; }
+
+    /// @brief
+    ///   Get pixel format of the decoded pixels.
+    ///
+    /// @return DXGI_FORMAT
+    ///   Return pixel format of the decoded pixels.
+    YAGE_NODISCARD auto PixelFormat() const noexcept -> DXGI_FORMAT { return pixelFormat; }
+
+    /// @brief
+    ///   Get number of bits per pixel of the decoded pixels.
+    ///
+    /// @return uint32_t
+    ///   Return number of bits per pixel of the decoded pixels.
+    YAGE_NODISCARD auto PixelBitSize() const noexcept -> uint32_t { return pixelBitSize; }
+
+    /// @brief
+    ///   Get minimum number of bytes per row of the decoded pixels.
+    ///
+    /// @return size_t
+    ///   Return minimum number of bytes per row of the decoded pixels.
+    YAGE_NODISCARD auto RowPitch() const noexcept -> size_t { return rowPitch; }
+
+private:
+    /// @brief  Width in pixel of this image.
+    uint32_t width;
+
+    /// @brief  Height in pixel of this image.
+    uint32_t height;
+
+    /// @brief  Pixel format of the decoded pixels.
+    DXGI_FORMAT pixelFormat;
+
+    /// @brief  Number of bits per pixel of the decoded pixels.
+    uint32_t pixelBitSize;
+
+    /// @brief  Minimum number of bytes per row of the decoded pixels.
+    size_t rowPitch;
+
+    /// @brief  WIC bitmap source that pixels are decoded from. Format converter is applied if necessary.
+    Microsoft::WRL::ComPtr<IWICBitmapSource> source;
+};
+
 class Image {
 public:
     /// @brief
@@ -61,6 +172,27 @@ public:
     ///   Destroy this image and release all data.
     YAGE_API ~Image() noexcept;
 
+    /// @brief
+    ///   Load an image from file asynchronously on worker threads of @p ThreadPool::Singleton().
+    /// @remarks
+    ///   Each worker thread uses its own WIC imaging factory, so that multiple images could be decoded concurrently. This method is thread-safe.
+    ///
+    /// @param path     Path to the file to be used as image. The path is copied before this method returns.
+    ///
+    /// @return std::future<Image>
+    ///   Return a future that could be used to poll or wait for the image. @p SystemErrorException is rethrown by @p std::future::get() if failed to load the image.
+    YAGE_NODISCARD YAGE_API static auto LoadAsync(StringView path) -> std::future<Image>;
+
+    /// @brief
+    ///   Load an image from file asynchronously on worker threads of @p ThreadPool::Singleton() and call the callback once finished.
+    /// @remarks
+    ///   The callback is called on the worker thread that decodes the image. This method is thread-safe.
+    ///
+    /// @param path     Path to the file to be used as image. The path is copied before this method returns.
+    /// @param callback The callback to be called once the image is loaded. @p image is nullptr and @p error holds the exception if failed to load the image. The image could be moved away in the callback.
+    YAGE_API static auto LoadAsync(StringView                                                   path,
+                                   std::function<void(Image *image, std::exception_ptr error)> callback) -> void;
+
     /// @brief
     ///   Get width in pixel of this image.
     ///
@@ -0,0 +1,102 @@
+#include <YaGE/Core/Exception.h>
+#include <YaGE/Core/Unicode.h>
+#include <YaGE/Graphics/ShaderLibrary.h>
+
+#include <iostream>
+
+using namespace YaGE;
+
+static auto LoadBinary(const String &path) -> std::vector<uint8_t> {
+    HANDLE fileHandle = CreateFileW(reinterpret_cast<LPCWSTR>(path.Data()), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE)
+        throw SystemErrorException(HRESULT_FROM_WIN32(GetLastError()), Format(u"Failed to open file: {}.", path));
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(fileHandle, &fileSize)) {
+        const DWORD error = GetLastError();
+        CloseHandle(fileHandle);
+        throw SystemErrorException(HRESULT_FROM_WIN32(error), Format(u"Failed to get size of file: {}.", path));
+    }
+
+    std::vector<uint8_t> buffer(static_cast<size_t>(fileSize.QuadPart));
+
+    DWORD bytesRead = 0;
+    if (!ReadFile(fileHandle, buffer.data(), static_cast<DWORD>(buffer.size()), &bytesRead, nullptr) ||
+        bytesRead != buffer.size()) {
+        const DWORD error = GetLastError();
+        CloseHandle(fileHandle);
+        throw SystemErrorException(HRESULT_FROM_WIN32(error), Format(u"Failed to read file: {}.", path));
+    }
+
+    CloseHandle(fileHandle);
+    return buffer;
+}
+
+static auto ParseStage(StringView stage) -> ShaderStage {
+    if (stage == u"VERTEX")
+        return ShaderStage::Vertex;
+    if (stage == u"PIXEL")
+        return ShaderStage::Pixel;
+    if (stage == u"DOMAIN")
+        return ShaderStage::Domain;
+    if (stage == u"HULL")
+        return ShaderStage::Hull;
+    if (stage == u"GEOMETRY")
+        return ShaderStage::Geometry;
+    if (stage == u"COMPUTE")
+        return ShaderStage::Compute;
+    if (stage == u"AMPLIFICATION")
+        return ShaderStage::Amplification;
+    if (stage == u"MESH")
+        return ShaderStage::Mesh;
+    if (stage == u"RAY_TRACING")
+        return ShaderStage::RayTracing;
+
+    throw Exception(Format(u"Unknown shader stage: {}.", stage));
+}
+
+/// Pack compiled shader permutations into a single shader library file.
+///
+/// Each line of the manifest file is a shader permutation in UTF-8: <stage>\t<name>\t<path to compiled shader>. The
+/// manifest file is generated by YaGEAddShaderLibrary() in CMake/dxc.cmake.
+auto wmain(int argc, wchar_t **argv) -> int {
+    if (argc < 3) {
+        std::cout << "Usage: YaGEShaderPacker <manifest file> <output file>" << std::endl;
+        return 1;
+    }
+
+    try {
+        const String               manifestPath(reinterpret_cast<const char16_t *>(argv[1]));
+        const String               outputPath(reinterpret_cast<const char16_t *>(argv[2]));
+        const std::vector<uint8_t> manifestData(LoadBinary(manifestPath));
+
+        const String     manifest(ToString(reinterpret_cast<const char *>(manifestData.data()), manifestData.size()));
+        const StringView manifestView(manifest);
+
+        ShaderLibraryWriter writer;
+        for (StringView line : manifestView.Split(u'\n')) {
+            line.Trim();
+            if (line.IsEmpty())
+                continue;
+
+            const std::vector<StringView> fields(line.Split(u'\t'));
+            if (fields.size() != 3)
+                throw Exception(Format(u"Invalid shader manifest line: {}.", line));
+
+            const String               shaderPath(fields[2]);
+            const std::vector<uint8_t> bytecode(LoadBinary(shaderPath));
+            writer.AddShader(fields[1], ParseStage(fields[0]), bytecode.data(), bytecode.size());
+        }
+
+        writer.Save(outputPath);
+    } catch (const YaGE::SystemErrorException &e) {
+        std::cerr << ToUtf8(e.Message()) << " Error code: 0x" << std::hex << uint32_t(e.ErrorCode()) << std::endl;
+        return 1;
+    } catch (const YaGE::Exception &e) {
+        std::cerr << ToUtf8(e.Message()) << std::endl;
+        return 1;
+    }
+
+    return 0;
+}